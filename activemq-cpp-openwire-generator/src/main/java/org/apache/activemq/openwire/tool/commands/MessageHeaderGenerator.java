@@ -28,6 +28,7 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         Set<String> includes = getIncludeFiles();
         includes.add("<activemq/util/PrimitiveMap.h>");
         includes.add("<activemq/core/ActiveMQAckHandler.h>");
+        includes.add("<decaf/io/MemoryMappedFile.h>");
     }
 
     protected void generateNamespaceWrapper( PrintWriter out ) {
@@ -60,6 +61,10 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("        // Indicates if the Message Body are Read Only");
         out.println("        bool readOnlyBody;");
         out.println("");
+        out.println("        // When set the Message Body is held in this mapped file region instead of");
+        out.println("        // the content vector.");
+        out.println("        Pointer<decaf::io::MemoryMappedFile> mappedContent;");
+        out.println("");
         out.println("    protected:");
         out.println("");
         out.println("        core::ActiveMQConnection* connection;");
@@ -208,6 +213,46 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("            this->readOnlyBody = value;");
         out.println("        }");
         out.println("");
+        out.println("        /**");
+        out.println("         * Backs the Message Body with a memory mapped file region, the mapped bytes are");
+        out.println("         * marshaled straight from the mapping instead of being copied into the content");
+        out.println("         * vector.  Any existing content is cleared, passing NULL removes the mapping.");
+        out.println("         *");
+        out.println("         * @param mapping - the mapped region that holds the Message Body.");
+        out.println("         *");
+        out.println("         * @throws IllegalArgumentException if the region is too large for a Message Body.");
+        out.println("         */");
+        out.println("        void setMappedContent(const Pointer<decaf::io::MemoryMappedFile>& mapping);");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Gets the memory mapped file region that holds the Message Body.");
+        out.println("         * @return the mapped region or NULL if the body is held in the content vector.");
+        out.println("         */");
+        out.println("        const Pointer<decaf::io::MemoryMappedFile>& getMappedContent() const {");
+        out.println("            return this->mappedContent;");
+        out.println("        }");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Returns the size of the Message Body wherever it is held.");
+        out.println("         * @return number of bytes in the mapped region or the content vector.");
+        out.println("         */");
+        out.println("        int getContentSize() const;");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Returns the Message Body bytes wherever they are held.");
+        out.println("         * @return pointer to the first byte of the body or NULL if it is empty.");
+        out.println("         */");
+        out.println("        const unsigned char* getContentData() const;");
+        out.println("");
+        out.println("        /**");
+        out.println("         * Indicates if this Message type can read its body from a mapped file region,");
+        out.println("         * large bodies of such Messages may be spooled to disk when they are unmarshaled.");
+        out.println("         * @return true if setMappedContent can be used with this Message.");
+        out.println("         */");
+        out.println("        virtual bool isMappedContentSupported() const {");
+        out.println("            return false;");
+        out.println("        }");
+        out.println("");
     }
 
 }
@@ -29,6 +29,8 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         includes.add("<activemq/core/ActiveMQAckHandler.h>");
         includes.add("<activemq/core/ActiveMQConnection.h>");
         includes.add("<decaf/lang/System.h>");
+        includes.add("<decaf/lang/Integer.h>");
+        includes.add("<decaf/lang/exceptions/IllegalArgumentException.h>");
     }
 
     protected String generateInitializerList() {
@@ -39,6 +41,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         result.append(", properties()");
         result.append(", readOnlyProperties(false)");
         result.append(", readOnlyBody(false)");
+        result.append(", mappedContent()");
         result.append(", connection(NULL)");
 
         return result.toString();
@@ -51,6 +54,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("    this->setAckHandler(srcPtr->getAckHandler());");
         out.println("    this->setReadOnlyBody(srcPtr->isReadOnlyBody());");
         out.println("    this->setReadOnlyProperties(srcPtr->isReadOnlyProperties());");
+        out.println("    this->mappedContent = srcPtr->mappedContent;");
         out.println("    this->setConnection(srcPtr->getConnection());");
     }
 
@@ -77,6 +81,10 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("        return false;");
         out.println("    }");
         out.println("");
+        out.println("    if (mappedContent != valuePtr->getMappedContent()){");
+        out.println("        return false;");
+        out.println("    }");
+        out.println("");
     }
 
     protected void generateCompareToBody( PrintWriter out ) {
@@ -102,13 +110,45 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    unsigned int size = DEFAULT_MESSAGE_SIZE;");
         out.println("");
-        out.println("    size += (unsigned int)this->getContent().size();");
+        out.println("    size += (unsigned int)this->getContentSize();");
         out.println("    size += (unsigned int)this->getMarshalledProperties().size();");
         out.println("");
         out.println("    return size;");
         out.println("}");
         out.println("");
         out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::setMappedContent(const Pointer<decaf::io::MemoryMappedFile>& mapping) {");
+        out.println("");
+        out.println("    if (mapping != NULL && mapping->getLength() > (long long)Integer::MAX_VALUE) {");
+        out.println("        throw IllegalArgumentException(__FILE__, __LINE__,");
+        out.println("            \"Mapped region of %lld bytes is larger than a Message Body can be.\", mapping->getLength());");
+        out.println("    }");
+        out.println("");
+        out.println("    this->content.clear();");
+        out.println("    this->mappedContent = mapping;");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("int Message::getContentSize() const {");
+        out.println("");
+        out.println("    if (this->mappedContent != NULL) {");
+        out.println("        return (int)this->mappedContent->getLength();");
+        out.println("    }");
+        out.println("");
+        out.println("    return (int)this->content.size();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("const unsigned char* Message::getContentData() const {");
+        out.println("");
+        out.println("    if (this->mappedContent != NULL) {");
+        out.println("        return this->mappedContent->getData();");
+        out.println("    }");
+        out.println("");
+        out.println("    return this->content.empty() ? NULL : &this->content[0];");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
         out.println("void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
         out.println("");
         out.println("    try {");
@@ -119,6 +119,14 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
     // This section is for the tight wire format encoding generator
     //////////////////////////////////////////////////////////////////////////////////////
 
+    /**
+     * The Message body can be held in a memory mapped file instead of the content
+     * vector so it is marshaled by the BaseDataStreamMarshaller content helpers.
+     */
+    protected boolean isMessageContent(JProperty property) {
+        return jclass.getSimpleName().equals("Message") && property.getSimpleName().equals("content");
+    }
+
     protected void generateTightUnmarshalBody(PrintWriter out) {
 
         for ( JProperty property : getProperties() ) {
@@ -173,6 +181,9 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         else if( type.equals("String") ) {
             out.println(indent + "info->" + setter + "(tightUnmarshalString(dataIn, bs));");
         }
+        else if (isMessageContent(property)) {
+            out.println(indent + "tightUnmarshalMessageContent(wireFormat, info, dataIn, bs);");
+        }
         else if( type.equals("byte[]") || type.equals("ByteSequence") ) {
             if( size != null ) {
                 out.println(indent + "info->" + setter + "(tightUnmarshalConstByteArray(dataIn, bs, "+ size.asInt() +"));");
@@ -263,6 +274,9 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
                 out.print("");
                 out.println(indent + "rc += tightMarshalString1(" + getter + ", bs);" );
             }
+            else if (isMessageContent(property)) {
+                out.println(indent + "rc += tightMarshalMessageContent1(info, bs);");
+            }
             else if (type.equals("byte[]") || type.equals("ByteSequence")) {
                 if (size == null) {
                     out.println(indent + "bs->writeBoolean(" + getter + ".size() != 0);" );
@@ -340,6 +354,9 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
             else if (type.equals("String")) {
                 out.println(indent + "tightMarshalString2(" + getter + ", dataOut, bs);");
             }
+            else if (isMessageContent(property)) {
+                out.println(indent + "tightMarshalMessageContent2(info, dataOut, bs);");
+            }
             else if (type.equals("byte[]") || type.equals("ByteSequence")) {
                 if (size != null) {
                     out.println(indent + "dataOut->write((const unsigned char*)(&" + getter + "[0]), " + size.asInt() + ", 0, " + size.asInt() + ");");
@@ -434,6 +451,9 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         else if (type.equals("String")) {
             out.println(indent + "info->" + setter + "(looseUnmarshalString(dataIn));");
         }
+        else if (isMessageContent(property)) {
+            out.println(indent + "looseUnmarshalMessageContent(wireFormat, info, dataIn);");
+        }
         else if (type.equals("byte[]") || type.equals("ByteSequence")) {
             if (size != null) {
                 out.println(indent + "info->" + setter + "(looseUnmarshalConstByteArray(dataIn, " + size.asInt() + "));");
@@ -525,6 +545,9 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
             else if( type.equals("String") ) {
                 out.println(indent + "looseMarshalString(" + getter + ", dataOut);");
             }
+            else if (isMessageContent(property)) {
+                out.println(indent + "looseMarshalMessageContent(info, dataOut);");
+            }
             else if( type.equals("byte[]") || type.equals("ByteSequence") ) {
                 if(size != null) {
                     out.println(indent + "dataOut->write((const unsigned char*)(&" + getter + "[0]), " + size.asInt() + ", 0, " + size.asInt() + ");");
@@ -623,7 +646,7 @@ out.println("");
 
         String properClassName = getProperClassName( jclass.getSimpleName() );
 out.println("        "+properClassName+"* info =");
-out.println("            dynamic_cast<"+properClassName+"*>(dataStructure);");
+out.println("            static_cast<"+properClassName+"*>(dataStructure);");
     }
 
     if( marshallerAware ) {
@@ -659,7 +682,7 @@ out.println("");
     if( checkNeedsInfoPointerTM1() ) {
         String properClassName = getProperClassName( jclass.getSimpleName() );
 out.println("        "+properClassName+"* info =");
-out.println("            dynamic_cast<"+properClassName+"*>(dataStructure);");
+out.println("            static_cast<"+properClassName+"*>(dataStructure);");
 out.println("");
     }
 
@@ -696,7 +719,7 @@ out.println("");
     if( checkNeedsInfoPointerTM2() ) {
         String properClassName = getProperClassName( jclass.getSimpleName() );
 out.println("        "+properClassName+"* info =");
-out.println("            dynamic_cast<"+properClassName+"*>(dataStructure);");
+out.println("            static_cast<"+properClassName+"*>(dataStructure);");
     }
 
     if( checkNeedsWireFormatVersion() ) {
@@ -727,7 +750,7 @@ out.println("        "+baseClass+"::looseUnmarshal(wireFormat, dataStructure, da
     if( !properties.isEmpty() || marshallerAware ) {
         String properClassName = getProperClassName( jclass.getSimpleName() );
 out.println("        "+properClassName+"* info =");
-out.println("            dynamic_cast<"+properClassName+"*>(dataStructure);");
+out.println("            static_cast<"+properClassName+"*>(dataStructure);");
     }
 
     if( marshallerAware ) {
@@ -761,7 +784,7 @@ out.println("");
     if( !properties.isEmpty() || marshallerAware ) {
         String properClassName = getProperClassName( jclass.getSimpleName() );
 out.println("        "+properClassName+"* info =");
-out.println("            dynamic_cast<"+properClassName+"*>(dataStructure);");
+out.println("            static_cast<"+properClassName+"*>(dataStructure);");
     }
 
     if( marshallerAware ) {
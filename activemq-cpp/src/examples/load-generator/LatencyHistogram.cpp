@@ -0,0 +1,161 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace cms;
+using namespace cms::loadgen;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Values below SUB_BUCKET_COUNT are counted exactly, every doubling above that
+    // adds another SUB_BUCKET_HALF_COUNT slots.
+    const int SUB_BUCKET_HALF_COUNT_MAGNITUDE = 10;
+    const int SUB_BUCKET_HALF_COUNT = 1 << SUB_BUCKET_HALF_COUNT_MAGNITUDE;
+    const int SUB_BUCKET_COUNT = SUB_BUCKET_HALF_COUNT * 2;
+
+    int highestBit(long long value) {
+        int bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const long long LatencyHistogram::HIGHEST_TRACKABLE_VALUE = 3600LL * 1000 * 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyHistogram::LatencyHistogram() :
+    counts(indexOf(HIGHEST_TRACKABLE_VALUE) + 1, 0), totalCount(0), overflowCount(0), minValue(0), maxValue(0), sum(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyHistogram::~LatencyHistogram() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LatencyHistogram::indexOf(long long value) {
+
+    if (value < SUB_BUCKET_COUNT) {
+        return (int) value;
+    }
+
+    int shift = highestBit(value) - SUB_BUCKET_HALF_COUNT_MAGNITUDE;
+    return (shift + 1) * SUB_BUCKET_HALF_COUNT + (int) ((value >> shift) - SUB_BUCKET_HALF_COUNT);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LatencyHistogram::highestEquivalentValue(int index) {
+
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    int shift = index / SUB_BUCKET_HALF_COUNT - 1;
+    long long subBucket = index % SUB_BUCKET_HALF_COUNT + SUB_BUCKET_HALF_COUNT;
+    return (subBucket << shift) + (1LL << shift) - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogram::record(long long micros) {
+
+    long long value = std::max(0LL, micros);
+    if (value > HIGHEST_TRACKABLE_VALUE) {
+        this->overflowCount++;
+        value = HIGHEST_TRACKABLE_VALUE;
+    }
+
+    this->counts[indexOf(value)]++;
+
+    if (this->totalCount == 0 || value < this->minValue) {
+        this->minValue = value;
+    }
+    if (value > this->maxValue) {
+        this->maxValue = value;
+    }
+
+    this->totalCount++;
+    this->sum += (double) value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogram::add(const LatencyHistogram& other) {
+
+    if (other.totalCount == 0) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < this->counts.size(); ++i) {
+        this->counts[i] += other.counts[i];
+    }
+
+    if (this->totalCount == 0 || other.minValue < this->minValue) {
+        this->minValue = other.minValue;
+    }
+    this->maxValue = std::max(this->maxValue, other.maxValue);
+    this->totalCount += other.totalCount;
+    this->overflowCount += other.overflowCount;
+    this->sum += other.sum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LatencyHistogram::getValueAtPercentile(double percentile) const {
+
+    if (this->totalCount == 0) {
+        return 0;
+    }
+
+    double fraction = std::min(std::max(percentile, 0.0), 100.0) / 100.0;
+    long long target = std::max(1LL, (long long) std::ceil(fraction * (double) this->totalCount));
+
+    long long seen = 0;
+    for (std::size_t i = 0; i < this->counts.size(); ++i) {
+        seen += this->counts[i];
+        if (seen >= target) {
+            return std::min(highestEquivalentValue((int) i), this->maxValue);
+        }
+    }
+
+    return this->maxValue;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string LatencyHistogram::toJson() const {
+
+    static const double PERCENTILES[] = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+    static const char* NAMES[] = { "p50", "p90", "p99", "p999", "p9999" };
+
+    std::ostringstream stream;
+    stream << "{\"count\": " << this->totalCount
+           << ", \"overflows\": " << this->overflowCount
+           << ", \"min\": " << getMin()
+           << ", \"mean\": " << (long long) getMean();
+
+    for (int i = 0; i < 5; ++i) {
+        stream << ", \"" << NAMES[i] << "\": " << getValueAtPercentile(PERCENTILES[i]);
+    }
+
+    stream << ", \"max\": " << this->maxValue << "}";
+    return stream.str();
+}
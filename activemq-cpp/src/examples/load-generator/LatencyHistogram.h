@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _CMS_LOADGEN_LATENCYHISTOGRAM_H_
+#define _CMS_LOADGEN_LATENCYHISTOGRAM_H_
+
+#include <decaf/util/Config.h>
+
+#include <string>
+#include <vector>
+
+namespace cms {
+namespace loadgen {
+
+    /**
+     * Fixed memory latency histogram in the style of HdrHistogram.  Values are recorded
+     * in microseconds into log-linear buckets, every power of two range is split into
+     * 1024 sub buckets so any recorded value is reported with better than 0.1% error.
+     * Values above one hour are counted as overflows and recorded as the maximum.
+     *
+     * The histogram is not thread safe, give each recording thread its own instance and
+     * combine them with add() once recording is done.
+     */
+    class LatencyHistogram {
+    private:
+
+        std::vector<long long> counts;
+        long long totalCount;
+        long long overflowCount;
+        long long minValue;
+        long long maxValue;
+        double sum;
+
+    public:
+
+        static const long long HIGHEST_TRACKABLE_VALUE;
+
+    public:
+
+        LatencyHistogram();
+        virtual ~LatencyHistogram();
+
+        /**
+         * Records one value, negative values are recorded as zero.
+         *
+         * @param micros
+         *      The latency in microseconds.
+         */
+        void record(long long micros);
+
+        /**
+         * Adds every value recorded by the other histogram to this one.
+         */
+        void add(const LatencyHistogram& other);
+
+        long long getTotalCount() const {
+            return this->totalCount;
+        }
+
+        long long getOverflowCount() const {
+            return this->overflowCount;
+        }
+
+        long long getMin() const {
+            return this->totalCount == 0 ? 0 : this->minValue;
+        }
+
+        long long getMax() const {
+            return this->maxValue;
+        }
+
+        double getMean() const {
+            return this->totalCount == 0 ? 0.0 : this->sum / (double) this->totalCount;
+        }
+
+        /**
+         * Gets the highest value that is equivalent, within the histogram's precision,
+         * to the value at the given percentile.
+         *
+         * @param percentile
+         *      The percentile in the range [0, 100].
+         *
+         * @return the value in microseconds, zero when nothing was recorded.
+         */
+        long long getValueAtPercentile(double percentile) const;
+
+        /**
+         * @return a JSON object holding the count, min, max, mean and the common percentiles.
+         */
+        std::string toJson() const;
+
+    private:
+
+        static int indexOf(long long value);
+        static long long highestEquivalentValue(int index);
+
+    };
+
+}}
+
+#endif /** _CMS_LOADGEN_LATENCYHISTOGRAM_H_ */
@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LoadConsumer.h"
+#include "LoadProducer.h"
+
+#include <decaf/lang/System.h>
+
+using namespace cms;
+using namespace cms::loadgen;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+LoadConsumer::LoadConsumer(cms::Session* session, const cms::Destination* destination,
+                           long long measureFrom, AtomicInteger* received) :
+    consumer(), measureFrom(measureFrom), received(received), endToEnd(), service() {
+
+    this->consumer.reset(session->createConsumer(destination));
+    this->consumer->setMessageListener(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoadConsumer::~LoadConsumer() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoadConsumer::close() {
+    if (this->consumer.get() != NULL) {
+        this->consumer->close();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoadConsumer::onMessage(const cms::Message* message) {
+
+    long long now = System::nanoTime();
+
+    try {
+        long long intended = message->getLongProperty(LoadProducer::INTENDED_TIME_PROPERTY);
+        long long sent = message->getLongProperty(LoadProducer::SEND_TIME_PROPERTY);
+
+        if (intended >= this->measureFrom) {
+            this->endToEnd.record((now - intended) / 1000);
+            this->service.record((now - sent) / 1000);
+        }
+    } catch (CMSException& ex) {
+        // Not one of ours, count it all the same so the totals show the stray traffic.
+    }
+
+    this->received->incrementAndGet();
+}
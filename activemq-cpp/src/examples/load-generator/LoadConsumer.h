@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _CMS_LOADGEN_LOADCONSUMER_H_
+#define _CMS_LOADGEN_LOADCONSUMER_H_
+
+#include <decaf/util/Config.h>
+
+#include <cms/MessageListener.h>
+#include <cms/MessageConsumer.h>
+#include <cms/Session.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include "LatencyHistogram.h"
+
+#include <memory>
+
+namespace cms {
+namespace loadgen {
+
+    /**
+     * Receives the generated messages on one consumer and records, for each message
+     * sent after the warm up, the latency from the time the producer intended to send
+     * it and the latency from the time the send actually started.  The first of these
+     * is free of coordinated omission, a producer that falls behind its schedule does
+     * not hide the delay from the results.
+     */
+    class LoadConsumer : public cms::MessageListener {
+    private:
+
+        std::auto_ptr<cms::MessageConsumer> consumer;
+        long long measureFrom;
+        decaf::util::concurrent::atomic::AtomicInteger* received;
+
+        LatencyHistogram endToEnd;
+        LatencyHistogram service;
+
+    private:
+
+        LoadConsumer(const LoadConsumer&);
+        LoadConsumer& operator=(const LoadConsumer&);
+
+    public:
+
+        /**
+         * Creates the consumer on the session and starts listening.
+         *
+         * @param measureFrom
+         *      Messages whose intended send time, in System::nanoTime(), is earlier are
+         *      counted but not recorded.
+         * @param received
+         *      Counter incremented for every message received, shared by all consumers.
+         */
+        LoadConsumer(cms::Session* session, const cms::Destination* destination,
+                     long long measureFrom, decaf::util::concurrent::atomic::AtomicInteger* received);
+
+        virtual ~LoadConsumer();
+
+        virtual void onMessage(const cms::Message* message);
+
+        void close();
+
+        const LatencyHistogram& getEndToEndLatency() const {
+            return this->endToEnd;
+        }
+
+        const LatencyHistogram& getServiceLatency() const {
+            return this->service;
+        }
+
+    };
+
+}}
+
+#endif /** _CMS_LOADGEN_LOADCONSUMER_H_ */
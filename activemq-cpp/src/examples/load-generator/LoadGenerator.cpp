@@ -0,0 +1,374 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/library/ActiveMQCPP.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
+
+#include <cms/Connection.h>
+#include <cms/Session.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/NumberFormatException.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include "LatencyHistogram.h"
+#include "LoadConsumer.h"
+#include "LoadProducer.h"
+#include "LoadSettings.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <stdio.h>
+
+using namespace cms;
+using namespace cms::loadgen;
+using namespace activemq::core;
+using namespace activemq::library;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const long long NANOS_PER_SECOND = 1000000000LL;
+
+    // Time allowed for creating the producers and consumers before the first send.
+    const long long SETUP_NANOS = NANOS_PER_SECOND;
+
+    // A drain ends once the consumers go this long without receiving anything.
+    const long long DRAIN_IDLE_NANOS = 5 * NANOS_PER_SECOND;
+
+    void usage(const char* program) {
+        printf("Usage: %s [options]\n", program);
+        printf(" -u uri  : Broker URI (default is tcp://127.0.0.1:61616)\n");
+        printf(" -d name : Destination name (default is 'loadgen')\n");
+        printf(" -T      : Use a topic instead of a queue\n");
+        printf(" -P      : Send persistent messages (default is non-persistent)\n");
+        printf(" -c #    : Number of connections (default is 1)\n");
+        printf(" -s #    : Number of producer sessions and of consumer sessions per connection (default is 1)\n");
+        printf(" -p #    : Number of producers per session (default is 1)\n");
+        printf(" -q #    : Number of consumers per session (default is 1, 0 only produces)\n");
+        printf(" -r #    : Total messages per second over all producers (default is 1000, 0 is unthrottled)\n");
+        printf(" -w #    : Seconds of warm up that are not recorded (default is 2)\n");
+        printf(" -t #    : Seconds to record after the warm up (default is 10)\n");
+        printf(" -m dist : Message size distribution, one of fixed:SIZE, uniform:MIN:MAX or\n");
+        printf("           exponential:MEAN (default is fixed:1024)\n");
+        printf(" -x #    : Seed for the message size choices (default is 0)\n");
+        printf(" -o file : Write the JSON results to the file instead of standard output\n");
+        printf("\n");
+        printf("Latencies are reported in microseconds.  The send and end to end latencies are measured\n");
+        printf("from the time each message was scheduled to go out, so a stalled producer shows up in the\n");
+        printf("results instead of quietly lowering the rate.  The service latency is measured from the\n");
+        printf("time the send actually started.\n");
+    }
+
+    bool parseArguments(int argc, char** argv, LoadSettings& settings) {
+
+        try {
+            for (int i = 1; i < argc; i++) {
+                std::string option = argv[i];
+                if (option.size() != 2 || option[0] != '-') {
+                    return false;
+                }
+
+                // Flags that take no value.
+                if (option[1] == 'T') {
+                    settings.topic = true;
+                    continue;
+                } else if (option[1] == 'P') {
+                    settings.persistent = true;
+                    continue;
+                }
+
+                if (i + 1 >= argc) {
+                    return false;
+                }
+                std::string value = argv[++i];
+
+                switch (option[1]) {
+                    case 'u':
+                        settings.uri = value;
+                        break;
+                    case 'd':
+                        settings.destination = value;
+                        break;
+                    case 'c':
+                        settings.connections = Integer::parseInt(value);
+                        break;
+                    case 's':
+                        settings.sessions = Integer::parseInt(value);
+                        break;
+                    case 'p':
+                        settings.producers = Integer::parseInt(value);
+                        break;
+                    case 'q':
+                        settings.consumers = Integer::parseInt(value);
+                        break;
+                    case 'r':
+                        settings.rate = Integer::parseInt(value);
+                        break;
+                    case 'w':
+                        settings.warmupSeconds = Integer::parseInt(value);
+                        break;
+                    case 't':
+                        settings.durationSeconds = Integer::parseInt(value);
+                        break;
+                    case 'm':
+                        settings.sizes = SizeDistribution::parse(value);
+                        break;
+                    case 'x':
+                        settings.seed = Integer::parseInt(value);
+                        break;
+                    case 'o':
+                        settings.output = value;
+                        break;
+                    default:
+                        return false;
+                }
+            }
+        } catch (NumberFormatException& ex) {
+            return false;
+        } catch (IllegalArgumentException& ex) {
+            printf("%s\n", ex.getMessage().c_str());
+            return false;
+        }
+
+        return settings.connections > 0 && settings.sessions > 0 && settings.producers >= 0 &&
+               settings.consumers >= 0 && settings.rate >= 0 && settings.warmupSeconds >= 0 &&
+               settings.durationSeconds > 0;
+    }
+
+    std::string quote(const std::string& value) {
+        std::string result = "\"";
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            if (value[i] == '"' || value[i] == '\\') {
+                result += '\\';
+            }
+            result += value[i];
+        }
+        return result + "\"";
+    }
+
+    std::string toJson(const LoadSettings& settings, double elapsed, int sent, int received, int errors,
+                       const LatencyHistogram& send, const LatencyHistogram& endToEnd,
+                       const LatencyHistogram& service) {
+
+        std::ostringstream stream;
+        stream << "{\n"
+               << "  \"settings\": {\n"
+               << "    \"uri\": " << quote(settings.uri) << ",\n"
+               << "    \"destination\": " << quote(settings.destination) << ",\n"
+               << "    \"topic\": " << (settings.topic ? "true" : "false") << ",\n"
+               << "    \"persistent\": " << (settings.persistent ? "true" : "false") << ",\n"
+               << "    \"connections\": " << settings.connections << ",\n"
+               << "    \"sessions\": " << settings.sessions << ",\n"
+               << "    \"producers\": " << settings.producers << ",\n"
+               << "    \"consumers\": " << settings.consumers << ",\n"
+               << "    \"rate\": " << settings.rate << ",\n"
+               << "    \"warmupSeconds\": " << settings.warmupSeconds << ",\n"
+               << "    \"durationSeconds\": " << settings.durationSeconds << ",\n"
+               << "    \"sizes\": " << quote(settings.sizes.toString()) << "\n"
+               << "  },\n"
+               << "  \"elapsedSeconds\": " << elapsed << ",\n"
+               << "  \"sent\": " << sent << ",\n"
+               << "  \"received\": " << received << ",\n"
+               << "  \"sendErrors\": " << errors << ",\n"
+               << "  \"sendRate\": " << (long long) (send.getTotalCount() / (double) settings.durationSeconds) << ",\n"
+               << "  \"receiveRate\": " << (long long) (endToEnd.getTotalCount() / (double) settings.durationSeconds) << ",\n"
+               << "  \"latencyMicros\": {\n"
+               << "    \"send\": " << send.toJson() << ",\n"
+               << "    \"endToEnd\": " << endToEnd.toJson() << ",\n"
+               << "    \"service\": " << service.toJson() << "\n"
+               << "  }\n"
+               << "}\n";
+
+        return stream.str();
+    }
+
+    void progress(long long begin, AtomicInteger& sent, AtomicInteger& received, AtomicInteger& errors) {
+        fprintf(stderr, "[%4llds] sent=%d received=%d errors=%d\n",
+                (System::nanoTime() - begin) / NANOS_PER_SECOND, sent.get(), received.get(), errors.get());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv) {
+
+    LoadSettings settings;
+    if (!parseArguments(argc, argv, settings)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    ActiveMQCPP::initializeLibrary();
+
+    int result = 0;
+
+    std::vector<cms::Connection*> connections;
+    std::vector<cms::Session*> sessions;
+    std::vector<cms::Destination*> destinations;
+    std::vector<LoadConsumer*> consumers;
+    std::vector<LoadProducer*> producers;
+    std::vector<Thread*> threads;
+
+    AtomicInteger sent;
+    AtomicInteger received;
+    AtomicInteger errors;
+
+    try {
+
+        ActiveMQConnectionFactory factory(settings.uri);
+
+        for (int i = 0; i < settings.connections; ++i) {
+            connections.push_back(factory.createConnection());
+            connections.back()->start();
+        }
+
+        long long startTime = System::nanoTime() + SETUP_NANOS;
+        long long measureFrom = startTime + settings.warmupSeconds * NANOS_PER_SECOND;
+        long long endTime = measureFrom + settings.durationSeconds * NANOS_PER_SECOND;
+
+        int producerSessions = settings.producers > 0 ? settings.connections * settings.sessions : 0;
+        long long interval = settings.rate > 0 && producerSessions > 0 ?
+            producerSessions * NANOS_PER_SECOND / settings.rate : 0;
+
+        for (int i = 0; i < settings.connections; ++i) {
+            for (int j = 0; j < settings.sessions; ++j) {
+
+                if (settings.consumers > 0) {
+                    sessions.push_back(connections[i]->createSession(Session::AUTO_ACKNOWLEDGE));
+                    destinations.push_back(settings.topic ?
+                        (cms::Destination*) sessions.back()->createTopic(settings.destination) :
+                        (cms::Destination*) sessions.back()->createQueue(settings.destination));
+                    for (int k = 0; k < settings.consumers; ++k) {
+                        consumers.push_back(new LoadConsumer(sessions.back(), destinations.back(), measureFrom, &received));
+                    }
+                }
+
+                if (settings.producers > 0) {
+                    sessions.push_back(connections[i]->createSession(Session::AUTO_ACKNOWLEDGE));
+                    destinations.push_back(settings.topic ?
+                        (cms::Destination*) sessions.back()->createTopic(settings.destination) :
+                        (cms::Destination*) sessions.back()->createQueue(settings.destination));
+                    producers.push_back(new LoadProducer(sessions.back(), destinations.back(), settings.producers,
+                        settings.persistent, settings.sizes, settings.seed + (int) producers.size(), interval,
+                        startTime, measureFrom, endTime, &sent, &errors));
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < producers.size(); ++i) {
+            threads.push_back(new Thread(producers[i], "LoadProducer-" + Integer::toString((int) i)));
+            threads.back()->start();
+        }
+
+        long long begin = System::nanoTime();
+        while (System::nanoTime() < endTime) {
+            Thread::sleep(1000);
+            progress(begin, sent, received, errors);
+        }
+
+        for (std::size_t i = 0; i < threads.size(); ++i) {
+            threads[i]->join();
+        }
+
+        // Give the consumers a chance to take everything that was sent.
+        if (!consumers.empty()) {
+            long long expected = settings.topic ?
+                (long long) sent.get() * settings.consumers * settings.sessions * settings.connections : sent.get();
+            int last = received.get();
+            long long lastProgress = System::nanoTime();
+            while (received.get() < expected && System::nanoTime() - lastProgress < DRAIN_IDLE_NANOS) {
+                Thread::sleep(100);
+                if (received.get() != last) {
+                    last = received.get();
+                    lastProgress = System::nanoTime();
+                }
+            }
+            progress(begin, sent, received, errors);
+        }
+
+        double elapsed = (double) (System::nanoTime() - startTime) / NANOS_PER_SECOND;
+
+        for (std::size_t i = 0; i < producers.size(); ++i) {
+            producers[i]->close();
+        }
+        for (std::size_t i = 0; i < consumers.size(); ++i) {
+            consumers[i]->close();
+        }
+        for (std::size_t i = 0; i < connections.size(); ++i) {
+            connections[i]->close();
+        }
+
+        LatencyHistogram send;
+        LatencyHistogram endToEnd;
+        LatencyHistogram service;
+
+        for (std::size_t i = 0; i < producers.size(); ++i) {
+            send.add(producers[i]->getSendLatency());
+        }
+        for (std::size_t i = 0; i < consumers.size(); ++i) {
+            endToEnd.add(consumers[i]->getEndToEndLatency());
+            service.add(consumers[i]->getServiceLatency());
+        }
+
+        std::string json = toJson(settings, elapsed, sent.get(), received.get(), errors.get(), send, endToEnd, service);
+
+        if (settings.output.empty()) {
+            std::cout << json;
+        } else {
+            std::ofstream file(settings.output.c_str());
+            file << json;
+            if (!file) {
+                fprintf(stderr, "Failed to write the results to %s\n", settings.output.c_str());
+                result = 1;
+            }
+        }
+
+    } catch (CMSException& ex) {
+        fprintf(stderr, "Load generation failed: %s\n", ex.getMessage().c_str());
+        result = 1;
+    }
+
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        delete threads[i];
+    }
+    for (std::size_t i = 0; i < producers.size(); ++i) {
+        delete producers[i];
+    }
+    for (std::size_t i = 0; i < consumers.size(); ++i) {
+        delete consumers[i];
+    }
+    for (std::size_t i = 0; i < destinations.size(); ++i) {
+        delete destinations[i];
+    }
+    for (std::size_t i = 0; i < sessions.size(); ++i) {
+        delete sessions[i];
+    }
+    for (std::size_t i = 0; i < connections.size(); ++i) {
+        delete connections[i];
+    }
+
+    ActiveMQCPP::shutdownLibrary();
+
+    return result;
+}
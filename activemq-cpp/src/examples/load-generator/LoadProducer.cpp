@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LoadProducer.h"
+
+#include <cms/BytesMessage.h>
+#include <cms/DeliveryMode.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+
+#include <memory>
+
+using namespace cms;
+using namespace cms::loadgen;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+const char* LoadProducer::INTENDED_TIME_PROPERTY = "LoadGenIntendedTime";
+const char* LoadProducer::SEND_TIME_PROPERTY = "LoadGenSendTime";
+
+////////////////////////////////////////////////////////////////////////////////
+LoadProducer::LoadProducer(cms::Session* session, const cms::Destination* destination, int count,
+                           bool persistent, const SizeDistribution& sizes, int seed, long long interval,
+                           long long startTime, long long measureFrom, long long endTime,
+                           AtomicInteger* sent, AtomicInteger* errors) :
+    session(session), producers(), sizes(sizes), random(seed), payload(sizes.getMaximum() + 1, 'x'),
+    interval(interval), startTime(startTime), measureFrom(measureFrom), endTime(endTime),
+    sent(sent), errors(errors), sendLatency() {
+
+    for (int i = 0; i < count; ++i) {
+        this->producers.push_back(session->createProducer(destination));
+        this->producers.back()->setDeliveryMode(persistent ? DeliveryMode::PERSISTENT : DeliveryMode::NON_PERSISTENT);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoadProducer::~LoadProducer() {
+    try {
+        close();
+    } catch (...) {
+    }
+
+    for (std::size_t i = 0; i < this->producers.size(); ++i) {
+        delete this->producers[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoadProducer::close() {
+    for (std::size_t i = 0; i < this->producers.size(); ++i) {
+        this->producers[i]->close();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoadProducer::waitUntil(long long deadline) {
+
+    long long remaining = deadline - System::nanoTime();
+
+    // Sleep off the bulk of the wait and spin the last couple of milliseconds, the
+    // sleep granularity is far too coarse for the intervals used at high rates.
+    if (remaining > 2000000) {
+        Thread::sleep((remaining - 1000000) / 1000000);
+    }
+
+    while (System::nanoTime() < deadline) {
+        Thread::yield();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoadProducer::run() {
+
+    if (this->producers.empty()) {
+        return;
+    }
+
+    std::size_t next = 0;
+    long long intended = this->startTime;
+
+    waitUntil(intended);
+
+    while (intended < this->endTime) {
+
+        std::auto_ptr<BytesMessage> message(
+            this->session->createBytesMessage(&this->payload[0], this->sizes.next(this->random)));
+        message->setLongProperty(INTENDED_TIME_PROPERTY, intended);
+
+        long long begin = System::nanoTime();
+        message->setLongProperty(SEND_TIME_PROPERTY, begin);
+
+        try {
+            this->producers[next]->send(message.get());
+            this->sent->incrementAndGet();
+        } catch (CMSException& ex) {
+            this->errors->incrementAndGet();
+        }
+
+        long long end = System::nanoTime();
+        if (intended >= this->measureFrom) {
+            this->sendLatency.record((end - intended) / 1000);
+        }
+
+        next = (next + 1) % this->producers.size();
+
+        if (this->interval > 0) {
+            intended += this->interval;
+            waitUntil(intended);
+        } else {
+            intended = end;
+        }
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _CMS_LOADGEN_LOADPRODUCER_H_
+#define _CMS_LOADGEN_LOADPRODUCER_H_
+
+#include <decaf/util/Config.h>
+
+#include <cms/Destination.h>
+#include <cms/MessageProducer.h>
+#include <cms/Session.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/Random.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include "LatencyHistogram.h"
+#include "SizeDistribution.h"
+
+#include <vector>
+
+namespace cms {
+namespace loadgen {
+
+    /**
+     * Sends the generated load for one session, cycling over the session's producers.
+     *
+     * Sends follow a fixed schedule computed from the start time and the send interval
+     * rather than from the completion of the previous send, so a slow send delays the
+     * ones after it without lowering the offered rate.  Each message carries the time
+     * it was scheduled and the time its send started, and the send latency is recorded
+     * from the scheduled time.  With an interval of zero every send is scheduled for
+     * the moment the previous one completed.
+     */
+    class LoadProducer : public decaf::lang::Runnable {
+    public:
+
+        static const char* INTENDED_TIME_PROPERTY;
+        static const char* SEND_TIME_PROPERTY;
+
+    private:
+
+        cms::Session* session;
+        std::vector<cms::MessageProducer*> producers;
+        SizeDistribution sizes;
+        decaf::util::Random random;
+        std::vector<unsigned char> payload;
+
+        long long interval;
+        long long startTime;
+        long long measureFrom;
+        long long endTime;
+
+        decaf::util::concurrent::atomic::AtomicInteger* sent;
+        decaf::util::concurrent::atomic::AtomicInteger* errors;
+
+        LatencyHistogram sendLatency;
+
+    private:
+
+        LoadProducer(const LoadProducer&);
+        LoadProducer& operator=(const LoadProducer&);
+
+    public:
+
+        /**
+         * Creates the producers on the given session.  All times are in System::nanoTime().
+         *
+         * @param interval
+         *      Nanoseconds between scheduled sends, zero to send back to back.
+         * @param startTime
+         *      Time of the first scheduled send.
+         * @param measureFrom
+         *      Sends scheduled before this time are not recorded.
+         * @param endTime
+         *      No send is scheduled at or after this time.
+         */
+        LoadProducer(cms::Session* session, const cms::Destination* destination, int count,
+                     bool persistent, const SizeDistribution& sizes, int seed, long long interval,
+                     long long startTime, long long measureFrom, long long endTime,
+                     decaf::util::concurrent::atomic::AtomicInteger* sent,
+                     decaf::util::concurrent::atomic::AtomicInteger* errors);
+
+        virtual ~LoadProducer();
+
+        virtual void run();
+
+        void close();
+
+        const LatencyHistogram& getSendLatency() const {
+            return this->sendLatency;
+        }
+
+    private:
+
+        static void waitUntil(long long deadline);
+
+    };
+
+}}
+
+#endif /** _CMS_LOADGEN_LOADPRODUCER_H_ */
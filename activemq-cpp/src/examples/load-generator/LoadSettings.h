@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _CMS_LOADGEN_LOADSETTINGS_H_
+#define _CMS_LOADGEN_LOADSETTINGS_H_
+
+#include <decaf/util/Config.h>
+
+#include "SizeDistribution.h"
+
+#include <string>
+
+namespace cms {
+namespace loadgen {
+
+    /**
+     * Every option of a load generator run.
+     */
+    struct LoadSettings {
+
+        std::string uri;
+        std::string destination;
+        bool topic;
+        bool persistent;
+
+        int connections;
+        int sessions;
+        int producers;
+        int consumers;
+
+        // Total messages per second over all producers, zero sends as fast as possible.
+        int rate;
+        int warmupSeconds;
+        int durationSeconds;
+        SizeDistribution sizes;
+        int seed;
+
+        std::string output;
+
+        LoadSettings() : uri("tcp://127.0.0.1:61616"), destination("loadgen"), topic(false), persistent(false),
+                         connections(1), sessions(1), producers(1), consumers(1), rate(1000),
+                         warmupSeconds(2), durationSeconds(10), sizes(), seed(0), output() {
+        }
+
+    };
+
+}}
+
+#endif /** _CMS_LOADGEN_LOADSETTINGS_H_ */
@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SizeDistribution.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/NumberFormatException.h>
+#include <decaf/util/StringTokenizer.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace cms;
+using namespace cms::loadgen;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+SizeDistribution::SizeDistribution() : type(FIXED), first(1024), second(1024) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SizeDistribution::~SizeDistribution() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SizeDistribution SizeDistribution::parse(const std::string& description) {
+
+    std::vector<std::string> parts;
+    StringTokenizer tokenizer(description, ":");
+    while (tokenizer.hasMoreTokens()) {
+        parts.push_back(tokenizer.nextToken());
+    }
+
+    SizeDistribution result;
+
+    try {
+        if (parts.size() == 2 && parts[0] == "fixed") {
+            result.type = FIXED;
+            result.first = result.second = Integer::parseInt(parts[1]);
+        } else if (parts.size() == 3 && parts[0] == "uniform") {
+            result.type = UNIFORM;
+            result.first = Integer::parseInt(parts[1]);
+            result.second = Integer::parseInt(parts[2]);
+        } else if (parts.size() == 2 && parts[0] == "exponential") {
+            result.type = EXPONENTIAL;
+            result.first = Integer::parseInt(parts[1]);
+            result.second = result.first * 16;
+        } else {
+            throw IllegalArgumentException(__FILE__, __LINE__,
+                "Unknown size distribution: %s", description.c_str());
+        }
+    } catch (NumberFormatException& ex) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Invalid size in distribution: %s", description.c_str());
+    }
+
+    if (result.first < 0 || result.second < result.first) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Invalid size range in distribution: %s", description.c_str());
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int SizeDistribution::next(Random& random) const {
+
+    switch (this->type) {
+        case UNIFORM:
+            return this->first + random.nextInt(this->second - this->first + 1);
+        case EXPONENTIAL: {
+            double size = -std::log(1.0 - random.nextDouble()) * this->first;
+            return size > this->second ? this->second : (int) size;
+        }
+        default:
+            return this->first;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int SizeDistribution::getMaximum() const {
+    return this->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string SizeDistribution::toString() const {
+
+    switch (this->type) {
+        case UNIFORM:
+            return "uniform:" + Integer::toString(this->first) + ":" + Integer::toString(this->second);
+        case EXPONENTIAL:
+            return "exponential:" + Integer::toString(this->first);
+        default:
+            return "fixed:" + Integer::toString(this->first);
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _CMS_LOADGEN_SIZEDISTRIBUTION_H_
+#define _CMS_LOADGEN_SIZEDISTRIBUTION_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/util/Random.h>
+
+#include <string>
+
+namespace cms {
+namespace loadgen {
+
+    /**
+     * Chooses the body size of each message sent.  Parsed from one of the forms
+     *
+     *   fixed:SIZE          every message has SIZE bytes
+     *   uniform:MIN:MAX     sizes spread evenly over [MIN, MAX]
+     *   exponential:MEAN    sizes drawn from an exponential distribution with the given
+     *                       mean, capped at sixteen times the mean
+     */
+    class SizeDistribution {
+    public:
+
+        enum Type {
+            FIXED,
+            UNIFORM,
+            EXPONENTIAL
+        };
+
+    private:
+
+        Type type;
+        int first;
+        int second;
+
+    public:
+
+        SizeDistribution();
+        virtual ~SizeDistribution();
+
+        /**
+         * Parses a distribution description.
+         *
+         * @throws IllegalArgumentException if the description is not valid.
+         */
+        static SizeDistribution parse(const std::string& description);
+
+        /**
+         * @return the size of the next message.
+         */
+        int next(decaf::util::Random& random) const;
+
+        /**
+         * @return the largest size next() can return.
+         */
+        int getMaximum() const;
+
+        /**
+         * @return the distribution in the form accepted by parse().
+         */
+        std::string toString() const;
+
+    };
+
+}}
+
+#endif /** _CMS_LOADGEN_SIZEDISTRIBUTION_H_ */
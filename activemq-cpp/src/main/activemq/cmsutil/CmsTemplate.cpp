@@ -75,7 +75,7 @@ const long long CmsTemplate::DEFAULT_TIME_TO_LIVE = 0;
 
 ////////////////////////////////////////////////////////////////////////////////
 CmsTemplate::CmsTemplate() : CmsDestinationAccessor(),
-                             connection(NULL),
+                             connection(),
                              sessionPools(),
                              defaultDestination(NULL),
                              defaultDestinationName(""),
@@ -87,14 +87,16 @@ CmsTemplate::CmsTemplate() : CmsDestinationAccessor(),
                              deliveryMode(0),
                              priority(0),
                              timeToLive(0),
-                             initialized(false) {
+                             threadSessionCacheSize(0),
+                             initialized(),
+                             mutex() {
 
     initDefaults();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 CmsTemplate::CmsTemplate( cms::ConnectionFactory* connectionFactory ) : CmsDestinationAccessor(),
-                                                                        connection(NULL),
+                                                                        connection(),
                                                                         sessionPools(),
                                                                         defaultDestination(NULL),
                                                                         defaultDestinationName(""),
@@ -106,7 +108,9 @@ CmsTemplate::CmsTemplate( cms::ConnectionFactory* connectionFactory ) : CmsDesti
                                                                         deliveryMode(0),
                                                                         priority(0),
                                                                         timeToLive(0),
-                                                                        initialized(false) {
+                                                                        threadSessionCacheSize(0),
+                                                                        initialized(),
+                                                                        mutex() {
 
     initDefaults();
     setConnectionFactory(connectionFactory);
@@ -122,7 +126,7 @@ CmsTemplate::~CmsTemplate() {
 
 ////////////////////////////////////////////////////////////////////////////////
 void CmsTemplate::initDefaults() {
-    initialized = false;
+    initialized.set(false);
     defaultDestination = NULL;
     defaultDestinationName = "";
     messageIdEnabled = true;
@@ -133,9 +137,10 @@ void CmsTemplate::initDefaults() {
     deliveryMode = cms::DeliveryMode::PERSISTENT;
     priority = DEFAULT_PRIORITY;
     timeToLive = DEFAULT_TIME_TO_LIVE;
+    threadSessionCacheSize = 0;
 
     // Initialize the connection object.
-    connection = NULL;
+    connection.set(NULL);
 
     // Initialize the session pools.
     for( int ix=0; ix<NUM_SESSION_POOLS; ++ix ) {
@@ -144,7 +149,7 @@ void CmsTemplate::initDefaults() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CmsTemplate::createSessionPools() {
+void CmsTemplate::createSessionPools(cms::Connection* connection) {
 
     // Make sure they're destroyed first.
     destroySessionPools();
@@ -153,7 +158,8 @@ void CmsTemplate::createSessionPools() {
      * Create the session pools.
      */
     for (int ix = 0; ix < NUM_SESSION_POOLS; ++ix) {
-        sessionPools[ix] = new SessionPool(connection, (cms::Session::AcknowledgeMode) ix, getResourceLifecycleManager());
+        sessionPools[ix] = new SessionPool(connection, (cms::Session::AcknowledgeMode) ix,
+                                           getResourceLifecycleManager(), threadSessionCacheSize);
     }
 }
 
@@ -176,12 +182,17 @@ void CmsTemplate::init() {
 
     try {
 
-        if (!initialized) {
+        if (!initialized.get()) {
 
-            // Invoke the base class.
-            CmsDestinationAccessor::init();
+            synchronized(&mutex) {
+                if (!initialized.get()) {
 
-            initialized = true;
+                    // Invoke the base class.
+                    CmsDestinationAccessor::init();
+
+                    initialized.set(true);
+                }
+            }
         }
     }
     CMSTEMPLATE_CATCH(IllegalStateException, this)
@@ -193,20 +204,23 @@ void CmsTemplate::destroy() {
 
     try {
 
-        // Mark as not initialized.
-        initialized = false;
+        synchronized(&mutex) {
+
+            // Mark as not initialized.
+            initialized.set(false);
 
-        // Clear the connection reference
-        connection = NULL;
+            // Clear the connection reference
+            connection.set(NULL);
 
-        // Clear the reference to the default destination.
-        defaultDestination = NULL;
+            // Clear the reference to the default destination.
+            defaultDestination = NULL;
 
-        // Destroy the session pools.
-        destroySessionPools();
+            // Destroy the session pools.
+            destroySessionPools();
 
-        // Call the base class.
-        CmsDestinationAccessor::destroy();
+            // Call the base class.
+            CmsDestinationAccessor::destroy();
+        }
     }
     CMSTEMPLATE_CATCH(IllegalStateException, this)
     CMSTEMPLATE_CATCHALL(this)
@@ -251,25 +265,55 @@ cms::Connection* CmsTemplate::getConnection() {
     try {
 
         // If we don't have a connection, create one.
-        if (connection == NULL) {
+        cms::Connection* current = connection.get();
+        if (current == NULL) {
+
+            synchronized(&mutex) {
+                current = connection.get();
+                if (current == NULL) {
+
+                    // Invoke the base class to create the connection and add it
+                    // to the resource lifecycle manager.
+                    cms::Connection* newConnection = createConnection();
 
-            // Invoke the base class to create the connection and add it
-            // to the resource lifecycle manager.
-            connection = createConnection();
+                    // Start the connection.
+                    newConnection->start();
 
-            // Start the connection.
-            connection->start();
+                    // Create the session pools, passing in this connection.
+                    createSessionPools(newConnection);
 
-            // Create the session pools, passing in this connection.
-            createSessionPools();
+                    // Published last, a caller that finds it set doesn't lock.
+                    connection.set(newConnection);
+                    current = newConnection;
+                }
+            }
         }
 
-        return connection;
+        return current;
     }
     CMSTEMPLATE_CATCH(IllegalStateException, this)
     CMSTEMPLATE_CATCHALL(this)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void CmsTemplate::releaseThreadSession() {
+
+    try {
+
+        // Without a connection there are no pools, and no sessions to release.
+        if (connection.get() == NULL) {
+            return;
+        }
+
+        for (int ix = 0; ix < NUM_SESSION_POOLS; ++ix) {
+            if (sessionPools[ix] != NULL) {
+                sessionPools[ix]->releaseThreadSession();
+            }
+        }
+    }
+    CMSTEMPLATE_CATCHALL(this)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 PooledSession* CmsTemplate::takeSession() {
 
@@ -664,6 +708,36 @@ cms::Destination* CmsTemplate::ResolveReceiveExecutor::getDestination(cms::Sessi
     CMSTEMPLATE_CATCHALL(parent)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void CmsTemplate::sendBatch(decaf::util::Iterator<MessageCreator*>* messageCreators) {
+
+    try {
+        BatchSendExecutor senderExecutor(messageCreators, this);
+        execute(&senderExecutor);
+    }
+    CMSTEMPLATE_CATCHALL(this)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CmsTemplate::sendBatch(cms::Destination* dest, decaf::util::Iterator<MessageCreator*>* messageCreators) {
+
+    try {
+        BatchSendExecutor senderExecutor(messageCreators, this);
+        execute(dest, &senderExecutor);
+    }
+    CMSTEMPLATE_CATCHALL(this)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CmsTemplate::sendBatch(const std::string& destinationName, decaf::util::Iterator<MessageCreator*>* messageCreators) {
+
+    try {
+        BatchSendExecutor senderExecutor(messageCreators, this);
+        execute(destinationName, &senderExecutor);
+    }
+    CMSTEMPLATE_CATCHALL(this)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::Message* CmsTemplate::receive() {
 
@@ -25,6 +25,10 @@
 #include <activemq/cmsutil/SessionPool.h>
 #include <cms/ConnectionFactory.h>
 #include <cms/DeliveryMode.h>
+#include <decaf/util/Iterator.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
 #include <string>
 
 namespace activemq {
@@ -53,6 +57,13 @@ namespace cmsutil {
      * having to provide callbacks altogether for sending messages, by calling
      * one of the <code>send</code> methods.
      *
+     * <p>
+     * A <code>CmsTemplate</code> may be shared between threads.  By default
+     * every operation checks a session out of a shared pool and returns it
+     * afterwards; with a thread session cache size set, each thread instead
+     * keeps a session, and the producers cached on it, for its own use until
+     * the cache is full, so that threads don't contend on the pool.
+     *
      * @see SessionCallback
      * @see ProducerCallback
      * @see MessageCreator
@@ -175,6 +186,38 @@ namespace cmsutil {
             }
         };
 
+        /**
+         * Session callback that sends a batch of messages to the given destination.
+         */
+        class BatchSendExecutor;
+        friend class BatchSendExecutor;
+        class BatchSendExecutor : public ProducerCallback {
+        private:
+
+            decaf::util::Iterator<MessageCreator*>* messageCreators;
+            CmsTemplate* parent;
+
+        private:
+
+            BatchSendExecutor(const BatchSendExecutor&);
+            BatchSendExecutor& operator=(const BatchSendExecutor&);
+
+        public:
+
+            BatchSendExecutor(decaf::util::Iterator<MessageCreator*>* messageCreators, CmsTemplate* parent) :
+                ProducerCallback(), messageCreators(messageCreators), parent(parent) {
+            }
+
+            virtual ~BatchSendExecutor() {
+            }
+
+            virtual void doInCms(cms::Session* session, cms::MessageProducer* producer) {
+                while (messageCreators->hasNext()) {
+                    parent->doSend(session, producer, messageCreators->next());
+                }
+            }
+        };
+
         /**
          * Session callback that receives from the given destination.
          */
@@ -245,7 +288,9 @@ namespace cmsutil {
 
         static const int NUM_SESSION_POOLS = (int)cms::Session::SESSION_TRANSACTED + 1;
 
-        cms::Connection* connection;
+        // Set once the session pools exist, a thread that reads it set without the
+        // mutex also sees the pools.
+        decaf::util::concurrent::atomic::AtomicReference<cms::Connection> connection;
 
         SessionPool* sessionPools[NUM_SESSION_POOLS];
 
@@ -269,7 +314,12 @@ namespace cmsutil {
 
         long long timeToLive;
 
-        bool initialized;
+        int threadSessionCacheSize;
+
+        decaf::util::concurrent::atomic::AtomicBoolean initialized;
+
+        // Guards the one time creation of the connection and session pools.
+        decaf::util::concurrent::Mutex mutex;
 
     private:
 
@@ -481,6 +531,45 @@ namespace cmsutil {
             return this->timeToLive;
         }
 
+        /**
+         * Sets the number of sessions that are kept by the threads using this
+         * template, zero (the default) keeps none and every operation borrows a
+         * session from the shared pool.  A thread that finds the cache full uses
+         * the shared pool.  Only the kept sessions are limited by this size, the
+         * shared pool still creates a session whenever all of its sessions are
+         * in use, so the sessions in total are the kept ones plus as many as
+         * threads beyond the cache ever used at once.  The session kept by a
+         * thread started through decaf goes back to the pool when that thread
+         * ends, any other thread must call releaseThreadSession() before it ends
+         * or its session stays kept.  Only takes effect if set before the first
+         * operation.
+         *
+         * @param size
+         *          the most sessions kept by threads at one time.
+         */
+        virtual void setThreadSessionCacheSize(int size) {
+            this->threadSessionCacheSize = size;
+        }
+
+        /**
+         * Returns the number of sessions that are kept by the threads using this
+         * template.
+         */
+        virtual int getThreadSessionCacheSize() const {
+            return this->threadSessionCacheSize;
+        }
+
+        /**
+         * Returns the sessions kept by the calling thread to the shared pool,
+         * the thread's next operation binds a session again if the cache has
+         * room.  Does nothing if the thread keeps no session.
+         *
+         * @throws cms::CMSException thrown if an error occurs.
+         *
+         * @since 3.10.0
+         */
+        virtual void releaseThreadSession();
+
         /**
          * Executes the given action within a CMS Session.
          * @param action
@@ -556,6 +645,43 @@ namespace cmsutil {
          */
         virtual void send(const std::string& destinationName, MessageCreator* messageCreator);
 
+        /**
+         * Sends a message for each of the given creators to the default destination,
+         * all with the one session and producer.
+         *
+         * @param messageCreators
+         *          Iterates over the creators of the messages to send, in order.
+         * @throws cms::CMSException thrown if an error occurs, the messages created
+         *          before it have been sent.
+         */
+        virtual void sendBatch(decaf::util::Iterator<MessageCreator*>* messageCreators);
+
+        /**
+         * Sends a message for each of the given creators to the specified destination,
+         * all with the one session and producer.
+         *
+         * @param dest
+         *          The destination to send to
+         * @param messageCreators
+         *          Iterates over the creators of the messages to send, in order.
+         * @throws cms::CMSException thrown if an error occurs, the messages created
+         *          before it have been sent.
+         */
+        virtual void sendBatch(cms::Destination* dest, decaf::util::Iterator<MessageCreator*>* messageCreators);
+
+        /**
+         * Sends a message for each of the given creators to the specified destination,
+         * all with the one session and producer.
+         *
+         * @param destinationName
+         *          The name of the destination to send to.
+         * @param messageCreators
+         *          Iterates over the creators of the messages to send, in order.
+         * @throws cms::CMSException thrown if an error occurs, the messages created
+         *          before it have been sent.
+         */
+        virtual void sendBatch(const std::string& destinationName, decaf::util::Iterator<MessageCreator*>* messageCreators);
+
         /**
          * Performs a synchronous read from the default destination.
          * @return the message
@@ -636,7 +762,7 @@ namespace cmsutil {
         /**
          * Creates the session pools objects.
          */
-        void createSessionPools();
+        void createSessionPools(cms::Connection* connection);
 
         /**
          * Destroys the session pool objects.
@@ -0,0 +1,162 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DemuxConsumer.h"
+
+#include <activemq/commands/Message.h>
+#include <activemq/util/CMSExceptionSupport.h>
+#include <cms/CMSException.h>
+#include <decaf/lang/Exception.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace activemq::selector;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+DemuxConsumer::DemuxConsumer(cms::MessageConsumer* consumer) :
+    consumer(consumer), exceptionListener(NULL), routes(new RouteList()), mutex() {
+
+    if (consumer == NULL) {
+        throw cms::CMSException("DemuxConsumer requires a MessageConsumer", NULL);
+    }
+
+    this->consumer->setMessageListener(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DemuxConsumer::~DemuxConsumer() {
+    try {
+        this->consumer->setMessageListener(NULL);
+    } catch (...) {
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumer::addListener(const std::string& selector, cms::MessageListener* listener) {
+
+    if (listener == NULL) {
+        throw cms::CMSException("DemuxConsumer listener can't be NULL", NULL);
+    }
+
+    Route route;
+    route.listener = listener;
+
+    if (selector.find_first_not_of(" \t\r\n\f") != std::string::npos) {
+        route.selector.reset(new Selector(selector));
+    }
+
+    synchronized(&this->mutex) {
+        Pointer<RouteList> updated(new RouteList(*this->routes));
+        updated->push_back(route);
+        this->routes = updated;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DemuxConsumer::removeListener(cms::MessageListener* listener) {
+
+    synchronized(&this->mutex) {
+        Pointer<RouteList> updated(new RouteList());
+        for (RouteList::const_iterator iter = this->routes->begin(); iter != this->routes->end(); ++iter) {
+            if (iter->listener != listener) {
+                updated->push_back(*iter);
+            }
+        }
+
+        if (updated->size() == this->routes->size()) {
+            return false;
+        }
+
+        this->routes = updated;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int DemuxConsumer::getListenerCount() const {
+
+    synchronized(&this->mutex) {
+        return (int) this->routes->size();
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumer::setExceptionListener(cms::ExceptionListener* listener) {
+
+    synchronized(&this->mutex) {
+        this->exceptionListener = listener;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::ExceptionListener* DemuxConsumer::getExceptionListener() const {
+
+    synchronized(&this->mutex) {
+        return this->exceptionListener;
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumer::onMessage(const cms::Message* message) {
+
+    const commands::Message* amqMessage = dynamic_cast<const commands::Message*>(message);
+
+    Pointer<RouteList> current;
+    cms::ExceptionListener* listener = NULL;
+    synchronized(&this->mutex) {
+        current = this->routes;
+        listener = this->exceptionListener;
+    }
+
+    // One listener failing must not stop the others, or fail the delivery and have
+    // the message redelivered to those that already handled it.
+    for (RouteList::const_iterator iter = current->begin(); iter != current->end(); ++iter) {
+        if (iter->selector == NULL ||
+            (amqMessage != NULL && iter->selector->matches(amqMessage))) {
+
+            try {
+                iter->listener->onMessage(message);
+            } catch (cms::CMSException& ex) {
+                fire(listener, ex);
+            } catch (decaf::lang::Exception& ex) {
+                fire(listener, util::CMSExceptionSupport::create(ex));
+            } catch (std::exception& ex) {
+                fire(listener, cms::CMSException(ex.what(), NULL));
+            } catch (...) {
+                fire(listener, cms::CMSException("DemuxConsumer listener threw an unknown exception", NULL));
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumer::fire(cms::ExceptionListener* listener, const cms::CMSException& ex) {
+
+    if (listener != NULL) {
+        try {
+            listener->onException(ex);
+        } catch (...) {
+        }
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _ACTIVEMQ_CMSUTIL_DEMUXCONSUMER_H_
+#define _ACTIVEMQ_CMSUTIL_DEMUXCONSUMER_H_
+
+#include <cms/ExceptionListener.h>
+#include <cms/Message.h>
+#include <cms/MessageConsumer.h>
+#include <cms/MessageListener.h>
+#include <activemq/util/Config.h>
+#include <activemq/selector/Selector.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace cmsutil {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * Shares one consumer between many local listeners, each with a selector of its
+     * own, so that a process interested in several subsets of a destination holds a
+     * single broker subscription rather than one per selector.
+     *
+     * The DemuxConsumer installs itself as the consumer's MessageListener.  Every
+     * message the consumer receives is matched against each listener's selector on
+     * the client, see activemq::selector::Selector, and handed to every listener that
+     * matches in the order the listeners were added.  A listener added with an empty
+     * selector receives every message.  Selectors can only be evaluated against the
+     * messages of this client, any other cms::Message is only given to the listeners
+     * without a selector.
+     *
+     * The message passed to the listeners is the one the consumer delivered and is
+     * shared by them, a listener that needs to keep it must clone it.  An exception
+     * thrown by a listener doesn't reach the consumer, where it would have the message
+     * redelivered to the listeners that already handled it.  It is reported to the
+     * ExceptionListener set with setExceptionListener, typically the Connection's, and
+     * the remaining listeners are still called.  Without an ExceptionListener the
+     * exception is dropped.
+     *
+     * Listeners can be added and removed while messages are being delivered, even
+     * from inside a listener.  No lock is held while the listeners are called, each
+     * delivery walks the routes as they were when it started, so a delivery already
+     * under way can still reach a listener after removeListener returns.  This class
+     * is thread-safe.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API DemuxConsumer : public cms::MessageListener {
+    private:
+
+        struct Route {
+            Pointer<selector::Selector> selector;
+            cms::MessageListener* listener;
+
+            Route() : selector(), listener(NULL) {}
+        };
+
+        typedef std::vector<Route> RouteList;
+
+        cms::MessageConsumer* consumer;
+
+        cms::ExceptionListener* exceptionListener;
+
+        // Replaced rather than modified so that a delivery can walk the list it
+        // started with while a listener adds or removes routes.
+        Pointer<RouteList> routes;
+
+        // Guards the routes pointer and the exception listener, never held while a
+        // listener is called.
+        mutable decaf::util::concurrent::Mutex mutex;
+
+    private:
+
+        DemuxConsumer(const DemuxConsumer&);
+        DemuxConsumer& operator=(const DemuxConsumer&);
+
+    public:
+
+        /**
+         * Creates a DemuxConsumer that takes over delivery for the given consumer.
+         *
+         * @param consumer
+         *      The consumer whose messages are routed, it is not owned and must
+         *      outlive this DemuxConsumer.
+         *
+         * @throws CMSException if the consumer is NULL or its listener can't be set.
+         */
+        DemuxConsumer(cms::MessageConsumer* consumer);
+
+        /**
+         * Clears the consumer's MessageListener.
+         */
+        virtual ~DemuxConsumer();
+
+        /**
+         * Adds a listener for the messages that match the given selector.  The same
+         * listener may be added more than once, with different selectors it is then
+         * called once for each selector that matches.
+         *
+         * @param selector
+         *      The JMS selector the messages must match, empty to receive every message.
+         * @param listener
+         *      The listener to call, it is not owned.
+         *
+         * @throws InvalidSelectorException if the selector is not valid.
+         * @throws CMSException if the listener is NULL.
+         */
+        void addListener(const std::string& selector, cms::MessageListener* listener);
+
+        /**
+         * Removes every route to the given listener.
+         *
+         * @param listener
+         *      The listener to remove.
+         *
+         * @return true if the listener had been added.
+         */
+        bool removeListener(cms::MessageListener* listener);
+
+        /**
+         * @return the number of listeners, counting a listener once for each time
+         *         it was added.
+         */
+        int getListenerCount() const;
+
+        /**
+         * Sets the listener told about exceptions thrown by the message listeners,
+         * usually the one set on the consumer's Connection.
+         *
+         * @param listener
+         *      The listener to notify, it is not owned, NULL to drop the exceptions.
+         */
+        void setExceptionListener(cms::ExceptionListener* listener);
+
+        /**
+         * @return the listener told about exceptions thrown by the message listeners,
+         *         or NULL if none is set.
+         */
+        cms::ExceptionListener* getExceptionListener() const;
+
+        /**
+         * @return the consumer whose messages are routed.
+         */
+        cms::MessageConsumer* getConsumer() const {
+            return this->consumer;
+        }
+
+    public:  // cms::MessageListener
+
+        virtual void onMessage(const cms::Message* message);
+
+    private:
+
+        void fire(cms::ExceptionListener* listener, const cms::CMSException& ex);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CMSUTIL_DEMUXCONSUMER_H_ */
@@ -17,6 +17,7 @@
 
 #include "DynamicDestinationResolver.h"
 #include "ResourceLifecycleManager.h"
+#include "PooledSession.h"
 #include <cms/CMSException.h>
 
 using namespace activemq::cmsutil;
@@ -83,13 +84,16 @@ DynamicDestinationResolver::~DynamicDestinationResolver() {
 ////////////////////////////////////////////////////////////////////////////////
 void DynamicDestinationResolver::destroy() {
 
-    // Destroy the session resolvers.
-    std::auto_ptr<Iterator<SessionResolver*> > sessionResolvers(sessionResolverMap.values().iterator());
-    while (sessionResolvers->hasNext()) {
-        delete sessionResolvers->next();
-    }
+    synchronized(&sessionResolverMap) {
+
+        // Destroy the session resolvers.
+        std::auto_ptr<Iterator<SessionResolver*> > sessionResolvers(sessionResolverMap.values().iterator());
+        while (sessionResolvers->hasNext()) {
+            delete sessionResolvers->next();
+        }
 
-    sessionResolverMap.clear();
+        sessionResolverMap.clear();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -99,13 +103,23 @@ cms::Destination* DynamicDestinationResolver::resolveDestinationName(cms::Sessio
         throw CMSException("destination name is invalid", NULL);
     }
 
-    // Get the resolver for this session.
+    // A pooled session keeps its own destinations, and is used by one thread
+    // at a time, so resolving through it doesn't lock the shared map.
+    PooledSession* pooledSession = dynamic_cast<PooledSession*>(session);
+    if (pooledSession != NULL) {
+        return pooledSession->resolveCachedDestination(destName, pubSubDomain);
+    }
+
+    // Get the resolver for this session, the map is shared by every thread
+    // using the resolver but each resolver is only used with its session.
     SessionResolver* resolver = NULL;
-    try {
-        resolver = sessionResolverMap.get(session);
-    } catch (decaf::util::NoSuchElementException& ex) {
-        resolver = new SessionResolver(session, resourceLifecycleManager);
-        sessionResolverMap.put(session, resolver);
+    synchronized(&sessionResolverMap) {
+        try {
+            resolver = sessionResolverMap.get(session);
+        } catch (decaf::util::NoSuchElementException& ex) {
+            resolver = new SessionResolver(session, resourceLifecycleManager);
+            sessionResolverMap.put(session, resolver);
+        }
     }
 
     // Return the appropriate destination.
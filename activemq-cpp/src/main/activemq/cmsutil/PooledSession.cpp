@@ -41,7 +41,7 @@ using namespace activemq::cmsutil;
 
 ////////////////////////////////////////////////////////////////////////////////
 PooledSession::PooledSession(SessionPool* pool, cms::Session* session) :
-    pool(pool), session(session), producerCache(), consumerCache() {
+    pool(pool), session(session), producerCache(), consumerCache(), destinationCache() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -159,6 +159,41 @@ cms::MessageConsumer* PooledSession::createCachedConsumer(const cms::Destination
     CMSTEMPLATE_CATCHALL()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+cms::Destination* PooledSession::resolveCachedDestination(const std::string& destName, bool pubSubDomain) {
+
+    try {
+
+        std::string key = pubSubDomain ? "[t:" : "[q:";
+        key += destName;
+        key += "]";
+
+        // Check the cache - add it if necessary.
+        cms::Destination* destination = NULL;
+        try {
+            destination = destinationCache.get(key);
+        } catch (decaf::util::NoSuchElementException& e) {
+
+            // Create the destination and hand it to the resource lifecycle
+            // manager, the cache only refers to it.
+            if (pubSubDomain) {
+                cms::Topic* topic = session->createTopic(destName);
+                pool->getResourceLifecycleManager()->addDestination(topic);
+                destination = topic;
+            } else {
+                cms::Queue* queue = session->createQueue(destName);
+                pool->getResourceLifecycleManager()->addDestination(queue);
+                destination = queue;
+            }
+
+            destinationCache.put(key, destination);
+        }
+
+        return destination;
+    }
+    CMSTEMPLATE_CATCHALL()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 std::string PooledSession::getUniqueDestName(const cms::Destination* dest) {
 
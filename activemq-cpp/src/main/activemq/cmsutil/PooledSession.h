@@ -45,6 +45,8 @@ namespace cmsutil {
 
         decaf::util::StlMap<std::string, CachedConsumer*> consumerCache;
 
+        decaf::util::StlMap<std::string, cms::Destination*> destinationCache;
+
     private:
 
         PooledSession(const PooledSession&);
@@ -164,6 +166,24 @@ namespace cmsutil {
          */
         virtual cms::MessageProducer* createCachedProducer(const cms::Destination* destination);
 
+        /**
+         * Resolves a destination name for this session, creating the topic or
+         * queue the first time the name is seen.  Only the thread holding the
+         * session uses its cache, so resolving takes no lock.
+         *
+         * @param destName
+         *      the name to be resolved.
+         * @param pubSubDomain
+         *      If true, the name will be resolved to a Topic, otherwise a Queue.
+         *
+         * @return the resolved destination, owned by the pool's ResourceLifecycleManager.
+         *
+         * @throws cms::CMSException if resolution failed.
+         *
+         * @since 3.10.0
+         */
+        virtual cms::Destination* resolveCachedDestination(const std::string& destName, bool pubSubDomain);
+
         virtual cms::QueueBrowser* createBrowser(const cms::Queue* queue);
 
         virtual cms::QueueBrowser* createBrowser(const cms::Queue* queue, const std::string& selector);
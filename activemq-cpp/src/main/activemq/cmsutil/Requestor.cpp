@@ -0,0 +1,332 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Requestor.h"
+
+#include <activemq/util/IdGenerator.h>
+#include <cms/CMSException.h>
+#include <cms/DeliveryMode.h>
+#include <cms/IllegalStateException.h>
+#include <decaf/lang/Exception.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/TimerTask.h>
+#include <decaf/util/concurrent/ExecutionException.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/TimeoutException.h>
+
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Number of timeouts cancelled by replies between purges of the timer.
+    const int PURGE_INTERVAL = 256;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace cmsutil {
+
+    class Requestor::PendingRequest {
+    private:
+
+        PendingRequest(const PendingRequest&);
+        PendingRequest& operator=(const PendingRequest&);
+
+    public:
+
+        std::string correlationId;
+        Pointer<ReplyFuture> future;
+        Pointer<TimerTask> timeout;
+
+        PendingRequest(const std::string& correlationId) :
+            correlationId(correlationId), future(new ReplyFuture()), timeout() {
+        }
+    };
+
+    class Requestor::ReplyListener : public cms::MessageListener {
+    private:
+
+        Requestor* parent;
+
+    private:
+
+        ReplyListener(const ReplyListener&);
+        ReplyListener& operator=(const ReplyListener&);
+
+    public:
+
+        ReplyListener(Requestor* parent) : cms::MessageListener(), parent(parent) {
+        }
+
+        virtual ~ReplyListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+            parent->onReply(message);
+        }
+    };
+
+    class Requestor::TimeoutTask : public TimerTask {
+    private:
+
+        Requestor* parent;
+        std::string correlationId;
+
+    private:
+
+        TimeoutTask(const TimeoutTask&);
+        TimeoutTask& operator=(const TimeoutTask&);
+
+    public:
+
+        TimeoutTask(Requestor* parent, const std::string& correlationId) :
+            TimerTask(), parent(parent), correlationId(correlationId) {
+        }
+
+        virtual ~TimeoutTask() {}
+
+        virtual void run() {
+            parent->expire(correlationId);
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+Requestor::Requestor(cms::Connection* connection) :
+    session(), replyQueue(), producer(), consumer(), listener(), pending(), timer(), cancelledTimeouts(), sendMutex(),
+    correlationPrefix(), nextCorrelationId(0), closed(false) {
+
+    if (connection == NULL) {
+        throw cms::CMSException("Requestor requires a Connection", NULL);
+    }
+
+    this->correlationPrefix = IdGenerator("ID:requestor").generateId() + ":";
+
+    try {
+        this->session.reset(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+        this->replyQueue.reset(this->session->createTemporaryQueue());
+        this->producer.reset(this->session->createProducer(NULL));
+        this->producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+        this->listener.reset(new ReplyListener(this));
+        this->consumer.reset(this->session->createConsumer(this->replyQueue.get()));
+        this->consumer->setMessageListener(this->listener.get());
+    } catch (...) {
+        try {
+            close();
+        } catch (...) {
+        }
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Requestor::~Requestor() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::Message* Requestor::request(const cms::Destination* destination, cms::Message* message, long long timeout) {
+
+    // The wait is bounded here rather than by the timer, a late reply to an
+    // abandoned request is dropped when it can't be matched.
+    Pointer<PendingRequest> request = send(destination, message, 0);
+
+    try {
+
+        if (timeout > 0) {
+            if (!request->future->await(timeout, TimeUnit::MILLISECONDS)) {
+                this->pending.remove(request->correlationId);
+                return NULL;
+            }
+        } else {
+            request->future->await();
+        }
+
+        return request->future->get()->clone();
+
+    } catch (ExecutionException& ex) {
+        throw cms::CMSException(ex.getCause() != NULL ? ex.getCause()->what() : ex.what(), NULL);
+    } catch (decaf::lang::Exception& ex) {
+        this->pending.remove(request->correlationId);
+        throw cms::CMSException(ex.what(), NULL);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Requestor::ReplyFuture> Requestor::requestAsync(const cms::Destination* destination,
+                                                         cms::Message* message, long long timeout) {
+    return send(destination, message, timeout)->future;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Requestor::setDeliveryMode(int mode) {
+
+    synchronized(&this->sendMutex) {
+        if (this->closed) {
+            throw cms::IllegalStateException("Requestor is closed", NULL);
+        }
+        this->producer->setDeliveryMode(mode);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Requestor::getDeliveryMode() const {
+    return this->producer->getDeliveryMode();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Requestor::PendingRequest> Requestor::send(const cms::Destination* destination,
+                                                   cms::Message* message, long long timeout) {
+
+    if (destination == NULL || message == NULL) {
+        throw cms::CMSException("Requestor needs a destination and a message to send", NULL);
+    }
+
+    synchronized(&this->sendMutex) {
+
+        if (this->closed) {
+            throw cms::IllegalStateException("Requestor is closed", NULL);
+        }
+
+        Pointer<PendingRequest> request(
+            new PendingRequest(this->correlationPrefix + Long::toString(++this->nextCorrelationId)));
+
+        message->setCMSCorrelationID(request->correlationId);
+        message->setCMSReplyTo(this->replyQueue.get());
+
+        // The timeout is set before the request is published in the map and scheduled
+        // before sending, the reply can be dispatched and cancel it before send returns.
+        if (timeout > 0) {
+            request->timeout.reset(new TimeoutTask(this, request->correlationId));
+        }
+
+        this->pending.put(request->correlationId, request);
+
+        try {
+            if (request->timeout != NULL) {
+                this->timer.schedule(request->timeout, timeout);
+            }
+
+            this->producer->send(destination, message);
+        } catch (...) {
+            this->pending.remove(request->correlationId);
+            if (request->timeout != NULL) {
+                request->timeout->cancel();
+            }
+            throw;
+        }
+
+        return request;
+    }
+
+    return Pointer<PendingRequest>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Requestor::onReply(const cms::Message* message) {
+
+    try {
+
+        Pointer<PendingRequest> request = this->pending.remove(message->getCMSCorrelationID());
+        if (request == NULL) {
+            return;
+        }
+
+        // A cancelled task stays in the timer's queue until its time comes, purge
+        // them in batches so that short replies to long timeouts don't pile up.
+        if (request->timeout != NULL && request->timeout->cancel() &&
+            this->cancelledTimeouts.incrementAndGet() % PURGE_INTERVAL == 0) {
+
+            this->timer.purge();
+        }
+
+        request->future->complete(Pointer<cms::Message>(message->clone()));
+
+    } catch (...) {
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Requestor::expire(const std::string& correlationId) {
+
+    Pointer<PendingRequest> request = this->pending.remove(correlationId);
+    if (request != NULL) {
+        request->future->completeExceptionally(TimeoutException(
+            __FILE__, __LINE__, "No reply received for request %s in time", correlationId.c_str()));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Requestor::close() {
+
+    synchronized(&this->sendMutex) {
+
+        if (this->closed) {
+            return;
+        }
+
+        this->closed = true;
+    }
+
+    this->timer.cancel();
+
+    // Stop the replies first so nothing completes a request while they are failed.
+    try {
+        if (this->consumer.get() != NULL) {
+            this->consumer->close();
+        }
+    } catch (...) {
+    }
+
+    ArrayList< Pointer<PendingRequest> > outstanding;
+    outstanding.addAll(this->pending.values());
+    this->pending.clear();
+
+    decaf::lang::exceptions::IllegalStateException failure(__FILE__, __LINE__, "Requestor was closed");
+    Pointer< Iterator< Pointer<PendingRequest> > > iter(outstanding.iterator());
+    while (iter->hasNext()) {
+        iter->next()->future->completeExceptionally(failure);
+    }
+
+    try {
+        if (this->producer.get() != NULL) {
+            this->producer->close();
+        }
+        if (this->replyQueue.get() != NULL) {
+            this->replyQueue->destroy();
+        }
+        if (this->session.get() != NULL) {
+            this->session->close();
+        }
+    } catch (cms::CMSException&) {
+        throw;
+    } catch (decaf::lang::Exception& ex) {
+        throw cms::CMSException(ex.what(), NULL);
+    }
+}
@@ -0,0 +1,213 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CMSUTIL_REQUESTOR_H_
+#define _ACTIVEMQ_CMSUTIL_REQUESTOR_H_
+
+#include <cms/Connection.h>
+#include <cms/Destination.h>
+#include <cms/Message.h>
+#include <cms/MessageConsumer.h>
+#include <cms/MessageListener.h>
+#include <cms/MessageProducer.h>
+#include <cms/Session.h>
+#include <cms/TemporaryQueue.h>
+#include <activemq/util/Config.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/Timer.h>
+#include <decaf/util/concurrent/CompletableFuture.h>
+#include <decaf/util/concurrent/ConcurrentStlMap.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <memory>
+#include <string>
+
+namespace activemq {
+namespace cmsutil {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * Sends request messages and hands back their replies, sharing one temporary
+     * reply queue and one consumer between every request made through it.
+     *
+     * Each request is stamped with a unique CMSCorrelationID and with the reply
+     * queue as its CMSReplyTo, the responder is expected to copy the correlation
+     * id onto its reply.  Replies are matched to their requests through a
+     * concurrent map, so any number of threads may have requests outstanding at
+     * once and none of them pays for creating and destroying a temporary queue
+     * and consumer of its own.  Replies that arrive for a request that is no
+     * longer outstanding, because it timed out or was never made here, are
+     * dropped.
+     *
+     * The Requestor owns a session of the connection it is created from.  The
+     * connection must be started for replies to be delivered.  Requests are sent
+     * NON_PERSISTENT unless setDeliveryMode says otherwise.  This class is
+     * thread-safe.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API Requestor {
+    public:
+
+        typedef decaf::util::concurrent::CompletableFuture< Pointer<cms::Message> > ReplyFuture;
+
+    private:
+
+        class PendingRequest;
+        class ReplyListener;
+        class TimeoutTask;
+
+        typedef decaf::util::concurrent::ConcurrentStlMap< std::string, Pointer<PendingRequest> > PendingMap;
+
+        std::auto_ptr<cms::Session> session;
+        std::auto_ptr<cms::TemporaryQueue> replyQueue;
+        std::auto_ptr<cms::MessageProducer> producer;
+        std::auto_ptr<cms::MessageConsumer> consumer;
+        std::auto_ptr<ReplyListener> listener;
+
+        PendingMap pending;
+
+        // Declared after the map, its thread is joined before the map is destroyed.
+        decaf::util::Timer timer;
+
+        // Timeouts cancelled by a reply since the timer was last purged of them.
+        decaf::util::concurrent::atomic::AtomicInteger cancelledTimeouts;
+
+        // Guards the session, which CMS only allows one thread to use at a time.
+        decaf::util::concurrent::Mutex sendMutex;
+
+        std::string correlationPrefix;
+        long long nextCorrelationId;
+        bool closed;
+
+    private:
+
+        Requestor(const Requestor&);
+        Requestor& operator=(const Requestor&);
+
+    public:
+
+        /**
+         * Creates a Requestor that sends and receives on a new session of the
+         * given connection.
+         *
+         * @param connection
+         *      The connection to create the session, reply queue and consumer from,
+         *      it must outlive this Requestor.
+         *
+         * @throws CMSException if the session or any of its resources can't be created.
+         */
+        Requestor(cms::Connection* connection);
+
+        /**
+         * Closes this Requestor, see close.
+         */
+        virtual ~Requestor();
+
+        /**
+         * Sends a request and waits for its reply.
+         *
+         * @param destination
+         *      The destination to send the request to.
+         * @param message
+         *      The request, its CMSReplyTo and CMSCorrelationID are overwritten.  The
+         *      caller retains ownership.
+         * @param timeout
+         *      The time in milliseconds to wait for the reply, zero or less waits
+         *      indefinitely.
+         *
+         * @return the reply, which the caller owns, or NULL if none arrived in time.
+         *
+         * @throws CMSException if the request can't be sent or the Requestor is closed
+         *         while waiting.
+         */
+        cms::Message* request(const cms::Destination* destination, cms::Message* message, long long timeout);
+
+        /**
+         * Sends a request and returns a future for its reply without waiting.
+         *
+         * The future is completed on the session's delivery thread, any listener
+         * registered on it without an Executor runs there and holds up the delivery
+         * of other replies until it returns.  If no reply arrives within the timeout
+         * the future completes exceptionally with a TimeoutException.
+         *
+         * @param destination
+         *      The destination to send the request to.
+         * @param message
+         *      The request, its CMSReplyTo and CMSCorrelationID are overwritten.  The
+         *      caller retains ownership.
+         * @param timeout
+         *      The time in milliseconds allowed for the reply, zero or less allows
+         *      any amount of time.
+         *
+         * @return a future for the reply.
+         *
+         * @throws CMSException if the request can't be sent or the Requestor is closed.
+         */
+        Pointer<ReplyFuture> requestAsync(const cms::Destination* destination, cms::Message* message, long long timeout);
+
+        /**
+         * Sets the delivery mode that requests are sent with.
+         *
+         * @param mode
+         *      The DeliveryMode to use for requests.
+         *
+         * @throws CMSException if the Requestor is closed.
+         */
+        void setDeliveryMode(int mode);
+
+        /**
+         * @return the delivery mode that requests are sent with.
+         */
+        int getDeliveryMode() const;
+
+        /**
+         * @return the temporary queue that replies are delivered to.
+         */
+        const cms::TemporaryQueue* getReplyQueue() const {
+            return this->replyQueue.get();
+        }
+
+        /**
+         * @return the number of requests still waiting for their reply.
+         */
+        int getOutstandingRequestCount() const {
+            return this->pending.size();
+        }
+
+        /**
+         * Fails every outstanding request and releases the session, reply queue and
+         * consumer.  Calling close more than once has no further effect.
+         *
+         * @throws CMSException if an error occurs while releasing the resources.
+         */
+        void close();
+
+    private:
+
+        Pointer<PendingRequest> send(const cms::Destination* destination, cms::Message* message, long long timeout);
+
+        void onReply(const cms::Message* message);
+
+        void expire(const std::string& correlationId);
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_CMSUTIL_REQUESTOR_H_*/
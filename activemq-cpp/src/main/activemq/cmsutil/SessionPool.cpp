@@ -18,9 +18,67 @@
 #include "SessionPool.h"
 #include "ResourceLifecycleManager.h"
 
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+
 using namespace activemq::cmsutil;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent::atomic;
 using namespace std;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace cmsutil {
+
+    /**
+     * A session bound to a thread, released once that thread's claim on it is
+     * gone.  Claims are destroyed during thread exit with the library's thread
+     * locks held, so releasing only sets a flag; the pool takes the session
+     * back the next time it binds one.
+     */
+    class SessionPool::ThreadBinding {
+    private:
+
+        ThreadBinding(const ThreadBinding&);
+        ThreadBinding& operator=(const ThreadBinding&);
+
+    public:
+
+        PooledSession* session;
+        AtomicBoolean released;
+
+        ThreadBinding(PooledSession* session) : session(session), released() {
+        }
+    };
+
+    /**
+     * A thread's claim on its bound session, held in the pool's thread local.
+     */
+    class SessionPool::ThreadClaim {
+    private:
+
+        Pointer<ThreadBinding> binding;
+
+    private:
+
+        ThreadClaim(const ThreadClaim&);
+        ThreadClaim& operator=(const ThreadClaim&);
+
+    public:
+
+        ThreadClaim(Pointer<ThreadBinding> binding) : binding(binding) {
+        }
+
+        ~ThreadClaim() {
+            binding->released.set(true);
+        }
+
+        PooledSession* getSession() const {
+            return binding->session;
+        }
+    };
+
+}}
+
 ////////////////////////////////////////////////////////////////////////////////
 SessionPool::SessionPool(cms::Connection* connection,
                          cms::Session::AcknowledgeMode ackMode,
@@ -30,13 +88,41 @@ SessionPool::SessionPool(cms::Connection* connection,
       mutex(),
       available(),
       sessions(),
-      acknowledgeMode(ackMode) {
+      acknowledgeMode(ackMode),
+      claims(NULL),
+      bindings(),
+      maxBoundSessions(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SessionPool::SessionPool(cms::Connection* connection,
+                         cms::Session::AcknowledgeMode ackMode,
+                         ResourceLifecycleManager* resourceLifecycleManager,
+                         int maxBoundSessions)
+    : connection(connection),
+      resourceLifecycleManager(resourceLifecycleManager),
+      mutex(),
+      available(),
+      sessions(),
+      acknowledgeMode(ackMode),
+      claims(NULL),
+      bindings(),
+      maxBoundSessions(maxBoundSessions < 0 ? 0 : maxBoundSessions) {
+
+    if (this->maxBoundSessions > 0) {
+        this->claims = new ThreadClaims();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionPool::~SessionPool() {
 
     try {
+        // Drop every thread's claim before the sessions they refer to.
+        delete claims;
+        claims = NULL;
+        bindings.clear();
+
         // Destroy all of the pooled session objects.
         list<PooledSession*>::iterator iter = sessions.begin();
         for (; iter != sessions.end(); ++iter) {
@@ -54,6 +140,37 @@ SessionPool::~SessionPool() {
 ////////////////////////////////////////////////////////////////////////////////
 PooledSession* SessionPool::takeSession() {
 
+    if (claims != NULL) {
+
+        // Fetched outside the lock, the first lookup from a thread the library
+        // didn't start registers that thread globally.
+        Pointer<ThreadClaim>& claim = claims->get();
+        if (claim != NULL) {
+            return claim->getSession();
+        }
+
+        Pointer<ThreadBinding> binding;
+
+        synchronized(&mutex) {
+            reclaimSessions();
+
+            if ((int) bindings.size() < maxBoundSessions) {
+                if (available.empty()) {
+                    binding.reset(new ThreadBinding(createSession()));
+                } else {
+                    binding.reset(new ThreadBinding(available.front()));
+                    available.pop_front();
+                }
+                bindings.push_back(binding);
+            }
+        }
+
+        if (binding != NULL) {
+            claim.reset(new ThreadClaim(binding));
+            return binding->session;
+        }
+    }
+
     synchronized(&mutex) {
 
         PooledSession* pooledSession = NULL;
@@ -61,18 +178,7 @@ PooledSession* SessionPool::takeSession() {
         // If there are no sessions available, create a new one and return it.
         if (available.size() == 0) {
 
-            // No sessions were available - create a new one.
-            cms::Session* session = connection->createSession(acknowledgeMode);
-
-            // Give this resource to the life-cycle manager to manage. The pool
-            // will not be in charge of destroying this resource.
-            resourceLifecycleManager->addSession(session);
-
-            // Now wrap the session with a pooled session.
-            pooledSession = new PooledSession(this, session);
-
-            // Add to the sessions list.
-            sessions.push_back(pooledSession);
+            pooledSession = createSession();
 
         } else {
 
@@ -93,8 +199,72 @@ PooledSession* SessionPool::takeSession() {
 ////////////////////////////////////////////////////////////////////////////////
 void SessionPool::returnSession(PooledSession* session) {
 
+    if (claims != NULL) {
+        // A bound session stays with its thread.
+        Pointer<ThreadClaim>& claim = claims->get();
+        if (claim != NULL && claim->getSession() == session) {
+            return;
+        }
+    }
+
     synchronized(&mutex) {
         // Add to the available list.
         available.push_back(session);
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionPool::releaseThreadSession() {
+
+    if (claims == NULL) {
+        return;
+    }
+
+    Pointer<ThreadClaim>& claim = claims->get();
+    if (claim == NULL) {
+        return;
+    }
+
+    // Dropping the claim marks the binding released, reclaiming then makes
+    // the session available straight away.
+    claim.reset(NULL);
+
+    synchronized(&mutex) {
+        reclaimSessions();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledSession* SessionPool::createSession() {
+
+    // No sessions were available - create a new one.
+    cms::Session* session = connection->createSession(acknowledgeMode);
+
+    // Give this resource to the life-cycle manager to manage. The pool
+    // will not be in charge of destroying this resource.
+    resourceLifecycleManager->addSession(session);
+
+    // Now wrap the session with a pooled session.
+    PooledSession* pooledSession = new PooledSession(this, session);
+
+    // Add to the sessions list.
+    sessions.push_back(pooledSession);
+
+    return pooledSession;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionPool::reclaimSessions() {
+
+    // Called with the mutex held, sessions of threads that have ended become
+    // available again.
+    list< Pointer<ThreadBinding> >::iterator iter = bindings.begin();
+    while (iter != bindings.end()) {
+        if ((*iter)->released.get()) {
+            available.push_back((*iter)->session);
+            iter = bindings.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
@@ -19,6 +19,8 @@
 #define _ACTIVEMQ_CMSUTIL_SESSIONPOOL_H_
 
 #include <activemq/cmsutil/PooledSession.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/ThreadLocal.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <cms/Connection.h>
 #include <list>
@@ -35,10 +37,26 @@ namespace cmsutil {
      * acknowledge mode.  Internal session resources are managed through a
      * provided <code>ResourceLifecycleManager</code>, not by this pool.  This
      * class is thread-safe.
+     *
+     * A pool may also bind sessions to threads.  The first time a thread takes
+     * a session it is given one of its own, for as long as the number of bound
+     * sessions is below the limit given at construction; later takes by that
+     * thread return the same session and returning it leaves it bound, neither
+     * of which locks the pool.  Threads beyond the limit share the remaining
+     * sessions as usual, the limit applies to bound sessions only and the pool
+     * creates a new unbound session whenever none is available.  When a thread
+     * started through decaf ends its session goes back to the pool for another
+     * thread to use; any other thread keeps its session until it calls
+     * releaseThreadSession().
      */
     class AMQCPP_API SessionPool {
     private:
 
+        class ThreadBinding;
+        class ThreadClaim;
+
+        typedef decaf::lang::ThreadLocal< decaf::lang::Pointer<ThreadClaim> > ThreadClaims;
+
         cms::Connection* connection;
 
         ResourceLifecycleManager* resourceLifecycleManager;
@@ -51,6 +69,12 @@ namespace cmsutil {
 
         cms::Session::AcknowledgeMode acknowledgeMode;
 
+        ThreadClaims* claims;
+
+        std::list< decaf::lang::Pointer<ThreadBinding> > bindings;
+
+        int maxBoundSessions;
+
     private:
 
         SessionPool(const SessionPool&);
@@ -72,6 +96,27 @@ namespace cmsutil {
                     cms::Session::AcknowledgeMode ackMode,
                     ResourceLifecycleManager* resourceLifecycleManager);
 
+        /**
+         * Constructs a session pool that binds up to the given number of
+         * sessions to the threads that take them.
+         *
+         * @param connection
+         *          the connection to be used for creating all sessions.
+         * @param ackMode
+         *          the acknowledge mode to be used for all sessions
+         * @param resourceLifecycleManager
+         *          the object responsible for managing the lifecycle of
+         *          any allocated cms::Session resources.
+         * @param maxBoundSessions
+         *          the most sessions bound to threads at any one time, zero
+         *          binds none.  Sessions taken by other threads are not
+         *          counted against it.
+         */
+        SessionPool(cms::Connection* connection,
+                    cms::Session::AcknowledgeMode ackMode,
+                    ResourceLifecycleManager* resourceLifecycleManager,
+                    int maxBoundSessions);
+
         /**
          * Destroys the pooled session objects, but not the underlying session
          * resources.  That is the job of the ResourceLifecycleManager.
@@ -95,10 +140,32 @@ namespace cmsutil {
          */
         virtual void returnSession(PooledSession* session);
 
+        /**
+         * Returns the session bound to the calling thread, if any, to the pool.
+         * Threads the library didn't start must call this before they end,
+         * their bound session is not released otherwise.
+         *
+         * @since 3.10.0
+         */
+        virtual void releaseThreadSession();
+
         ResourceLifecycleManager* getResourceLifecycleManager() {
             return resourceLifecycleManager;
         }
 
+        /**
+         * @return the most sessions this pool binds to threads.
+         */
+        int getMaxBoundSessions() const {
+            return maxBoundSessions;
+        }
+
+    private:
+
+        PooledSession* createSession();
+
+        void reclaimSessions();
+
     };
 
 }}
@@ -22,6 +22,7 @@
 #include <decaf/io/ByteArrayInputStream.h>
 #include <decaf/io/EOFException.h>
 #include <decaf/io/IOException.h>
+#include <decaf/io/MemoryMappedFile.h>
 
 #include <decaf/util/zip/DeflaterOutputStream.h>
 #include <decaf/util/zip/InflaterInputStream.h>
@@ -584,6 +585,24 @@ void ActiveMQBytesMessage::writeUTF(const std::string& value) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessage::setBodyFromFile(const std::string& name, long long offset, long long length) {
+
+    this->failIfReadOnlyBody();
+    try {
+        Pointer<MemoryMappedFile> mapping(new MemoryMappedFile(name, offset, length));
+
+        this->dataOut.reset(NULL);
+        this->bytesOut = NULL;
+        this->dataIn.reset(NULL);
+        this->length = 0;
+        this->compressed = false;
+
+        this->setMappedContent(mapping);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessage::storeContent() {
 
@@ -630,7 +649,13 @@ void ActiveMQBytesMessage::initializeReading() const {
     try {
 
         if (this->dataIn.get() == NULL) {
-            InputStream* is = new ByteArrayInputStream(this->getContent());
+            InputStream* is = NULL;
+
+            if (this->getMappedContent() != NULL && this->getContentSize() > 0) {
+                is = new ByteArrayInputStream(this->getContentData(), this->getContentSize());
+            } else {
+                is = new ByteArrayInputStream(this->getContent());
+            }
 
             if (this->isCompressed()) {
 
@@ -644,7 +669,7 @@ void ActiveMQBytesMessage::initializeReading() const {
                 is = new InflaterInputStream(is, true);
 
             } else {
-                this->length = (int) this->getContent().size();
+                this->length = this->getContentSize();
             }
             this->dataIn.reset(new DataInputStream(is, true));
         }
@@ -673,6 +698,15 @@ void ActiveMQBytesMessage::initializeWriting() {
             }
 
             this->dataOut.reset(new DataOutputStream(os, true));
+
+            // A mapped body can't grow, copy it so that new bytes are appended to it.
+            if (this->getMappedContent() != NULL) {
+                int size = this->getContentSize();
+                if (size > 0) {
+                    this->dataOut->write(this->getContentData(), size, 0, size);
+                }
+                this->setMappedContent(Pointer<MemoryMappedFile>());
+            }
         }
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
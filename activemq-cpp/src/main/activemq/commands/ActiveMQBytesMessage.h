@@ -150,6 +150,31 @@ namespace commands {
 
         virtual void writeUTF(const std::string& value);
 
+    public:  // ActiveMQBytesMessage
+
+        /**
+         * Replaces the body of this Message with a region of a file.  The region is memory
+         * mapped read-only and marshaled straight from the mapping when the Message is
+         * sent, so the file contents are never copied onto the heap.  The body is sent
+         * uncompressed even if the Connection has compression enabled, bytes written
+         * after this call are appended to a copy of the region.
+         *
+         * @param name
+         *      The path name of the file that holds the body.
+         * @param offset
+         *      The position in the file where the body starts.
+         * @param length
+         *      The number of bytes in the body, or -1 to use the rest of the file.
+         *
+         * @throws MessageNotWriteableException if the body is read-only.
+         * @throws CMSException if the file cannot be mapped.
+         */
+        void setBodyFromFile(const std::string& name, long long offset = 0, long long length = -1);
+
+        virtual bool isMappedContentSupported() const {
+            return true;
+        }
+
     private:
 
         void storeContent();
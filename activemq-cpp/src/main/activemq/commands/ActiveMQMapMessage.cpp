@@ -111,25 +111,30 @@ void ActiveMQMapMessage::beforeMarshal(WireFormat* wireFormat) {
 
         if (map.get() != NULL && !map->isEmpty()) {
 
-            ByteArrayOutputStream* bytesOut = new ByteArrayOutputStream();
-
-            OutputStream* os = bytesOut;
-
             if (this->connection != NULL && this->connection->isUseCompression()) {
                 this->compressed = true;
 
+                ByteArrayOutputStream* bytesOut = new ByteArrayOutputStream();
                 Deflater* deflator = new Deflater(this->connection->getCompressionLevel());
+                OutputStream* os = new DeflaterOutputStream(bytesOut, deflator, true, true);
 
-                os = new DeflaterOutputStream(os, deflator, true, true);
-            }
+                DataOutputStream dataOut(os, true);
+                PrimitiveTypesMarshaller::marshalMap(map.get(), dataOut);
+                dataOut.close();
+
+                std::pair<unsigned char*, int> array = bytesOut->toByteArray();
+                this->setContent(std::vector<unsigned char>(array.first, array.first + array.second));
+                delete[] array.first;
 
-            DataOutputStream dataOut(os, true);
-            PrimitiveTypesMarshaller::marshalMap(map.get(), dataOut);
-            dataOut.close();
+            } else if (map->isDirty() || this->compressed || this->content.empty()) {
+
+                // Encoded straight into the body, an unchanged map keeps the last encoding.
+                this->compressed = false;
+                this->content.clear();
+                PrimitiveTypesMarshaller::marshal(map.get(), this->content);
+                map->clearDirty();
+            }
 
-            std::pair<unsigned char*, int> array = bytesOut->toByteArray();
-            this->setContent(std::vector<unsigned char>(array.first, array.first + array.second));
-            delete[] array.first;
         } else {
             clearBody();
         }
@@ -186,6 +191,11 @@ void ActiveMQMapMessage::checkMapIsUnmarshalled() const {
                     __FILE__, __LINE__,
                     "ActiveMQMapMessage::getMap() - All attempts to create a map have failed.");
             }
+
+            // The body already holds the encoding of this map unless it was compressed.
+            if (!isCompressed()) {
+                map->clearDirty();
+            }
         } else if (map.get() == NULL) {
             map.reset(new PrimitiveMap());
         }
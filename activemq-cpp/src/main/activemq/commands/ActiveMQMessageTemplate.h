@@ -90,6 +90,7 @@ namespace commands {
 
         virtual void clearBody() {
             try {
+                this->setMappedContent(Pointer<decaf::io::MemoryMappedFile>());
                 this->setContent(std::vector<unsigned char>());
                 this->setReadOnlyBody(false);
             }
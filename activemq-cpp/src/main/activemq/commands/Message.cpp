@@ -23,6 +23,8 @@
 #include <activemq/wireformat/openwire/marshal/BaseDataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
 #include <decaf/lang/System.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 
 using namespace std;
@@ -48,7 +50,7 @@ Message::Message() :
       groupID(""), groupSequence(0), correlationId(""), persistent(false), expiration(0), priority(0), replyTo(NULL), timestamp(0), 
       type(""), content(), marshalledProperties(), dataStructure(NULL), targetConsumerId(NULL), compressed(false), redeliveryCounter(0), 
       brokerPath(), arrival(0), userID(""), recievedByDFBridge(false), droppable(false), cluster(), brokerInTime(0), brokerOutTime(0), 
-      jMSXGroupFirstForConsumer(false), ackHandler(NULL), properties(), readOnlyProperties(false), readOnlyBody(false), connection(NULL) {
+      jMSXGroupFirstForConsumer(false), ackHandler(NULL), properties(), readOnlyProperties(false), readOnlyBody(false), mappedContent(), connection(NULL) {
 
 }
 
@@ -119,6 +121,7 @@ void Message::copyDataStructure(const DataStructure* src) {
     this->setAckHandler(srcPtr->getAckHandler());
     this->setReadOnlyBody(srcPtr->isReadOnlyBody());
     this->setReadOnlyProperties(srcPtr->isReadOnlyProperties());
+    this->mappedContent = srcPtr->mappedContent;
     this->setConnection(srcPtr->getConnection());
 }
 
@@ -452,6 +455,10 @@ bool Message::equals(const DataStructure* value) const {
         return false;
     }
 
+    if (mappedContent != valuePtr->getMappedContent()){
+        return false;
+    }
+
     if (!BaseCommand::equals(value)) {
         return false;
     }
@@ -863,20 +870,61 @@ unsigned int Message::getSize() const {
 
     unsigned int size = DEFAULT_MESSAGE_SIZE;
 
-    size += (unsigned int)this->getContent().size();
+    size += (unsigned int)this->getContentSize();
     size += (unsigned int)this->getMarshalledProperties().size();
 
     return size;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void Message::setMappedContent(const Pointer<decaf::io::MemoryMappedFile>& mapping) {
+
+    if (mapping != NULL && mapping->getLength() > (long long)Integer::MAX_VALUE) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Mapped region of %lld bytes is larger than a Message Body can be.", mapping->getLength());
+    }
+
+    this->content.clear();
+    this->mappedContent = mapping;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Message::getContentSize() const {
+
+    if (this->mappedContent != NULL) {
+        return (int)this->mappedContent->getLength();
+    }
+
+    return (int)this->content.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const unsigned char* Message::getContentData() const {
+
+    if (this->mappedContent != NULL) {
+        return this->mappedContent->getData();
+    }
+
+    return this->content.empty() ? NULL : &this->content[0];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
 
     try {
-        marshalledProperties.clear();
-        if (!properties.isEmpty()) {
+
+        if (properties.isEmpty()) {
+            marshalledProperties.clear();
+            return;
+        }
+
+        // A message resent without touching its properties, or one that was received and
+        // forwarded, still holds the encoding of the current property set.
+        if (properties.isDirty() || marshalledProperties.empty()) {
+            marshalledProperties.clear();
             wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(
                 &properties, marshalledProperties );
+            properties.clearDirty();
         }
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -890,6 +938,7 @@ void Message::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
     try {
         wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(
             &properties, marshalledProperties);
+        properties.clearDirty();
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
@@ -34,6 +34,7 @@
 #include <activemq/core/ActiveMQAckHandler.h>
 #include <activemq/util/Config.h>
 #include <activemq/util/PrimitiveMap.h>
+#include <decaf/io/MemoryMappedFile.h>
 #include <decaf/lang/Pointer.h>
 #include <string>
 #include <vector>
@@ -110,6 +111,10 @@ namespace commands{
         // Indicates if the Message Body are Read Only
         bool readOnlyBody;
 
+        // When set the Message Body is held in this mapped file region instead of
+        // the content vector.
+        Pointer<decaf::io::MemoryMappedFile> mappedContent;
+
     protected:
 
         core::ActiveMQConnection* connection;
@@ -272,6 +277,46 @@ namespace commands{
             this->readOnlyBody = value;
         }
 
+        /**
+         * Backs the Message Body with a memory mapped file region, the mapped bytes are
+         * marshaled straight from the mapping instead of being copied into the content
+         * vector.  Any existing content is cleared, passing NULL removes the mapping.
+         *
+         * @param mapping - the mapped region that holds the Message Body.
+         *
+         * @throws IllegalArgumentException if the region is too large for a Message Body.
+         */
+        void setMappedContent(const Pointer<decaf::io::MemoryMappedFile>& mapping);
+
+        /**
+         * Gets the memory mapped file region that holds the Message Body.
+         * @return the mapped region or NULL if the body is held in the content vector.
+         */
+        const Pointer<decaf::io::MemoryMappedFile>& getMappedContent() const {
+            return this->mappedContent;
+        }
+
+        /**
+         * Returns the size of the Message Body wherever it is held.
+         * @return number of bytes in the mapped region or the content vector.
+         */
+        int getContentSize() const;
+
+        /**
+         * Returns the Message Body bytes wherever they are held.
+         * @return pointer to the first byte of the body or NULL if it is empty.
+         */
+        const unsigned char* getContentData() const;
+
+        /**
+         * Indicates if this Message type can read its body from a mapped file region,
+         * large bodies of such Messages may be spooled to disk when they are unmarshaled.
+         * @return true if setMappedContent can be used with this Message.
+         */
+        virtual bool isMappedContentSupported() const {
+            return false;
+        }
+
         virtual const Pointer<ProducerId>& getProducerId() const;
         virtual Pointer<ProducerId>& getProducerId();
         virtual void setProducerId(const Pointer<ProducerId>& producerId);
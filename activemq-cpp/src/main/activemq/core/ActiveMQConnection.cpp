@@ -35,6 +35,7 @@
 #include <activemq/exceptions/ConnectionFailedException.h>
 #include <activemq/util/CMSExceptionSupport.h>
 #include <activemq/util/IdGenerator.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/transport/failover/FailoverTransport.h>
 #include <activemq/transport/ResponseCallback.h>
 #include <activemq/transport/DefaultTransportListener.h>
@@ -43,6 +44,7 @@
 #include <decaf/lang/Math.h>
 #include <decaf/lang/Boolean.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
 #include <decaf/util/Iterator.h>
 #include <decaf/util/Set.h>
 #include <decaf/util/Collection.h>
@@ -52,6 +54,7 @@
 #include <decaf/util/concurrent/TimeUnit.h>
 #include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/WorkStealingExecutor.h>
 #include <decaf/util/concurrent/LinkedBlockingQueue.h>
 #include <decaf/util/concurrent/locks/ReentrantReadWriteLock.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
@@ -102,10 +105,22 @@ namespace core {
     private:
 
         std::string connectionId;
+        const ThreadPolicy* policy;
+        ThreadPolicy::Role role;
+        std::string prefix;
+
+    private:
+
+        ConnectionThreadFactory(const ConnectionThreadFactory&);
+        ConnectionThreadFactory& operator=(const ConnectionThreadFactory&);
 
     public:
 
-        ConnectionThreadFactory(std::string connectionId) : connectionId(connectionId) {
+        ConnectionThreadFactory(std::string connectionId, const ThreadPolicy* policy,
+                                ThreadPolicy::Role role = ThreadPolicy::EXECUTOR,
+                                const std::string& prefix = "ActiveMQ Connection Executor: ") :
+            connectionId(connectionId), policy(policy), role(role), prefix(prefix) {
+
             if (connectionId.empty()) {
                 throw NullPointerException(__FILE__, __LINE__, "Connection Id must be set.");
             }
@@ -114,15 +129,34 @@ namespace core {
         virtual ~ConnectionThreadFactory() {}
 
         virtual Thread* newThread(decaf::lang::Runnable* runnable) {
-            static std::string prefix = "ActiveMQ Connection Executor: ";
-
             std::string name = prefix + connectionId;
-            Thread* thread = new Thread(runnable, name);
-            return thread;
+            return policy->newThread(role, runnable, name);
         }
 
     };
 
+    class ApplyThreadPolicyTask : public Runnable {
+    private:
+
+        ThreadPolicy policy;
+        ThreadPolicy::Role role;
+
+    public:
+
+        ApplyThreadPolicyTask(const ThreadPolicy& policy, ThreadPolicy::Role role) :
+            policy(policy), role(role) {
+        }
+
+        virtual ~ApplyThreadPolicyTask() {}
+
+        virtual void run() {
+            try {
+                policy.apply(role, Thread::currentThread());
+            }
+            AMQ_CATCHALL_NOTHROW()
+        }
+    };
+
     class ConnectionConfig {
     private:
 
@@ -153,6 +187,7 @@ namespace core {
         Pointer<util::IdGenerator> clientIdGenerator;
         Pointer<Scheduler> scheduler;
         Pointer<ExecutorService> executor;
+        Pointer<ExecutorService> sessionTaskExecutor;
 
         util::LongSequenceGenerator sessionIds;
         util::LongSequenceGenerator consumerIdGenerator;
@@ -193,6 +228,10 @@ namespace core {
         long long optimizedAckScheduledAckInterval;
         long long consumerFailoverRedeliveryWaitPeriod;
         bool consumerExpiryCheckEnabled;
+        bool useDedicatedTaskRunner;
+        int sessionTaskPoolSize;
+
+        ThreadPolicy threadPolicy;
 
         std::auto_ptr<PrefetchPolicy> defaultPrefetchPolicy;
         std::auto_ptr<RedeliveryPolicy> defaultRedeliveryPolicy;
@@ -228,6 +267,7 @@ namespace core {
                              clientIdGenerator(),
                              scheduler(),
                              executor(),
+                             sessionTaskExecutor(),
                              sessionIds(),
                              consumerIdGenerator(),
                              tempDestinationIds(),
@@ -263,6 +303,9 @@ namespace core {
                              optimizedAckScheduledAckInterval(0),
                              consumerFailoverRedeliveryWaitPeriod(0),
                              consumerExpiryCheckEnabled(true),
+                             useDedicatedTaskRunner(true),
+                             sessionTaskPoolSize(0),
+                             threadPolicy(),
                              defaultPrefetchPolicy(NULL),
                              defaultRedeliveryPolicy(NULL),
                              exceptionListener(NULL),
@@ -297,7 +340,7 @@ namespace core {
             this->executor.reset(
                 new ThreadPoolExecutor(1, 1, 5, TimeUnit::SECONDS,
                     new LinkedBlockingQueue<Runnable*>(),
-                    new ConnectionThreadFactory(connectionId->toString())));
+                    new ConnectionThreadFactory(connectionId->toString(), &this->threadPolicy)));
 
             this->connectionInfo->setConnectionId(connectionId);
             this->scheduler.reset(new Scheduler(std::string("ActiveMQConnection[")+uniqueId+"] Scheduler"));
@@ -311,6 +354,11 @@ namespace core {
                     this->executor->shutdown();
                     this->executor->awaitTermination(10, TimeUnit::MINUTES);
                 }
+
+                if (this->sessionTaskExecutor != NULL) {
+                    this->sessionTaskExecutor->shutdown();
+                    this->sessionTaskExecutor->awaitTermination(10, TimeUnit::MINUTES);
+                }
             }
             AMQ_CATCHALL_NOTHROW()
         }
@@ -438,6 +486,24 @@ namespace core {
         }
     };
 
+    class ResponseErrorCheck : public Continuation< Pointer<Response>, Pointer<Response> > {
+    public:
+
+        virtual ~ResponseErrorCheck() {}
+
+        virtual Pointer<Response> apply(const Pointer<Response>& response) {
+
+            commands::ExceptionResponse* exceptionResponse =
+                dynamic_cast<ExceptionResponse*> (response.get());
+
+            if (exceptionResponse != NULL) {
+                throw exceptionResponse->getException()->createExceptionObject();
+            }
+
+            return response;
+        }
+    };
+
     class AsyncResponseCallback : public ResponseCallback {
     private:
 
@@ -773,6 +839,12 @@ void ActiveMQConnection::close() {
             if (this->config->executor != NULL) {
                 this->config->executor->shutdown();
             }
+
+            synchronized(&this->config->mutex) {
+                if (this->config->sessionTaskExecutor != NULL) {
+                    this->config->sessionTaskExecutor->shutdown();
+                }
+            }
         } catch (Exception& error) {
             if (!hasException) {
                 ex = error;
@@ -1263,6 +1335,19 @@ void ActiveMQConnection::oneway(Pointer<Command> command) {
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    try {
+        checkClosedOrFailed();
+        this->config->transport->onewayBatch(commands);
+    }
+    AMQ_CATCH_EXCEPTION_CONVERT(IOException, ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::exceptions::UnsupportedOperationException, ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Response> ActiveMQConnection::syncRequest(Pointer<Command> command, unsigned int timeout) {
 
@@ -1315,6 +1400,26 @@ void ActiveMQConnection::asyncRequest(Pointer<Command> command, cms::AsyncCallba
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQConnection::asyncRequest(Pointer<Command> command) {
+
+    try {
+
+        checkClosedOrFailed();
+
+        Pointer<FutureResponse> response =
+            this->config->transport->asyncRequest(command, Pointer<ResponseCallback>());
+
+        // The check is cheap enough to run on the transport thread that completes the response.
+        return response->then(Pointer< Continuation< Pointer<Response>, Pointer<Response> > >(new ResponseErrorCheck));
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(IOException, ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::exceptions::UnsupportedOperationException, ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnection::checkClosed() const {
     if (this->isClosed()) {
@@ -1678,6 +1783,33 @@ ExecutorService* ActiveMQConnection::getExecutor() const {
     return this->config->executor.get();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ExecutorService* ActiveMQConnection::getSessionTaskExecutor() const {
+
+    try {
+
+        synchronized(&this->config->mutex) {
+            if (this->config->sessionTaskExecutor == NULL) {
+                int poolSize = this->config->sessionTaskPoolSize;
+                if (poolSize <= 0) {
+                    poolSize = System::availableProcessors();
+                }
+
+                this->config->sessionTaskExecutor.reset(
+                    new WorkStealingExecutor(poolSize,
+                        new ConnectionThreadFactory(this->config->connectionInfo->getConnectionId()->toString(),
+                                                    &this->config->threadPolicy, ThreadPolicy::SESSION_DISPATCH,
+                                                    "ActiveMQ Session Task: ")));
+            }
+        }
+
+        return this->config->sessionTaskExecutor.get();
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ArrayList< Pointer<ActiveMQSessionKernel> > ActiveMQConnection::getSessions() const {
     ArrayList< Pointer<ActiveMQSessionKernel> > result;
@@ -1960,3 +2092,60 @@ bool ActiveMQConnection::isConsumerExpiryCheckEnabled() {
 void ActiveMQConnection::setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled) {
     this->config->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isUseDedicatedTaskRunner() const {
+    return this->config->useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setUseDedicatedTaskRunner(bool useDedicatedTaskRunner) {
+    this->config->useDedicatedTaskRunner = useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getSessionTaskPoolSize() const {
+    return this->config->sessionTaskPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setSessionTaskPoolSize(int sessionTaskPoolSize) {
+    this->config->sessionTaskPoolSize = sessionTaskPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const ThreadPolicy& ActiveMQConnection::getThreadPolicy() const {
+    return this->config->threadPolicy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setThreadPolicy(const ThreadPolicy& policy) {
+
+    try {
+
+        this->config->threadPolicy = policy;
+
+        Transport* transport = this->config->transport.get();
+
+        FailoverTransport* failover =
+            dynamic_cast<FailoverTransport*>(transport->narrow(typeid(FailoverTransport)));
+
+        if (failover != NULL) {
+            failover->setThreadPolicy(policy);
+        } else {
+            IOTransport* ioTransport = dynamic_cast<IOTransport*>(transport->narrow(typeid(IOTransport)));
+            if (ioTransport != NULL) {
+                ioTransport->setThreadPolicy(policy);
+            }
+        }
+
+        // The Scheduler's timer thread is already running, let it configure itself.
+        if (this->config->scheduler->isStarted()) {
+            this->config->scheduler->executeAfterDelay(
+                new ApplyThreadPolicyTask(policy, ThreadPolicy::SCHEDULER), 0, true);
+        }
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
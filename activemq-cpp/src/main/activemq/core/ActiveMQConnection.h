@@ -29,11 +29,13 @@
 #include <activemq/transport/Transport.h>
 #include <activemq/transport/TransportListener.h>
 #include <activemq/threads/Scheduler.h>
+#include <activemq/threads/ThreadPolicy.h>
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <decaf/util/Properties.h>
 #include <decaf/util/ArrayList.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/concurrent/CompletableFuture.h>
 #include <decaf/util/concurrent/ExecutorService.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
@@ -822,6 +824,66 @@ namespace core {
          */
         void setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled);
 
+        /**
+         * @return true if each Session dispatches its messages on a thread of its own.
+         */
+        bool isUseDedicatedTaskRunner() const;
+
+        /**
+         * Configures whether each Session of this Connection dispatches messages on a
+         * dedicated thread, which is the default, or on the threads of the work stealing
+         * pool that this Connection shares between its Sessions.  The pooled mode keeps
+         * the thread count fixed no matter how many Sessions are opened and suits many
+         * Sessions that each see light traffic.  The value applies to Sessions whose
+         * dispatching starts after it is changed.
+         *
+         * In the pooled mode a MessageListener runs on a pool thread, and a listener that
+         * blocks, for instance on a synchronous receive or a remote call, holds that
+         * thread and stalls the Sessions queued behind it.  Listeners that may block
+         * should be used with dedicated task runners, or with a pool sized for them.
+         *
+         * @param useDedicatedTaskRunner
+         *      False if Sessions should dispatch on the shared pool.
+         */
+        void setUseDedicatedTaskRunner(bool useDedicatedTaskRunner);
+
+        /**
+         * @return the number of threads in the pool shared by this Connection's Sessions,
+         *         zero means one per available processor.
+         */
+        int getSessionTaskPoolSize() const;
+
+        /**
+         * Sets the number of threads in the pool this Connection's Sessions share when
+         * dedicated task runners are not in use, zero (the default) uses one thread per
+         * available processor.  Only takes effect if set before the pool is first used.
+         *
+         * @param sessionTaskPoolSize
+         *      The number of pool threads, or zero for one per processor.
+         *
+         * @since 3.10.0
+         */
+        void setSessionTaskPoolSize(int sessionTaskPoolSize);
+
+        /**
+         * Gets the ThreadPolicy that configures the threads this Connection creates.
+         *
+         * @return the ThreadPolicy in use by this Connection.
+         */
+        const activemq::threads::ThreadPolicy& getThreadPolicy() const;
+
+        /**
+         * Sets the ThreadPolicy that configures the name, priority and processor affinity
+         * of the transport reader, failover, scheduler, executor and session dispatch
+         * threads of this Connection.  The policy should be assigned before the Connection
+         * is started, threads that already exist are updated but sessions created earlier
+         * keep their dispatch thread settings.
+         *
+         * @param policy
+         *      The ThreadPolicy to copy.
+         */
+        void setThreadPolicy(const activemq::threads::ThreadPolicy& policy);
+
         /**
          * @return the current connection's OpenWire protocol version.
          */
@@ -933,6 +995,18 @@ namespace core {
          */
         void oneway(Pointer<commands::Command> command);
 
+        /**
+         * Sends a group of commands without requesting responses, in order and as one
+         * write to the transport where the transport supports it.
+         *
+         * @param commands
+         *      The Command objects to send to the Broker.
+         *
+         * @throws ActiveMQException if not currently connected, or if the operation
+         *         fails for any reason.
+         */
+        void onewayBatch(const decaf::util::List< Pointer<commands::Command> >& commands);
+
         /**
          * Sends a synchronous request and returns the response from the broker.  This
          * method converts any error responses it receives into an exception.
@@ -963,6 +1037,22 @@ namespace core {
          */
         void asyncRequest(Pointer<commands::Command> command, cms::AsyncCallback* onComplete);
 
+        /**
+         * Sends a request without waiting for the response, the returned future completes
+         * with the broker's response or, when the broker responds with an ExceptionResponse
+         * or the transport fails, exceptionally with the corresponding exception.  No thread
+         * is blocked while the request is outstanding.
+         *
+         * @param command
+         *      The Command object that is to be sent to the broker.
+         *
+         * @return a future for the broker's response.
+         *
+         * @throws ActiveMQException if an error occurs while sending the Command.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > asyncRequest(
+            Pointer<commands::Command> command);
+
         /**
          * Notify the exception listener
          * @param ex the exception to fire
@@ -1031,6 +1121,16 @@ namespace core {
          */
         decaf::util::concurrent::ExecutorService* getExecutor() const;
 
+        /**
+         * Returns the work stealing pool that this Connection's Sessions share for message
+         * dispatch and asynchronous acks when dedicated task runners are not in use.  The
+         * pool is created on first use with getSessionTaskPoolSize() threads and its threads
+         * are set up using the SESSION_DISPATCH role of the ThreadPolicy.
+         *
+         * @return the ExecutorService shared by this Connection's Sessions.
+         */
+        decaf::util::concurrent::ExecutorService* getSessionTaskExecutor() const;
+
         /**
          * Adds the given Temporary Destination to this Connections collection of known
          * Temporary Destinations.
@@ -43,6 +43,7 @@ using namespace activemq::util;
 using namespace activemq::core;
 using namespace activemq::core::policies;
 using namespace activemq::exceptions;
+using namespace activemq::threads;
 using namespace activemq::transport;
 using namespace decaf;
 using namespace decaf::net;
@@ -100,11 +101,14 @@ namespace core{
         long long optimizedAckScheduledAckInterval;
         long long consumerFailoverRedeliveryWaitPeriod;
         bool consumerExpiryCheckEnabled;
+        bool useDedicatedTaskRunner;
+        int sessionTaskPoolSize;
 
         cms::ExceptionListener* defaultListener;
         cms::MessageTransformer* defaultTransformer;
         std::auto_ptr<PrefetchPolicy> defaultPrefetchPolicy;
         std::auto_ptr<RedeliveryPolicy> defaultRedeliveryPolicy;
+        ThreadPolicy threadPolicy;
 
         FactorySettings() : configLock(),
                             properties(new Properties()),
@@ -136,10 +140,13 @@ namespace core{
                             optimizedAckScheduledAckInterval(0),
                             consumerFailoverRedeliveryWaitPeriod(0),
                             consumerExpiryCheckEnabled(true),
+                            useDedicatedTaskRunner(true),
+                            sessionTaskPoolSize(0),
                             defaultListener(NULL),
                             defaultTransformer(NULL),
                             defaultPrefetchPolicy(new DefaultPrefetchPolicy()),
-                            defaultRedeliveryPolicy(new DefaultRedeliveryPolicy()) {
+                            defaultRedeliveryPolicy(new DefaultRedeliveryPolicy()),
+                            threadPolicy() {
         }
 
         void updateConfiguration(const URI& uri) {
@@ -224,9 +231,14 @@ namespace core{
                 properties->getProperty("connection.alwaysSessionAsync", Boolean::toString(alwaysSessionAsync)));
             this->consumerExpiryCheckEnabled = Boolean::parseBoolean(
                 properties->getProperty("connection.consumerExpiryCheckEnabled", Boolean::toString(consumerExpiryCheckEnabled)));
+            this->useDedicatedTaskRunner = Boolean::parseBoolean(
+                properties->getProperty("connection.useDedicatedTaskRunner", Boolean::toString(useDedicatedTaskRunner)));
+            this->sessionTaskPoolSize = Integer::parseInt(
+                properties->getProperty("connection.sessionTaskPoolSize", Integer::toString(sessionTaskPoolSize)));
 
             this->defaultPrefetchPolicy->configure(*properties);
             this->defaultRedeliveryPolicy->configure(*properties);
+            this->threadPolicy.configure(*properties);
         }
 
         static URI createURI(const std::string& uriString) {
@@ -421,6 +433,9 @@ void ActiveMQConnectionFactory::configureConnection(ActiveMQConnection* connecti
     connection->setConsumerFailoverRedeliveryWaitPeriod(this->settings->consumerFailoverRedeliveryWaitPeriod);
     connection->setAlwaysSessionAsync(this->settings->alwaysSessionAsync);
     connection->setConsumerExpiryCheckEnabled(this->settings->consumerExpiryCheckEnabled);
+    connection->setUseDedicatedTaskRunner(this->settings->useDedicatedTaskRunner);
+    connection->setSessionTaskPoolSize(this->settings->sessionTaskPoolSize);
+    connection->setThreadPolicy(this->settings->threadPolicy);
 
     if (this->settings->defaultListener) {
         connection->setExceptionListener(this->settings->defaultListener);
@@ -508,6 +523,16 @@ PrefetchPolicy* ActiveMQConnectionFactory::getPrefetchPolicy() const {
     return this->settings->defaultPrefetchPolicy.get();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setThreadPolicy(const ThreadPolicy& policy) {
+    this->settings->threadPolicy = policy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const ThreadPolicy& ActiveMQConnectionFactory::getThreadPolicy() const {
+    return this->settings->threadPolicy;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnectionFactory::setRedeliveryPolicy(RedeliveryPolicy* policy) {
     this->settings->defaultRedeliveryPolicy.reset(policy);
@@ -762,3 +787,23 @@ bool ActiveMQConnectionFactory::isConsumerExpiryCheckEnabled() {
 void ActiveMQConnectionFactory::setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled) {
     this->settings->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isUseDedicatedTaskRunner() const {
+    return this->settings->useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setUseDedicatedTaskRunner(bool useDedicatedTaskRunner) {
+    this->settings->useDedicatedTaskRunner = useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnectionFactory::getSessionTaskPoolSize() const {
+    return this->settings->sessionTaskPoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setSessionTaskPoolSize(int sessionTaskPoolSize) {
+    this->settings->sessionTaskPoolSize = sessionTaskPoolSize;
+}
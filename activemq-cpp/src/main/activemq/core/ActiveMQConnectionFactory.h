@@ -23,6 +23,7 @@
 #include <cms/Connection.h>
 
 #include <activemq/transport/Transport.h>
+#include <activemq/threads/ThreadPolicy.h>
 
 #include <decaf/net/URI.h>
 #include <decaf/util/Properties.h>
@@ -260,6 +261,23 @@ namespace core {
          */
         PrefetchPolicy* getPrefetchPolicy() const;
 
+        /**
+         * Sets the ThreadPolicy that this factory applies to the Connections it creates, the
+         * policy is copied.  Any threads.* options in the broker URI override the settings
+         * given here for the Roles they name.
+         *
+         * @param policy
+         *      The ThreadPolicy that new Connections should use.
+         */
+        void setThreadPolicy(const activemq::threads::ThreadPolicy& policy);
+
+        /**
+         * Gets the ThreadPolicy that this factory applies to the Connections it creates.
+         *
+         * @return a reference to this objects ThreadPolicy.
+         */
+        const activemq::threads::ThreadPolicy& getThreadPolicy() const;
+
         /**
          * Sets the RedeliveryPolicy instance that this factory should use when it creates
          * new Connection instances.  The RedeliveryPolicy passed becomes the property of the
@@ -672,6 +690,43 @@ namespace core {
          */
         void setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled);
 
+        /**
+         * @return true if the Sessions of new Connections dispatch on threads of their own.
+         */
+        bool isUseDedicatedTaskRunner() const;
+
+        /**
+         * Configures whether the Sessions of Connections created by this factory each
+         * dispatch messages on a dedicated thread, the default, or share the work stealing
+         * pool of their Connection.  The pooled mode keeps the number of threads fixed when
+         * an application opens many Sessions.
+         *
+         * Listeners run on the pool threads in the pooled mode and must not block, see
+         * ActiveMQConnection::setUseDedicatedTaskRunner.
+         *
+         * @param useDedicatedTaskRunner
+         *      False if Sessions should dispatch on their Connection's shared pool.
+         */
+        void setUseDedicatedTaskRunner(bool useDedicatedTaskRunner);
+
+        /**
+         * @return the number of threads in the Session pool of new Connections, zero
+         *         means one per available processor.
+         */
+        int getSessionTaskPoolSize() const;
+
+        /**
+         * Sets the number of threads in the pool that the Sessions of each new Connection
+         * share when dedicated task runners are not in use, zero (the default) uses one
+         * thread per available processor.
+         *
+         * @param sessionTaskPoolSize
+         *      The number of pool threads, or zero for one per processor.
+         *
+         * @since 3.10.0
+         */
+        void setSessionTaskPoolSize(int sessionTaskPoolSize);
+
     public:
 
         /**
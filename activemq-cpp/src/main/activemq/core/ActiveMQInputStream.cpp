@@ -0,0 +1,227 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveMQInputStream.h"
+
+#include <cms/CMSException.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+#include <algorithm>
+#include <memory>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQInputStream::ActiveMQInputStream(cms::Session* session, const cms::Destination* destination,
+                                         const std::string& selector, long long timeout) :
+    InputStream(), session(session), consumer(NULL), current(NULL), streamId(), timeout(timeout),
+    remaining(0), nextSequence(1), endOfStream(false), closed(false) {
+
+    if (session == NULL) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Session instance provided was NULL.");
+    }
+
+    try {
+        this->consumer = session->createConsumer(destination, selector);
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, "Failed to create stream consumer: %s", ex.getMessage().c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQInputStream::~ActiveMQInputStream() {
+    try {
+        this->close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete this->consumer;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQInputStream::available() const {
+    checkClosed();
+    return this->remaining;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQInputStream::close() {
+
+    if (this->closed) {
+        return;
+    }
+
+    this->closed = true;
+
+    delete this->current;
+    this->current = NULL;
+    this->remaining = 0;
+
+    try {
+        this->consumer->close();
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, "Failed to close stream consumer: %s", ex.getMessage().c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQInputStream::doReadByte() {
+
+    unsigned char value = 0;
+    int result = this->doReadArrayBounded(&value, 1, 0, 1);
+    return result == -1 ? -1 : (int) value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQInputStream::doReadArrayBounded(unsigned char* buffer, int size, int offset, int length) {
+
+    if (length == 0) {
+        return 0;
+    }
+
+    if (buffer == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Buffer pointer passed was NULL.");
+    }
+
+    if (size < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "size parameter out of Bounds: %d.", size);
+    }
+
+    if (offset > size || offset < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "offset parameter out of Bounds: %d.", offset);
+    }
+
+    if (length < 0 || length > size - offset) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
+    }
+
+    checkClosed();
+
+    while (this->remaining == 0) {
+        if (!nextChunk()) {
+            return -1;
+        }
+    }
+
+    try {
+        int count = this->current->readBytes(buffer + offset, std::min(length, this->remaining));
+        this->remaining -= count;
+
+        if (this->remaining == 0) {
+            releaseChunk();
+        }
+
+        return count;
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, "Failed to read chunk of stream %s: %s",
+                          this->streamId.c_str(), ex.getMessage().c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQInputStream::nextChunk() {
+
+    if (this->endOfStream) {
+        return false;
+    }
+
+    try {
+
+        std::auto_ptr<cms::Message> message(
+            this->timeout > 0 ? this->consumer->receive((int) this->timeout) : this->consumer->receive());
+
+        if (message.get() == NULL) {
+            throw IOException(__FILE__, __LINE__, "Timed out waiting for chunk %d of stream %s.",
+                              this->nextSequence, this->streamId.c_str());
+        }
+
+        std::string groupId = message->getStringProperty("JMSXGroupID");
+        if (this->streamId.empty()) {
+            this->streamId = groupId;
+        } else if (groupId != this->streamId) {
+            throw IOException(__FILE__, __LINE__, "Received a chunk of stream %s while reading stream %s.",
+                              groupId.c_str(), this->streamId.c_str());
+        }
+
+        int sequence = message->getIntProperty("JMSXGroupSeq");
+
+        if (sequence == -1) {
+            if (this->session->getAcknowledgeMode() == cms::Session::CLIENT_ACKNOWLEDGE) {
+                message->acknowledge();
+            }
+            this->endOfStream = true;
+            return false;
+        }
+
+        if (sequence != this->nextSequence) {
+            throw IOException(__FILE__, __LINE__, "Expected chunk %d of stream %s but received chunk %d.",
+                              this->nextSequence, this->streamId.c_str(), sequence);
+        }
+
+        cms::BytesMessage* chunk = dynamic_cast<cms::BytesMessage*>(message.get());
+        if (chunk == NULL) {
+            throw IOException(__FILE__, __LINE__, "Chunk %d of stream %s is not a BytesMessage.",
+                              sequence, this->streamId.c_str());
+        }
+
+        message.release();
+        this->current = chunk;
+        this->remaining = chunk->getBodyLength();
+        this->nextSequence++;
+
+        if (this->remaining == 0) {
+            releaseChunk();
+        }
+
+        return true;
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, "Failed to receive chunk of stream %s: %s",
+                          this->streamId.c_str(), ex.getMessage().c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQInputStream::releaseChunk() {
+
+    std::auto_ptr<cms::BytesMessage> chunk(this->current);
+    this->current = NULL;
+
+    if (this->session->getAcknowledgeMode() == cms::Session::CLIENT_ACKNOWLEDGE) {
+        chunk->acknowledge();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQInputStream::checkClosed() const {
+    if (this->closed) {
+        throw IOException(__FILE__, __LINE__, "ActiveMQInputStream is closed.");
+    }
+}
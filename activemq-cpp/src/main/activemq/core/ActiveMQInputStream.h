@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_ACTIVEMQINPUTSTREAM_H_
+#define _ACTIVEMQ_CORE_ACTIVEMQINPUTSTREAM_H_
+
+#include <activemq/util/Config.h>
+
+#include <cms/Session.h>
+#include <cms/Destination.h>
+#include <cms/MessageConsumer.h>
+#include <cms/BytesMessage.h>
+#include <decaf/io/InputStream.h>
+
+#include <string>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * An InputStream that reassembles a payload sent by an ActiveMQOutputStream.  Chunk
+     * messages are received one at a time and read directly out of the message body, so
+     * only the chunks the broker has dispatched to the consumer are held in memory.  The
+     * number of those is bounded by the consumer prefetch, which can be set on the
+     * Destination, for instance "queue?consumer.prefetchSize=4".
+     *
+     * The stream reads exactly one payload, the group of the first chunk received, and
+     * returns -1 once its end of stream marker arrives.  Chunks from another stream or out
+     * of sequence are reported as an IOException.  In a CLIENT_ACKNOWLEDGE session each
+     * chunk is acknowledged once it has been read completely.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API ActiveMQInputStream : public decaf::io::InputStream {
+    private:
+
+        cms::Session* session;
+        cms::MessageConsumer* consumer;
+        cms::BytesMessage* current;
+        std::string streamId;
+        long long timeout;
+        int remaining;
+        int nextSequence;
+        bool endOfStream;
+        bool closed;
+
+    private:
+
+        ActiveMQInputStream(const ActiveMQInputStream&);
+        ActiveMQInputStream& operator=(const ActiveMQInputStream&);
+
+    public:
+
+        /**
+         * Creates a new stream that consumes chunks from the given Destination using a
+         * MessageConsumer created from the given Session, the stream owns the consumer.
+         *
+         * @param session
+         *      The Session used to create the consumer.
+         * @param destination
+         *      The Destination the chunks are consumed from.
+         * @param selector
+         *      Optional message selector used to pick the stream to read.
+         * @param timeout
+         *      Milliseconds to wait for each chunk, zero waits forever.
+         *
+         * @throws IllegalArgumentException if the session is NULL.
+         * @throws IOException if the consumer cannot be created.
+         */
+        ActiveMQInputStream(cms::Session* session, const cms::Destination* destination,
+                            const std::string& selector = "", long long timeout = 0);
+
+        virtual ~ActiveMQInputStream();
+
+        /**
+         * @return the JMSXGroupID of the stream being read, empty until the first chunk arrives.
+         */
+        const std::string& getStreamId() const {
+            return this->streamId;
+        }
+
+        /**
+         * @return the MessageConsumer owned by this stream.
+         */
+        cms::MessageConsumer* getConsumer() const {
+            return this->consumer;
+        }
+
+        /**
+         * @return the number of bytes left in the current chunk, which can be read without blocking.
+         */
+        virtual int available() const;
+
+        virtual void close();
+
+    protected:
+
+        virtual int doReadByte();
+
+        virtual int doReadArrayBounded(unsigned char* buffer, int size, int offset, int length);
+
+    private:
+
+        void checkClosed() const;
+
+        bool nextChunk();
+
+        void releaseChunk();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_ACTIVEMQINPUTSTREAM_H_ */
@@ -21,9 +21,10 @@
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/commands/ProducerId.h>
 
-#include <decaf/util/LRUCache.h>
+#include <decaf/util/LinkedFlatHashMap.h>
 #include <decaf/util/BitSet.h>
 #include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
 
 #include <string>
 
@@ -46,6 +47,49 @@ const int ActiveMQMessageAudit::MAXIMUM_PRODUCER_COUNT = 64;
 namespace activemq {
 namespace core {
 
+    /**
+     * Access ordered LRU map of producer id to the BitSet of sequence ids seen from it,
+     * kept in a LinkedFlatHashMap since duplicate checks look up a producer on every
+     * message.  Nothing here holds a reference returned from get() across a put.
+     */
+    class ProducerAuditCache : public LinkedFlatHashMap<std::string, Pointer<BitSet> > {
+    private:
+
+        int maxCacheSize;
+
+    public:
+
+        ProducerAuditCache() :
+            LinkedFlatHashMap<std::string, Pointer<BitSet> >(0, 0.75f, true), maxCacheSize(10000) {
+        }
+
+        ProducerAuditCache(int maxCacheSize) :
+            LinkedFlatHashMap<std::string, Pointer<BitSet> >(0, 0.75f, true), maxCacheSize(maxCacheSize) {
+
+            if (maxCacheSize <= 0) {
+                throw IllegalArgumentException(
+                    __FILE__, __LINE__, "Cache size must be greater than zero.");
+            }
+        }
+
+        virtual ~ProducerAuditCache() {}
+
+        void setMaxCacheSize(int size) {
+            if (size <= 0) {
+                throw IllegalArgumentException(
+                    __FILE__, __LINE__, "Cache size must be greater than zero.");
+            }
+
+            this->maxCacheSize = size;
+        }
+
+    protected:
+
+        virtual bool removeEldestEntry(const MapEntry<std::string, Pointer<BitSet> >& eldest AMQCPP_UNUSED) {
+            return this->size() > maxCacheSize;
+        }
+    };
+
     class MessageAuditImpl {
     private:
 
@@ -58,7 +102,7 @@ namespace core {
         int maximumNumberOfProducersToTrack;
         Mutex mutex;
 
-        LRUCache<std::string, Pointer<BitSet> > map;
+        ProducerAuditCache map;
 
         MessageAuditImpl() : auditDepth(2048),
                              maximumNumberOfProducersToTrack(64),
@@ -79,7 +123,7 @@ namespace core {
             // since putAll will access the entries in the right order,
             // this shouldn't result in wrong cache entries being removed
             if (value < maximumNumberOfProducersToTrack) {
-                LRUCache<std::string, Pointer<BitSet> > newMap(0, value, 0.75f, true);
+                ProducerAuditCache newMap(value);
                 newMap.putAll(this->map);
                 this->map.clear();
                 this->map.putAll(newMap);
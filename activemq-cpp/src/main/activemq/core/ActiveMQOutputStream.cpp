@@ -0,0 +1,202 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveMQOutputStream.h"
+
+#include <cms/BytesMessage.h>
+#include <cms/CMSException.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+#include <decaf/util/UUID.h>
+
+#include <algorithm>
+#include <memory>
+#include <string.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+const int ActiveMQOutputStream::DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQOutputStream::ActiveMQOutputStream(cms::Session* session, const cms::Destination* destination, int chunkSize) :
+    OutputStream(), session(session), producer(NULL), streamId(), buffer(), position(0), sequence(0), closed(false) {
+
+    if (session == NULL) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Session instance provided was NULL.");
+    }
+
+    if (chunkSize <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Chunk size must be positive: %d.", chunkSize);
+    }
+
+    try {
+        this->producer = session->createProducer(destination);
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, "Failed to create stream producer: %s", ex.getMessage().c_str());
+    }
+
+    this->streamId = "ID:stream:" + UUID::randomUUID().toString();
+    this->buffer.resize(chunkSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQOutputStream::~ActiveMQOutputStream() {
+    try {
+        this->close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete this->producer;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::flush() {
+
+    checkClosed();
+
+    if (this->position > 0) {
+        sendChunk(&this->buffer[0], this->position);
+        this->position = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::close() {
+
+    if (this->closed) {
+        return;
+    }
+
+    try {
+        this->flush();
+
+        std::auto_ptr<cms::Message> message(this->session->createMessage());
+        message->setStringProperty("JMSXGroupID", this->streamId);
+        message->setIntProperty("JMSXGroupSeq", -1);
+        this->producer->send(message.get());
+
+        this->closed = true;
+        this->producer->close();
+    } catch (cms::CMSException& ex) {
+        this->closed = true;
+        throw IOException(__FILE__, __LINE__, "Failed to end stream %s: %s",
+                          this->streamId.c_str(), ex.getMessage().c_str());
+    } catch (...) {
+        // An IOException from flush or anything else unexpected still ends the
+        // stream, otherwise the destructor would try to send the end marker again.
+        this->closed = true;
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::doWriteByte(unsigned char value) {
+
+    checkClosed();
+
+    this->buffer[this->position++] = value;
+    if (this->position == (int) this->buffer.size()) {
+        this->flush();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length) {
+
+    if (length == 0) {
+        return;
+    }
+
+    if (buffer == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Buffer pointer passed was NULL.");
+    }
+
+    if (size < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "size parameter out of Bounds: %d.", size);
+    }
+
+    if (offset > size || offset < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "offset parameter out of Bounds: %d.", offset);
+    }
+
+    if (length < 0 || length > size - offset) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
+    }
+
+    checkClosed();
+
+    const int chunkSize = (int) this->buffer.size();
+    const unsigned char* data = buffer + offset;
+
+    while (length > 0) {
+
+        // Whole chunks go straight from the caller's array into a message.
+        if (this->position == 0 && length >= chunkSize) {
+            sendChunk(data, chunkSize);
+            data += chunkSize;
+            length -= chunkSize;
+            continue;
+        }
+
+        int count = std::min(length, chunkSize - this->position);
+        memcpy(&this->buffer[this->position], data, count);
+        this->position += count;
+        data += count;
+        length -= count;
+
+        if (this->position == chunkSize) {
+            this->flush();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::sendChunk(const unsigned char* data, int length) {
+
+    try {
+        std::auto_ptr<cms::BytesMessage> message(this->session->createBytesMessage(data, length));
+        message->setStringProperty("JMSXGroupID", this->streamId);
+        message->setIntProperty("JMSXGroupSeq", this->sequence + 1);
+        this->producer->send(message.get());
+        this->sequence++;
+    } catch (cms::CMSException& ex) {
+        throw IOException(__FILE__, __LINE__, "Failed to send chunk %d of stream %s: %s",
+                          this->sequence + 1, this->streamId.c_str(), ex.getMessage().c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQOutputStream::checkClosed() const {
+    if (this->closed) {
+        throw IOException(__FILE__, __LINE__, "ActiveMQOutputStream is closed.");
+    }
+}
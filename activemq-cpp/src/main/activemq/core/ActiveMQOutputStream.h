@@ -0,0 +1,154 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_ACTIVEMQOUTPUTSTREAM_H_
+#define _ACTIVEMQ_CORE_ACTIVEMQOUTPUTSTREAM_H_
+
+#include <activemq/util/Config.h>
+
+#include <cms/Session.h>
+#include <cms/Destination.h>
+#include <cms/MessageProducer.h>
+#include <decaf/io/OutputStream.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * An OutputStream that sends everything written to it to a Destination as a series
+     * of BytesMessage chunks, allowing payloads far larger than would be practical to
+     * hold in a single message.  At most one chunk is buffered by the stream at a time
+     * so memory use is bounded by the chunk size and not the size of the payload.
+     *
+     * All chunks of a stream carry the same JMSXGroupID, which keeps them on a single
+     * consumer, and an increasing JMSXGroupSeq starting at one.  Closing the stream sends
+     * a final empty Message with a JMSXGroupSeq of -1 which marks the end of the stream
+     * and closes the message group on the broker.  The matching ActiveMQInputStream
+     * reassembles the payload on the consuming side.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API ActiveMQOutputStream : public decaf::io::OutputStream {
+    public:
+
+        /**
+         * The chunk size used when none is given, 64KB.
+         */
+        static const int DEFAULT_CHUNK_SIZE;
+
+    private:
+
+        cms::Session* session;
+        cms::MessageProducer* producer;
+        std::string streamId;
+        std::vector<unsigned char> buffer;
+        int position;
+        int sequence;
+        bool closed;
+
+    private:
+
+        ActiveMQOutputStream(const ActiveMQOutputStream&);
+        ActiveMQOutputStream& operator=(const ActiveMQOutputStream&);
+
+    public:
+
+        /**
+         * Creates a new stream that sends to the given Destination using a MessageProducer
+         * created from the given Session, the stream owns the producer.
+         *
+         * @param session
+         *      The Session used to create the producer and the chunk messages.
+         * @param destination
+         *      The Destination the chunks are sent to.
+         * @param chunkSize
+         *      The maximum number of payload bytes carried by each chunk message.
+         *
+         * @throws IllegalArgumentException if the session is NULL or chunkSize is not positive.
+         * @throws IOException if the producer cannot be created.
+         */
+        ActiveMQOutputStream(cms::Session* session, const cms::Destination* destination,
+                             int chunkSize = DEFAULT_CHUNK_SIZE);
+
+        virtual ~ActiveMQOutputStream();
+
+        /**
+         * @return the JMSXGroupID value that identifies the chunks of this stream.
+         */
+        const std::string& getStreamId() const {
+            return this->streamId;
+        }
+
+        /**
+         * @return the maximum number of payload bytes sent in each chunk.
+         */
+        int getChunkSize() const {
+            return (int) this->buffer.size();
+        }
+
+        /**
+         * @return the number of chunk messages sent so far, not counting the end of stream marker.
+         */
+        int getChunksSent() const {
+            return this->sequence;
+        }
+
+        /**
+         * Gets the MessageProducer used to send the chunks, it can be used to configure the
+         * delivery mode, priority and time to live of the chunk messages before writing.
+         *
+         * @return the MessageProducer owned by this stream.
+         */
+        cms::MessageProducer* getProducer() const {
+            return this->producer;
+        }
+
+        /**
+         * Sends any buffered bytes as a chunk, which may be smaller than the chunk size.
+         *
+         * @throws IOException if the stream is closed or the chunk cannot be sent.
+         */
+        virtual void flush();
+
+        /**
+         * Sends any buffered bytes followed by the end of stream marker and closes the
+         * producer.  Calling close on a closed stream has no effect.
+         *
+         * @throws IOException if the final messages cannot be sent.
+         */
+        virtual void close();
+
+    protected:
+
+        virtual void doWriteByte(unsigned char value);
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
+
+    private:
+
+        void checkClosed() const;
+
+        void sendChunk(const unsigned char* data, int length);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_ACTIVEMQOUTPUTSTREAM_H_ */
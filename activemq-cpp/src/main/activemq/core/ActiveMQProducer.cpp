@@ -25,9 +25,11 @@ using namespace activemq;
 using namespace activemq::util;
 using namespace activemq::core;
 using namespace activemq::core::kernels;
+using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
 
 ////////////////////////////////////////////////////////////////////////////////
 ActiveMQProducer::ActiveMQProducer(Pointer<ActiveMQProducerKernel> kernel) : kernel(kernel) {
@@ -128,3 +130,83 @@ void ActiveMQProducer::send(const cms::Destination* destination, cms::Message* m
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQProducer::sendAsync(cms::Message* message) {
+
+    try {
+        return this->kernel->sendAsync(message);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQProducer::sendAsync(cms::Message* message, int deliveryMode,
+                                                                                int priority, long long timeToLive) {
+
+    try {
+        return this->kernel->sendAsync(message, deliveryMode, priority, timeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQProducer::sendAsync(const cms::Destination* destination,
+                                                                                cms::Message* message) {
+
+    try {
+        return this->kernel->sendAsync(destination, message);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQProducer::sendAsync(const cms::Destination* destination,
+                                                                                cms::Message* message, int deliveryMode,
+                                                                                int priority, long long timeToLive) {
+
+    try {
+        return this->kernel->sendAsync(destination, message, deliveryMode, priority, timeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::sendBatch(const decaf::util::List<cms::Message*>& messages) {
+
+    try {
+        this->kernel->sendBatch(messages);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::sendBatch(const decaf::util::List<cms::Message*>& messages,
+                                 int deliveryMode, int priority, long long timeToLive) {
+
+    try {
+        this->kernel->sendBatch(messages, deliveryMode, priority, timeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::sendBatch(const cms::Destination* destination,
+                                 const decaf::util::List<cms::Message*>& messages) {
+
+    try {
+        this->kernel->sendBatch(destination, messages);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducer::sendBatch(const cms::Destination* destination,
+                                 const decaf::util::List<cms::Message*>& messages,
+                                 int deliveryMode, int priority, long long timeToLive) {
+
+    try {
+        this->kernel->sendBatch(destination, messages, deliveryMode, priority, timeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
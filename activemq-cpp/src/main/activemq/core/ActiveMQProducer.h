@@ -206,6 +206,88 @@ namespace core {
         const Pointer<commands::ProducerId>& getProducerId() const {
             return this->kernel->getProducerId();
         }
+
+        /**
+         * Sends the message to this producer's destination and returns a future that
+         * completes when the broker acknowledges it, see ActiveMQProducerKernel::sendAsync.
+         *
+         * @param message
+         *      The message to send, the caller retains ownership.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            cms::Message* message);
+
+        /**
+         * Sends the message to this producer's destination with the given delivery mode,
+         * priority and time to live, returning a future for the broker's acknowledgement.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            cms::Message* message, int deliveryMode, int priority, long long timeToLive);
+
+        /**
+         * Sends the message to the given destination, returning a future for the broker's
+         * acknowledgement.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            const cms::Destination* destination, cms::Message* message);
+
+        /**
+         * Sends the message to the given destination with the given delivery mode, priority
+         * and time to live, returning a future for the broker's acknowledgement.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            const cms::Destination* destination, cms::Message* message, int deliveryMode, int priority, long long timeToLive);
+
+        /**
+         * Sends a group of messages to this producer's destination, doing the per send
+         * work once for the group, see ActiveMQProducerKernel::sendBatch.
+         *
+         * @param messages
+         *      The messages to send in order, the caller retains ownership.
+         *
+         * @throws CMSException if an error occurs while sending the messages.
+         */
+        void sendBatch(const decaf::util::List<cms::Message*>& messages);
+
+        /**
+         * Sends a group of messages to this producer's destination with the given delivery
+         * mode, priority and time to live.
+         *
+         * @throws CMSException if an error occurs while sending the messages.
+         */
+        void sendBatch(const decaf::util::List<cms::Message*>& messages, int deliveryMode, int priority, long long timeToLive);
+
+        /**
+         * Sends a group of messages to the given destination.
+         *
+         * @throws CMSException if an error occurs while sending the messages.
+         */
+        void sendBatch(const cms::Destination* destination, const decaf::util::List<cms::Message*>& messages);
+
+        /**
+         * Sends a group of messages to the given destination with the given delivery mode,
+         * priority and time to live.
+         *
+         * @throws CMSException if an error occurs while sending the messages.
+         */
+        void sendBatch(const cms::Destination* destination, const decaf::util::List<cms::Message*>& messages,
+                       int deliveryMode, int priority, long long timeToLive);
    };
 
 }}
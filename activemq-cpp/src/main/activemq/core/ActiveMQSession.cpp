@@ -72,6 +72,14 @@ void ActiveMQSession::commit() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSession::commitAsync(cms::AsyncCallback* onComplete) {
+    try {
+        this->kernel->commitAsync(onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSession::rollback() {
     try {
@@ -17,6 +17,7 @@
 #ifndef _ACTIVEMQ_CORE_ACTIVEMQSESSION_H_
 #define _ACTIVEMQ_CORE_ACTIVEMQSESSION_H_
 
+#include <cms/AsyncCallback.h>
 #include <cms/Session.h>
 #include <cms/ExceptionListener.h>
 
@@ -186,6 +187,26 @@ namespace core {
             return this->kernel->getSessionId();
         }
 
+        /**
+         * Commits the current transaction without blocking for the broker's response,
+         * the session can start its next transaction right away.  The callback is told
+         * of the outcome, if the commit fails the transaction was rolled back.
+         *
+         * Commits complete in the order they were issued.  A transaction in which this
+         * session consumed messages is committed synchronously so that the consumers'
+         * state is settled before the next transaction, the callback is then notified
+         * before this method returns.
+         *
+         * @param onComplete
+         *      The callback notified when the commit completes, the caller retains
+         *      ownership and must keep it alive until notified.  When NULL this
+         *      method is the same as calling commit().
+         *
+         * @throws CMSException if the session is closed or not transacted, or the
+         *         commit could not be sent.
+         */
+        virtual void commitAsync(cms::AsyncCallback* onComplete);
+
         /**
          * Gets the ActiveMQConnection that is associated with this session.
          */
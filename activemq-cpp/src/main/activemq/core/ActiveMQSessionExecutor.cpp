@@ -25,6 +25,7 @@
 #include <activemq/core/SimplePriorityMessageDispatchChannel.h>
 #include <activemq/commands/ConsumerInfo.h>
 #include <activemq/threads/DedicatedTaskRunner.h>
+#include <activemq/threads/PooledTaskRunner.h>
 
 using namespace std;
 using namespace activemq;
@@ -36,6 +37,14 @@ using namespace decaf::lang;
 using namespace decaf::util;
 using namespace decaf::util::concurrent;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Dispatches a pooled session makes before it lets other sessions have the thread.
+    const int MAX_ITERATIONS_PER_RUN = 1000;
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ActiveMQSessionExecutor::ActiveMQSessionExecutor(ActiveMQSessionKernel* session) :
     session(session), messageQueue(), taskRunner() {
@@ -110,7 +119,15 @@ void ActiveMQSessionExecutor::wakeup() {
             if (!messageQueue->isRunning()) {
                 return;
             }
-            this->taskRunner.reset(new DedicatedTaskRunner(this));
+            ActiveMQConnection* connection = this->session->getConnection();
+            if (connection->isUseDedicatedTaskRunner()) {
+                Pointer<DedicatedTaskRunner> runner(new DedicatedTaskRunner(this));
+                runner->applyThreadPolicy(connection->getThreadPolicy(), ThreadPolicy::SESSION_DISPATCH);
+                this->taskRunner = runner;
+            } else {
+                this->taskRunner.reset(new PooledTaskRunner(
+                    connection->getSessionTaskExecutor(), this, MAX_ITERATIONS_PER_RUN));
+            }
             this->taskRunner->start();
         }
 
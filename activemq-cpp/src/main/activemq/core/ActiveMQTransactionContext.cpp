@@ -222,6 +222,59 @@ void ActiveMQTransactionContext::commit() {
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQTransactionContext::commitAsync(cms::AsyncCallback* onComplete) {
+
+    try{
+
+        if (onComplete == NULL) {
+            this->commit();
+            return;
+        }
+
+        if (isInXATransaction()) {
+            throw cms::TransactionInProgressException("Cannot Commit a local transaction while an XA Transaction is in progress.");
+        }
+
+        bool hasSynchronizations = false;
+        synchronized(&this->synchronizations) {
+            hasSynchronizations = !this->synchronizations.isEmpty();
+        }
+
+        // The Synchronizations update consumer and session state that the next transaction
+        // depends on, they must not run on the transport thread while the session continues.
+        if (hasSynchronizations) {
+            try {
+                this->commit();
+            } catch (cms::CMSException& ex) {
+                onComplete->onException(ex);
+                return;
+            }
+
+            onComplete->onSuccess();
+            return;
+        }
+
+        if (isInTransaction()) {
+            Pointer<TransactionInfo> info(new TransactionInfo());
+            info->setConnectionId(this->connection->getConnectionInfo().getConnectionId());
+            info->setTransactionId(this->context->transactionId);
+            info->setType(ActiveMQConstants::TRANSACTION_STATE_COMMITONEPHASE);
+
+            // The next call to begin starts a new transaction while this one completes.
+            this->context->transactionId.reset(NULL);
+
+            this->connection->asyncRequest(info, onComplete);
+        } else {
+            onComplete->onSuccess();
+        }
+    }
+    AMQ_CATCH_RETHROW(cms::CMSException)
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQTransactionContext::rollback() {
 
@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include <cms/AsyncCallback.h>
 #include <cms/Message.h>
 #include <cms/XAResource.h>
 #include <cms/CMSException.h>
@@ -115,6 +116,25 @@ namespace kernels {
          */
         virtual void commit();
 
+        /**
+         * Commits the current Transaction without waiting for the broker to answer, the
+         * outcome is reported to the given callback and a new Transaction can be started
+         * as soon as this method returns.  Commits complete in the order they are issued
+         * since they travel the same connection as the rest of the session's commands.
+         *
+         * When the Transaction has registered Synchronizations, such as a consumer that
+         * acknowledged messages in it, the commit is done synchronously and the callback
+         * is invoked before this method returns.  The Synchronizations then run before the
+         * session can deliver messages that belong to the next Transaction.
+         *
+         * @param onComplete
+         *      The callback notified of the commit result, if NULL this method behaves
+         *      exactly like commit().  The caller retains ownership.
+         *
+         * @throw ActiveMQException
+         */
+        virtual void commitAsync(cms::AsyncCallback* onComplete);
+
         /**
          * Rollback the current Transaction
          * @throw ActiveMQException
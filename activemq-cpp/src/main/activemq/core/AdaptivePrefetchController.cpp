@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AdaptivePrefetchController.h"
+
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <math.h>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    int clamp(int value, int minimum, int maximum) {
+        return value < minimum ? minimum : (value > maximum ? maximum : value);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AdaptivePrefetchController::AdaptivePrefetchController(int initialPrefetch, int minimumPrefetch, int maximumPrefetch,
+                                                       long long interval, long long startTime) :
+    minimumPrefetch(minimumPrefetch),
+    maximumPrefetch(maximumPrefetch),
+    interval(interval),
+    consumed(0),
+    prefetch(0),
+    processingRate(0),
+    lastSampleTime(startTime),
+    sampled(false) {
+
+    if (minimumPrefetch < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Minimum prefetch must be at least one");
+    }
+    if (maximumPrefetch < minimumPrefetch) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Maximum prefetch must not be less than the minimum");
+    }
+    if (interval <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Sampling interval must be greater than zero");
+    }
+
+    this->prefetch.set(clamp(initialPrefetch, minimumPrefetch, maximumPrefetch));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AdaptivePrefetchController::~AdaptivePrefetchController() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchController::messageConsumed() {
+    this->consumed.incrementAndGet();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AdaptivePrefetchController::sample(long long currentTime, int queueDepth) {
+
+    long long elapsed = currentTime - this->lastSampleTime;
+    if (elapsed <= 0) {
+        return false;
+    }
+
+    int count = this->consumed.getAndSet(0);
+    this->lastSampleTime = currentTime;
+
+    if (count == 0 && queueDepth == 0) {
+        // No traffic, nothing learned about how fast this consumer is.
+        return false;
+    }
+
+    double rate = (double) count * 1000.0 / (double) elapsed;
+    this->processingRate = this->sampled ? (this->processingRate + rate) / 2.0 : rate;
+    this->sampled = true;
+
+    int current = this->prefetch.get();
+    int target = current;
+
+    if (count == 0) {
+        // Messages are waiting and none were processed, the consumer is stalled.
+        target = this->minimumPrefetch;
+    } else {
+        double work = ceil(this->processingRate * (double) this->interval / 1000.0);
+        target = work > (double) this->maximumPrefetch ? this->maximumPrefetch : (int) work;
+
+        if (queueDepth == 0 && count >= current) {
+            // Drained all it was sent, the window is what holds this consumer back.
+            target = target > current * 2 ? target : current * 2;
+        }
+    }
+
+    target = clamp(target, current / 2, current * 2);
+    target = clamp(target, this->minimumPrefetch, this->maximumPrefetch);
+
+    if (target == current) {
+        return false;
+    }
+
+    // Small corrections aren't worth a round trip to the broker, except to reach a bound.
+    if (target != this->minimumPrefetch && target != this->maximumPrefetch &&
+        (target > current ? target - current : current - target) * 10 < current) {
+        return false;
+    }
+
+    this->prefetch.set(target);
+    return true;
+}
@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_
+#define _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * Computes the prefetch window of a single consumer from its observed processing
+     * rate and the depth of its dispatch queue.
+     *
+     * The consumer reports every message it finishes with messageConsumed, and on each
+     * sampling interval calls sample with the number of messages still waiting to be
+     * delivered.  The window aims to hold one sampling interval's worth of work at the
+     * smoothed processing rate: a consumer that drains everything it is sent grows its
+     * window, one with messages waiting that it isn't getting through shrinks it so the
+     * broker hands the work to its competitors instead.  Each sample moves the window by
+     * at most a factor of two and always stays within the configured bounds.
+     *
+     * messageConsumed may be called from any thread, sample is expected to be called
+     * from one thread at a time.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API AdaptivePrefetchController {
+    private:
+
+        int minimumPrefetch;
+        int maximumPrefetch;
+        long long interval;
+
+        decaf::util::concurrent::atomic::AtomicInteger consumed;
+        decaf::util::concurrent::atomic::AtomicInteger prefetch;
+
+        double processingRate;
+        long long lastSampleTime;
+        bool sampled;
+
+    private:
+
+        AdaptivePrefetchController(const AdaptivePrefetchController&);
+        AdaptivePrefetchController& operator= (const AdaptivePrefetchController&);
+
+    public:
+
+        /**
+         * Creates a new controller.
+         *
+         * @param initialPrefetch
+         *      The window to start from, clamped to the given bounds.
+         * @param minimumPrefetch
+         *      The smallest window the controller will choose, at least one.
+         * @param maximumPrefetch
+         *      The largest window the controller will choose.
+         * @param interval
+         *      The time in milliseconds between samples.
+         * @param startTime
+         *      The time in milliseconds that the first sample interval starts at.
+         *
+         * @throws IllegalArgumentException if the bounds or interval are invalid.
+         */
+        AdaptivePrefetchController(int initialPrefetch, int minimumPrefetch, int maximumPrefetch,
+                                   long long interval, long long startTime);
+
+        virtual ~AdaptivePrefetchController();
+
+        /**
+         * Records that the consumer finished processing one message.
+         */
+        void messageConsumed();
+
+        /**
+         * Closes the current sampling interval and recomputes the window.
+         *
+         * @param currentTime
+         *      The current time in milliseconds.
+         * @param queueDepth
+         *      The number of messages dispatched to the consumer that it has not yet
+         *      started processing.
+         *
+         * @return true if the window changed and the broker should be told about it.
+         */
+        bool sample(long long currentTime, int queueDepth);
+
+        /**
+         * @return the current prefetch window.
+         */
+        int getPrefetch() const {
+            return this->prefetch.get();
+        }
+
+        /**
+         * @return the smoothed processing rate in messages per second, zero before the
+         *         first sample.
+         */
+        double getProcessingRate() const {
+            return this->processingRate;
+        }
+
+        int getMinimumPrefetch() const {
+            return this->minimumPrefetch;
+        }
+
+        int getMaximumPrefetch() const {
+            return this->maximumPrefetch;
+        }
+
+        long long getInterval() const {
+            return this->interval;
+        }
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_ */
@@ -17,7 +17,7 @@
 
 #include "ConnectionAudit.h"
 
-#include <decaf/util/LinkedHashMap.h>
+#include <decaf/util/LinkedFlatHashMap.h>
 #include <decaf/util/StlMap.h>
 
 #include <activemq/core/Dispatcher.h>
@@ -51,7 +51,7 @@ namespace core {
         Mutex mutex;
 
         StlMap<Pointer<ActiveMQDestination>, Pointer<ActiveMQMessageAudit>, ActiveMQDestination::COMPARATOR> destinations;
-        LinkedHashMap<Dispatcher*, Pointer<ActiveMQMessageAudit> > dispatchers;
+        LinkedFlatHashMap<Dispatcher*, Pointer<ActiveMQMessageAudit> > dispatchers;
 
         ConnectionAuditImpl() : mutex(), destinations(), dispatchers(1000) {
         }
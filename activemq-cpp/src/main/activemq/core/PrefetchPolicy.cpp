@@ -17,7 +17,9 @@
 
 #include "PrefetchPolicy.h"
 
+#include <decaf/lang/Boolean.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
 
 using namespace activemq;
 using namespace activemq::core;
@@ -32,6 +34,42 @@ PrefetchPolicy::PrefetchPolicy() {
 PrefetchPolicy::~PrefetchPolicy() {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void PrefetchPolicy::setAdaptive(bool value AMQCPP_UNUSED) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PrefetchPolicy::isAdaptive() const {
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrefetchPolicy::setAdaptiveMinimumPrefetch(int value AMQCPP_UNUSED) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PrefetchPolicy::getAdaptiveMinimumPrefetch() const {
+    return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrefetchPolicy::setAdaptiveMaximumPrefetch(int value AMQCPP_UNUSED) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PrefetchPolicy::getAdaptiveMaximumPrefetch() const {
+    return 1000;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrefetchPolicy::setAdaptiveInterval(long long value AMQCPP_UNUSED) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long PrefetchPolicy::getAdaptiveInterval() const {
+    return 1000;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void PrefetchPolicy::setAll(int value) {
 
@@ -67,6 +105,23 @@ void PrefetchPolicy::configure(const decaf::util::Properties& properties) {
                 properties.getProperty("cms.prefetchPolicy.topicPrefetch")));
         }
 
+        if (properties.hasProperty("cms.prefetchPolicy.adaptive")) {
+            this->setAdaptive(Boolean::parseBoolean(
+                properties.getProperty("cms.prefetchPolicy.adaptive")));
+        }
+        if (properties.hasProperty("cms.prefetchPolicy.adaptiveMinimumPrefetch")) {
+            this->setAdaptiveMinimumPrefetch(Integer::parseInt(
+                properties.getProperty("cms.prefetchPolicy.adaptiveMinimumPrefetch")));
+        }
+        if (properties.hasProperty("cms.prefetchPolicy.adaptiveMaximumPrefetch")) {
+            this->setAdaptiveMaximumPrefetch(Integer::parseInt(
+                properties.getProperty("cms.prefetchPolicy.adaptiveMaximumPrefetch")));
+        }
+        if (properties.hasProperty("cms.prefetchPolicy.adaptiveInterval")) {
+            this->setAdaptiveInterval(Long::parseLong(
+                properties.getProperty("cms.prefetchPolicy.adaptiveInterval")));
+        }
+
         if (properties.hasProperty("cms.prefetchPolicy.all")) {
             int value = Integer::parseInt(properties.getProperty("cms.prefetchPolicy.all"));
 
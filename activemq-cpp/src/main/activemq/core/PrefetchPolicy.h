@@ -105,6 +105,85 @@ namespace core {
          */
         virtual int getTopicPrefetch() const = 0;
 
+        /**
+         * Sets whether consumers adapt their prefetch window to their observed processing
+         * rate.  When enabled the static prefetch values become the starting window, each
+         * consumer then periodically measures how fast it consumes messages and how many
+         * are waiting in its dispatch queue and asks the broker for a larger or smaller
+         * window within the adaptive minimum and maximum.  Consumers with a prefetch of
+         * zero pull their messages and are never adapted.
+         *
+         * The default implementation ignores the value so that policies which predate
+         * adaptive prefetch keep their static windows, subclasses that support it override
+         * all of the adaptive accessors.
+         *
+         * @param value
+         *      True to enable adaptive prefetch for newly created consumers.
+         *
+         * @since 3.10.0
+         */
+        virtual void setAdaptive(bool value);
+
+        /**
+         * @return true if consumers adapt their prefetch window to their processing rate,
+         *         the default implementation always returns false.
+         *
+         * @since 3.10.0
+         */
+        virtual bool isAdaptive() const;
+
+        /**
+         * Sets the smallest window an adaptive consumer will shrink its prefetch to.
+         *
+         * @param value
+         *      The lower bound of the adaptive prefetch window, at least one.
+         *
+         * @since 3.10.0
+         */
+        virtual void setAdaptiveMinimumPrefetch(int value);
+
+        /**
+         * @return the lower bound of the adaptive prefetch window.
+         *
+         * @since 3.10.0
+         */
+        virtual int getAdaptiveMinimumPrefetch() const;
+
+        /**
+         * Sets the largest window an adaptive consumer will grow its prefetch to.
+         *
+         * @param value
+         *      The upper bound of the adaptive prefetch window.
+         *
+         * @since 3.10.0
+         */
+        virtual void setAdaptiveMaximumPrefetch(int value);
+
+        /**
+         * @return the upper bound of the adaptive prefetch window.
+         *
+         * @since 3.10.0
+         */
+        virtual int getAdaptiveMaximumPrefetch() const;
+
+        /**
+         * Sets how often an adaptive consumer samples its processing rate and dispatch
+         * queue depth, which is also how much buffered work the window aims to hold.
+         *
+         * @param value
+         *      The sampling interval in milliseconds.
+         *
+         * @since 3.10.0
+         */
+        virtual void setAdaptiveInterval(long long value);
+
+        /**
+         * @return the adaptive sampling interval in milliseconds.
+         *
+         * @since 3.10.0
+         */
+        virtual long long getAdaptiveInterval() const;
+
         /**
          * Sets the prefetch value on all available prefetch configuration options.
          *
@@ -29,12 +29,15 @@
 #include <decaf/util/Collections.h>
 #include <decaf/util/concurrent/ExecutorService.h>
 #include <decaf/util/concurrent/Executors.h>
+#include <decaf/util/concurrent/Future.h>
+#include <decaf/util/concurrent/RejectedExecutionException.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
 #include <activemq/util/Config.h>
 #include <activemq/util/CMSExceptionSupport.h>
 #include <activemq/util/ActiveMQProperties.h>
 #include <activemq/util/ActiveMQMessageTransformation.h>
 #include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/commands/ConsumerControl.h>
 #include <activemq/commands/Message.h>
 #include <activemq/commands/MessageAck.h>
 #include <activemq/commands/MessagePull.h>
@@ -45,8 +48,10 @@
 #include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQTransactionContext.h>
 #include <activemq/core/ActiveMQAckHandler.h>
+#include <activemq/core/AdaptivePrefetchController.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
 #include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/core/PrefetchPolicy.h>
 #include <activemq/core/RedeliveryPolicy.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/threads/Scheduler.h>
@@ -126,7 +131,10 @@ namespace kernels {
         Runnable* optimizedAckTask;
         int ackCounter;
         int dispatchedCount;
+        Pointer<AdaptivePrefetchController> adaptivePrefetch;
+        Runnable* adaptivePrefetchTask;
         Pointer<ExecutorService> executor;
+        Pointer< Future<bool> > pendingAckTask;
         ActiveMQSessionKernel* session;
         ActiveMQConsumerKernel* parent;
         Pointer<ConsumerInfo> info;
@@ -164,12 +172,28 @@ namespace kernels {
                                          optimizedAckTask(),
                                          ackCounter(),
                                          dispatchedCount(),
+                                         adaptivePrefetch(),
+                                         adaptivePrefetchTask(),
                                          executor(),
+                                         pendingAckTask(),
                                          session(),
                                          parent(),
                                          info() {
         }
 
+        /**
+         * The window acks are batched against, an adapted window can be smaller than
+         * the prefetch the consumer was created with and batching against that would
+         * stall the consumer waiting on messages the broker won't send.
+         */
+        int getAckWindowSize() const {
+            if (adaptivePrefetch != NULL) {
+                return info->getCurrentPrefetchSize();
+            }
+
+            return info->getPrefetchSize();
+        }
+
         bool isTimeForOptimizedAck(int prefetchSize) const {
             if (ackCounter + deliveredCounter >= (prefetchSize * 0.65)) {
                 return true;
@@ -667,6 +691,52 @@ namespace {
         }
     };
 
+    /**
+     * Periodically samples the consumer's processing rate and dispatch queue depth and,
+     * when the adaptive prefetch window changes, tells the broker with a ConsumerControl.
+     */
+    class AdaptivePrefetchTask : public Runnable {
+    private:
+
+        ActiveMQConsumerKernel* consumer;
+        ActiveMQConsumerKernelConfig* impl;
+
+    private:
+
+        AdaptivePrefetchTask(const AdaptivePrefetchTask&);
+        AdaptivePrefetchTask& operator=(const AdaptivePrefetchTask&);
+
+    public:
+
+        AdaptivePrefetchTask(ActiveMQConsumerKernel* consumer, ActiveMQConsumerKernelConfig* impl) :
+            Runnable(), consumer(consumer), impl(impl) {}
+        virtual ~AdaptivePrefetchTask() {}
+
+        virtual void run() {
+            try {
+                if (impl->unconsumedMessages->isClosed()) {
+                    return;
+                }
+
+                if (impl->adaptivePrefetch->sample(System::currentTimeMillis(), impl->unconsumedMessages->size())) {
+                    int prefetch = impl->adaptivePrefetch->getPrefetch();
+
+                    // Flushes pending acks so a shrinking window is measured against
+                    // what the consumer really still holds.
+                    this->consumer->setPrefetchSize(prefetch);
+
+                    Pointer<ConsumerControl> control(new ConsumerControl());
+                    control->setConsumerId(impl->info->getConsumerId());
+                    control->setDestination(impl->info->getDestination());
+                    control->setPrefetch(prefetch);
+                    impl->session->oneway(control);
+                }
+            } catch(Exception& ex) {
+                impl->session->getConnection()->onAsyncException(ex);
+            }
+        }
+    };
+
     class NonBlockingRedeliveryTask : public Runnable {
     private:
 
@@ -803,6 +873,25 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(ActiveMQSessionKernel* session,
     }
 
     consumerInfo->setOptimizedAcknowledge(this->internal->optimizeAcknowledge);
+
+    // Pull consumers fetch one message at a time and browsers read a snapshot, neither
+    // has a window worth adapting.
+    PrefetchPolicy* prefetchPolicy = session->getConnection()->getPrefetchPolicy();
+    if (prefetchPolicy->isAdaptive() && consumerInfo->getPrefetchSize() > 0 && !consumerInfo->isBrowser()) {
+        this->internal->adaptivePrefetch.reset(new AdaptivePrefetchController(
+            consumerInfo->getPrefetchSize(),
+            prefetchPolicy->getAdaptiveMinimumPrefetch(),
+            prefetchPolicy->getAdaptiveMaximumPrefetch(),
+            prefetchPolicy->getAdaptiveInterval(),
+            System::currentTimeMillis()));
+
+        consumerInfo->setPrefetchSize(this->internal->adaptivePrefetch->getPrefetch());
+        consumerInfo->setCurrentPrefetchSize(this->internal->adaptivePrefetch->getPrefetch());
+
+        this->internal->adaptivePrefetchTask = new AdaptivePrefetchTask(this, this->internal);
+        this->session->getScheduler()->executePeriodically(
+            this->internal->adaptivePrefetchTask, prefetchPolicy->getAdaptiveInterval());
+    }
     this->internal->failoverRedeliveryWaitPeriod =
         session->getConnection()->getConsumerFailoverRedeliveryWaitPeriod();
     this->internal->nonBlockingRedelivery = session->getConnection()->isNonBlockingRedelivery();
@@ -926,11 +1015,27 @@ void ActiveMQConsumerKernel::dispose() {
                 this->internal->executor.reset(NULL);
             }
 
+            if (this->internal->pendingAckTask != NULL) {
+                try {
+                    this->internal->pendingAckTask->get(60, TimeUnit::SECONDS);
+                } catch (Exception& ex) {
+                }
+                this->internal->pendingAckTask.reset(NULL);
+            }
+
             if (this->internal->optimizedAckTask != NULL) {
                 this->session->getScheduler()->cancel(this->internal->optimizedAckTask);
                 this->internal->optimizedAckTask = NULL;
             }
 
+            // A closing connection stops its scheduler first, which drops the task.
+            if (this->internal->adaptivePrefetchTask != NULL) {
+                if (this->session->getScheduler()->isStarted()) {
+                    this->session->getScheduler()->cancel(this->internal->adaptivePrefetchTask);
+                }
+                this->internal->adaptivePrefetchTask = NULL;
+            }
+
             if (session->isClientAcknowledge() || session->isIndividualAcknowledge()) {
                 if (!this->consumerInfo->isBrowser()) {
                     // roll back duplicates that aren't acknowledged
@@ -1254,7 +1359,13 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(Pointer<MessageDispatch> mes
         } else if (messageExpired) {
             acknowledge(message, ActiveMQConstants::ACK_TYPE_EXPIRED);
             return;
-        } else if (session->isTransacted()) {
+        }
+
+        if (this->internal->adaptivePrefetch != NULL) {
+            this->internal->adaptivePrefetch->messageConsumed();
+        }
+
+        if (session->isTransacted()) {
             return;
         }
 
@@ -1265,7 +1376,7 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(Pointer<MessageDispatch> mes
                         if (this->internal->optimizeAcknowledge) {
 
                             this->internal->ackCounter++;
-                            if (this->internal->isTimeForOptimizedAck(this->consumerInfo->getPrefetchSize())) {
+                            if (this->internal->isTimeForOptimizedAck(this->internal->getAckWindowSize())) {
                                 Pointer<MessageAck> ack =
                                     makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
                                 if (ack != NULL) {
@@ -1341,12 +1452,27 @@ void ActiveMQConsumerKernel::deliverAcks() {
             }
 
             if (ack != NULL) {
-                if (this->internal->executor == NULL) {
-                    this->internal->executor.reset(Executors::newSingleThreadExecutor());
-                }
+                if (this->session->getConnection()->isUseDedicatedTaskRunner()) {
+                    // With dedicated task runners nothing else is put on the shared
+                    // pool, each consumer keeps a thread of its own for acks.
+                    if (this->internal->executor == NULL) {
+                        this->internal->executor.reset(Executors::newSingleThreadExecutor());
+                    }
 
-                Pointer< Future<bool> >( this->internal->executor->submit(
-                    new AsyncMessageAckTask(ack, this->session, this->internal), true));
+                    Pointer< Future<bool> >(this->internal->executor->submit(
+                        new AsyncMessageAckTask(ack, this->session, this->internal), true));
+                } else {
+                    // Only one ack task is outstanding at a time, deliveringAcks is
+                    // cleared once it has run.
+                    try {
+                        this->internal->pendingAckTask.reset(
+                            this->session->getConnection()->getSessionTaskExecutor()->submit(
+                                new AsyncMessageAckTask(ack, this->session, this->internal), true));
+                    } catch (RejectedExecutionException& ex) {
+                        // The connection is closing and its pool takes no more work.
+                        AsyncMessageAckTask(ack, this->session, this->internal).run();
+                    }
+                }
             } else {
                 this->internal->deliveringAcks.set(false);
             }
@@ -1391,7 +1517,7 @@ void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> dispatch, int ack
 
     // Need to evaluate both expired and normal messages as otherwise consumer may get stalled
     int pendingAcks = (internal->deliveredCounter + internal->ackCounter) - internal->additionalWindowSize;
-    if ((0.5 * this->consumerInfo->getPrefetchSize()) <= pendingAcks) {
+    if ((0.5 * this->internal->getAckWindowSize()) <= pendingAcks) {
         session->sendAck(this->internal->pendingAck);
         this->internal->pendingAck.reset(NULL);
         this->internal->deliveredCounter = 0;
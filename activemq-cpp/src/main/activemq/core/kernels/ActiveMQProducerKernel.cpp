@@ -29,6 +29,9 @@
 #include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Boolean.h>
+#include <decaf/util/ArrayList.h>
+
+#include <vector>
 
 using namespace std;
 using namespace activemq;
@@ -38,6 +41,7 @@ using namespace activemq::core::kernels;
 using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace decaf::util;
+using namespace decaf::util::concurrent;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
@@ -210,68 +214,219 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Mess
                                   int deliveryMode, int priority, long long timeToLive, cms::AsyncCallback* onComplete) {
 
     try {
+        this->doSend(destination, message, deliveryMode, priority, timeToLive, onComplete, NULL);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
 
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQProducerKernel::sendAsync(cms::Message* message) {
+
+    try {
         this->checkClosed();
+        return this->sendAsync(this->destination.get(), message, defaultDeliveryMode, defaultPriority, defaultTimeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
 
-        if (destination == NULL) {
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQProducerKernel::sendAsync(cms::Message* message, int deliveryMode,
+                                                                                      int priority, long long timeToLive) {
 
-            if (this->producerInfo->getDestination() == NULL) {
-                throw cms::UnsupportedOperationException("A destination must be specified.", NULL);
-            }
+    try {
+        this->checkClosed();
+        return this->sendAsync(this->destination.get(), message, deliveryMode, priority, timeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQProducerKernel::sendAsync(const cms::Destination* destination,
+                                                                                      cms::Message* message) {
+
+    try {
+        this->checkClosed();
+        return this->sendAsync(destination, message, defaultDeliveryMode, defaultPriority, defaultTimeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQProducerKernel::sendAsync(const cms::Destination* destination,
+                                                                                      cms::Message* message, int deliveryMode,
+                                                                                      int priority, long long timeToLive) {
+
+    try {
+        Pointer< CompletableFuture< Pointer<Response> > > future;
+        this->doSend(destination, message, deliveryMode, priority, timeToLive, NULL, &future);
+        return future;
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::sendBatch(const decaf::util::List<cms::Message*>& messages) {
+
+    try {
+        this->checkClosed();
+        this->sendBatch(this->destination.get(), messages, defaultDeliveryMode, defaultPriority, defaultTimeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::sendBatch(const decaf::util::List<cms::Message*>& messages,
+                                       int deliveryMode, int priority, long long timeToLive) {
+
+    try {
+        this->checkClosed();
+        this->sendBatch(this->destination.get(), messages, deliveryMode, priority, timeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::sendBatch(const cms::Destination* destination,
+                                       const decaf::util::List<cms::Message*>& messages) {
+
+    try {
+        this->checkClosed();
+        this->sendBatch(destination, messages, defaultDeliveryMode, defaultPriority, defaultTimeToLive);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::sendBatch(const cms::Destination* destination,
+                                       const decaf::util::List<cms::Message*>& messages,
+                                       int deliveryMode, int priority, long long timeToLive) {
+
+    try {
+
+        this->checkClosed();
+
+        Pointer<ActiveMQDestination> dest = resolveDestination(destination);
 
-            throw cms::InvalidDestinationException("Don't understand null destinations", NULL);
+        if (messages.isEmpty()) {
+            return;
         }
 
-        Pointer<ActiveMQDestination> dest;
-        const ActiveMQDestination* transformed;
-
-        if (destination == this->destination.get()) {
-            dest = this->producerInfo->getDestination();
-        } else if (this->producerInfo->getDestination() == NULL) {
-            // We always need to use a copy of the users destination since we want to control
-            // its lifetime.  If the transform results in a new destination we can use that, but
-            // if its already an ActiveMQDestination then we need to clone it.
-            if (ActiveMQMessageTransformation::transformDestination(destination, &transformed)) {
-                dest.reset(const_cast<ActiveMQDestination*>(transformed));
-            } else {
-                dest.reset(transformed->cloneDataStructure());
-            }
+        // The transformed messages stay valid until the batch has been sent.
+        ArrayList<cms::Message*> outbound(messages.size());
+        std::vector< Pointer<cms::Message> > scoped(messages.size());
+
+        std::auto_ptr< Iterator<cms::Message*> > iter(messages.iterator());
+        for (std::size_t i = 0; iter->hasNext(); ++i) {
+            outbound.add(transform(iter->next(), scoped[i]));
+        }
+
+        // The session reserves window space for the whole batch at once.
+        this->session->sendBatch(this, dest, outbound, deliveryMode, priority, timeToLive,
+                                 this->memoryUsage.get(), this->sendTimeout);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::doSend(const cms::Destination* destination, cms::Message* message,
+                                    int deliveryMode, int priority, long long timeToLive, cms::AsyncCallback* onComplete,
+                                    Pointer< CompletableFuture< Pointer<Response> > >* future) {
+
+    try {
+
+        this->checkClosed();
+
+        Pointer<ActiveMQDestination> dest = resolveDestination(destination);
+
+        // scopedMessage ensures that when we are responsible for the lifetime of the
+        // transformed message, the message remains valid until the send operation either
+        // succeeds or throws an exception.
+        Pointer<cms::Message> scopedMessage;
+        cms::Message* outbound = transform(message, scopedMessage);
+
+        waitForWindowSpace();
+
+        if (future != NULL) {
+            *future = this->session->sendAsync(this, dest, outbound, deliveryMode, priority, timeToLive);
         } else {
-            throw cms::UnsupportedOperationException(
-                string("This producer can only send messages to: ") +
-                this->producerInfo->getDestination()->getPhysicalName(), NULL);
+            this->session->send(this, dest, outbound, deliveryMode, priority, timeToLive,
+                                this->memoryUsage.get(), this->sendTimeout, onComplete);
         }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
 
-        if (dest == NULL) {
-            throw cms::CMSException("No destination specified", NULL);
+////////////////////////////////////////////////////////////////////////////////
+Pointer<ActiveMQDestination> ActiveMQProducerKernel::resolveDestination(const cms::Destination* destination) {
+
+    if (destination == NULL) {
+
+        if (this->producerInfo->getDestination() == NULL) {
+            throw cms::UnsupportedOperationException("A destination must be specified.", NULL);
         }
 
-        cms::Message* outbound = message;
-        Pointer<cms::Message> scopedMessage;
-        if (this->transformer != NULL) {
-            if (this->transformer->producerTransform(this->session, this, message, &outbound)) {
-                // scopedMessage ensures that when we are responsible for the lifetime of the
-                // transformed message, the message remains valid until the send operation either
-                // succeeds or throws an exception.
-                scopedMessage.reset(outbound);
-            }
-            if (outbound == NULL) {
-                throw NullPointerException(__FILE__, __LINE__, "MessageTransformer set transformed message to NULL");
-            }
+        throw cms::InvalidDestinationException("Don't understand null destinations", NULL);
+    }
+
+    Pointer<ActiveMQDestination> dest;
+    const ActiveMQDestination* transformed;
+
+    if (destination == this->destination.get()) {
+        dest = this->producerInfo->getDestination();
+    } else if (this->producerInfo->getDestination() == NULL) {
+        // We always need to use a copy of the users destination since we want to control
+        // its lifetime.  If the transform results in a new destination we can use that, but
+        // if its already an ActiveMQDestination then we need to clone it.
+        if (ActiveMQMessageTransformation::transformDestination(destination, &transformed)) {
+            dest.reset(const_cast<ActiveMQDestination*>(transformed));
+        } else {
+            dest.reset(transformed->cloneDataStructure());
         }
+    } else {
+        throw cms::UnsupportedOperationException(
+            string("This producer can only send messages to: ") +
+            this->producerInfo->getDestination()->getPhysicalName(), NULL);
+    }
 
-        if (this->memoryUsage.get() != NULL) {
-            try {
+    if (dest == NULL) {
+        throw cms::CMSException("No destination specified", NULL);
+    }
+
+    return dest;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::Message* ActiveMQProducerKernel::transform(cms::Message* message, Pointer<cms::Message>& scoped) {
+
+    cms::Message* outbound = message;
+    if (this->transformer != NULL) {
+        if (this->transformer->producerTransform(this->session, this, message, &outbound)) {
+            scoped.reset(outbound);
+        }
+        if (outbound == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "MessageTransformer set transformed message to NULL");
+        }
+    }
+
+    return outbound;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQProducerKernel::waitForWindowSpace() {
+
+    if (this->memoryUsage.get() != NULL) {
+        try {
+            if (this->sendTimeout > 0) {
+                if (!this->memoryUsage->tryWaitForSpace((unsigned int) this->sendTimeout)) {
+                    throw cms::CMSException("Send timed out waiting for space in the producer window.");
+                }
+            } else {
                 this->memoryUsage->waitForSpace();
-            } catch (InterruptedException& e) {
-                throw cms::CMSException("Send aborted due to thread interrupt.");
             }
+        } catch (InterruptedException& e) {
+            throw cms::CMSException("Send aborted due to thread interrupt.");
         }
-
-        this->session->send(this, dest, outbound, deliveryMode, priority, timeToLive,
-                            this->memoryUsage.get(), this->sendTimeout, onComplete);
     }
-    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,8 +29,12 @@
 #include <activemq/util/LongSequenceGenerator.h>
 #include <activemq/commands/ProducerInfo.h>
 #include <activemq/commands/ProducerAck.h>
+#include <activemq/commands/Response.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
+#include <decaf/util/List.h>
+#include <decaf/util/concurrent/CompletableFuture.h>
+
 #include <memory>
 
 namespace activemq {
@@ -134,6 +138,120 @@ namespace kernels {
         virtual void send(const cms::Destination* destination, cms::Message* message,
                           int deliveryMode, int priority, long long timeToLive, cms::AsyncCallback* callback);
 
+        /**
+         * Sends the message to this producer's destination with its default delivery mode,
+         * priority and time to live, returning a future that completes when the broker
+         * acknowledges the message instead of waiting for it.  The future completes
+         * exceptionally if the broker rejects the message or the connection fails first.
+         *
+         * @param message
+         *      The message to send, the caller retains ownership.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            cms::Message* message);
+
+        /**
+         * Sends the message to this producer's destination, returning a future that completes
+         * when the broker acknowledges the message.
+         *
+         * @param message
+         *      The message to send, the caller retains ownership.
+         * @param deliveryMode
+         *      The delivery mode to be used.
+         * @param priority
+         *      The priority for this message.
+         * @param timeToLive
+         *      The time to live value for this message in milliseconds.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            cms::Message* message, int deliveryMode, int priority, long long timeToLive);
+
+        /**
+         * Sends the message to the given destination with this producer's default delivery
+         * mode, priority and time to live, returning a future that completes when the broker
+         * acknowledges the message.
+         *
+         * @param destination
+         *      The destination on which to send the message.
+         * @param message
+         *      The message to send, the caller retains ownership.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            const cms::Destination* destination, cms::Message* message);
+
+        /**
+         * Sends the message to the given destination, returning a future that completes when
+         * the broker acknowledges the message.
+         *
+         * @param destination
+         *      The destination on which to send the message.
+         * @param message
+         *      The message to send, the caller retains ownership.
+         * @param deliveryMode
+         *      The delivery mode to be used.
+         * @param priority
+         *      The priority for this message.
+         * @param timeToLive
+         *      The time to live value for this message in milliseconds.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            const cms::Destination* destination, cms::Message* message, int deliveryMode, int priority, long long timeToLive);
+
+        /**
+         * Sends a group of messages to this producer's destination.  Each message is sent as
+         * send would send it, but the per send work of locking the session, starting any
+         * transaction, waiting on the producer window and writing to the transport is done
+         * once for the group.  See ActiveMQSessionKernel::sendBatch.
+         *
+         * @param messages
+         *      The messages to send in order, the caller retains ownership.
+         *
+         * @throws CMSException if an error occurs while sending the messages.  Nothing is sent
+         *         if one of the messages can't be prepared, a failure while writing leaves
+         *         the messages ahead of the failed one sent.
+         */
+        void sendBatch(const decaf::util::List<cms::Message*>& messages);
+
+        /**
+         * Sends a group of messages to this producer's destination with the given delivery
+         * mode, priority and time to live, see sendBatch(messages).
+         *
+         * @throws CMSException if an error occurs while sending the messages.
+         */
+        void sendBatch(const decaf::util::List<cms::Message*>& messages, int deliveryMode, int priority, long long timeToLive);
+
+        /**
+         * Sends a group of messages to the given destination, see sendBatch(messages).
+         *
+         * @throws CMSException if an error occurs while sending the messages.
+         */
+        void sendBatch(const cms::Destination* destination, const decaf::util::List<cms::Message*>& messages);
+
+        /**
+         * Sends a group of messages to the given destination with the given delivery mode,
+         * priority and time to live, see sendBatch(messages).
+         *
+         * @throws CMSException if an error occurs while sending the messages.
+         */
+        void sendBatch(const cms::Destination* destination, const decaf::util::List<cms::Message*>& messages,
+                       int deliveryMode, int priority, long long timeToLive);
+
         /**
          * Set an MessageTransformer instance that is applied to all cms::Message objects before they
          * are sent on to the CMS bus.
@@ -296,11 +414,40 @@ namespace kernels {
             return this->messageSequence.getNextSequenceId();
         }
 
+        /**
+         * Reserves a run of sequence numbers for a batch of Messages sent from this Producer.
+         *
+         * @param count
+         *      The number of sequence numbers to reserve.
+         *
+         * @return the first sequence number of the run.
+         */
+        long long getNextMessageSequences(int count) {
+            return this->messageSequence.getNextSequenceIds(count);
+        }
+
     private:
 
        // Checks for the closed state and throws if so.
        void checkClosed() const;
 
+       // Common send path, when future is set the message is sent with a response
+       // required and the future for that response is stored there.
+       void doSend(const cms::Destination* destination, cms::Message* message,
+                   int deliveryMode, int priority, long long timeToLive, cms::AsyncCallback* onComplete,
+                   Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > >* future);
+
+       // Returns the destination a send to the given one goes to, throwing if this
+       // producer can't send there.
+       Pointer<commands::ActiveMQDestination> resolveDestination(const cms::Destination* destination);
+
+       // Passes the message through the transformer if one is set, the result is owned by
+       // scoped when the transformer created it.
+       cms::Message* transform(cms::Message* message, Pointer<cms::Message>& scoped);
+
+       // Blocks until the producer window has space or the send timeout passes.
+       void waitForWindowSpace();
+
     };
 
 }}}
@@ -54,12 +54,15 @@
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Math.h>
 #include <decaf/util/Queue.h>
+#include <decaf/util/ArrayList.h>
 #include <decaf/util/LinkedList.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/util/concurrent/locks/ReentrantReadWriteLock.h>
 #include <decaf/lang/exceptions/InvalidStateException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/InterruptedException.h>
+#include <vector>
 
 using namespace std;
 using namespace activemq;
@@ -435,6 +438,23 @@ void ActiveMQSessionKernel::commit() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::commitAsync(cms::AsyncCallback* onComplete) {
+
+    try {
+
+        this->checkClosed();
+
+        if (!this->isTransacted()) {
+            throw ActiveMQException(
+                __FILE__, __LINE__, "ActiveMQSessionKernel::commitAsync - This Session is not Transacted");
+        }
+
+        this->transaction->commitAsync(onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionKernel::rollback() {
 
@@ -917,79 +937,10 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
 
         this->checkClosed();
 
-        if (destination->isTemporary()) {
-            Pointer<ActiveMQTempDestination> tempDest = destination.dynamicCast<ActiveMQTempDestination>();
-            if (this->connection->isDeleted(tempDest)) {
-                throw cms::InvalidDestinationException(
-                    std::string("Cannot publish to a deleted Destination: ") + destination->toString());
-            }
-        }
-
         synchronized(&this->config->sendMutex) {
 
-            // Ensure that a new transaction is started if this is the first message
-            // sent since the last commit, Broker is notified of a new TX.
-            doStartTransaction();
-
-            Pointer<TransactionId> txId = this->transaction->getTransactionId();
-            Pointer<ProducerInfo> producerInfo = producer->getProducerInfo();
-            Pointer<ProducerId> producerId = producerInfo->getProducerId();
-            long long sequenceId = producer->getNextMessageSequence();
-
-            // Set the "CMS" header fields on the original message, see JMS 1.1 spec section 3.4.11
-            message->setCMSDeliveryMode(deliveryMode);
-            long long expiration = 0LL;
-            if (!producer->getDisableMessageTimeStamp()) {
-                long long timeStamp = System::currentTimeMillis();
-                message->setCMSTimestamp(timeStamp);
-                if (timeToLive > 0) {
-                    expiration = timeToLive + timeStamp;
-                }
-            }
-            message->setCMSExpiration(expiration);
-            message->setCMSPriority(priority);
-            message->setCMSRedelivered(false);
-
-            // transform to our own message format here
-            commands::Message* transformed = NULL;
-            Pointer<commands::Message> amqMessage;
-
-            // Always assign the message ID, regardless of the disable flag.
-            // Not adding a message ID will cause an NPE at the broker.
-            decaf::lang::Pointer<commands::MessageId> id(new commands::MessageId());
-            id->setProducerId(producerId);
-            id->setProducerSequenceId(sequenceId);
-
-            // NOTE:
-            // Now we copy the message before sending, this allows the user to reuse the
-            // message object without interfering with the copy that's being sent.  We
-            // could make this step optional to increase performance but for now we won't.
-            // To not do this implies that the user must never reuse the message object, or
-            // know that the configuration of Transports doesn't involve the message hanging
-            // around beyond the point that send returns.  When the transform step results in
-            // a new Message object being created we can just use that new instance, but when
-            // the original cms::Message pointer was already a commands::Message then we need
-            // to clone it.
-            if (ActiveMQMessageTransformation::transformMessage(message, connection, &transformed)) {
-                amqMessage.reset(transformed);
-            } else {
-                amqMessage.reset(transformed->cloneDataStructure());
-            }
-
-            // Sets the Message ID on the original message per spec.
-            message->setCMSMessageID(id->toString());
-            message->setCMSDestination(destination.dynamicCast<cms::Destination>().get());
-
-            amqMessage->setMessageId(id);
-            amqMessage->getBrokerPath().clear();
-            amqMessage->setTransactionId(txId);
-            amqMessage->setConnection(this->connection);
-
-            // destination format is provider specific so only set on transformed message
-            amqMessage->setDestination(destination);
-
-            amqMessage->onSend();
-            amqMessage->setProducerId(producerId);
+            Pointer<commands::Message> amqMessage =
+                prepareOutboundMessage(producer, destination, message, deliveryMode, priority, timeToLive);
 
             if (onComplete == NULL && sendTimeout <= 0 && !amqMessage->isResponseRequired() && !this->connection->isAlwaysSyncSend() &&
                 (!amqMessage->isPersistent() || this->connection->isUseAsyncSend() || amqMessage->getTransactionId() != NULL)) {
@@ -1013,6 +964,259 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Pointer< CompletableFuture< Pointer<Response> > > ActiveMQSessionKernel::sendAsync(
+    kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
+    cms::Message* message, int deliveryMode, int priority, long long timeToLive) {
+
+    try {
+
+        this->checkClosed();
+
+        Pointer< CompletableFuture< Pointer<Response> > > result;
+
+        synchronized(&this->config->sendMutex) {
+
+            Pointer<commands::Message> amqMessage =
+                prepareOutboundMessage(producer, destination, message, deliveryMode, priority, timeToLive);
+
+            result = this->connection->asyncRequest(amqMessage);
+        }
+
+        return result;
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::sendBatch(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
+                                      const decaf::util::List<cms::Message*>& messages, int deliveryMode, int priority,
+                                      long long timeToLive, util::MemoryUsage* producerWindow, long long sendTimeout) {
+
+    try {
+
+        this->checkClosed();
+
+        if (messages.isEmpty()) {
+            return;
+        }
+
+        synchronized(&this->config->sendMutex) {
+
+            checkDestinationNotDeleted(destination);
+            doStartTransaction();
+
+            // Every message in the batch shares one timestamp and takes the next id from a
+            // run reserved up front, the producer id is only formatted once.
+            long long timeStamp = producer->getDisableMessageTimeStamp() ? 0LL : System::currentTimeMillis();
+            long long sequenceId = producer->getNextMessageSequences(messages.size());
+            std::string producerKey = producer->getProducerId()->toString() + ":";
+
+            // The whole batch is prepared before anything is written, so a message that
+            // can't be converted fails the batch without sending part of it.
+            std::vector< Pointer<commands::Message> > prepared;
+            std::vector<bool> oneway;
+            prepared.reserve(messages.size());
+            oneway.reserve(messages.size());
+            long long windowSize = 0;
+
+            std::auto_ptr< Iterator<cms::Message*> > iter(messages.iterator());
+            while (iter->hasNext()) {
+
+                Pointer<commands::Message> amqMessage =
+                    prepareOutboundMessage(producer, destination, iter->next(), deliveryMode, priority,
+                                           timeToLive, timeStamp, sequenceId++, producerKey);
+
+                bool async = sendTimeout <= 0 && !amqMessage->isResponseRequired() && !this->connection->isAlwaysSyncSend() &&
+                    (!amqMessage->isPersistent() || this->connection->isUseAsyncSend() || amqMessage->getTransactionId() != NULL);
+
+                prepared.push_back(amqMessage);
+                oneway.push_back(async);
+                if (async) {
+                    windowSize += amqMessage->getSize();
+                }
+            }
+
+            // One reservation covers every message that the broker will acknowledge with
+            // a ProducerAck, it waits until the whole batch fits in the window.  Only
+            // messages sent without a send timeout are charged, as in send, so the wait
+            // isn't bounded.
+            reserveWindowUsage(producerWindow, windowSize);
+
+            ArrayList< Pointer<Command> > pending((int) prepared.size());
+            long long pendingSize = 0;
+            long long unsent = producerWindow != NULL ? windowSize : 0;
+
+            try {
+
+                for (std::size_t i = 0; i < prepared.size(); ++i) {
+
+                    if (oneway[i]) {
+                        pending.add(prepared[i]);
+                        pendingSize += prepared[i]->getSize();
+                        continue;
+                    }
+
+                    // Messages that need a response from the broker are sent one at a time as
+                    // send does, after everything queued ahead of them has been written.
+                    flushBatch(pending);
+                    unsent -= pendingSize;
+                    pendingSize = 0;
+
+                    if (sendTimeout > 0) {
+                        this->connection->syncRequest(prepared[i], (unsigned int) sendTimeout);
+                    } else {
+                        this->connection->syncRequest(prepared[i]);
+                    }
+                }
+
+                flushBatch(pending);
+                unsent -= pendingSize;
+
+            } catch (...) {
+                // Give back the window reserved for the messages that were never written.
+                if (producerWindow != NULL && unsent > 0) {
+                    producerWindow->decreaseUsage((unsigned long long) unsent);
+                }
+                throw;
+            }
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::flushBatch(decaf::util::List< Pointer<commands::Command> >& pending) {
+
+    if (pending.isEmpty()) {
+        return;
+    }
+
+    if (pending.size() == 1) {
+        this->connection->oneway(pending.get(0));
+    } else {
+        this->connection->onewayBatch(pending);
+    }
+    pending.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::reserveWindowUsage(util::MemoryUsage* producerWindow, long long size) {
+
+    if (producerWindow == NULL || size == 0) {
+        return;
+    }
+
+    try {
+        producerWindow->reserveUsage((unsigned long long) size, 0);
+    } catch (InterruptedException& e) {
+        throw cms::CMSException("Send aborted due to thread interrupt.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::checkDestinationNotDeleted(const Pointer<commands::ActiveMQDestination>& destination) {
+
+    if (destination->isTemporary()) {
+        Pointer<ActiveMQTempDestination> tempDest = destination.dynamicCast<ActiveMQTempDestination>();
+        if (this->connection->isDeleted(tempDest)) {
+            throw cms::InvalidDestinationException(
+                std::string("Cannot publish to a deleted Destination: ") + destination->toString());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<commands::Message> ActiveMQSessionKernel::prepareOutboundMessage(kernels::ActiveMQProducerKernel* producer,
+                                                                         Pointer<commands::ActiveMQDestination> destination,
+                                                                         cms::Message* message, int deliveryMode,
+                                                                         int priority, long long timeToLive) {
+
+    checkDestinationNotDeleted(destination);
+
+    // Ensure that a new transaction is started if this is the first message
+    // sent since the last commit, Broker is notified of a new TX.
+    doStartTransaction();
+
+    long long timeStamp = producer->getDisableMessageTimeStamp() ? 0LL : System::currentTimeMillis();
+
+    return prepareOutboundMessage(producer, destination, message, deliveryMode, priority, timeToLive,
+                                  timeStamp, producer->getNextMessageSequence(), "");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<commands::Message> ActiveMQSessionKernel::prepareOutboundMessage(kernels::ActiveMQProducerKernel* producer,
+                                                                         Pointer<commands::ActiveMQDestination> destination,
+                                                                         cms::Message* message, int deliveryMode,
+                                                                         int priority, long long timeToLive,
+                                                                         long long timeStamp, long long sequenceId,
+                                                                         const std::string& producerKey) {
+
+    Pointer<TransactionId> txId = this->transaction->getTransactionId();
+    Pointer<ProducerInfo> producerInfo = producer->getProducerInfo();
+    Pointer<ProducerId> producerId = producerInfo->getProducerId();
+
+    // Set the "CMS" header fields on the original message, see JMS 1.1 spec section 3.4.11
+    message->setCMSDeliveryMode(deliveryMode);
+    long long expiration = 0LL;
+    if (!producer->getDisableMessageTimeStamp()) {
+        message->setCMSTimestamp(timeStamp);
+        if (timeToLive > 0) {
+            expiration = timeToLive + timeStamp;
+        }
+    }
+    message->setCMSExpiration(expiration);
+    message->setCMSPriority(priority);
+    message->setCMSRedelivered(false);
+
+    // transform to our own message format here
+    commands::Message* transformed = NULL;
+    Pointer<commands::Message> amqMessage;
+
+    // Always assign the message ID, regardless of the disable flag.
+    // Not adding a message ID will cause an NPE at the broker.
+    decaf::lang::Pointer<commands::MessageId> id(new commands::MessageId());
+    id->setProducerId(producerId);
+    id->setProducerSequenceId(sequenceId);
+
+    // NOTE:
+    // Now we copy the message before sending, this allows the user to reuse the
+    // message object without interfering with the copy that's being sent.  We
+    // could make this step optional to increase performance but for now we won't.
+    // To not do this implies that the user must never reuse the message object, or
+    // know that the configuration of Transports doesn't involve the message hanging
+    // around beyond the point that send returns.  When the transform step results in
+    // a new Message object being created we can just use that new instance, but when
+    // the original cms::Message pointer was already a commands::Message then we need
+    // to clone it.
+    if (ActiveMQMessageTransformation::transformMessage(message, connection, &transformed)) {
+        amqMessage.reset(transformed);
+    } else {
+        amqMessage.reset(transformed->cloneDataStructure());
+    }
+
+    // Sets the Message ID on the original message per spec.
+    if (producerKey.empty()) {
+        message->setCMSMessageID(id->toString());
+    } else {
+        message->setCMSMessageID(producerKey + Long::toString(sequenceId));
+    }
+    message->setCMSDestination(destination.dynamicCast<cms::Destination>().get());
+
+    amqMessage->setMessageId(id);
+    amqMessage->getBrokerPath().clear();
+    amqMessage->setTransactionId(txId);
+    amqMessage->setConnection(this->connection);
+
+    // destination format is provider specific so only set on transformed message
+    amqMessage->setDestination(destination);
+
+    amqMessage->onSend();
+    amqMessage->setProducerId(producerId);
+
+    return amqMessage;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::ExceptionListener* ActiveMQSessionKernel::getExceptionListener() {
 
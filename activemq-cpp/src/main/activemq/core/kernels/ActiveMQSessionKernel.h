@@ -29,6 +29,7 @@
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
 #include <activemq/commands/ActiveMQTempDestination.h>
 #include <activemq/commands/Response.h>
+#include <activemq/commands/Message.h>
 #include <activemq/commands/MessageAck.h>
 #include <activemq/commands/SessionInfo.h>
 #include <activemq/commands/ConsumerInfo.h>
@@ -43,6 +44,7 @@
 #include <decaf/lang/Pointer.h>
 #include <decaf/util/ArrayList.h>
 #include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/CompletableFuture.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
 
@@ -199,6 +201,17 @@ namespace kernels {
 
         virtual void recover();
 
+        /**
+         * Commits the current transaction without blocking on the broker's response, the
+         * result is delivered to the given callback.
+         *
+         * @param onComplete
+         *      The callback to notify when the commit completes, NULL for a blocking commit.
+         *
+         * @see ActiveMQTransactionContext::commitAsync
+         */
+        virtual void commitAsync(cms::AsyncCallback* onComplete);
+
         virtual cms::MessageConsumer* createConsumer(const cms::Destination* destination);
 
         virtual cms::MessageConsumer* createConsumer(const cms::Destination* destination,
@@ -280,6 +293,68 @@ namespace kernels {
                   cms::Message* message, int deliveryMode, int priority, long long timeToLive,
                   util::MemoryUsage* producerWindow, long long sendTimeout, cms::AsyncCallback* onComplete);
 
+        /**
+         * Sends a message for the given producer and returns a future for the broker's
+         * acknowledgement of it instead of waiting for it.  The message is always sent with
+         * a response required, the future completes once the broker has accepted the message
+         * or exceptionally if it rejects it.
+         *
+         * @param producer
+         *      The sending Producer
+         * @param destination
+         *      The target destination for the Message.
+         * @param message
+         *      The message to send to the broker.
+         * @param deliveryMode
+         *      The delivery mode to assign to the outgoing message.
+         * @param priority
+         *      The priority value to assign to the outgoing message.
+         * @param timeToLive
+         *      The time to live for the outgoing message.
+         *
+         * @return a future for the broker's response to the send.
+         *
+         * @throws CMSException if an error occurs while sending the message.
+         */
+        Pointer< decaf::util::concurrent::CompletableFuture< Pointer<commands::Response> > > sendAsync(
+            kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
+            cms::Message* message, int deliveryMode, int priority, long long timeToLive);
+
+        /**
+         * Sends a group of messages for the given producer as send would send each of them,
+         * but with the send lock taken and any transaction started once for the whole group.
+         * The messages share one timestamp and take consecutive sequence ids, and those that
+         * need no response from the broker are written to the transport together.  Their
+         * combined size is reserved in the producer window before anything is written, waiting
+         * until all of it fits.  A message that does need a response is sent on its own, in
+         * order, once the messages ahead of it have been written.
+         *
+         * @param producer
+         *      The sending Producer
+         * @param destination
+         *      The target destination for the Messages.
+         * @param messages
+         *      The messages to send to the broker, in order.
+         * @param deliveryMode
+         *      The delivery mode to assign to the outgoing messages.
+         * @param priority
+         *      The priority value to assign to the outgoing messages.
+         * @param timeToLive
+         *      The time to live for the outgoing messages.
+         * @param producerWindow
+         *      Pointer to a Usage tracker which if set will be increased by the size
+         *      of the messages sent without a response.
+         * @param sendTimeout
+         *      The amount of time to block during send before failing, or 0 to wait forever.
+         *
+         * @throws CMSException if an error occurs while sending the messages.  Nothing is sent
+         *         if one of the messages can't be prepared, a failure while writing leaves
+         *         the messages ahead of the failed one sent.
+         */
+        void sendBatch(kernels::ActiveMQProducerKernel* producer, Pointer<commands::ActiveMQDestination> destination,
+                       const decaf::util::List<cms::Message*>& messages, int deliveryMode, int priority,
+                       long long timeToLive, util::MemoryUsage* producerWindow, long long sendTimeout);
+
         /**
          * This method gets any registered exception listener of this sessions
          * connection and returns it.  Mainly intended for use by the objects
@@ -607,6 +682,33 @@ namespace kernels {
        // Checks for the closed state and throws if so.
        void checkClosed() const;
 
+       // Assigns the CMS headers and message id to the user's message and returns the
+       // copy of it that goes to the broker, the caller holds the send mutex.
+       Pointer<commands::Message> prepareOutboundMessage(kernels::ActiveMQProducerKernel* producer,
+                                                         Pointer<commands::ActiveMQDestination> destination,
+                                                         cms::Message* message, int deliveryMode,
+                                                         int priority, long long timeToLive);
+
+       // Fills in a single outbound message using the given timestamp and sequence id, when
+       // producerKey is not empty it is the producer id followed by a colon and is used to
+       // build the message id string.
+       Pointer<commands::Message> prepareOutboundMessage(kernels::ActiveMQProducerKernel* producer,
+                                                         Pointer<commands::ActiveMQDestination> destination,
+                                                         cms::Message* message, int deliveryMode,
+                                                         int priority, long long timeToLive,
+                                                         long long timeStamp, long long sequenceId,
+                                                         const std::string& producerKey);
+
+       // Writes the pending messages of a batch send to the transport.
+       void flushBatch(decaf::util::List< Pointer<commands::Command> >& pending);
+
+       // Charges the size of a whole batch to the producer window in one reservation that
+       // waits for all of it to fit.
+       void reserveWindowUsage(util::MemoryUsage* producerWindow, long long size);
+
+       // Throws if the destination is a temporary one that has since been deleted.
+       void checkDestinationNotDeleted(const Pointer<commands::ActiveMQDestination>& destination);
+
        // Send the Destination Creation Request to the Broker, alerting it
        // that we've created a new Temporary Destination.
        // @param tempDestination - The new Temporary Destination
@@ -59,6 +59,11 @@ void ActiveMQXASessionKernel::commit() {
     throw cms::TransactionInProgressException("Cannot commit inside an XASession");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQXASessionKernel::commitAsync(cms::AsyncCallback* onComplete AMQCPP_UNUSED) {
+    throw cms::TransactionInProgressException("Cannot commit inside an XASession");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQXASessionKernel::rollback() {
     throw cms::TransactionInProgressException("Cannot rollback inside an XASession");
@@ -31,13 +31,20 @@ int DefaultPrefetchPolicy::DEFAULT_DURABLE_TOPIC_PREFETCH = 100;
 int DefaultPrefetchPolicy::DEFAULT_QUEUE_PREFETCH = 1000;
 int DefaultPrefetchPolicy::DEFAULT_QUEUE_BROWSER_PREFETCH = 500;
 int DefaultPrefetchPolicy::DEFAULT_TOPIC_PREFETCH = MAX_PREFETCH_SIZE;
+int DefaultPrefetchPolicy::DEFAULT_ADAPTIVE_MINIMUM_PREFETCH = 1;
+int DefaultPrefetchPolicy::DEFAULT_ADAPTIVE_MAXIMUM_PREFETCH = 1000;
+long long DefaultPrefetchPolicy::DEFAULT_ADAPTIVE_INTERVAL = 1000;
 
 ////////////////////////////////////////////////////////////////////////////////
 DefaultPrefetchPolicy::DefaultPrefetchPolicy() :
     durableTopicPrefetch( DEFAULT_DURABLE_TOPIC_PREFETCH ),
     queuePrefetch( DEFAULT_QUEUE_PREFETCH ),
     queueBrowserPrefetch( DEFAULT_QUEUE_BROWSER_PREFETCH ),
-    topicPrefetch( DEFAULT_TOPIC_PREFETCH ) {
+    topicPrefetch( DEFAULT_TOPIC_PREFETCH ),
+    adaptive( false ),
+    adaptiveMinimumPrefetch( DEFAULT_ADAPTIVE_MINIMUM_PREFETCH ),
+    adaptiveMaximumPrefetch( DEFAULT_ADAPTIVE_MAXIMUM_PREFETCH ),
+    adaptiveInterval( DEFAULT_ADAPTIVE_INTERVAL ) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -53,6 +60,10 @@ PrefetchPolicy* DefaultPrefetchPolicy::clone() const {
     copy->setTopicPrefetch(this->getTopicPrefetch());
     copy->setQueueBrowserPrefetch(this->getQueueBrowserPrefetch());
     copy->setQueuePrefetch(this->getQueuePrefetch());
+    copy->setAdaptive(this->isAdaptive());
+    copy->setAdaptiveMinimumPrefetch(this->getAdaptiveMinimumPrefetch());
+    copy->setAdaptiveMaximumPrefetch(this->getAdaptiveMaximumPrefetch());
+    copy->setAdaptiveInterval(this->getAdaptiveInterval());
 
     return copy;
 }
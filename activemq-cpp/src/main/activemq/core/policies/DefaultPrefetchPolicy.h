@@ -33,6 +33,10 @@ namespace policies {
         int queuePrefetch;
         int queueBrowserPrefetch;
         int topicPrefetch;
+        bool adaptive;
+        int adaptiveMinimumPrefetch;
+        int adaptiveMaximumPrefetch;
+        long long adaptiveInterval;
 
     public:
 
@@ -41,6 +45,9 @@ namespace policies {
         static int DEFAULT_QUEUE_PREFETCH;
         static int DEFAULT_QUEUE_BROWSER_PREFETCH;
         static int DEFAULT_TOPIC_PREFETCH;
+        static int DEFAULT_ADAPTIVE_MINIMUM_PREFETCH;
+        static int DEFAULT_ADAPTIVE_MAXIMUM_PREFETCH;
+        static long long DEFAULT_ADAPTIVE_INTERVAL;
 
     private:
 
@@ -85,6 +92,38 @@ namespace policies {
             return this->topicPrefetch;
         }
 
+        virtual void setAdaptive(bool value) {
+            this->adaptive = value;
+        }
+
+        virtual bool isAdaptive() const {
+            return this->adaptive;
+        }
+
+        virtual void setAdaptiveMinimumPrefetch(int value) {
+            this->adaptiveMinimumPrefetch = getMaxPrefetchLimit(value < 1 ? 1 : value);
+        }
+
+        virtual int getAdaptiveMinimumPrefetch() const {
+            return this->adaptiveMinimumPrefetch;
+        }
+
+        virtual void setAdaptiveMaximumPrefetch(int value) {
+            this->adaptiveMaximumPrefetch = getMaxPrefetchLimit(value < 1 ? 1 : value);
+        }
+
+        virtual int getAdaptiveMaximumPrefetch() const {
+            return this->adaptiveMaximumPrefetch;
+        }
+
+        virtual void setAdaptiveInterval(long long value) {
+            this->adaptiveInterval = value;
+        }
+
+        virtual long long getAdaptiveInterval() const {
+            return this->adaptiveInterval;
+        }
+
         virtual int getMaxPrefetchLimit(int value) const {
             return value < MAX_PREFETCH_SIZE ? value : MAX_PREFETCH_SIZE;
         }
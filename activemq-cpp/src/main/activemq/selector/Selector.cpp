@@ -0,0 +1,552 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Selector.h"
+
+#include <activemq/selector/SelectorParser.h>
+#include <activemq/util/PrimitiveMap.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::selector;
+using namespace activemq::commands;
+using namespace activemq::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const std::string PERSISTENT("PERSISTENT");
+    const std::string NON_PERSISTENT("NON_PERSISTENT");
+    const std::string EMPTY;
+
+    // Values up to this depth live on the caller's stack while matching.
+    const int LOCAL_STACK_SIZE = 8;
+
+    std::size_t nextCharacter(const std::string& text, std::size_t index) {
+        index++;
+        while (index < text.size() && ((unsigned char) text[index] & 0xC0) == 0x80) {
+            index++;
+        }
+        return index;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Selector::Selector(const std::string& expression) :
+    expression(expression), program(), strings(), constants(), inLists(), patterns(), stackDepth(0) {
+
+    SelectorParser parser(this->expression, this);
+    parser.parse();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Selector::~Selector() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Selector::matches(const Message* message) const {
+
+    if (message == NULL) {
+        return false;
+    }
+
+    Value local[LOCAL_STACK_SIZE];
+    std::vector<Value> overflow;
+    Value* stack = local;
+    if (this->stackDepth > LOCAL_STACK_SIZE) {
+        overflow.resize(this->stackDepth);
+        stack = &overflow[0];
+    }
+
+    int top = -1;
+    std::size_t size = this->program.size();
+
+    for (std::size_t pc = 0; pc < size;) {
+
+        const Instruction& instruction = this->program[pc++];
+
+        switch (instruction.op) {
+            case PUSH_CONSTANT: {
+                const Value& constant = this->constants[instruction.operand];
+                Value& value = stack[++top];
+                value.type = constant.type;
+                value.boolValue = constant.boolValue;
+                value.longValue = constant.longValue;
+                value.doubleValue = constant.doubleValue;
+                value.stringValue = constant.stringValue;
+                break;
+            }
+            case LOAD_PROPERTY:
+                loadProperty(message, this->strings[instruction.operand], stack[++top]);
+                break;
+            case LOAD_HEADER:
+                load(message, (Header) instruction.operand, stack[++top]);
+                break;
+            case AND_JUMP:
+                // The left operand stays as the result when it is false.
+                if (truth(stack[top]) == TRUTH_FALSE) {
+                    pc = (std::size_t) instruction.operand;
+                }
+                break;
+            case OR_JUMP:
+                if (truth(stack[top]) == TRUTH_TRUE) {
+                    pc = (std::size_t) instruction.operand;
+                }
+                break;
+            case AND: {
+                Truth left = truth(stack[top - 1]);
+                Truth right = truth(stack[top]);
+                Truth result = TRUTH_TRUE;
+                if (left == TRUTH_FALSE || right == TRUTH_FALSE) {
+                    result = TRUTH_FALSE;
+                } else if (left == TRUTH_UNKNOWN || right == TRUTH_UNKNOWN) {
+                    result = TRUTH_UNKNOWN;
+                }
+                setTruth(stack[--top], result);
+                break;
+            }
+            case OR: {
+                Truth left = truth(stack[top - 1]);
+                Truth right = truth(stack[top]);
+                Truth result = TRUTH_FALSE;
+                if (left == TRUTH_TRUE || right == TRUTH_TRUE) {
+                    result = TRUTH_TRUE;
+                } else if (left == TRUTH_UNKNOWN || right == TRUTH_UNKNOWN) {
+                    result = TRUTH_UNKNOWN;
+                }
+                setTruth(stack[--top], result);
+                break;
+            }
+            case NOT: {
+                Truth operand = truth(stack[top]);
+                if (operand != TRUTH_UNKNOWN) {
+                    operand = operand == TRUTH_TRUE ? TRUTH_FALSE : TRUTH_TRUE;
+                }
+                setTruth(stack[top], operand);
+                break;
+            }
+            case EQUAL:
+            case NOT_EQUAL:
+            case LESS_THAN:
+            case LESS_THAN_OR_EQUAL:
+            case GREATER_THAN:
+            case GREATER_THAN_OR_EQUAL: {
+                Truth result = compare(instruction.op, stack[top - 1], stack[top]);
+                setTruth(stack[--top], result);
+                break;
+            }
+            case ADD:
+            case SUBTRACT:
+            case MULTIPLY:
+            case DIVIDE:
+                arithmetic(instruction.op, stack[top - 1], stack[top]);
+                top--;
+                break;
+            case NEGATE: {
+                Value& value = stack[top];
+                if (value.type == Value::LONG) {
+                    value.longValue = (long long) (0ULL - (unsigned long long) value.longValue);
+                } else if (value.type == Value::DOUBLE) {
+                    value.doubleValue = -value.doubleValue;
+                } else {
+                    value.type = Value::UNKNOWN;
+                }
+                break;
+            }
+            case BETWEEN:
+            case NOT_BETWEEN: {
+                Truth lower = compare(GREATER_THAN_OR_EQUAL, stack[top - 2], stack[top - 1]);
+                Truth upper = compare(LESS_THAN_OR_EQUAL, stack[top - 2], stack[top]);
+                Truth result = TRUTH_TRUE;
+                if (lower == TRUTH_FALSE || upper == TRUTH_FALSE) {
+                    result = TRUTH_FALSE;
+                } else if (lower == TRUTH_UNKNOWN || upper == TRUTH_UNKNOWN) {
+                    result = TRUTH_UNKNOWN;
+                }
+                if (instruction.op == NOT_BETWEEN && result != TRUTH_UNKNOWN) {
+                    result = result == TRUTH_TRUE ? TRUTH_FALSE : TRUTH_TRUE;
+                }
+                top -= 2;
+                setTruth(stack[top], result);
+                break;
+            }
+            case IN:
+            case NOT_IN:
+            case LIKE:
+            case NOT_LIKE: {
+                Value& value = stack[top];
+                Truth result = TRUTH_UNKNOWN;
+                if (value.type == Value::STRING) {
+                    bool found;
+                    if (instruction.op == IN || instruction.op == NOT_IN) {
+                        const std::vector<std::string>& list = this->inLists[instruction.operand];
+                        found = std::binary_search(list.begin(), list.end(), *value.stringValue);
+                    } else {
+                        found = like(this->patterns[instruction.operand], *value.stringValue);
+                    }
+                    if (instruction.op == NOT_IN || instruction.op == NOT_LIKE) {
+                        found = !found;
+                    }
+                    result = found ? TRUTH_TRUE : TRUTH_FALSE;
+                } else if (value.type != Value::UNKNOWN) {
+                    result = TRUTH_FALSE;
+                }
+                setTruth(value, result);
+                break;
+            }
+            case IS_NULL:
+            case IS_NOT_NULL: {
+                bool isNull = stack[top].type == Value::UNKNOWN;
+                if (instruction.op == IS_NOT_NULL) {
+                    isNull = !isNull;
+                }
+                setTruth(stack[top], isNull ? TRUTH_TRUE : TRUTH_FALSE);
+                break;
+            }
+        }
+    }
+
+    return truth(stack[top]) == TRUTH_TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Selector::load(const Message* message, Header header, Value& value) const {
+
+    const std::string* text = NULL;
+
+    switch (header) {
+        case JMS_DELIVERY_MODE:
+            text = message->isPersistent() ? &PERSISTENT : &NON_PERSISTENT;
+            break;
+        case JMS_PRIORITY:
+            value.type = Value::LONG;
+            value.longValue = message->getPriority();
+            return;
+        case JMS_MESSAGE_ID:
+            if (message->getMessageId() == NULL) {
+                value.type = Value::UNKNOWN;
+                return;
+            }
+            value.text = message->getMessageId()->toString();
+            text = &value.text;
+            break;
+        case JMS_TIMESTAMP:
+            value.type = Value::LONG;
+            value.longValue = message->getTimestamp();
+            return;
+        case JMS_CORRELATION_ID:
+            text = &message->getCorrelationId();
+            break;
+        case JMS_TYPE:
+            text = &message->getType();
+            break;
+        case JMS_EXPIRATION:
+            value.type = Value::LONG;
+            value.longValue = message->getExpiration();
+            return;
+        case JMS_REDELIVERED:
+            value.type = Value::BOOLEAN;
+            value.boolValue = message->getRedeliveryCounter() > 0;
+            return;
+        case JMSX_DELIVERY_COUNT:
+            value.type = Value::LONG;
+            value.longValue = (long long) message->getRedeliveryCounter() + 1;
+            return;
+        case JMSX_GROUP_ID:
+            text = &message->getGroupID();
+            break;
+        case JMSX_GROUP_SEQ:
+            value.type = Value::LONG;
+            value.longValue = message->getGroupSequence();
+            return;
+    }
+
+    // An empty string header is one that was never set.
+    if (text == NULL || text->empty()) {
+        value.type = Value::UNKNOWN;
+        return;
+    }
+
+    value.type = Value::STRING;
+    value.stringValue = text;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Selector::loadProperty(const Message* message, const std::string& name, Value& value) const {
+
+    const PrimitiveMap& properties = message->getMessageProperties();
+
+    if (!properties.containsKey(name)) {
+        value.type = Value::UNKNOWN;
+        return;
+    }
+
+    const PrimitiveValueNode& node = properties.get(name);
+
+    switch (node.getType()) {
+        case PrimitiveValueNode::BOOLEAN_TYPE:
+            value.type = Value::BOOLEAN;
+            value.boolValue = node.getBool();
+            break;
+        case PrimitiveValueNode::BYTE_TYPE:
+            value.type = Value::LONG;
+            value.longValue = (signed char) node.getByte();
+            break;
+        case PrimitiveValueNode::SHORT_TYPE:
+            value.type = Value::LONG;
+            value.longValue = node.getShort();
+            break;
+        case PrimitiveValueNode::INTEGER_TYPE:
+            value.type = Value::LONG;
+            value.longValue = node.getInt();
+            break;
+        case PrimitiveValueNode::LONG_TYPE:
+            value.type = Value::LONG;
+            value.longValue = node.getLong();
+            break;
+        case PrimitiveValueNode::FLOAT_TYPE:
+            value.type = Value::DOUBLE;
+            value.doubleValue = node.getFloat();
+            break;
+        case PrimitiveValueNode::DOUBLE_TYPE:
+            value.type = Value::DOUBLE;
+            value.doubleValue = node.getDouble();
+            break;
+        case PrimitiveValueNode::STRING_TYPE: {
+            // Read in place, the map outlives the evaluation.
+            const std::string* text = node.getValue().stringValue;
+            value.type = Value::STRING;
+            value.stringValue = text != NULL ? text : &EMPTY;
+            break;
+        }
+        case PrimitiveValueNode::CHAR_TYPE:
+            value.type = Value::STRING;
+            value.text.assign(1, node.getChar());
+            value.stringValue = &value.text;
+            break;
+        default:
+            value.type = Value::UNKNOWN;
+            break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Selector::like(const Pattern& pattern, const std::string& text) {
+
+    const std::string& literal = pattern.literal;
+
+    switch (pattern.kind) {
+        case Pattern::EXACT:
+            return text == literal;
+        case Pattern::PREFIX:
+            return text.size() >= literal.size() && text.compare(0, literal.size(), literal) == 0;
+        case Pattern::SUFFIX:
+            return text.size() >= literal.size() &&
+                   text.compare(text.size() - literal.size(), literal.size(), literal) == 0;
+        case Pattern::CONTAINS:
+            return text.find(literal) != std::string::npos;
+        case Pattern::GENERAL:
+            break;
+    }
+
+    // Greedy match that backtracks only to the most recent '%', '_' consumes one
+    // UTF-8 encoded character.
+    const std::vector<short>& elements = pattern.elements;
+    std::size_t count = elements.size();
+    std::size_t position = 0;
+    std::size_t element = 0;
+    std::size_t starElement = std::string::npos;
+    std::size_t starPosition = 0;
+
+    while (position < text.size()) {
+        if (element < count && elements[element] == Pattern::ANY_CHARS) {
+            starElement = ++element;
+            starPosition = position;
+        } else if (element < count && elements[element] == Pattern::ANY_CHAR) {
+            position = nextCharacter(text, position);
+            element++;
+        } else if (element < count && elements[element] == (unsigned char) text[position]) {
+            position++;
+            element++;
+        } else if (starElement != std::string::npos) {
+            starPosition = nextCharacter(text, starPosition);
+            position = starPosition;
+            element = starElement;
+        } else {
+            return false;
+        }
+    }
+
+    while (element < count && elements[element] == Pattern::ANY_CHARS) {
+        element++;
+    }
+
+    return element == count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Selector::Truth Selector::truth(const Value& value) {
+
+    if (value.type != Value::BOOLEAN) {
+        return TRUTH_UNKNOWN;
+    }
+
+    return value.boolValue ? TRUTH_TRUE : TRUTH_FALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Selector::setTruth(Value& value, Truth truth) {
+
+    if (truth == TRUTH_UNKNOWN) {
+        value.type = Value::UNKNOWN;
+    } else {
+        value.type = Value::BOOLEAN;
+        value.boolValue = truth == TRUTH_TRUE;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Selector::Truth Selector::compare(OpCode op, const Value& left, const Value& right) {
+
+    if (left.type == Value::UNKNOWN || right.type == Value::UNKNOWN) {
+        return TRUTH_UNKNOWN;
+    }
+
+    bool less = false;
+    bool equal = false;
+    bool greater = false;
+
+    if (left.isNumeric() && right.isNumeric()) {
+        if (left.type == Value::LONG && right.type == Value::LONG) {
+            less = left.longValue < right.longValue;
+            equal = left.longValue == right.longValue;
+            greater = left.longValue > right.longValue;
+        } else {
+            double lhs = left.type == Value::LONG ? (double) left.longValue : left.doubleValue;
+            double rhs = right.type == Value::LONG ? (double) right.longValue : right.doubleValue;
+            less = lhs < rhs;
+            equal = lhs == rhs;
+            greater = lhs > rhs;
+        }
+    } else if (left.type == Value::STRING && right.type == Value::STRING) {
+        int result = left.stringValue->compare(*right.stringValue);
+        less = result < 0;
+        equal = result == 0;
+        greater = result > 0;
+    } else if (left.type == Value::BOOLEAN && right.type == Value::BOOLEAN) {
+        // Booleans are only equal or not, they have no order.
+        if (op != EQUAL && op != NOT_EQUAL) {
+            return TRUTH_FALSE;
+        }
+        equal = left.boolValue == right.boolValue;
+    } else if (op != NOT_EQUAL) {
+        return TRUTH_FALSE;
+    }
+
+    bool result = false;
+    switch (op) {
+        case EQUAL:
+            result = equal;
+            break;
+        case NOT_EQUAL:
+            result = !equal;
+            break;
+        case LESS_THAN:
+            result = less;
+            break;
+        case LESS_THAN_OR_EQUAL:
+            result = less || equal;
+            break;
+        case GREATER_THAN:
+            result = greater;
+            break;
+        case GREATER_THAN_OR_EQUAL:
+            result = greater || equal;
+            break;
+        default:
+            break;
+    }
+
+    return result ? TRUTH_TRUE : TRUTH_FALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Selector::arithmetic(OpCode op, Value& left, const Value& right) {
+
+    if (!left.isNumeric() || !right.isNumeric()) {
+        left.type = Value::UNKNOWN;
+        return;
+    }
+
+    if (left.type == Value::LONG && right.type == Value::LONG) {
+
+        // Exact arithmetic wraps on overflow as it does in Java.
+        unsigned long long lhs = (unsigned long long) left.longValue;
+        unsigned long long rhs = (unsigned long long) right.longValue;
+
+        switch (op) {
+            case ADD:
+                left.longValue = (long long) (lhs + rhs);
+                break;
+            case SUBTRACT:
+                left.longValue = (long long) (lhs - rhs);
+                break;
+            case MULTIPLY:
+                left.longValue = (long long) (lhs * rhs);
+                break;
+            case DIVIDE:
+                if (right.longValue == 0) {
+                    left.type = Value::UNKNOWN;
+                } else if (right.longValue == -1) {
+                    left.longValue = (long long) (0ULL - lhs);
+                } else {
+                    left.longValue = left.longValue / right.longValue;
+                }
+                break;
+            default:
+                break;
+        }
+        return;
+    }
+
+    double lhs = left.type == Value::LONG ? (double) left.longValue : left.doubleValue;
+    double rhs = right.type == Value::LONG ? (double) right.longValue : right.doubleValue;
+
+    left.type = Value::DOUBLE;
+    switch (op) {
+        case ADD:
+            left.doubleValue = lhs + rhs;
+            break;
+        case SUBTRACT:
+            left.doubleValue = lhs - rhs;
+            break;
+        case MULTIPLY:
+            left.doubleValue = lhs * rhs;
+            break;
+        case DIVIDE:
+            if (rhs == 0) {
+                left.type = Value::UNKNOWN;
+            } else {
+                left.doubleValue = lhs / rhs;
+            }
+            break;
+        default:
+            break;
+    }
+}
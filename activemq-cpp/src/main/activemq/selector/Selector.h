@@ -0,0 +1,234 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _ACTIVEMQ_SELECTOR_SELECTOR_H_
+#define _ACTIVEMQ_SELECTOR_SELECTOR_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/commands/Message.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace selector {
+
+    class SelectorParser;
+
+    /**
+     * A JMS message selector compiled for evaluation in the client.
+     *
+     * The expression uses the SQL-92 subset defined by the JMS specification: the
+     * comparison, arithmetic and logical operators, BETWEEN, LIKE with an optional
+     * ESCAPE, IN and IS [NOT] NULL.  Identifiers name message properties or one of the
+     * headers JMSDeliveryMode, JMSPriority, JMSMessageID, JMSTimestamp, JMSCorrelationID,
+     * JMSType, JMSExpiration, JMSRedelivered, JMSXDeliveryCount, JMSXGroupID and
+     * JMSXGroupSeq.  A property or header that is not set is NULL, and comparisons and
+     * arithmetic involving NULL are unknown; a message is selected only when the whole
+     * expression is true.  Values of different types compare as not equal, the same as
+     * the broker's own selector.
+     *
+     * The expression is compiled once into a flat program for a small value stack.
+     * Matching reads the message's headers and its already decoded property map in
+     * place, so it does not allocate other than to copy the text of JMSMessageID.  A compiled Selector is not modified by matching and can
+     * be shared between threads.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API Selector {
+    private:
+
+        friend class SelectorParser;
+
+        enum OpCode {
+            PUSH_CONSTANT,
+            LOAD_PROPERTY,
+            LOAD_HEADER,
+            AND_JUMP,
+            OR_JUMP,
+            AND,
+            OR,
+            NOT,
+            EQUAL,
+            NOT_EQUAL,
+            LESS_THAN,
+            LESS_THAN_OR_EQUAL,
+            GREATER_THAN,
+            GREATER_THAN_OR_EQUAL,
+            ADD,
+            SUBTRACT,
+            MULTIPLY,
+            DIVIDE,
+            NEGATE,
+            BETWEEN,
+            NOT_BETWEEN,
+            IN,
+            NOT_IN,
+            LIKE,
+            NOT_LIKE,
+            IS_NULL,
+            IS_NOT_NULL
+        };
+
+        enum Header {
+            JMS_DELIVERY_MODE,
+            JMS_PRIORITY,
+            JMS_MESSAGE_ID,
+            JMS_TIMESTAMP,
+            JMS_CORRELATION_ID,
+            JMS_TYPE,
+            JMS_EXPIRATION,
+            JMS_REDELIVERED,
+            JMSX_DELIVERY_COUNT,
+            JMSX_GROUP_ID,
+            JMSX_GROUP_SEQ
+        };
+
+        // The three valued result of a condition.
+        enum Truth {
+            TRUTH_FALSE,
+            TRUTH_TRUE,
+            TRUTH_UNKNOWN
+        };
+
+        // One step of the program, the operand indexes the table the operation uses
+        // or is the target of a jump.
+        struct Instruction {
+            OpCode op;
+            int operand;
+
+            Instruction(OpCode op, int operand) : op(op), operand(operand) {}
+        };
+
+        // A slot of the value stack, UNKNOWN is the SQL NULL.  Strings point at the
+        // message, the selector's tables or the slot's own text.
+        struct Value {
+
+            enum Type {
+                UNKNOWN,
+                BOOLEAN,
+                LONG,
+                DOUBLE,
+                STRING
+            };
+
+            Type type;
+            bool boolValue;
+            long long longValue;
+            double doubleValue;
+            const std::string* stringValue;
+            std::string text;
+
+            Value() : type(UNKNOWN), boolValue(false), longValue(0), doubleValue(0), stringValue(NULL), text() {}
+
+            bool isNumeric() const {
+                return type == LONG || type == DOUBLE;
+            }
+        };
+
+        // A LIKE pattern, the common forms are matched without the general matcher.
+        struct Pattern {
+
+            enum Kind {
+                EXACT,
+                PREFIX,
+                SUFFIX,
+                CONTAINS,
+                GENERAL
+            };
+
+            enum Element {
+                ANY_CHAR = -1,
+                ANY_CHARS = -2
+            };
+
+            Kind kind;
+
+            // The literal text for all kinds but GENERAL.
+            std::string literal;
+
+            // For GENERAL, a literal byte or one of ANY_CHAR and ANY_CHARS.
+            std::vector<short> elements;
+
+            Pattern() : kind(EXACT), literal(), elements() {}
+        };
+
+        std::string expression;
+        std::vector<Instruction> program;
+        std::deque<std::string> strings;
+        std::vector<Value> constants;
+        std::vector< std::vector<std::string> > inLists;
+        std::vector<Pattern> patterns;
+        int stackDepth;
+
+    private:
+
+        Selector(const Selector&);
+        Selector& operator=(const Selector&);
+
+    public:
+
+        /**
+         * Compiles the given selector expression.
+         *
+         * @param expression
+         *      The JMS selector to compile.
+         *
+         * @throws InvalidSelectorException if the expression is not a valid selector.
+         */
+        Selector(const std::string& expression);
+
+        virtual ~Selector();
+
+        /**
+         * @return the expression this selector was compiled from.
+         */
+        const std::string& getExpression() const {
+            return this->expression;
+        }
+
+        /**
+         * Evaluates the selector against the given message.
+         *
+         * @param message
+         *      The message to test, NULL never matches.
+         *
+         * @return true if the selector is true for the message, false if it is false or unknown.
+         */
+        bool matches(const commands::Message* message) const;
+
+    private:
+
+        void load(const commands::Message* message, Header header, Value& value) const;
+
+        void loadProperty(const commands::Message* message, const std::string& name, Value& value) const;
+
+        static bool like(const Pattern& pattern, const std::string& text);
+
+        static Truth truth(const Value& value);
+
+        static void setTruth(Value& value, Truth truth);
+
+        static Truth compare(OpCode op, const Value& left, const Value& right);
+
+        static void arithmetic(OpCode op, Value& left, const Value& right);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_SELECTOR_SELECTOR_H_ */
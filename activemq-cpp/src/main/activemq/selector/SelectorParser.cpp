@@ -0,0 +1,804 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SelectorParser.h"
+
+#include <cms/InvalidSelectorException.h>
+#include <decaf/lang/Integer.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::selector;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    struct KeywordEntry {
+        const char* name;
+        int token;
+    };
+
+    struct HeaderEntry {
+        const char* name;
+        int header;
+    };
+
+    bool isIdentifierStart(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$' ||
+               (unsigned char) c >= 0x80;
+    }
+
+    bool isIdentifierPart(char c) {
+        return isIdentifierStart(c) || (c >= '0' && c <= '9');
+    }
+
+    bool equalsIgnoreCase(const std::string& text, const char* keyword) {
+        std::size_t length = std::strlen(keyword);
+        if (text.size() != length) {
+            return false;
+        }
+        for (std::size_t i = 0; i < length; ++i) {
+            char c = text[i];
+            if (c >= 'a' && c <= 'z') {
+                c = (char) (c - 'a' + 'A');
+            }
+            if (c != keyword[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::SelectorParser(const std::string& text, Selector* selector) :
+    text(text), selector(selector), position(0), token(END), tokenText(), tokenLong(0), tokenDouble(0), depth(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::~SelectorParser() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::parse() {
+
+    next();
+
+    if (token == END) {
+        fail("the selector is empty");
+    }
+
+    requireBoolean(parseOr(), "the selector");
+
+    if (token != END) {
+        fail("unexpected '" + tokenText + "'");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::Kind SelectorParser::parseOr() {
+
+    Kind kind = parseAnd();
+
+    while (token == KEYWORD_OR) {
+        requireBoolean(kind, "OR");
+        int jump = emit(Selector::OR_JUMP);
+        next();
+        requireBoolean(parseAnd(), "OR");
+        emit(Selector::OR);
+        selector->program[jump].operand = (int) selector->program.size();
+        kind = BOOLEAN_KIND;
+    }
+
+    return kind;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::Kind SelectorParser::parseAnd() {
+
+    Kind kind = parseNot();
+
+    while (token == KEYWORD_AND) {
+        requireBoolean(kind, "AND");
+        int jump = emit(Selector::AND_JUMP);
+        next();
+        requireBoolean(parseNot(), "AND");
+        emit(Selector::AND);
+        selector->program[jump].operand = (int) selector->program.size();
+        kind = BOOLEAN_KIND;
+    }
+
+    return kind;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::Kind SelectorParser::parseNot() {
+
+    if (token == KEYWORD_NOT) {
+        next();
+        requireBoolean(parseNot(), "NOT");
+        emit(Selector::NOT);
+        return BOOLEAN_KIND;
+    }
+
+    return parseComparison();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::Kind SelectorParser::parseComparison() {
+
+    Kind left = parseAdditive();
+
+    Selector::OpCode op;
+    switch (token) {
+        case EQUAL:
+            op = Selector::EQUAL;
+            break;
+        case NOT_EQUAL:
+            op = Selector::NOT_EQUAL;
+            break;
+        case LESS_THAN:
+            op = Selector::LESS_THAN;
+            break;
+        case LESS_THAN_OR_EQUAL:
+            op = Selector::LESS_THAN_OR_EQUAL;
+            break;
+        case GREATER_THAN:
+            op = Selector::GREATER_THAN;
+            break;
+        case GREATER_THAN_OR_EQUAL:
+            op = Selector::GREATER_THAN_OR_EQUAL;
+            break;
+        case KEYWORD_IS: {
+            next();
+            bool negated = false;
+            if (token == KEYWORD_NOT) {
+                negated = true;
+                next();
+            }
+            expect(KEYWORD_NULL, "NULL after IS");
+            emit(negated ? Selector::IS_NOT_NULL : Selector::IS_NULL);
+            return BOOLEAN_KIND;
+        }
+        case KEYWORD_NOT:
+        case KEYWORD_BETWEEN:
+        case KEYWORD_LIKE:
+        case KEYWORD_IN: {
+            bool negated = false;
+            if (token == KEYWORD_NOT) {
+                negated = true;
+                next();
+            }
+
+            if (token == KEYWORD_LIKE) {
+                requireString(left, "LIKE");
+                parseLike(negated);
+            } else if (token == KEYWORD_IN) {
+                requireString(left, "IN");
+                parseIn(negated);
+            } else if (token == KEYWORD_BETWEEN) {
+                requireNumeric(left, "BETWEEN");
+                next();
+                requireNumeric(parseAdditive(), "BETWEEN");
+                expect(KEYWORD_AND, "AND in BETWEEN");
+                requireNumeric(parseAdditive(), "BETWEEN");
+                emit(negated ? Selector::NOT_BETWEEN : Selector::BETWEEN);
+            } else {
+                fail("expected BETWEEN, LIKE or IN after NOT");
+            }
+            return BOOLEAN_KIND;
+        }
+        default:
+            return left;
+    }
+
+    next();
+    parseAdditive();
+    emit(op);
+
+    return BOOLEAN_KIND;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::parseLike(bool negated) {
+
+    next();
+    if (token != STRING_LITERAL) {
+        fail("LIKE must be followed by a string pattern");
+    }
+    std::string pattern = tokenText;
+    next();
+
+    int escape = -1;
+    if (token == KEYWORD_ESCAPE) {
+        next();
+        if (token != STRING_LITERAL || tokenText.size() != 1) {
+            fail("ESCAPE must be followed by a single character string");
+        }
+        escape = (unsigned char) tokenText[0];
+        next();
+    }
+
+    selector->patterns.push_back(Selector::Pattern());
+    compilePattern(pattern, escape, selector->patterns.back());
+
+    emit(negated ? Selector::NOT_LIKE : Selector::LIKE, (int) selector->patterns.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::parseIn(bool negated) {
+
+    next();
+    expect(LEFT_PAREN, "'(' after IN");
+
+    std::vector<std::string> values;
+    while (true) {
+        if (token != STRING_LITERAL) {
+            fail("IN lists may only hold strings");
+        }
+        values.push_back(tokenText);
+        next();
+
+        if (token == RIGHT_PAREN) {
+            next();
+            break;
+        }
+        expect(COMMA, "',' or ')' in IN list");
+    }
+
+    // Sorted so that a long list is searched rather than scanned.
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    selector->inLists.push_back(values);
+
+    emit(negated ? Selector::NOT_IN : Selector::IN, (int) selector->inLists.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::Kind SelectorParser::parseAdditive() {
+
+    Kind kind = parseMultiplicative();
+
+    while (token == PLUS || token == MINUS) {
+        Selector::OpCode op = token == PLUS ? Selector::ADD : Selector::SUBTRACT;
+        requireNumeric(kind, "arithmetic");
+        next();
+        requireNumeric(parseMultiplicative(), "arithmetic");
+        emit(op);
+        kind = NUMERIC_KIND;
+    }
+
+    return kind;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::Kind SelectorParser::parseMultiplicative() {
+
+    Kind kind = parseUnary();
+
+    while (token == STAR || token == SLASH) {
+        Selector::OpCode op = token == STAR ? Selector::MULTIPLY : Selector::DIVIDE;
+        requireNumeric(kind, "arithmetic");
+        next();
+        requireNumeric(parseUnary(), "arithmetic");
+        emit(op);
+        kind = NUMERIC_KIND;
+    }
+
+    return kind;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::Kind SelectorParser::parseUnary() {
+
+    if (token == PLUS) {
+        next();
+        Kind kind = parseUnary();
+        requireNumeric(kind, "unary +");
+        return kind;
+    }
+
+    if (token == MINUS) {
+        next();
+
+        // Negative literals are folded into the constant.
+        if (token == LONG_LITERAL || token == DOUBLE_LITERAL) {
+            Selector::Value value;
+            if (token == LONG_LITERAL) {
+                value.type = Selector::Value::LONG;
+                value.longValue = -tokenLong;
+            } else {
+                value.type = Selector::Value::DOUBLE;
+                value.doubleValue = -tokenDouble;
+            }
+            next();
+            pushConstant(value);
+            return NUMERIC_KIND;
+        }
+
+        requireNumeric(parseUnary(), "unary -");
+        emit(Selector::NEGATE);
+        return NUMERIC_KIND;
+    }
+
+    return parsePrimary();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorParser::Kind SelectorParser::parsePrimary() {
+
+    static const HeaderEntry HEADERS[] = {
+        { "JMSDeliveryMode", Selector::JMS_DELIVERY_MODE },
+        { "JMSPriority", Selector::JMS_PRIORITY },
+        { "JMSMessageID", Selector::JMS_MESSAGE_ID },
+        { "JMSTimestamp", Selector::JMS_TIMESTAMP },
+        { "JMSCorrelationID", Selector::JMS_CORRELATION_ID },
+        { "JMSType", Selector::JMS_TYPE },
+        { "JMSExpiration", Selector::JMS_EXPIRATION },
+        { "JMSRedelivered", Selector::JMS_REDELIVERED },
+        { "JMSXDeliveryCount", Selector::JMSX_DELIVERY_COUNT },
+        { "JMSXGroupID", Selector::JMSX_GROUP_ID },
+        { "JMSXGroupSeq", Selector::JMSX_GROUP_SEQ }
+    };
+
+    Selector::Value value;
+
+    switch (token) {
+        case LEFT_PAREN: {
+            next();
+            Kind kind = parseOr();
+            expect(RIGHT_PAREN, "')'");
+            return kind;
+        }
+        case IDENTIFIER: {
+            for (std::size_t i = 0; i < sizeof(HEADERS) / sizeof(HeaderEntry); ++i) {
+                if (tokenText == HEADERS[i].name) {
+                    emit(Selector::LOAD_HEADER, HEADERS[i].header);
+                    next();
+                    return ANY_KIND;
+                }
+            }
+
+            selector->strings.push_back(tokenText);
+            emit(Selector::LOAD_PROPERTY, (int) selector->strings.size() - 1);
+            next();
+            return ANY_KIND;
+        }
+        case STRING_LITERAL:
+            selector->strings.push_back(tokenText);
+            value.type = Selector::Value::STRING;
+            value.stringValue = &selector->strings.back();
+            next();
+            pushConstant(value);
+            return STRING_KIND;
+        case LONG_LITERAL:
+            value.type = Selector::Value::LONG;
+            value.longValue = tokenLong;
+            next();
+            pushConstant(value);
+            return NUMERIC_KIND;
+        case DOUBLE_LITERAL:
+            value.type = Selector::Value::DOUBLE;
+            value.doubleValue = tokenDouble;
+            next();
+            pushConstant(value);
+            return NUMERIC_KIND;
+        case KEYWORD_TRUE:
+        case KEYWORD_FALSE:
+            value.type = Selector::Value::BOOLEAN;
+            value.boolValue = token == KEYWORD_TRUE;
+            next();
+            pushConstant(value);
+            return BOOLEAN_KIND;
+        case KEYWORD_NULL:
+            fail("NULL can only be tested with IS NULL");
+            break;
+        case END:
+            fail("unexpected end of selector");
+            break;
+        default:
+            fail("unexpected '" + tokenText + "'");
+            break;
+    }
+
+    return ANY_KIND;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::next() {
+
+    while (position < text.size() && (text[position] == ' ' || text[position] == '\t' ||
+                                      text[position] == '\n' || text[position] == '\r' ||
+                                      text[position] == '\f')) {
+        position++;
+    }
+
+    tokenText.clear();
+
+    if (position >= text.size()) {
+        token = END;
+        return;
+    }
+
+    char c = text[position];
+
+    if ((c >= '0' && c <= '9') ||
+        (c == '.' && position + 1 < text.size() && text[position + 1] >= '0' && text[position + 1] <= '9')) {
+        readNumber();
+        return;
+    }
+
+    if (c == '\'') {
+        readString();
+        return;
+    }
+
+    if (isIdentifierStart(c)) {
+        readIdentifier();
+        return;
+    }
+
+    tokenText = c;
+    position++;
+
+    switch (c) {
+        case '=':
+            token = EQUAL;
+            return;
+        case '<':
+            if (position < text.size() && text[position] == '>') {
+                tokenText += text[position++];
+                token = NOT_EQUAL;
+            } else if (position < text.size() && text[position] == '=') {
+                tokenText += text[position++];
+                token = LESS_THAN_OR_EQUAL;
+            } else {
+                token = LESS_THAN;
+            }
+            return;
+        case '>':
+            if (position < text.size() && text[position] == '=') {
+                tokenText += text[position++];
+                token = GREATER_THAN_OR_EQUAL;
+            } else {
+                token = GREATER_THAN;
+            }
+            return;
+        case '+':
+            token = PLUS;
+            return;
+        case '-':
+            token = MINUS;
+            return;
+        case '*':
+            token = STAR;
+            return;
+        case '/':
+            token = SLASH;
+            return;
+        case '(':
+            token = LEFT_PAREN;
+            return;
+        case ')':
+            token = RIGHT_PAREN;
+            return;
+        case ',':
+            token = COMMA;
+            return;
+        default:
+            position--;
+            fail("unexpected character '" + tokenText + "'");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::readNumber() {
+
+    std::size_t start = position;
+
+    // Hexadecimal exact numeric.
+    if (text[position] == '0' && position + 1 < text.size() &&
+        (text[position + 1] == 'x' || text[position + 1] == 'X')) {
+
+        position += 2;
+        unsigned long long value = 0;
+        std::size_t digits = position;
+        while (position < text.size() && std::isxdigit((unsigned char) text[position])) {
+            char c = text[position++];
+            int digit = c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+            if (value > (0xFFFFFFFFFFFFFFFFULL >> 4)) {
+                fail("numeric literal out of range");
+            }
+            value = (value << 4) | (unsigned long long) digit;
+        }
+        if (position == digits) {
+            fail("malformed hexadecimal literal");
+        }
+        if (position < text.size() && (text[position] == 'l' || text[position] == 'L')) {
+            position++;
+        }
+
+        tokenText = text.substr(start, position - start);
+        token = LONG_LITERAL;
+        tokenLong = (long long) value;
+        return;
+    }
+
+    bool approximate = false;
+    while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+        position++;
+    }
+    if (position < text.size() && text[position] == '.') {
+        approximate = true;
+        position++;
+        while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+            position++;
+        }
+    }
+    if (position < text.size() && (text[position] == 'e' || text[position] == 'E')) {
+        approximate = true;
+        position++;
+        if (position < text.size() && (text[position] == '+' || text[position] == '-')) {
+            position++;
+        }
+        std::size_t digits = position;
+        while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+            position++;
+        }
+        if (position == digits) {
+            fail("malformed exponent");
+        }
+    }
+
+    tokenText = text.substr(start, position - start);
+
+    if (position < text.size()) {
+        char suffix = text[position];
+        if (suffix == 'f' || suffix == 'F' || suffix == 'd' || suffix == 'D') {
+            approximate = true;
+            position++;
+        } else if (!approximate && (suffix == 'l' || suffix == 'L')) {
+            position++;
+        }
+    }
+
+    if (approximate) {
+        token = DOUBLE_LITERAL;
+        tokenDouble = std::strtod(tokenText.c_str(), NULL);
+        return;
+    }
+
+    // A leading zero makes the literal octal as it would be in Java.
+    int radix = tokenText.size() > 1 && tokenText[0] == '0' ? 8 : 10;
+    unsigned long long limit = 9223372036854775807ULL;
+    unsigned long long value = 0;
+    for (std::size_t i = 0; i < tokenText.size(); ++i) {
+        int digit = tokenText[i] - '0';
+        if (digit >= radix) {
+            fail("malformed octal literal " + tokenText);
+        }
+        if (value > (limit - (unsigned long long) digit) / (unsigned long long) radix) {
+            fail("numeric literal out of range " + tokenText);
+        }
+        value = value * (unsigned long long) radix + (unsigned long long) digit;
+    }
+
+    token = LONG_LITERAL;
+    tokenLong = (long long) value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::readString() {
+
+    std::size_t start = position++;
+
+    while (true) {
+        if (position >= text.size()) {
+            position = start;
+            fail("unterminated string literal");
+        }
+
+        char c = text[position++];
+        if (c == '\'') {
+            // Two quotes in a row are an escaped quote.
+            if (position < text.size() && text[position] == '\'') {
+                tokenText += '\'';
+                position++;
+                continue;
+            }
+            break;
+        }
+        tokenText += c;
+    }
+
+    token = STRING_LITERAL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::readIdentifier() {
+
+    static const KeywordEntry KEYWORDS[] = {
+        { "AND", KEYWORD_AND },
+        { "OR", KEYWORD_OR },
+        { "NOT", KEYWORD_NOT },
+        { "BETWEEN", KEYWORD_BETWEEN },
+        { "LIKE", KEYWORD_LIKE },
+        { "ESCAPE", KEYWORD_ESCAPE },
+        { "IN", KEYWORD_IN },
+        { "IS", KEYWORD_IS },
+        { "NULL", KEYWORD_NULL },
+        { "TRUE", KEYWORD_TRUE },
+        { "FALSE", KEYWORD_FALSE }
+    };
+
+    std::size_t start = position;
+    while (position < text.size() && isIdentifierPart(text[position])) {
+        position++;
+    }
+
+    tokenText = text.substr(start, position - start);
+    token = IDENTIFIER;
+
+    for (std::size_t i = 0; i < sizeof(KEYWORDS) / sizeof(KeywordEntry); ++i) {
+        if (equalsIgnoreCase(tokenText, KEYWORDS[i].name)) {
+            token = (TokenType) KEYWORDS[i].token;
+            return;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::expect(TokenType type, const char* what) {
+
+    if (token != type) {
+        fail(std::string("expected ") + what);
+    }
+
+    next();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::requireBoolean(Kind kind, const char* context) {
+    if (kind != BOOLEAN_KIND && kind != ANY_KIND) {
+        fail(std::string(context) + " needs a boolean expression");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::requireNumeric(Kind kind, const char* context) {
+    if (kind != NUMERIC_KIND && kind != ANY_KIND) {
+        fail(std::string(context) + " needs a numeric expression");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::requireString(Kind kind, const char* context) {
+    if (kind != STRING_KIND && kind != ANY_KIND) {
+        fail(std::string(context) + " needs a string expression");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int SelectorParser::emit(Selector::OpCode op, int operand) {
+
+    switch (op) {
+        case Selector::PUSH_CONSTANT:
+        case Selector::LOAD_PROPERTY:
+        case Selector::LOAD_HEADER:
+            depth++;
+            break;
+        case Selector::AND:
+        case Selector::OR:
+        case Selector::EQUAL:
+        case Selector::NOT_EQUAL:
+        case Selector::LESS_THAN:
+        case Selector::LESS_THAN_OR_EQUAL:
+        case Selector::GREATER_THAN:
+        case Selector::GREATER_THAN_OR_EQUAL:
+        case Selector::ADD:
+        case Selector::SUBTRACT:
+        case Selector::MULTIPLY:
+        case Selector::DIVIDE:
+            depth--;
+            break;
+        case Selector::BETWEEN:
+        case Selector::NOT_BETWEEN:
+            depth -= 2;
+            break;
+        default:
+            break;
+    }
+
+    selector->stackDepth = std::max(selector->stackDepth, depth);
+    selector->program.push_back(Selector::Instruction(op, operand));
+
+    return (int) selector->program.size() - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::pushConstant(const Selector::Value& value) {
+    selector->constants.push_back(value);
+    emit(Selector::PUSH_CONSTANT, (int) selector->constants.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::compilePattern(const std::string& pattern, int escape, Selector::Pattern& compiled) {
+
+    std::vector<short>& elements = compiled.elements;
+
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        unsigned char c = (unsigned char) pattern[i];
+        if ((int) c == escape) {
+            if (++i == pattern.size()) {
+                fail("LIKE pattern ends with its escape character");
+            }
+            elements.push_back((short) (unsigned char) pattern[i]);
+        } else if (c == '%') {
+            if (elements.empty() || elements.back() != Selector::Pattern::ANY_CHARS) {
+                elements.push_back(Selector::Pattern::ANY_CHARS);
+            }
+        } else if (c == '_') {
+            elements.push_back(Selector::Pattern::ANY_CHAR);
+        } else {
+            elements.push_back((short) c);
+        }
+    }
+
+    // Patterns that are a literal with a '%' at one or both ends are matched by a
+    // plain string comparison.
+    std::size_t first = 0;
+    std::size_t last = elements.size();
+    bool leading = first < last && elements[first] == Selector::Pattern::ANY_CHARS;
+    if (leading) {
+        first++;
+    }
+    bool trailing = first < last && elements[last - 1] == Selector::Pattern::ANY_CHARS;
+    if (trailing) {
+        last--;
+    }
+
+    for (std::size_t i = first; i < last; ++i) {
+        if (elements[i] < 0) {
+            compiled.kind = Selector::Pattern::GENERAL;
+            return;
+        }
+        compiled.literal += (char) elements[i];
+    }
+
+    if (leading && trailing) {
+        compiled.kind = Selector::Pattern::CONTAINS;
+    } else if (leading) {
+        compiled.kind = Selector::Pattern::SUFFIX;
+    } else if (trailing) {
+        compiled.kind = Selector::Pattern::PREFIX;
+    } else {
+        compiled.kind = Selector::Pattern::EXACT;
+    }
+    elements.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorParser::fail(const std::string& reason) const {
+    throw cms::InvalidSelectorException(
+        "Invalid selector '" + text + "': " + reason + " at position " + Integer::toString((int) position));
+}
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _ACTIVEMQ_SELECTOR_SELECTORPARSER_H_
+#define _ACTIVEMQ_SELECTOR_SELECTORPARSER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/selector/Selector.h>
+
+#include <string>
+
+namespace activemq {
+namespace selector {
+
+    /**
+     * Compiles the text of a JMS selector into the program of a Selector.  The parser
+     * is a recursive descent over the selector grammar that emits postfix code as it
+     * goes, AND and OR get a jump over their right operand so that evaluation stops
+     * as soon as the result is known.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API SelectorParser {
+    private:
+
+        enum TokenType {
+            END,
+            IDENTIFIER,
+            STRING_LITERAL,
+            LONG_LITERAL,
+            DOUBLE_LITERAL,
+            KEYWORD_AND,
+            KEYWORD_OR,
+            KEYWORD_NOT,
+            KEYWORD_BETWEEN,
+            KEYWORD_LIKE,
+            KEYWORD_ESCAPE,
+            KEYWORD_IN,
+            KEYWORD_IS,
+            KEYWORD_NULL,
+            KEYWORD_TRUE,
+            KEYWORD_FALSE,
+            EQUAL,
+            NOT_EQUAL,
+            LESS_THAN,
+            LESS_THAN_OR_EQUAL,
+            GREATER_THAN,
+            GREATER_THAN_OR_EQUAL,
+            PLUS,
+            MINUS,
+            STAR,
+            SLASH,
+            LEFT_PAREN,
+            RIGHT_PAREN,
+            COMMA
+        };
+
+        // What an expression is known to produce when it is compiled, identifiers can
+        // hold a value of any type so they are accepted wherever a boolean is.
+        enum Kind {
+            BOOLEAN_KIND,
+            ANY_KIND,
+            NUMERIC_KIND,
+            STRING_KIND
+        };
+
+        const std::string& text;
+        Selector* selector;
+
+        std::size_t position;
+        TokenType token;
+        std::string tokenText;
+        long long tokenLong;
+        double tokenDouble;
+
+        int depth;
+
+    private:
+
+        SelectorParser(const SelectorParser&);
+        SelectorParser& operator=(const SelectorParser&);
+
+    public:
+
+        /**
+         * Creates a parser that compiles the text into the given selector's program.
+         *
+         * @param text
+         *      The selector expression.
+         * @param selector
+         *      The Selector whose program and tables are filled in.
+         */
+        SelectorParser(const std::string& text, Selector* selector);
+
+        virtual ~SelectorParser();
+
+        /**
+         * Compiles the whole expression.
+         *
+         * @throws InvalidSelectorException if the expression is not a valid selector.
+         */
+        void parse();
+
+    private:
+
+        Kind parseOr();
+        Kind parseAnd();
+        Kind parseNot();
+        Kind parseComparison();
+        Kind parseAdditive();
+        Kind parseMultiplicative();
+        Kind parseUnary();
+        Kind parsePrimary();
+
+        void parseLike(bool negated);
+        void parseIn(bool negated);
+
+        void next();
+        void readNumber();
+        void readString();
+        void readIdentifier();
+        void expect(TokenType type, const char* what);
+
+        void requireBoolean(Kind kind, const char* context);
+        void requireNumeric(Kind kind, const char* context);
+        void requireString(Kind kind, const char* context);
+
+        int emit(Selector::OpCode op, int operand = 0);
+        void pushConstant(const Selector::Value& value);
+        void compilePattern(const std::string& pattern, int escape, Selector::Pattern& compiled);
+
+        void fail(const std::string& reason) const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_SELECTOR_SELECTORPARSER_H_ */
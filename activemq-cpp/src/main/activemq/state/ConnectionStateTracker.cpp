@@ -19,9 +19,10 @@
 
 #include <decaf/lang/Runnable.h>
 #include <decaf/util/HashCode.h>
-#include <decaf/util/LinkedHashMap.h>
+#include <decaf/util/LinkedFlatHashMap.h>
 #include <decaf/util/MapEntry.h>
 #include <decaf/util/NoSuchElementException.h>
+#include <decaf/util/ArrayList.h>
 #include <decaf/util/concurrent/ConcurrentStlMap.h>
 
 #include <activemq/commands/ConsumerControl.h>
@@ -46,7 +47,7 @@ namespace activemq {
 namespace state {
 
 
-    class MessageCache : public LinkedHashMap<Pointer<MessageId>, Pointer<Command> > {
+    class MessageCache : public LinkedFlatHashMap<Pointer<MessageId>, Pointer<Command> > {
     protected:
 
         ConnectionStateTracker* parent;
@@ -58,7 +59,7 @@ namespace state {
     public:
 
         MessageCache(ConnectionStateTracker* parent) :
-            LinkedHashMap<Pointer<MessageId>, Pointer<Command> >(), parent(parent), currentCacheSize(0) {
+            LinkedFlatHashMap<Pointer<MessageId>, Pointer<Command> >(), parent(parent), currentCacheSize(0) {
         }
 
         virtual ~MessageCache() {}
@@ -73,7 +74,7 @@ namespace state {
         }
     };
 
-    class MessagePullCache : public LinkedHashMap<std::string, Pointer<Command> > {
+    class MessagePullCache : public LinkedFlatHashMap<std::string, Pointer<Command> > {
     protected:
 
         ConnectionStateTracker* parent;
@@ -81,7 +82,7 @@ namespace state {
     public:
 
         MessagePullCache(ConnectionStateTracker* parent) :
-            LinkedHashMap<std::string, Pointer<Command> >(), parent(parent) {
+            LinkedFlatHashMap<std::string, Pointer<Command> >(), parent(parent) {
         }
 
         virtual ~MessagePullCache() {}
@@ -131,6 +132,56 @@ namespace state {
         }
     };
 
+    /**
+     * Collects the commands written during restore and hands them to the Transport
+     * with onewayBatch each time the configured batch size is reached.
+     */
+    class RestoreBatch {
+    private:
+
+        Pointer<transport::Transport> transport;
+        ArrayList<Pointer<Command> > pending;
+        int batchSize;
+
+    private:
+
+        RestoreBatch(const RestoreBatch&);
+        RestoreBatch& operator=(const RestoreBatch&);
+
+    public:
+
+        RestoreBatch(Pointer<transport::Transport> transport, int batchSize) :
+            transport(transport), pending(), batchSize(batchSize < 1 ? 1 : batchSize) {
+        }
+
+        ~RestoreBatch() {}
+
+        Pointer<transport::Transport> getTransport() const {
+            return this->transport;
+        }
+
+        void add(Pointer<Command> command) {
+            this->pending.add(command);
+            if (this->pending.size() >= this->batchSize) {
+                flush();
+            }
+        }
+
+        void flush() {
+            if (this->pending.isEmpty()) {
+                return;
+            }
+
+            if (this->pending.size() == 1) {
+                this->transport->oneway(this->pending.get(0));
+            } else {
+                this->transport->onewayBatch(this->pending);
+            }
+
+            this->pending.clear();
+        }
+    };
+
     class RemoveTransactionAction : public Runnable {
     private:
 
@@ -172,7 +223,8 @@ ConnectionStateTracker::ConnectionStateTracker() : impl(new StateTrackerImpl(thi
                                                    trackMessages(true),
                                                    trackTransactionProducers(true),
                                                    maxMessageCacheSize(128 * 1024),
-                                                   maxMessagePullCacheSize(10) {
+                                                   maxMessagePullCacheSize(10),
+                                                   restoreBatchSize(500) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -223,6 +275,8 @@ void ConnectionStateTracker::restore(Pointer<transport::Transport> transport) {
 
     try {
 
+        RestoreBatch batch(transport, this->restoreBatchSize);
+
         Pointer<Iterator<Pointer<ConnectionState> > > iterator(
             this->impl->connectionStates.values().iterator());
 
@@ -231,29 +285,31 @@ void ConnectionStateTracker::restore(Pointer<transport::Transport> transport) {
 
             Pointer<ConnectionInfo> info = state->getInfo();
             info->setFailoverReconnect(true);
-            transport->oneway(info);
+            batch.add(info);
 
-            doRestoreTempDestinations(transport, state);
+            doRestoreTempDestinations(batch, state);
 
             if (restoreSessions) {
-                doRestoreSessions(transport, state);
+                doRestoreSessions(batch, state);
             }
 
             if (restoreTransaction) {
-                doRestoreTransactions(transport, state);
+                doRestoreTransactions(batch, state);
             }
         }
 
         // Now we flush messages
         Pointer<Iterator<Pointer<Command> > > messages(this->impl->messageCache.values().iterator());
         while (messages->hasNext()) {
-            transport->oneway(messages->next());
+            batch.add(messages->next());
         }
 
         Pointer<Iterator<Pointer<Command> > > messagePullIter(this->impl->messagePullCache.values().iterator());
         while (messagePullIter->hasNext()) {
-            transport->oneway(messagePullIter->next());
+            batch.add(messagePullIter->next());
         }
+
+        batch.flush();
     }
     AMQ_CATCH_RETHROW(IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
@@ -261,7 +317,7 @@ void ConnectionStateTracker::restore(Pointer<transport::Transport> transport) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ConnectionStateTracker::doRestoreTransactions(Pointer<transport::Transport> transport, Pointer<ConnectionState> connectionState) {
+void ConnectionStateTracker::doRestoreTransactions(RestoreBatch& batch, Pointer<ConnectionState> connectionState) {
 
     try {
 
@@ -285,21 +341,28 @@ void ConnectionStateTracker::doRestoreTransactions(Pointer<transport::Transport>
             // replay short lived producers that may have been involved in the transaction
             Pointer<Iterator<Pointer<ProducerState> > > state(txState->getProducerStates().iterator());
             while (state->hasNext()) {
-                transport->oneway(state->next()->getInfo());
+                batch.add(state->next()->getInfo());
             }
 
             std::auto_ptr<Iterator<Pointer<Command> > > commands(txState->getCommands().iterator());
 
             while (commands->hasNext()) {
-                transport->oneway(commands->next());
+                batch.add(commands->next());
             }
 
             state.reset(txState->getProducerStates().iterator());
             while (state->hasNext()) {
-                transport->oneway(state->next()->getInfo()->createRemoveCommand());
+                batch.add(state->next()->getInfo()->createRemoveCommand());
             }
         }
 
+        if (toRollback.empty()) {
+            return;
+        }
+
+        // Everything restored so far must be on the wire before the rollbacks are reported.
+        batch.flush();
+
         // Trigger failure of commit for all outstanding completed but in doubt transactions.
         std::vector<Pointer<TransactionInfo> >::const_iterator command = toRollback.begin();
         for (; command != toRollback.end(); ++command) {
@@ -310,7 +373,7 @@ void ConnectionStateTracker::doRestoreTransactions(Pointer<transport::Transport>
                     std::string("Transaction completion in doubt due to failover. Forcing rollback of ") + (*command)->getTransactionId()->toString());
             response->setException(exception);
             response->setCorrelationId((*command)->getCommandId());
-            transport->getTransportListener()->onCommand(response);
+            batch.getTransport()->getTransportListener()->onCommand(response);
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -319,21 +382,28 @@ void ConnectionStateTracker::doRestoreTransactions(Pointer<transport::Transport>
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ConnectionStateTracker::doRestoreSessions(Pointer<transport::Transport> transport, Pointer<ConnectionState> connectionState) {
+void ConnectionStateTracker::doRestoreSessions(RestoreBatch& batch, Pointer<ConnectionState> connectionState) {
 
     try {
 
+        // All sessions go first, then the consumers of every session and only then the
+        // producers, this lets the broker resume dispatch before the rest is restored.
         Pointer<Iterator<Pointer<SessionState> > > iter(connectionState->getSessionStates().iterator());
         while (iter->hasNext()) {
-            Pointer<SessionState> state = iter->next();
-            transport->oneway(state->getInfo());
+            batch.add(iter->next()->getInfo());
+        }
 
-            if (restoreProducers) {
-                doRestoreProducers(transport, state);
+        if (restoreConsumers) {
+            iter.reset(connectionState->getSessionStates().iterator());
+            while (iter->hasNext()) {
+                doRestoreConsumers(batch, iter->next());
             }
+        }
 
-            if (restoreConsumers) {
-                doRestoreConsumers(transport, state);
+        if (restoreProducers) {
+            iter.reset(connectionState->getSessionStates().iterator());
+            while (iter->hasNext()) {
+                doRestoreProducers(batch, iter->next());
             }
         }
     }
@@ -343,7 +413,7 @@ void ConnectionStateTracker::doRestoreSessions(Pointer<transport::Transport> tra
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ConnectionStateTracker::doRestoreConsumers(Pointer<transport::Transport> transport, Pointer<SessionState> sessionState) {
+void ConnectionStateTracker::doRestoreConsumers(RestoreBatch& batch, Pointer<SessionState> sessionState) {
 
     try {
 
@@ -351,12 +421,12 @@ void ConnectionStateTracker::doRestoreConsumers(Pointer<transport::Transport> tr
         Pointer<ConnectionState> connectionState =
             this->impl->connectionStates.get(sessionState->getInfo()->getSessionId()->getParentId());
         bool connectionInterruptionProcessingComplete = connectionState->isConnectionInterruptProcessingComplete();
+        Pointer<wireformat::WireFormat> wireFormat = batch.getTransport()->getWireFormat();
 
         Pointer<Iterator<Pointer<ConsumerState> > > state(sessionState->getConsumerStates().iterator());
         while (state->hasNext()) {
 
             Pointer<ConsumerInfo> infoToSend = state->next()->getInfo();
-            Pointer<wireformat::WireFormat> wireFormat = transport->getWireFormat();
 
             if (!connectionInterruptionProcessingComplete && infoToSend->getPrefetchSize() > 0 && wireFormat->getVersion() > 5) {
 
@@ -366,7 +436,7 @@ void ConnectionStateTracker::doRestoreConsumers(Pointer<transport::Transport> tr
                 infoToSend->setPrefetchSize(0);
             }
 
-            transport->oneway(infoToSend);
+            batch.add(infoToSend);
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -375,7 +445,7 @@ void ConnectionStateTracker::doRestoreConsumers(Pointer<transport::Transport> tr
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ConnectionStateTracker::doRestoreProducers(Pointer<transport::Transport> transport, Pointer<SessionState> sessionState) {
+void ConnectionStateTracker::doRestoreProducers(RestoreBatch& batch, Pointer<SessionState> sessionState) {
 
     try {
 
@@ -383,7 +453,7 @@ void ConnectionStateTracker::doRestoreProducers(Pointer<transport::Transport> tr
         Pointer<Iterator<Pointer<ProducerState> > > iter(sessionState->getProducerStates().iterator());
         while (iter->hasNext()) {
             Pointer<ProducerState> state = iter->next();
-            transport->oneway(state->getInfo());
+            batch.add(state->getInfo());
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -392,12 +462,12 @@ void ConnectionStateTracker::doRestoreProducers(Pointer<transport::Transport> tr
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ConnectionStateTracker::doRestoreTempDestinations(Pointer<transport::Transport> transport, Pointer<ConnectionState> connectionState) {
+void ConnectionStateTracker::doRestoreTempDestinations(RestoreBatch& batch, Pointer<ConnectionState> connectionState) {
     try {
         std::auto_ptr<Iterator<Pointer<DestinationInfo> > > iter(connectionState->getTempDesinations().iterator());
 
         while (iter->hasNext()) {
-            transport->oneway(iter->next());
+            batch.add(iter->next());
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -36,6 +36,7 @@ namespace activemq {
 namespace state {
 
     class RemoveTransactionAction;
+    class RestoreBatch;
     class StateTrackerImpl;
 
     class AMQCPP_API ConnectionStateTracker: public CommandVisitorAdapter {
@@ -52,6 +53,7 @@ namespace state {
         bool trackTransactionProducers;
         int maxMessageCacheSize;
         int maxMessagePullCacheSize;
+        int restoreBatchSize;
 
         friend class RemoveTransactionAction;
 
@@ -65,6 +67,17 @@ namespace state {
 
         void trackBack(decaf::lang::Pointer<Command> command);
 
+        /**
+         * Replays the tracked state onto the given Transport.  The commands are written
+         * in batches of at most restoreBatchSize commands using Transport::onewayBatch,
+         * all sessions and their consumers are restored ahead of the producers so that
+         * message delivery can resume as early as possible.
+         *
+         * @param transport
+         *      The Transport that the tracked state is restored on.
+         *
+         * @throws IOException if an error occurs while writing to the Transport.
+         */
         void restore(decaf::lang::Pointer<transport::Transport> transport);
 
         void connectionInterruptProcessingComplete(
@@ -172,6 +185,24 @@ namespace state {
             this->maxMessagePullCacheSize = maxMessagePullCacheSize;
         }
 
+        /**
+         * @return the maximum number of commands written by one onewayBatch call during restore.
+         */
+        int getRestoreBatchSize() const {
+            return this->restoreBatchSize;
+        }
+
+        /**
+         * Sets the maximum number of commands that are written to the Transport in a single
+         * batch during restore, values less than one restore one command at a time.
+         *
+         * @param restoreBatchSize
+         *      The maximum number of commands in a restore batch.
+         */
+        void setRestoreBatchSize(int restoreBatchSize) {
+            this->restoreBatchSize = restoreBatchSize;
+        }
+
         bool isTrackTransactionProducers() const {
             return this->trackTransactionProducers;
         }
@@ -182,20 +213,15 @@ namespace state {
 
     private:
 
-        void doRestoreTransactions(decaf::lang::Pointer<transport::Transport> transport,
-                                   decaf::lang::Pointer<ConnectionState> connectionState);
+        void doRestoreTransactions(RestoreBatch& batch, decaf::lang::Pointer<ConnectionState> connectionState);
 
-        void doRestoreSessions(decaf::lang::Pointer<transport::Transport> transport,
-                               decaf::lang::Pointer<ConnectionState> connectionState);
+        void doRestoreSessions(RestoreBatch& batch, decaf::lang::Pointer<ConnectionState> connectionState);
 
-        void doRestoreConsumers(decaf::lang::Pointer<transport::Transport> transport,
-                                decaf::lang::Pointer<SessionState> sessionState);
+        void doRestoreConsumers(RestoreBatch& batch, decaf::lang::Pointer<SessionState> sessionState);
 
-        void doRestoreProducers(decaf::lang::Pointer<transport::Transport> transport,
-                                decaf::lang::Pointer<SessionState> sessionState);
+        void doRestoreProducers(RestoreBatch& batch, decaf::lang::Pointer<SessionState> sessionState);
 
-        void doRestoreTempDestinations(decaf::lang::Pointer<transport::Transport> transport,
-                                       decaf::lang::Pointer<ConnectionState> connectionState);
+        void doRestoreTempDestinations(RestoreBatch& batch, decaf::lang::Pointer<ConnectionState> connectionState);
 
     };
 
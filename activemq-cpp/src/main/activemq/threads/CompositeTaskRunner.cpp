@@ -154,6 +154,16 @@ void CompositeTaskRunner::wakeup() {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void CompositeTaskRunner::applyThreadPolicy(const ThreadPolicy& policy, ThreadPolicy::Role role) {
+
+    synchronized(&impl->mutex) {
+        if (this->impl->thread != NULL && this->impl->thread->getState() != Thread::TERMINATED) {
+            policy.apply(role, this->impl->thread.get());
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void CompositeTaskRunner::run() {
 
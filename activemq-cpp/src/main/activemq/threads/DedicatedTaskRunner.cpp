@@ -124,6 +124,16 @@ void DedicatedTaskRunner::wakeup() {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void DedicatedTaskRunner::applyThreadPolicy(const ThreadPolicy& policy, ThreadPolicy::Role role) {
+
+    synchronized(&mutex) {
+        if (this->thread != NULL && this->thread->getState() != Thread::TERMINATED) {
+            policy.apply(role, this->thread.get());
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void DedicatedTaskRunner::run() {
 
@@ -21,6 +21,7 @@
 #include <activemq/util/Config.h>
 #include <activemq/threads/TaskRunner.h>
 #include <activemq/threads/Task.h>
+#include <activemq/threads/ThreadPolicy.h>
 
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/Runnable.h>
@@ -76,6 +77,15 @@ namespace threads {
          */
         virtual void wakeup();
 
+        /**
+         * Applies the settings of the given Role from the ThreadPolicy to this runner's
+         * thread, this can be done either before or after the runner is started.
+         *
+         * @param policy - The ThreadPolicy to take the settings from.
+         * @param role - The Role whose settings are applied.
+         */
+        void applyThreadPolicy(const ThreadPolicy& policy, ThreadPolicy::Role role);
+
     protected:
 
         virtual void run();
@@ -0,0 +1,221 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledTaskRunner.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/concurrent/RejectedExecutionException.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // How often a shutdown that is waiting on a queued run checks whether the
+    // executor has terminated and so will never start that run.
+    const long long TERMINATION_CHECK_INTERVAL = 100;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledTaskRunner::PooledTaskRunner(ExecutorService* executor, Task* task, int maxIterationsPerRun) :
+    mutex(), executor(executor), task(task), maxIterationsPerRun(maxIterationsPerRun),
+    started(false), shutDown(false), queued(false), scheduled(false), runningThread(NULL) {
+
+    if (this->executor == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Executor passed was null");
+    }
+
+    if (this->task == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Task passed was null");
+    }
+
+    if (this->maxIterationsPerRun < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Max iterations per run must be at least one");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledTaskRunner::~PooledTaskRunner() {
+    try {
+        this->shutdown();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::start() {
+
+    synchronized(&mutex) {
+        if (started || shutDown) {
+            return;
+        }
+
+        started = true;
+        queued = true;
+        if (!scheduled) {
+            schedule();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PooledTaskRunner::isStarted() const {
+
+    bool result = false;
+
+    synchronized(&mutex) {
+        result = started;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::shutdown(long long timeout) {
+
+    synchronized(&mutex) {
+        shutDown = true;
+    }
+
+    awaitIdle(timeout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::shutdown() {
+
+    synchronized(&mutex) {
+        shutDown = true;
+    }
+
+    awaitIdle(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::wakeup() {
+
+    synchronized(&mutex) {
+        if (shutDown || queued) {
+            return;
+        }
+
+        // A run in progress sees the flag and queues the runner again when it ends.
+        queued = true;
+        if (started && !scheduled) {
+            schedule();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::run() {
+
+    synchronized(&mutex) {
+        queued = false;
+        if (shutDown) {
+            scheduled = false;
+            mutex.notifyAll();
+            return;
+        }
+
+        runningThread = Thread::currentThread();
+    }
+
+    bool done = false;
+    bool stopped = false;
+
+    try {
+        for (int i = 0; i < maxIterationsPerRun && !done && !stopped; ++i) {
+            done = !this->task->iterate();
+
+            // The task may have shut its own runner down.
+            synchronized(&mutex) {
+                stopped = shutDown;
+            }
+        }
+    } catch (...) {
+        done = true;
+    }
+
+    synchronized(&mutex) {
+        runningThread = NULL;
+
+        if (!done) {
+            queued = true;
+        }
+
+        if (queued && !shutDown) {
+            schedule();
+        } else {
+            queued = false;
+            scheduled = false;
+            mutex.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::schedule() {
+
+    scheduled = true;
+
+    try {
+        this->executor->execute(this, false);
+    } catch (RejectedExecutionException& ex) {
+        queued = false;
+        scheduled = false;
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::awaitIdle(long long timeout) {
+
+    long long deadline = System::currentTimeMillis() + timeout;
+
+    synchronized(&mutex) {
+
+        // No need to wait if shutdown is called from the task being run.
+        if (runningThread == Thread::currentThread()) {
+            return;
+        }
+
+        while (scheduled && !this->executor->isTerminated()) {
+
+            long long waitTime = TERMINATION_CHECK_INTERVAL;
+            if (timeout > 0) {
+                long long remaining = deadline - System::currentTimeMillis();
+                if (remaining <= 0) {
+                    return;
+                }
+                waitTime = remaining < waitTime ? remaining : waitTime;
+            }
+
+            mutex.wait(waitTime);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_
+#define _ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/threads/TaskRunner.h>
+#include <activemq/threads/Task.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/ExecutorService.h>
+
+namespace activemq {
+namespace threads {
+
+    /**
+     * A TaskRunner that borrows a thread from a shared ExecutorService whenever its
+     * Task has work instead of keeping a thread of its own.  At most one iteration
+     * cycle is in flight at a time, and after a bounded number of iterations the
+     * runner hands its thread back to the pool and queues itself again so that one
+     * busy Task cannot hold a pool thread away from the others.
+     *
+     * The runner does not own the ExecutorService, which must outlive it.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API PooledTaskRunner : public TaskRunner,
+                                        public decaf::lang::Runnable {
+    private:
+
+        mutable decaf::util::concurrent::Mutex mutex;
+        decaf::util::concurrent::ExecutorService* executor;
+        Task* task;
+        int maxIterationsPerRun;
+
+        bool started;
+        bool shutDown;
+
+        // A run has been requested and will iterate the task again.
+        bool queued;
+
+        // This runner is sitting in the executor or running on one of its threads.
+        bool scheduled;
+
+        decaf::lang::Thread* runningThread;
+
+    private:
+
+        PooledTaskRunner(const PooledTaskRunner&);
+        PooledTaskRunner& operator=(const PooledTaskRunner&);
+
+    public:
+
+        /**
+         * Creates a new PooledTaskRunner.
+         *
+         * @param executor
+         *      The ExecutorService whose threads run the Task, not owned by the runner.
+         * @param task
+         *      The Task whose iterate method is called.
+         * @param maxIterationsPerRun
+         *      The number of iterations run before the thread is returned to the pool.
+         *
+         * @throws NullPointerException if the executor or the task is NULL.
+         * @throws IllegalArgumentException if maxIterationsPerRun is less than one.
+         */
+        PooledTaskRunner(decaf::util::concurrent::ExecutorService* executor, Task* task, int maxIterationsPerRun);
+
+        virtual ~PooledTaskRunner();
+
+        virtual void start();
+
+        virtual bool isStarted() const;
+
+        /**
+         * Shutdown after a timeout, does not guarantee that the task's iterate
+         * method has completed.
+         *
+         * @param timeout - Time in Milliseconds to wait for the task to stop.
+         */
+        virtual void shutdown(long long timeout);
+
+        /**
+         * Shutdown once the task's current iteration cycle, if any, has finished and
+         * the runner is no longer queued in the executor.
+         */
+        virtual void shutdown();
+
+        /**
+         * Signal the TaskRunner to wakeup and execute another iteration cycle on
+         * the task, the Task instance will be run until its iterate method has
+         * returned false indicating it is done.
+         */
+        virtual void wakeup();
+
+    protected:
+
+        virtual void run();
+
+    private:
+
+        void schedule();
+
+        void awaitIdle(long long timeout);
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_*/
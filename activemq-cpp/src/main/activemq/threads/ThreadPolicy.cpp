@@ -0,0 +1,232 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThreadPolicy.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/NumberFormatException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/StringTokenizer.h>
+
+#include <memory>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+const int ThreadPolicy::ROLE_COUNT = 5;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::string trim(const std::string& value) {
+        std::string::size_type begin = value.find_first_not_of(" \t");
+        if (begin == std::string::npos) {
+            return "";
+        }
+        std::string::size_type end = value.find_last_not_of(" \t");
+        return value.substr(begin, end - begin + 1);
+    }
+
+    int parseCpu(const std::string& value, const std::string& list) {
+        int cpu = -1;
+        try {
+            cpu = Integer::parseInt(trim(value));
+        } catch (NumberFormatException& ex) {
+        }
+
+        if (cpu < 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__,
+                "Invalid processor number '%s' in affinity list '%s'", value.c_str(), list.c_str());
+        }
+
+        return cpu;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPolicy::ThreadPolicy() : settings(ROLE_COUNT) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPolicy::~ThreadPolicy() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ThreadPolicy::getRoleName(Role role) {
+
+    switch (role) {
+        case TRANSPORT_READER:
+            return "transportReader";
+        case SESSION_DISPATCH:
+            return "sessionDispatch";
+        case FAILOVER:
+            return "failover";
+        case SCHEDULER:
+            return "scheduler";
+        case EXECUTOR:
+            return "executor";
+    }
+
+    throw IllegalArgumentException(__FILE__, __LINE__, "Unknown thread role: %d", (int) role);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<int> ThreadPolicy::parseAffinity(const std::string& value) {
+
+    std::vector<int> cpus;
+    StringTokenizer tokenizer(value, ",");
+
+    while (tokenizer.hasMoreTokens()) {
+
+        std::string token = trim(tokenizer.nextToken());
+        if (token.empty()) {
+            continue;
+        }
+
+        std::string::size_type dash = token.find('-', 1);
+        if (dash == std::string::npos) {
+            cpus.push_back(parseCpu(token, value));
+            continue;
+        }
+
+        int first = parseCpu(token.substr(0, dash), value);
+        int last = parseCpu(token.substr(dash + 1), value);
+
+        if (last < first) {
+            throw IllegalArgumentException(__FILE__, __LINE__,
+                "Invalid processor range '%s' in affinity list '%s'", token.c_str(), value.c_str());
+        }
+
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicy::configure(const Properties& properties) {
+
+    for (int i = 0; i < ROLE_COUNT; ++i) {
+
+        Role role = (Role) i;
+        std::string prefix = std::string("threads.") + getRoleName(role) + ".";
+
+        if (properties.hasProperty(prefix + "name")) {
+            setName(role, properties.getProperty(prefix + "name"));
+        }
+
+        if (properties.hasProperty(prefix + "priority")) {
+            std::string value = properties.getProperty(prefix + "priority");
+            try {
+                setPriority(role, Integer::parseInt(trim(value)));
+            } catch (NumberFormatException& ex) {
+                throw IllegalArgumentException(__FILE__, __LINE__,
+                    "Invalid value '%s' for %spriority", value.c_str(), prefix.c_str());
+            }
+        }
+
+        if (properties.hasProperty(prefix + "affinity")) {
+            setAffinity(role, parseAffinity(properties.getProperty(prefix + "affinity")));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ThreadPolicy::isEmpty() const {
+
+    std::vector<RoleSettings>::const_iterator iter = this->settings.begin();
+    for (; iter != this->settings.end(); ++iter) {
+        if (!iter->name.empty() || iter->priority != 0 || !iter->affinity.empty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string& ThreadPolicy::getName(Role role) const {
+    return this->settings.at(role).name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicy::setName(Role role, const std::string& name) {
+    this->settings.at(role).name = name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ThreadPolicy::getPriority(Role role) const {
+    return this->settings.at(role).priority;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicy::setPriority(Role role, int priority) {
+
+    if (priority != 0 && (priority < Thread::MIN_PRIORITY || priority > Thread::MAX_PRIORITY)) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Thread priority %d is out of range", priority);
+    }
+
+    this->settings.at(role).priority = priority;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::vector<int>& ThreadPolicy::getAffinity(Role role) const {
+    return this->settings.at(role).affinity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicy::setAffinity(Role role, const std::vector<int>& cpus) {
+    this->settings.at(role).affinity = cpus;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicy::apply(Role role, Thread* thread) const {
+
+    if (thread == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Thread to configure cannot be NULL");
+    }
+
+    const RoleSettings& roleSettings = this->settings.at(role);
+
+    if (!roleSettings.name.empty()) {
+        thread->setName(roleSettings.name);
+    }
+
+    if (roleSettings.priority != 0) {
+        thread->setPriority(roleSettings.priority);
+    }
+
+    if (!roleSettings.affinity.empty()) {
+        thread->setAffinity(roleSettings.affinity);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Thread* ThreadPolicy::newThread(Role role, Runnable* task, const std::string& defaultName) const {
+
+    std::auto_ptr<Thread> thread(new Thread(task, defaultName));
+    apply(role, thread.get());
+    return thread.release();
+}
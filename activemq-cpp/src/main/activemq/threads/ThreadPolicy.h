@@ -0,0 +1,181 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_THREADPOLICY_H_
+#define _ACTIVEMQ_THREADS_THREADPOLICY_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/Properties.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace threads {
+
+    /**
+     * Describes how the threads that the library creates on its own behalf are set up.
+     * Every such thread serves one Role and for each Role the policy can assign a name,
+     * a priority and the set of processors the thread may run on, anything left unset
+     * keeps the library default.
+     *
+     * A policy is either filled in programmatically or from a set of properties such
+     * as the options of a connection URI, the recognized keys are:
+     *
+     *   threads.<role>.name=<thread name>
+     *   threads.<role>.priority=<Thread::MIN_PRIORITY to Thread::MAX_PRIORITY>
+     *   threads.<role>.affinity=<processor list, e.g. 0,2,4-7>
+     *
+     * where role is one of transportReader, sessionDispatch, failover, scheduler or
+     * executor.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API ThreadPolicy {
+    public:
+
+        enum Role {
+            /** The IOTransport thread that reads commands from the wire. */
+            TRANSPORT_READER = 0,
+            /** The dedicated thread of each Session that dispatches to its consumers. */
+            SESSION_DISPATCH = 1,
+            /** The FailoverTransport reconnect and backup task thread. */
+            FAILOVER = 2,
+            /** The Connection Scheduler's timer thread used for ack and redelivery tasks. */
+            SCHEDULER = 3,
+            /** The Connection executor thread used for async listener notifications. */
+            EXECUTOR = 4
+        };
+
+        static const int ROLE_COUNT;
+
+    private:
+
+        struct RoleSettings {
+            std::string name;
+            int priority;
+            std::vector<int> affinity;
+
+            RoleSettings() : name(), priority(0), affinity() {}
+        };
+
+        std::vector<RoleSettings> settings;
+
+    public:
+
+        ThreadPolicy();
+
+        virtual ~ThreadPolicy();
+
+        /**
+         * @return the name used for a Role in the property keys, e.g. "transportReader".
+         */
+        static std::string getRoleName(Role role);
+
+        /**
+         * Parses a processor list made of comma separated numbers and inclusive ranges,
+         * for example "0,2,4-7".
+         *
+         * @param value
+         *      The processor list to parse, an empty string yields an empty list.
+         *
+         * @return the processor numbers in the order given.
+         *
+         * @throws IllegalArgumentException if the list is malformed.
+         */
+        static std::vector<int> parseAffinity(const std::string& value);
+
+        /**
+         * Reads any threads.<role>.* keys from the given properties, keys that are
+         * absent leave the current settings untouched.
+         *
+         * @param properties
+         *      The properties to read, typically the options of a connection URI.
+         *
+         * @throws IllegalArgumentException if a value cannot be parsed.
+         */
+        void configure(const decaf::util::Properties& properties);
+
+        /**
+         * @return true if no Role has any setting assigned.
+         */
+        bool isEmpty() const;
+
+        const std::string& getName(Role role) const;
+
+        /**
+         * Sets the name given to threads of the Role, an empty name keeps the default.
+         */
+        void setName(Role role, const std::string& name);
+
+        int getPriority(Role role) const;
+
+        /**
+         * Sets the priority given to threads of the Role, zero keeps the default.
+         *
+         * @throws IllegalArgumentException if the value is not zero and out of range.
+         */
+        void setPriority(Role role, int priority);
+
+        const std::vector<int>& getAffinity(Role role) const;
+
+        /**
+         * Sets the processors threads of the Role are pinned to, an empty list leaves
+         * them free to run anywhere.
+         */
+        void setAffinity(Role role, const std::vector<int>& cpus);
+
+        /**
+         * Applies the settings of the Role to the given Thread, which may be either new
+         * or already running.
+         *
+         * @param role
+         *      The Role the Thread serves.
+         * @param thread
+         *      The Thread to configure.
+         *
+         * @throws NullPointerException if the thread is NULL.
+         * @throws UnsupportedOperationException if affinity is set but the platform can't apply it.
+         * @throws RuntimeException if the operating system rejects a setting.
+         */
+        void apply(Role role, decaf::lang::Thread* thread) const;
+
+        /**
+         * Creates a new Thread for the Role with this policy applied, the caller owns
+         * the returned Thread.
+         *
+         * @param role
+         *      The Role the new Thread serves.
+         * @param task
+         *      The Runnable to execute, still owned by the caller.
+         * @param defaultName
+         *      The name used when the policy assigns none to the Role.
+         *
+         * @return a new Thread that has not been started.
+         */
+        decaf::lang::Thread* newThread(Role role, decaf::lang::Runnable* task,
+                                       const std::string& defaultName) const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_THREADS_THREADPOLICY_H_ */
@@ -34,11 +34,11 @@ using namespace decaf::lang::exceptions;
 using namespace decaf::util::concurrent;
 
 ////////////////////////////////////////////////////////////////////////////////
-FutureResponse::FutureResponse() : responseLatch(1), response(), responseCallback() {}
+FutureResponse::FutureResponse() : CompletableFuture< Pointer<Response> >(), responseCallback() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 FutureResponse::FutureResponse(const Pointer<ResponseCallback> responseCallback) :
-    responseLatch(1), response(), responseCallback(responseCallback) {}
+    CompletableFuture< Pointer<Response> >(), responseCallback(responseCallback) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 FutureResponse::~FutureResponse() {}
@@ -46,50 +46,45 @@ FutureResponse::~FutureResponse() {}
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Response> FutureResponse::getResponse() const {
     try {
-        this->responseLatch.await();
-        return response;
+        this->await();
+        return this->getNow(Pointer<Response>());
     } catch (decaf::lang::exceptions::InterruptedException& ex) {
         decaf::lang::Thread::currentThread()->interrupt();
         throw decaf::io::InterruptedIOException(__FILE__, __LINE__, "Interrupted while awaiting a response");
+    } catch (CancellationException& ex) {
+        throw decaf::io::IOException(__FILE__, __LINE__, "Request cancelled while awaiting a response");
+    } catch (ExecutionException& ex) {
+        throw decaf::io::IOException(__FILE__, __LINE__, ex.getMessage().c_str());
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Response> FutureResponse::getResponse() {
-    try {
-        this->responseLatch.await();
-        return response;
-    } catch (decaf::lang::exceptions::InterruptedException& ex) {
-        decaf::lang::Thread::currentThread()->interrupt();
-        throw decaf::io::InterruptedIOException(__FILE__, __LINE__, "Interrupted while awaiting a response");
-    }
+    return static_cast<const FutureResponse*>(this)->getResponse();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Response> FutureResponse::getResponse(unsigned int timeout) const {
     try {
-        this->responseLatch.await(timeout);
-        return response;
+        this->await(timeout, TimeUnit::MILLISECONDS);
+        return this->getNow(Pointer<Response>());
     } catch (decaf::lang::exceptions::InterruptedException& ex) {
         throw decaf::io::InterruptedIOException(__FILE__, __LINE__, "Interrupted while awaiting a response");
+    } catch (CancellationException& ex) {
+        throw decaf::io::IOException(__FILE__, __LINE__, "Request cancelled while awaiting a response");
+    } catch (ExecutionException& ex) {
+        throw decaf::io::IOException(__FILE__, __LINE__, ex.getMessage().c_str());
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Response> FutureResponse::getResponse(unsigned int timeout) {
-    try {
-        this->responseLatch.await(timeout);
-        return response;
-    } catch (decaf::lang::exceptions::InterruptedException& ex) {
-        throw decaf::io::InterruptedIOException(__FILE__, __LINE__, "Interrupted while awaiting a response");
-    }
+    return static_cast<const FutureResponse*>(this)->getResponse(timeout);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void FutureResponse::setResponse(Pointer<Response> response) {
-    this->response = response;
-    this->responseLatch.countDown();
-    if (responseCallback != NULL) {
-        responseCallback->onComplete(this->response);
+    if (this->complete(response) && responseCallback != NULL) {
+        responseCallback->onComplete(response);
     }
 }
@@ -26,8 +26,7 @@
 
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/Pointer.h>
-#include <decaf/util/concurrent/Mutex.h>
-#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/CompletableFuture.h>
 #include <decaf/lang/exceptions/InterruptedException.h>
 #include <decaf/io/InterruptedIOException.h>
 
@@ -41,12 +40,15 @@ namespace transport {
      * A container that holds a response object.  Callers of the getResponse
      * method will block until a response has been receive unless they call
      * the getRepsonse that takes a timeout.
+     *
+     * A FutureResponse is also a CompletableFuture for the Response, so rather than
+     * blocking a thread in getResponse the caller can attach listeners and continuations
+     * that run once the response arrives.  The future completes normally for every
+     * Response the broker sends back, ExceptionResponse included.
      */
-    class AMQCPP_API FutureResponse {
+    class AMQCPP_API FutureResponse : public decaf::util::concurrent::CompletableFuture< Pointer<Response> > {
     private:
 
-        mutable decaf::util::concurrent::CountDownLatch responseLatch;
-        Pointer<Response> response;
         Pointer<ResponseCallback> responseCallback;
 
     public:
@@ -63,6 +65,7 @@ namespace transport {
          * @return the response object for the request.
          *
          * @throws InterruptedIOException if the wait for response is interrupted.
+         * @throws IOException if the request was cancelled.
          */
         Pointer<Response> getResponse() const;
         Pointer<Response> getResponse();
@@ -76,12 +79,14 @@ namespace transport {
          * @return the response object for the request
          *
          * @throws InterruptedIOException if the wait for response is interrupted.
+         * @throws IOException if the request was cancelled.
          */
         Pointer<Response> getResponse(unsigned int timeout) const;
         Pointer<Response> getResponse(unsigned int timeout);
 
         /**
-         * Setter for the response property.
+         * Setter for the response property, completes this future and then notifies
+         * the ResponseCallback, if any.
          * @param response the response object for the request.
          */
         void setResponse(Pointer<Response> response);
@@ -24,12 +24,14 @@
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/util/Config.h>
 #include <typeinfo>
+#include <memory>
 
 using namespace activemq;
 using namespace activemq::transport;
 using namespace activemq::exceptions;
 using namespace activemq::commands;
 using namespace activemq::wireformat;
+using namespace activemq::threads;
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::lang;
@@ -56,14 +58,17 @@ namespace transport {
         decaf::io::DataInputStream* inputStream;
         decaf::io::DataOutputStream* outputStream;
         Pointer<decaf::lang::Thread> thread;
+        ThreadPolicy threadPolicy;
         AtomicBoolean closed;
         AtomicBoolean started;
 
-        IOTransportImpl() : wireFormat(), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false) {
+        IOTransportImpl() : wireFormat(), listener(NULL), inputStream(NULL), outputStream(NULL), thread(),
+                            threadPolicy(), closed(false) {
         }
 
         IOTransportImpl(const Pointer<WireFormat> wireFormat) :
-            wireFormat(wireFormat), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false) {
+            wireFormat(wireFormat), listener(NULL), inputStream(NULL), outputStream(NULL), thread(),
+            threadPolicy(), closed(false) {
         }
     };
 
@@ -152,6 +157,46 @@ void IOTransport::oneway(const Pointer<Command> command) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    try {
+
+        if (impl->closed.get()) {
+            throw IOException(__FILE__, __LINE__, "IOTransport::onewayBatch() - transport is closed!");
+        }
+
+        // Make sure the thread has been started.
+        if (impl->thread == NULL) {
+            throw IOException(__FILE__, __LINE__, "IOTransport::onewayBatch() - transport is not started");
+        }
+
+        // Make sure we have an output stream to write to.
+        if (impl->outputStream == NULL) {
+            throw IOException(__FILE__, __LINE__, "IOTransport::onewayBatch() - invalid output stream");
+        }
+
+        synchronized(impl->outputStream) {
+
+            std::auto_ptr< decaf::util::Iterator< Pointer<Command> > > iter(commands.iterator());
+            while (iter->hasNext()) {
+                Pointer<Command> command = iter->next();
+
+                if (command == NULL) {
+                    throw IOException(__FILE__, __LINE__, "IOTransport::onewayBatch() - attempting to write NULL command");
+                }
+
+                this->impl->wireFormat->marshal(command, this, this->impl->outputStream);
+            }
+
+            this->impl->outputStream->flush();
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransport::start() {
 
@@ -170,7 +215,8 @@ void IOTransport::start() {
             }
 
             // Start the polling thread.
-            impl->thread.reset(new Thread(this, "IOTransport reader Thread"));
+            impl->thread.reset(impl->threadPolicy.newThread(
+                ThreadPolicy::TRANSPORT_READER, this, "IOTransport reader Thread"));
             impl->thread->start();
         }
     }
@@ -316,6 +362,22 @@ void IOTransport::setOutputStream(decaf::io::DataOutputStream* os) {
     this->impl->outputStream = os;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setThreadPolicy(const ThreadPolicy& policy) {
+
+    this->impl->threadPolicy = policy;
+
+    Pointer<Thread> thread = this->impl->thread;
+    if (thread != NULL && thread->isAlive()) {
+        policy.apply(ThreadPolicy::TRANSPORT_READER, thread.get());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const ThreadPolicy& IOTransport::getThreadPolicy() const {
+    return this->impl->threadPolicy;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<wireformat::WireFormat> IOTransport::getWireFormat() const {
     return this->impl->wireFormat;
@@ -24,6 +24,7 @@
 #include <activemq/commands/Command.h>
 #include <activemq/commands/Response.h>
 #include <activemq/wireformat/WireFormat.h>
+#include <activemq/threads/ThreadPolicy.h>
 
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Thread.h>
@@ -121,10 +122,33 @@ namespace transport {
          */
         virtual void setOutputStream(decaf::io::DataOutputStream* os);
 
+        /**
+         * Sets the ThreadPolicy whose TRANSPORT_READER settings are applied to the
+         * reader thread.  If the transport is already started the policy is applied
+         * to the running reader thread as well.
+         *
+         * @param policy
+         *      The ThreadPolicy to copy.
+         */
+        void setThreadPolicy(const activemq::threads::ThreadPolicy& policy);
+
+        /**
+         * @return the ThreadPolicy used to configure the reader thread.
+         */
+        const activemq::threads::ThreadPolicy& getThreadPolicy() const;
+
     public:  // Transport methods
 
         virtual void oneway(const Pointer<Command> command);
 
+        /**
+         * {@inheritDoc}
+         *
+         * All commands are marshaled while holding the output stream and the stream
+         * is flushed once at the end of the batch.
+         */
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands);
+
         /**
          * {@inheritDoc}
          *
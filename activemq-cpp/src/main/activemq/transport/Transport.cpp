@@ -17,6 +17,8 @@
 
 #include "Transport.h"
 
+#include <memory>
+
 using namespace activemq;
 using namespace activemq::transport;
 
@@ -24,3 +26,12 @@ using namespace activemq::transport;
 Transport::~Transport() {
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void Transport::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    std::auto_ptr< decaf::util::Iterator< Pointer<Command> > > iter(commands.iterator());
+    while (iter->hasNext()) {
+        this->oneway(iter->next());
+    }
+}
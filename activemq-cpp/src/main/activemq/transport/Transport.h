@@ -90,6 +90,21 @@ namespace transport{
          */
         virtual void oneway(const Pointer<Command> command) = 0;
 
+        /**
+         * Sends a group of one-way commands in the order given.  The outcome is the same
+         * as calling oneway for each command but a Transport that writes to a stream can
+         * write the whole group before it flushes.  The default implementation calls
+         * oneway once per command.
+         *
+         * @param commands
+         *      The commands to be sent.
+         *
+         * @throws IOException if an exception occurs during writing of the commands.
+         * @throws UnsupportedOperationException if this method is not implemented
+         *         by this transport.
+         */
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands);
+
         /**
          * Sends a commands asynchronously, returning a FutureResponse object that the caller
          * can use to check to find out the response from the broker.
@@ -97,9 +112,11 @@ namespace transport{
          * @param command
          *      The Command object that is to sent out.
          * @param responseCallback
-         *      A callback object that will be notified once a response to the command is received.
+         *      A callback object that will be notified once a response to the command is received,
+         *      may be NULL when the caller attaches its continuations to the returned future.
          *
-         * @return A FutureResponse instance that can be queried for the Response to the Command.
+         * @return A FutureResponse instance that can be queried for the Response to the Command,
+         *         or composed with further asynchronous work.
          *
          * @throws IOException if an exception occurs during the read of the command.
          * @throws UnsupportedOperationException if this method is not implemented
@@ -118,6 +118,18 @@ namespace transport {
             next->oneway(command);
         }
 
+        /**
+         * {@inheritDoc}
+         *
+         * The default sends each command through this filter's oneway method, so a filter
+         * that only overrides oneway still sees every command.  Filters that can pass the
+         * whole batch on to the next Transport override this method to do so.
+         */
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+            checkClosed();
+            Transport::onewayBatch(commands);
+        }
+
         virtual Pointer<FutureResponse> asyncRequest(const Pointer<Command> command,
                                                      const Pointer<ResponseCallback> responseCallback) {
             checkClosed();
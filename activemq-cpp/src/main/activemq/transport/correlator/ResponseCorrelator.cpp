@@ -17,11 +17,12 @@
 
 #include "ResponseCorrelator.h"
 #include <algorithm>
+#include <memory>
 
 #include <decaf/util/ArrayList.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
-#include <decaf/util/HashMap.h>
+#include <decaf/util/FlatHashMap.h>
 
 #include <activemq/commands/Response.h>
 #include <activemq/commands/ExceptionResponse.h>
@@ -52,11 +53,11 @@ namespace {
 
         Mutex* mutex;
         int commandId;
-        HashMap<unsigned int, Pointer<FutureResponse> >* map;
+        FlatHashMap<unsigned int, Pointer<FutureResponse> >* map;
 
     public:
 
-        ResponseFinalizer(Mutex* mutex, int commandId, HashMap<unsigned int, Pointer<FutureResponse> >* map) :
+        ResponseFinalizer(Mutex* mutex, int commandId, FlatHashMap<unsigned int, Pointer<FutureResponse> >* map) :
             mutex(mutex), commandId(commandId), map(map) {
         }
 
@@ -82,7 +83,7 @@ namespace correlator{
         decaf::util::concurrent::atomic::AtomicInteger nextCommandId;
 
         // Map of request ids to future response objects.
-        HashMap<unsigned int, Pointer<FutureResponse> > requestMap;
+        FlatHashMap<unsigned int, Pointer<FutureResponse> > requestMap;
 
         // Sync object for accessing the request map.
         decaf::util::concurrent::Mutex mapMutex;
@@ -133,6 +134,29 @@ void ResponseCorrelator::oneway(const Pointer<Command> command) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelator::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    try {
+
+        checkClosed();
+
+        std::auto_ptr< decaf::util::Iterator< Pointer<Command> > > iter(commands.iterator());
+        while (iter->hasNext()) {
+            Pointer<Command> command = iter->next();
+            command->setCommandId(this->impl->nextCommandId.getAndIncrement());
+            command->setResponseRequired(false);
+        }
+
+        next->onewayBatch(commands);
+    }
+    AMQ_CATCH_RETHROW(UnsupportedOperationException)
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<FutureResponse> ResponseCorrelator::asyncRequest(const Pointer<Command> command, const Pointer<ResponseCallback> responseCallback) {
 
@@ -298,18 +322,18 @@ void ResponseCorrelator::onCommand(const Pointer<Command> command) {
     Pointer<Response> response = command.dynamicCast<Response>();
 
     // It is a response - let's correlate ...
+    Pointer<FutureResponse> futureResponse;
     synchronized(&this->impl->mapMutex) {
-
-        Pointer<FutureResponse> futureResponse;
         try {
             futureResponse = this->impl->requestMap.remove(response->getCorrelationId());
         } catch (NoSuchElementException& ex) {
             return;
         }
-
-        // Set the response property in the future response.
-        futureResponse->setResponse(response);
     }
+
+    // Set the response outside the lock, completing the future runs its listeners
+    // and continuations which are free to issue further requests.
+    futureResponse->setResponse(response);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -71,6 +71,8 @@ namespace correlator {
 
         virtual void oneway(const Pointer<Command> command);
 
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands);
+
         virtual Pointer<FutureResponse> asyncRequest(const Pointer<Command> command,
                                                      const Pointer<ResponseCallback> responseCallback);
 
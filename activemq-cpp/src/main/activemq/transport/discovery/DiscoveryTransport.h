@@ -56,6 +56,11 @@ namespace discovery {
 
         virtual void stop();
 
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+            checkClosed();
+            next->onewayBatch(commands);
+        }
+
         /**
          * Sets the Discovery Agent that this transport will use to discover new Brokers.
          *
@@ -254,6 +254,11 @@ bool BackupTransportPool::iterate() {
 
     LinkedList<URI> failures;
 
+    // Probing can take a while so it is done before the backups are locked, the
+    // results are then used by getURI to pick the closest brokers for the backups.
+    Pointer<URIPool> candidates = updates->isEmpty() ? this->uriPool : updates;
+    candidates->probeLatencies();
+
     synchronized(&this->impl->backups) {
 
         Pointer<URIPool> uriPool = this->uriPool;
@@ -375,6 +380,8 @@ Pointer<Transport> BackupTransportPool::createTransport(const URI& location) con
 
         Pointer<Transport> transport(factory->createComposite(location));
 
+        this->parent->applyThreadPolicy(transport);
+
         return transport;
     }
     AMQ_CATCH_RETHROW(IOException)
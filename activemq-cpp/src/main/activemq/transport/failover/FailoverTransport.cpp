@@ -18,25 +18,33 @@
 #include "FailoverTransport.h"
 
 #include <activemq/commands/ConnectionControl.h>
+#include <activemq/commands/Message.h>
 #include <activemq/commands/ShutdownInfo.h>
 #include <activemq/commands/RemoveInfo.h>
 #include <activemq/transport/TransportRegistry.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/threads/DedicatedTaskRunner.h>
 #include <activemq/threads/CompositeTaskRunner.h>
 #include <activemq/transport/failover/BackupTransportPool.h>
 #include <activemq/transport/failover/URIPool.h>
 #include <activemq/transport/failover/FailoverTransportListener.h>
 #include <activemq/transport/failover/CloseTransportsTask.h>
+#include <activemq/transport/failover/MessageSpool.h>
 #include <activemq/transport/failover/URIPool.h>
+#include <decaf/util/ArrayList.h>
 #include <decaf/util/Random.h>
 #include <decaf/util/StringTokenizer.h>
 #include <decaf/util/LinkedList.h>
 #include <decaf/util/StlMap.h>
+#include <decaf/util/Timer.h>
+#include <decaf/util/TimerTask.h>
 #include <decaf/util/concurrent/TimeUnit.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Integer.h>
 
+#include <typeinfo>
+
 using namespace std;
 using namespace activemq;
 using namespace activemq::state;
@@ -87,6 +95,13 @@ namespace failover {
         bool trackTransactionProducers;
         int maxCacheSize;
         int maxPullCacheSize;
+        int restoreBatchSize;
+        std::string spoolFile;
+        long long maxSpoolSize;
+        int spoolSyncEvery;
+        long long spoolSyncInterval;
+        bool latencySelection;
+        bool latencyRebalance;
         bool connectionInterruptProcessingComplete;
         bool firstConnection;
         bool updateURIsSupported;
@@ -97,6 +112,7 @@ namespace failover {
         volatile bool shutdown;
 
         bool doRebalance;
+        bool rebalanceForLatency;
         bool connectedToPrioirty;
 
         mutable Mutex reconnectMutex;
@@ -116,6 +132,10 @@ namespace failover {
         Pointer<CompositeTaskRunner> taskRunner;
         Pointer<TransportListener> disposedListener;
         Pointer<TransportListener> myTransportListener;
+        Pointer<MessageSpool> spool;
+        Pointer<LatencyProbe> latencyProbe;
+        Pointer<Timer> latencyTimer;
+        ThreadPolicy threadPolicy;
 
         TransportListener* transportListener;
 
@@ -137,6 +157,13 @@ namespace failover {
             trackTransactionProducers(true),
             maxCacheSize(128*1024),
             maxPullCacheSize(10),
+            restoreBatchSize(500),
+            spoolFile(),
+            maxSpoolSize(64*1024*1024),
+            spoolSyncEvery(0),
+            spoolSyncInterval(1000),
+            latencySelection(false),
+            latencyRebalance(false),
             connectionInterruptProcessingComplete(false),
             firstConnection(true),
             updateURIsSupported(true),
@@ -146,6 +173,7 @@ namespace failover {
             backupsEnabled(false),
             shutdown(false),
             doRebalance(false),
+            rebalanceForLatency(false),
             connectedToPrioirty(false),
             reconnectMutex(),
             sleepMutex(),
@@ -162,6 +190,10 @@ namespace failover {
             taskRunner(new CompositeTaskRunner()),
             disposedListener(),
             myTransportListener(new FailoverTransportListener(parent)),
+            spool(),
+            latencyProbe(new LatencyProbe()),
+            latencyTimer(),
+            threadPolicy(),
             transportListener(NULL) {
 
             this->backups.reset(
@@ -175,6 +207,62 @@ namespace failover {
             return priorityUris->contains(uri) || uris->isPriority(uri);
         }
 
+        /**
+         * Only plain asynchronous sends are spooled, anything the caller waits on or
+         * that belongs to a transaction must see the outage.
+         */
+        bool isSpoolable(const Pointer<Command> command) const {
+            if (this->spool == NULL || !command->isMessage() || command->isResponseRequired()) {
+                return false;
+            }
+
+            return command.dynamicCast<Message>()->getTransactionId() == NULL;
+        }
+
+        void drainSpool(const Pointer<Transport> transport) {
+            if (this->spool != NULL && !this->spool->isEmpty()) {
+                this->spool->replay(transport, this->restoreBatchSize);
+            }
+        }
+
+        /**
+         * Probes the connected broker along with the candidates and reports whether one
+         * of the candidates answered in less than half the time.
+         */
+        bool hasFasterBroker() {
+
+            Pointer<URI> current;
+            synchronized(&reconnectMutex) {
+                current = connectedTransportURI;
+            }
+
+            if (current == NULL) {
+                return false;
+            }
+
+            LinkedList<URI> candidates;
+            getConnectList()->copyURIs(candidates);
+            if (candidates.isEmpty()) {
+                return false;
+            }
+
+            LinkedList<URI> probed(candidates);
+            probed.add(*current);
+            latencyProbe->probe(probed);
+
+            long long best = LatencyProbe::UNREACHABLE;
+            std::auto_ptr<Iterator<URI> > iter(candidates.iterator());
+            while (iter->hasNext()) {
+                long long latency = latencyProbe->getLatency(iter->next());
+                if (LatencyProbe::isBetter(latency, best)) {
+                    best = latency;
+                }
+            }
+
+            long long latency = latencyProbe->getLatency(*current);
+            return best >= 0 && (latency < 0 || best * 2 < latency);
+        }
+
         Pointer<URIPool> getConnectList() {
             // Pick an appropriate URI pool, updated is always preferred if updates are
             // enabled and we have any, otherwise we fallback to our original list so that
@@ -286,6 +374,38 @@ namespace failover {
     const int FailoverTransportImpl::DEFAULT_INITIAL_RECONNECT_DELAY = 10;
     const int FailoverTransportImpl::INFINITE_WAIT = -1;
 
+    class LatencyRebalanceTask : public TimerTask {
+    private:
+
+        FailoverTransport* parent;
+        FailoverTransportImpl* impl;
+
+    private:
+
+        LatencyRebalanceTask(const LatencyRebalanceTask&);
+        LatencyRebalanceTask& operator= (const LatencyRebalanceTask&);
+
+    public:
+
+        LatencyRebalanceTask(FailoverTransport* parent, FailoverTransportImpl* impl) :
+            TimerTask(), parent(parent), impl(impl) {
+        }
+
+        virtual ~LatencyRebalanceTask() {}
+
+        virtual void run() {
+            try {
+                if (impl->hasFasterBroker()) {
+                    synchronized(&impl->reconnectMutex) {
+                        impl->rebalanceForLatency = true;
+                    }
+                    parent->reconnect(true);
+                }
+            } catch (...) {
+            }
+        }
+    };
+
 }}}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -394,6 +514,16 @@ std::string FailoverTransport::getRemoteAddress() const {
     return "";
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::string FailoverTransport::getConnectedTransportURI() const {
+    synchronized( &this->impl->reconnectMutex ) {
+        if (this->impl->connectedTransportURI != NULL) {
+            return this->impl->connectedTransportURI->toString();
+        }
+    }
+    return "";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void FailoverTransport::oneway(const Pointer<Command> command) {
 
@@ -414,6 +544,11 @@ void FailoverTransport::oneway(const Pointer<Command> command) {
                     // Simulate response to RemoveInfo command or Ack as they will be stale.
                     stateTracker.track(command);
 
+                    // Spooled sends of a removed producer must not outlive it.
+                    if (command->isRemoveInfo() && this->impl->spool != NULL && !this->impl->spool->isEmpty()) {
+                        this->impl->spool->discardSendsFrom(command.dynamicCast<RemoveInfo>()->getObjectId());
+                    }
+
                     if (command->isResponseRequired()) {
                         Pointer<Response> response(new Response());
                         response->setCorrelationId(command->getCommandId());
@@ -431,6 +566,9 @@ void FailoverTransport::oneway(const Pointer<Command> command) {
                         this->impl->myTransportListener->onCommand(dispatch);
                     }
 
+                    return;
+                } else if (this->impl->isSpoolable(command) && this->impl->spool->append(command)) {
+                    // Journaled to disk, it goes out ahead of new sends once reconnected.
                     return;
                 }
             }
@@ -497,6 +635,10 @@ void FailoverTransport::oneway(const Pointer<Command> command) {
 
                     // Send the message.
                     try {
+                        if (command->isMessage()) {
+                            this->impl->drainSpool(transport);
+                        }
+
                         transport->oneway(command);
                         stateTracker.trackBack(command);
                         if (command->isShutdownInfo()) {
@@ -544,6 +686,97 @@ void FailoverTransport::oneway(const Pointer<Command> command) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    ArrayList< Pointer<Command> > remaining;
+
+    try {
+
+        synchronized(&this->impl->reconnectMutex) {
+
+            Pointer<Transport> transport = this->impl->connectedTransport;
+
+            if (transport == NULL || this->impl->closed) {
+                remaining.addAll(commands);
+            } else {
+
+                ArrayList< Pointer<Command> > untracked;
+                bool hasMessage = false;
+
+                std::auto_ptr< Iterator< Pointer<Command> > > iter(commands.iterator());
+                while (iter->hasNext()) {
+                    Pointer<Command> command = iter->next();
+
+                    Pointer<Tracked> tracked = stateTracker.track(command);
+                    synchronized(&this->impl->requestMap) {
+                        if (tracked != NULL && tracked->isWaitingForResponse()) {
+                            this->impl->requestMap.put(command->getCommandId(), tracked);
+                        } else if (tracked == NULL && command->isResponseRequired()) {
+                            this->impl->requestMap.put(command->getCommandId(), command);
+                        }
+                    }
+
+                    if (tracked == NULL) {
+                        untracked.add(command);
+                    }
+                    hasMessage = hasMessage || command->isMessage();
+                }
+
+                try {
+
+                    if (hasMessage) {
+                        this->impl->drainSpool(transport);
+                    }
+
+                    transport->onewayBatch(commands);
+
+                    iter.reset(commands.iterator());
+                    while (iter->hasNext()) {
+                        Pointer<Command> command = iter->next();
+                        stateTracker.trackBack(command);
+                        if (command->isShutdownInfo()) {
+                            this->impl->shutdown = true;
+                        }
+                    }
+
+                } catch (IOException& e) {
+
+                    e.setMark(__FILE__, __LINE__);
+
+                    // As in oneway, the state tracker replays what it tracked once reconnected
+                    // and the rest is sent again, taken out of the request map so that it
+                    // isn't sent twice on recovery.
+                    if (this->impl->canReconnect()) {
+                        iter.reset(untracked.iterator());
+                        while (iter->hasNext()) {
+                            Pointer<Command> command = iter->next();
+                            if (command->isResponseRequired()) {
+                                this->impl->requestMap.remove(command->getCommandId());
+                            }
+                            remaining.add(command);
+                        }
+                    }
+
+                    handleTransportFailure(e);
+                }
+            }
+        }
+
+    } catch (InterruptedException& ex) {
+        Thread::currentThread()->interrupt();
+        throw InterruptedIOException(__FILE__, __LINE__, "FailoverTransport onewayBatch() interrupted");
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+
+    std::auto_ptr< Iterator< Pointer<Command> > > iter(remaining.iterator());
+    while (iter->hasNext()) {
+        this->oneway(iter->next());
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<FutureResponse> FailoverTransport::asyncRequest(const Pointer<Command> command AMQCPP_UNUSED,
                                                         const Pointer<ResponseCallback> responseCallback AMQCPP_UNUSED) {
@@ -580,9 +813,24 @@ void FailoverTransport::start() {
 
             stateTracker.setMaxMessageCacheSize(this->getMaxCacheSize());
             stateTracker.setMaxMessagePullCacheSize(this->getMaxPullCacheSize());
+            stateTracker.setRestoreBatchSize(this->getRestoreBatchSize());
             stateTracker.setTrackMessages(this->isTrackMessages());
             stateTracker.setTrackTransactionProducers(this->isTrackTransactionProducers());
 
+            if (!this->impl->spoolFile.empty() && this->impl->spool == NULL) {
+                this->impl->spool.reset(new MessageSpool(this, this->impl->spoolFile, this->impl->maxSpoolSize));
+                this->impl->spool->setSyncEvery(this->impl->spoolSyncEvery);
+                this->impl->spool->setSyncInterval(this->impl->spoolSyncInterval);
+                this->impl->spool->open();
+            }
+
+            if (this->impl->latencySelection && this->impl->latencyRebalance && this->impl->latencyTimer == NULL) {
+                long long interval = this->impl->latencyProbe->getInterval();
+                this->impl->latencyTimer.reset(new Timer("ActiveMQ Failover Latency Rebalance Timer"));
+                this->impl->latencyTimer->scheduleAtFixedRate(
+                    Pointer<TimerTask>(new LatencyRebalanceTask(this, this->impl)), interval, interval);
+            }
+
             if (this->impl->connectedTransport != NULL) {
                 stateTracker.restore(this->impl->connectedTransport);
             } else {
@@ -615,6 +863,7 @@ void FailoverTransport::close() {
     try {
 
         Pointer<Transport> transportToStop;
+        Pointer<Timer> latencyTimer;
 
         synchronized(&this->impl->reconnectMutex) {
 
@@ -633,9 +882,22 @@ void FailoverTransport::close() {
                 transportToStop.swap(this->impl->connectedTransport);
             }
 
+            if (this->impl->spool != NULL) {
+                this->impl->spool->close();
+                this->impl->spool.reset(NULL);
+            }
+
+            latencyTimer.swap(this->impl->latencyTimer);
+
             this->impl->reconnectMutex.notifyAll();
         }
 
+        // The rebalance task takes the reconnect mutex so its timer is stopped outside it.
+        if (latencyTimer != NULL) {
+            latencyTimer->cancel();
+            latencyTimer.reset(NULL);
+        }
+
         this->impl->backups->close();
 
         synchronized( &this->impl->sleepMutex ) {
@@ -693,10 +955,12 @@ void FailoverTransport::restoreTransport(const Pointer<Transport> transport) {
             commands.copy(this->impl->requestMap);
         }
 
-        Pointer<Iterator<Pointer<Command> > > iter(commands.values().iterator());
-        while (iter->hasNext()) {
-            transport->oneway(iter->next());
+        if (!commands.isEmpty()) {
+            ArrayList<Pointer<Command> > pending(commands.values());
+            transport->onewayBatch(pending);
         }
+
+        this->impl->drainSpool(transport);
     }
     AMQ_CATCH_RETHROW(IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
@@ -895,7 +1159,8 @@ bool FailoverTransport::iterate() {
             } else {
 
                 if (this->impl->doRebalance) {
-                    if (this->impl->connectedToPrioirty || connectList->getPriorityURI().equals(*this->impl->connectedTransportURI)) {
+                    if (!this->impl->rebalanceForLatency && (this->impl->connectedToPrioirty ||
+                        connectList->getPriorityURI().equals(*this->impl->connectedTransportURI))) {
                         // already connected to first in the list, no need to rebalance
                         this->impl->doRebalance = false;
                         return false;
@@ -905,6 +1170,7 @@ bool FailoverTransport::iterate() {
                     }
 
                     this->impl->doRebalance = false;
+                    this->impl->rebalanceForLatency = false;
                 }
 
                 this->impl->resetReconnectDelay();
@@ -939,6 +1205,10 @@ bool FailoverTransport::iterate() {
                     }
                 }
 
+                if (transport == NULL) {
+                    connectList->probeLatencies();
+                }
+
                 while ((transport != NULL || !connectList->isEmpty()) && this->impl->connectedTransport == NULL && !this->impl->closed) {
                     try {
                         // We could be starting the loop with a backup already.
@@ -1067,6 +1337,8 @@ Pointer<Transport> FailoverTransport::createTransport(const URI& location) const
 
         Pointer<Transport> transport(factory->createComposite(location));
 
+        applyThreadPolicy(transport);
+
         return transport;
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -1301,6 +1573,114 @@ void FailoverTransport::setMaxPullCacheSize(int value) {
     this->impl->maxPullCacheSize = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int FailoverTransport::getRestoreBatchSize() const {
+    return this->impl->restoreBatchSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setRestoreBatchSize(int value) {
+    this->impl->restoreBatchSize = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string FailoverTransport::getSpoolFile() const {
+    return this->impl->spoolFile;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setSpoolFile(const std::string& value) {
+    this->impl->spoolFile = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getMaxSpoolSize() const {
+    return this->impl->maxSpoolSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setMaxSpoolSize(long long value) {
+    this->impl->maxSpoolSize = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FailoverTransport::getSpoolSyncEvery() const {
+    return this->impl->spoolSyncEvery;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setSpoolSyncEvery(int value) {
+    this->impl->spoolSyncEvery = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getSpoolSyncInterval() const {
+    return this->impl->spoolSyncInterval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setSpoolSyncInterval(long long value) {
+    this->impl->spoolSyncInterval = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FailoverTransport::isLatencySelection() const {
+    return this->impl->latencySelection;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setLatencySelection(bool value) {
+    this->impl->latencySelection = value;
+
+    Pointer<LatencyProbe> probe;
+    if (value) {
+        probe = this->impl->latencyProbe;
+    }
+
+    this->impl->uris->setLatencyProbe(probe);
+    this->impl->updated->setLatencyProbe(probe);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyProbe::ProbeType FailoverTransport::getLatencyProbeType() const {
+    return this->impl->latencyProbe->getProbeType();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setLatencyProbeType(LatencyProbe::ProbeType value) {
+    this->impl->latencyProbe->setProbeType(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FailoverTransport::getLatencyProbeTimeout() const {
+    return this->impl->latencyProbe->getTimeout();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setLatencyProbeTimeout(int value) {
+    this->impl->latencyProbe->setTimeout(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getLatencyProbeInterval() const {
+    return this->impl->latencyProbe->getInterval();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setLatencyProbeInterval(long long value) {
+    this->impl->latencyProbe->setInterval(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FailoverTransport::isLatencyRebalance() const {
+    return this->impl->latencyRebalance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setLatencyRebalance(bool value) {
+    this->impl->latencyRebalance = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool FailoverTransport::isReconnectSupported() const {
     return this->impl->reconnectSupported;
@@ -1341,6 +1721,30 @@ void FailoverTransport::setPriorityBackup(bool priorityBackup) {
     this->impl->priorityBackup = priorityBackup;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setThreadPolicy(const ThreadPolicy& policy) {
+    this->impl->threadPolicy = policy;
+    this->impl->taskRunner->applyThreadPolicy(policy, ThreadPolicy::FAILOVER);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const ThreadPolicy& FailoverTransport::getThreadPolicy() const {
+    return this->impl->threadPolicy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::applyThreadPolicy(const Pointer<Transport> transport) const {
+
+    if (transport == NULL || this->impl->threadPolicy.isEmpty()) {
+        return;
+    }
+
+    IOTransport* ioTransport = dynamic_cast<IOTransport*>(transport->narrow(typeid(IOTransport)));
+    if (ioTransport != NULL) {
+        ioTransport->setThreadPolicy(this->impl->threadPolicy);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool FailoverTransport::isConnectedToPriority() const {
     return this->impl->connectedToPrioirty;
@@ -24,8 +24,10 @@
 #include <activemq/commands/ConnectionId.h>
 #include <activemq/threads/TaskRunner.h>
 #include <activemq/threads/CompositeTaskRunner.h>
+#include <activemq/threads/ThreadPolicy.h>
 #include <activemq/state/ConnectionStateTracker.h>
 #include <activemq/transport/CompositeTransport.h>
+#include <activemq/transport/failover/LatencyProbe.h>
 #include <activemq/wireformat/WireFormat.h>
 
 #include <decaf/util/List.h>
@@ -102,6 +104,16 @@ namespace failover {
 
         virtual void oneway(const Pointer<Command> command);
 
+        /**
+         * {@inheritDoc}
+         *
+         * While connected the whole batch is tracked and then written to the connected
+         * Transport in one call.  While disconnected, or for the untracked commands of a
+         * batch whose write failed, each command is sent with oneway, which waits for a
+         * reconnect or spools it.
+         */
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands);
+
         virtual Pointer<FutureResponse> asyncRequest(const Pointer<Command> command,
                                                      const Pointer<ResponseCallback> responseCallback);
 
@@ -216,6 +228,122 @@ namespace failover {
 
         void setMaxPullCacheSize(int value);
 
+        int getRestoreBatchSize() const;
+
+        void setRestoreBatchSize(int value);
+
+        /**
+         * @return the path of the file that sends are spooled to while disconnected,
+         *         an empty string means spooling is disabled.
+         */
+        std::string getSpoolFile() const;
+
+        /**
+         * Sets the path of a file that asynchronous, non-transacted message sends are
+         * written to while no Transport is connected instead of blocking the sender.
+         * The spooled messages are sent in order once a connection is restored and any
+         * left over from a previous run are recovered when this transport is started.
+         *
+         * @param value
+         *      The spool file path, or an empty string to disable spooling.
+         */
+        void setSpoolFile(const std::string& value);
+
+        long long getMaxSpoolSize() const;
+
+        /**
+         * Sets the maximum size in bytes of the spool file, once it is full senders
+         * block waiting for a connection as they do when spooling is disabled.
+         *
+         * @param value
+         *      The maximum size of the spool file in bytes.
+         */
+        void setMaxSpoolSize(long long value);
+
+        int getSpoolSyncEvery() const;
+
+        /**
+         * Sets how many spooled sends may be written before the spool file is forced to
+         * disk, one forces every send and zero (the default) leaves it to the interval.
+         *
+         * @param value
+         *      The number of sends spooled between syncs, or zero.
+         */
+        void setSpoolSyncEvery(int value);
+
+        long long getSpoolSyncInterval() const;
+
+        /**
+         * Sets the time in milliseconds after which spooling a send forces the spool file
+         * to disk, bounding the sends lost if the machine fails during an outage.  The
+         * default is one second, zero together with a zero sync count never syncs and
+         * only survives a crash of the process.
+         *
+         * @param value
+         *      The longest time in milliseconds between syncs while spooling, or zero.
+         */
+        void setSpoolSyncInterval(long long value);
+
+        bool isLatencySelection() const;
+
+        /**
+         * Sets whether reconnects and backups go to the broker with the lowest measured
+         * latency instead of taking the URIs in order or at random.  The candidate URIs
+         * are probed in parallel before a connect attempt whenever the previous results
+         * are older than the probe interval.  Brokers whose probe failed are tried last.
+         * With priorityBackup enabled a priority broker is still preferred over a
+         * faster one.
+         *
+         * @param value
+         *      True to select brokers by latency.
+         */
+        void setLatencySelection(bool value);
+
+        LatencyProbe::ProbeType getLatencyProbeType() const;
+
+        /**
+         * Sets how broker latency is measured, CONNECT times a TCP connect and
+         * WIREFORMAT also waits for the broker's WireFormatInfo.
+         *
+         * @param value
+         *      The kind of probe to use.
+         */
+        void setLatencyProbeType(LatencyProbe::ProbeType value);
+
+        int getLatencyProbeTimeout() const;
+
+        /**
+         * Sets the time in milliseconds a probe may take before its broker is treated
+         * as unreachable.
+         *
+         * @param value
+         *      The probe timeout in milliseconds.
+         */
+        void setLatencyProbeTimeout(int value);
+
+        long long getLatencyProbeInterval() const;
+
+        /**
+         * Sets how long in milliseconds probe results are reused before the brokers are
+         * probed again, this is also the period of the rebalance check.
+         *
+         * @param value
+         *      The probe interval in milliseconds.
+         */
+        void setLatencyProbeInterval(long long value);
+
+        bool isLatencyRebalance() const;
+
+        /**
+         * Sets whether a connected transport re-probes the brokers every probe interval
+         * and moves to another broker when it answers in less than half the time of the
+         * current one.  Only applies when latency selection is enabled.
+         *
+         * @param value
+         *      True to rebalance by latency.
+         */
+        void setLatencyRebalance(bool value);
+
         bool isReconnectSupported() const;
 
         void setReconnectSupported(bool value);
@@ -240,6 +368,33 @@ namespace failover {
 
         bool isConnectedToPriority() const;
 
+        /**
+         * @return the URI of the broker this transport is connected to, or an empty
+         *         string when it is not connected.
+         */
+        std::string getConnectedTransportURI() const;
+
+        /**
+         * Sets the ThreadPolicy used for the failover task thread and for the reader
+         * thread of every transport that this transport connects or keeps as a backup.
+         * The policy should be assigned before the transport is started.
+         *
+         * @param policy
+         *      The ThreadPolicy to copy.
+         */
+        void setThreadPolicy(const activemq::threads::ThreadPolicy& policy);
+
+        const activemq::threads::ThreadPolicy& getThreadPolicy() const;
+
+        /**
+         * Applies the TRANSPORT_READER settings of this transport's ThreadPolicy to the
+         * given transport if it is backed by an IOTransport.
+         *
+         * @param transport
+         *      A newly created transport that has not yet been started.
+         */
+        void applyThreadPolicy(const Pointer<Transport> transport) const;
+
     protected:
 
         /**
@@ -103,11 +103,31 @@ Pointer<Transport> FailoverTransportFactory::doCreateComposite(const decaf::net:
             Integer::parseInt(topLvlProperties.getProperty("maxCacheSize", "131072")));
         transport->setMaxPullCacheSize(
             Integer::parseInt(topLvlProperties.getProperty("maxPullCacheSize", "10")));
+        transport->setRestoreBatchSize(
+            Integer::parseInt(topLvlProperties.getProperty("restoreBatchSize", "500")));
+        transport->setSpoolFile(topLvlProperties.getProperty("spoolFile", ""));
+        transport->setMaxSpoolSize(
+            Long::parseLong(topLvlProperties.getProperty("maxSpoolSize", "67108864")));
+        transport->setSpoolSyncEvery(
+            Integer::parseInt(topLvlProperties.getProperty("spoolSyncEvery", "0")));
+        transport->setSpoolSyncInterval(
+            Long::parseLong(topLvlProperties.getProperty("spoolSyncInterval", "1000")));
         transport->setUpdateURIsSupported(
             Boolean::parseBoolean(topLvlProperties.getProperty("updateURIsSupported", "true")));
         transport->setPriorityBackup(
             Boolean::parseBoolean(topLvlProperties.getProperty("priorityBackup", "false")));
         transport->setPriorityURIs(topLvlProperties.getProperty("priorityURIs", ""));
+        transport->setLatencySelection(
+            Boolean::parseBoolean(topLvlProperties.getProperty("latencySelection", "false")));
+        transport->setLatencyProbeType(
+            topLvlProperties.getProperty("latencyProbe", "connect") == "wireformat" ?
+                LatencyProbe::WIREFORMAT : LatencyProbe::CONNECT);
+        transport->setLatencyProbeTimeout(
+            Integer::parseInt(topLvlProperties.getProperty("latencyProbeTimeout", "1000")));
+        transport->setLatencyProbeInterval(
+            Long::parseLong(topLvlProperties.getProperty("latencyProbeInterval", "30000")));
+        transport->setLatencyRebalance(
+            Boolean::parseBoolean(topLvlProperties.getProperty("latencyRebalance", "false")));
 
         transport->addURI(false, data.getComponents());
 
@@ -0,0 +1,310 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyProbe.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/io/InputStream.h>
+#include <decaf/net/Socket.h>
+#include <decaf/util/Iterator.h>
+#include <decaf/util/StlMap.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <memory>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::transport;
+using namespace activemq::transport::failover;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::net;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    class LatencyProbeImpl {
+    private:
+
+        LatencyProbeImpl(const LatencyProbeImpl&);
+        LatencyProbeImpl& operator=(const LatencyProbeImpl&);
+
+    public:
+
+        Mutex mutex;
+        StlMap<std::string, long long> latencies;
+        StlMap<std::string, std::string> failures;
+        LatencyProbe::ProbeType type;
+        int timeout;
+        long long interval;
+        long long lastProbe;
+
+        LatencyProbeImpl() : mutex(), latencies(), failures(), type(LatencyProbe::CONNECT), timeout(1000),
+                             interval(30000), lastProbe(-1) {
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ProbeTask : public Runnable {
+    private:
+
+        ProbeTask(const ProbeTask&);
+        ProbeTask& operator=(const ProbeTask&);
+
+    public:
+
+        URI uri;
+        LatencyProbe::ProbeType type;
+        int timeout;
+        long long latency;
+        std::string failure;
+
+        ProbeTask(const URI& uri, LatencyProbe::ProbeType type, int timeout) :
+            uri(uri), type(type), timeout(timeout), latency(LatencyProbe::UNREACHABLE), failure() {
+        }
+
+        virtual ~ProbeTask() {}
+
+        virtual void run() {
+
+            long long start = System::nanoTime();
+
+            try {
+                Socket socket;
+                socket.connect(uri.getHost(), uri.getPort(), timeout);
+
+                // The broker speaks first on a plain OpenWire connection, any other
+                // protocol waits on the client so only the connect can be timed.
+                if (type == LatencyProbe::WIREFORMAT && uri.getScheme() == "tcp") {
+                    socket.setSoTimeout(timeout);
+                    if (socket.getInputStream()->read() == -1) {
+                        failure = "Connection closed before the broker sent its WireFormatInfo";
+                        return;
+                    }
+                }
+
+                latency = (System::nanoTime() - start) / 1000;
+                socket.close();
+            } catch (Exception& ex) {
+                latency = LatencyProbe::UNREACHABLE;
+                failure = ex.getMessage();
+            } catch (std::exception& ex) {
+                latency = LatencyProbe::UNREACHABLE;
+                failure = ex.what();
+            } catch (...) {
+                latency = LatencyProbe::UNREACHABLE;
+                failure = "Unknown error";
+            }
+
+            if (latency == LatencyProbe::UNREACHABLE && failure.empty()) {
+                failure = "Probe failed";
+            }
+        }
+    };
+
+    bool isProbeable(const URI& uri) {
+        return !uri.getHost().empty() && uri.getPort() > 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const long long LatencyProbe::UNKNOWN = -1;
+const long long LatencyProbe::UNREACHABLE = -2;
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyProbe::LatencyProbe() : impl(new LatencyProbeImpl()) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyProbe::~LatencyProbe() {
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbe::probe(const List<URI>& uris) {
+
+    ProbeType type;
+    int timeout;
+
+    synchronized(&this->impl->mutex) {
+        type = this->impl->type;
+        timeout = this->impl->timeout;
+    }
+
+    std::vector<ProbeTask*> tasks;
+    std::vector<Thread*> threads;
+
+    std::auto_ptr<Iterator<URI> > iter(uris.iterator());
+    while (iter->hasNext()) {
+        URI uri = iter->next();
+        if (isProbeable(uri)) {
+            tasks.push_back(new ProbeTask(uri, type, timeout));
+        }
+    }
+
+    try {
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            threads.push_back(new Thread(tasks[i], "ActiveMQ Latency Probe: " + tasks[i]->uri.toString()));
+            threads.back()->start();
+        }
+
+        // Every probe is bounded by the timeout, so the joins are too.
+        for (std::size_t i = 0; i < threads.size(); ++i) {
+            threads[i]->join();
+        }
+    } catch (...) {
+    }
+
+    synchronized(&this->impl->mutex) {
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            std::string key = tasks[i]->uri.toString();
+            this->impl->latencies.put(key, tasks[i]->latency);
+            if (tasks[i]->failure.empty()) {
+                if (this->impl->failures.containsKey(key)) {
+                    this->impl->failures.remove(key);
+                }
+            } else {
+                this->impl->failures.put(key, tasks[i]->failure);
+            }
+        }
+        this->impl->lastProbe = System::currentTimeMillis();
+    }
+
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        delete threads[i];
+    }
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        delete tasks[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool LatencyProbe::isStale() const {
+    synchronized(&this->impl->mutex) {
+        return this->impl->lastProbe < 0 ||
+               System::currentTimeMillis() - this->impl->lastProbe >= this->impl->interval;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LatencyProbe::getLatency(const URI& uri) const {
+    synchronized(&this->impl->mutex) {
+        std::string key = uri.toString();
+        if (this->impl->latencies.containsKey(key)) {
+            return this->impl->latencies.get(key);
+        }
+    }
+
+    return UNKNOWN;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string LatencyProbe::getFailure(const URI& uri) const {
+    synchronized(&this->impl->mutex) {
+        std::string key = uri.toString();
+        if (this->impl->failures.containsKey(key)) {
+            return this->impl->failures.get(key);
+        }
+    }
+
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbe::setLatency(const URI& uri, long long latency) {
+    synchronized(&this->impl->mutex) {
+        std::string key = uri.toString();
+        this->impl->latencies.put(key, latency);
+        if (this->impl->failures.containsKey(key)) {
+            this->impl->failures.remove(key);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool LatencyProbe::isBetter(long long latency, long long other) {
+
+    if (latency >= 0) {
+        return other < 0 || latency < other;
+    }
+
+    return latency == UNKNOWN && other == UNREACHABLE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyProbe::ProbeType LatencyProbe::getProbeType() const {
+    synchronized(&this->impl->mutex) {
+        return this->impl->type;
+    }
+
+    return CONNECT;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbe::setProbeType(ProbeType type) {
+    synchronized(&this->impl->mutex) {
+        this->impl->type = type;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LatencyProbe::getTimeout() const {
+    synchronized(&this->impl->mutex) {
+        return this->impl->timeout;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbe::setTimeout(int timeout) {
+    synchronized(&this->impl->mutex) {
+        this->impl->timeout = timeout;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LatencyProbe::getInterval() const {
+    synchronized(&this->impl->mutex) {
+        return this->impl->interval;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbe::setInterval(long long interval) {
+    synchronized(&this->impl->mutex) {
+        this->impl->interval = interval;
+    }
+}
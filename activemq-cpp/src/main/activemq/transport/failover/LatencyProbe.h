@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_FAILOVER_LATENCYPROBE_H_
+#define _ACTIVEMQ_TRANSPORT_FAILOVER_LATENCYPROBE_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/net/URI.h>
+#include <decaf/util/List.h>
+
+#include <string>
+
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    class LatencyProbeImpl;
+
+    /**
+     * Measures how far away each of a set of broker URIs is so that a URIPool can
+     * prefer the closest one.  All the URIs are probed in parallel and the results
+     * are kept until the probe interval has passed.
+     *
+     * Two kinds of probe are supported, CONNECT times a TCP connect to the URI's host
+     * and port while WIREFORMAT also waits for the first bytes of the WireFormatInfo
+     * that an OpenWire broker sends once it accepts a connection, so a broker that is
+     * accepting sockets but is too busy to service them looks as slow as it is.  The
+     * WIREFORMAT probe only applies to plain tcp URIs, other socket based schemes are
+     * timed on the connect alone.  URIs without a host and port, mock or vm URIs for
+     * instance, are never probed and are reported as UNKNOWN.
+     *
+     * The CONNECT probe measures the network round trip and nothing more: the TCP
+     * handshake is completed by the broker host's kernel from its listen backlog
+     * before the broker accepts the socket, so a broker that is slow to accept or to
+     * service new connections looks just as close as an idle one.  Use WIREFORMAT
+     * where that matters.
+     *
+     * A probe that fails records the URI as UNREACHABLE along with the reason, see
+     * getFailure.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API LatencyProbe {
+    public:
+
+        enum ProbeType {
+            CONNECT,
+            WIREFORMAT
+        };
+
+        /**
+         * Latency reported for a URI that has not been probed or cannot be.
+         */
+        static const long long UNKNOWN;
+
+        /**
+         * Latency reported for a URI whose last probe failed or timed out.
+         */
+        static const long long UNREACHABLE;
+
+    private:
+
+        LatencyProbeImpl* impl;
+
+    private:
+
+        LatencyProbe(const LatencyProbe&);
+        LatencyProbe& operator=(const LatencyProbe&);
+
+    public:
+
+        LatencyProbe();
+
+        virtual ~LatencyProbe();
+
+        /**
+         * Probes all the given URIs in parallel and records the results, blocks until
+         * every probe has completed or timed out.
+         *
+         * @param uris
+         *      The URIs to probe.
+         */
+        void probe(const decaf::util::List<decaf::net::URI>& uris);
+
+        /**
+         * @return true if the probe interval has passed since the last call to probe.
+         */
+        bool isStale() const;
+
+        /**
+         * Gets the latency last measured for the given URI.
+         *
+         * @param uri
+         *      The URI whose latency is wanted.
+         *
+         * @return the latency in microseconds, or UNKNOWN or UNREACHABLE.
+         */
+        long long getLatency(const decaf::net::URI& uri) const;
+
+        /**
+         * Gets the reason the last probe of the given URI failed.
+         *
+         * @param uri
+         *      The URI whose probe result is wanted.
+         *
+         * @return the error from the last probe if it left the URI UNREACHABLE, or an
+         *         empty string if it succeeded or the URI was not probed.
+         */
+        std::string getFailure(const decaf::net::URI& uri) const;
+
+        /**
+         * Records the latency of a URI as if it had been probed.
+         *
+         * @param uri
+         *      The URI whose latency is being recorded.
+         * @param latency
+         *      The latency in microseconds, or UNKNOWN or UNREACHABLE.
+         */
+        void setLatency(const decaf::net::URI& uri, long long latency);
+
+        /**
+         * Compares two latencies as reported by getLatency, any measured latency is
+         * better than UNKNOWN which in turn is better than UNREACHABLE.
+         *
+         * @return true if the first latency is better than the second.
+         */
+        static bool isBetter(long long latency, long long other);
+
+        ProbeType getProbeType() const;
+
+        void setProbeType(ProbeType type);
+
+        /**
+         * @return the time in milliseconds that each probe is allowed before the URI
+         *         is considered unreachable.
+         */
+        int getTimeout() const;
+
+        void setTimeout(int timeout);
+
+        /**
+         * @return the time in milliseconds that probe results are considered current.
+         */
+        long long getInterval() const;
+
+        void setInterval(long long interval);
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_FAILOVER_LATENCYPROBE_H_ */
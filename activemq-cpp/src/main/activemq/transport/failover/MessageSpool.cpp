@@ -0,0 +1,594 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageSpool.h"
+
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/commands/ConnectionId.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/SessionId.h>
+#include <decaf/io/File.h>
+#include <decaf/io/FileInputStream.h>
+#include <decaf/io/FileOutputStream.h>
+#include <decaf/io/BufferedInputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/EOFException.h>
+#include <decaf/lang/ArrayPointer.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/Properties.h>
+#include <decaf/util/StlSet.h>
+#include <decaf/util/zip/CRC32.h>
+
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace activemq::transport;
+using namespace activemq::transport::failover;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::zip;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int SPOOL_MAGIC = 0x414D5153;
+    const int SPOOL_FORMAT_VERSION = 1;
+    const int SPOOL_HEADER_SIZE = 12;
+    const int RECORD_HEADER_SIZE = 12;
+    const int COPY_BUFFER_SIZE = 8192;
+
+    long long checksum(const unsigned char* buffer, int length) {
+        CRC32 crc;
+        crc.update(buffer, length, 0, length);
+        return crc.getValue();
+    }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    class MessageSpoolImpl {
+    private:
+
+        MessageSpoolImpl(const MessageSpoolImpl&);
+        MessageSpoolImpl& operator=(const MessageSpoolImpl&);
+
+    public:
+
+        const Transport* owner;
+        std::string fileName;
+        long long maxSize;
+        Pointer<OpenWireFormat> format;
+        Pointer<FileOutputStream> out;
+        int records;
+        long long fileSize;
+        int syncEvery;
+        long long syncInterval;
+        int unsynced;
+        long long lastSync;
+
+        // Keys of the producers, sessions and connections removed since the last replay.
+        StlSet<std::string> removed;
+
+        MessageSpoolImpl(const Transport* owner, const std::string& fileName, long long maxSize) :
+            owner(owner), fileName(fileName), maxSize(maxSize), format(), out(), records(0), fileSize(0),
+            syncEvery(0), syncInterval(0), unsynced(0), lastSync(0), removed() {
+
+            Properties properties;
+            this->format.reset(new OpenWireFormat(properties));
+        }
+
+        void sync() {
+            this->out->sync();
+            this->unsynced = 0;
+            this->lastSync = System::currentTimeMillis();
+        }
+
+        void syncIfDue() {
+            if (this->syncEvery > 0 && this->unsynced >= this->syncEvery) {
+                sync();
+            } else if (this->syncInterval > 0 &&
+                       System::currentTimeMillis() - this->lastSync >= this->syncInterval) {
+                sync();
+            }
+        }
+
+        static std::string keyOf(const Pointer<ProducerId>& id) {
+            return "P:" + id->toString();
+        }
+
+        static std::string keyOf(const Pointer<SessionId>& id) {
+            return "S:" + id->toString();
+        }
+
+        static std::string keyOf(const Pointer<ConnectionId>& id) {
+            return "C:" + id->toString();
+        }
+
+        bool isDiscarded(const Pointer<Command>& command) const {
+
+            if (this->removed.isEmpty() || !command->isMessage()) {
+                return false;
+            }
+
+            Pointer<Message> message = command.staticCast<Message>();
+            Pointer<ProducerId> producerId = message->getProducerId();
+            if (producerId == NULL && message->getMessageId() != NULL) {
+                producerId = message->getMessageId()->getProducerId();
+            }
+
+            if (producerId == NULL) {
+                return false;
+            }
+
+            const Pointer<SessionId>& sessionId = producerId->getParentId();
+
+            return this->removed.contains(keyOf(producerId)) ||
+                   this->removed.contains(keyOf(sessionId)) ||
+                   this->removed.contains(keyOf(sessionId->getParentId()));
+        }
+
+        void writeHeader() {
+            ByteArrayOutputStream bytes;
+            DataOutputStream header(&bytes);
+            header.writeInt(SPOOL_MAGIC);
+            header.writeInt(SPOOL_FORMAT_VERSION);
+            header.writeInt(this->format->getVersion());
+            header.flush();
+
+            std::pair<unsigned char*, int> array = bytes.toByteArray();
+            ArrayPointer<unsigned char> finalizer(array.first, array.second);
+            this->out->write(array.first, array.second, 0, array.second);
+            this->out->flush();
+            this->fileSize = SPOOL_HEADER_SIZE;
+        }
+
+        bool readHeader(DataInputStream& in) {
+            try {
+                int magic = in.readInt();
+                int version = in.readInt();
+                int wireFormatVersion = in.readInt();
+
+                if (magic != SPOOL_MAGIC) {
+                    throw IOException(__FILE__, __LINE__,
+                        "File %s is not a message spool.", this->fileName.c_str());
+                }
+
+                if (version != SPOOL_FORMAT_VERSION) {
+                    throw IOException(__FILE__, __LINE__,
+                        "Message spool %s has unsupported format version %d.", this->fileName.c_str(), version);
+                }
+
+                this->format->setVersion(wireFormatVersion);
+            } catch (EOFException& ex) {
+                return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * Reads the next record into the payload buffer, returns false if there is no
+         * complete record with a matching checksum at the current position.
+         */
+        bool readRecord(DataInputStream& in, long long remaining, std::vector<unsigned char>& payload) {
+            try {
+                if (remaining < RECORD_HEADER_SIZE) {
+                    return false;
+                }
+
+                int length = in.readInt();
+                long long crc = in.readLong();
+
+                if (length <= 0 || length > remaining - RECORD_HEADER_SIZE) {
+                    return false;
+                }
+
+                payload.resize(length);
+                in.readFully(&payload[0], length);
+
+                return checksum(&payload[0], length) == crc;
+            } catch (EOFException& ex) {
+                return false;
+            }
+        }
+
+        void truncate(long long validLength) {
+
+            std::string tempName = this->fileName + ".tmp";
+
+            {
+                FileInputStream source(this->fileName);
+                FileOutputStream target(tempName);
+
+                std::vector<unsigned char> buffer(COPY_BUFFER_SIZE);
+                long long remaining = validLength;
+                while (remaining > 0) {
+                    int chunk = remaining > COPY_BUFFER_SIZE ? COPY_BUFFER_SIZE : (int) remaining;
+                    int count = source.read(&buffer[0], COPY_BUFFER_SIZE, 0, chunk);
+                    if (count == -1) {
+                        break;
+                    }
+                    target.write(&buffer[0], COPY_BUFFER_SIZE, 0, count);
+                    remaining -= count;
+                }
+
+                target.flush();
+            }
+
+            File temp(tempName);
+            if (!temp.renameTo(File(this->fileName))) {
+                throw IOException(__FILE__, __LINE__,
+                    "Failed to truncate damaged message spool %s.", this->fileName.c_str());
+            }
+        }
+
+        void recover() {
+
+            long long length = File(this->fileName).length();
+            long long validLength = SPOOL_HEADER_SIZE;
+            int valid = 0;
+
+            {
+                FileInputStream file(this->fileName);
+                BufferedInputStream buffered(&file);
+                DataInputStream in(&buffered);
+
+                if (!readHeader(in)) {
+                    // A crash while the header was written, nothing can have been spooled yet.
+                    this->out.reset(new FileOutputStream(this->fileName, false));
+                    writeHeader();
+                    this->records = 0;
+                    return;
+                }
+
+                std::vector<unsigned char> payload;
+                while (readRecord(in, length - validLength, payload)) {
+                    validLength += RECORD_HEADER_SIZE + (long long) payload.size();
+                    valid++;
+                }
+            }
+
+            if (validLength < length) {
+                truncate(validLength);
+            }
+
+            this->out.reset(new FileOutputStream(this->fileName, true));
+            this->records = valid;
+            this->fileSize = validLength;
+        }
+
+        int replay(const Pointer<Transport> transport, int batchSize) {
+
+            if (batchSize < 1) {
+                batchSize = 1;
+            }
+
+            int sent = 0;
+            ArrayList<Pointer<Command> > batch;
+
+            FileInputStream file(this->fileName);
+            BufferedInputStream buffered(&file);
+            DataInputStream in(&buffered);
+
+            readHeader(in);
+
+            long long position = SPOOL_HEADER_SIZE;
+            std::vector<unsigned char> payload;
+            for (int i = 0; i < this->records; ++i) {
+
+                // Nothing after a damaged record can be trusted, as with recover the
+                // spool ends there and the good records ahead of it still go out.
+                if (!readRecord(in, this->fileSize - position, payload)) {
+                    break;
+                }
+
+                position += RECORD_HEADER_SIZE + (long long) payload.size();
+
+                ByteArrayInputStream bytes(&payload[0], (int) payload.size());
+                DataInputStream record(&bytes);
+                Pointer<Command> command = this->format->unmarshal(this->owner, &record);
+
+                if (isDiscarded(command)) {
+                    continue;
+                }
+
+                batch.add(command);
+
+                if (batch.size() >= batchSize) {
+                    sendBatch(transport, batch);
+                    sent += batch.size();
+                    batch.clear();
+                }
+            }
+
+            if (!batch.isEmpty()) {
+                sendBatch(transport, batch);
+                sent += batch.size();
+            }
+
+            return sent;
+        }
+
+        void sendBatch(const Pointer<Transport> transport, ArrayList<Pointer<Command> >& batch) {
+            if (batch.size() == 1) {
+                transport->oneway(batch.get(0));
+            } else {
+                transport->onewayBatch(batch);
+            }
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageSpool::MessageSpool(const Transport* owner, const std::string& fileName, long long maxSize) :
+    impl(new MessageSpoolImpl(owner, fileName, maxSize)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageSpool::~MessageSpool() {
+    try {
+        close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::open() {
+
+    try {
+
+        if (this->impl->out != NULL) {
+            return;
+        }
+
+        if (File(this->impl->fileName).exists()) {
+            this->impl->recover();
+        } else {
+            this->impl->out.reset(new FileOutputStream(this->impl->fileName, false));
+            this->impl->writeHeader();
+            this->impl->records = 0;
+        }
+
+        this->impl->unsynced = 0;
+        this->impl->lastSync = System::currentTimeMillis();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::close() {
+
+    try {
+
+        Pointer<FileOutputStream> out;
+        out.swap(this->impl->out);
+
+        if (out != NULL) {
+            // With a sync policy set, records still waiting for a sync get one now.
+            if (this->impl->unsynced > 0 &&
+                (this->impl->syncEvery > 0 || this->impl->syncInterval > 0)) {
+                out->sync();
+                this->impl->unsynced = 0;
+            }
+
+            out->close();
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MessageSpool::append(const Pointer<Command> command) {
+
+    try {
+
+        if (this->impl->out == NULL) {
+            throw IOException(__FILE__, __LINE__, "Message spool %s is not open.", this->impl->fileName.c_str());
+        }
+
+        ByteArrayOutputStream payloadBytes;
+        DataOutputStream payloadOut(&payloadBytes);
+        this->impl->format->marshal(command, this->impl->owner, &payloadOut);
+        payloadOut.flush();
+
+        std::pair<unsigned char*, int> payload = payloadBytes.toByteArray();
+        ArrayPointer<unsigned char> payloadFinalizer(payload.first, payload.second);
+
+        if (this->impl->fileSize + RECORD_HEADER_SIZE + payload.second > this->impl->maxSize) {
+            return false;
+        }
+
+        // Build the whole record first so that it reaches the file in a single write.
+        ByteArrayOutputStream recordBytes(RECORD_HEADER_SIZE + payload.second);
+        DataOutputStream recordOut(&recordBytes);
+        recordOut.writeInt(payload.second);
+        recordOut.writeLong(checksum(payload.first, payload.second));
+        recordOut.write(payload.first, payload.second, 0, payload.second);
+        recordOut.flush();
+
+        std::pair<unsigned char*, int> record = recordBytes.toByteArray();
+        ArrayPointer<unsigned char> recordFinalizer(record.first, record.second);
+
+        this->impl->out->write(record.first, record.second, 0, record.second);
+        this->impl->out->flush();
+
+        this->impl->fileSize += record.second;
+        this->impl->records++;
+        this->impl->unsynced++;
+
+        this->impl->syncIfDue();
+
+        return true;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageSpool::replay(const Pointer<Transport> transport, int batchSize) {
+
+    try {
+
+        if (this->impl->out == NULL) {
+            throw IOException(__FILE__, __LINE__, "Message spool %s is not open.", this->impl->fileName.c_str());
+        }
+
+        if (this->impl->records == 0) {
+            return 0;
+        }
+
+        int sent = 0;
+
+        this->impl->out->close();
+        this->impl->out.reset(NULL);
+
+        try {
+            sent = this->impl->replay(transport, batchSize);
+        } catch (...) {
+            this->impl->out.reset(new FileOutputStream(this->impl->fileName, true));
+            throw;
+        }
+
+        // Everything went out, start the journal over from an empty file.
+        this->impl->out.reset(new FileOutputStream(this->impl->fileName, false));
+        this->impl->writeHeader();
+        this->impl->records = 0;
+        this->impl->unsynced = 0;
+        this->impl->removed.clear();
+
+        return sent;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::sync() {
+
+    try {
+
+        if (this->impl->out == NULL) {
+            throw IOException(__FILE__, __LINE__, "Message spool %s is not open.", this->impl->fileName.c_str());
+        }
+
+        this->impl->sync();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::discardSendsFrom(const Pointer<DataStructure> removedId) {
+
+    if (removedId == NULL) {
+        return;
+    }
+
+    switch (removedId->getDataStructureType()) {
+        case ProducerId::ID_PRODUCERID:
+            this->impl->removed.add(MessageSpoolImpl::keyOf(removedId.dynamicCast<ProducerId>()));
+            break;
+        case SessionId::ID_SESSIONID:
+            this->impl->removed.add(MessageSpoolImpl::keyOf(removedId.dynamicCast<SessionId>()));
+            break;
+        case ConnectionId::ID_CONNECTIONID:
+            this->impl->removed.add(MessageSpoolImpl::keyOf(removedId.dynamicCast<ConnectionId>()));
+            break;
+        default:
+            break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MessageSpool::isEmpty() const {
+    return this->impl->records == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageSpool::size() const {
+    return this->impl->records;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MessageSpool::getFileSize() const {
+    return this->impl->fileSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MessageSpool::getFileName() const {
+    return this->impl->fileName;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MessageSpool::getMaxSize() const {
+    return this->impl->maxSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MessageSpool::isOpen() const {
+    return this->impl->out != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageSpool::getSyncEvery() const {
+    return this->impl->syncEvery;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::setSyncEvery(int records) {
+    this->impl->syncEvery = records < 0 ? 0 : records;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MessageSpool::getSyncInterval() const {
+    return this->impl->syncInterval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::setSyncInterval(long long interval) {
+    this->impl->syncInterval = interval < 0 ? 0 : interval;
+}
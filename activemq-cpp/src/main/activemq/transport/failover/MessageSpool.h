@@ -0,0 +1,232 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_FAILOVER_MESSAGESPOOL_H_
+#define _ACTIVEMQ_TRANSPORT_FAILOVER_MESSAGESPOOL_H_
+
+#include <activemq/util/Config.h>
+
+#include <activemq/commands/Command.h>
+#include <activemq/commands/DataStructure.h>
+#include <activemq/transport/Transport.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/io/IOException.h>
+
+#include <string>
+
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    using decaf::lang::Pointer;
+
+    class MessageSpoolImpl;
+
+    /**
+     * An append only journal of Commands that the FailoverTransport writes to while it
+     * has no connected Transport.  Each record is stored in OpenWire form along with a
+     * length and a CRC32 checksum so that a partially written record left behind by a
+     * crash can be detected and discarded when the spool is next opened.
+     *
+     * The spool is bounded, once appending a record would grow the file past the
+     * configured maximum size the append is refused and the caller must fall back to
+     * some other means of handling the Command.
+     *
+     * Appended records are flushed to the operating system at once but only forced to
+     * the storage device according to the sync policy, see setSyncEvery and
+     * setSyncInterval.  A spool with neither set never syncs on its own, which survives
+     * a crash of the process but not of the machine.  The FailoverTransport sets a one
+     * second interval unless configured otherwise, see its spoolSyncInterval option.
+     *
+     * Records are replayed in the order they were appended.  Replay is at least once,
+     * if the process dies during a replay the records are sent again on the next one
+     * and the broker's duplicate detection removes the copies it already has.  Sends
+     * from producers that were removed while the records waited are dropped, see
+     * discardSendsFrom.  A record that can no longer be read ends the replay the same
+     * way a damaged tail ends recovery in open, it and the records after it are lost.
+     *
+     * Records left behind by an earlier process are replayed as they were written, with
+     * the ConnectionId and ProducerId of that process.  The broker was never told of
+     * that connection or its producers, whether it accepts such sends is up to the
+     * broker.  Their message ids can not clash with those of the new connection, so
+     * duplicate detection only removes copies the broker already took under the old
+     * ids, and discardSendsFrom never matches them since the new connection only
+     * removes its own producers.
+     *
+     * This class is not thread safe, the owner must serialize access to it.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API MessageSpool {
+    private:
+
+        MessageSpoolImpl* impl;
+
+    private:
+
+        MessageSpool(const MessageSpool&);
+        MessageSpool& operator=(const MessageSpool&);
+
+    public:
+
+        /**
+         * Creates a new MessageSpool, the file is not touched until open is called.
+         *
+         * @param owner
+         *      The Transport that owns this spool, used when marshaling the records.
+         * @param fileName
+         *      The path of the spool file.
+         * @param maxSize
+         *      The maximum size in bytes that the spool file is allowed to grow to.
+         */
+        MessageSpool(const Transport* owner, const std::string& fileName, long long maxSize);
+
+        virtual ~MessageSpool();
+
+        /**
+         * Opens the spool file, creating it if needed.  If the file exists the records
+         * it holds are verified and any damaged tail is truncated away.
+         *
+         * @throws IOException if the file cannot be opened or is not a spool file.
+         */
+        void open();
+
+        /**
+         * Closes the spool file, records that have not been replayed remain in the file
+         * and will be found again by the next call to open.
+         *
+         * @throws IOException if an error occurs while closing the file.
+         */
+        void close();
+
+        /**
+         * Appends the given Command to the end of the spool.
+         *
+         * @param command
+         *      The Command to write to the spool.
+         *
+         * @return true if the Command was written, false if the spool is full.
+         *
+         * @throws IOException if the Command cannot be marshaled or written.
+         */
+        bool append(const Pointer<commands::Command> command);
+
+        /**
+         * Forces the records appended so far out to the storage device.
+         *
+         * @throws IOException if the spool is not open or the file cannot be synced.
+         */
+        void sync();
+
+        /**
+         * Records that a producer, or every producer of a session or connection, was
+         * removed, its spooled sends are dropped by the next replay instead of being
+         * sent for a producer the broker will never hear of again.  Ids of any other
+         * kind are ignored.  The removals are kept in memory only, records recovered
+         * from an earlier process are all replayed.
+         *
+         * @param removedId
+         *      The ProducerId, SessionId or ConnectionId that was removed.
+         */
+        void discardSendsFrom(const Pointer<commands::DataStructure> removedId);
+
+        /**
+         * Sends every spooled record to the given Transport in the order they were
+         * appended and then empties the spool.  Records from producers passed to
+         * discardSendsFrom are skipped, a record that fails its checksum ends the
+         * replay and is dropped along with the records after it.  If the Transport
+         * fails during the replay the spool is left intact so the records are sent
+         * again next time.
+         *
+         * @param transport
+         *      The Transport to send the spooled Commands to.
+         * @param batchSize
+         *      The maximum number of Commands handed to the Transport in one batch.
+         *
+         * @return the number of Commands that were sent.
+         *
+         * @throws IOException if the spool file cannot be read or the Transport fails.
+         */
+        int replay(const Pointer<Transport> transport, int batchSize);
+
+        /**
+         * @return true if there are no records in the spool.
+         */
+        bool isEmpty() const;
+
+        /**
+         * @return the number of records currently held in the spool.
+         */
+        int size() const;
+
+        /**
+         * @return the current size of the spool file in bytes.
+         */
+        long long getFileSize() const;
+
+        /**
+         * @return the path of the spool file.
+         */
+        std::string getFileName() const;
+
+        /**
+         * @return the maximum size in bytes the spool file may grow to.
+         */
+        long long getMaxSize() const;
+
+        /**
+         * @return true if the spool has been opened and not yet closed.
+         */
+        bool isOpen() const;
+
+        /**
+         * @return the number of appended records after which the spool syncs, zero if
+         *         the record count never triggers a sync.
+         */
+        int getSyncEvery() const;
+
+        /**
+         * Sets how many records may be appended before the spool syncs the file, one
+         * syncs after every record and zero (the default) leaves it to the interval.
+         *
+         * @param records
+         *      The number of records appended between syncs, or zero.
+         */
+        void setSyncEvery(int records);
+
+        /**
+         * @return the time in milliseconds after which an append syncs the spool, zero
+         *         if time never triggers a sync.
+         */
+        long long getSyncInterval() const;
+
+        /**
+         * Sets the time in milliseconds after the last sync at which an append syncs
+         * the file, zero (the default) leaves it to the record count.  The interval is
+         * checked as records are appended, the records appended last before an idle
+         * period are synced by close or the next append.
+         *
+         * @param interval
+         *      The longest time in milliseconds between syncs while appending, or zero.
+         */
+        void setSyncInterval(long long interval);
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_FAILOVER_MESSAGESPOOL_H_ */
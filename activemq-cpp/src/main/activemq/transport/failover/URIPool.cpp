@@ -18,6 +18,7 @@
 #include "URIPool.h"
 
 #include <memory>
+#include <vector>
 #include <decaf/util/Random.h>
 #include <decaf/lang/System.h>
 
@@ -31,11 +32,11 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-URIPool::URIPool() : uriPool(), priorityURI(), randomize(false) {
+URIPool::URIPool() : uriPool(), priorityURI(), randomize(false), latencyProbe() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-URIPool::URIPool(const decaf::util::List<URI>& uris) : uriPool(), priorityURI(), randomize(false) {
+URIPool::URIPool(const decaf::util::List<URI>& uris) : uriPool(), priorityURI(), randomize(false), latencyProbe() {
     this->uriPool.copy(uris);
 
     if (!this->uriPool.isEmpty()) {
@@ -44,7 +45,7 @@ URIPool::URIPool(const decaf::util::List<URI>& uris) : uriPool(), priorityURI(),
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-URIPool::URIPool(const URIPool& uris) : uriPool(), priorityURI(), randomize(false) {
+URIPool::URIPool(const URIPool& uris) : uriPool(), priorityURI(), randomize(false), latencyProbe() {
     synchronized(&uris.uriPool) {
         this->uriPool.copy(uris.uriPool);
     }
@@ -79,7 +80,9 @@ URI URIPool::getURI() {
 
             int index = 0; // Take the first one in the list unless random is on.
 
-            if (isRandomize()) {
+            if (latencyProbe != NULL) {
+                index = selectLowestLatency();
+            } else if (isRandomize()) {
                 Random rand;
                 rand.setSeed(decaf::lang::System::currentTimeMillis());
                 index = rand.nextInt((int) uriPool.size());
@@ -92,6 +95,54 @@ URI URIPool::getURI() {
     throw NoSuchElementException(__FILE__, __LINE__, "URI Pool is currently empty.");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int URIPool::selectLowestLatency() const {
+
+    std::vector<int> candidates;
+    long long best = LatencyProbe::UNREACHABLE;
+
+    for (int i = 0; i < uriPool.size(); ++i) {
+        long long latency = latencyProbe->getLatency(uriPool.get(i));
+
+        if (candidates.empty() || LatencyProbe::isBetter(latency, best)) {
+            candidates.clear();
+            best = latency;
+        } else if (LatencyProbe::isBetter(best, latency)) {
+            continue;
+        }
+
+        candidates.push_back(i);
+    }
+
+    if (isRandomize() && candidates.size() > 1) {
+        Random rand;
+        rand.setSeed(decaf::lang::System::currentTimeMillis());
+        return candidates[rand.nextInt((int) candidates.size())];
+    }
+
+    return candidates.front();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URIPool::probeLatencies() {
+
+    Pointer<LatencyProbe> probe = this->latencyProbe;
+    if (probe == NULL || !probe->isStale()) {
+        return;
+    }
+
+    LinkedList<URI> uris;
+    copyURIs(uris);
+    probe->probe(uris);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URIPool::copyURIs(List<URI>& target) const {
+    synchronized(&uriPool) {
+        target.addAll(uriPool);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool URIPool::addURI(const URI& uri) {
 
@@ -20,6 +20,8 @@
 
 #include <activemq/util/Config.h>
 
+#include <activemq/transport/failover/LatencyProbe.h>
+#include <decaf/lang/Pointer.h>
 #include <decaf/net/URI.h>
 #include <decaf/util/LinkedList.h>
 #include <decaf/util/NoSuchElementException.h>
@@ -34,6 +36,7 @@ namespace failover {
         mutable decaf::util::LinkedList<decaf::net::URI> uriPool;
         decaf::net::URI priorityURI;
         bool randomize;
+        decaf::lang::Pointer<LatencyProbe> latencyProbe;
 
     public:
 
@@ -76,6 +79,14 @@ namespace failover {
             return this->uriPool;
         }
 
+        /**
+         * Adds a copy of every URI currently in the pool to the given list.
+         *
+         * @param target
+         *      The list that receives the URIs.
+         */
+        void copyURIs(decaf::util::List<decaf::net::URI>& target) const;
+
         /**
          * @return true if this URI Pool is empty.
          */
@@ -105,6 +116,9 @@ namespace failover {
          * Receiving the exception is not an indication that a URI won't be available
          * in the future, the caller should react accordingly.
          *
+         * When a LatencyProbe is set the URI with the lowest measured latency is taken,
+         * URIs that are equally good are taken in order or at random as configured.
+         *
          * @return the next free URI in the Pool.
          *
          * @throw NoSuchElementException if there are none free currently.
@@ -162,6 +176,30 @@ namespace failover {
             this->randomize = value;
         }
 
+        /**
+         * Gets the LatencyProbe used to choose between URIs, NULL when URIs are picked
+         * only in order or at random.
+         */
+        decaf::lang::Pointer<LatencyProbe> getLatencyProbe() const {
+            return this->latencyProbe;
+        }
+
+        /**
+         * Sets the LatencyProbe used to choose between URIs, pools may share a probe.
+         *
+         * @param probe
+         *      The probe whose results rank the URIs, or NULL to disable ranking.
+         */
+        void setLatencyProbe(const decaf::lang::Pointer<LatencyProbe>& probe) {
+            this->latencyProbe = probe;
+        }
+
+        /**
+         * Probes the URIs currently in the pool if there is a LatencyProbe set and its
+         * results are stale.  The pool is not locked while the probes run.
+         */
+        void probeLatencies();
+
         /**
          * Returns true if the given URI is contained in this set of URIs.
          *
@@ -189,6 +227,15 @@ namespace failover {
          */
         bool equals(const URIPool& other) const;
 
+    private:
+
+        /**
+         * Must be called with the pool locked and not empty.
+         *
+         * @return the index of the URI with the lowest latency.
+         */
+        int selectLowestLatency() const;
+
     };
 
 }}}
@@ -32,6 +32,7 @@
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Boolean.h>
+#include <memory>
 
 using namespace std;
 using namespace activemq;
@@ -382,6 +383,50 @@ void InactivityMonitor::oneway(const Pointer<Command> command) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void InactivityMonitor::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    try {
+        // Same bookkeeping as oneway, held once for the whole batch.
+        synchronized(&this->members->inWriteMutex) {
+            this->members->inWrite.set(true);
+            try {
+
+                if (this->members->failed.get()) {
+                    throw IOException(__FILE__, __LINE__,
+                        (std::string("Channel was inactive for too long: ") + next->getRemoteAddress()).c_str());
+                }
+
+                std::auto_ptr< decaf::util::Iterator< Pointer<Command> > > iter(commands.iterator());
+                while (iter->hasNext()) {
+                    Pointer<Command> command = iter->next();
+                    if (command->isWireFormatInfo()) {
+                        synchronized( &this->members->monitor ) {
+                            this->members->localWireFormatInfo = command.dynamicCast<WireFormatInfo>();
+                            startMonitorThreads();
+                        }
+                    }
+                }
+
+                this->next->onewayBatch(commands);
+
+                this->members->commandSent.set(true);
+                this->members->inWrite.set(false);
+
+            } catch (Exception& ex) {
+                this->members->commandSent.set(true);
+                this->members->inWrite.set(false);
+                ex.setMark(__FILE__, __LINE__);
+                throw;
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(UnsupportedOperationException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool InactivityMonitor::allowReadCheck(long long elapsed) {
     return elapsed > (this->members->readCheckTime * 9 / 10);
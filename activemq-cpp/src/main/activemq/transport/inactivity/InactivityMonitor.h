@@ -74,6 +74,8 @@ namespace inactivity {
 
         virtual void oneway(const Pointer<Command> command);
 
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands);
+
     public:
 
         bool isKeepAliveResponseRequired() const;
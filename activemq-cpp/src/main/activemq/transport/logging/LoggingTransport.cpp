@@ -17,6 +17,8 @@
 
 #include "LoggingTransport.h"
 
+#include <memory>
+
 using namespace std;
 using namespace activemq;
 using namespace activemq::exceptions;
@@ -55,6 +57,26 @@ void LoggingTransport::oneway(const Pointer<Command> command) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransport::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    try {
+
+        std::auto_ptr< decaf::util::Iterator< Pointer<Command> > > iter(commands.iterator());
+        while (iter->hasNext()) {
+            std::cout << "SEND: " << iter->next()->toString() << std::endl;
+        }
+
+        // The base class would log each command again through oneway.
+        checkClosed();
+        next->onewayBatch(commands);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(UnsupportedOperationException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Response> LoggingTransport::request(const Pointer<Command> command) {
 
@@ -50,6 +50,8 @@ namespace logging{
 
         virtual void oneway(const Pointer<Command> command);
 
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands);
+
         /**
          * {@inheritDoc}
          *
@@ -18,6 +18,8 @@
 #include <activemq/transport/mock/MockTransport.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
+#include <memory>
+
 using namespace activemq;
 using namespace activemq::transport;
 using namespace activemq::transport::mock;
@@ -49,6 +51,7 @@ MockTransport::MockTransport(const Pointer<WireFormat> wireFormat,
     failOnKeepAliveSends(false),
     numSentKeepAlivesBeforeFail(0),
     numSentKeepAlives(0),
+    numSentBatches(0),
     failOnStart(false),
     failOnStop(false),
     failOnClose(false) {
@@ -97,6 +100,25 @@ void MockTransport::oneway(const Pointer<Command> command) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void MockTransport::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    try {
+
+        this->numSentBatches++;
+
+        std::auto_ptr< decaf::util::Iterator< Pointer<Command> > > iter(commands.iterator());
+        while (iter->hasNext()) {
+            this->oneway(iter->next());
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(UnsupportedOperationException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<FutureResponse> MockTransport::asyncRequest(const Pointer<Command> command,
                                                     const Pointer<ResponseCallback> responseCallback) {
@@ -80,6 +80,7 @@ namespace mock{
         bool failOnKeepAliveSends;
         int numSentKeepAlivesBeforeFail;
         int numSentKeepAlives;
+        int numSentBatches;
 
         bool failOnStart;
         bool failOnStop;
@@ -157,6 +158,8 @@ namespace mock{
 
         virtual void oneway(const Pointer<Command> command);
 
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands);
+
         virtual Pointer<FutureResponse> asyncRequest(const Pointer<Command> command,
                                                      const Pointer<ResponseCallback> responseCallback);
 
@@ -288,6 +291,17 @@ namespace mock{
             this->numSentKeepAlives = value;
         }
 
+        /**
+         * @return the number of times onewayBatch has been called on this transport.
+         */
+        int getNumSentBatches() const {
+            return this->numSentBatches;
+        }
+
+        void setNumSentBatches(int value) {
+            this->numSentBatches = value;
+        }
+
         bool isFailOnStart() const {
             return this->failOnReceiveMessage;
         }
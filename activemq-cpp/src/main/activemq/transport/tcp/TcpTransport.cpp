@@ -63,6 +63,7 @@ namespace tcp {
         const decaf::net::URI& location;
 
         int outputBufferSize;
+        int outputDirectWriteThreshold;
         int inputBufferSize;
 
         bool trace;
@@ -80,6 +81,7 @@ namespace tcp {
             dataOutputStream(),
             location(location),
             outputBufferSize(8192),
+            outputDirectWriteThreshold(8192),
             inputBufferSize(8192),
             trace(false),
             soLinger(-1),
@@ -182,6 +184,7 @@ void TcpTransport::connect() {
 
         // Get the write buffer size.
         int outputBufferSize = this->impl->outputBufferSize;
+        BufferedOutputStream* bufferedOStream = NULL;
 
         // We don't own these ever, socket object owns.
         InputStream* socketIStream = impl->socket->getInputStream();
@@ -198,13 +201,19 @@ void TcpTransport::connect() {
 
             // Now wrap with the Buffered streams, we own the source streams
             inputStream.reset(new BufferedInputStream(inputStream.release(), inputBufferSize, true));
-            outputStream.reset(new BufferedOutputStream(outputStream.release(), outputBufferSize, true));
+            bufferedOStream = new BufferedOutputStream(outputStream.release(), outputBufferSize, true);
+            outputStream.reset(bufferedOStream);
         } else {
             // Wrap with the Buffered streams, we don't own the source streams
             inputStream.reset(new BufferedInputStream(socketIStream, inputBufferSize));
-            outputStream.reset(new BufferedOutputStream(sokcetOStream, outputBufferSize));
+            bufferedOStream = new BufferedOutputStream(sokcetOStream, outputBufferSize);
+            outputStream.reset(bufferedOStream);
         }
 
+        // Large writes such as message bodies go to the socket in one gathered send
+        // with whatever was buffered ahead of them instead of being copied through.
+        bufferedOStream->setDirectWriteThreshold(this->impl->outputDirectWriteThreshold);
+
         // Now wrap the Buffered Streams with DataInput based streams.  We own
         // the Source streams, all the streams in the chain that we own are
         // destroyed when these are.
@@ -293,6 +302,16 @@ int TcpTransport::getOutputBufferSize() const {
     return this->impl->outputBufferSize;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransport::setOutputDirectWriteThreshold(int outputDirectWriteThreshold) {
+    this->impl->outputDirectWriteThreshold = outputDirectWriteThreshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TcpTransport::getOutputDirectWriteThreshold() const {
+    return this->impl->outputDirectWriteThreshold;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void TcpTransport::setInputBufferSize(int inputBufferSize) {
     this->impl->inputBufferSize = inputBufferSize;
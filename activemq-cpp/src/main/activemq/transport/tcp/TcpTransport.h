@@ -76,6 +76,9 @@ namespace tcp {
         void setOutputBufferSize(int outputBufferSize);
         int getOutputBufferSize() const;
 
+        void setOutputDirectWriteThreshold(int outputDirectWriteThreshold);
+        int getOutputDirectWriteThreshold() const;
+
         void setInputBufferSize(int inputBufferSize);
         int getInputBufferSize() const;
 
@@ -105,6 +108,11 @@ namespace tcp {
 
         virtual bool isConnected() const;
 
+        virtual void onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+            checkClosed();
+            next->onewayBatch(commands);
+        }
+
     protected:
 
         decaf::net::URI getLocation() const;
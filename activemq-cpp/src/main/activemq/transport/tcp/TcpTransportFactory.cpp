@@ -130,6 +130,7 @@ void TcpTransportFactory::doConfigureTransport(Pointer<Transport> transport,
 
         tcp->setInputBufferSize(Integer::parseInt(properties.getProperty("inputBufferSize", "8192")));
         tcp->setOutputBufferSize(Integer::parseInt(properties.getProperty("outputBufferSize", "8192")));
+        tcp->setOutputDirectWriteThreshold(Integer::parseInt(properties.getProperty("outputDirectWriteThreshold", "8192")));
         tcp->setTrace(Boolean::parseBoolean(properties.getProperty("transport.tcpTracingEnabled", "false")));
         tcp->setLinger(Integer::parseInt(properties.getProperty("soLinger", "-1")));
         tcp->setKeepAlive(Boolean::parseBoolean(properties.getProperty("soKeepAlive", "false")));
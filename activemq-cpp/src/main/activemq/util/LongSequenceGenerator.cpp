@@ -40,6 +40,18 @@ long long LongSequenceGenerator::getNextSequenceId() {
     return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+long long LongSequenceGenerator::getNextSequenceIds(int count) {
+
+    synchronized(&mutex) {
+        long long first = this->lastSequenceId + 1;
+        this->lastSequenceId += count;
+        return first;
+    }
+
+    return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 long long LongSequenceGenerator::getLastSequenceId() {
 
@@ -45,6 +45,16 @@ namespace util {
          */
         long long getNextSequenceId();
 
+        /**
+         * Reserves a run of consecutive ids in a single step.
+         *
+         * @param count
+         *      The number of ids to reserve, must be at least one.
+         *
+         * @return the first id of the run, the last is this value plus count minus one.
+         */
+        long long getNextSequenceIds(int count);
+
         /**
          * @return the last id that was generated.
          */
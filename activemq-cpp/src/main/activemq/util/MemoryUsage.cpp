@@ -16,20 +16,97 @@
  */
 
 #include "MemoryUsage.h"
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/InterruptedException.h>
+#include <decaf/internal/util/concurrent/Atomics.h>
 #include <decaf/util/concurrent/Concurrent.h>
 
 using namespace activemq;
 using namespace activemq::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
 using namespace decaf::util;
 using namespace decaf::util::concurrent;
+using namespace decaf::internal::util::concurrent;
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
-MemoryUsage::MemoryUsage() : limit(0), usage(0), mutex() {
+namespace {
+
+    inline long long atomicGet(const volatile long long* target) {
+        return Atomics::getAndAdd64(const_cast<volatile long long*>(target), 0);
+    }
+
+    inline void atomicSet(volatile long long* target, long long value) {
+        long long current = atomicGet(target);
+        while (!Atomics::compareAndSet64(target, current, value)) {
+            current = atomicGet(target);
+        }
+    }
+
+    // A timeout of zero waits forever, as Object::wait does.
+    inline long long toWaitTimeout(unsigned int timeout) {
+        return timeout > 0 ? (long long)timeout : -1;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-MemoryUsage::MemoryUsage(unsigned long long limit) : limit(limit), usage(), mutex() {
+namespace activemq {
+namespace util {
+
+    /**
+     * A thread parked in the MemoryUsage wait queue, each waiter has its own monitor
+     * so that it can be woken individually.  The signaled flag ensures a signal that
+     * arrives before the thread starts waiting is not lost.
+     */
+    class MemoryUsage::Waiter {
+    private:
+
+        Mutex monitor;
+        bool signaled;
+
+    private:
+
+        Waiter(const Waiter&);
+        Waiter& operator= (const Waiter&);
+
+    public:
+
+        Waiter() : monitor(), signaled(false) {}
+
+        void signal() {
+            synchronized(&monitor) {
+                signaled = true;
+                monitor.notify();
+            }
+        }
+
+        /**
+         * Waits until signaled or the timeout expires, a negative timeout waits forever.
+         */
+        void await(long long timeout) {
+            synchronized(&monitor) {
+                if (!signaled) {
+                    if (timeout < 0) {
+                        monitor.wait();
+                    } else if (timeout > 0) {
+                        monitor.wait(timeout);
+                    }
+                }
+                signaled = false;
+            }
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsage::MemoryUsage() : limit(0), usage(0), waiting(0), mutex(), waiters() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsage::MemoryUsage(unsigned long long limit) : limit((long long)limit), usage(0), waiting(0), mutex(), waiters() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -39,21 +116,60 @@ MemoryUsage::~MemoryUsage() {
 ////////////////////////////////////////////////////////////////////////////////
 void MemoryUsage::waitForSpace() {
 
-    synchronized(&mutex) {
-        while (this->isFull()) {
-            mutex.wait();
-        }
+    if (this->waiting == 0 && this->hasSpace()) {
+        return;
     }
+
+    this->awaitSpace(-1, 0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MemoryUsage::waitForSpace(unsigned int timeout) {
+    this->tryWaitForSpace(timeout);
+}
 
-    if (this->isFull()) {
-        synchronized(&mutex) {
-            mutex.wait(timeout);
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::tryWaitForSpace(unsigned int timeout) {
+
+    if (this->waiting == 0 && this->hasSpace()) {
+        return true;
+    }
+
+    return this->awaitSpace(toWaitTimeout(timeout), 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsage::enqueueUsage(unsigned long long value) {
+
+    if (!this->tryReserve(value)) {
+        this->awaitSpace(-1, value);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::enqueueUsage(unsigned long long value, unsigned int timeout) {
+
+    if (this->tryReserve(value)) {
+        return true;
+    }
+
+    return this->awaitSpace(toWaitTimeout(timeout), value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::reserveUsage(unsigned long long value, unsigned int timeout) {
+
+    if (this->waiting == 0) {
+        long long current = atomicGet(&this->usage);
+        while (hasSpaceFor(value)) {
+            if (Atomics::compareAndSet64(&this->usage, current, current + (long long)value)) {
+                return true;
+            }
+            current = atomicGet(&this->usage);
         }
     }
+
+    return this->awaitSpace(toWaitTimeout(timeout), value, true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -63,9 +179,7 @@ void MemoryUsage::increaseUsage(unsigned long long value) {
         return;
     }
 
-    synchronized(&mutex) {
-        this->usage += value;
-    }
+    Atomics::getAndAdd64(&this->usage, (long long)value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -75,19 +189,160 @@ void MemoryUsage::decreaseUsage(unsigned long long value) {
         return;
     }
 
-    synchronized(&mutex) {
-        value > this->usage ? this->usage = 0 : this->usage -= value;
-        mutex.notifyAll();
+    long long current = atomicGet(&this->usage);
+    while (true) {
+        long long update = value >= (unsigned long long)current ? 0 : current - (long long)value;
+        if (Atomics::compareAndSet64(&this->usage, current, update)) {
+            break;
+        }
+        current = atomicGet(&this->usage);
     }
+
+    this->signalWaitersIfSpace();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool MemoryUsage::isFull() const {
-    bool result = false;
+    return !this->hasSpace();
+}
 
+////////////////////////////////////////////////////////////////////////////////
+unsigned long long MemoryUsage::getUsage() const {
+    return (unsigned long long)atomicGet(&this->usage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsage::setUsage(unsigned long long usage) {
+    atomicSet(&this->usage, (long long)usage);
+    this->signalWaitersIfSpace();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned long long MemoryUsage::getLimit() const {
+    return (unsigned long long)atomicGet(&this->limit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsage::setLimit(unsigned long long limit) {
+    atomicSet(&this->limit, (long long)limit);
+    this->signalWaitersIfSpace();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MemoryUsage::getWaitingCount() const {
+    return this->waiting;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::hasSpace() const {
+    return atomicGet(&this->usage) < atomicGet(&this->limit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::hasSpaceFor(unsigned long long value) const {
+
+    long long limit = atomicGet(&this->limit);
+    long long needed = value >= (unsigned long long)limit ? limit : (long long)value;
+
+    return atomicGet(&this->usage) <= limit - needed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::tryReserve(unsigned long long value) {
+
+    // Fast path, nobody is queued so take the credit directly if there is any.
+    if (this->waiting == 0) {
+        long long current = atomicGet(&this->usage);
+        while (current < atomicGet(&this->limit)) {
+            if (Atomics::compareAndSet64(&this->usage, current, current + (long long)value)) {
+                return true;
+            }
+            current = atomicGet(&this->usage);
+        }
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::awaitSpace(long long timeout, unsigned long long reserve, bool whole) {
+
+    Waiter waiter;
+    bool granted = false;
+
+    // The waiting count is raised before space is checked under the lock, paired with
+    // the usage update in decreaseUsage this guarantees that either we see the space
+    // returned or the thread returning it sees us in the queue and signals.
+    synchronized(&mutex) {
+        this->waiters.addLast(&waiter);
+        Atomics::incrementAndGet(&this->waiting);
+    }
+
+    long long deadline = timeout > 0 ? System::currentTimeMillis() + timeout : 0;
+
+    try {
+
+        while (true) {
+
+            synchronized(&mutex) {
+                if (this->waiters.getFirst() == &waiter && (whole ? this->hasSpaceFor(reserve) : this->hasSpace())) {
+                    if (reserve > 0) {
+                        Atomics::getAndAdd64(&this->usage, (long long)reserve);
+                    }
+
+                    this->waiters.removeFirst();
+                    Atomics::decrementAndGet(&this->waiting);
+                    this->signalNextWaiter();
+                    granted = true;
+                }
+            }
+
+            if (granted) {
+                return true;
+            }
+
+            long long remaining = -1;
+            if (timeout >= 0) {
+                remaining = deadline - System::currentTimeMillis();
+                if (remaining <= 0) {
+                    break;
+                }
+            }
+
+            waiter.await(remaining);
+        }
+
+    } catch (InterruptedException& ex) {
+        synchronized(&mutex) {
+            this->waiters.remove(&waiter);
+            Atomics::decrementAndGet(&this->waiting);
+            this->signalNextWaiter();
+        }
+        throw;
+    }
+
+    // Timed out, leave the queue and pass on any signal we may have consumed.
     synchronized(&mutex) {
-        result = this->usage >= this->limit;
+        this->waiters.remove(&waiter);
+        Atomics::decrementAndGet(&this->waiting);
+        this->signalNextWaiter();
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsage::signalNextWaiter() {
+    if (!this->waiters.isEmpty() && this->hasSpace()) {
+        this->waiters.getFirst()->signal();
     }
+}
 
-    return result;
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsage::signalWaitersIfSpace() {
+    if (this->waiting > 0 && this->hasSpace()) {
+        synchronized(&mutex) {
+            this->signalNextWaiter();
+        }
+    }
 }
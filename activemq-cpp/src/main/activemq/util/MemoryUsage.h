@@ -20,23 +20,47 @@
 
 #include <activemq/util/Config.h>
 #include <activemq/util/Usage.h>
+#include <decaf/util/LinkedList.h>
 #include <decaf/util/concurrent/Mutex.h>
 
 namespace activemq {
 namespace util {
 
+    /**
+     * Credit based Usage manager used to implement the Producer Window.
+     *
+     * The usage and limit values are maintained with atomic operations so that the common
+     * case of a producer sending while there is still credit available, or a ProducerAck
+     * returning credit while nobody is waiting, never acquires a lock.  Threads that must
+     * wait for space are placed in a FIFO queue and are woken one at a time, the head of the
+     * queue is only signaled once the usage has dropped below the limit and it passes the
+     * signal on to the next waiter when it leaves if there is still space remaining.
+     */
     class AMQCPP_API MemoryUsage : public Usage {
     private:
 
+        class Waiter;
+
         // The physical limit of memory usage this object allows.
-        unsigned long long limit;
+        volatile long long limit;
 
         // Amount of memory currently used in.
-        unsigned long long usage;
+        volatile long long usage;
+
+        // Count of threads in the wait queue, allows the fast paths to skip the lock.
+        volatile int waiting;
 
-        // Mutex to lock usage and wait on.
+        // Mutex that guards the wait queue.
         mutable decaf::util::concurrent::Mutex mutex;
 
+        // FIFO queue of threads waiting for space to become available.
+        decaf::util::LinkedList<Waiter*> waiters;
+
+    private:
+
+        MemoryUsage(const MemoryUsage&);
+        MemoryUsage& operator= (const MemoryUsage&);
+
     public:
 
         /**
@@ -60,19 +84,57 @@ namespace util {
         /**
          * Waits for more space to be returned to this Usage Manager, times out
          * when the given time span in milliseconds elapses.
-         * @param timeout The time to wait for more space.
+         * @param timeout The time in milliseconds to wait for more space, zero waits forever.
          */
         virtual void waitForSpace(unsigned int timeout);
 
+        /**
+         * Waits for more space to be returned to this Usage Manager, times out
+         * when the given time span in milliseconds elapses.
+         * @param timeout The time in milliseconds to wait for more space, zero waits forever.
+         *
+         * @return true if there is space available, false if the wait timed out.
+         */
+        virtual bool tryWaitForSpace(unsigned int timeout);
+
         /**
          * Tries to increase the usage by value amount but blocks if this object is
-         * currently full.
+         * currently full.  The credit is reserved at the point the waiting thread is
+         * granted space so that concurrent producers cannot all pass the check before
+         * any of them accounts for its usage.
+         *
+         * @param value Amount of usage in bytes to add.
+         */
+        virtual void enqueueUsage(unsigned long long value);
+
+        /**
+         * Tries to increase the usage by value amount, waiting no longer than the given
+         * time span in milliseconds for space if this object is currently full.
+         *
          * @param value Amount of usage in bytes to add.
+         * @param timeout The time in milliseconds to wait for space, zero waits forever.
+         *
+         * @return true if the usage was added, false if the wait timed out.
          */
-        virtual void enqueueUsage(unsigned long long value) {
-            waitForSpace();
-            increaseUsage(value);
-        }
+        virtual bool enqueueUsage(unsigned long long value, unsigned int timeout);
+
+        /**
+         * Increases the usage by value amount once all of it fits under the limit, unlike
+         * enqueueUsage which only waits for the usage to drop below the limit.  A value
+         * larger than the limit waits for the usage to drop to zero, so that it can't
+         * wait forever.  Threads waiting here keep their place in the same FIFO queue as
+         * those waiting in enqueueUsage.
+         *
+         * @param value Amount of usage in bytes to add.
+         * @param timeout The time in milliseconds to wait for space, zero waits forever.
+         *
+         * @return true if the usage was added, false if the wait timed out.
+         *
+         * @throws InterruptedException if the calling thread is interrupted while waiting.
+         *
+         * @since 3.10.0
+         */
+        bool reserveUsage(unsigned long long value, unsigned int timeout);
 
         /**
          * Increases the usage by the value amount
@@ -95,33 +157,44 @@ namespace util {
          * Gets the current usage amount.
          * @return the amount of bytes currently used.
          */
-        unsigned long long getUsage() const {
-            return usage;
-        }
+        unsigned long long getUsage() const;
 
         /**
          * Sets the current usage amount
          * @param usage - The amount to tag as used.
          */
-        void setUsage(unsigned long long usage) {
-            this->usage = usage;
-        }
+        void setUsage(unsigned long long usage);
 
         /**
          * Gets the current limit amount.
          * @return the amount that can be used before full.
          */
-        unsigned long long getLimit() const {
-            return limit;
-        }
+        unsigned long long getLimit() const;
 
         /**
          * Sets the current limit amount
          * @param limit - The amount that can be used before full.
          */
-        void setLimit(unsigned long long limit) {
-            this->limit = limit;
-        }
+        void setLimit(unsigned long long limit);
+
+        /**
+         * @return the number of threads currently waiting for space.
+         */
+        int getWaitingCount() const;
+
+    private:
+
+        bool hasSpace() const;
+
+        bool hasSpaceFor(unsigned long long value) const;
+
+        bool tryReserve(unsigned long long value);
+
+        bool awaitSpace(long long timeout, unsigned long long reserve, bool whole = false);
+
+        void signalNextWaiter();
+
+        void signalWaitersIfSpace();
 
     };
 
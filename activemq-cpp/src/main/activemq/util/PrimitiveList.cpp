@@ -27,17 +27,17 @@ using namespace decaf::util;
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveList::PrimitiveList() : converter() {
+PrimitiveList::PrimitiveList() : converter(), dirty(true), cleanModCount(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveList::PrimitiveList( const decaf::util::List<PrimitiveValueNode>& src )
-  : LinkedList<PrimitiveValueNode>( src ), converter(){
+  : LinkedList<PrimitiveValueNode>( src ), converter(), dirty(true), cleanModCount(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveList::PrimitiveList( const PrimitiveList& src )
-  : LinkedList<PrimitiveValueNode>( src ), converter() {
+  : LinkedList<PrimitiveValueNode>( src ), converter(), dirty(true), cleanModCount(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -61,6 +61,34 @@ std::string PrimitiveList::toString() const {
     return stream.str();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode PrimitiveList::set(int index, const PrimitiveValueNode& element) {
+    PrimitiveValueNode oldValue = LinkedList<PrimitiveValueNode>::set(index, element);
+    this->dirty = true;
+    return oldValue;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode& PrimitiveList::getFirst() {
+    PrimitiveValueNode& value = LinkedList<PrimitiveValueNode>::getFirst();
+    this->dirty = true;
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode& PrimitiveList::getLast() {
+    PrimitiveValueNode& value = LinkedList<PrimitiveValueNode>::getLast();
+    this->dirty = true;
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ListIterator<PrimitiveValueNode>* PrimitiveList::listIterator(int index) {
+    ListIterator<PrimitiveValueNode>* iterator = LinkedList<PrimitiveValueNode>::listIterator(index);
+    this->dirty = true;
+    return iterator;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool PrimitiveList::getBool(int index) const {
 
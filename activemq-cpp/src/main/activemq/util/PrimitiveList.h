@@ -37,6 +37,14 @@ namespace util{
     private:
 
         PrimitiveValueConverter converter;
+        bool dirty;
+        int cleanModCount;
+
+    public:
+
+        using decaf::util::LinkedList<PrimitiveValueNode>::getFirst;
+        using decaf::util::LinkedList<PrimitiveValueNode>::getLast;
+        using decaf::util::LinkedList<PrimitiveValueNode>::listIterator;
 
     public:
 
@@ -66,6 +74,37 @@ namespace util{
          */
         std::string toString() const;
 
+        /**
+         * Returns whether the list may have changed since clearDirty was last called.
+         * Adding or removing elements, replacing one or handing out a modifiable reference
+         * or list iterator all mark the list dirty.  A newly created list starts out dirty.
+         *
+         * @return true if the contents may differ from when the list was last marked clean.
+         */
+        bool isDirty() const {
+            return this->dirty || this->modCount != this->cleanModCount;
+        }
+
+        /**
+         * Marks the list as clean, done once its current contents have been marshaled so
+         * that an unchanged list can reuse that encoding.
+         */
+        void clearDirty() {
+            this->dirty = false;
+            this->cleanModCount = this->modCount;
+        }
+
+        // Structural changes are already counted in modCount, these cover the ways an
+        // element can be replaced or changed in place.
+
+        virtual PrimitiveValueNode set(int index, const PrimitiveValueNode& element);
+
+        virtual PrimitiveValueNode& getFirst();
+
+        virtual PrimitiveValueNode& getLast();
+
+        virtual decaf::util::ListIterator<PrimitiveValueNode>* listIterator(int index);
+
         /**
          * Gets the Boolean value at the specified index.
          * @param index - index to get value from
@@ -32,7 +32,7 @@ using namespace decaf::lang;
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveMap::PrimitiveMap() : decaf::util::StlMap<std::string, PrimitiveValueNode>(), converter() {
+PrimitiveMap::PrimitiveMap() : decaf::util::StlMap<std::string, PrimitiveValueNode>(), converter(), dirty(true) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -41,12 +41,12 @@ PrimitiveMap::~PrimitiveMap() {
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveMap::PrimitiveMap(const decaf::util::Map<std::string, PrimitiveValueNode>& src) :
-    decaf::util::StlMap<std::string, PrimitiveValueNode>(src), converter() {
+    decaf::util::StlMap<std::string, PrimitiveValueNode>(src), converter(), dirty(true) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveMap::PrimitiveMap(const PrimitiveMap& src) :
-    decaf::util::StlMap<std::string, PrimitiveValueNode>(src), converter() {
+    decaf::util::StlMap<std::string, PrimitiveValueNode>(src), converter(), dirty(true) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +68,81 @@ std::string PrimitiveMap::toString() const {
     return stream.str();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::copy(const StlMap<std::string, PrimitiveValueNode>& source) {
+    this->dirty = true;
+    StlMap<std::string, PrimitiveValueNode>::copy(source);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::copy(const Map<std::string, PrimitiveValueNode>& source) {
+    this->dirty = true;
+    StlMap<std::string, PrimitiveValueNode>::copy(source);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::clear() {
+    this->dirty = true;
+    StlMap<std::string, PrimitiveValueNode>::clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode& PrimitiveMap::get(const std::string& key) {
+    // The caller can change the value through the returned reference.
+    PrimitiveValueNode& value = StlMap<std::string, PrimitiveValueNode>::get(key);
+    this->dirty = true;
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PrimitiveMap::put(const std::string& key, const PrimitiveValueNode& value) {
+    this->dirty = true;
+    return StlMap<std::string, PrimitiveValueNode>::put(key, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PrimitiveMap::put(const std::string& key, const PrimitiveValueNode& value, PrimitiveValueNode& oldValue) {
+    this->dirty = true;
+    return StlMap<std::string, PrimitiveValueNode>::put(key, value, oldValue);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::putAll(const StlMap<std::string, PrimitiveValueNode>& other) {
+    this->dirty = true;
+    StlMap<std::string, PrimitiveValueNode>::putAll(other);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::putAll(const Map<std::string, PrimitiveValueNode>& other) {
+    this->dirty = true;
+    StlMap<std::string, PrimitiveValueNode>::putAll(other);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode PrimitiveMap::remove(const std::string& key) {
+    PrimitiveValueNode value = StlMap<std::string, PrimitiveValueNode>::remove(key);
+    this->dirty = true;
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Set< MapEntry<std::string, PrimitiveValueNode> >& PrimitiveMap::entrySet() {
+    this->dirty = true;
+    return StlMap<std::string, PrimitiveValueNode>::entrySet();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Set<std::string>& PrimitiveMap::keySet() {
+    this->dirty = true;
+    return StlMap<std::string, PrimitiveValueNode>::keySet();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Collection<PrimitiveValueNode>& PrimitiveMap::values() {
+    this->dirty = true;
+    return StlMap<std::string, PrimitiveValueNode>::values();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveValueNode::PrimitiveType PrimitiveMap::getValueType(const std::string& key) const {
     PrimitiveValueNode node = this->get(key);
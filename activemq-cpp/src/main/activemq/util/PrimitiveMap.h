@@ -37,6 +37,14 @@ namespace util {
     private:
 
         PrimitiveValueConverter converter;
+        bool dirty;
+
+    public:
+
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::get;
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::entrySet;
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::keySet;
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::values;
 
     public:
 
@@ -71,6 +79,51 @@ namespace util {
          */
         std::string toString() const;
 
+        /**
+         * Returns whether the map may have changed since clearDirty was last called.  Any
+         * modification marks the map dirty, as does handing out a modifiable reference to
+         * a value or to one of the map's views.  A newly created map starts out dirty.
+         *
+         * @return true if the contents may differ from when the map was last marked clean.
+         */
+        bool isDirty() const {
+            return this->dirty;
+        }
+
+        /**
+         * Marks the map as clean, done once its current contents have been marshaled so
+         * that an unchanged map can reuse that encoding.
+         */
+        void clearDirty() {
+            this->dirty = false;
+        }
+
+        // Overridden to mark the map dirty before handing off to StlMap.
+
+        virtual void copy(const decaf::util::StlMap<std::string, PrimitiveValueNode>& source);
+
+        virtual void copy(const decaf::util::Map<std::string, PrimitiveValueNode>& source);
+
+        virtual void clear();
+
+        virtual PrimitiveValueNode& get(const std::string& key);
+
+        virtual bool put(const std::string& key, const PrimitiveValueNode& value);
+
+        virtual bool put(const std::string& key, const PrimitiveValueNode& value, PrimitiveValueNode& oldValue);
+
+        virtual void putAll(const decaf::util::StlMap<std::string, PrimitiveValueNode>& other);
+
+        virtual void putAll(const decaf::util::Map<std::string, PrimitiveValueNode>& other);
+
+        virtual PrimitiveValueNode remove(const std::string& key);
+
+        virtual decaf::util::Set< decaf::util::MapEntry<std::string, PrimitiveValueNode> >& entrySet();
+
+        virtual decaf::util::Set<std::string>& keySet();
+
+        virtual decaf::util::Collection<PrimitiveValueNode>& values();
+
         /**
          * @return the numeric type value for the given key if it exists.
          * @throws NoSuchElementException if the key is not present in the map.
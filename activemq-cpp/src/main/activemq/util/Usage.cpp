@@ -22,3 +22,20 @@ using namespace activemq::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 Usage::~Usage() {}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Usage::tryWaitForSpace(unsigned int timeout) {
+    this->waitForSpace(timeout);
+    return !this->isFull();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Usage::enqueueUsage(unsigned long long value, unsigned int timeout) {
+
+    if (!this->tryWaitForSpace(timeout)) {
+        return false;
+    }
+
+    this->increaseUsage(value);
+    return true;
+}
@@ -36,10 +36,20 @@ namespace util {
         /**
          * Waits for more space to be returned to this Usage Manager, times out
          * when the given time span in milliseconds elapses.
-         * @param timeout The time to wait for more space.
+         * @param timeout The time in milliseconds to wait for more space, zero waits forever.
          */
         virtual void waitForSpace(unsigned int timeout) = 0;
 
+        /**
+         * Waits for more space to be returned to this Usage Manager, times out
+         * when the given time span in milliseconds elapses.  The default calls
+         * waitForSpace(timeout) and then checks isFull.
+         * @param timeout The time in milliseconds to wait for more space, zero waits forever.
+         *
+         * @return true if there is space available, false if the wait timed out.
+         */
+        virtual bool tryWaitForSpace(unsigned int timeout);
+
         /**
          * Tries to increase the usage by value amount but blocks if this object is
          * currently full.
@@ -47,6 +57,17 @@ namespace util {
          */
         virtual void enqueueUsage(unsigned long long value) = 0;
 
+        /**
+         * Tries to increase the usage by value amount but blocks if this object is
+         * currently full, giving up when the given time span in milliseconds elapses.
+         * The default waits with tryWaitForSpace and then calls increaseUsage.
+         * @param value Amount of usage in bytes to add.
+         * @param timeout The time in milliseconds to wait for space, zero waits forever.
+         *
+         * @return true if the usage was added, false if the wait timed out.
+         */
+        virtual bool enqueueUsage(unsigned long long value, unsigned int timeout);
+
         /**
          * Increases the usage by the value amount
          * @param value Amount of usage to add.
@@ -29,6 +29,7 @@
 #include <activemq/commands/WireFormatInfo.h>
 #include <activemq/commands/DataStructure.h>
 #include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/FusedTightMarshaller.h>
 #include <activemq/wireformat/openwire/marshal/generated/MarshallerFactory.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
@@ -57,7 +58,12 @@ OpenWireFormat::OpenWireFormat(const decaf::util::Properties& properties) :
     properties(properties), preferedWireFormatInfo(), dataMarshallers(256),
     id(UUID::randomUUID().toString()), receiving(), version(0), stackTraceEnabled(true),
     tcpNoDelayEnabled(true), cacheEnabled(true), cacheSize(1024), tightEncodingEnabled(false),
-    sizePrefixDisabled(false), maxInactivityDuration(30000), maxInactivityDurationInitialDelay(10000) {
+    sizePrefixDisabled(false), maxInactivityDuration(30000), maxInactivityDurationInitialDelay(10000),
+    contentSpoolThreshold(0), contentSpoolDirectory() {
+
+    this->contentSpoolThreshold =
+        Integer::parseInt(properties.getProperty("wireFormat.contentSpoolThreshold", "0"));
+    this->contentSpoolDirectory = properties.getProperty("wireFormat.contentSpoolDirectory", "");
 
     // initialize the universal marshalers, don't need to reset them again
     // after this so its safe to do this here.
@@ -148,7 +154,7 @@ void OpenWireFormat::marshal(const Pointer<commands::Command> command, const act
 
         if (command != NULL) {
 
-            DataStructure* dataStructure = dynamic_cast<DataStructure*>(command.get());
+            DataStructure* dataStructure = command.get();
 
             unsigned char type = dataStructure->getDataStructureType();
 
@@ -159,6 +165,13 @@ void OpenWireFormat::marshal(const Pointer<commands::Command> command, const act
             }
 
             if (tightEncodingEnabled) {
+
+                // The busiest commands are encoded in a single pass, the rest go
+                // through the generated marshallers in two.
+                if (FusedTightMarshaller::marshal(this, dataStructure, dataOut)) {
+                    return;
+                }
+
                 BooleanStream bs;
                 size += dsm->tightMarshal1(this, dataStructure, &bs);
                 size += bs.marshalledSize();
@@ -178,28 +191,16 @@ void OpenWireFormat::marshal(const Pointer<commands::Command> command, const act
                     dsm->looseMarshal(this, dataStructure, dataOut);
                 } else {
 
-                    ByteArrayOutputStream* baos = new ByteArrayOutputStream();
-                    std::auto_ptr<DataOutputStream> looseOut(new DataOutputStream(baos, true));
+                    ByteArrayOutputStream baos;
+                    DataOutputStream looseOut(&baos);
 
-                    looseOut->writeByte(type);
-                    dsm->looseMarshal(this, dataStructure, looseOut.get());
-                    looseOut->close();
+                    looseOut.writeByte(type);
+                    dsm->looseMarshal(this, dataStructure, &looseOut);
+                    looseOut.flush();
 
-                    // Now the data goes to the transport from out byte buffer.
-                    dataOut->writeInt((int) baos->size());
-
-                    if (baos->size() > 0) {
-                        std::pair<unsigned char*, int> array = baos->toByteArray();
-
-                        try {
-                            dataOut->write(array.first, array.second);
-                        } catch (Exception& ex) {
-                            delete[] array.first;
-                            throw;
-                        }
-
-                        delete[] array.first;
-                    }
+                    // Now the data goes to the transport straight from our byte buffer.
+                    dataOut->writeInt((int) baos.size());
+                    baos.writeTo(dataOut);
                 }
             }
         } else {
@@ -279,7 +280,7 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(DataInputStream* dis) {
 
         if (dataType != NULL_TYPE) {
 
-            DataStreamMarshaller* dsm = dynamic_cast<DataStreamMarshaller*>(dataMarshallers[dataType & 0xFF]);
+            DataStreamMarshaller* dsm = dataMarshallers[dataType & 0xFF];
 
             if (dsm == NULL) {
                 throw IOException(__FILE__, __LINE__, (string("OpenWireFormat::marshal - Unknown data type: ") + Integer::toString(dataType)).c_str());
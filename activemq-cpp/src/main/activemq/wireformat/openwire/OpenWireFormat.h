@@ -80,6 +80,10 @@ namespace marshal {
         long long maxInactivityDuration;
         long long maxInactivityDurationInitialDelay;
 
+        // Message bodies at least this large are spooled to a mapped temp file, zero disables.
+        int contentSpoolThreshold;
+        std::string contentSpoolDirectory;
+
     public:
 
         /**
@@ -357,6 +361,40 @@ namespace marshal {
             this->maxInactivityDurationInitialDelay = value;
         }
 
+        /**
+         * Gets the size in bytes at which a received Message body is spooled to a memory
+         * mapped temporary file instead of being held on the heap.
+         * @return the spool threshold in bytes, zero when spooling is disabled.
+         */
+        int getContentSpoolThreshold() const {
+            return this->contentSpoolThreshold;
+        }
+
+        /**
+         * Sets the size in bytes at which a received Message body is spooled to a memory
+         * mapped temporary file, only Messages that support mapped content are spooled.
+         * @param value - the spool threshold in bytes, zero disables spooling.
+         */
+        void setContentSpoolThreshold(int value) {
+            this->contentSpoolThreshold = value;
+        }
+
+        /**
+         * Gets the directory that spooled Message bodies are written to.
+         * @return the spool directory, empty when the system temporary directory is used.
+         */
+        const std::string& getContentSpoolDirectory() const {
+            return this->contentSpoolDirectory;
+        }
+
+        /**
+         * Sets the directory that spooled Message bodies are written to.
+         * @param value - the spool directory, empty to use the system temporary directory.
+         */
+        void setContentSpoolDirectory(const std::string& value) {
+            this->contentSpoolDirectory = value;
+        }
+
     protected:
 
         /**
@@ -75,6 +75,27 @@ void OpenWireFormatNegotiator::oneway(const Pointer<Command> command) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatNegotiator::onewayBatch(const decaf::util::List< Pointer<Command> >& commands) {
+
+    try {
+
+        checkClosed();
+
+        if (!readyCountDownLatch.await(negotiationTimeout)) {
+            throw IOException(__FILE__, __LINE__, "OpenWireFormatNegotiator::onewayBatch"
+                    "Wire format negotiation timeout: peer did not "
+                    "send his wire format.");
+        }
+
+        next->onewayBatch(commands);
+    }
+    AMQ_CATCH_RETHROW(UnsupportedOperationException)
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Response> OpenWireFormatNegotiator::request(const Pointer<Command> command) {
 
@@ -76,6 +76,8 @@ namespace openwire{
 
         virtual void oneway(const Pointer<commands::Command> command);
 
+        virtual void onewayBatch(const decaf::util::List< Pointer<commands::Command> >& commands);
+
         virtual Pointer<commands::Response> request(const Pointer<commands::Command> command);
 
         virtual Pointer<commands::Response> request(const Pointer<commands::Command> command, unsigned int timeout);
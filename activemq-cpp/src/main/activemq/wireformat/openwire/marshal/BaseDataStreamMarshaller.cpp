@@ -23,10 +23,13 @@
 #include <activemq/commands/LocalTransactionId.h>
 #include <activemq/commands/XATransactionId.h>
 #include <activemq/commands/BrokerError.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Pointer.h>
+#include <decaf/io/MemoryMappedFile.h>
+#include <decaf/internal/util/ModifiedUTF8.h>
 #include <activemq/util/Config.h>
 
 using namespace std;
@@ -41,6 +44,7 @@ using namespace activemq::wireformat::openwire::utils;
 using namespace decaf::io;
 using namespace decaf::util;
 using namespace decaf::lang;
+using decaf::internal::util::ModifiedUTF8;
 
 ////////////////////////////////////////////////////////////////////////////////
 utils::HexTable BaseDataStreamMarshaller::hexTable;
@@ -174,24 +178,8 @@ int BaseDataStreamMarshaller::tightMarshalString1(const std::string& value, util
         bs->writeBoolean(value != "");
         if (value != "") {
             size_t strlen = value.length();
-
-            int utflen = 0;
-            int c = 0;
-            bool isOnlyAscii = true;
-
-            for (size_t i = 0; i < strlen; ++i) {
-
-                c = value[i];
-                if ((c >= 0x0001) && (c <= 0x007F)) { // ASCII char
-                    utflen++;
-                } else if (c > 0x07FF) {
-                    utflen += 3;
-                    isOnlyAscii = false;
-                } else {
-                    isOnlyAscii = false;
-                    utflen += 2;
-                }
-            }
+            size_t utflen = ModifiedUTF8::encodedLength((const unsigned char*) value.c_str(), strlen);
+            bool isOnlyAscii = utflen == strlen;
 
             if (utflen >= 0x10000) {
                 throw IOException(__FILE__, __LINE__, "BaseDataStreamMarshaller::tightMarshalString1 - "
@@ -200,7 +188,7 @@ int BaseDataStreamMarshaller::tightMarshalString1(const std::string& value, util
 
             bs->writeBoolean(isOnlyAscii);
 
-            return utflen + 2;
+            return (int) utflen + 2;
         } else {
             return 0;
         }
@@ -612,6 +600,80 @@ std::vector<unsigned char> BaseDataStreamMarshaller::looseUnmarshalByteArray(dec
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int BaseDataStreamMarshaller::tightMarshalMessageContent1(commands::Message* info, utils::BooleanStream* bs) {
+
+    try {
+        int size = info->getContentSize();
+        bs->writeBoolean(size != 0);
+        return size == 0 ? 0 : size + 4;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalMessageContent2(commands::Message* info, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
+
+    try {
+        if (bs->readBoolean()) {
+            int size = info->getContentSize();
+            dataOut->writeInt(size);
+            dataOut->write(info->getContentData(), size, 0, size);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightUnmarshalMessageContent(OpenWireFormat* wireFormat, commands::Message* info, decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs) {
+
+    try {
+        if (bs->readBoolean()) {
+            readMessageContent(wireFormat, info, dataIn, dataIn->readInt());
+        } else {
+            readMessageContent(wireFormat, info, dataIn, 0);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::looseMarshalMessageContent(commands::Message* info, decaf::io::DataOutputStream* dataOut) {
+
+    try {
+        int size = info->getContentSize();
+        dataOut->writeBoolean(size != 0);
+        if (size != 0) {
+            dataOut->writeInt(size);
+            dataOut->write(info->getContentData(), size, 0, size);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::looseUnmarshalMessageContent(OpenWireFormat* wireFormat, commands::Message* info, decaf::io::DataInputStream* dataIn) {
+
+    try {
+        if (dataIn->readBoolean()) {
+            readMessageContent(wireFormat, info, dataIn, dataIn->readInt());
+        } else {
+            readMessageContent(wireFormat, info, dataIn, 0);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char> BaseDataStreamMarshaller::tightUnmarshalConstByteArray(decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs AMQCPP_UNUSED,int size) {
 
@@ -710,3 +772,32 @@ std::string BaseDataStreamMarshaller::readAsciiString(decaf::io::DataInputStream
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
     AMQ_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::readMessageContent(OpenWireFormat* wireFormat, commands::Message* info, decaf::io::DataInputStream* dataIn, int size) {
+
+    try {
+
+        int threshold = wireFormat->getContentSpoolThreshold();
+
+        if (threshold > 0 && size >= threshold && info->isMappedContentSupported()) {
+            Pointer<MemoryMappedFile> spool(
+                MemoryMappedFile::createTemporary(size, wireFormat->getContentSpoolDirectory()));
+            dataIn->readFully(spool->getWritableData(), size);
+            info->setMappedContent(spool);
+            return;
+        }
+
+        std::vector<unsigned char> data;
+        if (size > 0) {
+            data.resize(size);
+            dataIn->readFully(&data[0], (int) data.size());
+        }
+
+        info->setMappedContent(Pointer<MemoryMappedFile>());
+        info->getContent().swap(data);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
@@ -20,6 +20,7 @@
 
 #include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/utils/HexTable.h>
+#include <activemq/commands/Message.h>
 #include <activemq/commands/MessageId.h>
 #include <activemq/commands/ProducerId.h>
 #include <activemq/commands/TransactionId.h>
@@ -371,6 +372,56 @@ namespace marshal{
          */
         virtual std::vector<unsigned char> looseUnmarshalConstByteArray(decaf::io::DataInputStream* dataIn, int size);
 
+        /**
+         * Tight Marshal the body of a Message, the bytes may be held in the content
+         * vector or in a memory mapped file region.
+         * @param info - the Message whose body is marshaled
+         * @param bs - boolean stream to marshal to.
+         * @return size of the data the body adds to the stream.
+         * @throws IOException if an error occurs.
+         */
+        virtual int tightMarshalMessageContent1(commands::Message* info, utils::BooleanStream* bs);
+
+        /**
+         * Tight Marshal the body of a Message, mapped bodies are written straight
+         * from the mapping without being copied.
+         * @param info - the Message whose body is marshaled
+         * @param dataOut - stream to write the body to
+         * @param bs - boolean stream to marshal from.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightMarshalMessageContent2(commands::Message* info, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs);
+
+        /**
+         * Tight Unmarshal the body of a Message, bodies at or above the wire format's
+         * content spool threshold are read into a mapped temporary file.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param info - the Message whose body is unmarshaled
+         * @param dataIn - stream to read the body from
+         * @param bs - boolean stream to unmarshal from.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightUnmarshalMessageContent(OpenWireFormat* wireFormat, commands::Message* info, decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs);
+
+        /**
+         * Loose Marshal the body of a Message, mapped bodies are written straight
+         * from the mapping without being copied.
+         * @param info - the Message whose body is marshaled
+         * @param dataOut - stream to write the body to
+         * @throws IOException if an error occurs.
+         */
+        virtual void looseMarshalMessageContent(commands::Message* info, decaf::io::DataOutputStream* dataOut);
+
+        /**
+         * Loose Unmarshal the body of a Message, bodies at or above the wire format's
+         * content spool threshold are read into a mapped temporary file.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param info - the Message whose body is unmarshaled
+         * @param dataIn - stream to read the body from
+         * @throws IOException if an error occurs.
+         */
+        virtual void looseUnmarshalMessageContent(OpenWireFormat* wireFormat, commands::Message* info, decaf::io::DataInputStream* dataIn);
+
         /**
          * Tight Unarshall the Error object
          * @param wireFormat - The OpenwireFormat properties
@@ -430,7 +481,7 @@ namespace marshal{
          * @throws IOException if an error occurs.
          */
         template<typename T>
-        int tightMarshalObjectArray1(OpenWireFormat* wireFormat, std::vector<T> objects, utils::BooleanStream* bs) {
+        int tightMarshalObjectArray1(OpenWireFormat* wireFormat, const std::vector<T>& objects, utils::BooleanStream* bs) {
 
             try {
                 if (!objects.empty()) {
@@ -463,7 +514,7 @@ namespace marshal{
          * @throws IOException if an error occurs.
          */
         template<typename T>
-        void tightMarshalObjectArray2(OpenWireFormat* wireFormat, std::vector<T> objects, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
+        void tightMarshalObjectArray2(OpenWireFormat* wireFormat, const std::vector<T>& objects, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
 
             try {
 
@@ -490,7 +541,7 @@ namespace marshal{
          * @throws IOException if an error occurs.
          */
         template<typename T>
-        void looseMarshalObjectArray(OpenWireFormat* wireFormat, std::vector<T> objects, decaf::io::DataOutputStream* dataOut) {
+        void looseMarshalObjectArray(OpenWireFormat* wireFormat, const std::vector<T>& objects, decaf::io::DataOutputStream* dataOut) {
 
             try {
 
@@ -518,6 +569,16 @@ namespace marshal{
          */
         virtual std::string readAsciiString(decaf::io::DataInputStream* dataIn);
 
+        /**
+         * Reads a Message body of the given size into the Message, spooling it to a
+         * mapped temporary file when the wire format's spool threshold allows it.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param info - the Message whose body is read
+         * @param dataIn - stream to read the body from
+         * @param size - the number of bytes in the body
+         */
+        virtual void readMessageContent(OpenWireFormat* wireFormat, commands::Message* info, decaf::io::DataInputStream* dataIn, int size);
+
     };
 
 }}}}
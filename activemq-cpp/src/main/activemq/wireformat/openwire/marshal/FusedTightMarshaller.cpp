@@ -0,0 +1,627 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <activemq/wireformat/openwire/marshal/FusedTightMarshaller.h>
+
+#include <activemq/commands/ActiveMQBlobMessage.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQDestination.h>
+#include <activemq/commands/ActiveMQMapMessage.h>
+#include <activemq/commands/ActiveMQMessage.h>
+#include <activemq/commands/ActiveMQObjectMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQStreamMessage.h>
+#include <activemq/commands/ActiveMQTempQueue.h>
+#include <activemq/commands/ActiveMQTempTopic.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ActiveMQTopic.h>
+#include <activemq/commands/BrokerError.h>
+#include <activemq/commands/BrokerId.h>
+#include <activemq/commands/ConnectionId.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/LocalTransactionId.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/XATransactionId.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <decaf/internal/util/ModifiedUTF8.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::exceptions;
+using namespace activemq::commands;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::lang;
+using decaf::internal::util::ModifiedUTF8;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Collects the flags of a command in a BooleanStream and its fields in a byte
+     * buffer, both in the order the generated marshallers would write them.  A
+     * message body isn't copied, the buffer only records where it goes so that it
+     * can be written to the stream straight from the message.
+     */
+    class Encoder {
+    private:
+
+        Encoder(const Encoder&);
+        Encoder& operator= (const Encoder&);
+
+    public:
+
+        BooleanStream bs;
+        std::vector<unsigned char> buffer;
+
+        const unsigned char* body;
+        std::size_t bodySize;
+        std::size_t bodyOffset;
+
+        // The message whose afterMarshal hook is due once the command is written.
+        Message* marshaled;
+
+        Encoder() : bs(), buffer(), body(NULL), bodySize(0), bodyOffset(0), marshaled(NULL) {}
+
+        void writeBoolean(bool value) {
+            this->bs.writeBoolean(value);
+        }
+
+        void writeByte(unsigned char value) {
+            this->buffer.push_back(value);
+        }
+
+        void writeShort(short value) {
+            this->buffer.push_back((unsigned char) (value >> 8));
+            this->buffer.push_back((unsigned char) value);
+        }
+
+        void writeInt(int value) {
+            this->buffer.push_back((unsigned char) (value >> 24));
+            this->buffer.push_back((unsigned char) (value >> 16));
+            this->buffer.push_back((unsigned char) (value >> 8));
+            this->buffer.push_back((unsigned char) value);
+        }
+
+        void writeLong(long long value) {
+            this->writeInt((int) (value >> 32));
+            this->writeInt((int) value);
+        }
+
+        void write(const unsigned char* data, std::size_t length) {
+            if (length > 0) {
+                this->buffer.insert(this->buffer.end(), data, data + length);
+            }
+        }
+
+        void writeBody(const unsigned char* data, std::size_t length) {
+            this->body = data;
+            this->bodySize = length;
+            this->bodyOffset = this->buffer.size();
+        }
+
+        void reserve(std::size_t size) {
+            this->buffer.reserve(size);
+        }
+
+        std::size_t size() const {
+            return this->buffer.size() + this->bodySize;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeString(Encoder& out, const std::string& value) {
+
+        out.writeBoolean(!value.empty());
+        if (value.empty()) {
+            return;
+        }
+
+        std::size_t length = value.length();
+        std::size_t utflen = ModifiedUTF8::encodedLength((const unsigned char*) value.c_str(), length);
+
+        if (utflen >= 0x10000) {
+            throw IOException(__FILE__, __LINE__, "FusedTightMarshaller::writeString - "
+                    "Encountered a String value that is too long to encode.");
+        }
+
+        out.writeBoolean(utflen == length);
+        out.writeShort((short) utflen);
+
+        if (utflen == length) {
+            out.write((const unsigned char*) value.c_str(), length);
+        } else {
+            std::size_t start = out.buffer.size();
+            out.buffer.resize(start + utflen);
+            ModifiedUTF8::encode((const unsigned char*) value.c_str(), length, &out.buffer[start]);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeLong(Encoder& out, long long value) {
+
+        unsigned long long ul = (unsigned long long) value;
+
+        if (value == 0) {
+            out.writeBoolean(false);
+            out.writeBoolean(false);
+        } else if ((ul & 0xFFFFFFFFFFFF0000ULL) == 0ULL) {
+            out.writeBoolean(false);
+            out.writeBoolean(true);
+            out.writeShort((short) value);
+        } else if ((ul & 0xFFFFFFFF00000000ULL) == 0ULL) {
+            out.writeBoolean(true);
+            out.writeBoolean(false);
+            out.writeInt((int) value);
+        } else {
+            out.writeBoolean(true);
+            out.writeBoolean(true);
+            out.writeLong(value);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeByteArray(Encoder& out, const std::vector<unsigned char>& value) {
+
+        out.writeBoolean(!value.empty());
+        if (!value.empty()) {
+            out.writeInt((int) value.size());
+            out.write(&value[0], value.size());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The nested writers below start with the flags and type byte that
+    // OpenWireFormat::tightMarshalNestedObject1/2 would write.  None of these
+    // types is MarshalAware, so there is no marshaled form flag.
+    bool writeNestedHeader(Encoder& out, const DataStructure* object, unsigned char type) {
+
+        out.writeBoolean(object != NULL);
+        if (object == NULL) {
+            return false;
+        }
+
+        out.writeByte(type);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeConnectionId(Encoder& out, const ConnectionId* id) {
+        if (writeNestedHeader(out, id, ConnectionId::ID_CONNECTIONID)) {
+            writeString(out, id->getValue());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeProducerId(Encoder& out, const ProducerId* id) {
+        if (writeNestedHeader(out, id, ProducerId::ID_PRODUCERID)) {
+            writeString(out, id->getConnectionId());
+            writeLong(out, id->getValue());
+            writeLong(out, id->getSessionId());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeConsumerId(Encoder& out, const ConsumerId* id) {
+        if (writeNestedHeader(out, id, ConsumerId::ID_CONSUMERID)) {
+            writeString(out, id->getConnectionId());
+            writeLong(out, id->getSessionId());
+            writeLong(out, id->getValue());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeBrokerIds(Encoder& out, const std::vector< Pointer<BrokerId> >& ids) {
+
+        out.writeBoolean(!ids.empty());
+        if (ids.empty()) {
+            return;
+        }
+
+        out.writeShort((short) ids.size());
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            const BrokerId* id = ids[i].get();
+            if (writeNestedHeader(out, id, BrokerId::ID_BROKERID)) {
+                writeString(out, id->getValue());
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    bool isDestinationSupported(const ActiveMQDestination* destination) {
+
+        if (destination == NULL) {
+            return true;
+        }
+
+        switch (destination->getDataStructureType()) {
+            case ActiveMQQueue::ID_ACTIVEMQQUEUE:
+            case ActiveMQTopic::ID_ACTIVEMQTOPIC:
+            case ActiveMQTempQueue::ID_ACTIVEMQTEMPQUEUE:
+            case ActiveMQTempTopic::ID_ACTIVEMQTEMPTOPIC:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The four destination types add nothing to ActiveMQDestination's fields.
+    void writeDestination(Encoder& out, const ActiveMQDestination* destination) {
+        if (writeNestedHeader(out, destination, destination == NULL ? 0 : destination->getDataStructureType())) {
+            writeString(out, destination->getPhysicalName());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    bool isTransactionIdSupported(const TransactionId* id) {
+        return id == NULL ||
+               id->getDataStructureType() == LocalTransactionId::ID_LOCALTRANSACTIONID ||
+               id->getDataStructureType() == XATransactionId::ID_XATRANSACTIONID;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeTransactionId(Encoder& out, const TransactionId* id) {
+
+        unsigned char type = id == NULL ? 0 : id->getDataStructureType();
+        if (!writeNestedHeader(out, id, type)) {
+            return;
+        }
+
+        if (type == LocalTransactionId::ID_LOCALTRANSACTIONID) {
+            const LocalTransactionId* local = static_cast<const LocalTransactionId*>(id);
+            writeLong(out, local->getValue());
+            writeConnectionId(out, local->getConnectionId().get());
+        } else {
+            const XATransactionId* xa = static_cast<const XATransactionId*>(id);
+            out.writeInt(xa->getFormatId());
+            writeByteArray(out, xa->getGlobalTransactionId());
+            writeByteArray(out, xa->getBranchQualifier());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    void writeBrokerError(Encoder& out, const OpenWireFormat* wireFormat, const BrokerError* error) {
+
+        out.writeBoolean(error != NULL);
+        if (error == NULL) {
+            return;
+        }
+
+        writeString(out, error->getExceptionClass());
+        writeString(out, error->getMessage());
+
+        if (wireFormat->isStackTraceEnabled()) {
+
+            const std::vector< Pointer<BrokerError::StackTraceElement> >& stackTrace = error->getStackTraceElements();
+
+            out.writeShort((short) stackTrace.size());
+            for (std::size_t i = 0; i < stackTrace.size(); ++i) {
+                writeString(out, stackTrace[i]->ClassName);
+                writeString(out, stackTrace[i]->MethodName);
+                writeString(out, stackTrace[i]->FileName);
+                out.writeInt(stackTrace[i]->LineNumber);
+            }
+
+            writeBrokerError(out, wireFormat, error->getCause().get());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    bool isMessageType(unsigned char type) {
+        return type == ActiveMQMessage::ID_ACTIVEMQMESSAGE ||
+               type == ActiveMQBytesMessage::ID_ACTIVEMQBYTESMESSAGE ||
+               type == ActiveMQMapMessage::ID_ACTIVEMQMAPMESSAGE ||
+               type == ActiveMQObjectMessage::ID_ACTIVEMQOBJECTMESSAGE ||
+               type == ActiveMQStreamMessage::ID_ACTIVEMQSTREAMMESSAGE ||
+               type == ActiveMQTextMessage::ID_ACTIVEMQTEXTMESSAGE ||
+               type == ActiveMQBlobMessage::ID_ACTIVEMQBLOBMESSAGE;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Every ActiveMQ message type except the blob message converts its body to
+    // bytes before it is marshaled, the generated marshallers call these hooks.
+    bool hasMarshalHooks(unsigned char type) {
+        return type != ActiveMQBlobMessage::ID_ACTIVEMQBLOBMESSAGE;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Room for a command's fixed fields and ids plus the message properties, if any.
+    std::size_t estimateSize(const Message* info) {
+        return info == NULL ? 256 : 256 + info->getMarshalledProperties().size();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Message::dataStructure may hold any command, those messages are left to the
+    // generated marshallers along with destination or transaction id types that
+    // aren't encoded here.
+    bool isMessageSupported(const Message* info) {
+        return info->getDataStructure() == NULL &&
+               isDestinationSupported(info->getDestination().get()) &&
+               isDestinationSupported(info->getOriginalDestination().get()) &&
+               isDestinationSupported(info->getReplyTo().get()) &&
+               isTransactionIdSupported(info->getTransactionId().get()) &&
+               isTransactionIdSupported(info->getOriginalTransactionId().get());
+    }
+
+    /**
+     * The encoders whose output depends on the wire version, instantiated once for
+     * each supported version so the version checks fold away.
+     */
+    template<int VERSION>
+    class VersionEncoder {
+    public:
+
+        static void writeMessageId(Encoder& out, const MessageId* id) {
+
+            if (!writeNestedHeader(out, id, MessageId::ID_MESSAGEID)) {
+                return;
+            }
+
+            if (VERSION >= 10) {
+                writeString(out, id->getTextView());
+            }
+            writeProducerId(out, id->getProducerId().get());
+            writeLong(out, id->getProducerSequenceId());
+            writeLong(out, id->getBrokerSequenceId());
+        }
+
+        // The caller runs the marshal hooks around this, the body is referenced
+        // rather than copied so afterMarshal must wait until it has been written.
+        static void writeMessage(Encoder& out, Message* info, unsigned char type) {
+
+            out.writeInt(info->getCommandId());
+            out.writeBoolean(info->isResponseRequired());
+
+            writeProducerId(out, info->getProducerId().get());
+            writeDestination(out, info->getDestination().get());
+            writeTransactionId(out, info->getTransactionId().get());
+            writeDestination(out, info->getOriginalDestination().get());
+            writeMessageId(out, info->getMessageId().get());
+            writeTransactionId(out, info->getOriginalTransactionId().get());
+            writeString(out, info->getGroupID());
+            out.writeInt(info->getGroupSequence());
+            writeString(out, info->getCorrelationId());
+            out.writeBoolean(info->isPersistent());
+            writeLong(out, info->getExpiration());
+            out.writeByte(info->getPriority());
+            writeDestination(out, info->getReplyTo().get());
+            writeLong(out, info->getTimestamp());
+            writeString(out, info->getType());
+
+            int size = info->getContentSize();
+            out.writeBoolean(size != 0);
+            if (size != 0) {
+                out.writeInt(size);
+                out.writeBody(info->getContentData(), size);
+            }
+
+            writeByteArray(out, info->getMarshalledProperties());
+            out.writeBoolean(false);  // dataStructure, isMessageSupported requires it be NULL
+            writeConsumerId(out, info->getTargetConsumerId().get());
+            out.writeBoolean(info->isCompressed());
+            out.writeInt(info->getRedeliveryCounter());
+            writeBrokerIds(out, info->getBrokerPath());
+            writeLong(out, info->getArrival());
+            writeString(out, info->getUserID());
+            out.writeBoolean(info->isRecievedByDFBridge());
+
+            if (VERSION >= 2) {
+                out.writeBoolean(info->isDroppable());
+            }
+            if (VERSION >= 3) {
+                writeBrokerIds(out, info->getCluster());
+                writeLong(out, info->getBrokerInTime());
+                writeLong(out, info->getBrokerOutTime());
+            }
+            if (VERSION >= 10) {
+                out.writeBoolean(info->isJMSXGroupFirstForConsumer());
+            }
+
+            if (VERSION >= 3 && type == ActiveMQBlobMessage::ID_ACTIVEMQBLOBMESSAGE) {
+                ActiveMQBlobMessage* blob = static_cast<ActiveMQBlobMessage*>(info);
+                writeString(out, blob->getRemoteBlobUrl());
+                writeString(out, blob->getMimeType());
+                out.writeBoolean(blob->isDeletedByBroker());
+            }
+        }
+
+        static bool writeMessageDispatch(Encoder& out, OpenWireFormat* wireFormat, MessageDispatch* info) {
+
+            Message* message = info->getMessage().get();
+            unsigned char messageType = message == NULL ? 0 : message->getDataStructureType();
+
+            if (!isDestinationSupported(info->getDestination().get()) ||
+                (message != NULL && (!isMessageType(messageType) || !isMessageSupported(message)))) {
+                return false;
+            }
+
+            // Messages are MarshalAware, a cached marshaled form is written in place
+            // of the fields.  Otherwise the body is converted now so the buffer can
+            // be sized for it before anything is written.
+            std::vector<unsigned char> sequence;
+            bool hooks = false;
+            if (message != NULL) {
+                sequence = message->getMarshaledForm(wireFormat);
+                hooks = sequence.empty() && hasMarshalHooks(messageType);
+                if (hooks) {
+                    message->beforeMarshal(wireFormat);
+                    out.marshaled = message;
+                }
+            }
+
+            out.reserve(estimateSize(message) + sequence.size());
+
+            out.writeInt(info->getCommandId());
+            out.writeBoolean(info->isResponseRequired());
+
+            writeConsumerId(out, info->getConsumerId().get());
+            writeDestination(out, info->getDestination().get());
+
+            out.writeBoolean(message != NULL);
+            if (message != NULL) {
+
+                out.writeByte(messageType);
+                out.writeBoolean(!sequence.empty());
+                if (!sequence.empty()) {
+                    out.write(&sequence[0], sequence.size());
+                } else {
+                    writeMessage(out, message, messageType);
+                }
+            }
+
+            out.writeInt(info->getRedeliveryCounter());
+            return true;
+        }
+
+        static bool writeMessageAck(Encoder& out, OpenWireFormat* wireFormat, MessageAck* info) {
+
+            if (!isDestinationSupported(info->getDestination().get()) ||
+                !isTransactionIdSupported(info->getTransactionId().get())) {
+                return false;
+            }
+
+            out.reserve(estimateSize(NULL));
+
+            out.writeInt(info->getCommandId());
+            out.writeBoolean(info->isResponseRequired());
+
+            writeDestination(out, info->getDestination().get());
+            writeTransactionId(out, info->getTransactionId().get());
+            writeConsumerId(out, info->getConsumerId().get());
+            out.writeByte(info->getAckType());
+            writeMessageId(out, info->getFirstMessageId().get());
+            writeMessageId(out, info->getLastMessageId().get());
+            out.writeInt(info->getMessageCount());
+
+            if (VERSION >= 7) {
+                writeBrokerError(out, wireFormat, info->getPoisonCause().get());
+            }
+
+            return true;
+        }
+
+        static bool write(Encoder& out, OpenWireFormat* wireFormat, DataStructure* command, unsigned char type) {
+
+            if (type == MessageDispatch::ID_MESSAGEDISPATCH) {
+                return writeMessageDispatch(out, wireFormat, static_cast<MessageDispatch*>(command));
+            } else if (type == MessageAck::ID_MESSAGEACK) {
+                return writeMessageAck(out, wireFormat, static_cast<MessageAck*>(command));
+            } else if (isMessageType(type)) {
+                Message* message = static_cast<Message*>(command);
+                if (!isMessageSupported(message)) {
+                    return false;
+                }
+
+                if (hasMarshalHooks(type)) {
+                    message->beforeMarshal(wireFormat);
+                    out.marshaled = message;
+                }
+
+                out.reserve(estimateSize(message));
+                writeMessage(out, message, type);
+                return true;
+            }
+
+            return false;
+        }
+    };
+
+    typedef bool (*VersionWriter)(Encoder&, OpenWireFormat*, DataStructure*, unsigned char);
+
+    // Indexed by wire version, a version without an entry uses the generated marshallers.
+    const VersionWriter VERSION_WRITERS[] = {
+        NULL,
+        &VersionEncoder<1>::write,
+        &VersionEncoder<2>::write,
+        &VersionEncoder<3>::write,
+        &VersionEncoder<4>::write,
+        &VersionEncoder<5>::write,
+        &VersionEncoder<6>::write,
+        &VersionEncoder<7>::write,
+        &VersionEncoder<8>::write,
+        &VersionEncoder<9>::write,
+        &VersionEncoder<10>::write,
+        &VersionEncoder<11>::write
+    };
+
+    const int VERSION_WRITER_COUNT = (int) (sizeof(VERSION_WRITERS) / sizeof(VERSION_WRITERS[0]));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FusedTightMarshaller::marshal(OpenWireFormat* wireFormat, DataStructure* command, DataOutputStream* dataOut) {
+
+    try {
+
+        int version = wireFormat->getVersion();
+        if (version <= 0 || version >= VERSION_WRITER_COUNT) {
+            return false;
+        }
+
+        unsigned char type = command->getDataStructureType();
+
+        Encoder out;
+        if (!VERSION_WRITERS[version](out, wireFormat, command, type)) {
+            return false;
+        }
+
+        if (!wireFormat->isSizePrefixDisabled()) {
+            dataOut->writeInt(1 + out.bs.marshalledSize() + (int) out.size());
+        }
+
+        dataOut->writeByte(type);
+        out.bs.marshal(dataOut);
+
+        // The body is written on its own so that a large one can skip the stream's
+        // buffer and go out in a gathered write, as it does from the generated marshallers.
+        int head = (int) out.bodyOffset;
+        int tail = (int) (out.buffer.size() - out.bodyOffset);
+        if (out.body == NULL) {
+            head = (int) out.buffer.size();
+            tail = 0;
+        }
+
+        if (head > 0) {
+            dataOut->write(&out.buffer[0], head, 0, head);
+        }
+        if (out.body != NULL) {
+            dataOut->write(out.body, (int) out.bodySize, 0, (int) out.bodySize);
+        }
+        if (tail > 0) {
+            dataOut->write(&out.buffer[head], tail, 0, tail);
+        }
+
+        if (out.marshaled != NULL) {
+            out.marshaled->afterMarshal(wireFormat);
+        }
+
+        return true;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
@@ -0,0 +1,85 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_MARSHAL_FUSEDTIGHTMARSHALLER_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_MARSHAL_FUSEDTIGHTMARSHALLER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/commands/DataStructure.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+
+    class OpenWireFormat;
+
+namespace marshal {
+
+    /**
+     * Tight encodes the commands that make up the bulk of the traffic on a busy
+     * connection, the Message family, MessageDispatch and MessageAck, in a single pass.
+     *
+     * The generated marshallers make two passes over a command, the first sizes it and
+     * fills the BooleanStream, the second reads the flags back and writes the fields.
+     * Here the fields are written to a scratch buffer while the flags are collected,
+     * the size prefix, the flags and the buffer are then written out in that order.
+     * The ids, destinations and transaction ids nested in these commands are encoded
+     * by direct calls rather than through the marshaller table, and the fields added
+     * by each wire version are resolved at compile time, one set of encoders is
+     * instantiated for every supported version.
+     *
+     * The output is byte for byte what the generated marshallers produce.  Commands of
+     * any other type, or that carry a nested object this class doesn't encode, are
+     * left to the generated marshallers.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API FusedTightMarshaller {
+    private:
+
+        FusedTightMarshaller();
+        FusedTightMarshaller(const FusedTightMarshaller&);
+        FusedTightMarshaller& operator= (const FusedTightMarshaller&);
+
+    public:
+
+        /**
+         * Tight marshals the command to the output stream at the wire format's current
+         * version, with a size prefix unless the wire format has them disabled.
+         *
+         * @param wireFormat
+         *      The OpenWireFormat whose version and options govern the encoding.
+         * @param command
+         *      The command to marshal.
+         * @param dataOut
+         *      The stream the encoded command is written to.
+         *
+         * @return true if the command was written, false if nothing was written and the
+         *         caller should use the generated marshallers instead.
+         *
+         * @throws IOException if an error occurs while encoding or writing the command.
+         */
+        static bool marshal(OpenWireFormat* wireFormat, commands::DataStructure* command,
+                            decaf::io::DataOutputStream* dataOut);
+
+    };
+
+}}}}
+
+#endif /*_ACTIVEMQ_WIREFORMAT_OPENWIRE_MARSHAL_FUSEDTIGHTMARSHALLER_H_*/
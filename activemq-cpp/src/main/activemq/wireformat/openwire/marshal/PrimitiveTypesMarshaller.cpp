@@ -18,13 +18,15 @@
 #include "PrimitiveTypesMarshaller.h"
 
 #include <decaf/io/ByteArrayInputStream.h>
-#include <decaf/io/ByteArrayOutputStream.h>
 #include <decaf/io/DataInputStream.h>
 #include <decaf/io/DataOutputStream.h>
+#include <decaf/io/UTFDataFormatException.h>
+#include <decaf/internal/util/ModifiedUTF8.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <decaf/lang/Short.h>
 
 #include <memory>
+#include <string.h>
 
 using namespace std;
 using namespace activemq;
@@ -37,26 +39,69 @@ using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::util;
+using decaf::internal::util::ModifiedUTF8;
+
+///////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Big endian writers matching the DataOutputStream encoding.
+
+    unsigned char* putShort(unsigned char* buffer, short value) {
+        buffer[0] = (unsigned char) ((value & 0xFF00) >> 8);
+        buffer[1] = (unsigned char) (value & 0x00FF);
+        return buffer + 2;
+    }
+
+    unsigned char* putInt(unsigned char* buffer, int value) {
+        buffer[0] = (unsigned char) ((value & 0xFF000000) >> 24);
+        buffer[1] = (unsigned char) ((value & 0x00FF0000) >> 16);
+        buffer[2] = (unsigned char) ((value & 0x0000FF00) >> 8);
+        buffer[3] = (unsigned char) (value & 0x000000FF);
+        return buffer + 4;
+    }
+
+    unsigned char* putLong(unsigned char* buffer, long long value) {
+        buffer = putInt(buffer, (int) (value >> 32));
+        return putInt(buffer, (int) (value & 0xFFFFFFFFLL));
+    }
+
+    unsigned char* putBytes(unsigned char* buffer, const unsigned char* data, std::size_t length) {
+        if (length > 0) {
+            memcpy(buffer, data, length);
+        }
+        return buffer + length;
+    }
+
+    std::size_t keyLength(const std::string& key) {
+
+        std::size_t utfLength = ModifiedUTF8::encodedLength((const unsigned char*) key.c_str(), key.length());
+
+        if (utfLength > 65535) {
+            throw UTFDataFormatException(__FILE__, __LINE__, "Attempted to write a string as UTF-8 whose length is longer "
+                    "than the supported 65535 bytes");
+        }
+
+        return utfLength;
+    }
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 void PrimitiveTypesMarshaller::marshal(const PrimitiveMap* map, std::vector<unsigned char>& buffer) {
 
     try {
 
-        ByteArrayOutputStream bytesOut;
-        DataOutputStream dataOut(&bytesOut);
-
         if (map == NULL) {
-            dataOut.writeInt(-1);
-        } else {
-            PrimitiveTypesMarshaller::marshalPrimitiveMap(dataOut, *map);
+            unsigned char nullMarker[4];
+            putInt(nullMarker, -1);
+            buffer.insert(buffer.begin(), nullMarker, nullMarker + 4);
+            return;
         }
 
-        if (bytesOut.size() > 0) {
-            std::pair<unsigned char*, int> array = bytesOut.toByteArray();
-            buffer.insert(buffer.begin(), array.first, array.first + array.second);
-            delete[] array.first;
-        }
+        // Size it exactly up front so the encoding lands in place, ahead of anything
+        // the buffer already held.
+        std::size_t size = (std::size_t) PrimitiveTypesMarshaller::encodedPrimitiveMapSize(*map);
+        buffer.insert(buffer.begin(), size, (unsigned char) 0);
+        PrimitiveTypesMarshaller::encodePrimitiveMap(&buffer[0], *map);
     }
     AMQ_CATCH_RETHROW(decaf::lang::Exception)
     AMQ_CATCHALL_THROW(decaf::lang::Exception)
@@ -87,20 +132,18 @@ void PrimitiveTypesMarshaller::marshal(const PrimitiveList* list, std::vector<un
 
     try {
 
-        ByteArrayOutputStream bytesOut;
-        DataOutputStream dataOut(&bytesOut);
-
         if (list == NULL) {
-            dataOut.writeInt(-1);
-        } else {
-            PrimitiveTypesMarshaller::marshalPrimitiveList(dataOut, *list);
+            unsigned char nullMarker[4];
+            putInt(nullMarker, -1);
+            buffer.insert(buffer.begin(), nullMarker, nullMarker + 4);
+            return;
         }
 
-        if (bytesOut.size() > 0) {
-            std::pair<unsigned char*, int> array = bytesOut.toByteArray();
-            buffer.insert(buffer.begin(), array.first, array.first + array.second);
-            delete[] array.first;
-        }
+        // Size it exactly up front so the encoding lands in place, ahead of anything
+        // the buffer already held.
+        std::size_t size = (std::size_t) PrimitiveTypesMarshaller::encodedPrimitiveListSize(*list);
+        buffer.insert(buffer.begin(), size, (unsigned char) 0);
+        PrimitiveTypesMarshaller::encodePrimitiveList(&buffer[0], *list);
     }
     AMQ_CATCH_RETHROW(decaf::lang::Exception)
     AMQ_CATCHALL_THROW(decaf::lang::Exception)
@@ -444,3 +487,230 @@ PrimitiveValueNode PrimitiveTypesMarshaller::unmarshalPrimitive(io::DataInputStr
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
     AMQ_CATCHALL_THROW(io::IOException)
 }
+
+///////////////////////////////////////////////////////////////////////////////
+int PrimitiveTypesMarshaller::encodedPrimitiveMapSize(const decaf::util::Map<std::string, PrimitiveValueNode>& map) {
+
+    try {
+
+        int size = 4;
+
+        Pointer<Iterator<std::string> > keys(map.keySet().iterator());
+        while (keys->hasNext()) {
+            std::string key = keys->next();
+            size += 2 + (int) keyLength(key);
+            size += encodedPrimitiveSize(map.get(key));
+        }
+
+        return size;
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int PrimitiveTypesMarshaller::encodedPrimitiveListSize(const decaf::util::List<PrimitiveValueNode>& list) {
+
+    try {
+
+        int size = 4;
+
+        for (int ix = 0; ix < list.size(); ++ix) {
+            size += encodedPrimitiveSize(list.get(ix));
+        }
+
+        return size;
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int PrimitiveTypesMarshaller::encodedPrimitiveSize(const PrimitiveValueNode& value) {
+
+    try {
+
+        PrimitiveValueNode::PrimitiveValue primitive = value.getValue();
+
+        switch (value.getType()) {
+
+            case PrimitiveValueNode::BOOLEAN_TYPE:
+            case PrimitiveValueNode::BYTE_TYPE:
+                return 1 + 1;
+            case PrimitiveValueNode::CHAR_TYPE:
+            case PrimitiveValueNode::SHORT_TYPE:
+                return 1 + 2;
+            case PrimitiveValueNode::INTEGER_TYPE:
+            case PrimitiveValueNode::FLOAT_TYPE:
+                return 1 + 4;
+            case PrimitiveValueNode::LONG_TYPE:
+            case PrimitiveValueNode::DOUBLE_TYPE:
+                return 1 + 8;
+            case PrimitiveValueNode::BYTE_ARRAY_TYPE: {
+                int length = primitive.byteArrayValue == NULL ? 0 : (int) primitive.byteArrayValue->size();
+                return 1 + 4 + length;
+            }
+            case PrimitiveValueNode::STRING_TYPE: {
+                int length = primitive.stringValue == NULL ? 0 : (int) primitive.stringValue->size();
+                if (length > Short::MAX_VALUE / 4) {
+                    return 1 + 4 + length;
+                }
+                return 1 + 2 + length;
+            }
+            case PrimitiveValueNode::LIST_TYPE:
+                return 1 + encodedPrimitiveListSize(value.getList());
+            case PrimitiveValueNode::MAP_TYPE:
+                return 1 + encodedPrimitiveMapSize(value.getMap());
+            default:
+                throw IOException(
+                    __FILE__, __LINE__, "Object is not a primitive: ");
+        }
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+unsigned char* PrimitiveTypesMarshaller::encodePrimitiveMap(unsigned char* buffer, const decaf::util::Map<std::string, PrimitiveValueNode>& map) {
+
+    try {
+
+        buffer = putInt(buffer, map.size());
+
+        Pointer<Iterator<std::string> > keys(map.keySet().iterator());
+        while (keys->hasNext()) {
+            std::string key = keys->next();
+
+            std::size_t utfLength = keyLength(key);
+            buffer = putShort(buffer, (short) utfLength);
+
+            if (utfLength == key.length()) {
+                buffer = putBytes(buffer, (const unsigned char*) key.c_str(), utfLength);
+            } else {
+                buffer += ModifiedUTF8::encode((const unsigned char*) key.c_str(), key.length(), buffer);
+            }
+
+            buffer = encodePrimitive(buffer, map.get(key));
+        }
+
+        return buffer;
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+unsigned char* PrimitiveTypesMarshaller::encodePrimitiveList(unsigned char* buffer, const decaf::util::List<PrimitiveValueNode>& list) {
+
+    try {
+
+        buffer = putInt(buffer, list.size());
+
+        for (int ix = 0; ix < list.size(); ++ix) {
+            buffer = encodePrimitive(buffer, list.get(ix));
+        }
+
+        return buffer;
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+unsigned char* PrimitiveTypesMarshaller::encodePrimitive(unsigned char* buffer, const PrimitiveValueNode& value) {
+
+    try {
+
+        PrimitiveValueNode::PrimitiveValue primitive = value.getValue();
+
+        switch (value.getType()) {
+
+            case PrimitiveValueNode::BOOLEAN_TYPE:
+                *buffer++ = PrimitiveValueNode::BOOLEAN_TYPE;
+                *buffer++ = primitive.boolValue ? 1 : 0;
+                break;
+            case PrimitiveValueNode::BYTE_TYPE:
+                *buffer++ = PrimitiveValueNode::BYTE_TYPE;
+                *buffer++ = primitive.byteValue;
+                break;
+            case PrimitiveValueNode::CHAR_TYPE:
+                // Java Char is two bytes, for now we can only send ASCII
+                *buffer++ = PrimitiveValueNode::CHAR_TYPE;
+                *buffer++ = 0;
+                *buffer++ = (unsigned char) primitive.charValue;
+                break;
+            case PrimitiveValueNode::SHORT_TYPE:
+                *buffer++ = PrimitiveValueNode::SHORT_TYPE;
+                buffer = putShort(buffer, primitive.shortValue);
+                break;
+            case PrimitiveValueNode::INTEGER_TYPE:
+                *buffer++ = PrimitiveValueNode::INTEGER_TYPE;
+                buffer = putInt(buffer, primitive.intValue);
+                break;
+            case PrimitiveValueNode::LONG_TYPE:
+                *buffer++ = PrimitiveValueNode::LONG_TYPE;
+                buffer = putLong(buffer, primitive.longValue);
+                break;
+            case PrimitiveValueNode::FLOAT_TYPE: {
+                int bits = 0;
+                memcpy(&bits, &primitive.floatValue, sizeof(float));
+                *buffer++ = PrimitiveValueNode::FLOAT_TYPE;
+                buffer = putInt(buffer, bits);
+                break;
+            }
+            case PrimitiveValueNode::DOUBLE_TYPE: {
+                long long bits = 0;
+                memcpy(&bits, &primitive.doubleValue, sizeof(double));
+                *buffer++ = PrimitiveValueNode::DOUBLE_TYPE;
+                buffer = putLong(buffer, bits);
+                break;
+            }
+            case PrimitiveValueNode::BYTE_ARRAY_TYPE: {
+                *buffer++ = PrimitiveValueNode::BYTE_ARRAY_TYPE;
+                if (primitive.byteArrayValue == NULL || primitive.byteArrayValue->empty()) {
+                    buffer = putInt(buffer, 0);
+                } else {
+                    const std::vector<unsigned char>& data = *primitive.byteArrayValue;
+                    buffer = putInt(buffer, (int) data.size());
+                    buffer = putBytes(buffer, &data[0], data.size());
+                }
+                break;
+            }
+            case PrimitiveValueNode::STRING_TYPE: {
+                int size = primitive.stringValue == NULL ? 0 : (int) primitive.stringValue->size();
+                if (size > Short::MAX_VALUE / 4) {
+                    *buffer++ = PrimitiveValueNode::BIG_STRING_TYPE;
+                    buffer = putInt(buffer, size);
+                } else {
+                    *buffer++ = PrimitiveValueNode::STRING_TYPE;
+                    buffer = putShort(buffer, (short) size);
+                }
+                if (size > 0) {
+                    buffer = putBytes(buffer, (const unsigned char*) primitive.stringValue->c_str(), size);
+                }
+                break;
+            }
+            case PrimitiveValueNode::LIST_TYPE:
+                *buffer++ = PrimitiveValueNode::LIST_TYPE;
+                buffer = encodePrimitiveList(buffer, value.getList());
+                break;
+            case PrimitiveValueNode::MAP_TYPE:
+                *buffer++ = PrimitiveValueNode::MAP_TYPE;
+                buffer = encodePrimitiveMap(buffer, value.getMap());
+                break;
+            default:
+                throw IOException(
+                    __FILE__, __LINE__, "Object is not a primitive: ");
+        }
+
+        return buffer;
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
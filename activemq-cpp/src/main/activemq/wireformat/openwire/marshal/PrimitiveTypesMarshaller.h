@@ -45,7 +45,9 @@ namespace marshal{
         virtual ~PrimitiveTypesMarshaller() {}
 
         /**
-         * Marshal a primitive map object to the given byte buffer.
+         * Marshal a primitive map object to the given byte buffer.  The encoded size is
+         * computed first so the map is written straight into the buffer with no
+         * intermediate stream.
          *
          * @param map
          *      Map to Marshal.
@@ -69,7 +71,9 @@ namespace marshal{
         static void unmarshal( util::PrimitiveMap* map, const std::vector<unsigned char>& buffer );
 
         /**
-         * Marshal a primitive list object to the given byte buffer.
+         * Marshal a primitive list object to the given byte buffer.  The encoded size is
+         * computed first so the list is written straight into the buffer with no
+         * intermediate stream.
          *
          * @param map
          *      The PrimitiveList to Marshal.
@@ -212,6 +216,81 @@ namespace marshal{
          */
         static util::PrimitiveValueNode unmarshalPrimitive( decaf::io::DataInputStream& dataIn );
 
+        /**
+         * Computes the exact number of bytes that marshalPrimitiveMap would write for
+         * the given map, including the leading element count.
+         *
+         * @param map - the Map whose encoded size is computed.
+         * @return the size in bytes of the encoded map.
+         *
+         * @throws IOException if the map contains a value that can't be marshaled.
+         */
+        static int encodedPrimitiveMapSize(
+            const decaf::util::Map<std::string, util::PrimitiveValueNode>& map );
+
+        /**
+         * Computes the exact number of bytes that marshalPrimitiveList would write for
+         * the given list, including the leading element count.
+         *
+         * @param list - the List whose encoded size is computed.
+         * @return the size in bytes of the encoded list.
+         *
+         * @throws IOException if the list contains a value that can't be marshaled.
+         */
+        static int encodedPrimitiveListSize(
+            const decaf::util::List<util::PrimitiveValueNode>& list );
+
+        /**
+         * Computes the exact number of bytes that marshalPrimitive would write for the
+         * given value, including its type tag.
+         *
+         * @param value - the ValueNode whose encoded size is computed.
+         * @return the size in bytes of the encoded value.
+         *
+         * @throws IOException if the value can't be marshaled.
+         */
+        static int encodedPrimitiveSize( const util::PrimitiveValueNode& value );
+
+        /**
+         * Encodes a Map of Primitives into the given buffer using the same format as
+         * marshalPrimitiveMap.  The buffer must have room for encodedPrimitiveMapSize
+         * bytes.
+         *
+         * @param buffer - the location the encoded bytes are written to.
+         * @param map - the Map to encode.
+         * @return the location just past the last byte written.
+         *
+         * @throws IOException if an error occurs while encoding the map.
+         */
+        static unsigned char* encodePrimitiveMap(
+            unsigned char* buffer, const decaf::util::Map<std::string, util::PrimitiveValueNode>& map );
+
+        /**
+         * Encodes a List of Primitives into the given buffer using the same format as
+         * marshalPrimitiveList.  The buffer must have room for encodedPrimitiveListSize
+         * bytes.
+         *
+         * @param buffer - the location the encoded bytes are written to.
+         * @param list - the List to encode.
+         * @return the location just past the last byte written.
+         *
+         * @throws IOException if an error occurs while encoding the list.
+         */
+        static unsigned char* encodePrimitiveList(
+            unsigned char* buffer, const decaf::util::List<util::PrimitiveValueNode>& list );
+
+        /**
+         * Encodes a single Primitive into the given buffer using the same format as
+         * marshalPrimitive.  The buffer must have room for encodedPrimitiveSize bytes.
+         *
+         * @param buffer - the location the encoded bytes are written to.
+         * @param value - the ValueNode to encode.
+         * @return the location just past the last byte written.
+         *
+         * @throws IOException if an error occurs while encoding the value.
+         */
+        static unsigned char* encodePrimitive( unsigned char* buffer, const util::PrimitiveValueNode& value );
+
     };
 
 }}}}
@@ -58,7 +58,7 @@ void ActiveMQBlobMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, D
         MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ActiveMQBlobMessage* info =
-            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+            static_cast<ActiveMQBlobMessage*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -83,7 +83,7 @@ int ActiveMQBlobMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat, Dat
     try {
 
         ActiveMQBlobMessage* info =
-            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+            static_cast<ActiveMQBlobMessage*>(dataStructure);
 
         int rc = MessageMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -114,7 +114,7 @@ void ActiveMQBlobMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Da
         MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ActiveMQBlobMessage* info =
-            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+            static_cast<ActiveMQBlobMessage*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -140,7 +140,7 @@ void ActiveMQBlobMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, D
 
         MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ActiveMQBlobMessage* info =
-            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+            static_cast<ActiveMQBlobMessage*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -165,7 +165,7 @@ void ActiveMQBlobMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, Dat
     try {
 
         ActiveMQBlobMessage* info =
-            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+            static_cast<ActiveMQBlobMessage*>(dataStructure);
         MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
@@ -58,7 +58,7 @@ void ActiveMQBytesMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat,
         MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ActiveMQBytesMessage* info =
-            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+            static_cast<ActiveMQBytesMessage*>(dataStructure);
         info->beforeUnmarshal(wireFormat);
 
 
@@ -75,7 +75,7 @@ int ActiveMQBytesMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat, Da
     try {
 
         ActiveMQBytesMessage* info =
-            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+            static_cast<ActiveMQBytesMessage*>(dataStructure);
 
         info->beforeMarshal(wireFormat);
         int rc = MessageMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
@@ -95,7 +95,7 @@ void ActiveMQBytesMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, D
         MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ActiveMQBytesMessage* info =
-            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+            static_cast<ActiveMQBytesMessage*>(dataStructure);
         info->afterMarshal(wireFormat);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -110,7 +110,7 @@ void ActiveMQBytesMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat,
 
         MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ActiveMQBytesMessage* info =
-            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+            static_cast<ActiveMQBytesMessage*>(dataStructure);
         info->beforeUnmarshal(wireFormat);
         info->afterUnmarshal(wireFormat);
     }
@@ -125,7 +125,7 @@ void ActiveMQBytesMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, Da
     try {
 
         ActiveMQBytesMessage* info =
-            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+            static_cast<ActiveMQBytesMessage*>(dataStructure);
         info->beforeMarshal(wireFormat);
         MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         info->afterMarshal(wireFormat);
@@ -48,7 +48,7 @@ void ActiveMQDestinationMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, D
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ActiveMQDestination* info =
-            dynamic_cast<ActiveMQDestination*>(dataStructure);
+            static_cast<ActiveMQDestination*>(dataStructure);
         info->setPhysicalName(tightUnmarshalString(dataIn, bs));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -62,7 +62,7 @@ int ActiveMQDestinationMarshaller::tightMarshal1(OpenWireFormat* wireFormat, Dat
     try {
 
         ActiveMQDestination* info =
-            dynamic_cast<ActiveMQDestination*>(dataStructure);
+            static_cast<ActiveMQDestination*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalString1(info->getPhysicalName(), bs);
@@ -82,7 +82,7 @@ void ActiveMQDestinationMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Da
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ActiveMQDestination* info =
-            dynamic_cast<ActiveMQDestination*>(dataStructure);
+            static_cast<ActiveMQDestination*>(dataStructure);
         tightMarshalString2(info->getPhysicalName(), dataOut, bs);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -97,7 +97,7 @@ void ActiveMQDestinationMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, D
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ActiveMQDestination* info =
-            dynamic_cast<ActiveMQDestination*>(dataStructure);
+            static_cast<ActiveMQDestination*>(dataStructure);
         info->setPhysicalName(looseUnmarshalString(dataIn));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -111,7 +111,7 @@ void ActiveMQDestinationMarshaller::looseMarshal(OpenWireFormat* wireFormat, Dat
     try {
 
         ActiveMQDestination* info =
-            dynamic_cast<ActiveMQDestination*>(dataStructure);
+            static_cast<ActiveMQDestination*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalString(info->getPhysicalName(), dataOut);
     }
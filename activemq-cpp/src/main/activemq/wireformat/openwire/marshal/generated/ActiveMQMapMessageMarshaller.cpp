@@ -58,7 +58,7 @@ void ActiveMQMapMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, Da
         MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ActiveMQMapMessage* info =
-            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+            static_cast<ActiveMQMapMessage*>(dataStructure);
         info->beforeUnmarshal(wireFormat);
 
 
@@ -75,7 +75,7 @@ int ActiveMQMapMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat, Data
     try {
 
         ActiveMQMapMessage* info =
-            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+            static_cast<ActiveMQMapMessage*>(dataStructure);
 
         info->beforeMarshal(wireFormat);
         int rc = MessageMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
@@ -95,7 +95,7 @@ void ActiveMQMapMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Dat
         MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ActiveMQMapMessage* info =
-            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+            static_cast<ActiveMQMapMessage*>(dataStructure);
         info->afterMarshal(wireFormat);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -110,7 +110,7 @@ void ActiveMQMapMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, Da
 
         MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ActiveMQMapMessage* info =
-            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+            static_cast<ActiveMQMapMessage*>(dataStructure);
         info->beforeUnmarshal(wireFormat);
         info->afterUnmarshal(wireFormat);
     }
@@ -125,7 +125,7 @@ void ActiveMQMapMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, Data
     try {
 
         ActiveMQMapMessage* info =
-            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+            static_cast<ActiveMQMapMessage*>(dataStructure);
         info->beforeMarshal(wireFormat);
         MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         info->afterMarshal(wireFormat);
@@ -58,7 +58,7 @@ void ActiveMQMessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataS
         MessageMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ActiveMQMessage* info =
-            dynamic_cast<ActiveMQMessage*>(dataStructure);
+            static_cast<ActiveMQMessage*>(dataStructure);
         info->beforeUnmarshal(wireFormat);
 
 
@@ -75,7 +75,7 @@ int ActiveMQMessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStr
     try {
 
         ActiveMQMessage* info =
-            dynamic_cast<ActiveMQMessage*>(dataStructure);
+            static_cast<ActiveMQMessage*>(dataStructure);
 
         info->beforeMarshal(wireFormat);
         int rc = MessageMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
@@ -95,7 +95,7 @@ void ActiveMQMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
         MessageMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ActiveMQMessage* info =
-            dynamic_cast<ActiveMQMessage*>(dataStructure);
+            static_cast<ActiveMQMessage*>(dataStructure);
         info->afterMarshal(wireFormat);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -110,7 +110,7 @@ void ActiveMQMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataS
 
         MessageMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ActiveMQMessage* info =
-            dynamic_cast<ActiveMQMessage*>(dataStructure);
+            static_cast<ActiveMQMessage*>(dataStructure);
         info->beforeUnmarshal(wireFormat);
         info->afterUnmarshal(wireFormat);
     }
@@ -125,7 +125,7 @@ void ActiveMQMessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStr
     try {
 
         ActiveMQMessage* info =
-            dynamic_cast<ActiveMQMessage*>(dataStructure);
+            static_cast<ActiveMQMessage*>(dataStructure);
         info->beforeMarshal(wireFormat);
         MessageMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         info->afterMarshal(wireFormat);
@@ -48,7 +48,7 @@ void BaseCommandMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruc
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         BaseCommand* info =
-            dynamic_cast<BaseCommand*>(dataStructure);
+            static_cast<BaseCommand*>(dataStructure);
         info->setCommandId(dataIn->readInt());
         info->setResponseRequired(bs->readBoolean());
     }
@@ -63,7 +63,7 @@ int BaseCommandMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructu
     try {
 
         BaseCommand* info =
-            dynamic_cast<BaseCommand*>(dataStructure);
+            static_cast<BaseCommand*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         bs->writeBoolean(info->isResponseRequired());
@@ -83,7 +83,7 @@ void BaseCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         BaseCommand* info =
-            dynamic_cast<BaseCommand*>(dataStructure);
+            static_cast<BaseCommand*>(dataStructure);
         dataOut->writeInt(info->getCommandId());
         bs->readBoolean();
     }
@@ -99,7 +99,7 @@ void BaseCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruc
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         BaseCommand* info =
-            dynamic_cast<BaseCommand*>(dataStructure);
+            static_cast<BaseCommand*>(dataStructure);
         info->setCommandId(dataIn->readInt());
         info->setResponseRequired(dataIn->readBoolean());
     }
@@ -114,7 +114,7 @@ void BaseCommandMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructu
     try {
 
         BaseCommand* info =
-            dynamic_cast<BaseCommand*>(dataStructure);
+            static_cast<BaseCommand*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         dataOut->writeInt(info->getCommandId());
         dataOut->writeBoolean(info->isResponseRequired());
@@ -58,7 +58,7 @@ void BrokerInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruct
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         BrokerInfo* info =
-            dynamic_cast<BrokerInfo*>(dataStructure);
+            static_cast<BrokerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -107,7 +107,7 @@ int BrokerInfoMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructur
     try {
 
         BrokerInfo* info =
-            dynamic_cast<BrokerInfo*>(dataStructure);
+            static_cast<BrokerInfo*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -151,7 +151,7 @@ void BrokerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         BrokerInfo* info =
-            dynamic_cast<BrokerInfo*>(dataStructure);
+            static_cast<BrokerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -190,7 +190,7 @@ void BrokerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruct
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         BrokerInfo* info =
-            dynamic_cast<BrokerInfo*>(dataStructure);
+            static_cast<BrokerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -239,7 +239,7 @@ void BrokerInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructur
     try {
 
         BrokerInfo* info =
-            dynamic_cast<BrokerInfo*>(dataStructure);
+            static_cast<BrokerInfo*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
@@ -58,7 +58,7 @@ void ConnectionControlMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, Dat
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ConnectionControl* info =
-            dynamic_cast<ConnectionControl*>(dataStructure);
+            static_cast<ConnectionControl*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -91,7 +91,7 @@ int ConnectionControlMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataS
     try {
 
         ConnectionControl* info =
-            dynamic_cast<ConnectionControl*>(dataStructure);
+            static_cast<ConnectionControl*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -131,7 +131,7 @@ void ConnectionControlMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ConnectionControl* info =
-            dynamic_cast<ConnectionControl*>(dataStructure);
+            static_cast<ConnectionControl*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -168,7 +168,7 @@ void ConnectionControlMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, Dat
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ConnectionControl* info =
-            dynamic_cast<ConnectionControl*>(dataStructure);
+            static_cast<ConnectionControl*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -201,7 +201,7 @@ void ConnectionControlMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataS
     try {
 
         ConnectionControl* info =
-            dynamic_cast<ConnectionControl*>(dataStructure);
+            static_cast<ConnectionControl*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
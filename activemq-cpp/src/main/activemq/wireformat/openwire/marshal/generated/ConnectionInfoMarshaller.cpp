@@ -58,7 +58,7 @@ void ConnectionInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataSt
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ConnectionInfo* info =
-            dynamic_cast<ConnectionInfo*>(dataStructure);
+            static_cast<ConnectionInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -104,7 +104,7 @@ int ConnectionInfoMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStru
     try {
 
         ConnectionInfo* info =
-            dynamic_cast<ConnectionInfo*>(dataStructure);
+            static_cast<ConnectionInfo*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -145,7 +145,7 @@ void ConnectionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ConnectionInfo* info =
-            dynamic_cast<ConnectionInfo*>(dataStructure);
+            static_cast<ConnectionInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -181,7 +181,7 @@ void ConnectionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataSt
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ConnectionInfo* info =
-            dynamic_cast<ConnectionInfo*>(dataStructure);
+            static_cast<ConnectionInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -227,7 +227,7 @@ void ConnectionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStru
     try {
 
         ConnectionInfo* info =
-            dynamic_cast<ConnectionInfo*>(dataStructure);
+            static_cast<ConnectionInfo*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
@@ -58,7 +58,7 @@ void ConsumerIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruct
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ConsumerId* info =
-            dynamic_cast<ConsumerId*>(dataStructure);
+            static_cast<ConsumerId*>(dataStructure);
         info->setConnectionId(tightUnmarshalString(dataIn, bs));
         info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
@@ -74,7 +74,7 @@ int ConsumerIdMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructur
     try {
 
         ConsumerId* info =
-            dynamic_cast<ConsumerId*>(dataStructure);
+            static_cast<ConsumerId*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalString1(info->getConnectionId(), bs);
@@ -96,7 +96,7 @@ void ConsumerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ConsumerId* info =
-            dynamic_cast<ConsumerId*>(dataStructure);
+            static_cast<ConsumerId*>(dataStructure);
         tightMarshalString2(info->getConnectionId(), dataOut, bs);
         tightMarshalLong2(wireFormat, info->getSessionId(), dataOut, bs);
         tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
@@ -113,7 +113,7 @@ void ConsumerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruct
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ConsumerId* info =
-            dynamic_cast<ConsumerId*>(dataStructure);
+            static_cast<ConsumerId*>(dataStructure);
         info->setConnectionId(looseUnmarshalString(dataIn));
         info->setSessionId(looseUnmarshalLong(wireFormat, dataIn));
         info->setValue(looseUnmarshalLong(wireFormat, dataIn));
@@ -129,7 +129,7 @@ void ConsumerIdMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructur
     try {
 
         ConsumerId* info =
-            dynamic_cast<ConsumerId*>(dataStructure);
+            static_cast<ConsumerId*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalString(info->getConnectionId(), dataOut);
         looseMarshalLong(wireFormat, info->getSessionId(), dataOut);
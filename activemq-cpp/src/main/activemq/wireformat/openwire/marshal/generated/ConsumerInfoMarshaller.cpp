@@ -58,7 +58,7 @@ void ConsumerInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStru
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ConsumerInfo* info =
-            dynamic_cast<ConsumerInfo*>(dataStructure);
+            static_cast<ConsumerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -120,7 +120,7 @@ int ConsumerInfoMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStruct
     try {
 
         ConsumerInfo* info =
-            dynamic_cast<ConsumerInfo*>(dataStructure);
+            static_cast<ConsumerInfo*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -162,7 +162,7 @@ void ConsumerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ConsumerInfo* info =
-            dynamic_cast<ConsumerInfo*>(dataStructure);
+            static_cast<ConsumerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -202,7 +202,7 @@ void ConsumerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStru
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ConsumerInfo* info =
-            dynamic_cast<ConsumerInfo*>(dataStructure);
+            static_cast<ConsumerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -264,7 +264,7 @@ void ConsumerInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStruct
     try {
 
         ConsumerInfo* info =
-            dynamic_cast<ConsumerInfo*>(dataStructure);
+            static_cast<ConsumerInfo*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
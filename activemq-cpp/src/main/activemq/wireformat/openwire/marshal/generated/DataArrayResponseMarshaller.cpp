@@ -58,7 +58,7 @@ void DataArrayResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, Dat
         ResponseMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         DataArrayResponse* info =
-            dynamic_cast<DataArrayResponse*>(dataStructure);
+            static_cast<DataArrayResponse*>(dataStructure);
 
         if (bs->readBoolean()) {
             short size = dataIn->readShort();
@@ -82,7 +82,7 @@ int DataArrayResponseMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataS
     try {
 
         DataArrayResponse* info =
-            dynamic_cast<DataArrayResponse*>(dataStructure);
+            static_cast<DataArrayResponse*>(dataStructure);
 
         int rc = ResponseMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalObjectArray1(wireFormat, info->getData(), bs);
@@ -102,7 +102,7 @@ void DataArrayResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
         ResponseMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         DataArrayResponse* info =
-            dynamic_cast<DataArrayResponse*>(dataStructure);
+            static_cast<DataArrayResponse*>(dataStructure);
         tightMarshalObjectArray2(wireFormat, info->getData(), dataOut, bs);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -117,7 +117,7 @@ void DataArrayResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, Dat
 
         ResponseMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         DataArrayResponse* info =
-            dynamic_cast<DataArrayResponse*>(dataStructure);
+            static_cast<DataArrayResponse*>(dataStructure);
 
         if (dataIn->readBoolean()) {
             short size = dataIn->readShort();
@@ -141,7 +141,7 @@ void DataArrayResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataS
     try {
 
         DataArrayResponse* info =
-            dynamic_cast<DataArrayResponse*>(dataStructure);
+            static_cast<DataArrayResponse*>(dataStructure);
         ResponseMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalObjectArray(wireFormat, info->getData(), dataOut);
     }
@@ -58,7 +58,7 @@ void DataResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStru
         ResponseMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         DataResponse* info =
-            dynamic_cast<DataResponse*>(dataStructure);
+            static_cast<DataResponse*>(dataStructure);
         info->setData(Pointer<DataStructure>(dynamic_cast<DataStructure* >(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
     }
@@ -73,7 +73,7 @@ int DataResponseMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStruct
     try {
 
         DataResponse* info =
-            dynamic_cast<DataResponse*>(dataStructure);
+            static_cast<DataResponse*>(dataStructure);
 
         int rc = ResponseMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalNestedObject1(wireFormat, info->getData().get(), bs);
@@ -93,7 +93,7 @@ void DataResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
         ResponseMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         DataResponse* info =
-            dynamic_cast<DataResponse*>(dataStructure);
+            static_cast<DataResponse*>(dataStructure);
         tightMarshalNestedObject2(wireFormat, info->getData().get(), dataOut, bs);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -108,7 +108,7 @@ void DataResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStru
 
         ResponseMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         DataResponse* info =
-            dynamic_cast<DataResponse*>(dataStructure);
+            static_cast<DataResponse*>(dataStructure);
         info->setData(Pointer<DataStructure>(dynamic_cast<DataStructure*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
     }
@@ -123,7 +123,7 @@ void DataResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStruct
     try {
 
         DataResponse* info =
-            dynamic_cast<DataResponse*>(dataStructure);
+            static_cast<DataResponse*>(dataStructure);
         ResponseMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalNestedObject(wireFormat, info->getData().get(), dataOut);
     }
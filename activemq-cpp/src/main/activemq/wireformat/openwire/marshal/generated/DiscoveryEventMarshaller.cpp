@@ -58,7 +58,7 @@ void DiscoveryEventMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataSt
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         DiscoveryEvent* info =
-            dynamic_cast<DiscoveryEvent*>(dataStructure);
+            static_cast<DiscoveryEvent*>(dataStructure);
         info->setServiceName(tightUnmarshalString(dataIn, bs));
         info->setBrokerName(tightUnmarshalString(dataIn, bs));
     }
@@ -73,7 +73,7 @@ int DiscoveryEventMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStru
     try {
 
         DiscoveryEvent* info =
-            dynamic_cast<DiscoveryEvent*>(dataStructure);
+            static_cast<DiscoveryEvent*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalString1(info->getServiceName(), bs);
@@ -94,7 +94,7 @@ void DiscoveryEventMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         DiscoveryEvent* info =
-            dynamic_cast<DiscoveryEvent*>(dataStructure);
+            static_cast<DiscoveryEvent*>(dataStructure);
         tightMarshalString2(info->getServiceName(), dataOut, bs);
         tightMarshalString2(info->getBrokerName(), dataOut, bs);
     }
@@ -110,7 +110,7 @@ void DiscoveryEventMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataSt
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         DiscoveryEvent* info =
-            dynamic_cast<DiscoveryEvent*>(dataStructure);
+            static_cast<DiscoveryEvent*>(dataStructure);
         info->setServiceName(looseUnmarshalString(dataIn));
         info->setBrokerName(looseUnmarshalString(dataIn));
     }
@@ -125,7 +125,7 @@ void DiscoveryEventMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStru
     try {
 
         DiscoveryEvent* info =
-            dynamic_cast<DiscoveryEvent*>(dataStructure);
+            static_cast<DiscoveryEvent*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalString(info->getServiceName(), dataOut);
         looseMarshalString(info->getBrokerName(), dataOut);
@@ -58,7 +58,7 @@ void ExceptionResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, Dat
         ResponseMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ExceptionResponse* info =
-            dynamic_cast<ExceptionResponse*>(dataStructure);
+            static_cast<ExceptionResponse*>(dataStructure);
         info->setException(Pointer<BrokerError>(dynamic_cast<BrokerError* >(
             tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
     }
@@ -73,7 +73,7 @@ int ExceptionResponseMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataS
     try {
 
         ExceptionResponse* info =
-            dynamic_cast<ExceptionResponse*>(dataStructure);
+            static_cast<ExceptionResponse*>(dataStructure);
 
         int rc = ResponseMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalBrokerError1(wireFormat, info->getException().get(), bs);
@@ -93,7 +93,7 @@ void ExceptionResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
         ResponseMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ExceptionResponse* info =
-            dynamic_cast<ExceptionResponse*>(dataStructure);
+            static_cast<ExceptionResponse*>(dataStructure);
         tightMarshalBrokerError2(wireFormat, info->getException().get(), dataOut, bs);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -108,7 +108,7 @@ void ExceptionResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, Dat
 
         ResponseMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ExceptionResponse* info =
-            dynamic_cast<ExceptionResponse*>(dataStructure);
+            static_cast<ExceptionResponse*>(dataStructure);
         info->setException(Pointer<BrokerError>(dynamic_cast< BrokerError*>(
             looseUnmarshalBrokerError(wireFormat, dataIn))));
     }
@@ -123,7 +123,7 @@ void ExceptionResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataS
     try {
 
         ExceptionResponse* info =
-            dynamic_cast<ExceptionResponse*>(dataStructure);
+            static_cast<ExceptionResponse*>(dataStructure);
         ResponseMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalBrokerError(wireFormat, info->getException().get(), dataOut);
     }
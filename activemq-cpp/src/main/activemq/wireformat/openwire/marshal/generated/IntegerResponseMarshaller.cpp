@@ -58,7 +58,7 @@ void IntegerResponseMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataS
         ResponseMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         IntegerResponse* info =
-            dynamic_cast<IntegerResponse*>(dataStructure);
+            static_cast<IntegerResponse*>(dataStructure);
         info->setResult(dataIn->readInt());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -88,7 +88,7 @@ void IntegerResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
         ResponseMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         IntegerResponse* info =
-            dynamic_cast<IntegerResponse*>(dataStructure);
+            static_cast<IntegerResponse*>(dataStructure);
         dataOut->writeInt(info->getResult());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -103,7 +103,7 @@ void IntegerResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataS
 
         ResponseMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         IntegerResponse* info =
-            dynamic_cast<IntegerResponse*>(dataStructure);
+            static_cast<IntegerResponse*>(dataStructure);
         info->setResult(dataIn->readInt());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -117,7 +117,7 @@ void IntegerResponseMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStr
     try {
 
         IntegerResponse* info =
-            dynamic_cast<IntegerResponse*>(dataStructure);
+            static_cast<IntegerResponse*>(dataStructure);
         ResponseMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         dataOut->writeInt(info->getResult());
     }
@@ -58,7 +58,7 @@ void JournalQueueAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataS
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         JournalQueueAck* info =
-            dynamic_cast<JournalQueueAck*>(dataStructure);
+            static_cast<JournalQueueAck*>(dataStructure);
         info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
         info->setMessageAck(Pointer<MessageAck>(dynamic_cast<MessageAck* >(
@@ -75,7 +75,7 @@ int JournalQueueAckMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStr
     try {
 
         JournalQueueAck* info =
-            dynamic_cast<JournalQueueAck*>(dataStructure);
+            static_cast<JournalQueueAck*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalNestedObject1(wireFormat, info->getDestination().get(), bs);
@@ -96,7 +96,7 @@ void JournalQueueAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         JournalQueueAck* info =
-            dynamic_cast<JournalQueueAck*>(dataStructure);
+            static_cast<JournalQueueAck*>(dataStructure);
         tightMarshalNestedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
         tightMarshalNestedObject2(wireFormat, info->getMessageAck().get(), dataOut, bs);
     }
@@ -112,7 +112,7 @@ void JournalQueueAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataS
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         JournalQueueAck* info =
-            dynamic_cast<JournalQueueAck*>(dataStructure);
+            static_cast<JournalQueueAck*>(dataStructure);
         info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
         info->setMessageAck(Pointer<MessageAck>(dynamic_cast<MessageAck*>(
@@ -129,7 +129,7 @@ void JournalQueueAckMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStr
     try {
 
         JournalQueueAck* info =
-            dynamic_cast<JournalQueueAck*>(dataStructure);
+            static_cast<JournalQueueAck*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalNestedObject(wireFormat, info->getDestination().get(), dataOut);
         looseMarshalNestedObject(wireFormat, info->getMessageAck().get(), dataOut);
@@ -58,7 +58,7 @@ void JournalTopicAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataS
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         JournalTopicAck* info =
-            dynamic_cast<JournalTopicAck*>(dataStructure);
+            static_cast<JournalTopicAck*>(dataStructure);
         info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
         info->setMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
@@ -80,7 +80,7 @@ int JournalTopicAckMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStr
     try {
 
         JournalTopicAck* info =
-            dynamic_cast<JournalTopicAck*>(dataStructure);
+            static_cast<JournalTopicAck*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalNestedObject1(wireFormat, info->getDestination().get(), bs);
@@ -105,7 +105,7 @@ void JournalTopicAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         JournalTopicAck* info =
-            dynamic_cast<JournalTopicAck*>(dataStructure);
+            static_cast<JournalTopicAck*>(dataStructure);
         tightMarshalNestedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
         tightMarshalNestedObject2(wireFormat, info->getMessageId().get(), dataOut, bs);
         tightMarshalLong2(wireFormat, info->getMessageSequenceId(), dataOut, bs);
@@ -125,7 +125,7 @@ void JournalTopicAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataS
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         JournalTopicAck* info =
-            dynamic_cast<JournalTopicAck*>(dataStructure);
+            static_cast<JournalTopicAck*>(dataStructure);
         info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
         info->setMessageId(Pointer<MessageId>(dynamic_cast<MessageId*>(
@@ -147,7 +147,7 @@ void JournalTopicAckMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStr
     try {
 
         JournalTopicAck* info =
-            dynamic_cast<JournalTopicAck*>(dataStructure);
+            static_cast<JournalTopicAck*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalNestedObject(wireFormat, info->getDestination().get(), dataOut);
         looseMarshalNestedObject(wireFormat, info->getMessageId().get(), dataOut);
@@ -58,7 +58,7 @@ void JournalTraceMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStru
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         JournalTrace* info =
-            dynamic_cast<JournalTrace*>(dataStructure);
+            static_cast<JournalTrace*>(dataStructure);
         info->setMessage(tightUnmarshalString(dataIn, bs));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -72,7 +72,7 @@ int JournalTraceMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStruct
     try {
 
         JournalTrace* info =
-            dynamic_cast<JournalTrace*>(dataStructure);
+            static_cast<JournalTrace*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalString1(info->getMessage(), bs);
@@ -92,7 +92,7 @@ void JournalTraceMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         JournalTrace* info =
-            dynamic_cast<JournalTrace*>(dataStructure);
+            static_cast<JournalTrace*>(dataStructure);
         tightMarshalString2(info->getMessage(), dataOut, bs);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -107,7 +107,7 @@ void JournalTraceMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStru
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         JournalTrace* info =
-            dynamic_cast<JournalTrace*>(dataStructure);
+            static_cast<JournalTrace*>(dataStructure);
         info->setMessage(looseUnmarshalString(dataIn));
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -121,7 +121,7 @@ void JournalTraceMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStruct
     try {
 
         JournalTrace* info =
-            dynamic_cast<JournalTrace*>(dataStructure);
+            static_cast<JournalTrace*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalString(info->getMessage(), dataOut);
     }
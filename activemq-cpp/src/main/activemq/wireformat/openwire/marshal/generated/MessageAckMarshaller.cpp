@@ -58,7 +58,7 @@ void MessageAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruct
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         MessageAck* info =
-            dynamic_cast<MessageAck*>(dataStructure);
+            static_cast<MessageAck*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -90,7 +90,7 @@ int MessageAckMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructur
     try {
 
         MessageAck* info =
-            dynamic_cast<MessageAck*>(dataStructure);
+            static_cast<MessageAck*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -120,7 +120,7 @@ void MessageAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         MessageAck* info =
-            dynamic_cast<MessageAck*>(dataStructure);
+            static_cast<MessageAck*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -147,7 +147,7 @@ void MessageAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruct
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         MessageAck* info =
-            dynamic_cast<MessageAck*>(dataStructure);
+            static_cast<MessageAck*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -179,7 +179,7 @@ void MessageAckMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructur
     try {
 
         MessageAck* info =
-            dynamic_cast<MessageAck*>(dataStructure);
+            static_cast<MessageAck*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
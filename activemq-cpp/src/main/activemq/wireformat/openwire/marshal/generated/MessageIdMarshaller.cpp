@@ -58,7 +58,7 @@ void MessageIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructu
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         MessageId* info =
-            dynamic_cast<MessageId*>(dataStructure);
+            static_cast<MessageId*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -81,7 +81,7 @@ int MessageIdMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructure
     try {
 
         MessageId* info =
-            dynamic_cast<MessageId*>(dataStructure);
+            static_cast<MessageId*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -109,7 +109,7 @@ void MessageIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructur
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         MessageId* info =
-            dynamic_cast<MessageId*>(dataStructure);
+            static_cast<MessageId*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -132,7 +132,7 @@ void MessageIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructu
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         MessageId* info =
-            dynamic_cast<MessageId*>(dataStructure);
+            static_cast<MessageId*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -155,7 +155,7 @@ void MessageIdMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructure
     try {
 
         MessageId* info =
-            dynamic_cast<MessageId*>(dataStructure);
+            static_cast<MessageId*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
@@ -48,7 +48,7 @@ void MessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructure
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         Message* info =
-            dynamic_cast<Message*>(dataStructure);
+            static_cast<Message*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -74,7 +74,7 @@ void MessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructure
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
         info->setTimestamp(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setType(tightUnmarshalString(dataIn, bs));
-        info->setContent(tightUnmarshalByteArray(dataIn, bs));
+        tightUnmarshalMessageContent(wireFormat, info, dataIn, bs);
         info->setMarshalledProperties(tightUnmarshalByteArray(dataIn, bs));
         info->setDataStructure(Pointer<DataStructure>(dynamic_cast<DataStructure* >(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
@@ -133,7 +133,7 @@ int MessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructure*
     try {
 
         Message* info =
-            dynamic_cast<Message*>(dataStructure);
+            static_cast<Message*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -152,8 +152,7 @@ int MessageMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructure*
         rc += tightMarshalNestedObject1(wireFormat, info->getReplyTo().get(), bs);
         rc += tightMarshalLong1(wireFormat, info->getTimestamp(), bs);
         rc += tightMarshalString1(info->getType(), bs);
-        bs->writeBoolean(info->getContent().size() != 0);
-        rc += info->getContent().size() == 0 ? 0 : (int)info->getContent().size() + 4;
+        rc += tightMarshalMessageContent1(info, bs);
         bs->writeBoolean(info->getMarshalledProperties().size() != 0);
         rc += info->getMarshalledProperties().size() == 0 ? 0 : (int)info->getMarshalledProperties().size() + 4;
         rc += tightMarshalNestedObject1(wireFormat, info->getDataStructure().get(), bs);
@@ -194,7 +193,7 @@ void MessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructure*
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         Message* info =
-            dynamic_cast<Message*>(dataStructure);
+            static_cast<Message*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -213,10 +212,7 @@ void MessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructure*
         tightMarshalNestedObject2(wireFormat, info->getReplyTo().get(), dataOut, bs);
         tightMarshalLong2(wireFormat, info->getTimestamp(), dataOut, bs);
         tightMarshalString2(info->getType(), dataOut, bs);
-        if (bs->readBoolean()) {
-            dataOut->writeInt((int)info->getContent().size() );
-            dataOut->write((const unsigned char*)(&info->getContent()[0]), (int)info->getContent().size(), 0, (int)info->getContent().size());
-        }
+        tightMarshalMessageContent2(info, dataOut, bs);
         if (bs->readBoolean()) {
             dataOut->writeInt((int)info->getMarshalledProperties().size() );
             dataOut->write((const unsigned char*)(&info->getMarshalledProperties()[0]), (int)info->getMarshalledProperties().size(), 0, (int)info->getMarshalledProperties().size());
@@ -257,7 +253,7 @@ void MessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         Message* info =
-            dynamic_cast<Message*>(dataStructure);
+            static_cast<Message*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -283,7 +279,7 @@ void MessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure
             looseUnmarshalNestedObject(wireFormat, dataIn))));
         info->setTimestamp(looseUnmarshalLong(wireFormat, dataIn));
         info->setType(looseUnmarshalString(dataIn));
-        info->setContent(looseUnmarshalByteArray(dataIn));
+        looseUnmarshalMessageContent(wireFormat, info, dataIn);
         info->setMarshalledProperties(looseUnmarshalByteArray(dataIn));
         info->setDataStructure(Pointer<DataStructure>(dynamic_cast<DataStructure*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
@@ -342,7 +338,7 @@ void MessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructure*
     try {
 
         Message* info =
-            dynamic_cast<Message*>(dataStructure);
+            static_cast<Message*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
@@ -362,11 +358,7 @@ void MessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructure*
         looseMarshalNestedObject(wireFormat, info->getReplyTo().get(), dataOut);
         looseMarshalLong(wireFormat, info->getTimestamp(), dataOut);
         looseMarshalString(info->getType(), dataOut);
-        dataOut->write( info->getContent().size() != 0 );
-        if( info->getContent().size() != 0 ) {
-            dataOut->writeInt( (int)info->getContent().size() );
-            dataOut->write((const unsigned char*)(&info->getContent()[0]), (int)info->getContent().size(), 0, (int)info->getContent().size());
-        }
+        looseMarshalMessageContent(info, dataOut);
         dataOut->write( info->getMarshalledProperties().size() != 0 );
         if( info->getMarshalledProperties().size() != 0 ) {
             dataOut->writeInt( (int)info->getMarshalledProperties().size() );
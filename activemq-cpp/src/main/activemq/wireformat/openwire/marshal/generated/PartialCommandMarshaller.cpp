@@ -58,7 +58,7 @@ void PartialCommandMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataSt
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         PartialCommand* info =
-            dynamic_cast<PartialCommand*>(dataStructure);
+            static_cast<PartialCommand*>(dataStructure);
         info->setCommandId(dataIn->readInt());
         info->setData(tightUnmarshalByteArray(dataIn, bs));
     }
@@ -73,7 +73,7 @@ int PartialCommandMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStru
     try {
 
         PartialCommand* info =
-            dynamic_cast<PartialCommand*>(dataStructure);
+            static_cast<PartialCommand*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         bs->writeBoolean(info->getData().size() != 0);
@@ -94,7 +94,7 @@ void PartialCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         PartialCommand* info =
-            dynamic_cast<PartialCommand*>(dataStructure);
+            static_cast<PartialCommand*>(dataStructure);
         dataOut->writeInt(info->getCommandId());
         if (bs->readBoolean()) {
             dataOut->writeInt((int)info->getData().size() );
@@ -113,7 +113,7 @@ void PartialCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataSt
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         PartialCommand* info =
-            dynamic_cast<PartialCommand*>(dataStructure);
+            static_cast<PartialCommand*>(dataStructure);
         info->setCommandId(dataIn->readInt());
         info->setData(looseUnmarshalByteArray(dataIn));
     }
@@ -128,7 +128,7 @@ void PartialCommandMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStru
     try {
 
         PartialCommand* info =
-            dynamic_cast<PartialCommand*>(dataStructure);
+            static_cast<PartialCommand*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         dataOut->writeInt(info->getCommandId());
         dataOut->write( info->getData().size() != 0 );
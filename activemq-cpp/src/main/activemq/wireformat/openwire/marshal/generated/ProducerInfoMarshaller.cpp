@@ -58,7 +58,7 @@ void ProducerInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStru
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ProducerInfo* info =
-            dynamic_cast<ProducerInfo*>(dataStructure);
+            static_cast<ProducerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -95,7 +95,7 @@ int ProducerInfoMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStruct
     try {
 
         ProducerInfo* info =
-            dynamic_cast<ProducerInfo*>(dataStructure);
+            static_cast<ProducerInfo*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -125,7 +125,7 @@ void ProducerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ProducerInfo* info =
-            dynamic_cast<ProducerInfo*>(dataStructure);
+            static_cast<ProducerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -151,7 +151,7 @@ void ProducerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStru
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ProducerInfo* info =
-            dynamic_cast<ProducerInfo*>(dataStructure);
+            static_cast<ProducerInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -188,7 +188,7 @@ void ProducerInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStruct
     try {
 
         ProducerInfo* info =
-            dynamic_cast<ProducerInfo*>(dataStructure);
+            static_cast<ProducerInfo*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
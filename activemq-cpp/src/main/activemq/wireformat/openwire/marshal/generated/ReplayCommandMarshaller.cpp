@@ -58,7 +58,7 @@ void ReplayCommandMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStr
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         ReplayCommand* info =
-            dynamic_cast<ReplayCommand*>(dataStructure);
+            static_cast<ReplayCommand*>(dataStructure);
         info->setFirstNakNumber(dataIn->readInt());
         info->setLastNakNumber(dataIn->readInt());
     }
@@ -89,7 +89,7 @@ void ReplayCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStru
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         ReplayCommand* info =
-            dynamic_cast<ReplayCommand*>(dataStructure);
+            static_cast<ReplayCommand*>(dataStructure);
         dataOut->writeInt(info->getFirstNakNumber());
         dataOut->writeInt(info->getLastNakNumber());
     }
@@ -105,7 +105,7 @@ void ReplayCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStr
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         ReplayCommand* info =
-            dynamic_cast<ReplayCommand*>(dataStructure);
+            static_cast<ReplayCommand*>(dataStructure);
         info->setFirstNakNumber(dataIn->readInt());
         info->setLastNakNumber(dataIn->readInt());
     }
@@ -120,7 +120,7 @@ void ReplayCommandMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStruc
     try {
 
         ReplayCommand* info =
-            dynamic_cast<ReplayCommand*>(dataStructure);
+            static_cast<ReplayCommand*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         dataOut->writeInt(info->getFirstNakNumber());
         dataOut->writeInt(info->getLastNakNumber());
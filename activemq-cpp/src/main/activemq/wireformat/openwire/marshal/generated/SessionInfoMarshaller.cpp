@@ -58,7 +58,7 @@ void SessionInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruc
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         SessionInfo* info =
-            dynamic_cast<SessionInfo*>(dataStructure);
+            static_cast<SessionInfo*>(dataStructure);
         info->setSessionId(Pointer<SessionId>(dynamic_cast<SessionId* >(
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
     }
@@ -73,7 +73,7 @@ int SessionInfoMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStructu
     try {
 
         SessionInfo* info =
-            dynamic_cast<SessionInfo*>(dataStructure);
+            static_cast<SessionInfo*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalCachedObject1(wireFormat, info->getSessionId().get(), bs);
@@ -93,7 +93,7 @@ void SessionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         SessionInfo* info =
-            dynamic_cast<SessionInfo*>(dataStructure);
+            static_cast<SessionInfo*>(dataStructure);
         tightMarshalCachedObject2(wireFormat, info->getSessionId().get(), dataOut, bs);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -108,7 +108,7 @@ void SessionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruc
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         SessionInfo* info =
-            dynamic_cast<SessionInfo*>(dataStructure);
+            static_cast<SessionInfo*>(dataStructure);
         info->setSessionId(Pointer<SessionId>(dynamic_cast<SessionId*>(
             looseUnmarshalCachedObject(wireFormat, dataIn))));
     }
@@ -123,7 +123,7 @@ void SessionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructu
     try {
 
         SessionInfo* info =
-            dynamic_cast<SessionInfo*>(dataStructure);
+            static_cast<SessionInfo*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalCachedObject(wireFormat, info->getSessionId().get(), dataOut);
     }
@@ -58,7 +58,7 @@ void SubscriptionInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, Data
         BaseDataStreamMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         SubscriptionInfo* info =
-            dynamic_cast<SubscriptionInfo*>(dataStructure);
+            static_cast<SubscriptionInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -86,7 +86,7 @@ int SubscriptionInfoMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataSt
     try {
 
         SubscriptionInfo* info =
-            dynamic_cast<SubscriptionInfo*>(dataStructure);
+            static_cast<SubscriptionInfo*>(dataStructure);
 
         int rc = BaseDataStreamMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
 
@@ -118,7 +118,7 @@ void SubscriptionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataS
         BaseDataStreamMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         SubscriptionInfo* info =
-            dynamic_cast<SubscriptionInfo*>(dataStructure);
+            static_cast<SubscriptionInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -145,7 +145,7 @@ void SubscriptionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, Data
 
         BaseDataStreamMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         SubscriptionInfo* info =
-            dynamic_cast<SubscriptionInfo*>(dataStructure);
+            static_cast<SubscriptionInfo*>(dataStructure);
 
         int wireVersion = wireFormat->getVersion();
 
@@ -173,7 +173,7 @@ void SubscriptionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataSt
     try {
 
         SubscriptionInfo* info =
-            dynamic_cast<SubscriptionInfo*>(dataStructure);
+            static_cast<SubscriptionInfo*>(dataStructure);
         BaseDataStreamMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
 
         int wireVersion = wireFormat->getVersion();
@@ -58,7 +58,7 @@ void TransactionInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataS
         BaseCommandMarshaller::tightUnmarshal(wireFormat, dataStructure, dataIn, bs);
 
         TransactionInfo* info =
-            dynamic_cast<TransactionInfo*>(dataStructure);
+            static_cast<TransactionInfo*>(dataStructure);
         info->setConnectionId(Pointer<ConnectionId>(dynamic_cast<ConnectionId* >(
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
         info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
@@ -76,7 +76,7 @@ int TransactionInfoMarshaller::tightMarshal1(OpenWireFormat* wireFormat, DataStr
     try {
 
         TransactionInfo* info =
-            dynamic_cast<TransactionInfo*>(dataStructure);
+            static_cast<TransactionInfo*>(dataStructure);
 
         int rc = BaseCommandMarshaller::tightMarshal1(wireFormat, dataStructure, bs);
         rc += tightMarshalCachedObject1(wireFormat, info->getConnectionId().get(), bs);
@@ -97,7 +97,7 @@ void TransactionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
         BaseCommandMarshaller::tightMarshal2(wireFormat, dataStructure, dataOut, bs );
 
         TransactionInfo* info =
-            dynamic_cast<TransactionInfo*>(dataStructure);
+            static_cast<TransactionInfo*>(dataStructure);
         tightMarshalCachedObject2(wireFormat, info->getConnectionId().get(), dataOut, bs);
         tightMarshalCachedObject2(wireFormat, info->getTransactionId().get(), dataOut, bs);
         dataOut->write(info->getType());
@@ -114,7 +114,7 @@ void TransactionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataS
 
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         TransactionInfo* info =
-            dynamic_cast<TransactionInfo*>(dataStructure);
+            static_cast<TransactionInfo*>(dataStructure);
         info->setConnectionId(Pointer<ConnectionId>(dynamic_cast<ConnectionId*>(
             looseUnmarshalCachedObject(wireFormat, dataIn))));
         info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId*>(
@@ -132,7 +132,7 @@ void TransactionInfoMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStr
     try {
 
         TransactionInfo* info =
-            dynamic_cast<TransactionInfo*>(dataStructure);
+            static_cast<TransactionInfo*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
         looseMarshalCachedObject(wireFormat, info->getConnectionId().get(), dataOut);
         looseMarshalCachedObject(wireFormat, info->getTransactionId().get(), dataOut);
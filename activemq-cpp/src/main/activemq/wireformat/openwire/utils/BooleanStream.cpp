@@ -32,8 +32,9 @@ using namespace decaf::lang::exceptions;
 ///////////////////////////////////////////////////////////////////////////////
 BooleanStream::BooleanStream() : data(), arrayLimit(0), arrayPos(0), bytePos(0) {
 
-    // Reserve 1K
-    this->data.resize( 1000, 0 );
+    // A command rarely needs more than a handful of bytes of flags, writeBoolean
+    // doubles the buffer on the odd occasion it does.
+    this->data.resize( 32, 0 );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -20,10 +20,9 @@
 #include <string>
 
 #include <decaf/lang/exceptions/NullPointerException.h>
-#include <decaf/lang/Character.h>
-#include <decaf/lang/Integer.h>
 
 #include <activemq/wireformat/stomp/StompCommandConstants.h>
+#include <activemq/wireformat/stomp/StompFrameReader.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
 using namespace std;
@@ -37,7 +36,7 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-StompFrame::StompFrame() : command(), properties(), body() {
+StompFrame::StompFrame() : command(), properties(), headerData(), headerViews(), viewsActive(false), body() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -55,10 +54,127 @@ StompFrame* StompFrame::clone() const {
 void StompFrame::copy(const StompFrame* src) {
 
     this->setCommand(src->getCommand());
-    this->properties = src->getProperties();
+    this->clearHeaders();
+
+    if (src->viewsActive) {
+        this->headerData = src->headerData;
+        this->headerViews = src->headerViews;
+        this->viewsActive = true;
+    } else {
+        this->properties = src->properties;
+    }
+
     this->body = src->getBody();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool StompFrame::hasProperty(const std::string& name) const {
+
+    if (this->viewsActive) {
+        return findHeaderView(name) != NULL;
+    }
+
+    return this->properties.hasProperty(name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string StompFrame::getProperty(const std::string& name, const std::string& fallback) const {
+
+    if (this->viewsActive) {
+        const HeaderView* view = findHeaderView(name);
+        if (view == NULL) {
+            return fallback;
+        }
+
+        return this->headerData.substr(view->valueOffset, view->valueLength);
+    }
+
+    return this->properties.getProperty(name, fallback);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector< std::pair<std::string, std::string> > StompFrame::propertiesToArray() const {
+
+    if (!this->viewsActive) {
+        return this->properties.toArray();
+    }
+
+    std::vector< std::pair<std::string, std::string> > result;
+    result.reserve(this->headerViews.size());
+
+    std::vector<HeaderView>::const_iterator iter = this->headerViews.begin();
+    for (; iter != this->headerViews.end(); ++iter) {
+        result.push_back(std::make_pair(
+            this->headerData.substr(iter->keyOffset, iter->keyLength),
+            this->headerData.substr(iter->valueOffset, iter->valueLength)));
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrame::clearHeaders() {
+    this->properties.clear();
+    this->headerData.clear();
+    this->headerViews.clear();
+    this->viewsActive = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrame::addHeaderView(std::size_t lineStart, std::size_t separator, std::size_t lineEnd) {
+
+    HeaderView view;
+    view.keyOffset = lineStart;
+    view.keyLength = separator - lineStart;
+    view.valueOffset = separator + 1;
+    view.valueLength = lineEnd - separator - 1;
+
+    // Stomp defines that the first occurrence of a repeated header wins.
+    std::vector<HeaderView>::const_iterator iter = this->headerViews.begin();
+    for (; iter != this->headerViews.end(); ++iter) {
+        if (iter->keyLength == view.keyLength &&
+            this->headerData.compare(iter->keyOffset, iter->keyLength, this->headerData, view.keyOffset, view.keyLength) == 0) {
+            return;
+        }
+    }
+
+    this->headerViews.push_back(view);
+    this->viewsActive = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const StompFrame::HeaderView* StompFrame::findHeaderView(const std::string& name) const {
+
+    std::vector<HeaderView>::const_iterator iter = this->headerViews.begin();
+    for (; iter != this->headerViews.end(); ++iter) {
+        if (iter->keyLength == name.length() &&
+            this->headerData.compare(iter->keyOffset, iter->keyLength, name) == 0) {
+            return &(*iter);
+        }
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrame::materializeHeaders() const {
+
+    if (!this->viewsActive) {
+        return;
+    }
+
+    std::vector<HeaderView>::const_iterator iter = this->headerViews.begin();
+    for (; iter != this->headerViews.end(); ++iter) {
+        this->properties.setProperty(
+            this->headerData.substr(iter->keyOffset, iter->keyLength),
+            this->headerData.substr(iter->valueOffset, iter->valueLength));
+    }
+
+    this->viewsActive = false;
+    this->headerViews.clear();
+    this->headerData.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void StompFrame::setBody(const unsigned char* bytes, std::size_t numBytes) {
 
@@ -83,7 +199,7 @@ void StompFrame::toStream(decaf::io::DataOutputStream* stream) const {
     stream->write('\n');
 
     // Write all the headers.
-    vector<pair<string, string> > headers = this->getProperties().toArray();
+    vector<pair<string, string> > headers = this->propertiesToArray();
     for (std::size_t ix = 0; ix < headers.size(); ++ix) {
         string& name = headers[ix].first;
         string& value = headers[ix].second;
@@ -121,204 +237,8 @@ void StompFrame::fromStream(decaf::io::DataInputStream* in) {
     }
 
     try {
-
-        // Read the command header.
-        readCommandHeader(in);
-
-        // Read the headers.
-        readHeaders(in);
-
-        // Read the body.
-        readBody(in);
-    }
-    AMQ_CATCH_RETHROW(decaf::io::IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
-    AMQ_CATCHALL_THROW(decaf::io::IOException)
-}
-
-////////////////////////////////////////////////////////////////////////////////
-void StompFrame::readCommandHeader(decaf::io::DataInputStream* in) {
-
-    try {
-
-        std::vector<unsigned char> buffer;
-
-        while (true) {
-
-            // The command header is formatted just like any other stomp header.
-            readHeaderLine(buffer, in);
-
-            // Ignore all white space before the command.
-            long long offset = -1;
-            for (size_t ix = 0; ix < buffer.size() - 1; ++ix) {
-
-                // Find the first non whitespace character
-                if (!Character::isWhitespace(buffer[ix])) {
-                    offset = (long long) ix;
-                    break;
-                }
-            }
-
-            if (offset >= 0) {
-                // Set the command in the frame - copy the memory.
-                this->setCommand(reinterpret_cast<char*>(&buffer[(size_t) offset]));
-                break;
-            }
-        }
-    }
-    AMQ_CATCH_RETHROW(decaf::io::IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
-    AMQ_CATCHALL_THROW(decaf::io::IOException)
-}
-
-////////////////////////////////////////////////////////////////////////////////
-void StompFrame::readHeaders(decaf::io::DataInputStream* in) {
-
-    try {
-
-        // Read the command;
-        bool endOfHeaders = false;
-        std::vector<unsigned char> buffer;
-
-        while (!endOfHeaders) {
-
-            // Read in the next header line.
-            std::size_t numChars = readHeaderLine(buffer, in);
-
-            if (numChars == 0) {
-
-                // should never get here
-                throw decaf::io::IOException(__FILE__, __LINE__, "StompWireFormat::readStompHeaders: no characters read");
-            }
-
-            // Check for an empty line to demark the end of the header section.
-            // if its not the end then we have a header to process, so parse it.
-            if (numChars == 1 && buffer[0] == '\0') {
-                endOfHeaders = true;
-            } else {
-
-                // Search through this line to separate the key/value pair.
-                for (size_t ix = 0; ix < buffer.size(); ++ix) {
-
-                    // If found the key/value separator...
-                    if (buffer[ix] == ':') {
-
-                        // Null-terminate the key.
-                        buffer[ix] = '\0';
-
-                        const char* key = reinterpret_cast<char*>(&buffer[0]);
-                        const char* value = reinterpret_cast<char*>(&buffer[ix + 1]);
-
-                        // Assign the header key/value pair.
-                        if (!this->getProperties().hasProperty(key)) {
-                            this->getProperties().setProperty(key, value);
-                        }
-
-                        // Break out of the for loop.
-                        break;
-                    }
-                }
-            }
-        }
-    }
-    AMQ_CATCH_RETHROW(decaf::io::IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
-    AMQ_CATCHALL_THROW(decaf::io::IOException)
-}
-
-////////////////////////////////////////////////////////////////////////////////
-std::size_t StompFrame::readHeaderLine(std::vector<unsigned char>& buffer, decaf::io::DataInputStream* in) {
-
-    try {
-
-        // Clear any data from the buffer.
-        buffer.clear();
-
-        std::size_t count = 0;
-
-        while (true) {
-
-            // Read the next char from the stream.
-            buffer.push_back(in->readByte());
-
-            // Increment the position pointer.
-            count++;
-
-            // If we reached the line terminator, return the total number
-            // of characters read.
-            if (buffer[count - 1] == '\n') {
-                // Overwrite the line feed with a null character.
-                buffer[count - 1] = '\0';
-                return count;
-            }
-        }
-
-        // If we get here something bad must have happened.
-        throw decaf::io::IOException(__FILE__, __LINE__, "StompWireFormat::readStompHeaderLine: "
-                "Unrecoverable, error condition");
-    }
-    AMQ_CATCH_RETHROW(decaf::io::IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
-    AMQ_CATCHALL_THROW(decaf::io::IOException)
-}
-
-////////////////////////////////////////////////////////////////////////////////
-void StompFrame::readBody(decaf::io::DataInputStream* in) {
-
-    try {
-
-        // Clear any data from the body.
-        this->body.clear();
-
-        unsigned int content_length = 0;
-
-        if (this->hasProperty(StompCommandConstants::HEADER_CONTENTLENGTH)) {
-            string length = this->getProperty(StompCommandConstants::HEADER_CONTENTLENGTH);
-            content_length = (unsigned int) Integer::parseInt(length);
-        }
-
-        if (content_length != 0) {
-            // For this case its assumed that content length indicates how
-            // much to read.  We reserve space in the buffer for it to
-            // minimize the number of reallocs that might occur.  We are
-            // assuming that content length doesn't count the trailing null
-            // that indicates the end of frame.  The reserve won't do anything
-            // if the buffer already has that much capacity.  The resize call
-            // basically sets the end iterator to the correct location since
-            // this is a char vector and we already reserve enough space.
-            // Resize doesn't realloc the vector smaller if content_length
-            // is less than capacity of the buffer, it just move the end
-            // iterator.  Reserve adds the benefit that the mem is set to
-            // zero.
-
-            this->body.reserve((std::size_t) content_length);
-            this->body.resize((std::size_t) content_length);
-
-            // Read the Content Length now
-            in->readFully(&body[0], (int) body.size());
-
-            // Content Length read, now pop the end terminator off (\0\n).
-            if (in->readByte() != '\0') {
-                throw decaf::io::IOException(__FILE__, __LINE__, "StompWireFormat::readStompBody: "
-                        "Read Content Length, and no trailing null");
-            }
-
-        } else {
-
-            // Content length was either zero, or not set, so we read until the
-            // first null is encountered.
-            while (true) {
-
-                char byte = in->readByte();
-                this->body.push_back(byte);
-
-                if (byte != '\0') {
-                    continue;
-                }
-
-                break; // Read null and newline we are done.
-            }
-        }
+        StompFrameReader reader(false);
+        reader.readFrame(*this, in);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
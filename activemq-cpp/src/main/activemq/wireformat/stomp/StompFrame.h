@@ -21,6 +21,7 @@
 #include <string>
 #include <string.h>
 #include <map>
+#include <vector>
 #include <decaf/util/Properties.h>
 #include <decaf/io/DataOutputStream.h>
 #include <decaf/io/DataInputStream.h>
@@ -30,21 +31,50 @@ namespace activemq {
 namespace wireformat {
 namespace stomp {
 
+    class StompFrameReader;
+
     /**
      * A Stomp-level message frame that encloses all messages to and from the broker.
+     *
+     * Frames that are read from the wire keep their headers as a single block of raw
+     * header bytes plus a list of key / value views into that block, lookups made through
+     * hasProperty and getProperty are answered from the views directly.  The headers are
+     * only copied into a Properties instance when the caller asks for the Properties
+     * object or modifies the headers.
      */
     class AMQCPP_API StompFrame {
     private:
 
+        /**
+         * Offsets of a single header key and value within the raw header block.
+         */
+        struct HeaderView {
+            std::size_t keyOffset;
+            std::size_t keyLength;
+            std::size_t valueOffset;
+            std::size_t valueLength;
+        };
+
         // String Name of this command.
         std::string command;
 
-        // Properties of the Stomp Message
-        decaf::util::Properties properties;
+        // Properties of the Stomp Message, populated lazily for frames read from the wire.
+        mutable decaf::util::Properties properties;
+
+        // Raw header lines of a frame read from the wire, without the line terminators.
+        mutable std::string headerData;
+
+        // Views of the unique headers contained in the header block, in arrival order.
+        mutable std::vector<HeaderView> headerViews;
+
+        // True while the header views are the authoritative copy of the headers.
+        mutable bool viewsActive;
 
         // Byte data of Body.
         std::vector<unsigned char> body;
 
+        friend class StompFrameReader;
+
     public:
 
         /**
@@ -90,9 +120,7 @@ namespace stomp {
          *
          * @param name - The name of the property to check for.
          */
-        bool hasProperty(const std::string& name) const {
-            return this->properties.hasProperty(name);
-        }
+        bool hasProperty(const std::string& name) const;
 
         /**
          * Gets a property from this Frame's properties and returns it, or the
@@ -103,9 +131,7 @@ namespace stomp {
          *
          * @return string value of the property asked for.
          */
-        std::string getProperty(const std::string& name, const std::string& fallback = "") const {
-            return this->properties.getProperty(name, fallback);
-        }
+        std::string getProperty(const std::string& name, const std::string& fallback = "") const;
 
         /**
          * Gets and remove the property specified, if the property is not set, this method
@@ -114,7 +140,7 @@ namespace stomp {
          * @param name - the Name of the property to get and return.
          */
         std::string removeProperty(const std::string& name) {
-            return this->properties.getProperty(name, "");
+            return this->getProperty(name, "");
         }
 
         /**
@@ -124,6 +150,7 @@ namespace stomp {
          * @param value - Value to set the property to.
          */
         void setProperty(const std::string& name, const std::string& value) {
+            this->materializeHeaders();
             this->properties.setProperty(name, value);
         }
 
@@ -132,12 +159,23 @@ namespace stomp {
          * @return the Properties object owned by this Frame
          */
         decaf::util::Properties& getProperties() {
+            this->materializeHeaders();
             return properties;
         }
         const decaf::util::Properties& getProperties() const {
+            this->materializeHeaders();
             return properties;
         }
 
+        /**
+         * Returns a copy of all the headers in this frame as key / value pairs, for frames
+         * read from the wire this is built from the header views without populating the
+         * Properties object.
+         *
+         * @return a vector containing all the header key / value pairs.
+         */
+        std::vector< std::pair<std::string, std::string> > propertiesToArray() const;
+
         /**
          * Accessor for the body data of this frame.
          * @return char pointer to body data
@@ -180,6 +218,10 @@ namespace stomp {
         /**
          * Reads a Stop Frame from a DataInputStream in the Stomp Wire format.
          *
+         * This method never consumes bytes beyond the end of the frame, so it must
+         * fall back to reading the header section a byte at a time.  Readers that own
+         * the stream should use a StompFrameReader which reads ahead in bulk.
+         *
          * @param stream - The stream to read the Frame from.
          *
          * @throw IOException if an error occurs while writing the Frame.
@@ -188,35 +230,13 @@ namespace stomp {
 
     private:
 
-        /**
-         * Read the Stomp Command from the Frame
-         * @param in - The stream to read the Frame from.
-         * @throws IOException
-         */
-        void readCommandHeader(decaf::io::DataInputStream* in);
+        void clearHeaders();
 
-        /**
-         * Read all the Stomp Headers for the incoming Frame
-         * @param in - The stream to read the Frame from.
-         * @throws IOException
-         */
-        void readHeaders(decaf::io::DataInputStream* in);
+        void addHeaderView(std::size_t lineStart, std::size_t separator, std::size_t lineEnd);
 
-        /**
-         * Reads a Stomp Header line and stores it in the buffer object
-         * @param buffer - reference to a memory buffer to store the read line in.
-         * @param in - The stream to read the Frame from.
-         * @return number of bytes read, zero if there was a problem.
-         * @throws IOException
-         */
-        std::size_t readHeaderLine(std::vector<unsigned char>& buffer, decaf::io::DataInputStream* in);
+        const HeaderView* findHeaderView(const std::string& name) const;
 
-        /**
-         * Reads the Stomp Body from the Wire and store it in the frame.
-         * @param in - The stream to read the Frame from.
-         * @throws IOException
-         */
-        void readBody(decaf::io::DataInputStream* in);
+        void materializeHeaders() const;
 
     };
 
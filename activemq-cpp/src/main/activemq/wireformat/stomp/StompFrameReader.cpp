@@ -0,0 +1,243 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StompFrameReader.h"
+
+#include <activemq/wireformat/stomp/StompCommandConstants.h>
+#include <activemq/exceptions/ExceptionDefines.h>
+
+#include <decaf/io/EOFException.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/Character.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+
+#include <string.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::stomp;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+const int StompFrameReader::DEFAULT_BUFFER_SIZE = 8192;
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameReader::StompFrameReader(bool readAhead, int bufferSize) :
+    buffer(), position(0), limit(0), readAhead(readAhead), source(NULL) {
+
+    this->buffer.resize(readAhead && bufferSize > 0 ? (std::size_t) bufferSize : 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameReader::~StompFrameReader() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReader::reset() {
+    this->position = 0;
+    this->limit = 0;
+    this->source = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReader::readFrame(StompFrame& frame, decaf::io::InputStream* in) {
+
+    if (in == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "InputStream passed is NULL");
+    }
+
+    try {
+
+        if (this->source != in) {
+            this->reset();
+            this->source = in;
+        }
+
+        frame.clearHeaders();
+        frame.getBody().clear();
+
+        readCommand(frame, in);
+        readHeaders(frame, in);
+        readBody(frame, in);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReader::fill(decaf::io::InputStream* in) {
+
+    this->position = 0;
+    this->limit = 0;
+
+    int size = (int) this->buffer.size();
+    int result = in->read(&this->buffer[0], size, 0, size);
+
+    if (result == -1) {
+        throw EOFException(__FILE__, __LINE__, "StompFrameReader::fill - Reached EOF");
+    }
+
+    this->limit = (std::size_t) result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReader::readLine(std::string& line, decaf::io::InputStream* in) {
+
+    while (true) {
+
+        if (this->position == this->limit) {
+            fill(in);
+        }
+
+        const char* start = reinterpret_cast<const char*>(&this->buffer[this->position]);
+        std::size_t length = this->limit - this->position;
+        const char* terminator = static_cast<const char*>(::memchr(start, '\n', length));
+
+        if (terminator != NULL) {
+            length = (std::size_t) (terminator - start);
+            line.append(start, length);
+            this->position += length + 1;
+            return;
+        }
+
+        line.append(start, length);
+        this->position = this->limit;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReader::readCommand(StompFrame& frame, decaf::io::InputStream* in) {
+
+    std::string line;
+
+    while (true) {
+
+        line.clear();
+        readLine(line, in);
+
+        // Ignore all white space before the command, which includes the blank
+        // lines some brokers send between frames.
+        for (std::size_t ix = 0; ix < line.length(); ++ix) {
+            if (!Character::isWhitespace(line[ix])) {
+                frame.setCommand(line.substr(ix));
+                return;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReader::readHeaders(StompFrame& frame, decaf::io::InputStream* in) {
+
+    std::string& data = frame.headerData;
+
+    while (true) {
+
+        std::size_t lineStart = data.length();
+        readLine(data, in);
+        std::size_t lineEnd = data.length();
+
+        // An empty line marks the end of the header section.
+        if (lineEnd == lineStart) {
+            break;
+        }
+
+        const char* start = data.c_str() + lineStart;
+        const char* separator = static_cast<const char*>(::memchr(start, ':', lineEnd - lineStart));
+
+        if (separator != NULL) {
+            frame.addHeaderView(lineStart, lineStart + (std::size_t) (separator - start), lineEnd);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReader::readBody(StompFrame& frame, decaf::io::InputStream* in) {
+
+    std::vector<unsigned char>& body = frame.getBody();
+
+    std::size_t contentLength = 0;
+    if (frame.hasProperty(StompCommandConstants::HEADER_CONTENTLENGTH)) {
+        contentLength = (std::size_t) Integer::parseInt(
+            frame.getProperty(StompCommandConstants::HEADER_CONTENTLENGTH));
+    }
+
+    if (contentLength != 0) {
+
+        // Content length does not count the trailing null that marks the end of the
+        // frame, use what has been buffered and read the rest directly into the body.
+        body.resize(contentLength);
+
+        std::size_t copied = this->limit - this->position;
+        if (copied > contentLength) {
+            copied = contentLength;
+        }
+
+        if (copied > 0) {
+            ::memcpy(&body[0], &this->buffer[this->position], copied);
+            this->position += copied;
+        }
+
+        while (copied < contentLength) {
+            int result = in->read(&body[0], (int) contentLength, (int) copied, (int) (contentLength - copied));
+            if (result == -1) {
+                throw EOFException(__FILE__, __LINE__, "StompFrameReader::readBody - Reached EOF");
+            }
+            copied += (std::size_t) result;
+        }
+
+        if (this->position == this->limit) {
+            fill(in);
+        }
+
+        if (this->buffer[this->position++] != '\0') {
+            throw decaf::io::IOException(__FILE__, __LINE__, "StompWireFormat::readStompBody: "
+                "Read Content Length, and no trailing null");
+        }
+
+    } else {
+
+        // Content length was either zero, or not set, so we read until the first
+        // null is encountered, the null is kept as part of the body.
+        while (true) {
+
+            if (this->position == this->limit) {
+                fill(in);
+            }
+
+            const unsigned char* start = &this->buffer[this->position];
+            std::size_t length = this->limit - this->position;
+            const unsigned char* terminator = static_cast<const unsigned char*>(::memchr(start, '\0', length));
+
+            if (terminator != NULL) {
+                length = (std::size_t) (terminator - start) + 1;
+                body.insert(body.end(), start, start + length);
+                this->position += length;
+                return;
+            }
+
+            body.insert(body.end(), start, start + length);
+            this->position = this->limit;
+        }
+    }
+}
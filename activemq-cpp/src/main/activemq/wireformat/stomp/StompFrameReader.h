@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEREADER_H_
+#define _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEREADER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/wireformat/stomp/StompFrame.h>
+
+#include <decaf/io/InputStream.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace wireformat {
+namespace stomp {
+
+    /**
+     * Parses Stomp Frames from an InputStream.
+     *
+     * In read ahead mode the reader pulls whatever data the stream has available into
+     * its own buffer and locates the line and frame terminators with memchr, header
+     * lines are appended to the Frame's header block in bulk and bodies with a known
+     * content-length are read directly into the Frame.  Any bytes read past the end of
+     * a Frame are retained for the next call, so a read ahead reader must be the only
+     * consumer of the stream it reads from, the StompWireFormat keeps one per transport.
+     *
+     * When read ahead is disabled the reader never consumes more of the stream than the
+     * Frame it is parsing, at the cost of pulling the header section one byte at a time.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API StompFrameReader {
+    public:
+
+        /**
+         * The default size of the read ahead buffer.
+         */
+        static const int DEFAULT_BUFFER_SIZE;
+
+    private:
+
+        std::vector<unsigned char> buffer;
+        std::size_t position;
+        std::size_t limit;
+        bool readAhead;
+
+        // Stream the buffered data came from, buffered data is discarded if it changes.
+        const decaf::io::InputStream* source;
+
+    private:
+
+        StompFrameReader(const StompFrameReader&);
+        StompFrameReader& operator= (const StompFrameReader&);
+
+    public:
+
+        /**
+         * Creates a new Frame reader.
+         *
+         * @param readAhead
+         *      Allows the reader to read data beyond the end of the current Frame.
+         * @param bufferSize
+         *      The size of the read ahead buffer.
+         */
+        StompFrameReader(bool readAhead = true, int bufferSize = DEFAULT_BUFFER_SIZE);
+
+        virtual ~StompFrameReader();
+
+        /**
+         * Reads the next Frame from the given stream into the Frame provided, any
+         * existing contents of the Frame are replaced.
+         *
+         * @param frame
+         *      The Frame to populate.
+         * @param in
+         *      The stream to read from.
+         *
+         * @throw IOException if an error occurs while reading the Frame.
+         */
+        void readFrame(StompFrame& frame, decaf::io::InputStream* in);
+
+        /**
+         * @return the number of bytes read from the stream but not yet consumed.
+         */
+        std::size_t getBufferedCount() const {
+            return this->limit - this->position;
+        }
+
+        /**
+         * Discards any data that was read ahead from the stream.
+         */
+        void reset();
+
+    private:
+
+        void fill(decaf::io::InputStream* in);
+
+        void readLine(std::string& line, decaf::io::InputStream* in);
+
+        void readCommand(StompFrame& frame, decaf::io::InputStream* in);
+
+        void readHeaders(StompFrame& frame, decaf::io::InputStream* in);
+
+        void readBody(StompFrame& frame, decaf::io::InputStream* in);
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEREADER_H_ */
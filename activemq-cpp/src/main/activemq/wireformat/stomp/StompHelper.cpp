@@ -130,7 +130,7 @@ void StompHelper::convertProperties(const Pointer<StompFrame>& frame, const Poin
     }
 
     // Copy the general headers over to the Message.
-    std::vector<std::pair<std::string, std::string> > properties = frame->getProperties().toArray();
+    std::vector<std::pair<std::string, std::string> > properties = frame->propertiesToArray();
     std::vector<std::pair<std::string, std::string> >::const_iterator iter = properties.begin();
 
     for (; iter != properties.end(); ++iter) {
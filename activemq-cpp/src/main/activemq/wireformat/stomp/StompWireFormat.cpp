@@ -18,6 +18,7 @@
 #include "StompWireFormat.h"
 
 #include <activemq/wireformat/stomp/StompFrame.h>
+#include <activemq/wireformat/stomp/StompFrameReader.h>
 #include <activemq/wireformat/stomp/StompHelper.h>
 #include <activemq/wireformat/stomp/StompCommandConstants.h>
 #include <activemq/core/ActiveMQConstants.h>
@@ -83,13 +84,17 @@ namespace stomp {
         // Prefix used to address Temporary Queues (default is /temp-queue/
         std::string tempQueuePrefix;
 
+        // Parses incoming frames, holds any data read ahead of the current frame.
+        StompFrameReader reader;
+
     public:
 
         StompWireformatProperties() : connectResponseId(-1),
                                       topicPrefix("/topic/"),
                                       queuePrefix("/queue/"),
                                       tempTopicPrefix("/temp-topic/"),
-                                      tempQueuePrefix("/temp-queue/") {
+                                      tempQueuePrefix("/temp-queue/"),
+                                      reader() {
 
         }
 
@@ -188,8 +193,9 @@ Pointer<Command> StompWireFormat::unmarshal(const activemq::transport::Transport
         // Create a new Frame for reading to.
         frame.reset(new StompFrame());
 
-        // Read the command header.
-        frame->fromStream(in);
+        // Read the whole frame, the reader scans the stream in bulk and keeps any
+        // data belonging to the next frame buffered for the next call.
+        this->properties->reader.readFrame(*frame, in);
 
         // Return the Command.
         const std::string commandId = frame->getCommand();
@@ -29,6 +29,7 @@
 #include <decaf/internal/net/ssl/openssl/OpenSSLSocketException.h>
 #include <decaf/internal/net/ssl/openssl/OpenSSLSocketFactory.h>
 #include <decaf/internal/net/ssl/openssl/OpenSSLServerSocketFactory.h>
+#include <decaf/internal/net/ssl/openssl/OpenSSLSessionCache.h>
 
 #ifdef HAVE_STRINGS_H
 #include <strings.h>
@@ -76,6 +77,7 @@ namespace openssl {
         Pointer<ServerSocketFactory> serverSocketFactory;
         Pointer<SecureRandom> random;
         std::string password;
+        OpenSSLSessionCache sessionCache;
 
         static Mutex* locks;
         static std::string defaultCipherList;
@@ -98,6 +100,7 @@ namespace openssl {
                                   serverSocketFactory(),
                                   random(),
                                   password(),
+                                  sessionCache(),
                                   openSSLContext(NULL) {
 
             ContextData::locks = new Mutex[size];
@@ -203,6 +206,10 @@ void OpenSSLContextSpi::providerInit( SecureRandom* random ) {
         SSL_CTX_set_options( this->data->openSSLContext, SSL_OP_ALL | SSL_OP_NO_SSLv2 );
         SSL_CTX_set_mode( this->data->openSSLContext, SSL_MODE_AUTO_RETRY );
 
+        // Client sockets keep the sessions they negotiate so that reconnecting to the same
+        // broker can resume the session instead of performing a full handshake.
+        this->data->sessionCache.install( this->data->openSSLContext );
+
         // The Password Callback for cases where we need to open a Cert.
         SSL_CTX_set_default_passwd_cb( this->data->openSSLContext, &ContextData::passwordCallback );
         SSL_CTX_set_default_passwd_cb_userdata( this->data->openSSLContext, (void*)this->data );
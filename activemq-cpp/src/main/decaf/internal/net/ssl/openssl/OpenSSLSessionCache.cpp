@@ -0,0 +1,198 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OpenSSLSessionCache.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/concurrent/Concurrent.h>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+using namespace decaf::internal;
+using namespace decaf::internal::net;
+using namespace decaf::internal::net::ssl;
+using namespace decaf::internal::net::ssl::openssl;
+
+////////////////////////////////////////////////////////////////////////////////
+const int OpenSSLSessionCache::DEFAULT_MAX_SESSIONS = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Identifies sessions created by this library when acting as a server, required
+    // by OpenSSL for resumption once client certificates are being verified.
+    const unsigned char SESSION_ID_CONTEXT[] = "decaf";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLSessionCache::OpenSSLSessionCache(int maxSessions) : mutex(), maxSessions(maxSessions)
+#ifdef HAVE_OPENSSL
+                                                          , sessions()
+#endif
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLSessionCache::~OpenSSLSessionCache() {
+    try {
+        this->clear();
+    }
+    DECAF_CATCH_NOTHROW(Exception)
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSessionCache::remove(const std::string& key DECAF_UNUSED) {
+
+#ifdef HAVE_OPENSSL
+    synchronized(&this->mutex) {
+        std::map<std::string, SSL_SESSION*>::iterator iter = this->sessions.find(key);
+        if (iter != this->sessions.end()) {
+            SSL_SESSION_free(iter->second);
+            this->sessions.erase(iter);
+        }
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSessionCache::clear() {
+
+#ifdef HAVE_OPENSSL
+    synchronized(&this->mutex) {
+        std::map<std::string, SSL_SESSION*>::iterator iter = this->sessions.begin();
+        for (; iter != this->sessions.end(); ++iter) {
+            SSL_SESSION_free(iter->second);
+        }
+        this->sessions.clear();
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int OpenSSLSessionCache::size() const {
+
+    int result = 0;
+
+#ifdef HAVE_OPENSSL
+    synchronized(&this->mutex) {
+        result = (int) this->sessions.size();
+    }
+#endif
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string OpenSSLSessionCache::createKey(const std::string& host, int port) {
+    return host + ":" + Integer::toString(port);
+}
+
+#ifdef HAVE_OPENSSL
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSessionCache::install(SSL_CTX* context) {
+
+    if (context == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "SSL Context was NULL");
+    }
+
+    SSL_CTX_set_app_data(context, this);
+    SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_BOTH);
+    SSL_CTX_set_session_id_context(context, SESSION_ID_CONTEXT, sizeof(SESSION_ID_CONTEXT) - 1);
+    SSL_CTX_sess_set_new_cb(context, &OpenSSLSessionCache::newSessionCallback);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSessionCache::bind(SSL* ssl, const std::string* key) {
+    SSL_set_app_data(ssl, (char*) key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool OpenSSLSessionCache::resume(SSL* ssl, const std::string& key) {
+
+    bool result = false;
+
+    synchronized(&this->mutex) {
+        std::map<std::string, SSL_SESSION*>::iterator iter = this->sessions.find(key);
+        if (iter != this->sessions.end()) {
+            // SSL_set_session takes its own reference so the cache entry can be
+            // replaced or dropped while the handshake is in progress.
+            result = SSL_set_session(ssl, iter->second) == 1;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSessionCache::put(const std::string& key, SSL_SESSION* session) {
+
+    synchronized(&this->mutex) {
+
+        std::map<std::string, SSL_SESSION*>::iterator iter = this->sessions.find(key);
+        if (iter != this->sessions.end()) {
+            SSL_SESSION_free(iter->second);
+            iter->second = session;
+            return;
+        }
+
+        if ((int) this->sessions.size() >= this->maxSessions && !this->sessions.empty()) {
+            SSL_SESSION_free(this->sessions.begin()->second);
+            this->sessions.erase(this->sessions.begin());
+        }
+
+        this->sessions.insert(std::make_pair(key, session));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLSessionCache* OpenSSLSessionCache::getCache(SSL_CTX* context) {
+
+    if (context == NULL) {
+        return NULL;
+    }
+
+    return static_cast<OpenSSLSessionCache*>(SSL_CTX_get_app_data(context));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int OpenSSLSessionCache::newSessionCallback(SSL* ssl, SSL_SESSION* session) {
+
+    // Only client sockets are bound to a peer key, server side sessions are left
+    // to the internal cache of the context.
+    const std::string* key = static_cast<const std::string*>(SSL_get_app_data(ssl));
+    OpenSSLSessionCache* cache = getCache(SSL_get_SSL_CTX(ssl));
+
+    if (key == NULL || cache == NULL || key->empty()) {
+        return 0;
+    }
+
+    try {
+        cache->put(*key, session);
+    } catch (...) {
+        return 0;
+    }
+
+    // Returning one tells OpenSSL that we kept the reference it passed us.
+    return 1;
+}
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSESSIONCACHE_H_
+#define _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSESSIONCACHE_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <map>
+#include <string>
+
+#ifdef HAVE_OPENSSL
+#include <openssl/ssl.h>
+#endif
+
+namespace decaf {
+namespace internal {
+namespace net {
+namespace ssl {
+namespace openssl {
+
+    /**
+     * Client side cache of negotiated TLS sessions, keyed by the host and port of the
+     * peer.  A client socket that connects to a peer it has talked to before offers the
+     * cached session (session ID or ticket) so the server can resume it with an
+     * abbreviated handshake instead of repeating the full key exchange.
+     *
+     * The cache is attached to an SSL_CTX and is filled from OpenSSL's new session
+     * callback, which also covers TLS 1.3 where tickets arrive after the handshake.
+     *
+     * @since 1.0
+     */
+    class OpenSSLSessionCache {
+    public:
+
+        /**
+         * The default number of peers whose sessions are kept.
+         */
+        static const int DEFAULT_MAX_SESSIONS;
+
+    private:
+
+        mutable decaf::util::concurrent::Mutex mutex;
+
+        int maxSessions;
+
+#ifdef HAVE_OPENSSL
+        std::map<std::string, SSL_SESSION*> sessions;
+#endif
+
+    private:
+
+        OpenSSLSessionCache(const OpenSSLSessionCache&);
+        OpenSSLSessionCache& operator=(const OpenSSLSessionCache&);
+
+    public:
+
+        OpenSSLSessionCache(int maxSessions = DEFAULT_MAX_SESSIONS);
+
+        virtual ~OpenSSLSessionCache();
+
+        /**
+         * Removes the session cached for the given peer, called when resuming it failed.
+         *
+         * @param key
+         *      The peer key the session was stored under.
+         */
+        void remove(const std::string& key);
+
+        /**
+         * Removes all cached sessions.
+         */
+        void clear();
+
+        /**
+         * @return the number of peers that currently have a cached session.
+         */
+        int size() const;
+
+        /**
+         * Creates the key that sessions for a given peer are stored under.
+         *
+         * @param host
+         *      The host name the socket was connected to.
+         * @param port
+         *      The port the socket was connected to.
+         *
+         * @return the cache key for the peer.
+         */
+        static std::string createKey(const std::string& host, int port);
+
+#ifdef HAVE_OPENSSL
+
+        /**
+         * Attaches this cache to the given context, enables session caching on it and
+         * registers the callback that stores new client sessions.
+         *
+         * @param context
+         *      The OpenSSL context whose client sockets should use this cache.
+         */
+        void install(SSL_CTX* context);
+
+        /**
+         * Binds the SSL instance to a peer key, sessions negotiated on it are stored
+         * under that key.  The key must remain valid until the SSL instance is unbound
+         * by passing NULL.
+         *
+         * @param ssl
+         *      The client SSL instance.
+         * @param key
+         *      Pointer to the peer key or NULL to unbind.
+         */
+        static void bind(SSL* ssl, const std::string* key);
+
+        /**
+         * Offers the session cached for the peer on the SSL instance, must be called
+         * before the handshake starts.
+         *
+         * @param ssl
+         *      The client SSL instance.
+         * @param key
+         *      The peer key.
+         *
+         * @return true if a cached session was set on the SSL instance.
+         */
+        bool resume(SSL* ssl, const std::string& key);
+
+        /**
+         * Stores a session for the given peer, replacing any older one.  The cache takes
+         * over the caller's reference to the session.
+         *
+         * @param key
+         *      The peer key.
+         * @param session
+         *      The session to store.
+         */
+        void put(const std::string& key, SSL_SESSION* session);
+
+        /**
+         * @return the cache attached to the given context or NULL if none was installed.
+         */
+        static OpenSSLSessionCache* getCache(SSL_CTX* context);
+
+    private:
+
+        static int newSessionCallback(SSL* ssl, SSL_SESSION* session);
+
+#endif
+
+    };
+
+}}}}}
+
+#endif /* _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSESSIONCACHE_H_ */
@@ -34,6 +34,7 @@
 #include <decaf/internal/util/StringUtils.h>
 #include <decaf/internal/net/SocketFileDescriptor.h>
 #include <decaf/internal/net/ssl/openssl/OpenSSLParameters.h>
+#include <decaf/internal/net/ssl/openssl/OpenSSLSessionCache.h>
 #include <decaf/internal/net/ssl/openssl/OpenSSLSocketException.h>
 #include <decaf/internal/net/ssl/openssl/OpenSSLSocketInputStream.h>
 #include <decaf/internal/net/ssl/openssl/OpenSSLSocketOutputStream.h>
@@ -64,7 +65,9 @@ namespace openssl {
 
         bool handshakeStarted;
         bool handshakeCompleted;
+        bool sessionReused;
         std::string commonName;
+        std::string sessionKey;
 
         Mutex handshakeLock;
 
@@ -72,7 +75,9 @@ namespace openssl {
 
         SocketData() : handshakeStarted(false),
                        handshakeCompleted(false),
+                       sessionReused(false),
                        commonName(),
+                       sessionKey(),
                        handshakeLock() {
         }
 
@@ -146,6 +151,7 @@ OpenSSLSocket::~OpenSSLSocket() {
 
 #ifdef HAVE_OPENSSL
         if (this->parameters->getSSL()) {
+            OpenSSLSessionCache::bind(this->parameters->getSSL(), NULL);
             SSL_set_shutdown(this->parameters->getSSL(), SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
             SSL_shutdown(this->parameters->getSSL());
         }
@@ -190,6 +196,9 @@ void OpenSSLSocket::connect(const std::string& host, int port, int timeout) {
             // Later when startHandshake is called we will check for this common name
             // in the provided certificate
             this->data->commonName = host;
+
+            // Sessions are cached per broker host and port so a reconnect can resume.
+            this->data->sessionKey = OpenSSLSessionCache::createKey(host, port);
         }
 #else
         throw SocketException( __FILE__, __LINE__, "Not Supported" );
@@ -367,6 +376,19 @@ void OpenSSLSocket::startHandshake() {
                     SSL_set_tlsext_host_name(this->parameters->getSSL(), serverName.c_str());
                 }
 
+                // Offer the session from an earlier connection to this peer, if the server
+                // still knows it the handshake skips the key exchange.
+                OpenSSLSessionCache* sessionCache = NULL;
+                bool resumptionDisabled = Boolean::parseBoolean(System::getProperty("decaf.net.ssl.disableSessionResumption", "false"));
+
+                if (!resumptionDisabled && !this->data->sessionKey.empty()) {
+                    sessionCache = OpenSSLSessionCache::getCache(this->parameters->getSSLContext());
+                    if (sessionCache != NULL) {
+                        OpenSSLSessionCache::bind(this->parameters->getSSL(), &this->data->sessionKey);
+                        sessionCache->resume(this->parameters->getSSL(), this->data->sessionKey);
+                    }
+                }
+
                 int result = SSL_connect(this->parameters->getSSL());
 
                 // Checks the error status, when things go right we still perform a deeper
@@ -375,6 +397,7 @@ void OpenSSLSocket::startHandshake() {
                 // signed by a signing authority that we trust.
                 switch (SSL_get_error(this->parameters->getSSL(), result)) {
                 case SSL_ERROR_NONE:
+                    this->data->sessionReused = SSL_session_reused(this->parameters->getSSL()) != 0;
                     if (!peerVerifyDisabled) {
                         verifyServerCert(this->data->commonName);
                     }
@@ -382,6 +405,9 @@ void OpenSSLSocket::startHandshake() {
                 case SSL_ERROR_SSL:
                 case SSL_ERROR_ZERO_RETURN:
                 case SSL_ERROR_SYSCALL:
+                    if (sessionCache != NULL) {
+                        sessionCache->remove(this->data->sessionKey);
+                    }
                     SSLSocket::close();
                     throw OpenSSLSocketException(__FILE__, __LINE__);
                 }
@@ -423,6 +449,11 @@ void OpenSSLSocket::startHandshake() {
     DECAF_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool OpenSSLSocket::isSessionReused() const {
+    return this->data->sessionReused;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void OpenSSLSocket::setUseClientMode(bool value) {
 
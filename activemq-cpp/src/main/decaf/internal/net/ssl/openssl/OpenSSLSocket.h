@@ -195,6 +195,12 @@ namespace openssl {
 
     public:
 
+        /**
+         * @return true if the completed handshake resumed a cached session instead of
+         *         performing a full handshake.
+         */
+        bool isSessionReused() const;
+
         /**
          * Reads the requested data from the Socket and write it into the passed in buffer.
          *
@@ -24,10 +24,12 @@
 #include <decaf/net/SocketError.h>
 #include <decaf/net/SocketOptions.h>
 #include <decaf/lang/Character.h>
+#include <decaf/lang/Math.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 #include <stdio.h>
 #include <iostream>
 
@@ -62,6 +64,13 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 using namespace decaf::util::concurrent::atomic;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Buffers handed to a single gathered send, well under any platform's IOV_MAX.
+    const int MAX_GATHERED_BUFFERS = 64;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace decaf {
 namespace internal {
@@ -740,9 +749,10 @@ void TcpSocket::write(const unsigned char* buffer, int size, int offset, int len
 
         while (remaining > 0 && !isClosed()) {
 
-            // On input remaining is the bytes to send, after return remaining
-            // is the amount actually sent.
-            result = apr_socket_send(this->impl->socketHandle, (const char*) lbuffer, &remaining);
+            // On input sent is the bytes to send, after return it is the amount
+            // actually sent.
+            apr_size_t sent = remaining;
+            result = apr_socket_send(this->impl->socketHandle, (const char*) lbuffer, &sent);
 
             if (result != APR_SUCCESS || isClosed()) {
                 throw IOException(__FILE__, __LINE__,
@@ -750,8 +760,8 @@ void TcpSocket::write(const unsigned char* buffer, int size, int offset, int len
             }
 
             // move us to next position to write, or maybe end.
-            lbuffer += remaining;
-            remaining = length - remaining;
+            lbuffer += sent;
+            remaining -= sent;
         }
     }
     DECAF_CATCH_RETHROW(IOException)
@@ -760,6 +770,60 @@ void TcpSocket::write(const unsigned char* buffer, int size, int offset, int len
     DECAF_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpSocket::writeGathered(const unsigned char* const* buffers, const int* lengths, int count) {
+
+    try {
+
+        if (isClosed()) {
+            throw IOException(__FILE__, __LINE__,
+                "TcpSocket::writeGathered - This Stream has been closed.");
+        }
+
+        std::vector<struct iovec> vectors;
+        vectors.reserve(count);
+
+        for (int i = 0; i < count; ++i) {
+            if (lengths[i] > 0) {
+                struct iovec vector;
+                vector.iov_base = (char*) buffers[i];
+                vector.iov_len = (apr_size_t) lengths[i];
+                vectors.push_back(vector);
+            }
+        }
+
+        std::size_t next = 0;
+
+        while (next < vectors.size() && !isClosed()) {
+
+            apr_int32_t batch = (apr_int32_t) Math::min((int) (vectors.size() - next), MAX_GATHERED_BUFFERS);
+            apr_size_t sent = 0;
+
+            apr_status_t result = apr_socket_sendv(this->impl->socketHandle, &vectors[next], batch, &sent);
+
+            if (result != APR_SUCCESS || isClosed()) {
+                throw IOException(__FILE__, __LINE__,
+                    "TcpSocketOutputStream::write - %s", SocketError::getErrorString().c_str());
+            }
+
+            // Step past what was sent, a buffer that only partly went out is resumed
+            // from where the send stopped.
+            while (sent > 0) {
+                if (sent >= (apr_size_t) vectors[next].iov_len) {
+                    sent -= (apr_size_t) vectors[next].iov_len;
+                    next++;
+                } else {
+                    vectors[next].iov_base = (char*) vectors[next].iov_base + sent;
+                    vectors[next].iov_len -= sent;
+                    sent = 0;
+                }
+            }
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool TcpSocket::isConnected() const {
     return this->impl->connected;
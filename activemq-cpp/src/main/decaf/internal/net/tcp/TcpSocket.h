@@ -184,6 +184,21 @@ namespace tcp {
          */
         void write(const unsigned char* buffer, int size, int offset, int length);
 
+        /**
+         * Writes a sequence of buffers to the Socket in order, handing as many of them
+         * to the OS in each send as it accepts (writev) rather than one send per buffer.
+         *
+         * @param buffers
+         *      The buffers to write to the socket.
+         * @param lengths
+         *      The number of bytes to write from each buffer.
+         * @param count
+         *      The number of buffers passed.
+         *
+         * @throw IOException if an I/O error occurs during the write.
+         */
+        void writeGathered(const unsigned char* const* buffers, const int* lengths, int count);
+
     protected:
 
         void checkResult(apr_status_t value) const;
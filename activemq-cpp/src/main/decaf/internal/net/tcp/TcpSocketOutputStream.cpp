@@ -100,3 +100,19 @@ void TcpSocketOutputStream::doWriteArrayBounded(const unsigned char* buffer, int
     DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
     DECAF_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpSocketOutputStream::doWriteGathered(const unsigned char* const* buffers, const int* lengths, int count) {
+
+    try {
+
+        if (closed) {
+            throw IOException(__FILE__, __LINE__,
+                "TcpSocketOutputStream::write - This Stream has been closed.");
+        }
+
+        this->socket->writeGathered(buffers, lengths, count);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
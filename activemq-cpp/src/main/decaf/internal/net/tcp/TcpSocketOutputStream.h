@@ -65,6 +65,8 @@ namespace tcp {
 
         virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
 
+        virtual void doWriteGathered(const unsigned char* const* buffers, const int* lengths, int count);
+
     };
 
 }}}}
@@ -0,0 +1,341 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ModifiedUTF8.h"
+
+#include <decaf/io/UTFDataFormatException.h>
+
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define DECAF_MODIFIED_UTF8_X86
+#include <immintrin.h>
+#endif
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    typedef std::size_t (*ScanFunction)(const unsigned char*, std::size_t);
+
+    /**
+     * The scanning loops of one implementation, the encode and decode loops are
+     * shared and only the ASCII scans differ between instruction sets.
+     */
+    struct Kernels {
+        const char* name;
+        // Index of the first byte that is zero or has the high bit set.
+        ScanFunction asciiLength;
+        // Index of the first byte that has the high bit set.
+        ScanFunction highBitLength;
+        // Number of bytes that are zero or have the high bit set.
+        ScanFunction countExpanded;
+    };
+
+    const unsigned long long LOW_BITS = 0x0101010101010101ULL;
+    const unsigned long long HIGH_BITS = 0x8080808080808080ULL;
+
+    inline unsigned long long loadWord(const unsigned char* data) {
+        unsigned long long word;
+        ::memcpy(&word, data, sizeof(word));
+        return word;
+    }
+
+    inline bool isAscii(unsigned char value) {
+        return (unsigned char) (value - 1) < 0x7F;
+    }
+
+    std::size_t scalarAsciiLength(const unsigned char* data, std::size_t length) {
+        std::size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            unsigned long long word = loadWord(data + i);
+            // High bit of a byte is set if it was >= 0x80 or if it was zero.
+            if (((word | ((word - LOW_BITS) & ~word)) & HIGH_BITS) != 0) {
+                break;
+            }
+        }
+        for (; i < length && isAscii(data[i]); ++i) {
+        }
+        return i;
+    }
+
+    std::size_t scalarHighBitLength(const unsigned char* data, std::size_t length) {
+        std::size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            if ((loadWord(data + i) & HIGH_BITS) != 0) {
+                break;
+            }
+        }
+        for (; i < length && data[i] < 0x80; ++i) {
+        }
+        return i;
+    }
+
+    std::size_t scalarCountExpanded(const unsigned char* data, std::size_t length) {
+        std::size_t count = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            unsigned long long word = loadWord(data + i);
+            if (((word | ((word - LOW_BITS) & ~word)) & HIGH_BITS) != 0) {
+                for (std::size_t j = i; j < i + 8; ++j) {
+                    count += isAscii(data[j]) ? 0 : 1;
+                }
+            }
+        }
+        for (; i < length; ++i) {
+            count += isAscii(data[i]) ? 0 : 1;
+        }
+        return count;
+    }
+
+    const Kernels SCALAR_KERNELS = { "scalar", scalarAsciiLength, scalarHighBitLength, scalarCountExpanded };
+
+#ifdef DECAF_MODIFIED_UTF8_X86
+
+    __attribute__((target("sse2")))
+    std::size_t sse2AsciiLength(const unsigned char* data, std::size_t length) {
+        const __m128i zero = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*) (data + i));
+            unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, zero)));
+            if (mask != 0) {
+                return i + (std::size_t) __builtin_ctz(mask);
+            }
+        }
+        return i + scalarAsciiLength(data + i, length - i);
+    }
+
+    __attribute__((target("sse2")))
+    std::size_t sse2HighBitLength(const unsigned char* data, std::size_t length) {
+        std::size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (data + i)));
+            if (mask != 0) {
+                return i + (std::size_t) __builtin_ctz(mask);
+            }
+        }
+        return i + scalarHighBitLength(data + i, length - i);
+    }
+
+    __attribute__((target("sse2")))
+    std::size_t sse2CountExpanded(const unsigned char* data, std::size_t length) {
+        const __m128i zero = _mm_setzero_si128();
+        std::size_t ascii = 0;
+        std::size_t i = 0;
+        while (i + 16 <= length) {
+            // Byte lanes count ASCII bytes as signed values > 0, folded into
+            // the total before any lane can overflow.
+            __m128i counts = zero;
+            for (int blocks = 0; blocks < 255 && i + 16 <= length; ++blocks, i += 16) {
+                __m128i block = _mm_loadu_si128((const __m128i*) (data + i));
+                counts = _mm_sub_epi8(counts, _mm_cmpgt_epi8(block, zero));
+            }
+            __m128i sums = _mm_sad_epu8(counts, zero);
+            ascii += (std::size_t) _mm_cvtsi128_si32(sums) + (std::size_t) _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+        }
+        return (i - ascii) + scalarCountExpanded(data + i, length - i);
+    }
+
+    const Kernels SSE2_KERNELS = { "sse2", sse2AsciiLength, sse2HighBitLength, sse2CountExpanded };
+
+    __attribute__((target("avx2")))
+    std::size_t avx2AsciiLength(const unsigned char* data, std::size_t length) {
+        const __m256i zero = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            __m256i block = _mm256_loadu_si256((const __m256i*) (data + i));
+            unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(block, _mm256_cmpeq_epi8(block, zero)));
+            if (mask != 0) {
+                return i + (std::size_t) __builtin_ctz(mask);
+            }
+        }
+        // The SSE2 tails are not VEX encoded, running them with dirty upper lanes
+        // costs far more than the scan itself.
+        _mm256_zeroupper();
+        return i + sse2AsciiLength(data + i, length - i);
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t avx2HighBitLength(const unsigned char* data, std::size_t length) {
+        std::size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*) (data + i)));
+            if (mask != 0) {
+                return i + (std::size_t) __builtin_ctz(mask);
+            }
+        }
+        _mm256_zeroupper();
+        return i + sse2HighBitLength(data + i, length - i);
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t avx2CountExpanded(const unsigned char* data, std::size_t length) {
+        const __m256i zero = _mm256_setzero_si256();
+        std::size_t ascii = 0;
+        std::size_t i = 0;
+        while (i + 32 <= length) {
+            __m256i counts = zero;
+            for (int blocks = 0; blocks < 255 && i + 32 <= length; ++blocks, i += 32) {
+                __m256i block = _mm256_loadu_si256((const __m256i*) (data + i));
+                counts = _mm256_sub_epi8(counts, _mm256_cmpgt_epi8(block, zero));
+            }
+            unsigned long long sums[4];
+            _mm256_storeu_si256((__m256i*) sums, _mm256_sad_epu8(counts, zero));
+            ascii += (std::size_t) (sums[0] + sums[1] + sums[2] + sums[3]);
+        }
+        _mm256_zeroupper();
+        return (i - ascii) + sse2CountExpanded(data + i, length - i);
+    }
+
+    const Kernels AVX2_KERNELS = { "avx2", avx2AsciiLength, avx2HighBitLength, avx2CountExpanded };
+
+#endif
+
+    const Kernels& detectKernels() {
+#ifdef DECAF_MODIFIED_UTF8_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return AVX2_KERNELS;
+        } else if (__builtin_cpu_supports("sse2")) {
+            return SSE2_KERNELS;
+        }
+#endif
+        return SCALAR_KERNELS;
+    }
+
+    volatile bool accelerationEnabled = true;
+
+    inline const Kernels& activeKernels() {
+        static const Kernels& best = detectKernels();
+        return accelerationEnabled ? best : SCALAR_KERNELS;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ModifiedUTF8::asciiLength(const unsigned char* data, std::size_t length) {
+    return activeKernels().asciiLength(data, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ModifiedUTF8::encodedLength(const unsigned char* data, std::size_t length) {
+    return length + activeKernels().countExpanded(data, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ModifiedUTF8::encode(const unsigned char* data, std::size_t length, unsigned char* buffer) {
+
+    const Kernels& kernels = activeKernels();
+
+    std::size_t count = 0;
+    std::size_t index = 0;
+
+    while (count < length) {
+
+        std::size_t run = kernels.asciiLength(data + count, length - count);
+        if (run > 0) {
+            ::memcpy(buffer + index, data + count, run);
+            count += run;
+            index += run;
+        }
+
+        // Zero and values above 127 take the two byte form: 110X XXxx 10xx xxxx
+        while (count < length && !isAscii(data[count])) {
+            unsigned char value = data[count++];
+            buffer[index++] = (unsigned char) (0xC0 | (value >> 6));
+            buffer[index++] = (unsigned char) (0x80 | (value & 0x3F));
+        }
+    }
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t ModifiedUTF8::decode(const unsigned char* data, std::size_t length, unsigned char* buffer) {
+
+    const Kernels& kernels = activeKernels();
+
+    std::size_t count = 0;
+    std::size_t index = 0;
+
+    while (count < length) {
+
+        std::size_t run = kernels.highBitLength(data + count, length - count);
+        if (run > 0) {
+            if (buffer + index != data + count) {
+                ::memmove(buffer + index, data + count, run);
+            }
+            count += run;
+            index += run;
+        }
+
+        while (count < length && data[count] >= 0x80) {
+
+            unsigned char a = data[count++];
+
+            if ((a & 0xE0) == 0xC0) {
+                if (count >= length) {
+                    throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, start of two byte char found at end.");
+                }
+
+                unsigned char b = data[count++];
+                if ((b & 0xC0) != 0x80) {
+                    throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, byte two does not start with 0x80.");
+                }
+
+                // 2-byte UTF8 encoding: 110X XXxx 10xx xxxx
+                // Bits set at 'X' means we have encountered a UTF8 encoded value
+                // greater than 255, which is not supported.
+                if (a & 0x1C) {
+                    throw UTFDataFormatException(__FILE__, __LINE__, "Invalid 2 byte UTF-8 encoding found, "
+                            "This method only supports encoded ASCII values of (0-255).");
+                }
+
+                buffer[index++] = (unsigned char) (((a & 0x1F) << 6) | (b & 0x3F));
+
+            } else if ((a & 0xF0) == 0xE0) {
+
+                if (count + 1 >= length) {
+                    throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, start of three byte char found at end.");
+                } else {
+                    throw UTFDataFormatException(__FILE__, __LINE__, "Invalid 3 byte UTF-8 encoding found, "
+                            "This method only supports encoded ASCII values of (0-255).");
+                }
+
+            } else {
+                throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, aborting.");
+            }
+        }
+    }
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8::setAccelerationEnabled(bool enabled) {
+    accelerationEnabled = enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ModifiedUTF8::getImplementationName() {
+    return activeKernels().name;
+}
@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_UTIL_MODIFIEDUTF8_H_
+#define _DECAF_INTERNAL_UTIL_MODIFIEDUTF8_H_
+
+#include <decaf/util/Config.h>
+
+#include <string>
+
+namespace decaf {
+namespace internal {
+namespace util {
+
+    /**
+     * Shared codec for the modified UTF-8 encoding used by DataInput / DataOutput and
+     * the OpenWire wire format.  Strings are treated as sequences of single byte chars
+     * (0-255); values 1-127 encode as one byte, zero and values 128-255 encode as two.
+     *
+     * The scanning loops that find runs of plain ASCII and count the bytes needing
+     * expansion are vectorized.  On x86 the widest of AVX2 or SSE2 that the CPU supports
+     * is chosen at runtime, other platforms use a word at a time scalar fallback.
+     *
+     * @since 1.0
+     */
+    class DECAF_API ModifiedUTF8 {
+    private:
+
+        ModifiedUTF8(const ModifiedUTF8&);
+        ModifiedUTF8& operator= (const ModifiedUTF8&);
+
+    private:
+
+        ModifiedUTF8() {}
+
+    public:
+
+        virtual ~ModifiedUTF8() {}
+
+        /**
+         * Returns the number of leading bytes that encode as themselves, which is the
+         * index of the first zero byte or byte with the high bit set.
+         *
+         * @param data
+         *      The bytes to scan.
+         * @param length
+         *      The number of bytes to scan.
+         *
+         * @return the length of the leading ASCII run, equal to length if all bytes are ASCII.
+         */
+        static std::size_t asciiLength(const unsigned char* data, std::size_t length);
+
+        /**
+         * Returns the number of bytes the modified UTF-8 encoding of the given chars takes.
+         *
+         * @param data
+         *      The chars to be encoded.
+         * @param length
+         *      The number of chars to be encoded.
+         *
+         * @return the encoded length, equal to length if the chars are all ASCII.
+         */
+        static std::size_t encodedLength(const unsigned char* data, std::size_t length);
+
+        /**
+         * Encodes the given chars into the buffer, which must be able to hold the number
+         * of bytes returned from encodedLength.
+         *
+         * @param data
+         *      The chars to be encoded.
+         * @param length
+         *      The number of chars to be encoded.
+         * @param buffer
+         *      The destination of the encoded bytes.
+         *
+         * @return the number of bytes written into the buffer.
+         */
+        static std::size_t encode(const unsigned char* data, std::size_t length, unsigned char* buffer);
+
+        /**
+         * Decodes modified UTF-8 bytes into the buffer, which must hold at least length
+         * bytes.  The buffer may be the same memory as the data to decode in place.
+         *
+         * @param data
+         *      The encoded bytes.
+         * @param length
+         *      The number of encoded bytes.
+         * @param buffer
+         *      The destination of the decoded chars.
+         *
+         * @return the number of chars written into the buffer.
+         *
+         * @throws UTFDataFormatException if the bytes are not a valid encoding or encode
+         *         a value greater than 255.
+         */
+        static std::size_t decode(const unsigned char* data, std::size_t length, unsigned char* buffer);
+
+        /**
+         * Enables or disables the vectorized code paths, when disabled the scalar fallback
+         * is used regardless of what the CPU supports.  Meant for testing and benchmarks.
+         *
+         * @param enabled
+         *      True to use the best implementation for this CPU, false for the scalar one.
+         */
+        static void setAccelerationEnabled(bool enabled);
+
+        /**
+         * @return the name of the implementation in use, one of "avx2", "sse2" or "scalar".
+         */
+        static std::string getImplementationName();
+
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_UTIL_MODIFIEDUTF8_H_ */
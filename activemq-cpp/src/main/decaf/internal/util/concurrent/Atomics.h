@@ -59,6 +59,10 @@ namespace concurrent {
         static int incrementAndGet(volatile int* target);
         static int decrementAndGet(volatile int* target);
 
+        static bool compareAndSet64(volatile long long* target, long long expect, long long update);
+        static long long getAndAdd64(volatile long long* target, long long delta);
+        static long long addAndGet64(volatile long long* target, long long delta);
+
     private:
 
         static void initialize();
@@ -137,6 +137,10 @@ namespace concurrent {
 
         static void setPriority(decaf_thread_t thread, int priority);
 
+        static void getAffinity(decaf_thread_t thread, std::vector<int>& cpus);
+
+        static void setAffinity(decaf_thread_t thread, const std::vector<int>& cpus);
+
         static long long getStackSize(decaf_thread_t thread);
 
         static void setStackSize(decaf_thread_t thread, long long stackSize);
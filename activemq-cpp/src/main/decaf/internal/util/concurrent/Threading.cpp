@@ -1299,6 +1299,16 @@ void Threading::setThreadPriority(ThreadHandle* handle, int priority) {
     handle->priority = priority;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void Threading::getThreadAffinity(ThreadHandle* handle, std::vector<int>& cpus) {
+    PlatformThread::getAffinity(handle->handle, cpus);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Threading::setThreadAffinity(ThreadHandle* handle, const std::vector<int>& cpus) {
+    PlatformThread::setAffinity(handle->handle, cpus);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 const char* Threading::getThreadName(ThreadHandle* handle) {
     return handle->name;
@@ -242,6 +242,10 @@ namespace concurrent {
 
         static void setThreadPriority(ThreadHandle* thread, int priority);
 
+        static void getThreadAffinity(ThreadHandle* thread, std::vector<int>& cpus);
+
+        static void setThreadAffinity(ThreadHandle* thread, const std::vector<int>& cpus);
+
         static const char* getThreadName(ThreadHandle* thread);
 
         static void setThreadName(ThreadHandle* thread, const char* name);
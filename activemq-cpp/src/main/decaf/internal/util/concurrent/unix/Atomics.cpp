@@ -251,3 +251,61 @@ int Atomics::decrementAndGet(volatile int* target) {
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool Atomics::compareAndSet64(volatile long long* target, long long expect, long long update) {
+#ifdef HAVE_ATOMIC_BUILTINS
+    return __sync_val_compare_and_swap(target, expect, update) == expect;
+#elif defined(SOLARIS2) && SOLARIS2 >= 10
+    return atomic_cas_64((volatile uint64_t*)target, expect, update) == (uint64_t)expect;
+#else
+    bool result = false;
+    PlatformThread::lockMutex(atomicMutex);
+
+    if (*target == expect) {
+        *target = update;
+        result = true;
+    }
+
+    PlatformThread::unlockMutex(atomicMutex);
+
+    return result;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long Atomics::getAndAdd64(volatile long long* target, long long delta) {
+#ifdef HAVE_ATOMIC_BUILTINS
+    return __sync_fetch_and_add(target, delta);
+#elif defined(SOLARIS2) && SOLARIS2 >= 10
+    return atomic_add_64_nv((volatile uint64_t*)target, delta) - delta;
+#else
+    long long oldValue;
+    PlatformThread::lockMutex(atomicMutex);
+
+    oldValue = *target;
+    *target += delta;
+
+    PlatformThread::unlockMutex(atomicMutex);
+
+    return oldValue;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long Atomics::addAndGet64(volatile long long* target, long long delta) {
+#ifdef HAVE_ATOMIC_BUILTINS
+    return __sync_fetch_and_add(target, delta) + delta;
+#elif defined(SOLARIS2) && SOLARIS2 >= 10
+    return atomic_add_64_nv((volatile uint64_t*)target, delta);
+#else
+    long long newValue;
+    PlatformThread::lockMutex(atomicMutex);
+
+    *target += delta;
+    newValue = *target;
+
+    PlatformThread::unlockMutex(atomicMutex);
+
+    return newValue;
+#endif
+}
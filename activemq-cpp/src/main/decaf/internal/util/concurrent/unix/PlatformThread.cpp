@@ -18,6 +18,7 @@
 #include <decaf/internal/util/concurrent/PlatformThread.h>
 
 #include <decaf/lang/exceptions/RuntimeException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/util/concurrent/TimeUnit.h>
 #include <memory>
 
@@ -421,6 +422,65 @@ void PlatformThread::setPriority(decaf_thread_t thread, int priority) {
     pthread_setschedparam(thread, SCHED_OTHER, &schedParam);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void PlatformThread::getAffinity(decaf_thread_t thread, std::vector<int>& cpus) {
+
+#if defined(__linux__) && defined(CPU_SETSIZE)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+
+    int result = pthread_getaffinity_np(thread, sizeof(cpu_set_t), &cpuSet);
+    if (result != 0) {
+        throw RuntimeException(__FILE__, __LINE__,
+            "Failed to get the Thread processor affinity, error value is: %d.", result);
+    }
+
+    cpus.clear();
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &cpuSet)) {
+            cpus.push_back(cpu);
+        }
+    }
+#else
+    throw UnsupportedOperationException(__FILE__, __LINE__,
+        "Thread processor affinity is not supported on this platform.");
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PlatformThread::setAffinity(decaf_thread_t thread, const std::vector<int>& cpus) {
+
+#if defined(__linux__) && defined(CPU_SETSIZE)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+
+    if (cpus.empty()) {
+        long configured = sysconf(_SC_NPROCESSORS_CONF);
+        for (long cpu = 0; cpu < configured && cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET((int) cpu, &cpuSet);
+        }
+    } else {
+        std::vector<int>::const_iterator iter = cpus.begin();
+        for (; iter != cpus.end(); ++iter) {
+            if (*iter >= CPU_SETSIZE) {
+                throw RuntimeException(__FILE__, __LINE__,
+                    "Processor %d is beyond the largest supported processor number.", *iter);
+            }
+            CPU_SET(*iter, &cpuSet);
+        }
+    }
+
+    int result = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet);
+    if (result != 0) {
+        throw RuntimeException(__FILE__, __LINE__,
+            "Failed to set the Thread processor affinity, error value is: %d.", result);
+    }
+#else
+    throw UnsupportedOperationException(__FILE__, __LINE__,
+        "Thread processor affinity is not supported on this platform.");
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 long long PlatformThread::getStackSize(decaf_thread_t thread DECAF_UNUSED) {
 
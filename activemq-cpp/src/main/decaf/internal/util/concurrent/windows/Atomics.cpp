@@ -79,3 +79,17 @@ int Atomics::decrementAndGet(volatile int* target) {
     return ::InterlockedExchangeAdd((volatile LONG*)target, 0xFFFFFFFF) - 1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool Atomics::compareAndSet64(volatile long long* target, long long expect, long long update) {
+    return ::InterlockedCompareExchange64((volatile LONGLONG*)target, update, expect) == expect;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long Atomics::getAndAdd64(volatile long long* target, long long delta) {
+    return ::InterlockedExchangeAdd64((volatile LONGLONG*)target, delta);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long Atomics::addAndGet64(volatile long long* target, long long delta) {
+    return ::InterlockedExchangeAdd64((volatile LONGLONG*)target, delta) + delta;
+}
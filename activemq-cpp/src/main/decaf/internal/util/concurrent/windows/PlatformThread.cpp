@@ -413,6 +413,61 @@ int PlatformThread::getPriority(decaf_thread_t thread) {
 void PlatformThread::setPriority(decaf_thread_t thread, int priority) {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void PlatformThread::getAffinity(decaf_thread_t thread, std::vector<int>& cpus) {
+
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+
+    if (!::GetProcessAffinityMask(::GetCurrentProcess(), &processMask, &systemMask)) {
+        throw RuntimeException(__FILE__, __LINE__,
+            "Failed to get the Process affinity, error value is: %d.", (int) ::GetLastError());
+    }
+
+    // There is no direct query for a Thread's mask, assigning one returns the previous.
+    DWORD_PTR threadMask = ::SetThreadAffinityMask(thread, processMask);
+    if (threadMask == 0) {
+        throw RuntimeException(__FILE__, __LINE__,
+            "Failed to get the Thread processor affinity, error value is: %d.", (int) ::GetLastError());
+    }
+    ::SetThreadAffinityMask(thread, threadMask);
+
+    cpus.clear();
+    for (int cpu = 0; cpu < (int) (sizeof(DWORD_PTR) * 8); ++cpu) {
+        if ((threadMask & ((DWORD_PTR) 1 << cpu)) != 0) {
+            cpus.push_back(cpu);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PlatformThread::setAffinity(decaf_thread_t thread, const std::vector<int>& cpus) {
+
+    DWORD_PTR mask = 0;
+
+    if (cpus.empty()) {
+        DWORD_PTR systemMask = 0;
+        if (!::GetProcessAffinityMask(::GetCurrentProcess(), &mask, &systemMask)) {
+            throw RuntimeException(__FILE__, __LINE__,
+                "Failed to get the Process affinity, error value is: %d.", (int) ::GetLastError());
+        }
+    } else {
+        std::vector<int>::const_iterator iter = cpus.begin();
+        for (; iter != cpus.end(); ++iter) {
+            if (*iter >= (int) (sizeof(DWORD_PTR) * 8)) {
+                throw RuntimeException(__FILE__, __LINE__,
+                    "Processor %d is beyond the largest supported processor number.", *iter);
+            }
+            mask |= (DWORD_PTR) 1 << *iter;
+        }
+    }
+
+    if (::SetThreadAffinityMask(thread, mask) == 0) {
+        throw RuntimeException(__FILE__, __LINE__,
+            "Failed to set the Thread processor affinity, error value is: %d.", (int) ::GetLastError());
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 long long PlatformThread::getStackSize(decaf_thread_t thread DECAF_UNUSED) {
     return PLATFORM_MIN_STACK_SIZE;
@@ -28,7 +28,7 @@ using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
 BufferedOutputStream::BufferedOutputStream(OutputStream* stream, bool own) :
-    FilterOutputStream(stream, own), buffer(NULL), bufferSize(0), head(0), tail(0) {
+    FilterOutputStream(stream, own), buffer(NULL), bufferSize(0), head(0), tail(0), directWriteThreshold(0) {
 
     // Default to 1k buffer.
     init(8192);
@@ -36,7 +36,7 @@ BufferedOutputStream::BufferedOutputStream(OutputStream* stream, bool own) :
 
 ////////////////////////////////////////////////////////////////////////////////
 BufferedOutputStream::BufferedOutputStream(OutputStream* stream, int bufSize, bool own) :
-    FilterOutputStream(stream, own), buffer(NULL), bufferSize(0), head(0), tail(0) {
+    FilterOutputStream(stream, own), buffer(NULL), bufferSize(0), head(0), tail(0), directWriteThreshold(0) {
 
     try {
         this->init(bufSize);
@@ -69,6 +69,16 @@ void BufferedOutputStream::init(int bufSize) {
     head = tail = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void BufferedOutputStream::setDirectWriteThreshold(int threshold) {
+
+    if (threshold < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Direct write threshold cannot be negative.");
+    }
+
+    this->directWriteThreshold = threshold;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void BufferedOutputStream::emptyBuffer() {
 
@@ -172,6 +182,22 @@ void BufferedOutputStream::doWriteArrayBounded(const unsigned char* buffer, int
             throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
         }
 
+        // Large writes skip the copy, anything already buffered goes out ahead of
+        // them in the same gathered write so the ordering is kept.
+        if (this->directWriteThreshold > 0 && length >= this->directWriteThreshold) {
+
+            if (this->outputStream == NULL) {
+                throw IOException(__FILE__, __LINE__, "BufferedOutputStream::write - OutputStream is closed");
+            }
+
+            const unsigned char* buffers[2] = { this->buffer + this->head, buffer + offset };
+            int lengths[2] = { this->tail - this->head, length };
+
+            this->outputStream->writeGathered(buffers, lengths, 2);
+            this->head = this->tail = 0;
+            return;
+        }
+
         // Iterate until all the data is written.
         for (int pos = 0; pos < length;) {
 
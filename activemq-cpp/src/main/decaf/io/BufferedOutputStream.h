@@ -51,6 +51,11 @@ namespace io{
          */
         int tail;
 
+        /**
+         * Writes of at least this many bytes bypass the buffer, zero if none do.
+         */
+        int directWriteThreshold;
+
     private:
 
         BufferedOutputStream(const BufferedOutputStream&);
@@ -89,6 +94,31 @@ namespace io{
          */
         virtual void flush();
 
+        /**
+         * Sets the size at which a write bypasses the internal buffer.  A write of at
+         * least this many bytes is handed to the target stream as is, together with any
+         * bytes already buffered in a single gathered write, instead of being copied
+         * through the buffer in buffer sized chunks.
+         *
+         * @param threshold
+         *      The write size in bytes at which the buffer is bypassed, zero (the default)
+         *      to always copy through the buffer.
+         *
+         * @throws IllegalArgumentException if the threshold given is negative.
+         *
+         * @since 1.0
+         */
+        void setDirectWriteThreshold(int threshold);
+
+        /**
+         * @return the write size in bytes at which the buffer is bypassed, zero if it never is.
+         *
+         * @since 1.0
+         */
+        int getDirectWriteThreshold() const {
+            return this->directWriteThreshold;
+        }
+
     protected:
 
         virtual void doWriteByte(unsigned char c);
@@ -18,12 +18,14 @@
 #include <decaf/io/DataOutputStream.h>
 #include <decaf/io/UTFDataFormatException.h>
 #include <decaf/util/Config.h>
+#include <decaf/internal/util/ModifiedUTF8.h>
 #include <string.h>
 #include <stdio.h>
 
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::util;
+using namespace decaf::internal::util;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -280,32 +282,17 @@ void DataOutputStream::writeUTF(const std::string& value) {
                     "than the supported 65535 bytes");
         }
 
-        std::size_t length = value.length();
-        std::vector<unsigned char> utfBytes((std::size_t) utfLength);
-        unsigned int utfIndex = 0;
-
-        for (std::size_t i = 0; i < length; i++) {
-
-            unsigned int charValue = (unsigned char) value.at(i);
-
-            // Written to allow for expansion to wide character strings at some
-            // point, as it stands now the value can never be > 255 since the
-            // string class returns a single byte char.
-            if (charValue > 0 && charValue <= 127) {
-                utfBytes[utfIndex++] = (unsigned char) charValue;
-            } else if (charValue <= 2047) {
-                utfBytes[utfIndex++] = (unsigned char) (0xc0 | (0x1f & (charValue >> 6)));
-                utfBytes[utfIndex++] = (unsigned char) (0x80 | (0x3f & charValue));
-            } else {
-                utfBytes[utfIndex++] = (unsigned char) (0xe0 | (0x0f & (charValue >> 12)));
-                utfBytes[utfIndex++] = (unsigned char) (0x80 | (0x3f & (charValue >> 6)));
-                utfBytes[utfIndex++] = (unsigned char) (0x80 | (0x3f & charValue));
-            }
-        }
-
         this->writeUnsignedShort((unsigned short) utfLength);
-        if (utfLength > 0) {
-            this->write(&utfBytes[0], utfIndex, 0, utfIndex);
+
+        if (utfLength == value.length()) {
+            // Only ASCII values so the string bytes are already encoded.
+            if (utfLength > 0) {
+                this->write((const unsigned char*) value.c_str(), (int) utfLength, 0, (int) utfLength);
+            }
+        } else {
+            std::vector<unsigned char> utfBytes((std::size_t) utfLength);
+            std::size_t utfIndex = ModifiedUTF8::encode((const unsigned char*) value.c_str(), value.length(), &utfBytes[0]);
+            this->write(&utfBytes[0], (int) utfIndex, 0, (int) utfIndex);
         }
     }
     DECAF_CATCH_RETHROW(UTFDataFormatException)
@@ -315,25 +302,5 @@ void DataOutputStream::writeUTF(const std::string& value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 unsigned int DataOutputStream::countUTFLength(const std::string& value) {
-
-    unsigned int utfCount = 0;
-    std::size_t length = value.length();
-
-    for (std::size_t i = 0; i < length; ++i) {
-
-        unsigned int charValue = (unsigned char) value.at(i);
-
-        // Written to allow for expansion to wide character strings at some
-        // point, as it stands now the value can never be > 255 since the
-        // string class returns a single byte char.
-        if (charValue > 0 && charValue <= 127) {
-            utfCount++;
-        } else if (charValue <= 2047) {
-            utfCount += 2;
-        } else {
-            utfCount += 3;
-        }
-    }
-
-    return utfCount;
+    return (unsigned int) ModifiedUTF8::encodedLength((const unsigned char*) value.c_str(), value.length());
 }
@@ -0,0 +1,69 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "File.h"
+
+#include <decaf/internal/AprPool.h>
+
+#include <apr_file_io.h>
+#include <apr_file_info.h>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+
+////////////////////////////////////////////////////////////////////////////////
+File::File(const std::string& path) : path(path) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+File::~File() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool File::exists() const {
+
+    AprPool pool;
+    apr_finfo_t info;
+    return apr_stat(&info, this->path.c_str(), APR_FINFO_SIZE, pool.getAprPool()) == APR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long File::length() const {
+
+    AprPool pool;
+    apr_finfo_t info;
+    if (apr_stat(&info, this->path.c_str(), APR_FINFO_SIZE, pool.getAprPool()) != APR_SUCCESS) {
+        return 0;
+    }
+
+    return (long long)info.size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool File::remove() {
+
+    AprPool pool;
+    return apr_file_remove(this->path.c_str(), pool.getAprPool()) == APR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool File::renameTo(const File& dest) {
+
+    AprPool pool;
+    return apr_file_rename(this->path.c_str(), dest.path.c_str(), pool.getAprPool()) == APR_SUCCESS;
+}
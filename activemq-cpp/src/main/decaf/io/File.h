@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_IO_FILE_H_
+#define _DECAF_IO_FILE_H_
+
+#include <decaf/util/Config.h>
+
+#include <string>
+
+namespace decaf {
+namespace io {
+
+    /**
+     * An abstract representation of a file path on the local file system.  Creating a
+     * File does not touch the file system, the methods query or change the file that
+     * the path names at the time they are called.
+     *
+     * @since 1.0
+     */
+    class DECAF_API File {
+    private:
+
+        std::string path;
+
+    public:
+
+        /**
+         * Creates a new File instance for the given path name.
+         *
+         * @param path
+         *      The path name of the file, relative paths are relative to the working directory.
+         */
+        File(const std::string& path);
+
+        virtual ~File();
+
+        /**
+         * @return the path name that this File was created with.
+         */
+        const std::string& getPath() const {
+            return this->path;
+        }
+
+        /**
+         * @return true if a file or directory with this path name exists.
+         */
+        bool exists() const;
+
+        /**
+         * @return the size in bytes of the file named by this path, or zero if it does not exist.
+         */
+        long long length() const;
+
+        /**
+         * Deletes the file named by this path.
+         *
+         * @return true if the file was deleted, false if it did not exist or could not be deleted.
+         */
+        bool remove();
+
+        /**
+         * Renames the file named by this path to the path of the given File, replacing any
+         * file that exists at the destination.
+         *
+         * @param dest
+         *      The File whose path is the new name of this file.
+         *
+         * @return true if the rename succeeded.
+         */
+        bool renameTo(const File& dest);
+
+    };
+
+}}
+
+#endif /* _DECAF_IO_FILE_H_ */
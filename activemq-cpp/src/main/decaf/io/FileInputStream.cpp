@@ -0,0 +1,168 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileInputStream.h"
+
+#include <decaf/internal/AprPool.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+#include <apr_errno.h>
+#include <apr_file_io.h>
+#include <apr_file_info.h>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace io {
+
+    class FileInputStreamHandle {
+    private:
+
+        FileInputStreamHandle(const FileInputStreamHandle&);
+        FileInputStreamHandle& operator=(const FileInputStreamHandle&);
+
+    public:
+
+        AprPool pool;
+        apr_file_t* file;
+
+        FileInputStreamHandle() : pool(), file(NULL) {}
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+FileInputStream::FileInputStream(const std::string& name) :
+    InputStream(), handle(new FileInputStreamHandle()), name(name), length(0), position(0) {
+
+    apr_status_t result = apr_file_open(&this->handle->file, name.c_str(), APR_READ | APR_BINARY,
+                                        APR_OS_DEFAULT, this->handle->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        delete this->handle;
+
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to open file %s: %s",
+                          name.c_str(), apr_strerror(result, buffer, 255));
+    }
+
+    apr_finfo_t info;
+    if (apr_file_info_get(&info, APR_FINFO_SIZE, this->handle->file) == APR_SUCCESS) {
+        this->length = (long long)info.size;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileInputStream::~FileInputStream() {
+    try {
+        this->close();
+    }
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->handle;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FileInputStream::available() const {
+
+    checkClosed();
+
+    long long remaining = this->length - this->position;
+    if (remaining <= 0) {
+        return 0;
+    }
+
+    return remaining > 0x7FFFFFFFLL ? 0x7FFFFFFF : (int)remaining;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileInputStream::close() {
+
+    if (this->handle->file == NULL) {
+        return;
+    }
+
+    apr_file_close(this->handle->file);
+    this->handle->file = NULL;
+    this->handle->pool.cleanup();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FileInputStream::doReadByte() {
+
+    unsigned char value = 0;
+    int result = this->doReadArrayBounded(&value, 1, 0, 1);
+    return result == -1 ? -1 : (int)value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FileInputStream::doReadArrayBounded(unsigned char* buffer, int size, int offset, int length) {
+
+    if (length == 0) {
+        return 0;
+    }
+
+    if (buffer == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Buffer pointer passed was NULL.");
+    }
+
+    if (size < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "size parameter out of Bounds: %d.", size);
+    }
+
+    if (offset > size || offset < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "offset parameter out of Bounds: %d.", offset);
+    }
+
+    if (length < 0 || length > size - offset) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
+    }
+
+    checkClosed();
+
+    apr_size_t count = (apr_size_t)length;
+    apr_status_t result = apr_file_read(this->handle->file, buffer + offset, &count);
+
+    if (APR_STATUS_IS_EOF(result) || (result == APR_SUCCESS && count == 0)) {
+        return -1;
+    }
+
+    if (result != APR_SUCCESS) {
+        char errorBuffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to read from file %s: %s",
+                          this->name.c_str(), apr_strerror(result, errorBuffer, 255));
+    }
+
+    this->position += (long long)count;
+    return (int)count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileInputStream::checkClosed() const {
+    if (this->handle->file == NULL) {
+        throw IOException(__FILE__, __LINE__, "FileInputStream for %s is closed.", this->name.c_str());
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_IO_FILEINPUTSTREAM_H_
+#define _DECAF_IO_FILEINPUTSTREAM_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/io/InputStream.h>
+
+#include <string>
+
+namespace decaf {
+namespace io {
+
+    class FileInputStreamHandle;
+
+    /**
+     * An InputStream that reads bytes from a file on the local file system.  Reads go
+     * straight to the file without buffering in this class, wrap the stream in a
+     * BufferedInputStream when many small reads are expected.
+     *
+     * @since 1.0
+     */
+    class DECAF_API FileInputStream : public InputStream {
+    private:
+
+        FileInputStreamHandle* handle;
+
+        std::string name;
+
+        long long length;
+
+        long long position;
+
+    private:
+
+        FileInputStream(const FileInputStream&);
+        FileInputStream& operator=(const FileInputStream&);
+
+    public:
+
+        /**
+         * Opens the named file for reading.
+         *
+         * @param name
+         *      The path name of the file to read.
+         *
+         * @throws IOException if the file does not exist or cannot be opened.
+         */
+        FileInputStream(const std::string& name);
+
+        virtual ~FileInputStream();
+
+        /**
+         * @return the path name of the file this stream reads from.
+         */
+        const std::string& getName() const {
+            return this->name;
+        }
+
+        /**
+         * {@inheritDoc}
+         *
+         * Returns the number of bytes between the current position and the size the file
+         * had when it was opened.
+         */
+        virtual int available() const;
+
+        virtual void close();
+
+    protected:
+
+        virtual int doReadByte();
+
+        virtual int doReadArrayBounded(unsigned char* buffer, int size, int offset, int length);
+
+    private:
+
+        void checkClosed() const;
+
+    };
+
+}}
+
+#endif /* _DECAF_IO_FILEINPUTSTREAM_H_ */
@@ -0,0 +1,198 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileOutputStream.h"
+
+#include <decaf/internal/AprPool.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+#include <apr_errno.h>
+#include <apr_file_io.h>
+#include <apr_portable.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace io {
+
+    class FileOutputStreamHandle {
+    private:
+
+        FileOutputStreamHandle(const FileOutputStreamHandle&);
+        FileOutputStreamHandle& operator=(const FileOutputStreamHandle&);
+
+    public:
+
+        AprPool pool;
+        apr_file_t* file;
+
+        FileOutputStreamHandle() : pool(), file(NULL) {}
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+FileOutputStream::FileOutputStream(const std::string& name, bool append) :
+    OutputStream(), handle(new FileOutputStreamHandle()), name(name) {
+
+    apr_int32_t flags = APR_WRITE | APR_CREATE | APR_BINARY | (append ? APR_APPEND : APR_TRUNCATE);
+
+    apr_status_t result = apr_file_open(&this->handle->file, name.c_str(), flags,
+                                        APR_OS_DEFAULT, this->handle->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        delete this->handle;
+
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to open file %s: %s",
+                          name.c_str(), apr_strerror(result, buffer, 255));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileOutputStream::~FileOutputStream() {
+    try {
+        this->close();
+    }
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->handle;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStream::flush() {
+
+    checkClosed();
+
+    apr_status_t result = apr_file_flush(this->handle->file);
+    if (result != APR_SUCCESS) {
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to flush file %s: %s",
+                          this->name.c_str(), apr_strerror(result, buffer, 255));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStream::sync() {
+
+    this->flush();
+
+    apr_os_file_t osFile;
+    apr_status_t result = apr_os_file_get(&osFile, this->handle->file);
+
+    if (result == APR_SUCCESS) {
+#ifdef _WIN32
+        if (!FlushFileBuffers(osFile)) {
+            result = APR_FROM_OS_ERROR(GetLastError());
+        }
+#else
+        while (fsync(osFile) != 0) {
+            if (errno != EINTR) {
+                result = errno;
+                break;
+            }
+        }
+#endif
+    }
+
+    if (result != APR_SUCCESS) {
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to sync file %s: %s",
+                          this->name.c_str(), apr_strerror(result, buffer, 255));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStream::close() {
+
+    if (this->handle->file == NULL) {
+        return;
+    }
+
+    apr_status_t result = apr_file_close(this->handle->file);
+    this->handle->file = NULL;
+    this->handle->pool.cleanup();
+
+    if (result != APR_SUCCESS) {
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to close file %s: %s",
+                          this->name.c_str(), apr_strerror(result, buffer, 255));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStream::doWriteByte(unsigned char value) {
+    this->doWriteArrayBounded(&value, 1, 0, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStream::doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length) {
+
+    if (length == 0) {
+        return;
+    }
+
+    if (buffer == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Buffer pointer passed was NULL.");
+    }
+
+    if (size < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "size parameter out of Bounds: %d.", size);
+    }
+
+    if (offset > size || offset < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "offset parameter out of Bounds: %d.", offset);
+    }
+
+    if (length < 0 || length > size - offset) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
+    }
+
+    checkClosed();
+
+    apr_size_t written = 0;
+    apr_status_t result = apr_file_write_full(this->handle->file, buffer + offset, (apr_size_t)length, &written);
+
+    if (result != APR_SUCCESS) {
+        char errorBuffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to write to file %s: %s",
+                          this->name.c_str(), apr_strerror(result, errorBuffer, 255));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStream::checkClosed() const {
+    if (this->handle->file == NULL) {
+        throw IOException(__FILE__, __LINE__, "FileOutputStream for %s is closed.", this->name.c_str());
+    }
+}
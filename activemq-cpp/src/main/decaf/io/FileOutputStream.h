@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_IO_FILEOUTPUTSTREAM_H_
+#define _DECAF_IO_FILEOUTPUTSTREAM_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/io/OutputStream.h>
+
+#include <string>
+
+namespace decaf {
+namespace io {
+
+    class FileOutputStreamHandle;
+
+    /**
+     * An OutputStream that writes bytes to a file on the local file system.  Writes go
+     * straight to the file without buffering in this class, wrap the stream in a
+     * BufferedOutputStream when many small writes are expected.
+     *
+     * @since 1.0
+     */
+    class DECAF_API FileOutputStream : public OutputStream {
+    private:
+
+        FileOutputStreamHandle* handle;
+
+        std::string name;
+
+    private:
+
+        FileOutputStream(const FileOutputStream&);
+        FileOutputStream& operator=(const FileOutputStream&);
+
+    public:
+
+        /**
+         * Opens the named file for writing, the file is created if it does not exist.
+         *
+         * @param name
+         *      The path name of the file to write.
+         * @param append
+         *      If true bytes are written to the end of the existing file, otherwise the
+         *      file is truncated.
+         *
+         * @throws IOException if the file cannot be opened.
+         */
+        FileOutputStream(const std::string& name, bool append = false);
+
+        virtual ~FileOutputStream();
+
+        /**
+         * @return the path name of the file this stream writes to.
+         */
+        const std::string& getName() const {
+            return this->name;
+        }
+
+        virtual void flush();
+
+        /**
+         * Flushes the stream and then forces the bytes written so far out to the storage
+         * device, so that they survive a crash of the operating system or a power loss.
+         * This is much slower than flush, callers decide how often durability is worth it.
+         *
+         * @throws IOException if the file is closed or the data cannot be synced.
+         *
+         * @since 3.10.0
+         */
+        virtual void sync();
+
+        virtual void close();
+
+    protected:
+
+        virtual void doWriteByte(unsigned char value);
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
+
+    private:
+
+        void checkClosed() const;
+
+    };
+
+}}
+
+#endif /* _DECAF_IO_FILEOUTPUTSTREAM_H_ */
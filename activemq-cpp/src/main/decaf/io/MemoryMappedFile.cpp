@@ -0,0 +1,268 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryMappedFile.h"
+
+#include <decaf/io/IOException.h>
+#include <decaf/internal/AprPool.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+#include <apr_errno.h>
+#include <apr_file_io.h>
+#include <apr_file_info.h>
+#include <apr_mmap.h>
+
+#include <memory>
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Mapping offsets must be page aligned on POSIX systems and aligned to the
+    // allocation granularity on Windows, 64k satisfies both.
+    const long long MAPPING_ALIGNMENT = 65536;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace io {
+
+    class MemoryMappedFileHandle {
+    private:
+
+        MemoryMappedFileHandle(const MemoryMappedFileHandle&);
+        MemoryMappedFileHandle& operator=(const MemoryMappedFileHandle&);
+
+    public:
+
+        AprPool pool;
+        apr_file_t* file;
+        apr_mmap_t* mapping;
+
+        MemoryMappedFileHandle() : pool(), file(NULL), mapping(NULL) {}
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryMappedFile::MemoryMappedFile() :
+    handle(new MemoryMappedFileHandle()), name(), offset(0), length(0), data(NULL), readOnly(false) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryMappedFile::MemoryMappedFile(const std::string& name, long long offset, long long length) :
+    handle(new MemoryMappedFileHandle()), name(name), offset(offset), length(length), data(NULL), readOnly(true) {
+
+    try {
+
+        apr_status_t result = apr_file_open(&this->handle->file, name.c_str(), APR_READ | APR_BINARY,
+                                            APR_OS_DEFAULT, this->handle->pool.getAprPool());
+
+        if (result != APR_SUCCESS) {
+            this->handle->file = NULL;
+            char buffer[256] = { 0 };
+            throw IOException(__FILE__, __LINE__, "Failed to open file %s: %s",
+                              name.c_str(), apr_strerror(result, buffer, 255));
+        }
+
+        apr_finfo_t info;
+        result = apr_file_info_get(&info, APR_FINFO_SIZE, this->handle->file);
+        if (result != APR_SUCCESS) {
+            char buffer[256] = { 0 };
+            throw IOException(__FILE__, __LINE__, "Failed to get the size of file %s: %s",
+                              name.c_str(), apr_strerror(result, buffer, 255));
+        }
+
+        this->map((long long)info.size, APR_MMAP_READ);
+
+    } catch (...) {
+        this->close();
+        delete this->handle;
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryMappedFile::~MemoryMappedFile() {
+    try {
+        this->close();
+    }
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->handle;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryMappedFile* MemoryMappedFile::createTemporary(long long length, const std::string& directory) {
+
+    if (length < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Temporary file length cannot be negative: %lld", length);
+    }
+
+    std::auto_ptr<MemoryMappedFile> file(new MemoryMappedFile());
+    MemoryMappedFileHandle* handle = file->handle;
+
+    std::string path = directory;
+    if (path.empty()) {
+        const char* tempDir = NULL;
+        apr_status_t result = apr_temp_dir_get(&tempDir, handle->pool.getAprPool());
+        if (result != APR_SUCCESS) {
+            char buffer[256] = { 0 };
+            throw IOException(__FILE__, __LINE__, "Failed to find a temporary directory: %s",
+                              apr_strerror(result, buffer, 255));
+        }
+        path = tempDir;
+    }
+
+    if (!path.empty() && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\') {
+        path += '/';
+    }
+    path += "amqXXXXXX";
+
+    std::vector<char> pathTemplate(path.begin(), path.end());
+    pathTemplate.push_back('\0');
+
+    apr_status_t result = apr_file_mktemp(&handle->file, &pathTemplate[0],
+        APR_CREATE | APR_READ | APR_WRITE | APR_EXCL | APR_DELONCLOSE | APR_BINARY,
+        handle->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        handle->file = NULL;
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to create temporary file %s: %s",
+                          path.c_str(), apr_strerror(result, buffer, 255));
+    }
+
+    file->name = &pathTemplate[0];
+    file->length = length;
+
+    result = apr_file_trunc(handle->file, (apr_off_t)length);
+    if (result != APR_SUCCESS) {
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to size temporary file %s: %s",
+                          file->name.c_str(), apr_strerror(result, buffer, 255));
+    }
+
+    file->map(length, APR_MMAP_READ | APR_MMAP_WRITE);
+
+    return file.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryMappedFile::isClosed() const {
+    return this->handle->file == NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const unsigned char* MemoryMappedFile::getData() const {
+    checkClosed();
+    return this->data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned char* MemoryMappedFile::getWritableData() {
+
+    checkClosed();
+
+    if (this->readOnly) {
+        throw IllegalStateException(__FILE__, __LINE__,
+            "Mapping of file %s is read-only.", this->name.c_str());
+    }
+
+    return this->data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFile::close() {
+
+    if (this->handle->file == NULL) {
+        return;
+    }
+
+    if (this->handle->mapping != NULL) {
+        apr_mmap_delete(this->handle->mapping);
+        this->handle->mapping = NULL;
+    }
+
+    this->data = NULL;
+
+    apr_file_close(this->handle->file);
+    this->handle->file = NULL;
+    this->handle->pool.cleanup();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFile::map(long long fileSize, int flags) {
+
+    if (this->offset < 0 || this->offset > fileSize) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Offset %lld is outside of file %s which has %lld bytes.",
+            this->offset, this->name.c_str(), fileSize);
+    }
+
+    if (this->length < 0) {
+        this->length = fileSize - this->offset;
+    } else if (this->length > fileSize - this->offset) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Region of %lld bytes at offset %lld is outside of file %s which has %lld bytes.",
+            this->length, this->offset, this->name.c_str(), fileSize);
+    }
+
+    if (this->length == 0) {
+        return;
+    }
+
+    long long alignedOffset = this->offset - (this->offset % MAPPING_ALIGNMENT);
+    unsigned long long mappedSize = (unsigned long long)(this->length + this->offset - alignedOffset);
+
+    if (mappedSize > (unsigned long long)((apr_size_t)-1)) {
+        throw IOException(__FILE__, __LINE__,
+            "Region of %lld bytes is too large to map on this platform.", this->length);
+    }
+
+    apr_status_t result = apr_mmap_create(&this->handle->mapping, this->handle->file,
+                                          (apr_off_t)alignedOffset, (apr_size_t)mappedSize,
+                                          flags, this->handle->pool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+        this->handle->mapping = NULL;
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to map file %s: %s",
+                          this->name.c_str(), apr_strerror(result, buffer, 255));
+    }
+
+    this->data = (unsigned char*)this->handle->mapping->mm + (this->offset - alignedOffset);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFile::checkClosed() const {
+    if (this->handle->file == NULL) {
+        throw IOException(__FILE__, __LINE__, "Mapping of file %s is closed.", this->name.c_str());
+    }
+}
@@ -0,0 +1,168 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_IO_MEMORYMAPPEDFILE_H_
+#define _DECAF_IO_MEMORYMAPPEDFILE_H_
+
+#include <decaf/util/Config.h>
+
+#include <string>
+
+namespace decaf {
+namespace io {
+
+    class MemoryMappedFileHandle;
+
+    /**
+     * Maps a region of a file on the local file system into memory so that its bytes
+     * can be read, and for temporary files written, without copying them through a
+     * stream.  The mapping stays valid until close is called or the object is destroyed.
+     *
+     * A mapping is either a read-only view of a region of an existing file, or a
+     * read-write view of a temporary file created with createTemporary.  Temporary files
+     * are removed from the file system when the mapping is closed.
+     *
+     * @since 1.0
+     */
+    class DECAF_API MemoryMappedFile {
+    private:
+
+        MemoryMappedFileHandle* handle;
+
+        std::string name;
+
+        long long offset;
+
+        long long length;
+
+        unsigned char* data;
+
+        bool readOnly;
+
+    private:
+
+        MemoryMappedFile(const MemoryMappedFile&);
+        MemoryMappedFile& operator=(const MemoryMappedFile&);
+
+        MemoryMappedFile();
+
+    public:
+
+        /**
+         * Maps a region of the named file read-only.
+         *
+         * @param name
+         *      The path name of the file to map.
+         * @param offset
+         *      The position in the file where the mapped region starts.
+         * @param length
+         *      The number of bytes to map, or -1 to map everything from offset to the end
+         *      of the file.
+         *
+         * @throws IOException if the file cannot be opened or mapped.
+         * @throws IllegalArgumentException if the region does not lie within the file.
+         */
+        MemoryMappedFile(const std::string& name, long long offset = 0, long long length = -1);
+
+        virtual ~MemoryMappedFile();
+
+        /**
+         * Creates a temporary file of the given size and maps all of it read-write, the
+         * file is deleted when the mapping is closed.
+         *
+         * @param length
+         *      The size in bytes of the temporary file.
+         * @param directory
+         *      The directory to create the file in, when empty the system temporary
+         *      directory is used.
+         *
+         * @return a new read-write mapping that the caller owns.
+         *
+         * @throws IOException if the file cannot be created or mapped.
+         * @throws IllegalArgumentException if length is negative.
+         */
+        static MemoryMappedFile* createTemporary(long long length, const std::string& directory = "");
+
+        /**
+         * @return the path name of the mapped file.
+         */
+        const std::string& getName() const {
+            return this->name;
+        }
+
+        /**
+         * @return the position in the file where the mapped region starts.
+         */
+        long long getOffset() const {
+            return this->offset;
+        }
+
+        /**
+         * @return the number of bytes in the mapped region.
+         */
+        long long getLength() const {
+            return this->length;
+        }
+
+        /**
+         * @return true if the mapped bytes cannot be modified.
+         */
+        bool isReadOnly() const {
+            return this->readOnly;
+        }
+
+        /**
+         * @return true if close has been called.
+         */
+        bool isClosed() const;
+
+        /**
+         * Returns the first byte of the mapped region, or NULL when the region is empty.
+         *
+         * @return pointer to the mapped bytes.
+         *
+         * @throws IOException if the mapping has been closed.
+         */
+        const unsigned char* getData() const;
+
+        /**
+         * Returns the first byte of the mapped region for writing.
+         *
+         * @return pointer to the mapped bytes.
+         *
+         * @throws IOException if the mapping has been closed.
+         * @throws IllegalStateException if the mapping is read-only.
+         */
+        unsigned char* getWritableData();
+
+        /**
+         * Unmaps the region and closes the file, temporary files are removed.  Calling
+         * this method more than once has no effect.
+         */
+        void close();
+
+    private:
+
+        void map(long long fileSize, int flags);
+
+        void checkClosed() const;
+
+    };
+
+}}
+
+#endif /* _DECAF_IO_MEMORYMAPPEDFILE_H_ */
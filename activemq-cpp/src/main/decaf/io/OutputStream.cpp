@@ -82,6 +82,37 @@ void OutputStream::write(const unsigned char* buffer, int size, int offset, int
     DECAF_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void OutputStream::writeGathered(const unsigned char* const* buffers, const int* lengths, int count) {
+
+    if (count < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "count parameter out of Bounds: %d.", count);
+    }
+
+    if (count > 0 && (buffers == NULL || lengths == NULL)) {
+        throw NullPointerException(__FILE__, __LINE__, "Buffer or length array passed was NULL.");
+    }
+
+    for (int i = 0; i < count; ++i) {
+
+        if (lengths[i] < 0) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", lengths[i]);
+        }
+
+        if (buffers[i] == NULL && lengths[i] > 0) {
+            throw NullPointerException(__FILE__, __LINE__, "Buffer pointer passed was NULL.");
+        }
+    }
+
+    try {
+        this->doWriteGathered(buffers, lengths, count);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void OutputStream::doWriteArray(const unsigned char* buffer, int size) {
 
@@ -121,3 +152,19 @@ void OutputStream::doWriteArrayBounded(const unsigned char* buffer, int size, in
     DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
     DECAF_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void OutputStream::doWriteGathered(const unsigned char* const* buffers, const int* lengths, int count) {
+
+    try {
+        for (int i = 0; i < count; ++i) {
+            if (lengths[i] > 0) {
+                this->doWriteArrayBounded(buffers[i], lengths[i], 0, lengths[i]);
+            }
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
@@ -126,6 +126,29 @@ namespace io{
          */
         virtual void write(const unsigned char* buffer, int size, int offset, int length);
 
+        /**
+         * Writes a sequence of byte arrays to the output stream, the result is the same as
+         * calling write once for each array in order.
+         *
+         * The default implementation of this method calls doWriteGathered which writes each
+         * array with doWriteArrayBounded.  Streams whose sink can accept several arrays in one
+         * operation, a socket's writev for instance, override doWriteGathered to do so.
+         *
+         * @param buffers
+         *      The arrays of bytes to write.
+         * @param lengths
+         *      The number of bytes to write from each array.
+         * @param count
+         *      The number of arrays passed.
+         *
+         * @throws IOException if an I/O error occurs.
+         * @throws NullPointerException thrown if buffers, lengths or one of the arrays is Null.
+         * @throws IndexOutOfBoundsException if count or one of the lengths is negative.
+         *
+         * @since 1.0
+         */
+        virtual void writeGathered(const unsigned char* const* buffers, const int* lengths, int count);
+
         /**
          * Output a String representation of this object.
          *
@@ -143,6 +166,8 @@ namespace io{
 
         virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
 
+        virtual void doWriteGathered(const unsigned char* const* buffers, const int* lengths, int count);
+
     public:
 
         virtual void lock() {
@@ -350,6 +350,12 @@ namespace lang {
         return out;
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename T, typename R>
+    inline void swap(Pointer<T, R>& left, Pointer<T, R>& right) {
+        left.swap(right);
+    }
+
     /**
      * This implementation of Comparator is designed to allows objects in a Collection
      * to be sorted or tested for equality based on the value of the Object being Pointed
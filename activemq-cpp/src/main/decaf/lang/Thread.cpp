@@ -257,6 +257,28 @@ int Thread::getPriority() const {
     return Threading::getThreadPriority(this->properties->handle);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<int> Thread::getAffinity() const {
+    std::vector<int> cpus;
+    Threading::getThreadAffinity(this->properties->handle, cpus);
+    return cpus;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Thread::setAffinity(const std::vector<int>& cpus) {
+
+    std::vector<int>::const_iterator iter = cpus.begin();
+    for (; iter != cpus.end(); ++iter) {
+        if (*iter < 0) {
+            throw IllegalArgumentException(
+                __FILE__, __LINE__,
+                "Thread::setAffinity - Specified processor {%d} is out of range", *iter);
+        }
+    }
+
+    Threading::setThreadAffinity(this->properties->handle, cpus);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void Thread::setUncaughtExceptionHandler(UncaughtExceptionHandler* handler) {
     this->properties->exHandler = handler;
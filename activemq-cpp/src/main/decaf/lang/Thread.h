@@ -21,10 +21,13 @@
 #include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/lang/exceptions/InterruptedException.h>
 #include <decaf/lang/exceptions/RuntimeException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/lang/Exception.h>
 #include <decaf/lang/Runnable.h>
 #include <decaf/util/Config.h>
 
+#include <vector>
+
 namespace decaf {
 namespace internal {
 namespace util {
@@ -289,6 +292,31 @@ namespace lang {
          */
         void setPriority(int value);
 
+        /**
+         * Gets the set of processors that this Thread is currently allowed to run on as
+         * reported by the operating system.
+         *
+         * @return a vector of zero based processor numbers in ascending order.
+         *
+         * @throws UnsupportedOperationException if the platform cannot report thread affinity.
+         * @throws RuntimeException if the operating system reports an error.
+         */
+        std::vector<int> getAffinity() const;
+
+        /**
+         * Restricts this Thread to the given set of processors.  The processor numbers are
+         * zero based, an empty set removes any previous restriction.  The affinity can be
+         * assigned before the Thread is started in which case it applies from the first
+         * instruction of the run method.
+         *
+         * @param cpus the processors this Thread is allowed to run on.
+         *
+         * @throws IllegalArgumentException if any processor number is negative.
+         * @throws UnsupportedOperationException if the platform cannot assign thread affinity.
+         * @throws RuntimeException if the operating system rejects the processor set.
+         */
+        void setAffinity(const std::vector<int>& cpus);
+
         /**
          * Set the handler invoked when this thread abruptly terminates due to an uncaught exception.
          *
@@ -0,0 +1,1027 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_FLATHASHMAP_H_
+#define _DECAF_UTIL_FLATHASHMAP_H_
+
+#include <decaf/util/Config.h>
+
+#include <decaf/util/AbstractMap.h>
+#include <decaf/util/AbstractSet.h>
+#include <decaf/util/AbstractCollection.h>
+#include <decaf/util/HashCode.h>
+#include <decaf/util/NoSuchElementException.h>
+#include <decaf/util/ConcurrentModificationException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+#include <decaf/lang/Pointer.h>
+
+#include <vector>
+
+namespace decaf {
+namespace util {
+
+    /**
+     * Open addressing hash table based implementation of the Map interface.
+     *
+     * The mappings are held in a dense array of entries and located through a separate
+     * index table using Robin Hood linear probing: each slot of the index records the hash
+     * of its key and the position of its entry, and an insert displaces any resident that
+     * sits closer to its home slot than the key being placed.  This keeps every probe
+     * sequence short and lets a lookup stop as soon as it meets a slot nearer its home
+     * than the probe distance so far.  Removal shifts the following slots back rather
+     * than leaving tombstones, and moves the last entry into the freed position so the
+     * entry array stays dense.
+     *
+     * Compared to HashMap this performs no allocation per mapping, a lookup touches one
+     * or two cache lines instead of walking a chain of separately allocated nodes, and
+     * iteration over the collection views is proportional to the number of mappings
+     * rather than the capacity of the table.
+     *
+     * The capacity and load factor have the same meaning as for HashMap.  Load factors
+     * above 0.9 are reduced to 0.9 since an open addressing table must keep free slots.
+     *
+     * Because the entries are stored by value, a reference returned from get() is only
+     * valid until the next structural modification of the map; copy the value if it must
+     * outlive a put or remove.  The map makes no guarantees as to its iteration order,
+     * and removing a mapping changes the position of another one.
+     *
+     * This implementation is not synchronized, and the iterators returned by the collection
+     * views are fail-fast in the same manner as those of HashMap.
+     *
+     * @since 3.10.0
+     */
+    template<typename K, typename V, typename HASHCODE = HashCode<K> >
+    class FlatHashMap : public AbstractMap<K, V> {
+    protected:
+
+        class FlatHashMapEntry : public MapEntry<K, V> {
+        public:
+
+            unsigned int keyHash;
+
+            // Index table slot referring to this entry, or -1 if the entry is unused.
+            int slot;
+
+            FlatHashMapEntry() : MapEntry<K, V>(), keyHash(0), slot(-1) {
+            }
+
+            FlatHashMapEntry(const K& key, const V& value, unsigned int hash) :
+                MapEntry<K, V>(key, value), keyHash(hash), slot(-1) {
+            }
+
+            FlatHashMapEntry(const FlatHashMapEntry& other) :
+                MapEntry<K, V>(other), keyHash(other.keyHash), slot(other.slot) {
+            }
+
+            FlatHashMapEntry& operator= (const FlatHashMapEntry& other) {
+                MapEntry<K, V>::operator= (other);
+                this->keyHash = other.keyHash;
+                this->slot = other.slot;
+                return *this;
+            }
+
+            bool isUsed() const {
+                return this->slot >= 0;
+            }
+
+            // Non virtual accessors for the map's own use, this class never overrides
+            // those of MapEntry so the qualified calls can be inlined.
+            K& key() {
+                return MapEntry<K, V>::getKey();
+            }
+
+            const K& key() const {
+                return MapEntry<K, V>::getKey();
+            }
+
+            V& value() {
+                return MapEntry<K, V>::getValue();
+            }
+
+            const V& value() const {
+                return MapEntry<K, V>::getValue();
+            }
+
+            void swap(FlatHashMapEntry& other) {
+                using std::swap;
+                swap(this->key(), other.key());
+                swap(this->value(), other.value());
+                swap(this->keyHash, other.keyHash);
+                swap(this->slot, other.slot);
+            }
+        };
+
+        struct IndexSlot {
+            unsigned int keyHash;
+            int entry;
+        };
+
+    private:
+
+        class AbstractMapIterator {
+        protected:
+
+            mutable int position;
+            int current;
+            int expectedModCount;
+            bool readOnly;
+
+            FlatHashMap* associatedMap;
+
+        private:
+
+            AbstractMapIterator(const AbstractMapIterator&);
+            AbstractMapIterator& operator= (const AbstractMapIterator&);
+
+        public:
+
+            AbstractMapIterator(FlatHashMap* parent, bool readOnly) : position(0),
+                                                                      current(-1),
+                                                                      expectedModCount(parent->modCount),
+                                                                      readOnly(readOnly),
+                                                                      associatedMap(parent) {
+            }
+
+            virtual ~AbstractMapIterator() {}
+
+            bool checkHasNext() const {
+                int length = (int) associatedMap->entries.size();
+                while (position < length && !associatedMap->entries[position].isUsed()) {
+                    position++;
+                }
+                return position < length;
+            }
+
+            void checkConcurrentMod() const {
+                if (expectedModCount != associatedMap->modCount) {
+                    throw ConcurrentModificationException(
+                        __FILE__, __LINE__, "FlatHashMap modified outside this iterator");
+                }
+            }
+
+            FlatHashMapEntry& makeNext() {
+                checkConcurrentMod();
+
+                if (!checkHasNext()) {
+                    throw NoSuchElementException(__FILE__, __LINE__, "No next element");
+                }
+
+                current = position++;
+                return associatedMap->entries[current];
+            }
+
+            void doRemove() {
+
+                if (readOnly) {
+                    throw decaf::lang::exceptions::UnsupportedOperationException(
+                        __FILE__, __LINE__, "Cannot write to a Const Collection.");
+                }
+
+                checkConcurrentMod();
+
+                if (current < 0) {
+                    throw decaf::lang::exceptions::IllegalStateException(
+                        __FILE__, __LINE__, "Remove called before call to next()");
+                }
+
+                // Whatever takes the place of the removed entry has not been visited yet.
+                associatedMap->removeEntryAt(current);
+                position = current;
+                current = -1;
+
+                expectedModCount = associatedMap->modCount;
+            }
+        };
+
+        class EntryIterator : public Iterator< MapEntry<K,V> >, public AbstractMapIterator {
+        private:
+
+            EntryIterator(const EntryIterator&);
+            EntryIterator& operator= (const EntryIterator&);
+
+        public:
+
+            EntryIterator(FlatHashMap* parent, bool readOnly) : AbstractMapIterator(parent, readOnly) {
+            }
+
+            virtual ~EntryIterator() {}
+
+            virtual bool hasNext() const {
+                return this->checkHasNext();
+            }
+
+            virtual MapEntry<K, V> next() {
+                return this->makeNext();
+            }
+
+            virtual void remove() {
+                this->doRemove();
+            }
+        };
+
+        class KeyIterator : public Iterator<K>, public AbstractMapIterator {
+        private:
+
+            KeyIterator(const KeyIterator&);
+            KeyIterator& operator= (const KeyIterator&);
+
+        public:
+
+            KeyIterator(FlatHashMap* parent, bool readOnly) : AbstractMapIterator(parent, readOnly) {
+            }
+
+            virtual ~KeyIterator() {}
+
+            virtual bool hasNext() const {
+                return this->checkHasNext();
+            }
+
+            virtual K next() {
+                return this->makeNext().key();
+            }
+
+            virtual void remove() {
+                this->doRemove();
+            }
+        };
+
+        class ValueIterator : public Iterator<V>, public AbstractMapIterator {
+        private:
+
+            ValueIterator(const ValueIterator&);
+            ValueIterator& operator= (const ValueIterator&);
+
+        public:
+
+            ValueIterator(FlatHashMap* parent, bool readOnly) : AbstractMapIterator(parent, readOnly) {
+            }
+
+            virtual ~ValueIterator() {}
+
+            virtual bool hasNext() const {
+                return this->checkHasNext();
+            }
+
+            virtual V next() {
+                return this->makeNext().value();
+            }
+
+            virtual void remove() {
+                this->doRemove();
+            }
+        };
+
+    protected:
+
+        // Set implementation that is backed by this FlatHashMap, when read only it serves
+        // as the view returned from a const map.
+        class FlatHashMapEntrySet : public AbstractSet< MapEntry<K, V> > {
+        private:
+
+            FlatHashMap* associatedMap;
+            bool readOnly;
+
+            FlatHashMapEntrySet(const FlatHashMapEntrySet&);
+            FlatHashMapEntrySet& operator= (const FlatHashMapEntrySet&);
+
+        public:
+
+            FlatHashMapEntrySet(FlatHashMap* parent, bool readOnly) :
+                AbstractSet< MapEntry<K,V> >(), associatedMap(parent), readOnly(readOnly) {
+            }
+
+            virtual ~FlatHashMapEntrySet() {}
+
+            virtual int size() const {
+                return associatedMap->elementCount;
+            }
+
+            virtual void clear() {
+                checkWritable();
+                associatedMap->clear();
+            }
+
+            virtual bool remove(const MapEntry<K,V>& entry) {
+                checkWritable();
+                int index = associatedMap->findEntry(entry.getKey());
+                if (index >= 0 && entry.getValue() == associatedMap->entries[index].value()) {
+                    associatedMap->removeEntryAt(index);
+                    return true;
+                }
+
+                return false;
+            }
+
+            virtual bool contains(const MapEntry<K,V>& entry) const {
+                int index = associatedMap->findEntry(entry.getKey());
+                return index >= 0 && entry.getValue() == associatedMap->entries[index].value();
+            }
+
+            virtual Iterator< MapEntry<K, V> >* iterator() {
+                return new EntryIterator(associatedMap, readOnly);
+            }
+
+            virtual Iterator< MapEntry<K, V> >* iterator() const {
+                return new EntryIterator(associatedMap, true);
+            }
+
+        private:
+
+            void checkWritable() const {
+                if (readOnly) {
+                    throw decaf::lang::exceptions::UnsupportedOperationException(
+                        __FILE__, __LINE__, "Can't modify a const collection");
+                }
+            }
+        };
+
+        class FlatHashMapKeySet : public AbstractSet<K> {
+        private:
+
+            FlatHashMap* associatedMap;
+            bool readOnly;
+
+            FlatHashMapKeySet(const FlatHashMapKeySet&);
+            FlatHashMapKeySet& operator= (const FlatHashMapKeySet&);
+
+        public:
+
+            FlatHashMapKeySet(FlatHashMap* parent, bool readOnly) :
+                AbstractSet<K>(), associatedMap(parent), readOnly(readOnly) {
+            }
+
+            virtual ~FlatHashMapKeySet() {}
+
+            virtual bool contains(const K& key) const {
+                return this->associatedMap->containsKey(key);
+            }
+
+            virtual int size() const {
+                return this->associatedMap->size();
+            }
+
+            virtual void clear() {
+                checkWritable();
+                this->associatedMap->clear();
+            }
+
+            virtual bool remove(const K& key) {
+                checkWritable();
+                int index = this->associatedMap->findEntry(key);
+                if (index >= 0) {
+                    this->associatedMap->removeEntryAt(index);
+                    return true;
+                }
+                return false;
+            }
+
+            virtual Iterator<K>* iterator() {
+                return new KeyIterator(this->associatedMap, readOnly);
+            }
+
+            virtual Iterator<K>* iterator() const {
+                return new KeyIterator(this->associatedMap, true);
+            }
+
+        private:
+
+            void checkWritable() const {
+                if (readOnly) {
+                    throw decaf::lang::exceptions::UnsupportedOperationException(
+                        __FILE__, __LINE__, "Can't modify a const collection");
+                }
+            }
+        };
+
+        class FlatHashMapValueCollection : public AbstractCollection<V> {
+        private:
+
+            FlatHashMap* associatedMap;
+            bool readOnly;
+
+            FlatHashMapValueCollection(const FlatHashMapValueCollection&);
+            FlatHashMapValueCollection& operator= (const FlatHashMapValueCollection&);
+
+        public:
+
+            FlatHashMapValueCollection(FlatHashMap* parent, bool readOnly) :
+                AbstractCollection<V>(), associatedMap(parent), readOnly(readOnly) {
+            }
+
+            virtual ~FlatHashMapValueCollection() {}
+
+            virtual bool contains(const V& value) const {
+                return this->associatedMap->containsValue(value);
+            }
+
+            virtual int size() const {
+                return this->associatedMap->size();
+            }
+
+            virtual void clear() {
+                if (readOnly) {
+                    throw decaf::lang::exceptions::UnsupportedOperationException(
+                        __FILE__, __LINE__, "Can't modify a const collection");
+                }
+                this->associatedMap->clear();
+            }
+
+            virtual Iterator<V>* iterator() {
+                return new ValueIterator(this->associatedMap, readOnly);
+            }
+
+            virtual Iterator<V>* iterator() const {
+                return new ValueIterator(this->associatedMap, true);
+            }
+        };
+
+    protected:
+
+        /**
+         * The Hash Code generator for this map's keys.
+         */
+        HASHCODE hashFunc;
+
+        /*
+         * Actual count of mappings.
+         */
+        int elementCount;
+
+        /*
+         * The mappings, in an order chosen by the map.  Entries are stored by value and
+         * may be moved by any structural modification.  Subclasses that reorder entries
+         * on access do so from const methods, hence mutable.
+         */
+        mutable std::vector<FlatHashMapEntry> entries;
+
+        /*
+         * Robin Hood index table, its length is always a power of two.
+         */
+        mutable std::vector<IndexSlot> slots;
+
+        /*
+         * modification count, to keep track of structural modifications between the
+         * map and the iterator
+         */
+        mutable int modCount;
+
+        /*
+         * maximum ratio of (stored elements)/(index table size) which does not lead to rehash
+         */
+        float loadFactor;
+
+        /*
+         * maximum number of elements that can be put in this map before having to rehash
+         */
+        int threshold;
+
+        /*
+         * 32 less the log2 of the index table size, see homeSlot.
+         */
+        int indexShift;
+
+        // Cached values that are only initialized once a request for them is made.
+        decaf::lang::Pointer<FlatHashMapEntrySet> cachedEntrySet;
+        decaf::lang::Pointer<FlatHashMapKeySet> cachedKeySet;
+        decaf::lang::Pointer<FlatHashMapValueCollection> cachedValueCollection;
+
+        // Cached values that are only initialized once a request for them is made.
+        mutable decaf::lang::Pointer<FlatHashMapEntrySet> cachedConstEntrySet;
+        mutable decaf::lang::Pointer<FlatHashMapKeySet> cachedConstKeySet;
+        mutable decaf::lang::Pointer<FlatHashMapValueCollection> cachedConstValueCollection;
+
+    private:
+
+        static const int MINIMUM_CAPACITY = 16;
+
+        static int calculateCapacity(int x) {
+            if (x >= 1 << 30) {
+                return 1 << 30;
+            }
+
+            if (x <= MINIMUM_CAPACITY) {
+                return MINIMUM_CAPACITY;
+            }
+            x = x - 1;
+            x |= x >> 1;
+            x |= x >> 2;
+            x |= x >> 4;
+            x |= x >> 8;
+            x |= x >> 16;
+            return x + 1;
+        }
+
+        void initialize(int capacity, float loadFactor) {
+            if (capacity < 0 || !(loadFactor > 0)) {
+                throw decaf::lang::exceptions::IllegalArgumentException(
+                    __FILE__, __LINE__, "Invalid configuration");
+            }
+
+            this->loadFactor = loadFactor > 0.9f ? 0.9f : loadFactor;
+            resizeIndex(calculateCapacity(capacity));
+        }
+
+    public:
+
+        /**
+         * Creates a new empty FlatHashMap with default configuration settings.
+         */
+        FlatHashMap() : AbstractMap<K,V>(), hashFunc(), elementCount(0), entries(), slots(),
+                        modCount(0), loadFactor(0.75), threshold(0), indexShift(32),
+                        cachedEntrySet(), cachedKeySet(), cachedValueCollection(),
+                        cachedConstEntrySet(), cachedConstKeySet(), cachedConstValueCollection() {
+            initialize(MINIMUM_CAPACITY, 0.75f);
+        }
+
+        /**
+         * Constructs a new FlatHashMap instance with the specified capacity.
+         *
+         * @param capacity
+         *      The initial capacity of this hash map.
+         *
+         * @throws IllegalArgumentException when the capacity is less than zero.
+         */
+        FlatHashMap(int capacity) : AbstractMap<K,V>(), hashFunc(), elementCount(0), entries(), slots(),
+                                    modCount(0), loadFactor(0.75), threshold(0), indexShift(32),
+                                    cachedEntrySet(), cachedKeySet(), cachedValueCollection(),
+                                    cachedConstEntrySet(), cachedConstKeySet(), cachedConstValueCollection() {
+            initialize(capacity, 0.75f);
+        }
+
+        /**
+         * Constructs a new FlatHashMap instance with the specified capacity and load factor.
+         *
+         * @param capacity
+         *      The initial capacity of this hash map.
+         * @param loadFactor
+         *      The load factor to use for this hash map.
+         *
+         * @throws IllegalArgumentException when the capacity is less than zero or the
+         *         load factor is less than or equal to zero.
+         */
+        FlatHashMap(int capacity, float loadFactor) :
+            AbstractMap<K,V>(), hashFunc(), elementCount(0), entries(), slots(),
+            modCount(0), loadFactor(0.75), threshold(0), indexShift(32),
+            cachedEntrySet(), cachedKeySet(), cachedValueCollection(),
+            cachedConstEntrySet(), cachedConstKeySet(), cachedConstValueCollection() {
+            initialize(capacity, loadFactor);
+        }
+
+        /**
+         * Creates a new FlatHashMap with default configuration settings and fills it with
+         * the contents of the given source FlatHashMap instance.
+         *
+         * @param map
+         *      The FlatHashMap instance whose elements are copied into this instance.
+         */
+        FlatHashMap(const FlatHashMap& map) :
+            AbstractMap<K,V>(), hashFunc(), elementCount(0), entries(), slots(),
+            modCount(0), loadFactor(0.75), threshold(0), indexShift(32),
+            cachedEntrySet(), cachedKeySet(), cachedValueCollection(),
+            cachedConstEntrySet(), cachedConstKeySet(), cachedConstValueCollection() {
+            initialize(map.size(), 0.75f);
+            putAll(map);
+        }
+
+        /**
+         * Creates a new FlatHashMap with default configuration settings and fills it with
+         * the contents of the given source Map instance.
+         *
+         * @param map
+         *      The Map instance whose elements are copied into this instance.
+         */
+        FlatHashMap(const Map<K,V>& map) :
+            AbstractMap<K,V>(), hashFunc(), elementCount(0), entries(), slots(),
+            modCount(0), loadFactor(0.75), threshold(0), indexShift(32),
+            cachedEntrySet(), cachedKeySet(), cachedValueCollection(),
+            cachedConstEntrySet(), cachedConstKeySet(), cachedConstValueCollection() {
+            initialize(map.size(), 0.75f);
+            putAll(map);
+        }
+
+        virtual ~FlatHashMap() {}
+
+    public:
+
+        FlatHashMap<K, V, HASHCODE>& operator= (const Map<K, V>& other) {
+            this->copy(other);
+            return *this;
+        }
+
+        FlatHashMap<K, V, HASHCODE>& operator= (const FlatHashMap<K, V, HASHCODE>& other) {
+            this->copy(other);
+            return *this;
+        }
+
+        bool operator==(const Map<K, V>& other) const {
+            return this->equals(other);
+        }
+
+        bool operator!=(const Map<K, V>& other) const {
+            return !this->equals(other);
+        }
+
+    public:
+
+        virtual void clear() {
+            if (!entries.empty()) {
+                entries.clear();
+                for (typename std::vector<IndexSlot>::iterator iter = slots.begin(); iter != slots.end(); ++iter) {
+                    iter->entry = -1;
+                }
+            }
+
+            if (elementCount > 0) {
+                elementCount = 0;
+                modCount++;
+            }
+        }
+
+        virtual bool isEmpty() const {
+            return elementCount == 0;
+        }
+
+        virtual int size() const {
+            return elementCount;
+        }
+
+        virtual bool containsKey(const K& key) const {
+            return findEntry(key) >= 0;
+        }
+
+        virtual bool containsValue(const V& value) const {
+            typename std::vector<FlatHashMapEntry>::const_iterator iter = entries.begin();
+            for (; iter != entries.end(); ++iter) {
+                if (iter->isUsed() && value == iter->value()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        virtual V& get(const K& key) {
+            int index = findEntry(key);
+            if (index >= 0) {
+                return entries[accessEntry(index)].value();
+            }
+
+            throw NoSuchElementException(
+                __FILE__, __LINE__, "The specified key is not present in the Map");
+        }
+
+        virtual const V& get(const K& key) const {
+            int index = findEntry(key);
+            if (index >= 0) {
+                return entries[accessEntry(index)].value();
+            }
+
+            throw NoSuchElementException(
+                __FILE__, __LINE__, "The specified key is not present in the Map");
+        }
+
+        virtual bool put(const K& key, const V& value) {
+            return this->putImpl(key, value);
+        }
+
+        virtual bool put(const K& key, const V& value, V& oldValue) {
+            return this->putImpl(key, value, oldValue);
+        }
+
+        virtual void putAll(const Map<K, V>& map) {
+            if (!map.isEmpty()) {
+                putAllImpl(map);
+            }
+        }
+
+        virtual V remove(const K& key) {
+            int index = findEntry(key);
+            if (index >= 0) {
+                V oldValue = entries[index].value();
+                removeEntryAt(index);
+                return oldValue;
+            }
+
+            throw NoSuchElementException(
+                __FILE__, __LINE__, "Specified key not present in the Map.");
+        }
+
+        virtual Set< MapEntry<K,V> >& entrySet() {
+            if (this->cachedEntrySet == NULL) {
+                this->cachedEntrySet.reset(new FlatHashMapEntrySet(this, false));
+            }
+            return *(this->cachedEntrySet);
+        }
+
+        virtual const Set< MapEntry<K,V> >& entrySet() const {
+            if (this->cachedConstEntrySet == NULL) {
+                this->cachedConstEntrySet.reset(new FlatHashMapEntrySet(const_cast<FlatHashMap*>(this), true));
+            }
+            return *(this->cachedConstEntrySet);
+        }
+
+        virtual Set<K>& keySet() {
+            if (this->cachedKeySet == NULL) {
+                this->cachedKeySet.reset(new FlatHashMapKeySet(this, false));
+            }
+            return *(this->cachedKeySet);
+        }
+
+        virtual const Set<K>& keySet() const {
+            if (this->cachedConstKeySet == NULL) {
+                this->cachedConstKeySet.reset(new FlatHashMapKeySet(const_cast<FlatHashMap*>(this), true));
+            }
+            return *(this->cachedConstKeySet);
+        }
+
+        virtual Collection<V>& values() {
+            if (this->cachedValueCollection == NULL) {
+                this->cachedValueCollection.reset(new FlatHashMapValueCollection(this, false));
+            }
+            return *(this->cachedValueCollection);
+        }
+
+        virtual const Collection<V>& values() const {
+            if (this->cachedConstValueCollection == NULL) {
+                this->cachedConstValueCollection.reset(
+                    new FlatHashMapValueCollection(const_cast<FlatHashMap*>(this), true));
+            }
+            return *(this->cachedConstValueCollection);
+        }
+
+        virtual bool equals(const Map<K, V>& source) const {
+
+            if (this == &source) {
+                return true;
+            }
+
+            if (size() != source.size()) {
+                return false;
+            }
+
+            typename std::vector<FlatHashMapEntry>::const_iterator iter = entries.begin();
+            for (; iter != entries.end(); ++iter) {
+                if (!iter->isUsed()) {
+                    continue;
+                }
+
+                if (!source.containsKey(iter->key())) {
+                    return false;
+                }
+
+                if (source.get(iter->key()) != iter->value()) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        virtual void copy(const Map<K, V>& source) {
+            if (this == &source) {
+                return;
+            }
+
+            this->clear();
+            putAll(source);
+        }
+
+        virtual std::string toString() const {
+            return "FlatHashMap";
+        }
+
+    protected:
+
+        /**
+         * Called whenever an existing mapping is read by get or overwritten by put, giving
+         * subclasses the chance to reposition the entry.
+         *
+         * @param index
+         *      The position of the entry that was accessed.
+         *
+         * @return the position of the entry once the access has been recorded.
+         */
+        virtual int accessEntry(int index) const {
+            return index;
+        }
+
+        /**
+         * Called once an entry's index slot has been removed to release its position in the
+         * entry array.  The default moves the last entry into the freed position, any
+         * subclass that leaves the position unused instead must reset it to a default
+         * constructed entry.
+         *
+         * @param index
+         *      The position of the entry being removed.
+         */
+        virtual void releaseEntry(int index) {
+            int last = (int) entries.size() - 1;
+            if (index != last) {
+                entries[index].swap(entries[last]);
+                slots[entries[index].slot].entry = index;
+            }
+            entries.pop_back();
+        }
+
+        virtual bool putImpl(const K& key, const V& value) {
+            V oldValue;
+            return putImpl(key, value, oldValue);
+        }
+
+        virtual bool putImpl(const K& key, const V& value, V& oldValue) {
+
+            unsigned int hash = hashOf(key);
+            int index = findEntry(key, hash);
+
+            if (index >= 0) {
+                index = accessEntry(index);
+                oldValue = entries[index].value();
+                entries[index].value() = value;
+                return true;
+            }
+
+            while (elementCount >= threshold && slots.size() < (1U << 30)) {
+                resizeIndex((int) slots.size() << 1);
+            }
+
+            FlatHashMapEntry& entry = appendEntry();
+            entry.key() = key;
+            entry.value() = value;
+            entry.keyHash = hash;
+            placeSlot(hash, (int) entries.size() - 1);
+            elementCount++;
+            modCount++;
+
+            return false;
+        }
+
+        void putAllImpl(const Map<K, V>& map) {
+            int capacity = (int) slots.size();
+            while (elementCount + map.size() > (int) ((float) capacity * loadFactor) && capacity < (1 << 30)) {
+                capacity <<= 1;
+            }
+            if (capacity > (int) slots.size()) {
+                resizeIndex(capacity);
+            }
+
+            decaf::lang::Pointer<Iterator< MapEntry<K,V> > > iterator(map.entrySet().iterator());
+            while (iterator->hasNext()) {
+                MapEntry<K, V> entry = iterator->next();
+                this->putImpl(entry.getKey(), entry.getValue());
+            }
+        }
+
+        /**
+         * Fibonacci hashing of the user supplied hash code, the slot is taken from the top
+         * bits of the product (see homeSlot).  Hash codes such as those of strings that
+         * differ only in a trailing counter are clustered in their low bits and would
+         * otherwise build long probe runs.
+         */
+        unsigned int hashOf(const K& key) const {
+            return (unsigned int) hashFunc(key) * 0x9E3779B9U;
+        }
+
+        int homeSlot(unsigned int hash) const {
+            return (int) (hash >> indexShift);
+        }
+
+        int findEntry(const K& key) const {
+            return findEntry(key, hashOf(key));
+        }
+
+        // Returns the position in the entry array of the mapping for key, or -1.
+        int findEntry(const K& key, unsigned int hash) const {
+            const int mask = (int) slots.size() - 1;
+            int index = homeSlot(hash);
+
+            for (int distance = 0;; ++distance) {
+                const IndexSlot& slot = slots[index];
+                if (slot.entry < 0 || probeDistance(slot.keyHash, index) < distance) {
+                    return -1;
+                }
+                if (slot.keyHash == hash && key == entries[slot.entry].key()) {
+                    return slot.entry;
+                }
+                index = (index + 1) & mask;
+            }
+        }
+
+        /**
+         * Adds an unused entry to the end of the entry array and returns it.  When the
+         * array is full it is regrown by swapping the entries into a larger one, which
+         * for keys such as strings is much cheaper than the copies a vector would make.
+         */
+        FlatHashMapEntry& appendEntry() const {
+            if (entries.size() == entries.capacity()) {
+                std::vector<FlatHashMapEntry> grown;
+                grown.reserve(entries.empty() ? (std::size_t) MINIMUM_CAPACITY : entries.size() * 2);
+                grown.resize(entries.size());
+                for (std::size_t i = 0; i < entries.size(); ++i) {
+                    grown[i].swap(entries[i]);
+                }
+                entries.swap(grown);
+            }
+
+            entries.push_back(FlatHashMapEntry());
+            return entries.back();
+        }
+
+        // Removes the mapping at the given position in the entry array.
+        void removeEntryAt(int index) {
+            eraseSlot(entries[index].slot);
+            releaseEntry(index);
+            elementCount--;
+            modCount++;
+        }
+
+        int probeDistance(unsigned int hash, int index) const {
+            return (index - homeSlot(hash)) & ((int) slots.size() - 1);
+        }
+
+        // Inserts a slot for the entry at the given position, displacing any slot that is
+        // nearer to its home than the one being placed.
+        void placeSlot(unsigned int hash, int entry) const {
+            const int mask = (int) slots.size() - 1;
+            int index = homeSlot(hash);
+            IndexSlot incoming;
+            incoming.keyHash = hash;
+            incoming.entry = entry;
+
+            for (int distance = 0;; ++distance) {
+                IndexSlot& slot = slots[index];
+                if (slot.entry < 0) {
+                    slot = incoming;
+                    entries[slot.entry].slot = index;
+                    return;
+                }
+
+                int residentDistance = probeDistance(slot.keyHash, index);
+                if (residentDistance < distance) {
+                    IndexSlot displaced = slot;
+                    slot = incoming;
+                    entries[slot.entry].slot = index;
+                    incoming = displaced;
+                    distance = residentDistance;
+                }
+
+                index = (index + 1) & mask;
+            }
+        }
+
+        // Empties the given slot and shifts the following run back by one.
+        void eraseSlot(int index) const {
+            const int mask = (int) slots.size() - 1;
+            int next = (index + 1) & mask;
+
+            while (slots[next].entry >= 0 && probeDistance(slots[next].keyHash, next) > 0) {
+                slots[index] = slots[next];
+                entries[slots[index].entry].slot = index;
+                index = next;
+                next = (next + 1) & mask;
+            }
+
+            slots[index].entry = -1;
+        }
+
+        void resizeIndex(int capacity) {
+            IndexSlot empty;
+            empty.keyHash = 0;
+            empty.entry = -1;
+            slots.assign(capacity, empty);
+
+            indexShift = 32;
+            for (int length = capacity; length > 1; length >>= 1) {
+                indexShift--;
+            }
+
+            threshold = (int) ((float) capacity * loadFactor);
+            if (threshold >= capacity) {
+                threshold = capacity - 1;
+            }
+
+            for (int i = 0; i < (int) entries.size(); ++i) {
+                if (entries[i].isUsed()) {
+                    placeSlot(entries[i].keyHash, i);
+                }
+            }
+        }
+
+    };
+
+}}
+
+#endif /* _DECAF_UTIL_FLATHASHMAP_H_ */
@@ -0,0 +1,272 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_LINKEDFLATHASHMAP_H_
+#define _DECAF_UTIL_LINKEDFLATHASHMAP_H_
+
+#include <decaf/util/Config.h>
+
+#include <decaf/util/FlatHashMap.h>
+
+namespace decaf {
+namespace util {
+
+    /**
+     * Open addressing hashed map with a predictable iteration order, the flat counterpart
+     * of LinkedHashMap.
+     *
+     * The entry array of the underlying FlatHashMap is kept in insertion order, or in
+     * access order when so configured, so iterating the map is a forward scan of that
+     * array and needs no per entry links.  Removing a mapping leaves its position unused
+     * and recording an access moves the entry to the end of the array; once the unused
+     * positions outnumber the mappings the array is compacted, which keeps the cost of
+     * both amortized constant.
+     *
+     * As with LinkedHashMap the removeEldestEntry method is consulted after every put, and
+     * onEviction is called before the eldest entry is dropped, which makes this class a
+     * suitable base for bounded caches.  In access order mode a get is a structural
+     * modification: it invalidates iterators and references obtained from earlier calls.
+     *
+     * @since 3.10.0
+     */
+    template<typename K, typename V, typename HASHCODE = HashCode<K> >
+    class LinkedFlatHashMap : public FlatHashMap<K, V, HASHCODE> {
+    private:
+
+        typedef typename FlatHashMap<K, V, HASHCODE>::FlatHashMapEntry FlatHashMapEntry;
+
+        bool accessOrder;
+
+        // Number of unused positions in the entry array.
+        mutable int unused;
+
+        // No entry before this position is in use.
+        mutable int eldest;
+
+    public:
+
+        /**
+         * Constructs an empty insertion-ordered LinkedFlatHashMap instance with the default
+         * initial capacity (16) and load factor (0.75).
+         */
+        LinkedFlatHashMap() : FlatHashMap<K, V, HASHCODE>(), accessOrder(false), unused(0), eldest(0) {
+        }
+
+        /**
+         * Constructs a new LinkedFlatHashMap instance with the specified capacity.
+         *
+         * @param capacity
+         *      The initial capacity of this map.
+         *
+         * @throws IllegalArgumentException if the capacity is less than zero.
+         */
+        LinkedFlatHashMap(int capacity) :
+            FlatHashMap<K, V, HASHCODE>(capacity), accessOrder(false), unused(0), eldest(0) {
+        }
+
+        /**
+         * Constructs a new LinkedFlatHashMap instance with the specified capacity and load factor.
+         *
+         * @param capacity
+         *      The initial capacity of this map.
+         * @param load
+         *      The initial load factor for this map.
+         *
+         * @throws IllegalArgumentException
+         *     If the capacity is less than zero or the load factor is less or equal to zero.
+         */
+        LinkedFlatHashMap(int capacity, float load) :
+            FlatHashMap<K, V, HASHCODE>(capacity, load), accessOrder(false), unused(0), eldest(0) {
+        }
+
+        /**
+         * Constructs a new LinkedFlatHashMap instance with the specified capacity, load
+         * factor and a flag specifying the ordering behavior.
+         *
+         * @param capacity
+         *      The initial capacity of this map.
+         * @param load
+         *      The initial load factor for this map.
+         * @param order
+         *      True if the ordering should be done based on the last access (from
+         *      least-recently accessed to most-recently accessed), and  false if
+         *      the ordering should be the order in which the entries were inserted.
+         *
+         * @throws IllegalArgumentException
+         *     If the capacity is less than zero or the load factor is less or equal to zero.
+         */
+        LinkedFlatHashMap(int capacity, float load, bool order) :
+            FlatHashMap<K, V, HASHCODE>(capacity, load), accessOrder(order), unused(0), eldest(0) {
+        }
+
+        /**
+         * Constructs a new LinkedFlatHashMap instance containing the mappings from the
+         * specified map, in the order the map's entry set returns them.
+         *
+         * @param map
+         *      The mappings to add to this Map instance.
+         */
+        LinkedFlatHashMap(const Map<K, V>& map) :
+            FlatHashMap<K, V, HASHCODE>(map.size()), accessOrder(false), unused(0), eldest(0) {
+            this->putAll(map);
+        }
+
+        /**
+         * Constructs a new insertion-ordered LinkedFlatHashMap holding the mappings of
+         * the given map in its current iteration order.
+         *
+         * @param map
+         *      The LinkedFlatHashMap whose mappings are copied.
+         */
+        LinkedFlatHashMap(const LinkedFlatHashMap& map) :
+            FlatHashMap<K, V, HASHCODE>(map.size()), accessOrder(false), unused(0), eldest(0) {
+            this->putAll(map);
+        }
+
+        virtual ~LinkedFlatHashMap() {}
+
+    protected:
+
+        /**
+         * This method is queried from the put methods to check if the eldest member of the
+         * map should be deleted now that the new member has been added.
+         *
+         * @param eldest
+         *      The entry to check if it should be removed.
+         *
+         * @return true if the eldest member should be removed.
+         */
+        virtual bool removeEldestEntry(const MapEntry<K, V>& eldest DECAF_UNUSED) {
+            return false;
+        }
+
+        /**
+         * This method is called when the removeEldestEntry has returned true and a
+         * MapEntry is about to be removed from the Map.  This method allows for Maps
+         * that contain pointers in their MapEntry object to have a chance to properly
+         * delete the pointer when the entry is removed.
+         *
+         * @param eldest
+         *      The MapEntry value that is about to be removed from the Map.
+         */
+        virtual void onEviction(const MapEntry<K, V>& eldest DECAF_UNUSED) {}
+
+    public:
+
+        virtual void clear() {
+            FlatHashMap<K, V, HASHCODE>::clear();
+            this->unused = 0;
+            this->eldest = 0;
+        }
+
+        virtual bool put(const K& key, const V& value) {
+            bool result = this->putImpl(key, value);
+            this->checkEldest();
+            return result;
+        }
+
+        virtual bool put(const K& key, const V& value, V& oldValue) {
+            bool result = this->putImpl(key, value, oldValue);
+            this->checkEldest();
+            return result;
+        }
+
+        virtual V remove(const K& key) {
+            V result = FlatHashMap<K, V, HASHCODE>::remove(key);
+            this->compactIfSparse();
+            return result;
+        }
+
+        virtual std::string toString() const {
+            return "LinkedFlatHashMap";
+        }
+
+    protected:
+
+        virtual int accessEntry(int index) const {
+            int last = (int) this->entries.size() - 1;
+            if (!accessOrder || index == last) {
+                return index;
+            }
+
+            FlatHashMapEntry& accessed = this->appendEntry();
+            accessed.swap(this->entries[index]);
+            this->slots[this->entries.back().slot].entry = last + 1;
+            this->unused++;
+            this->modCount++;
+
+            this->compactIfSparse();
+            return (int) this->entries.size() - 1;
+        }
+
+        virtual void releaseEntry(int index) {
+            this->entries[index] = FlatHashMapEntry();
+            this->unused++;
+
+            while (!this->entries.empty() && !this->entries.back().isUsed()) {
+                this->entries.pop_back();
+                this->unused--;
+            }
+
+            if (this->eldest > (int) this->entries.size()) {
+                this->eldest = (int) this->entries.size();
+            }
+        }
+
+    private:
+
+        void checkEldest() {
+            while (!this->entries[eldest].isUsed()) {
+                eldest++;
+            }
+
+            if (this->removeEldestEntry(this->entries[eldest])) {
+                this->onEviction(this->entries[eldest]);
+                this->removeEntryAt(eldest);
+                this->compactIfSparse();
+            }
+        }
+
+        // Closes up the unused positions once they outnumber the mappings, entries are
+        // only ever moved towards the front so their relative order is preserved.
+        void compactIfSparse() const {
+            if (unused <= this->elementCount || unused < 16) {
+                return;
+            }
+
+            int target = 0;
+            for (int i = 0; i < (int) this->entries.size(); ++i) {
+                if (!this->entries[i].isUsed()) {
+                    continue;
+                }
+                if (i != target) {
+                    this->entries[target].swap(this->entries[i]);
+                    this->slots[this->entries[target].slot].entry = target;
+                }
+                target++;
+            }
+
+            this->entries.erase(this->entries.begin() + target, this->entries.end());
+            this->unused = 0;
+            this->eldest = 0;
+        }
+
+    };
+
+}}
+
+#endif /* _DECAF_UTIL_LINKEDFLATHASHMAP_H_ */
@@ -0,0 +1,746 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_COMPLETABLEFUTURE_H_
+#define _DECAF_UTIL_CONCURRENT_COMPLETABLEFUTURE_H_
+
+#include <decaf/util/Config.h>
+
+#include <decaf/lang/Exception.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/Collection.h>
+#include <decaf/util/Iterator.h>
+#include <decaf/util/Timer.h>
+#include <decaf/util/TimerTask.h>
+#include <decaf/util/concurrent/CancellationException.h>
+#include <decaf/util/concurrent/CompletionListener.h>
+#include <decaf/util/concurrent/Continuation.h>
+#include <decaf/util/concurrent/ExecutionException.h>
+#include <decaf/util/concurrent/Executor.h>
+#include <decaf/util/concurrent/Future.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/RejectedExecutionException.h>
+#include <decaf/util/concurrent/TimeoutException.h>
+
+#include <utility>
+#include <vector>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * A Future that is completed explicitly, by whoever produces its result, and that
+     * can have further work attached to it instead of being waited on.
+     *
+     * Listeners and continuations registered on a CompletableFuture run once it completes,
+     * either on the thread that completes it or, when an Executor is supplied, as a task on
+     * that Executor; if the Executor rejects the task it is run on the completing thread
+     * instead.  Each continuation returns a new CompletableFuture for its own result, so a
+     * pipeline of asynchronous operations can be built without any thread blocking in get
+     * while an operation is outstanding.  An error in any stage skips the continuations
+     * after it and completes every later stage exceptionally with that same error.
+     *
+     * Instances are shared through Pointer, the stages of a pipeline hold Pointers to the
+     * stages that follow them.  The result type must be default constructible and
+     * copyable.
+     *
+     * @since 3.10.0
+     */
+    template<typename T>
+    class CompletableFuture : public Future<T> {
+    private:
+
+        template<typename> friend class CompletableFuture;
+
+        enum State {
+            PENDING,
+            SUCCEEDED,
+            FAILED,
+            CANCELLED
+        };
+
+        typedef std::pair<Pointer< CompletionListener<T> >, Executor*> Registration;
+
+        /**
+         * Delivers a copy of the outcome to a listener whose Executor accepted the task,
+         * the future itself may be gone by the time the task runs.
+         */
+        class ListenerTask : public decaf::lang::Runnable {
+        private:
+
+            Pointer< CompletionListener<T> > listener;
+            T value;
+            Pointer<decaf::lang::Exception> error;
+
+        private:
+
+            ListenerTask(const ListenerTask&);
+            ListenerTask& operator= (const ListenerTask&);
+
+        public:
+
+            ListenerTask(const Pointer< CompletionListener<T> >& listener, const T& value,
+                         const Pointer<decaf::lang::Exception>& error) :
+                decaf::lang::Runnable(), listener(listener), value(value), error(error) {
+            }
+
+            virtual ~ListenerTask() {}
+
+            virtual void run() {
+                notifyListener(*this->listener, this->value, this->error.get());
+            }
+        };
+
+        /**
+         * Completes the future returned by then with the continuation's result.
+         */
+        template<typename R>
+        class ApplyListener : public CompletionListener<T> {
+        private:
+
+            Pointer< Continuation<T, R> > continuation;
+            Pointer< CompletableFuture<R> > next;
+
+        private:
+
+            ApplyListener(const ApplyListener&);
+            ApplyListener& operator= (const ApplyListener&);
+
+        public:
+
+            ApplyListener(const Pointer< Continuation<T, R> >& continuation, const Pointer< CompletableFuture<R> >& next) :
+                CompletionListener<T>(), continuation(continuation), next(next) {
+            }
+
+            virtual ~ApplyListener() {}
+
+            virtual void onSuccess(const T& value) {
+                try {
+                    this->next->complete(this->continuation->apply(value));
+                } catch (decaf::lang::Exception& ex) {
+                    this->next->completeExceptionally(ex);
+                } catch (std::exception& stdex) {
+                    this->next->completeExceptionally(decaf::lang::Exception(new std::exception(stdex)));
+                } catch (...) {
+                    this->next->completeExceptionally(decaf::lang::Exception(
+                        __FILE__, __LINE__, "CompletableFuture Caught Unknown exception from a continuation."));
+                }
+            }
+
+            virtual void onFailure(const decaf::lang::Exception& error) {
+                this->next->completeExceptionally(error);
+            }
+        };
+
+        /**
+         * Completes the future returned by thenCompose once the future that the
+         * continuation started has completed.
+         */
+        template<typename R>
+        class ComposeListener : public CompletionListener<T> {
+        private:
+
+            Pointer< Continuation<T, Pointer< CompletableFuture<R> > > > continuation;
+            Pointer< CompletableFuture<R> > next;
+
+        private:
+
+            ComposeListener(const ComposeListener&);
+            ComposeListener& operator= (const ComposeListener&);
+
+        public:
+
+            ComposeListener(const Pointer< Continuation<T, Pointer< CompletableFuture<R> > > >& continuation,
+                            const Pointer< CompletableFuture<R> >& next) :
+                CompletionListener<T>(), continuation(continuation), next(next) {
+            }
+
+            virtual ~ComposeListener() {}
+
+            virtual void onSuccess(const T& value) {
+                try {
+                    Pointer< CompletableFuture<R> > started = this->continuation->apply(value);
+                    if (started == NULL) {
+                        throw decaf::lang::exceptions::NullPointerException(
+                            __FILE__, __LINE__, "Continuation returned a NULL future.");
+                    }
+                    started->onComplete(Pointer< CompletionListener<R> >(
+                        new typename CompletableFuture<R>::RelayListener(this->next)));
+                } catch (decaf::lang::Exception& ex) {
+                    this->next->completeExceptionally(ex);
+                } catch (std::exception& stdex) {
+                    this->next->completeExceptionally(decaf::lang::Exception(new std::exception(stdex)));
+                } catch (...) {
+                    this->next->completeExceptionally(decaf::lang::Exception(
+                        __FILE__, __LINE__, "CompletableFuture Caught Unknown exception from a continuation."));
+                }
+            }
+
+            virtual void onFailure(const decaf::lang::Exception& error) {
+                this->next->completeExceptionally(error);
+            }
+        };
+
+        /**
+         * Passes the outcome on to another future, and cancels a pending timeout when
+         * there is one.
+         */
+        class RelayListener : public CompletionListener<T> {
+        private:
+
+            Pointer< CompletableFuture<T> > next;
+            Pointer<TimerTask> timeout;
+
+        private:
+
+            RelayListener(const RelayListener&);
+            RelayListener& operator= (const RelayListener&);
+
+        public:
+
+            RelayListener(const Pointer< CompletableFuture<T> >& next,
+                          const Pointer<TimerTask>& timeout = Pointer<TimerTask>()) :
+                CompletionListener<T>(), next(next), timeout(timeout) {
+            }
+
+            virtual ~RelayListener() {}
+
+            virtual void onSuccess(const T& value) {
+                if (this->timeout != NULL) {
+                    this->timeout->cancel();
+                }
+                this->next->complete(value);
+            }
+
+            virtual void onFailure(const decaf::lang::Exception& error) {
+                if (this->timeout != NULL) {
+                    this->timeout->cancel();
+                }
+                this->next->completeExceptionally(error);
+            }
+        };
+
+        /**
+         * Fails the future returned by withTimeout when the time runs out first.
+         */
+        class TimeoutTask : public TimerTask {
+        private:
+
+            Pointer< CompletableFuture<T> > next;
+            long long timeout;
+
+        private:
+
+            TimeoutTask(const TimeoutTask&);
+            TimeoutTask& operator= (const TimeoutTask&);
+
+        public:
+
+            TimeoutTask(const Pointer< CompletableFuture<T> >& next, long long timeout) :
+                TimerTask(), next(next), timeout(timeout) {
+            }
+
+            virtual ~TimeoutTask() {}
+
+            virtual void run() {
+                this->next->completeExceptionally(TimeoutException(
+                    __FILE__, __LINE__, "Not completed within %lld milliseconds.", this->timeout));
+            }
+        };
+
+        /**
+         * Collects the results for whenAll, the first failure completes the combined
+         * future and the remaining outcomes are ignored.
+         */
+        class AllState {
+        private:
+
+            AllState(const AllState&);
+            AllState& operator= (const AllState&);
+
+        public:
+
+            Mutex mutex;
+            ArrayList<T> results;
+            int remaining;
+            Pointer< CompletableFuture< ArrayList<T> > > combined;
+
+            AllState(int count, const Pointer< CompletableFuture< ArrayList<T> > >& combined) :
+                mutex(), results(count), remaining(count), combined(combined) {
+                for (int i = 0; i < count; ++i) {
+                    this->results.add(T());
+                }
+            }
+        };
+
+        class AllListener : public CompletionListener<T> {
+        private:
+
+            Pointer<AllState> state;
+            int index;
+
+        private:
+
+            AllListener(const AllListener&);
+            AllListener& operator= (const AllListener&);
+
+        public:
+
+            AllListener(const Pointer<AllState>& state, int index) :
+                CompletionListener<T>(), state(state), index(index) {
+            }
+
+            virtual ~AllListener() {}
+
+            virtual void onSuccess(const T& value) {
+                bool done = false;
+                synchronized(&this->state->mutex) {
+                    this->state->results.set(this->index, value);
+                    done = --this->state->remaining == 0;
+                }
+
+                if (done) {
+                    this->state->combined->complete(this->state->results);
+                }
+            }
+
+            virtual void onFailure(const decaf::lang::Exception& error) {
+                this->state->combined->completeExceptionally(error);
+            }
+        };
+
+    private:
+
+        mutable Mutex mutex;
+        State state;
+        T value;
+        Pointer<decaf::lang::Exception> error;
+        std::vector<Registration> listeners;
+
+    private:
+
+        CompletableFuture(const CompletableFuture&);
+        CompletableFuture& operator= (const CompletableFuture&);
+
+    public:
+
+        /**
+         * Creates a new CompletableFuture that is not yet complete.
+         */
+        CompletableFuture() : Future<T>(), mutex(), state(PENDING), value(), error(), listeners() {
+        }
+
+        virtual ~CompletableFuture() {}
+
+        /**
+         * Creates a new CompletableFuture that is already completed with the given value.
+         *
+         * @param value
+         *      The result of the returned future.
+         *
+         * @return the completed future.
+         */
+        static Pointer< CompletableFuture<T> > completedFuture(const T& value) {
+            Pointer< CompletableFuture<T> > future(new CompletableFuture<T>());
+            future->complete(value);
+            return future;
+        }
+
+        /**
+         * Returns a new CompletableFuture that completes with the results of all the given
+         * futures, in iteration order, once every one of them has completed normally.  If
+         * any of them fails or is cancelled the returned future completes exceptionally with
+         * the first such error.  An empty collection gives an already completed future.
+         *
+         * @param futures
+         *      The futures to combine, none of which may be NULL.
+         *
+         * @return a future for the combined results.
+         *
+         * @throws NullPointerException if one of the futures is NULL.
+         */
+        static Pointer< CompletableFuture< ArrayList<T> > > whenAll(const Collection< Pointer< CompletableFuture<T> > >& futures) {
+
+            Pointer< CompletableFuture< ArrayList<T> > > combined(new CompletableFuture< ArrayList<T> >());
+            if (futures.isEmpty()) {
+                combined->complete(ArrayList<T>());
+                return combined;
+            }
+
+            Pointer<AllState> state(new AllState(futures.size(), combined));
+            std::vector< Pointer< CompletableFuture<T> > > sources;
+            sources.reserve(futures.size());
+
+            Pointer< Iterator< Pointer< CompletableFuture<T> > > > iter(futures.iterator());
+            while (iter->hasNext()) {
+                Pointer< CompletableFuture<T> > future = iter->next();
+                if (future == NULL) {
+                    throw decaf::lang::exceptions::NullPointerException(
+                        __FILE__, __LINE__, "Cannot combine a NULL future.");
+                }
+                sources.push_back(future);
+            }
+
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                sources[i]->onComplete(Pointer< CompletionListener<T> >(new AllListener(state, (int) i)));
+            }
+
+            return combined;
+        }
+
+    public:
+
+        /**
+         * Completes this future with the given value if it is not already complete, and
+         * then runs the listeners registered on it.
+         *
+         * @param result
+         *      The result of this future.
+         *
+         * @return true if this call completed the future, false if it was already complete.
+         */
+        bool complete(const T& result) {
+            std::vector<Registration> completed;
+            synchronized(&this->mutex) {
+                if (this->state != PENDING) {
+                    return false;
+                }
+                this->value = result;
+                this->state = SUCCEEDED;
+                completed.swap(this->listeners);
+                this->mutex.notifyAll();
+            }
+
+            dispatch(completed);
+            return true;
+        }
+
+        /**
+         * Completes this future with the given error if it is not already complete, and
+         * then runs the listeners registered on it.  Calls to get will throw an
+         * ExecutionException whose cause is a copy of the error.
+         *
+         * @param failure
+         *      The error that stopped this future's computation.
+         *
+         * @return true if this call completed the future, false if it was already complete.
+         */
+        bool completeExceptionally(const decaf::lang::Exception& failure) {
+            return fail(failure, FAILED);
+        }
+
+        /**
+         * Completes this future with a CancellationException if it is not already
+         * complete.  Cancelling a future does not cancel the operation that would have
+         * completed it, nor the stages the future itself was derived from.
+         *
+         * @param mayInterruptIfRunning
+         *      Ignored, there is no task running on behalf of this future.
+         *
+         * @return true if this call cancelled the future.
+         */
+        virtual bool cancel(bool mayInterruptIfRunning DECAF_UNUSED) {
+            return fail(CancellationException(__FILE__, __LINE__, "The future was cancelled."), CANCELLED);
+        }
+
+        virtual bool isCancelled() const {
+            synchronized(&this->mutex) {
+                return this->state == CANCELLED;
+            }
+            return false;
+        }
+
+        virtual bool isDone() const {
+            synchronized(&this->mutex) {
+                return this->state != PENDING;
+            }
+            return false;
+        }
+
+        /**
+         * @return true if this future completed with an error, including cancellation.
+         */
+        bool isCompletedExceptionally() const {
+            synchronized(&this->mutex) {
+                return this->state == FAILED || this->state == CANCELLED;
+            }
+            return false;
+        }
+
+        virtual T get() {
+            await();
+            return report();
+        }
+
+        virtual T get(long long timeout, const TimeUnit& unit) {
+            if (!await(timeout, unit)) {
+                throw TimeoutException(__FILE__, __LINE__, "The future did not complete in time.");
+            }
+            return report();
+        }
+
+        /**
+         * Returns the result if this future is complete, otherwise returns the given value.
+         *
+         * @param valueIfAbsent
+         *      The value returned while this future is not yet complete.
+         *
+         * @return the result or valueIfAbsent.
+         *
+         * @throws CancellationException if the future was cancelled.
+         * @throws ExecutionException if the future completed exceptionally.
+         */
+        T getNow(const T& valueIfAbsent) const {
+            synchronized(&this->mutex) {
+                if (this->state == PENDING) {
+                    return valueIfAbsent;
+                }
+            }
+            return report();
+        }
+
+        /**
+         * Waits until this future is complete, without retrieving the result.
+         *
+         * @throws InterruptedException if the current thread was interrupted while waiting.
+         */
+        void await() const {
+            synchronized(&this->mutex) {
+                while (this->state == PENDING) {
+                    this->mutex.wait();
+                }
+            }
+        }
+
+        /**
+         * Waits at most the given time for this future to complete, without retrieving
+         * the result.
+         *
+         * @param timeout
+         *      The maximum time to wait.
+         * @param unit
+         *      The unit of the timeout argument.
+         *
+         * @return true if the future is complete, false if the time ran out first.
+         *
+         * @throws InterruptedException if the current thread was interrupted while waiting.
+         */
+        bool await(long long timeout, const TimeUnit& unit) const {
+            long long remaining = unit.toMillis(timeout);
+            long long deadline = decaf::lang::System::currentTimeMillis() + remaining;
+
+            synchronized(&this->mutex) {
+                while (this->state == PENDING) {
+                    if (remaining <= 0) {
+                        return false;
+                    }
+                    this->mutex.wait(remaining);
+                    remaining = deadline - decaf::lang::System::currentTimeMillis();
+                }
+            }
+            return true;
+        }
+
+    public:
+
+        /**
+         * Registers a listener for the outcome of this future.  If the future is already
+         * complete the listener is notified before this method returns, or handed to the
+         * Executor.
+         *
+         * @param listener
+         *      The listener to notify.
+         * @param executor
+         *      The Executor to notify the listener from, or NULL to notify it from the
+         *      thread that completes this future.
+         *
+         * @throws NullPointerException if the listener is NULL.
+         */
+        void onComplete(const Pointer< CompletionListener<T> >& listener, Executor* executor = NULL) {
+
+            if (listener == NULL) {
+                throw decaf::lang::exceptions::NullPointerException(
+                    __FILE__, __LINE__, "Cannot register a NULL listener.");
+            }
+
+            std::vector<Registration> completed;
+            synchronized(&this->mutex) {
+                if (this->state == PENDING) {
+                    this->listeners.push_back(Registration(listener, executor));
+                    return;
+                }
+                completed.push_back(Registration(listener, executor));
+            }
+
+            dispatch(completed);
+        }
+
+        /**
+         * Returns a new future for the result of applying the continuation to the result
+         * of this one.  If this future fails, or the continuation throws, the returned
+         * future fails with the same error.
+         *
+         * @param continuation
+         *      The stage to run once this future completes normally.
+         * @param executor
+         *      The Executor to run the continuation on, or NULL to run it on the thread
+         *      that completes this future.
+         *
+         * @return a future for the continuation's result.
+         *
+         * @throws NullPointerException if the continuation is NULL.
+         */
+        template<typename R>
+        Pointer< CompletableFuture<R> > then(const Pointer< Continuation<T, R> >& continuation, Executor* executor = NULL) {
+
+            if (continuation == NULL) {
+                throw decaf::lang::exceptions::NullPointerException(
+                    __FILE__, __LINE__, "Cannot apply a NULL continuation.");
+            }
+
+            Pointer< CompletableFuture<R> > next(new CompletableFuture<R>());
+            this->onComplete(Pointer< CompletionListener<T> >(new ApplyListener<R>(continuation, next)), executor);
+            return next;
+        }
+
+        /**
+         * Returns a new future that completes with the future the continuation starts from
+         * the result of this one, the way to chain a further asynchronous operation without
+         * nesting futures.
+         *
+         * @param continuation
+         *      The stage to run once this future completes normally, it must not return NULL.
+         * @param executor
+         *      The Executor to run the continuation on, or NULL to run it on the thread
+         *      that completes this future.
+         *
+         * @return a future for the result of the started operation.
+         *
+         * @throws NullPointerException if the continuation is NULL.
+         */
+        template<typename R>
+        Pointer< CompletableFuture<R> > thenCompose(const Pointer< Continuation<T, Pointer< CompletableFuture<R> > > >& continuation,
+                                                    Executor* executor = NULL) {
+
+            if (continuation == NULL) {
+                throw decaf::lang::exceptions::NullPointerException(
+                    __FILE__, __LINE__, "Cannot apply a NULL continuation.");
+            }
+
+            Pointer< CompletableFuture<R> > next(new CompletableFuture<R>());
+            this->onComplete(Pointer< CompletionListener<T> >(new ComposeListener<R>(continuation, next)), executor);
+            return next;
+        }
+
+        /**
+         * Returns a new future that completes the way this one does, or fails with a
+         * TimeoutException if this one has not completed within the given time.  This
+         * future itself is left as it is.
+         *
+         * @param timeout
+         *      The time allowed for this future to complete.
+         * @param unit
+         *      The unit of the timeout argument.
+         * @param timer
+         *      The Timer that runs the timeout.
+         *
+         * @return a future bounded by the timeout.
+         *
+         * @throws NullPointerException if the timer is NULL.
+         * @throws IllegalStateException if the timer has been cancelled.
+         */
+        Pointer< CompletableFuture<T> > withTimeout(long long timeout, const TimeUnit& unit, Timer* timer) {
+
+            if (timer == NULL) {
+                throw decaf::lang::exceptions::NullPointerException(
+                    __FILE__, __LINE__, "Must provide a Timer to run the timeout.");
+            }
+
+            long long millis = unit.toMillis(timeout);
+            Pointer< CompletableFuture<T> > next(new CompletableFuture<T>());
+            Pointer<TimerTask> task(new TimeoutTask(next, millis));
+
+            timer->schedule(task, millis < 0 ? 0 : millis);
+            this->onComplete(Pointer< CompletionListener<T> >(new RelayListener(next, task)));
+            return next;
+        }
+
+    private:
+
+        bool fail(const decaf::lang::Exception& failure, State outcome) {
+            std::vector<Registration> completed;
+            synchronized(&this->mutex) {
+                if (this->state != PENDING) {
+                    return false;
+                }
+                this->error.reset(failure.clone());
+                this->state = outcome;
+                completed.swap(this->listeners);
+                this->mutex.notifyAll();
+            }
+
+            dispatch(completed);
+            return true;
+        }
+
+        T report() const {
+            if (this->state == CANCELLED) {
+                throw CancellationException(__FILE__, __LINE__, "The future was cancelled.");
+            } else if (this->state == FAILED) {
+                throw ExecutionException(this->error->clone());
+            }
+            return this->value;
+        }
+
+        static void notifyListener(CompletionListener<T>& listener, const T& value, const decaf::lang::Exception* error) {
+            try {
+                if (error == NULL) {
+                    listener.onSuccess(value);
+                } else {
+                    listener.onFailure(*error);
+                }
+            } catch (...) {
+            }
+        }
+
+        // Only called once the state is final, the value and error no longer change.
+        void dispatch(const std::vector<Registration>& completed) {
+            for (std::size_t i = 0; i < completed.size(); ++i) {
+                Executor* executor = completed[i].second;
+                if (executor != NULL) {
+                    try {
+                        executor->execute(new ListenerTask(completed[i].first, this->value, this->error));
+                        continue;
+                    } catch (RejectedExecutionException& ex) {
+                    }
+                }
+                notifyListener(*completed[i].first, this->value, this->error.get());
+            }
+        }
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_COMPLETABLEFUTURE_H_ */
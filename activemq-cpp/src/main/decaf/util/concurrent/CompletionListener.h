@@ -0,0 +1,62 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_COMPLETIONLISTENER_H_
+#define _DECAF_UTIL_CONCURRENT_COMPLETIONLISTENER_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/lang/Exception.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    /**
+     * Receives the outcome of a CompletableFuture.  Exactly one of the two methods is
+     * called, once, after the future completes.  Any exception thrown from either
+     * method is caught and ignored by the caller.
+     *
+     * @since 3.10.0
+     */
+    template<typename T>
+    class CompletionListener {
+    public:
+
+        virtual ~CompletionListener() {}
+
+        /**
+         * Called when the future completed normally.
+         *
+         * @param value
+         *      The result the future completed with.
+         */
+        virtual void onSuccess(const T& value) = 0;
+
+        /**
+         * Called when the future completed exceptionally or was cancelled, in the
+         * latter case the error is a CancellationException.
+         *
+         * @param error
+         *      The error the future completed with.
+         */
+        virtual void onFailure(const decaf::lang::Exception& error) = 0;
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_COMPLETIONLISTENER_H_ */
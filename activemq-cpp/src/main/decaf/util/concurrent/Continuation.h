@@ -0,0 +1,57 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_CONTINUATION_H_
+#define _DECAF_UTIL_CONCURRENT_CONTINUATION_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/lang/Exception.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    /**
+     * A step of an asynchronous pipeline, applied to the result of one CompletableFuture
+     * to produce the result of the next.  An exception thrown from apply completes the
+     * next future exceptionally with that exception.
+     *
+     * @since 3.10.0
+     */
+    template<typename T, typename R>
+    class Continuation {
+    public:
+
+        virtual ~Continuation() {}
+
+        /**
+         * Computes the next result from the result of the previous stage.
+         *
+         * @param value
+         *      The result of the previous stage.
+         *
+         * @return the result of this stage.
+         *
+         * @throws Exception if unable to compute a result.
+         */
+        virtual R apply(const T& value) = 0;
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_CONTINUATION_H_ */
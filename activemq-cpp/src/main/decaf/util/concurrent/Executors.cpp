@@ -23,6 +23,7 @@
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
 #include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/WorkStealingExecutor.h>
 #include <decaf/util/concurrent/ThreadFactory.h>
 #include <decaf/util/concurrent/TimeUnit.h>
 #include <decaf/util/concurrent/LinkedBlockingQueue.h>
@@ -144,10 +145,12 @@ Executors::~Executors() {
 ////////////////////////////////////////////////////////////////////////////////
 void Executors::initialize() {
     DefaultThreadFactory::poolNumber = new AtomicInteger(1);
+    WorkStealingExecutor::initializeWorkerLocals();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Executors::shutdown() {
+    WorkStealingExecutor::destroyWorkerLocals();
     delete DefaultThreadFactory::poolNumber;
 }
 
@@ -276,6 +279,35 @@ ExecutorService* Executors::newSingleThreadExecutor(ThreadFactory* threadFactory
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ExecutorService* Executors::newWorkStealingPool() {
+
+    try{
+        return new WorkStealingExecutor();
+    } catch(Exception& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(...) {
+        throw Exception();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ExecutorService* Executors::newWorkStealingPool(int parallelism) {
+
+    try{
+        return new WorkStealingExecutor(parallelism);
+    } catch(IllegalArgumentException& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(Exception& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(...) {
+        throw Exception();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ExecutorService* Executors::unconfigurableExecutorService(ExecutorService* executor) {
 
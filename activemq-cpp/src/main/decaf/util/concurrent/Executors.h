@@ -172,6 +172,31 @@ namespace concurrent {
          */
         static ExecutorService* newSingleThreadExecutor(ThreadFactory* threadFactory);
 
+        /**
+         * Creates a new WorkStealingExecutor with one worker thread per available processor.
+         * Each worker keeps its own queue of tasks and takes work from the others when it
+         * runs out, which suits many short tasks submitted from several threads.  The pool
+         * makes no guarantee about the order in which tasks are run.
+         *
+         * @return pointer to a new ExecutorService that is owned by the caller.
+         */
+        static ExecutorService* newWorkStealingPool();
+
+        /**
+         * Creates a new WorkStealingExecutor with the given number of worker threads.  Each
+         * worker keeps its own queue of tasks and takes work from the others when it runs
+         * out, which suits many short tasks submitted from several threads.  The pool makes
+         * no guarantee about the order in which tasks are run.
+         *
+         * @param parallelism
+         *      The number of worker threads in the new ExecutorService.
+         *
+         * @return pointer to a new ExecutorService that is owned by the caller.
+         *
+         * @throws IllegalArgumentException if parallelism is less than or equal to zero.
+         */
+        static ExecutorService* newWorkStealingPool(int parallelism);
+
         /**
          * Returns a new ExecutorService derived instance that wraps and takes ownership of the given
          * ExecutorService pointer.  The returned ExecutorService delegates all calls to the wrapped
@@ -0,0 +1,708 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkStealingExecutor.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/ThreadLocal.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/InterruptedException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/concurrent/Executors.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <deque>
+#include <vector>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    /**
+     * A queued task along with whether the pool deletes it once it has run.
+     */
+    struct WorkItem {
+
+        Runnable* task;
+        bool owned;
+
+        WorkItem() : task(NULL), owned(false) {}
+        WorkItem(Runnable* task, bool owned) : task(task), owned(owned) {}
+    };
+
+    /**
+     * Hands back tasks that the pool does not own from shutdownNow so that the
+     * caller can delete everything in the returned list.
+     */
+    class UnownedWorkWrapper : public Runnable {
+    private:
+
+        Runnable* task;
+
+    private:
+
+        UnownedWorkWrapper(const UnownedWorkWrapper&);
+        UnownedWorkWrapper& operator=(const UnownedWorkWrapper&);
+
+    public:
+
+        UnownedWorkWrapper(Runnable* task) : Runnable(), task(task) {}
+
+        virtual ~UnownedWorkWrapper() {}
+
+        virtual void run() {
+            this->task->run();
+        }
+    };
+
+    /**
+     * Double ended task queue, the owning worker pushes and pops at the back while
+     * every other taker removes from the front.  The size is published outside the
+     * lock so that idle workers can skip empty queues without locking them.
+     */
+    class WorkQueue {
+    private:
+
+        Mutex lock;
+        std::deque<WorkItem> items;
+        volatile int count;
+
+    private:
+
+        WorkQueue(const WorkQueue&);
+        WorkQueue& operator=(const WorkQueue&);
+
+    public:
+
+        WorkQueue() : lock(), items(), count(0) {}
+
+        int size() const {
+            return this->count;
+        }
+
+        void push(const WorkItem& item) {
+            synchronized(&lock) {
+                this->items.push_back(item);
+                this->count = (int) this->items.size();
+            }
+        }
+
+        bool pop(WorkItem& item) {
+            if (this->count == 0) {
+                return false;
+            }
+
+            synchronized(&lock) {
+                if (this->items.empty()) {
+                    return false;
+                }
+                item = this->items.back();
+                this->items.pop_back();
+                this->count = (int) this->items.size();
+            }
+
+            return true;
+        }
+
+        bool poll(WorkItem& item) {
+            if (this->count == 0) {
+                return false;
+            }
+
+            synchronized(&lock) {
+                if (this->items.empty()) {
+                    return false;
+                }
+                item = this->items.front();
+                this->items.pop_front();
+                this->count = (int) this->items.size();
+            }
+
+            return true;
+        }
+
+        // A thief moves on to the next queue rather than wait for a busy one.
+        bool trySteal(WorkItem& item) {
+            if (this->count == 0 || !this->lock.tryLock()) {
+                return false;
+            }
+
+            bool result = false;
+            if (!this->items.empty()) {
+                item = this->items.front();
+                this->items.pop_front();
+                this->count = (int) this->items.size();
+                result = true;
+            }
+
+            this->lock.unlock();
+            return result;
+        }
+
+        void drainTo(std::vector<WorkItem>& target) {
+            synchronized(&lock) {
+                target.insert(target.end(), this->items.begin(), this->items.end());
+                this->items.clear();
+                this->count = 0;
+            }
+        }
+    };
+
+    class WorkStealingWorker : public Runnable {
+    private:
+
+        WorkStealingWorker(const WorkStealingWorker&);
+        WorkStealingWorker& operator=(const WorkStealingWorker&);
+
+    public:
+
+        WorkStealingKernel* kernel;
+        int index;
+
+        // Tasks submitted by this worker's own thread.
+        WorkQueue local;
+
+        // Tasks submitted from threads outside the pool.
+        WorkQueue inbound;
+
+        Pointer<Thread> thread;
+
+        // Only ever written by the worker thread.
+        volatile long long steals;
+
+    public:
+
+        WorkStealingWorker(WorkStealingKernel* kernel, int index) :
+            Runnable(), kernel(kernel), index(index), local(), inbound(), thread(), steals(0) {
+        }
+
+        virtual ~WorkStealingWorker() {}
+
+        virtual void run();
+    };
+
+    /**
+     * The pool state, runState moves forward only:
+     *
+     *   RUNNING:    accepts new tasks and runs queued tasks.
+     *   SHUTDOWN:   accepts new tasks only from its own workers, runs queued tasks.
+     *   STOP:       accepts no tasks and runs no more queued tasks.
+     *   TERMINATED: every worker thread has finished.
+     *
+     * Every accepted task is counted in pending until it has run, workers leave a
+     * SHUTDOWN pool once that count reaches zero since only a running task could
+     * still add more work.  Idle workers wait on idleLock after a final check of
+     * the queues made with idleWorkers already raised, a submitter raises the count
+     * of queued tasks before it reads idleWorkers, so either the idle worker sees
+     * the new task or the submitter sees the worker and wakes it.
+     */
+    class WorkStealingKernel {
+    public:
+
+        static const int RUNNING = 0;
+        static const int SHUTDOWN = 1;
+        static const int STOP = 2;
+        static const int TERMINATED = 3;
+
+        // Times an idle worker yields and rescans before it blocks.
+        static const int IDLE_SPINS = 16;
+
+        // Idle workers allowed to spin at once, the rest block straight away so that a
+        // large pool does not hand its time slices around between spinning threads.
+        static const int MAX_SPINNING = 2;
+
+        static ThreadLocal<WorkStealingWorker*>* currentWorker;
+
+    public:
+
+        WorkStealingExecutor* parent;
+        Pointer<ThreadFactory> factory;
+        std::vector<WorkStealingWorker*> workers;
+
+        AtomicInteger runState;
+        AtomicInteger pending;
+        AtomicInteger idleWorkers;
+        AtomicInteger spinningWorkers;
+        AtomicInteger liveWorkers;
+        AtomicInteger nextQueue;
+
+        Mutex idleLock;
+        Mutex terminationLock;
+
+    private:
+
+        WorkStealingKernel(const WorkStealingKernel&);
+        WorkStealingKernel& operator=(const WorkStealingKernel&);
+
+    public:
+
+        WorkStealingKernel(WorkStealingExecutor* parent, int parallelism, ThreadFactory* threadFactory) :
+            parent(parent), factory(), workers(), runState(RUNNING), pending(0), idleWorkers(0),
+            spinningWorkers(0), liveWorkers(0), nextQueue(0), idleLock(), terminationLock() {
+
+            if (threadFactory == NULL) {
+                throw NullPointerException(__FILE__, __LINE__, "Must provide a valid ThreadFactory instance.");
+            }
+
+            // Owned from here on, even if the checks below fail.
+            this->factory.reset(threadFactory);
+
+            if (parallelism <= 0) {
+                throw IllegalArgumentException(__FILE__, __LINE__, "Parallelism must be greater than zero.");
+            }
+
+            try {
+                for (int i = 0; i < parallelism; ++i) {
+                    WorkStealingWorker* worker = new WorkStealingWorker(this, i);
+                    this->workers.push_back(worker);
+                    worker->thread.reset(this->factory->newThread(worker));
+                    if (worker->thread == NULL) {
+                        throw NullPointerException(__FILE__, __LINE__, "ThreadFactory returned a NULL Thread.");
+                    }
+                }
+            } catch (Exception& ex) {
+                destroyWorkers();
+                throw;
+            }
+
+            this->liveWorkers.set(parallelism);
+            for (int i = 0; i < parallelism; ++i) {
+                this->workers[i]->thread->start();
+            }
+        }
+
+        ~WorkStealingKernel() {
+            try {
+                shutdown();
+                while (!awaitTermination(Integer::MAX_VALUE)) {}
+
+                for (std::size_t i = 0; i < this->workers.size(); ++i) {
+                    this->workers[i]->thread->join();
+                }
+
+                // Anything submitted after shutdownNow drained the queues never ran.
+                std::vector<WorkItem> remaining;
+                drainQueues(remaining);
+                for (std::size_t i = 0; i < remaining.size(); ++i) {
+                    if (remaining[i].owned) {
+                        delete remaining[i].task;
+                    }
+                }
+
+                destroyWorkers();
+            }
+            DECAF_CATCH_NOTHROW(Exception)
+            DECAF_CATCHALL_NOTHROW()
+        }
+
+        void execute(Runnable* task, bool takeOwnership) {
+
+            // Counted before the state is read so a shutdown cannot retire the
+            // workers between the check and the push below.
+            this->pending.incrementAndGet();
+
+            WorkStealingWorker* worker = currentWorker->get();
+            if (worker != NULL && worker->kernel != this) {
+                worker = NULL;
+            }
+
+            int state = this->runState.get();
+            if (state != RUNNING && !(state == SHUTDOWN && worker != NULL)) {
+                taskDone();
+                if (takeOwnership) {
+                    delete task;
+                }
+                throw RejectedExecutionException(__FILE__, __LINE__, "Unable to execute task.");
+            }
+
+            WorkItem item(task, takeOwnership);
+            if (worker != NULL) {
+                worker->local.push(item);
+            } else {
+                unsigned int next = (unsigned int) this->nextQueue.getAndIncrement();
+                this->workers[next % this->workers.size()]->inbound.push(item);
+            }
+
+            if (this->idleWorkers.get() > 0) {
+                synchronized(&idleLock) {
+                    idleLock.notify();
+                }
+            }
+        }
+
+        void runWorker(WorkStealingWorker* worker) {
+
+            currentWorker->set(worker);
+
+            try {
+                WorkItem item;
+                while (this->runState.get() < STOP) {
+                    if (findTask(worker, item)) {
+                        runTask(item);
+                    } else if (!awaitWork()) {
+                        break;
+                    }
+                }
+            }
+            DECAF_CATCHALL_NOTHROW()
+
+            currentWorker->remove();
+
+            if (this->liveWorkers.decrementAndGet() == 0) {
+                synchronized(&terminationLock) {
+                    advanceRunState(TERMINATED);
+                    terminationLock.notifyAll();
+                }
+            }
+        }
+
+        void shutdown() {
+            advanceRunState(SHUTDOWN);
+            synchronized(&idleLock) {
+                idleLock.notifyAll();
+            }
+        }
+
+        void shutdownNow(ArrayList<Runnable*>& unexecutedTasks) {
+            advanceRunState(STOP);
+
+            std::vector<WorkItem> remaining;
+            drainQueues(remaining);
+            for (std::size_t i = 0; i < remaining.size(); ++i) {
+                if (remaining[i].owned) {
+                    unexecutedTasks.add(remaining[i].task);
+                } else {
+                    unexecutedTasks.add(new UnownedWorkWrapper(remaining[i].task));
+                }
+                this->pending.decrementAndGet();
+            }
+
+            for (std::size_t i = 0; i < this->workers.size(); ++i) {
+                this->workers[i]->thread->interrupt();
+            }
+
+            synchronized(&idleLock) {
+                idleLock.notifyAll();
+            }
+        }
+
+        bool awaitTermination(long long millis) {
+            long long deadline = System::currentTimeMillis() + millis;
+            synchronized(&terminationLock) {
+                while (this->runState.get() != TERMINATED) {
+                    long long remaining = deadline - System::currentTimeMillis();
+                    if (remaining <= 0) {
+                        return false;
+                    }
+                    terminationLock.wait(remaining);
+                }
+            }
+
+            return true;
+        }
+
+        long long getQueuedTaskCount() const {
+            long long count = 0;
+            for (std::size_t i = 0; i < this->workers.size(); ++i) {
+                count += this->workers[i]->local.size() + this->workers[i]->inbound.size();
+            }
+            return count;
+        }
+
+        long long getStealCount() const {
+            long long count = 0;
+            for (std::size_t i = 0; i < this->workers.size(); ++i) {
+                count += this->workers[i]->steals;
+            }
+            return count;
+        }
+
+    private:
+
+        bool findTask(WorkStealingWorker* worker, WorkItem& item) {
+
+            if (worker->local.pop(item) || worker->inbound.poll(item)) {
+                return true;
+            }
+
+            int count = (int) this->workers.size();
+            for (int i = 1; i < count; ++i) {
+                WorkStealingWorker* victim = this->workers[(worker->index + i) % count];
+                if (victim->local.trySteal(item) || victim->inbound.trySteal(item)) {
+                    worker->steals++;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void runTask(WorkItem& item) {
+            try {
+                item.task->run();
+            }
+            DECAF_CATCHALL_NOTHROW()
+
+            if (item.owned) {
+                try {
+                    delete item.task;
+                }
+                DECAF_CATCHALL_NOTHROW()
+            }
+
+            taskDone();
+        }
+
+        void taskDone() {
+            if (this->pending.decrementAndGet() == 0 && this->runState.get() >= SHUTDOWN) {
+                synchronized(&idleLock) {
+                    idleLock.notifyAll();
+                }
+            }
+        }
+
+        // Returns false once the worker should exit.
+        bool awaitWork() {
+
+            if (this->spinningWorkers.incrementAndGet() <= MAX_SPINNING) {
+                for (int spin = 0; spin < IDLE_SPINS; ++spin) {
+                    if (getQueuedTaskCount() > 0) {
+                        this->spinningWorkers.decrementAndGet();
+                        return true;
+                    }
+                    Thread::yield();
+                }
+            }
+            this->spinningWorkers.decrementAndGet();
+
+            synchronized(&idleLock) {
+                int state = this->runState.get();
+                if (state >= STOP || (state == SHUTDOWN && this->pending.get() == 0)) {
+                    return false;
+                }
+
+                this->idleWorkers.incrementAndGet();
+                if (getQueuedTaskCount() == 0) {
+                    try {
+                        idleLock.wait();
+                    } catch (InterruptedException& ex) {
+                    }
+                }
+                this->idleWorkers.decrementAndGet();
+            }
+
+            return true;
+        }
+
+        void advanceRunState(int target) {
+            for (;;) {
+                int state = this->runState.get();
+                if (state >= target || this->runState.compareAndSet(state, target)) {
+                    return;
+                }
+            }
+        }
+
+        void drainQueues(std::vector<WorkItem>& target) {
+            for (std::size_t i = 0; i < this->workers.size(); ++i) {
+                this->workers[i]->local.drainTo(target);
+                this->workers[i]->inbound.drainTo(target);
+            }
+        }
+
+        void destroyWorkers() {
+            for (std::size_t i = 0; i < this->workers.size(); ++i) {
+                delete this->workers[i];
+            }
+            this->workers.clear();
+        }
+    };
+
+    ThreadLocal<WorkStealingWorker*>* WorkStealingKernel::currentWorker = NULL;
+
+    ////////////////////////////////////////////////////////////////////////////
+    void WorkStealingWorker::run() {
+        this->kernel->runWorker(this);
+    }
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutor::WorkStealingExecutor() : AbstractExecutorService(), kernel(NULL) {
+
+    try {
+        this->kernel = new WorkStealingKernel(
+            this, System::availableProcessors(), Executors::getDefaultThreadFactory());
+    }
+    DECAF_CATCH_RETHROW(IllegalArgumentException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutor::WorkStealingExecutor(int parallelism) : AbstractExecutorService(), kernel(NULL) {
+
+    try {
+        this->kernel = new WorkStealingKernel(this, parallelism, Executors::getDefaultThreadFactory());
+    }
+    DECAF_CATCH_RETHROW(IllegalArgumentException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutor::WorkStealingExecutor(int parallelism, ThreadFactory* threadFactory) :
+    AbstractExecutorService(), kernel(NULL) {
+
+    try {
+        this->kernel = new WorkStealingKernel(this, parallelism, threadFactory);
+    }
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IllegalArgumentException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutor::~WorkStealingExecutor() {
+
+    try {
+        delete kernel;
+    }
+    DECAF_CATCH_NOTHROW(Exception)
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutor::execute(Runnable* task) {
+
+    try {
+
+        if (task == NULL) {
+            throw NullPointerException(
+                __FILE__, __LINE__,
+                "WorkStealingExecutor::execute - Supplied Runnable pointer was NULL.");
+        }
+
+        this->kernel->execute(task, true);
+    }
+    DECAF_CATCH_RETHROW(RejectedExecutionException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutor::execute(Runnable* task, bool takeOwnership) {
+
+    try {
+
+        if (task == NULL) {
+            throw NullPointerException(
+                __FILE__, __LINE__,
+                "WorkStealingExecutor::execute - Supplied Runnable pointer was NULL.");
+        }
+
+        this->kernel->execute(task, takeOwnership);
+    }
+    DECAF_CATCH_RETHROW(RejectedExecutionException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutor::shutdown() {
+
+    try {
+        this->kernel->shutdown();
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ArrayList<Runnable*> WorkStealingExecutor::shutdownNow() {
+
+    ArrayList<Runnable*> result;
+
+    try {
+        this->kernel->shutdownNow(result);
+        return result;
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingExecutor::awaitTermination(long long timeout, const TimeUnit& unit) {
+
+    try {
+        return this->kernel->awaitTermination(unit.toMillis(timeout));
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingExecutor::isShutdown() const {
+    return this->kernel->runState.get() >= WorkStealingKernel::SHUTDOWN;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingExecutor::isTerminated() const {
+    return this->kernel->runState.get() == WorkStealingKernel::TERMINATED;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int WorkStealingExecutor::getParallelism() const {
+    return (int) this->kernel->workers.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long WorkStealingExecutor::getQueuedTaskCount() const {
+    return this->kernel->getQueuedTaskCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long WorkStealingExecutor::getStealCount() const {
+    return this->kernel->getStealCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutor::initializeWorkerLocals() {
+    WorkStealingKernel::currentWorker = new ThreadLocal<WorkStealingWorker*>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutor::destroyWorkerLocals() {
+    delete WorkStealingKernel::currentWorker;
+    WorkStealingKernel::currentWorker = NULL;
+}
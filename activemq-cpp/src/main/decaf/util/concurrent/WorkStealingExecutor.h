@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTOR_H_
+#define _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTOR_H_
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/concurrent/ThreadFactory.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/AbstractExecutorService.h>
+#include <decaf/util/concurrent/RejectedExecutionException.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/Config.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    class WorkStealingKernel;
+
+    /**
+     * An ExecutorService built on the fork/join style of scheduling: a fixed set of
+     * worker threads each own a double ended queue of tasks instead of all of them
+     * taking turns on a single shared queue.
+     *
+     * A task submitted from one of the pool's own worker threads goes onto that
+     * worker's queue and the worker takes its most recently pushed task first, which
+     * keeps a burst of small related tasks on one thread and hot in its cache.  Tasks
+     * submitted from any other thread are spread over the workers in turn and are
+     * taken oldest first.  A worker that runs out of tasks steals the oldest task
+     * from another worker before it goes idle, so no single lock is taken by every
+     * submit and every take and the pool scales with short tasks in a way that a
+     * ThreadPoolExecutor with one work queue does not.
+     *
+     * Tasks from other threads are only started in submission order per worker, the
+     * pool gives no ordering guarantee across tasks; callers that need ordering must
+     * chain the work themselves.  An exception escaping a task is discarded and the
+     * worker carries on with its next task.
+     *
+     * Once shutdown is called no new tasks are accepted from outside the pool, the
+     * tasks already queued and any tasks those go on to submit from the worker threads
+     * are still run.  The worker threads are all created by the constructor and live
+     * until the pool terminates.
+     *
+     * @since 3.10.0
+     */
+    class DECAF_API WorkStealingExecutor : public AbstractExecutorService {
+    private:
+
+        WorkStealingExecutor(const WorkStealingExecutor&);
+        WorkStealingExecutor& operator= (const WorkStealingExecutor&);
+
+    private:
+
+        friend class WorkStealingKernel;
+        WorkStealingKernel* kernel;
+
+    public:
+
+        /**
+         * Creates a new WorkStealingExecutor with one worker per available processor
+         * whose threads are created by the default ThreadFactory.
+         */
+        WorkStealingExecutor();
+
+        /**
+         * Creates a new WorkStealingExecutor with the given number of workers whose
+         * threads are created by the default ThreadFactory.
+         *
+         * @param parallelism
+         *      The number of worker threads in the pool.
+         *
+         * @throws IllegalArgumentException if parallelism is less than or equal to zero.
+         */
+        WorkStealingExecutor(int parallelism);
+
+        /**
+         * Creates a new WorkStealingExecutor with the given number of workers.
+         *
+         * @param parallelism
+         *      The number of worker threads in the pool.
+         * @param threadFactory
+         *      A ThreadFactory implementation that will be used to create worker threads
+         *      that are used by this executor to run the submitted tasks.  The Executor takes
+         *      ownership of the ThreadFactory instance passed, even if this constructor throws.
+         *
+         * @throws IllegalArgumentException if parallelism is less than or equal to zero.
+         * @throws NullPointerException if the threadFactory pointer is NULL.
+         */
+        WorkStealingExecutor(int parallelism, ThreadFactory* threadFactory);
+
+        virtual ~WorkStealingExecutor();
+
+    public:
+
+        virtual void execute(decaf::lang::Runnable* task);
+
+        virtual void execute(decaf::lang::Runnable* task, bool takeOwnership);
+
+        virtual void shutdown();
+
+        virtual ArrayList<decaf::lang::Runnable*> shutdownNow();
+
+        virtual bool awaitTermination(long long timeout, const decaf::util::concurrent::TimeUnit& unit);
+
+        virtual bool isShutdown() const;
+
+        virtual bool isTerminated() const;
+
+        /**
+         * Returns the number of worker threads this pool was created with.
+         *
+         * @return the configured number of worker threads.
+         */
+        int getParallelism() const;
+
+        /**
+         * Returns an approximation of the number of tasks currently waiting in the
+         * worker queues, tasks that are running are not counted.
+         *
+         * @return the number of queued tasks, approximate.
+         */
+        long long getQueuedTaskCount() const;
+
+        /**
+         * Returns an approximation of the total number of tasks that were taken from
+         * the queue of one worker and run by another.
+         *
+         * @return the number of tasks stolen so far, approximate.
+         */
+        long long getStealCount() const;
+
+    private:
+
+        static void initializeWorkerLocals();
+        static void destroyWorkerLocals();
+
+        friend class Executors;
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTOR_H_ */
@@ -0,0 +1,419 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncHandler.h"
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/internal/util/concurrent/Atomics.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/logging/ErrorManager.h>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal::util::concurrent;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+const int AsyncHandler::DEFAULT_CAPACITY = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // How long the writer parks on an empty ring before checking it again, bounds
+    // the delay caused by a wakeup that raced with the writer going to sleep.
+    const long long WRITER_PARK_TIME = 100;
+
+    // How long a BLOCK publisher or flush waits before rechecking the ring.
+    const long long DRAIN_WAIT_TIME = 10;
+
+    // Number of times a BLOCK publisher yields before waiting on the writer.
+    const int BLOCKED_SPIN_COUNT = 16;
+
+    // Signed distance from b to a, correct across wrap of the positions.
+    inline int distance(int a, int b) {
+        return (int)((unsigned int)a - (unsigned int)b);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace util {
+namespace logging {
+
+    struct AsyncHandler::Slot {
+
+        // Equals the position a publisher may claim this slot for, one past it once
+        // the record has been stored and one ring cycle past it once drained.
+        volatile int sequence;
+
+        LogRecord record;
+
+        Slot() : sequence(0), record() {}
+
+    private:
+
+        Slot(const Slot&);
+        Slot& operator=(const Slot&);
+
+    };
+
+    class AsyncHandlerWriter : public Runnable {
+    private:
+
+        AsyncHandler* parent;
+
+    private:
+
+        AsyncHandlerWriter(const AsyncHandlerWriter&);
+        AsyncHandlerWriter& operator=(const AsyncHandlerWriter&);
+
+    public:
+
+        AsyncHandlerWriter(AsyncHandler* parent) : Runnable(), parent(parent) {}
+
+        virtual ~AsyncHandlerWriter() {}
+
+        virtual void run() {
+            this->parent->runWriter();
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandler::AsyncHandler(Handler* target, int capacity, OverflowPolicy policy) :
+    Handler(), target(target), policy(policy), capacity(1), mask(0), slots(NULL),
+    enqueuePosition(0), dequeuePosition(0), droppedCount(0), writerParked(0),
+    drainWaiters(0), activePublishers(0), closed(0), writerMonitor(), drainMonitor(), targetLock(),
+    writerTask(NULL), writer(NULL) {
+
+    if (target == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Target Handler cannot be NULL.");
+    }
+
+    if (capacity < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Capacity must be at least one: %d", capacity);
+    }
+
+    while (this->capacity < capacity) {
+        this->capacity <<= 1;
+    }
+
+    this->mask = this->capacity - 1;
+    this->slots = new Slot[this->capacity];
+    for (int i = 0; i < this->capacity; ++i) {
+        this->slots[i].sequence = i;
+    }
+
+    this->writerTask = new AsyncHandlerWriter(this);
+    this->writer = new Thread(this->writerTask, "AsyncHandler Writer");
+    this->writer->start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandler::~AsyncHandler() {
+
+    try {
+        this->close();
+    }
+    DECAF_CATCH_NOTHROW(Exception)
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->writer;
+        delete this->writerTask;
+        delete [] this->slots;
+    }
+    DECAF_CATCH_NOTHROW(Exception)
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::close() {
+
+    if (Atomics::getAndSet(&this->closed, 1) != 0) {
+        return;
+    }
+
+    // The writer drains whatever is left in the ring before it exits.
+    wakeWriter();
+    signalDrainWaiters();
+    this->writer->join();
+
+    synchronized(&this->targetLock) {
+        try {
+            this->target->flush();
+            this->target->close();
+        } catch (Exception& e) {
+            this->reportError("Failed to close the target Handler", &e, ErrorManager::CLOSE_FAILURE);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::flush() {
+
+    const int position = this->enqueuePosition;
+
+    if (distance(this->dequeuePosition, position) < 0) {
+
+        Atomics::incrementAndGet(&this->drainWaiters);
+        wakeWriter();
+
+        synchronized(&this->drainMonitor) {
+            while (distance(this->dequeuePosition, position) < 0 && this->writer->isAlive()) {
+                this->drainMonitor.wait(DRAIN_WAIT_TIME);
+            }
+        }
+
+        Atomics::decrementAndGet(&this->drainWaiters);
+    }
+
+    synchronized(&this->targetLock) {
+        try {
+            this->target->flush();
+        } catch (Exception& e) {
+            this->reportError("Failed to flush the target Handler", &e, ErrorManager::FLUSH_FAILURE);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::publish(const LogRecord& record) {
+
+    // Registered before closed is read, the writer waits for registered publishers
+    // before it exits so a record is never left in the ring uncounted.
+    Atomics::incrementAndGet(&this->activePublishers);
+
+    try {
+        if (this->closed != 0) {
+            Atomics::incrementAndGet(&this->droppedCount);
+        } else if (Handler::isLoggable(record) && !enqueue(record)) {
+            Atomics::incrementAndGet(&this->droppedCount);
+        }
+    } catch (...) {
+        Atomics::decrementAndGet(&this->activePublishers);
+        throw;
+    }
+
+    Atomics::decrementAndGet(&this->activePublishers);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AsyncHandler::enqueue(const LogRecord& record) {
+
+    if (offer(record)) {
+        return true;
+    }
+
+    if (this->policy == BLOCK) {
+
+        for (int spin = 0; spin < BLOCKED_SPIN_COUNT; ++spin) {
+            Thread::yield();
+            if (offer(record)) {
+                return true;
+            }
+        }
+
+        Atomics::incrementAndGet(&this->drainWaiters);
+
+        bool published = false;
+        while (this->closed == 0) {
+
+            if (offer(record)) {
+                published = true;
+                break;
+            }
+
+            synchronized(&this->drainMonitor) {
+                if (isFull() && this->closed == 0) {
+                    this->drainMonitor.wait(DRAIN_WAIT_TIME);
+                }
+            }
+        }
+
+        Atomics::decrementAndGet(&this->drainWaiters);
+
+        return published;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AsyncHandler::isLoggable(const LogRecord& record) const {
+    return this->closed == 0 && Handler::isLoggable(record);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncHandler::getDroppedCount() const {
+    return this->droppedCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AsyncHandler::offer(const LogRecord& record) {
+
+    Slot* slot = NULL;
+    int position = this->enqueuePosition;
+
+    for (;;) {
+
+        slot = &this->slots[position & this->mask];
+        int diff = distance(slot->sequence, position);
+
+        if (diff == 0) {
+            if (Atomics::compareAndSet32(&this->enqueuePosition, position, position + 1)) {
+                break;
+            }
+            position = this->enqueuePosition;
+        } else if (diff < 0) {
+            // The writer has not yet drained the record a full ring ago.
+            return false;
+        } else {
+            position = this->enqueuePosition;
+        }
+    }
+
+    LogRecord& copy = slot->record;
+    copy.setLevel(record.getLevel());
+    copy.setLoggerName(record.getLoggerName());
+    copy.setSourceFile(record.getSourceFile());
+    copy.setSourceLine(record.getSourceLine());
+    copy.setSourceFunction(record.getSourceFunction());
+    copy.setMessage(record.getMessage());
+    copy.setTimestamp(record.getTimestamp());
+    copy.setTreadId(record.getTreadId());
+    copy.setThrown(record.getThrown() != NULL ? record.getThrown()->clone() : NULL);
+
+    // Full barrier, makes the record visible before the writer can see the slot.
+    Atomics::getAndSet(&slot->sequence, position + 1);
+
+    if (this->writerParked != 0) {
+        wakeWriter();
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncHandler::drain() {
+
+    int count = 0;
+
+    synchronized(&this->targetLock) {
+
+        for (;;) {
+
+            const int position = this->dequeuePosition;
+            Slot* slot = &this->slots[position & this->mask];
+
+            if (distance(slot->sequence, position + 1) != 0) {
+                break;
+            }
+
+            try {
+                this->target->publish(slot->record);
+            } catch (Exception& e) {
+                this->reportError("Failed to publish the LogRecord", &e, ErrorManager::WRITE_FAILURE);
+            }
+
+            slot->record.setThrown(NULL);
+            Atomics::getAndSet(&this->dequeuePosition, position + 1);
+            Atomics::getAndSet(&slot->sequence, position + this->capacity);
+            count++;
+
+            if (this->drainWaiters != 0 && (count & this->mask) == 0) {
+                signalDrainWaiters();
+            }
+        }
+    }
+
+    if (count > 0 && this->drainWaiters != 0) {
+        signalDrainWaiters();
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::runWriter() {
+
+    try {
+
+        for (;;) {
+
+            if (drain() > 0) {
+                continue;
+            }
+
+            if (this->closed != 0) {
+                // Pick up records from publishers that passed the closed check
+                // before the close but had not finished copying into their slot.
+                while (this->activePublishers != 0 ||
+                       distance(this->enqueuePosition, this->dequeuePosition) > 0) {
+                    if (drain() == 0) {
+                        Thread::yield();
+                    }
+                }
+                break;
+            }
+
+            synchronized(&this->writerMonitor) {
+                Atomics::getAndSet(&this->writerParked, 1);
+                if (isEmpty() && this->closed == 0) {
+                    this->writerMonitor.wait(WRITER_PARK_TIME);
+                }
+                Atomics::getAndSet(&this->writerParked, 0);
+            }
+        }
+    } catch (Exception& e) {
+        this->reportError("AsyncHandler writer thread failed", &e, ErrorManager::GENERIC_FAILURE);
+    }
+
+    signalDrainWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AsyncHandler::isEmpty() const {
+    const int position = this->dequeuePosition;
+    return distance(this->slots[position & this->mask].sequence, position + 1) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AsyncHandler::isFull() const {
+    return distance(this->enqueuePosition, this->dequeuePosition) >= this->capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::wakeWriter() {
+    synchronized(&this->writerMonitor) {
+        this->writerMonitor.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::signalDrainWaiters() {
+    synchronized(&this->drainMonitor) {
+        this->drainMonitor.notifyAll();
+    }
+}
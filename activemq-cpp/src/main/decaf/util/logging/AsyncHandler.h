@@ -0,0 +1,227 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_LOGGING_ASYNCHANDLER_H_
+#define _DECAF_UTIL_LOGGING_ASYNCHANDLER_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/util/logging/Handler.h>
+#include <decaf/util/logging/LogRecord.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+namespace decaf {
+namespace lang {
+    class Thread;
+}
+namespace util {
+namespace logging {
+
+    class AsyncHandlerWriter;
+
+    /**
+     * A Handler that decouples the threads that log from the I/O performed by another
+     * Handler.  Published LogRecords are copied into a bounded ring buffer and a single
+     * background writer thread drains the ring into the target Handler.
+     *
+     * Claiming a slot in the ring is lock free, the only lock a publishing thread can
+     * touch is the one used to wake the writer when it has parked on an empty ring.
+     * When the ring is full the configured OverflowPolicy decides if the record is
+     * dropped (the default) or if the publishing thread waits for the writer to free
+     * a slot.
+     *
+     * The slots of the ring hold reusable LogRecord instances so that once the ring has
+     * warmed up publishing a record does not allocate beyond growing the string fields.
+     *
+     * Closing this handler drains any records still in the ring and then closes the
+     * target Handler.  The target is not owned by this handler and is not deleted.
+     *
+     * @since 1.0
+     */
+    class DECAF_API AsyncHandler : public Handler {
+    public:
+
+        /**
+         * Action taken by a publishing thread when the ring buffer is full.
+         */
+        enum OverflowPolicy {
+            /** The record is discarded and counted in the dropped record count. */
+            DROP,
+            /** The publishing thread waits until the writer frees a slot. */
+            BLOCK
+        };
+
+        /**
+         * The number of slots in the ring when no capacity is given.
+         */
+        static const int DEFAULT_CAPACITY;
+
+    private:
+
+        struct Slot;
+
+        // The Handler that the writer thread publishes to.
+        Handler* target;
+
+        // What to do when the ring is full.
+        OverflowPolicy policy;
+
+        // Size of the ring, always a power of two, and the mask used to index it.
+        int capacity;
+        int mask;
+
+        Slot* slots;
+
+        // Next position to be claimed by a publisher, advanced with a CAS.
+        volatile int enqueuePosition;
+
+        // Next position the writer will drain, written only by the writer thread.
+        volatile int dequeuePosition;
+
+        volatile int droppedCount;
+
+        // Set while the writer is parked on an empty ring.
+        volatile int writerParked;
+
+        // Number of threads waiting for the writer to make progress.
+        volatile int drainWaiters;
+
+        // Number of threads inside publish, the writer does not exit on close until
+        // this is zero so that each record is either drained or counted as dropped.
+        volatile int activePublishers;
+
+        volatile int closed;
+
+        // Used to park and wake the writer thread.
+        decaf::util::concurrent::Mutex writerMonitor;
+
+        // Signaled by the writer as it frees slots, for BLOCK publishers and flush.
+        decaf::util::concurrent::Mutex drainMonitor;
+
+        // Serializes use of the target between the writer and flush / close.
+        decaf::util::concurrent::Mutex targetLock;
+
+        AsyncHandlerWriter* writerTask;
+        decaf::lang::Thread* writer;
+
+    private:
+
+        AsyncHandler(const AsyncHandler&);
+        AsyncHandler& operator=(const AsyncHandler&);
+
+        friend class AsyncHandlerWriter;
+
+    public:
+
+        /**
+         * Creates a new AsyncHandler that publishes to the given target Handler and
+         * starts its writer thread.
+         *
+         * @param target
+         *      The Handler that records are forwarded to, must outlive this handler.
+         * @param capacity
+         *      The number of records the ring can hold, rounded up to a power of two.
+         * @param policy
+         *      The action taken when a record is published while the ring is full.
+         *
+         * @throws NullPointerException if the target Handler is NULL.
+         * @throws IllegalArgumentException if the capacity is less than one.
+         */
+        AsyncHandler(Handler* target, int capacity = DEFAULT_CAPACITY, OverflowPolicy policy = DROP);
+
+        virtual ~AsyncHandler();
+
+        /**
+         * Drains the records in the ring, stops the writer thread and closes the
+         * target Handler.  Records published after close are discarded.
+         */
+        virtual void close();
+
+        /**
+         * Waits until every record published before this call has been handed to the
+         * target Handler and then flushes the target.
+         */
+        virtual void flush();
+
+        /**
+         * Copies the record into the ring buffer for the writer thread to publish.
+         * This call never performs I/O, it only waits when the ring is full and the
+         * overflow policy is BLOCK.
+         *
+         * @param record
+         *      The <code>LogRecord</code> to Publish
+         */
+        virtual void publish(const LogRecord& record);
+
+        /**
+         * Check if this Handler would actually log a given LogRecord, records are not
+         * loggable once the handler has been closed.
+         *
+         * @param record
+         *      <code>LogRecord</code> to check
+         *
+         * @return true if the record can be logged with current settings.
+         */
+        virtual bool isLoggable(const LogRecord& record) const;
+
+        /**
+         * @return the number of records discarded because the ring was full or
+         *         because they were published after the handler was closed.
+         */
+        int getDroppedCount() const;
+
+        /**
+         * @return the number of records that the ring buffer can hold.
+         */
+        int getCapacity() const {
+            return this->capacity;
+        }
+
+        /**
+         * @return the policy applied when the ring buffer is full.
+         */
+        OverflowPolicy getOverflowPolicy() const {
+            return this->policy;
+        }
+
+    private:
+
+        // Offers the record applying the overflow policy, false if it was not stored.
+        bool enqueue(const LogRecord& record);
+
+        // Claims a slot and copies the record into it, false if the ring is full.
+        bool offer(const LogRecord& record);
+
+        // Publishes the records currently in the ring to the target, called by
+        // the writer thread only, returns the number of records published.
+        int drain();
+
+        // Body of the writer thread.
+        void runWriter();
+
+        bool isEmpty() const;
+
+        bool isFull() const;
+
+        void wakeWriter();
+
+        void signalDrainWaiters();
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_LOGGING_ASYNCHANDLER_H_ */
@@ -0,0 +1,293 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileHandler.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/io/IOException.h>
+#include <decaf/internal/AprPool.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/logging/ErrorManager.h>
+#include <decaf/util/logging/Formatter.h>
+
+#include <apr_errno.h>
+#include <apr_file_io.h>
+#include <apr_file_info.h>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::util;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+const int FileHandler::DEFAULT_BATCH_SIZE = 8192;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace util {
+namespace logging {
+
+    class FileHandlerProperties {
+    private:
+
+        FileHandlerProperties(const FileHandlerProperties&);
+        FileHandlerProperties& operator=(const FileHandlerProperties&);
+
+    public:
+
+        // Pool for the active file, cleared each time the file is closed.
+        AprPool filePool;
+
+        // Pool used for rename and remove while rotating.
+        AprPool pool;
+
+        apr_file_t* file;
+
+        FileHandlerProperties() : filePool(), pool(), file(NULL) {}
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+FileHandler::FileHandler(const std::string& fileName, bool append, long long limit, int count, int batchSize) :
+    Handler(), properties(new FileHandlerProperties()), fileName(fileName), limit(limit), count(count),
+    batchSize(batchSize), fileSize(0), buffer(), defaultFormatter(), mutex() {
+
+    try {
+
+        if (fileName.empty()) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "File name cannot be empty.");
+        }
+
+        if (limit < 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "File size limit cannot be negative.");
+        }
+
+        if (count < 1) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "File count must be at least one: %d", count);
+        }
+
+        if (batchSize < 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "Batch size cannot be negative: %d", batchSize);
+        }
+
+        setFormatter(&this->defaultFormatter);
+
+        if (batchSize > 0) {
+            this->buffer.reserve(batchSize * 2);
+        }
+
+        open(append);
+
+    } catch (...) {
+        delete this->properties;
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileHandler::~FileHandler() {
+
+    try {
+        this->close();
+    }
+    DECAF_CATCH_NOTHROW(Exception)
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->properties;
+    }
+    DECAF_CATCH_NOTHROW(Exception)
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandler::close() {
+
+    synchronized(&this->mutex) {
+        closeFile();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandler::flush() {
+
+    synchronized(&this->mutex) {
+
+        if (this->properties->file == NULL) {
+            return;
+        }
+
+        writeBuffer();
+
+        apr_status_t result = apr_file_flush(this->properties->file);
+        if (result != APR_SUCCESS) {
+            this->reportError("Failed to flush the log file", NULL, ErrorManager::FLUSH_FAILURE);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandler::publish(const LogRecord& record) {
+
+    try {
+
+        if (!this->isLoggable(record)) {
+            return;
+        }
+
+        std::string message;
+        try {
+            message = getFormatter()->format(record);
+        } catch (Exception& e) {
+            this->reportError("Failed to format the LogRecord", &e, ErrorManager::FORMAT_FAILURE);
+            return;
+        }
+
+        synchronized(&this->mutex) {
+
+            if (this->properties->file == NULL) {
+                return;
+            }
+
+            if (this->limit > 0 && this->fileSize > 0 &&
+                this->fileSize + (long long)message.length() > this->limit) {
+
+                rotate();
+            }
+
+            this->buffer.append(message);
+            this->fileSize += (long long)message.length();
+
+            if ((int)this->buffer.length() >= this->batchSize) {
+                writeBuffer();
+            }
+        }
+
+    } catch (Exception& e) {
+        this->reportError("Failed to publish the LogRecord", &e, ErrorManager::GENERIC_FAILURE);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandler::open(bool append) {
+
+    apr_int32_t flags = APR_WRITE | APR_CREATE | APR_BINARY | (append ? APR_APPEND : APR_TRUNCATE);
+
+    apr_status_t result = apr_file_open(&this->properties->file, this->fileName.c_str(),
+                                        flags, APR_OS_DEFAULT, this->properties->filePool.getAprPool());
+
+    if (result != APR_SUCCESS) {
+
+        this->properties->file = NULL;
+        this->properties->filePool.cleanup();
+
+        char buffer[256] = { 0 };
+        throw IOException(__FILE__, __LINE__, "Failed to open log file %s: %s",
+                          this->fileName.c_str(), apr_strerror(result, buffer, 255));
+    }
+
+    this->fileSize = 0;
+
+    if (append) {
+        apr_finfo_t info;
+        if (apr_file_info_get(&info, APR_FINFO_SIZE, this->properties->file) == APR_SUCCESS) {
+            this->fileSize = (long long)info.size;
+        }
+    }
+
+    std::string head = getFormatter()->getHead(this);
+    this->buffer.append(head);
+    this->fileSize += (long long)head.length();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandler::closeFile() {
+
+    if (this->properties->file == NULL) {
+        return;
+    }
+
+    this->buffer.append(getFormatter()->getTail(this));
+    writeBuffer();
+
+    apr_status_t result = apr_file_close(this->properties->file);
+    this->properties->file = NULL;
+    this->properties->filePool.cleanup();
+
+    if (result != APR_SUCCESS) {
+        this->reportError("Failed to close the log file", NULL, ErrorManager::CLOSE_FAILURE);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandler::rotate() {
+
+    closeFile();
+
+    if (this->count > 1) {
+
+        apr_pool_t* pool = this->properties->pool.getAprPool();
+
+        apr_file_remove(generationName(this->count - 1).c_str(), pool);
+
+        for (int generation = this->count - 2; generation >= 0; --generation) {
+            apr_file_rename(generationName(generation).c_str(),
+                            generationName(generation + 1).c_str(), pool);
+        }
+
+        this->properties->pool.cleanup();
+    }
+
+    try {
+        open(false);
+    } catch (IOException& e) {
+        this->reportError("Failed to open the next log file", &e, ErrorManager::OPEN_FAILURE);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandler::writeBuffer() {
+
+    if (this->buffer.empty() || this->properties->file == NULL) {
+        return;
+    }
+
+    apr_size_t written = 0;
+    apr_status_t result = apr_file_write_full(this->properties->file, this->buffer.c_str(),
+                                              this->buffer.length(), &written);
+
+    this->buffer.clear();
+
+    if (result != APR_SUCCESS) {
+        this->reportError("Failed to write to the log file", NULL, ErrorManager::WRITE_FAILURE);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string FileHandler::generationName(int generation) const {
+
+    if (generation == 0) {
+        return this->fileName;
+    }
+
+    return this->fileName + "." + Integer::toString(generation);
+}
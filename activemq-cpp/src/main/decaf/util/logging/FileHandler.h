@@ -0,0 +1,162 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_LOGGING_FILEHANDLER_H_
+#define _DECAF_UTIL_LOGGING_FILEHANDLER_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/util/logging/Handler.h>
+#include <decaf/util/logging/SimpleFormatter.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <string>
+
+namespace decaf {
+namespace util {
+namespace logging {
+
+    class FileHandlerProperties;
+
+    /**
+     * Simple file logging Handler.
+     *
+     * The FileHandler writes to a single file or, when a size limit is given, to a
+     * rotating set of files.  The active file is always the given file name, when
+     * writing a record would take it past the limit the file is closed, older files
+     * are shifted to the next generation and a new file is started.  Generations
+     * are named by appending ".1", ".2" up to ".count-1" to the file name and the
+     * oldest generation is deleted.
+     *
+     * Formatted records are collected in a buffer and written to the file in batches
+     * of at least the configured batch size, or when the handler is flushed or
+     * closed.  A batch size of zero writes each record as it is published.
+     *
+     * By default the SimpleFormatter is used and the Level is ALL.
+     *
+     * @since 1.0
+     */
+    class DECAF_API FileHandler : public Handler {
+    public:
+
+        /**
+         * Number of buffered bytes that triggers a write when no batch size is given.
+         */
+        static const int DEFAULT_BATCH_SIZE;
+
+    private:
+
+        FileHandlerProperties* properties;
+
+        // Name of the active log file.
+        std::string fileName;
+
+        // Byte limit of one file, zero means no limit and no rotation.
+        long long limit;
+
+        // Number of file generations kept when rotating.
+        int count;
+
+        // Buffered bytes that trigger a write to the file.
+        int batchSize;
+
+        // Bytes written to the active file including those still buffered.
+        long long fileSize;
+
+        // Formatted records waiting to be written.
+        std::string buffer;
+
+        SimpleFormatter defaultFormatter;
+
+        decaf::util::concurrent::Mutex mutex;
+
+    private:
+
+        FileHandler(const FileHandler&);
+        FileHandler& operator=(const FileHandler&);
+
+    public:
+
+        /**
+         * Creates a FileHandler that writes to the named file.
+         *
+         * @param fileName
+         *      The name of the file to write to.
+         * @param append
+         *      If true records are appended to an existing file, otherwise it is truncated.
+         * @param limit
+         *      The maximum number of bytes to write to one file, zero for no limit.
+         * @param count
+         *      The number of files to rotate through when a limit is set, at least one.
+         * @param batchSize
+         *      The number of buffered bytes that triggers a write to the file.
+         *
+         * @throws IllegalArgumentException if the file name is empty or a numeric argument
+         *         is out of range.
+         * @throws IOException if the file cannot be opened.
+         */
+        FileHandler(const std::string& fileName, bool append = false, long long limit = 0,
+                    int count = 1, int batchSize = DEFAULT_BATCH_SIZE);
+
+        virtual ~FileHandler();
+
+        /**
+         * Writes the Formatter's tail and any buffered records and then closes the file.
+         */
+        virtual void close();
+
+        /**
+         * Writes any buffered records to the file and flushes it.
+         */
+        virtual void flush();
+
+        /**
+         * Formats the record and adds it to the current batch, the batch is written when
+         * it reaches the batch size.
+         *
+         * @param record
+         *      The <code>LogRecord</code> to Publish
+         */
+        virtual void publish(const LogRecord& record);
+
+        /**
+         * @return the name of the file currently being written to.
+         */
+        std::string getFileName() const {
+            return this->fileName;
+        }
+
+    private:
+
+        // Opens the active file and writes the Formatter head.
+        void open(bool append);
+
+        // Writes the Formatter tail and any buffered data then closes the active file.
+        void closeFile();
+
+        // Closes the active file, shifts the older generations and opens a new file.
+        void rotate();
+
+        // Writes the buffered data to the file.
+        void writeBuffer();
+
+        std::string generationName(int generation) const;
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_LOGGING_FILEHANDLER_H_ */
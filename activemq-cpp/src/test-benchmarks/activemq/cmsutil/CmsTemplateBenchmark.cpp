@@ -0,0 +1,219 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CmsTemplateBenchmark.h"
+
+#include <benchmark/AllocationCounter.h>
+#include <benchmark/LatencyStats.h>
+
+#include <activemq/cmsutil/CmsTemplate.h>
+#include <activemq/cmsutil/MessageCreator.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+
+#include <cms/DeliveryMode.h>
+#include <cms/Session.h>
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace benchmark;
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace activemq::core;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int WARMUP_SENDS = 500;
+    const int TOTAL_SENDS = 64000;
+    const int BATCH_SIZE = 100;
+
+    void report(const std::string& name, int messages, long long elapsed,
+                LatencyStats& stats, int allocations) {
+
+        std::cout << std::left << std::setw(52) << name << std::right
+                  << std::setw(9) << (long long) (messages * 1000000000.0 / elapsed) << " msgs/s  "
+                  << stats.toString() << "  allocs/msg="
+                  << std::fixed << std::setprecision(1) << (double) allocations / messages
+                  << std::endl;
+    }
+
+    class TextCreator : public MessageCreator {
+    private:
+
+        std::string text;
+
+    public:
+
+        TextCreator() : MessageCreator(), text(256, 'x') {
+        }
+
+        virtual ~TextCreator() {}
+
+        virtual cms::Message* createMessage(cms::Session* session) {
+            return session->createTextMessage(text);
+        }
+    };
+
+    class SendTask : public Runnable {
+    private:
+
+        CmsTemplate* cmsTemplate;
+        CountDownLatch* start;
+        int count;
+        int batchSize;
+        TextCreator creator;
+        ArrayList<MessageCreator*> batch;
+
+    private:
+
+        SendTask(const SendTask&);
+        SendTask& operator=(const SendTask&);
+
+    public:
+
+        LatencyStats stats;
+
+        SendTask(CmsTemplate* cmsTemplate, CountDownLatch* start, int count, int batchSize) :
+            Runnable(), cmsTemplate(cmsTemplate), start(start), count(count),
+            batchSize(batchSize), creator(), batch(), stats() {
+
+            for (int i = 0; i < batchSize; ++i) {
+                batch.add(&creator);
+            }
+            stats.reserve(count);
+        }
+
+        virtual ~SendTask() {}
+
+        void send(int messages, LatencyStats* latencies) {
+
+            if (batchSize > 0) {
+                for (int i = 0; i < messages; i += batchSize) {
+                    long long begin = System::nanoTime();
+                    std::auto_ptr< Iterator<MessageCreator*> > iter(batch.iterator());
+                    cmsTemplate->sendBatch(iter.get());
+                    if (latencies != NULL) {
+                        latencies->add(System::nanoTime() - begin);
+                    }
+                }
+                return;
+            }
+
+            for (int i = 0; i < messages; ++i) {
+                long long begin = System::nanoTime();
+                cmsTemplate->send(&creator);
+                if (latencies != NULL) {
+                    latencies->add(System::nanoTime() - begin);
+                }
+            }
+        }
+
+        virtual void run() {
+            send(WARMUP_SENDS, NULL);
+            start->await();
+            send(count, &stats);
+        }
+    };
+
+    void runScenario(int threads, int cacheSize, int batchSize) {
+
+        ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+        CmsTemplate cmsTemplate(&factory);
+        cmsTemplate.setDefaultDestinationName("bench.template");
+        cmsTemplate.setExplicitQosEnabled(true);
+        cmsTemplate.setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+        cmsTemplate.setThreadSessionCacheSize(cacheSize);
+
+        CountDownLatch start(1);
+        int count = TOTAL_SENDS / threads;
+
+        std::vector<SendTask*> tasks;
+        std::vector<Thread*> workers;
+        for (int i = 0; i < threads; ++i) {
+            tasks.push_back(new SendTask(&cmsTemplate, &start, count, batchSize));
+            workers.push_back(new Thread(tasks.back()));
+            workers.back()->start();
+        }
+
+        // Let every thread finish its warm up sends before timing.
+        Thread::sleep(200);
+
+        AllocationCounter::reset();
+        long long begin = System::nanoTime();
+        start.countDown();
+
+        for (int i = 0; i < threads; ++i) {
+            workers[i]->join();
+        }
+
+        long long elapsed = System::nanoTime() - begin;
+        int allocations = AllocationCounter::getCount();
+
+        LatencyStats stats;
+        for (int i = 0; i < threads; ++i) {
+            stats.addAll(tasks[i]->stats);
+            delete workers[i];
+            delete tasks[i];
+        }
+
+        std::ostringstream name;
+        name << (cacheSize > 0 ? "thread sessions" : "shared pool");
+        if (batchSize > 0) {
+            name << " batch=" << batchSize;
+        }
+        name << " threads=" << threads;
+        report(name.str(), threads * count, elapsed, stats, allocations);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CmsTemplateBenchmark::CmsTemplateBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CmsTemplateBenchmark::~CmsTemplateBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CmsTemplateBenchmark::testSend() {
+
+    const int THREADS[] = { 1, 4, 32 };
+
+    std::cout << std::endl;
+
+    for (int threads = 0; threads < 3; ++threads) {
+        runScenario(THREADS[threads], 0, 0);
+        runScenario(THREADS[threads], THREADS[threads], 0);
+    }
+
+    runScenario(4, 0, BATCH_SIZE);
+    runScenario(4, 4, BATCH_SIZE);
+}
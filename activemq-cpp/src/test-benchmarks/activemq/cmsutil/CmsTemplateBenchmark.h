@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _ACTIVEMQ_CMSUTIL_CMSTEMPLATEBENCHMARK_H_
+#define _ACTIVEMQ_CMSUTIL_CMSTEMPLATEBENCHMARK_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace cmsutil {
+
+    /**
+     * Measures sends through one CmsTemplate shared by a growing number of threads,
+     * with the sessions taken from the shared pool and with a session bound to each
+     * thread.  The connection runs over the in-process mock transport and sends are
+     * non-persistent, so what is left is the client side cost including the time
+     * spent waiting on the pool.
+     *
+     * Each scenario prints its throughput in messages per second, the p50, p99 and
+     * p999 latency of the individual sends, or batches for the batched scenario, and
+     * the number of heap allocations made per message.
+     */
+    class CmsTemplateBenchmark : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( CmsTemplateBenchmark );
+        CPPUNIT_TEST( testSend );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        CmsTemplateBenchmark();
+        virtual ~CmsTemplateBenchmark();
+
+        /**
+         * Times single sends from 1, 4 and 32 threads against the shared pool and
+         * the per thread session cache, then batches of sends from 4 threads.
+         */
+        void testSend();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CMSUTIL_CMSTEMPLATEBENCHMARK_H_ */
@@ -0,0 +1,400 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RequestorBenchmark.h"
+
+#include <benchmark/AllocationCounter.h>
+#include <benchmark/LatencyStats.h>
+
+#include <activemq/cmsutil/Requestor.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ConsumerInfo.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <cms/DeliveryMode.h>
+#include <cms/MessageConsumer.h>
+#include <cms/MessageProducer.h>
+#include <cms/Session.h>
+#include <cms/TemporaryQueue.h>
+
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace benchmark;
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace activemq::commands;
+using namespace activemq::core;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int WARMUP_REQUESTS = 500;
+    const int PIPELINE_WINDOW = 64;
+    const long long REPLY_TIMEOUT = 10000;
+    const std::string REQUEST_QUEUE = "bench.requests";
+
+    enum Pattern {
+        TEMP_QUEUE_PER_REQUEST,
+        SHARED_REQUESTOR,
+        PIPELINED_REQUESTOR
+    };
+
+    void report(const std::string& name, int requests, long long elapsed,
+                LatencyStats& stats, int allocations) {
+
+        std::cout << std::left << std::setw(52) << name << std::right
+                  << std::setw(9) << (long long) (requests * 1000000000.0 / elapsed) << " reqs/s  "
+                  << stats.toString() << "  allocs/req="
+                  << std::fixed << std::setprecision(1) << (double) allocations / requests
+                  << std::endl;
+    }
+
+    /**
+     * Answers every message sent to the request queue with a reply to its CMSReplyTo,
+     * dispatched to whichever consumer the client opened on that destination.
+     */
+    class EchoService : public DefaultTransportListener {
+    private:
+
+        Mutex mutex;
+        MockTransport* transport;
+        long long sequence;
+        std::map<std::string, Pointer<ConsumerId> > consumers;
+        Pointer<ProducerId> producerId;
+
+    private:
+
+        EchoService(const EchoService&);
+        EchoService& operator=(const EchoService&);
+
+    public:
+
+        EchoService(MockTransport* transport) :
+            mutex(), transport(transport), sequence(0), consumers(),
+            producerId(new ProducerId("ID:bench-service:1:1:1")) {
+        }
+
+        virtual ~EchoService() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+
+            if (command->isConsumerInfo()) {
+                Pointer<ConsumerInfo> info = command.dynamicCast<ConsumerInfo>();
+                synchronized(&mutex) {
+                    consumers[info->getDestination()->getPhysicalName()] = info->getConsumerId();
+                }
+                return;
+            }
+
+            if (!command->isMessage()) {
+                return;
+            }
+
+            Pointer<commands::Message> request = command.dynamicCast<commands::Message>();
+            if (request->getDestination()->getPhysicalName() != REQUEST_QUEUE) {
+                return;
+            }
+
+            Pointer<ConsumerId> consumerId;
+            long long id = 0;
+            synchronized(&mutex) {
+                consumerId = consumers[request->getReplyTo()->getPhysicalName()];
+                id = ++sequence;
+            }
+
+            Pointer<ActiveMQTextMessage> reply(new ActiveMQTextMessage());
+            reply->setText(request.dynamicCast<ActiveMQTextMessage>()->getText());
+            reply->setCorrelationId(request->getCorrelationId());
+            reply->setDestination(request->getReplyTo());
+            reply->setMessageId(Pointer<MessageId>(new MessageId(producerId, id)));
+
+            Pointer<MessageDispatch> dispatch(new MessageDispatch());
+            dispatch->setConsumerId(consumerId);
+            dispatch->setDestination(request->getReplyTo());
+            dispatch->setMessage(reply);
+
+            transport->fireCommand(dispatch);
+        }
+    };
+
+    class MockConnection {
+    private:
+
+        MockConnection(const MockConnection&);
+        MockConnection& operator=(const MockConnection&);
+
+    public:
+
+        std::auto_ptr<ActiveMQConnection> connection;
+        MockTransport* transport;
+        std::auto_ptr<EchoService> service;
+
+        MockConnection() : connection(), transport(NULL), service() {
+
+            ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+            connection.reset(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+            transport = dynamic_cast<MockTransport*>(
+                connection->getTransport().narrow(typeid(MockTransport)));
+
+            service.reset(new EchoService(transport));
+            transport->setOutgoingListener(service.get());
+            connection->start();
+        }
+
+        ~MockConnection() {
+            try {
+                connection->close();
+            } catch (...) {
+            }
+            transport->setOutgoingListener(NULL);
+        }
+    };
+
+    /**
+     * Makes requests the way an application without a Requestor would, a temporary
+     * queue and a consumer on it are created for each request and destroyed after
+     * the reply arrives.
+     */
+    class TempQueueClient {
+    private:
+
+        std::auto_ptr<cms::Session> session;
+        std::auto_ptr<cms::MessageProducer> producer;
+
+    private:
+
+        TempQueueClient(const TempQueueClient&);
+        TempQueueClient& operator=(const TempQueueClient&);
+
+    public:
+
+        TempQueueClient(cms::Connection* connection) : session(), producer() {
+            session.reset(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+            producer.reset(session->createProducer(NULL));
+            producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+        }
+
+        cms::Message* request(const cms::Destination* destination, cms::Message* message) {
+
+            std::auto_ptr<cms::TemporaryQueue> replyQueue(session->createTemporaryQueue());
+            std::auto_ptr<cms::MessageConsumer> consumer(session->createConsumer(replyQueue.get()));
+
+            message->setCMSReplyTo(replyQueue.get());
+            producer->send(destination, message);
+            cms::Message* reply = consumer->receive((int) REPLY_TIMEOUT);
+
+            consumer->close();
+            replyQueue->destroy();
+            return reply;
+        }
+    };
+
+    class RequestTask : public Runnable {
+    private:
+
+        Pattern pattern;
+        Requestor* requestor;
+        std::auto_ptr<TempQueueClient> client;
+        ActiveMQQueue queue;
+        ActiveMQTextMessage message;
+        CountDownLatch* start;
+        int count;
+
+    private:
+
+        RequestTask(const RequestTask&);
+        RequestTask& operator=(const RequestTask&);
+
+    public:
+
+        LatencyStats stats;
+        int failures;
+
+        RequestTask(Pattern pattern, cms::Connection* connection, Requestor* requestor,
+                    CountDownLatch* start, int count) :
+            pattern(pattern), requestor(requestor), client(), queue(REQUEST_QUEUE), message(),
+            start(start), count(count), stats(), failures(0) {
+
+            if (pattern == TEMP_QUEUE_PER_REQUEST) {
+                client.reset(new TempQueueClient(connection));
+            }
+
+            message.setText(std::string(256, 'x'));
+            stats.reserve(count);
+        }
+
+        virtual ~RequestTask() {}
+
+        void request(int requests, LatencyStats* latencies) {
+            if (pattern == PIPELINED_REQUESTOR) {
+                pipeline(requests, latencies);
+                return;
+            }
+
+            for (int i = 0; i < requests; ++i) {
+                long long begin = System::nanoTime();
+                std::auto_ptr<cms::Message> reply(pattern == TEMP_QUEUE_PER_REQUEST ?
+                    client->request(&queue, &message) : requestor->request(&queue, &message, REPLY_TIMEOUT));
+                if (latencies != NULL) {
+                    latencies->add(System::nanoTime() - begin);
+                }
+                if (reply.get() == NULL) {
+                    failures++;
+                }
+            }
+        }
+
+        // Keeps a window of requests outstanding, waiting on the oldest once it is full.
+        void pipeline(int requests, LatencyStats* latencies) {
+
+            std::deque< std::pair<long long, Pointer<Requestor::ReplyFuture> > > window;
+
+            for (int i = 0; i < requests || !window.empty(); ) {
+                if (i < requests && (int) window.size() < PIPELINE_WINDOW) {
+                    long long begin = System::nanoTime();
+                    window.push_back(std::make_pair(begin, requestor->requestAsync(&queue, &message, REPLY_TIMEOUT)));
+                    i++;
+                    continue;
+                }
+
+                try {
+                    window.front().second->get();
+                } catch (...) {
+                    failures++;
+                }
+                if (latencies != NULL) {
+                    latencies->add(System::nanoTime() - window.front().first);
+                }
+                window.pop_front();
+            }
+        }
+
+        virtual void run() {
+            start->await();
+            request(count, &stats);
+        }
+    };
+
+    std::string patternName(Pattern pattern) {
+        switch (pattern) {
+            case TEMP_QUEUE_PER_REQUEST:
+                return "temp queue per request";
+            case SHARED_REQUESTOR:
+                return "requestor";
+            default:
+                return "requestor pipelined";
+        }
+    }
+
+    void runScenario(Pattern pattern, int threads, int count) {
+
+        MockConnection mock;
+        std::auto_ptr<Requestor> requestor;
+        if (pattern != TEMP_QUEUE_PER_REQUEST) {
+            requestor.reset(new Requestor(mock.connection.get()));
+        }
+
+        CountDownLatch start(1);
+
+        std::vector<RequestTask*> tasks;
+        std::vector<Thread*> workers;
+        for (int i = 0; i < threads; ++i) {
+            tasks.push_back(new RequestTask(pattern, mock.connection.get(), requestor.get(), &start, count));
+            tasks.back()->request(WARMUP_REQUESTS, NULL);
+            workers.push_back(new Thread(tasks.back()));
+            workers.back()->start();
+        }
+
+        AllocationCounter::reset();
+        long long begin = System::nanoTime();
+        start.countDown();
+
+        for (int i = 0; i < threads; ++i) {
+            workers[i]->join();
+        }
+
+        long long elapsed = System::nanoTime() - begin;
+        int allocations = AllocationCounter::getCount();
+
+        LatencyStats stats;
+        int failures = 0;
+        for (int i = 0; i < threads; ++i) {
+            stats.addAll(tasks[i]->stats);
+            failures += tasks[i]->failures;
+            delete workers[i];
+            delete tasks[i];
+        }
+
+        std::ostringstream name;
+        name << patternName(pattern) << " threads=" << threads;
+        if (failures > 0) {
+            name << " failures=" << failures;
+        }
+        report(name.str(), threads * count, elapsed, stats, allocations);
+
+        if (requestor.get() != NULL) {
+            requestor->close();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+RequestorBenchmark::RequestorBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+RequestorBenchmark::~RequestorBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorBenchmark::testRequestReply() {
+
+    const int THREADS[] = { 1, 4 };
+
+    std::cout << std::endl;
+
+    for (int threads = 0; threads < 2; ++threads) {
+        runScenario(TEMP_QUEUE_PER_REQUEST, THREADS[threads], 5000);
+        runScenario(SHARED_REQUESTOR, THREADS[threads], 5000);
+    }
+
+    runScenario(PIPELINED_REQUESTOR, 1, 20000);
+}
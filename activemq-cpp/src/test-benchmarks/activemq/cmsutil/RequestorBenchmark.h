@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CMSUTIL_REQUESTORBENCHMARK_H_
+#define _ACTIVEMQ_CMSUTIL_REQUESTORBENCHMARK_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace cmsutil {
+
+    /**
+     * Compares request/reply through a Requestor with the usual hand written pattern
+     * of a temporary queue and consumer per request.  The connection runs over the
+     * in-process mock transport and the replies are produced by a listener on the
+     * outgoing commands, so the broker round trips that the per-request pattern adds
+     * cost nothing here; the numbers are the client side cost only and understate
+     * the difference against a real broker.
+     *
+     * Each scenario prints its throughput in requests per second, the p50, p99 and
+     * p999 latency of the individual requests and the number of heap allocations
+     * made per request.
+     */
+    class RequestorBenchmark : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( RequestorBenchmark );
+        CPPUNIT_TEST( testRequestReply );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        RequestorBenchmark();
+        virtual ~RequestorBenchmark();
+
+        /**
+         * Times synchronous requests from one and four threads with a temporary
+         * queue per request and with a shared Requestor, and pipelined requests
+         * from a single thread through Requestor::requestAsync.
+         */
+        void testRequestReply();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CMSUTIL_REQUESTORBENCHMARK_H_ */
@@ -0,0 +1,539 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ClientPathBenchmark.h"
+
+#include <benchmark/AllocationCounter.h>
+#include <benchmark/LatencyStats.h>
+
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/core/ActiveMQConsumer.h>
+#include <activemq/core/ActiveMQProducer.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Semaphore.h>
+
+#include <cms/BytesMessage.h>
+#include <cms/MessageListener.h>
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace benchmark;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int WARMUP_MESSAGES = 1000;
+    const int DELIVERY_WINDOW = 100;
+    const int ACK_BATCH = 100;
+
+    std::vector<unsigned char> createPayload(int size) {
+        std::vector<unsigned char> payload(size);
+        for (int i = 0; i < size; ++i) {
+            payload[i] = (unsigned char) (i * 31 + 7);
+        }
+        return payload;
+    }
+
+    void report(const std::string& name, int messages, long long elapsed,
+                LatencyStats& stats, int allocations) {
+
+        std::cout << std::left << std::setw(52) << name << std::right
+                  << std::setw(9) << (long long) (messages * 1000000000.0 / elapsed) << " msgs/s  "
+                  << stats.toString() << "  allocs/msg="
+                  << std::fixed << std::setprecision(1) << (double) allocations / messages
+                  << std::endl;
+    }
+
+    /**
+     * Stands in for the wire, every command the client sends is marshaled to OpenWire
+     * so that the cost of encoding is part of the measurement.
+     */
+    class WireSink : public DefaultTransportListener {
+    private:
+
+        Mutex mutex;
+        Properties properties;
+        OpenWireFormat format;
+        ByteArrayOutputStream bytes;
+        DataOutputStream output;
+        const Transport* transport;
+
+    private:
+
+        WireSink(const WireSink&);
+        WireSink& operator=(const WireSink&);
+
+    public:
+
+        WireSink() : mutex(), properties(), format(properties), bytes(), output(&bytes), transport(NULL) {}
+
+        virtual ~WireSink() {}
+
+        void setTransport(const Transport* transport) {
+            this->transport = transport;
+        }
+
+        virtual void onCommand(const Pointer<Command> command) {
+            synchronized(&mutex) {
+                bytes.reset();
+                format.marshal(command, transport, &output);
+            }
+        }
+    };
+
+    /**
+     * A started connection over the mock transport whose outgoing commands go to a
+     * WireSink.  Closes the connection before the sink goes away since closing sends
+     * the remove commands through it.
+     */
+    class MockConnection {
+    private:
+
+        MockConnection(const MockConnection&);
+        MockConnection& operator=(const MockConnection&);
+
+    public:
+
+        WireSink sink;
+        std::auto_ptr<ActiveMQConnection> connection;
+        MockTransport* transport;
+
+        MockConnection() : sink(), connection(), transport(NULL) {
+
+            ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+            connection.reset(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+            transport = dynamic_cast<MockTransport*>(
+                connection->getTransport().narrow(typeid(MockTransport)));
+
+            sink.setTransport(transport);
+            transport->setOutgoingListener(&sink);
+            connection->start();
+        }
+
+        ~MockConnection() {
+            try {
+                connection->close();
+            } catch (...) {
+            }
+            transport->setOutgoingListener(NULL);
+        }
+    };
+
+    class ProducerTask : public Runnable {
+    private:
+
+        std::auto_ptr<cms::Session> session;
+        std::auto_ptr<cms::Queue> queue;
+        std::auto_ptr<cms::MessageProducer> producer;
+        std::auto_ptr<cms::BytesMessage> message;
+        ArrayList<cms::Message*> batch;
+        CountDownLatch* start;
+        int count;
+
+    private:
+
+        ProducerTask(const ProducerTask&);
+        ProducerTask& operator=(const ProducerTask&);
+
+    public:
+
+        LatencyStats stats;
+
+        ProducerTask(cms::Connection* connection, int index, const std::vector<unsigned char>& payload,
+                     bool persistent, CountDownLatch* start, int count, int batchSize = 0) :
+            session(), queue(), producer(), message(), batch(), start(start), count(count), stats() {
+
+            session.reset(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+            queue.reset(session->createQueue("bench.producer." + Integer::toString(index)));
+            producer.reset(session->createProducer(queue.get()));
+            producer->setDeliveryMode(persistent ? cms::DeliveryMode::PERSISTENT : cms::DeliveryMode::NON_PERSISTENT);
+            message.reset(session->createBytesMessage(&payload[0], (int) payload.size()));
+            for (int i = 0; i < batchSize; ++i) {
+                batch.add(message.get());
+            }
+            stats.reserve(count);
+        }
+
+        virtual ~ProducerTask() {}
+
+        void send(int messages, LatencyStats* latencies) {
+
+            // Batched sends are timed per batch.
+            if (!batch.isEmpty()) {
+                ActiveMQProducer* amqProducer = dynamic_cast<ActiveMQProducer*>(producer.get());
+                for (int i = 0; i < messages; i += batch.size()) {
+                    long long begin = System::nanoTime();
+                    amqProducer->sendBatch(batch);
+                    if (latencies != NULL) {
+                        latencies->add(System::nanoTime() - begin);
+                    }
+                }
+                return;
+            }
+
+            for (int i = 0; i < messages; ++i) {
+                long long begin = System::nanoTime();
+                producer->send(message.get());
+                if (latencies != NULL) {
+                    latencies->add(System::nanoTime() - begin);
+                }
+            }
+        }
+
+        virtual void run() {
+            start->await();
+            send(count, &stats);
+        }
+    };
+
+    /**
+     * Records the time from the injection of each dispatch to its arrival and applies
+     * the acknowledgement policy of the scenario.  Every delivery returns one permit to
+     * the window so the injector never runs more than a window ahead of the listeners.
+     */
+    class DeliveryListener : public cms::MessageListener {
+    private:
+
+        cms::Session* session;
+        int ackMode;
+        int warmup;
+        int received;
+        Semaphore* window;
+        CountDownLatch* done;
+
+    private:
+
+        DeliveryListener(const DeliveryListener&);
+        DeliveryListener& operator=(const DeliveryListener&);
+
+    public:
+
+        std::vector<long long> injected;
+        LatencyStats stats;
+
+        DeliveryListener(cms::Session* session, int ackMode, int warmup, int count,
+                         Semaphore* window, CountDownLatch* done) :
+            session(session), ackMode(ackMode), warmup(warmup), received(0), window(window),
+            done(done), injected(warmup + count), stats() {
+
+            stats.reserve(count);
+        }
+
+        virtual ~DeliveryListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+
+            long long now = System::nanoTime();
+            if (received >= warmup) {
+                stats.add(now - injected[received]);
+            }
+
+            received++;
+            bool endOfBatch = received % ACK_BATCH == 0 || received == (int) injected.size();
+
+            if (ackMode == cms::Session::CLIENT_ACKNOWLEDGE && endOfBatch) {
+                message->acknowledge();
+            } else if (ackMode == cms::Session::SESSION_TRANSACTED && endOfBatch) {
+                session->commit();
+            }
+
+            window->release();
+
+            if (received == (int) injected.size()) {
+                done->countDown();
+            }
+        }
+    };
+
+    class ConsumerTask {
+    private:
+
+        ConsumerTask(const ConsumerTask&);
+        ConsumerTask& operator=(const ConsumerTask&);
+
+    public:
+
+        std::auto_ptr<cms::Session> session;
+        std::auto_ptr<cms::Queue> queue;
+        std::auto_ptr<cms::MessageConsumer> consumer;
+        std::auto_ptr<DeliveryListener> listener;
+        std::vector<unsigned char> dispatch;
+        int next;
+
+        ConsumerTask(MockConnection& mock, int index, int ackMode, const std::vector<unsigned char>& payload,
+                     int count, Semaphore* window, CountDownLatch* done) :
+            session(), queue(), consumer(), listener(), dispatch(), next(0) {
+
+            session.reset(mock.connection->createSession((cms::Session::AcknowledgeMode) ackMode));
+            queue.reset(session->createQueue("bench.consumer." + Integer::toString(index)));
+            consumer.reset(session->createConsumer(queue.get()));
+            listener.reset(new DeliveryListener(session.get(), ackMode, WARMUP_MESSAGES, count, window, done));
+            consumer->setMessageListener(listener.get());
+
+            Pointer<ActiveMQDestination> destination(new ActiveMQQueue(queue->getQueueName()));
+
+            Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+            message->setContent(payload);
+            message->setDestination(destination);
+            message->setMessageId(Pointer<MessageId>(new MessageId(
+                Pointer<ProducerId>(new ProducerId("ID:bench-producer:1:1:1")), 1)));
+
+            Pointer<MessageDispatch> command(new MessageDispatch());
+            command->setConsumerId(Pointer<ConsumerId>(
+                dynamic_cast<ActiveMQConsumer*>(consumer.get())->getConsumerId()->cloneDataStructure()));
+            command->setDestination(destination);
+            command->setMessage(message);
+
+            // Marshaled once, each delivery unmarshals these bytes like a real transport would.
+            Properties properties;
+            OpenWireFormat format(properties);
+            ByteArrayOutputStream bytes;
+            DataOutputStream output(&bytes);
+            format.marshal(command, mock.transport, &output);
+            output.flush();
+
+            std::pair<unsigned char*, int> array = bytes.toByteArray();
+            dispatch.assign(array.first, array.first + array.second);
+            delete [] array.first;
+        }
+    };
+
+    /**
+     * Unmarshals the next dispatch for the given consumer and hands it to the
+     * connection, taking a permit from the delivery window first.
+     */
+    void inject(MockTransport* transport, OpenWireFormat& format, ByteArrayInputStream& bytes,
+                DataInputStream& input, ConsumerTask& task, Semaphore& window, long long sequence) {
+
+        window.acquire();
+
+        long long begin = System::nanoTime();
+        bytes.setByteArray(&task.dispatch[0], (int) task.dispatch.size());
+        Pointer<MessageDispatch> command = format.unmarshal(transport, &input).dynamicCast<MessageDispatch>();
+        command->getMessage()->getMessageId()->setProducerSequenceId(sequence);
+
+        task.listener->injected[task.next++] = begin;
+        transport->fireCommand(command);
+    }
+
+    std::string ackModeName(int ackMode) {
+        switch (ackMode) {
+            case cms::Session::AUTO_ACKNOWLEDGE:
+                return "auto";
+            case cms::Session::DUPS_OK_ACKNOWLEDGE:
+                return "dups_ok";
+            case cms::Session::CLIENT_ACKNOWLEDGE:
+                return "client";
+            default:
+                return "transacted";
+        }
+    }
+
+    void runProducerScenario(int size, bool persistent, int sessions, int count, int batchSize = 0) {
+
+        MockConnection mock;
+        std::vector<unsigned char> payload = createPayload(size);
+        CountDownLatch start(1);
+
+        std::vector<ProducerTask*> tasks;
+        std::vector<Thread*> threads;
+        for (int i = 0; i < sessions; ++i) {
+            tasks.push_back(new ProducerTask(mock.connection.get(), i, payload, persistent, &start, count, batchSize));
+            tasks.back()->send(WARMUP_MESSAGES, NULL);
+            threads.push_back(new Thread(tasks.back()));
+            threads.back()->start();
+        }
+
+        AllocationCounter::reset();
+        long long begin = System::nanoTime();
+        start.countDown();
+
+        for (int i = 0; i < sessions; ++i) {
+            threads[i]->join();
+        }
+
+        long long elapsed = System::nanoTime() - begin;
+        int allocations = AllocationCounter::getCount();
+
+        LatencyStats stats;
+        for (int i = 0; i < sessions; ++i) {
+            stats.addAll(tasks[i]->stats);
+            delete threads[i];
+            delete tasks[i];
+        }
+
+        std::ostringstream name;
+        name << "producer size=" << size << " sessions=" << sessions
+             << (persistent ? " persistent" : " non-persistent");
+        if (batchSize > 0) {
+            name << " batch=" << batchSize;
+        }
+        report(name.str(), sessions * count, elapsed, stats, allocations);
+    }
+
+    void runConsumerScenario(int size, int ackMode, int sessions, int count) {
+
+        MockConnection mock;
+        std::vector<unsigned char> payload = createPayload(size);
+        Semaphore window(DELIVERY_WINDOW);
+        CountDownLatch done(sessions);
+
+        std::vector<ConsumerTask*> tasks;
+        for (int i = 0; i < sessions; ++i) {
+            tasks.push_back(new ConsumerTask(mock, i, ackMode, payload, count, &window, &done));
+        }
+
+        Properties properties;
+        OpenWireFormat format(properties);
+        ByteArrayInputStream bytes;
+        DataInputStream input(&bytes);
+        long long sequence = 1;
+
+        for (int i = 0; i < WARMUP_MESSAGES; ++i) {
+            for (int j = 0; j < sessions; ++j) {
+                inject(mock.transport, format, bytes, input, *tasks[j], window, sequence++);
+            }
+        }
+
+        // Drain the window so the warm up deliveries are not counted.
+        window.acquire(DELIVERY_WINDOW);
+        window.release(DELIVERY_WINDOW);
+
+        AllocationCounter::reset();
+        long long begin = System::nanoTime();
+
+        for (int i = 0; i < count; ++i) {
+            for (int j = 0; j < sessions; ++j) {
+                inject(mock.transport, format, bytes, input, *tasks[j], window, sequence++);
+            }
+        }
+
+        done.await();
+        long long elapsed = System::nanoTime() - begin;
+        int allocations = AllocationCounter::getCount();
+
+        LatencyStats stats;
+        for (int i = 0; i < sessions; ++i) {
+            stats.addAll(tasks[i]->listener->stats);
+        }
+
+        std::ostringstream name;
+        name << "consumer size=" << size << " sessions=" << sessions << " " << ackModeName(ackMode);
+        report(name.str(), sessions * count, elapsed, stats, allocations);
+
+        for (int i = 0; i < sessions; ++i) {
+            tasks[i]->consumer->close();
+            delete tasks[i];
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ClientPathBenchmark::ClientPathBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ClientPathBenchmark::~ClientPathBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ClientPathBenchmark::testProducerPath() {
+
+    const int SIZES[] = { 256, 4096, 65536 };
+    const int SESSIONS[] = { 1, 4 };
+
+    std::cout << std::endl;
+
+    for (int size = 0; size < 3; ++size) {
+        int count = SIZES[size] > 4096 ? 2000 : 20000;
+        for (int persistent = 0; persistent < 2; ++persistent) {
+            for (int sessions = 0; sessions < 2; ++sessions) {
+                runProducerScenario(SIZES[size], persistent == 1, SESSIONS[sessions], count);
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ClientPathBenchmark::testProducerBatchPath() {
+
+    const int BATCHES[] = { 1, 10, 100 };
+
+    std::cout << std::endl;
+
+    runProducerScenario(256, false, 1, 20000);
+    for (int batch = 0; batch < 3; ++batch) {
+        runProducerScenario(256, false, 1, 20000, BATCHES[batch]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ClientPathBenchmark::testConsumerPath() {
+
+    const int SIZES[] = { 256, 4096 };
+    const int ACK_MODES[] = { cms::Session::AUTO_ACKNOWLEDGE,
+                              cms::Session::DUPS_OK_ACKNOWLEDGE,
+                              cms::Session::CLIENT_ACKNOWLEDGE,
+                              cms::Session::SESSION_TRANSACTED };
+    const int SESSIONS[] = { 1, 4 };
+
+    std::cout << std::endl;
+
+    for (int size = 0; size < 2; ++size) {
+        for (int ackMode = 0; ackMode < 4; ++ackMode) {
+            for (int sessions = 0; sessions < 2; ++sessions) {
+                runConsumerScenario(SIZES[size], ACK_MODES[ackMode], SESSIONS[sessions], 20000);
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_CLIENTPATHBENCHMARK_H_
+#define _ACTIVEMQ_CORE_CLIENTPATHBENCHMARK_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * End to end benchmark of the client send and receive paths.  The connection runs
+     * over the in-process mock transport so no broker is needed, every command the
+     * client emits is marshaled to OpenWire and every dispatch fed to a consumer is
+     * unmarshaled from OpenWire first, so the numbers include the codec cost but not
+     * the network.
+     *
+     * Each scenario prints its throughput in messages per second, the p50, p99 and
+     * p999 latency of the individual operations and the number of heap allocations
+     * made per message.
+     */
+    class ClientPathBenchmark : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( ClientPathBenchmark );
+        CPPUNIT_TEST( testProducerPath );
+        CPPUNIT_TEST( testProducerBatchPath );
+        CPPUNIT_TEST( testConsumerPath );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        ClientPathBenchmark();
+        virtual ~ClientPathBenchmark();
+
+        /**
+         * Times producer->send() across message sizes, delivery modes and session
+         * counts, one sending thread per session.
+         */
+        void testProducerPath();
+
+        /**
+         * Times ActiveMQProducer::sendBatch() of small non-persistent messages in
+         * batches of 1, 10 and 100 against single sends, each batch is one sample.
+         */
+        void testProducerBatchPath();
+
+        /**
+         * Times delivery from the arrival of the wire bytes to the consumer's message
+         * listener across message sizes, acknowledgement modes and session counts.
+         */
+        void testConsumerPath();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_CLIENTPATHBENCHMARK_H_ */
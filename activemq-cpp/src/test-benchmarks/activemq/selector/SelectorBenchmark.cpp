@@ -0,0 +1,211 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SelectorBenchmark.h"
+
+#include <benchmark/AllocationCounter.h>
+
+#include <activemq/cmsutil/DemuxConsumer.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/selector/Selector.h>
+#include <decaf/lang/System.h>
+
+#include <cms/Connection.h>
+#include <cms/MessageConsumer.h>
+#include <cms/Session.h>
+#include <cms/Topic.h>
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace benchmark;
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace activemq::commands;
+using namespace activemq::core;
+using namespace activemq::selector;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int WARMUP_EVALUATIONS = 10000;
+    const int TOTAL_EVALUATIONS = 1000000;
+    const int TOTAL_MESSAGES = 100000;
+    const int LISTENER_COUNT = 50;
+
+    const char* const REGIONS[] = {
+        "north", "south", "east", "west", "central", "emea", "apac", "latam", "nordic", "iberia"
+    };
+
+    void report(const std::string& name, const std::string& unit, int count, long long elapsed, int allocations) {
+
+        std::cout << std::left << std::setw(52) << name << std::right
+                  << std::setw(9) << std::fixed << std::setprecision(1) << (double) elapsed / count
+                  << " ns/" << unit << "  allocs/" << unit << "="
+                  << std::setprecision(2) << (double) allocations / count
+                  << std::endl;
+    }
+
+    void populate(ActiveMQTextMessage& message, const std::string& region) {
+        message.setText("payload");
+        message.setCMSType("order");
+        message.setCMSPriority(6);
+        message.setStringProperty("region", region);
+        message.setStringProperty("symbol", "IBM");
+        message.setStringProperty("account", "account-000123-retail-customer");
+        message.setIntProperty("priority", 7);
+        message.setIntProperty("quantity", 100);
+        message.setDoubleProperty("price", 12.5);
+    }
+
+    void evaluate(const std::string& name, const std::string& expression, bool expected) {
+
+        ActiveMQTextMessage message;
+        populate(message, "east");
+
+        Selector selector(expression);
+        CPPUNIT_ASSERT_EQUAL(expected, selector.matches(&message));
+
+        for (int i = 0; i < WARMUP_EVALUATIONS; ++i) {
+            selector.matches(&message);
+        }
+
+        int matched = 0;
+        AllocationCounter::reset();
+        long long begin = System::nanoTime();
+
+        for (int i = 0; i < TOTAL_EVALUATIONS; ++i) {
+            if (selector.matches(&message)) {
+                matched++;
+            }
+        }
+
+        long long elapsed = System::nanoTime() - begin;
+        int allocations = AllocationCounter::getCount();
+
+        CPPUNIT_ASSERT_EQUAL(expected ? TOTAL_EVALUATIONS : 0, matched);
+        report(name, "eval", TOTAL_EVALUATIONS, elapsed, allocations);
+    }
+
+    class CountingListener : public cms::MessageListener {
+    public:
+
+        long long count;
+
+        CountingListener() : count(0) {}
+        virtual ~CountingListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+            count++;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorBenchmark::SelectorBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectorBenchmark::~SelectorBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorBenchmark::testEvaluate() {
+
+    std::cout << std::endl;
+
+    evaluate("equality", "region = 'east'", true);
+    evaluate("compound", "region = 'east' AND priority > 5 AND JMSType = 'order'", true);
+    evaluate("compound short circuit", "region = 'west' AND priority > 5 AND JMSType = 'order'", false);
+    evaluate("like prefix", "symbol LIKE 'IB%'", true);
+    evaluate("like general", "account LIKE 'account-%-retail-%'", true);
+    evaluate("in", "region IN ('north', 'south', 'east', 'west', 'central')", true);
+    evaluate("arithmetic", "price * quantity > 1000 AND quantity BETWEEN 10 AND 1000", true);
+    evaluate("missing property", "missing = 1 OR missing IS NULL", true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorBenchmark::testDemux() {
+
+    ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+    std::auto_ptr<cms::Connection> connection(factory.createConnection());
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    std::auto_ptr<cms::Topic> topic(session->createTopic("BENCHMARK.SELECTOR"));
+    std::auto_ptr<cms::MessageConsumer> consumer(session->createConsumer(topic.get()));
+
+    std::vector<CountingListener> listeners(LISTENER_COUNT);
+    long long routes = 0;
+
+    {
+        DemuxConsumer demux(consumer.get());
+
+        // Ten regions with five priority bands each.
+        for (int i = 0; i < LISTENER_COUNT; ++i) {
+            std::ostringstream expression;
+            expression << "region = '" << REGIONS[i % 10] << "' AND priority > " << (i / 10) * 2;
+            demux.addListener(expression.str(), &listeners[i]);
+        }
+
+        std::vector<ActiveMQTextMessage*> messages;
+        for (int i = 0; i < 10; ++i) {
+            messages.push_back(new ActiveMQTextMessage());
+            populate(*messages.back(), REGIONS[i]);
+        }
+
+        for (int i = 0; i < WARMUP_EVALUATIONS; ++i) {
+            demux.onMessage(messages[i % 10]);
+        }
+
+        for (int i = 0; i < LISTENER_COUNT; ++i) {
+            listeners[i].count = 0;
+        }
+
+        AllocationCounter::reset();
+        long long begin = System::nanoTime();
+
+        for (int i = 0; i < TOTAL_MESSAGES; ++i) {
+            demux.onMessage(messages[i % 10]);
+        }
+
+        long long elapsed = System::nanoTime() - begin;
+        int allocations = AllocationCounter::getCount();
+
+        for (int i = 0; i < LISTENER_COUNT; ++i) {
+            routes += listeners[i].count;
+        }
+
+        std::ostringstream name;
+        name << "demux " << LISTENER_COUNT << " selectors, "
+             << std::fixed << std::setprecision(1) << (double) routes / TOTAL_MESSAGES << " deliveries/msg";
+        report(name.str(), "msg", TOTAL_MESSAGES, elapsed, allocations);
+
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            delete messages[i];
+        }
+    }
+
+    // priority 7 passes the bands 0, 2, 4 and 6 of its region.
+    CPPUNIT_ASSERT_EQUAL((long long) TOTAL_MESSAGES * 4, routes);
+
+    connection->close();
+}
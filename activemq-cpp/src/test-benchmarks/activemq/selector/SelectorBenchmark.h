@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _ACTIVEMQ_SELECTOR_SELECTORBENCHMARK_H_
+#define _ACTIVEMQ_SELECTOR_SELECTORBENCHMARK_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace selector {
+
+    /**
+     * Measures the client side selector engine.  Single selectors of the common
+     * shapes are evaluated against one message with a handful of properties, then a
+     * DemuxConsumer with fifty listeners routes messages the way a process sharing
+     * one topic subscription between many selectors would.
+     *
+     * Each scenario prints the time per evaluation, or per routed message, and the
+     * number of heap allocations made for each.
+     */
+    class SelectorBenchmark : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( SelectorBenchmark );
+        CPPUNIT_TEST( testEvaluate );
+        CPPUNIT_TEST( testDemux );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        SelectorBenchmark();
+        virtual ~SelectorBenchmark();
+
+        /**
+         * Times equality, compound, LIKE, IN and arithmetic selectors.
+         */
+        void testEvaluate();
+
+        /**
+         * Times routing messages through a DemuxConsumer with fifty selectors.
+         */
+        void testDemux();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_SELECTOR_SELECTORBENCHMARK_H_ */
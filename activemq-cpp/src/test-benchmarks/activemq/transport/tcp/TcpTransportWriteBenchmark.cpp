@@ -0,0 +1,178 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TcpTransportWriteBenchmark.h"
+
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <decaf/io/BufferedOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/net/ServerSocket.h>
+#include <decaf/net/Socket.h>
+#include <decaf/util/Properties.h>
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
+using namespace activemq::transport::tcp;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::net;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Same defaults TcpTransportFactory applies to a connection.
+    const int OUTPUT_BUFFER_SIZE = 8192;
+    const int DIRECT_WRITE_THRESHOLD = 8192;
+
+    const long long BYTES_PER_SIZE = 256LL * 1024 * 1024;
+
+    class Drain : public Runnable {
+    private:
+
+        Socket* socket;
+
+    public:
+
+        long long received;
+
+        Drain(Socket* socket) : socket(socket), received(0) {}
+
+        virtual ~Drain() {}
+
+        virtual void run() {
+            try {
+                std::vector<unsigned char> buffer(256 * 1024);
+                for (;;) {
+                    int count = socket->getInputStream()->read(&buffer[0], (int) buffer.size(), 0, (int) buffer.size());
+                    if (count == -1) {
+                        break;
+                    }
+                    received += count;
+                }
+            } catch (IOException& ex) {
+            }
+        }
+    };
+
+    Pointer<Command> createMessage(int bodySize) {
+
+        std::vector<unsigned char> payload(bodySize);
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = (unsigned char) (i * 31 + 7);
+        }
+
+        Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+        message->setContent(payload);
+        message->setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue("bench.transfers")));
+        message->setMessageId(Pointer<MessageId>(new MessageId(
+            Pointer<ProducerId>(new ProducerId("ID:bench-host-40123-1389041434210-0:1:1:1")), 1)));
+        message->setTimestamp(1389041434321LL);
+        message->setPersistent(true);
+
+        return message;
+    }
+
+    void run(int bodySize, int directWriteThreshold) {
+
+        MockTransport transport((Pointer<WireFormat>()), (Pointer<ResponseBuilder>()));
+
+        Properties properties;
+        OpenWireFormat format(properties);
+        format.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+
+        Pointer<Command> message = createMessage(bodySize);
+        int count = (int) (BYTES_PER_SIZE / bodySize);
+
+        ServerSocket server(0);
+        Socket client;
+        client.connect("127.0.0.1", server.getLocalPort());
+        std::auto_ptr<Socket> peer(server.accept());
+
+        Drain drain(peer.get());
+        Thread drainThread(&drain);
+        drainThread.start();
+
+        BufferedOutputStream buffered(client.getOutputStream(), OUTPUT_BUFFER_SIZE);
+        buffered.setDirectWriteThreshold(directWriteThreshold);
+        DataOutputStream output(&buffered);
+
+        long long begin = System::nanoTime();
+        for (int i = 0; i < count; ++i) {
+            format.marshal(message, &transport, &output);
+            output.flush();
+        }
+        client.shutdownOutput();
+        drainThread.join();
+        long long elapsed = System::nanoTime() - begin;
+
+        double megabytes = (double) drain.received / (1024.0 * 1024.0);
+        double seconds = (double) elapsed / 1000000000.0;
+
+        std::cout << std::setw(6) << bodySize / 1024 << " KB x " << std::setw(4) << count << "  "
+                  << std::fixed << std::setprecision(1) << std::setw(8) << megabytes / seconds << " MB/s"
+                  << std::endl;
+
+        client.close();
+        peer->close();
+    }
+
+    void runAll(int directWriteThreshold) {
+        std::cout << std::endl;
+        for (int size = 64 * 1024; size <= 16 * 1024 * 1024; size *= 4) {
+            run(size, directWriteThreshold);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TcpTransportWriteBenchmark::TcpTransportWriteBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TcpTransportWriteBenchmark::~TcpTransportWriteBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransportWriteBenchmark::testBufferedWrite() {
+    runAll(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransportWriteBenchmark::testGatheredWrite() {
+    runAll(DIRECT_WRITE_THRESHOLD);
+}
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_TCP_TCPTRANSPORTWRITEBENCHMARK_H_
+#define _ACTIVEMQ_TRANSPORT_TCP_TCPTRANSPORTWRITEBENCHMARK_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace transport {
+namespace tcp {
+
+    /**
+     * Measures the throughput of the TCP transport output path for bytes messages
+     * between 64KB and 16MB.  Each message is marshaled with OpenWire into the same
+     * stream stack TcpTransport builds over a loopback socket while a second thread
+     * drains the other end.
+     *
+     * The run is repeated with the body copied through the BufferedOutputStream and
+     * with it handed to the socket in a gathered write along with the header.
+     */
+    class TcpTransportWriteBenchmark : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( TcpTransportWriteBenchmark );
+        CPPUNIT_TEST( testBufferedWrite );
+        CPPUNIT_TEST( testGatheredWrite );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        TcpTransportWriteBenchmark();
+        virtual ~TcpTransportWriteBenchmark();
+
+        void testBufferedWrite();
+        void testGatheredWrite();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_TCP_TCPTRANSPORTWRITEBENCHMARK_H_ */
@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryUsageBenchmark.h"
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+const int MemoryUsageBenchmark::PRODUCER_COUNT = 16;
+const int MemoryUsageBenchmark::SENDS_PER_PRODUCER = 5000;
+const unsigned long long MemoryUsageBenchmark::MESSAGE_SIZE = 1024;
+const unsigned long long MemoryUsageBenchmark::WINDOW_SIZE = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ProducerRunner : public Runnable {
+    private:
+
+        ProducerRunner(const ProducerRunner&);
+        ProducerRunner& operator= (const ProducerRunner&);
+
+    private:
+
+        MemoryUsage* window;
+        int sends;
+        unsigned long long size;
+
+    public:
+
+        ProducerRunner(MemoryUsage* window, int sends, unsigned long long size) :
+            window(window), sends(sends), size(size) {}
+
+        virtual void run() {
+            for (int i = 0; i < sends; ++i) {
+                window->waitForSpace();
+                window->enqueueUsage(size);
+            }
+        }
+    };
+
+    class AckRunner : public Runnable {
+    private:
+
+        AckRunner(const AckRunner&);
+        AckRunner& operator= (const AckRunner&);
+
+    private:
+
+        MemoryUsage* window;
+        AtomicBoolean* done;
+
+    public:
+
+        AckRunner(MemoryUsage* window, AtomicBoolean* done) : window(window), done(done) {}
+
+        virtual void run() {
+            while (!done->get()) {
+                unsigned long long used = window->getUsage();
+                if (used > 0) {
+                    window->decreaseUsage(used);
+                } else {
+                    Thread::yield();
+                }
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsageBenchmark::MemoryUsageBenchmark() {}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsageBenchmark::~MemoryUsageBenchmark() {}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageBenchmark::run() {
+
+    MemoryUsage window(WINDOW_SIZE);
+    AtomicBoolean done(false);
+
+    AckRunner acker(&window, &done);
+    Thread ackThread(&acker);
+    ackThread.start();
+
+    std::vector<ProducerRunner*> producers;
+    std::vector<Thread*> threads;
+
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        producers.push_back(new ProducerRunner(&window, SENDS_PER_PRODUCER, MESSAGE_SIZE));
+        threads.push_back(new Thread(producers.back()));
+    }
+
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        threads[i]->start();
+    }
+
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        threads[i]->join();
+        delete threads[i];
+        delete producers[i];
+    }
+
+    done.set(true);
+    ackThread.join();
+}
@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_MEMORYUSAGEBENCHMARK_H_
+#define _ACTIVEMQ_UTIL_MEMORYUSAGEBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/util/MemoryUsage.h>
+
+namespace activemq{
+namespace util{
+
+    /**
+     * Contention benchmark for the producer window, many producer threads share a
+     * single MemoryUsage instance while one thread returns credit the way the
+     * ProducerAck handler does.
+     */
+    class MemoryUsageBenchmark :
+        public benchmark::BenchmarkBase<
+            activemq::util::MemoryUsageBenchmark, MemoryUsage, 10 >
+    {
+    private:
+
+        static const int PRODUCER_COUNT;
+        static const int SENDS_PER_PRODUCER;
+        static const unsigned long long MESSAGE_SIZE;
+        static const unsigned long long WINDOW_SIZE;
+
+    public:
+
+        MemoryUsageBenchmark();
+        virtual ~MemoryUsageBenchmark();
+
+        void run();
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_UTIL_MEMORYUSAGEBENCHMARK_H_*/
@@ -0,0 +1,216 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OpenWireFormatBenchmark.h"
+
+#include <benchmark/AllocationCounter.h>
+
+#include <activemq/core/ActiveMQConstants.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/Properties.h>
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace benchmark;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int WARMUP_COMMANDS = 20000;
+    const int TIMED_COMMANDS = 200000;
+
+    Pointer<ConsumerId> createConsumerId() {
+        Pointer<ConsumerId> consumerId(new ConsumerId());
+        consumerId->setConnectionId("ID:bench-host-40123-1389041434210-0:1");
+        consumerId->setSessionId(1);
+        consumerId->setValue(1);
+        return consumerId;
+    }
+
+    Pointer<MessageId> createMessageId(long long sequence) {
+        return Pointer<MessageId>(new MessageId(
+            Pointer<ProducerId>(new ProducerId("ID:bench-host-40123-1389041434210-0:1:1:1")), sequence));
+    }
+
+    Pointer<Command> createDispatch() {
+
+        Pointer<ActiveMQDestination> destination(new ActiveMQQueue("bench.orders.in"));
+
+        std::vector<unsigned char> payload(256);
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = (unsigned char) (i * 31 + 7);
+        }
+
+        Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+        message->setContent(payload);
+        message->setDestination(destination);
+        message->setMessageId(createMessageId(1));
+        message->setTimestamp(1389041434321LL);
+        message->setPriority(4);
+        message->setPersistent(true);
+        message->setCorrelationId("order-1001");
+        message->setStringProperty("region", "emea");
+        message->setIntProperty("attempt", 1);
+        message->setBooleanProperty("express", true);
+
+        Pointer<MessageDispatch> dispatch(new MessageDispatch());
+        dispatch->setConsumerId(createConsumerId());
+        dispatch->setDestination(destination);
+        dispatch->setMessage(message);
+        dispatch->setRedeliveryCounter(0);
+
+        return dispatch;
+    }
+
+    Pointer<Command> createTextMessage() {
+
+        Pointer<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+        message->setText("{\"order\":1001,\"sku\":\"A-113\",\"qty\":2}");
+        message->setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue("bench.orders.in")));
+        message->setMessageId(createMessageId(2));
+        message->setProducerId(message->getMessageId()->getProducerId());
+        message->setTimestamp(1389041434323LL);
+        message->setPriority(4);
+        message->setResponseRequired(false);
+
+        return message;
+    }
+
+    Pointer<Command> createAck() {
+
+        Pointer<MessageAck> ack(new MessageAck());
+        ack->setAckType(ActiveMQConstants::ACK_TYPE_CONSUMED);
+        ack->setConsumerId(createConsumerId());
+        ack->setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue("bench.orders.in")));
+        ack->setFirstMessageId(createMessageId(1));
+        ack->setLastMessageId(createMessageId(100));
+        ack->setMessageCount(100);
+
+        return ack;
+    }
+
+    void run(const std::string& name, const Pointer<Command>& command, bool tight) {
+
+        MockTransport transport((Pointer<WireFormat>()), (Pointer<ResponseBuilder>()));
+
+        // Negotiated as a current broker would, newest version and the requested encoding.
+        Properties properties;
+        OpenWireFormat format(properties);
+        format.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+        format.setTightEncodingEnabled(tight);
+
+        ByteArrayOutputStream bytes;
+        DataOutputStream output(&bytes);
+
+        for (int i = 0; i < WARMUP_COMMANDS; ++i) {
+            bytes.reset();
+            format.marshal(command, &transport, &output);
+        }
+
+        AllocationCounter::reset();
+        long long begin = System::nanoTime();
+        for (int i = 0; i < TIMED_COMMANDS; ++i) {
+            bytes.reset();
+            format.marshal(command, &transport, &output);
+        }
+        long long marshalTime = System::nanoTime() - begin;
+        int marshalAllocations = AllocationCounter::getCount();
+
+        std::pair<unsigned char*, int> array = bytes.toByteArray();
+        std::vector<unsigned char> encoded(array.first, array.first + array.second);
+        delete [] array.first;
+
+        ByteArrayInputStream source;
+        DataInputStream input(&source);
+
+        for (int i = 0; i < WARMUP_COMMANDS; ++i) {
+            source.setByteArray(&encoded[0], (int) encoded.size());
+            format.unmarshal(&transport, &input);
+        }
+
+        AllocationCounter::reset();
+        begin = System::nanoTime();
+        for (int i = 0; i < TIMED_COMMANDS; ++i) {
+            source.setByteArray(&encoded[0], (int) encoded.size());
+            format.unmarshal(&transport, &input);
+        }
+        long long unmarshalTime = System::nanoTime() - begin;
+        int unmarshalAllocations = AllocationCounter::getCount();
+
+        std::cout << std::left << std::setw(32) << name << std::right
+                  << std::setw(6) << encoded.size() << " bytes  "
+                  << "marshal " << std::setw(6) << marshalTime / TIMED_COMMANDS << " ns/cmd "
+                  << std::setw(3) << marshalAllocations / TIMED_COMMANDS << " allocs/cmd  "
+                  << "unmarshal " << std::setw(6) << unmarshalTime / TIMED_COMMANDS << " ns/cmd "
+                  << std::setw(3) << unmarshalAllocations / TIMED_COMMANDS << " allocs/cmd"
+                  << std::endl;
+    }
+
+    void runAll(bool tight) {
+        std::string encoding(tight ? " tight" : " loose");
+        std::cout << std::endl;
+        run("MessageDispatch" + encoding, createDispatch(), tight);
+        run("ActiveMQTextMessage" + encoding, createTextMessage(), tight);
+        run("MessageAck" + encoding, createAck(), tight);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenWireFormatBenchmark::OpenWireFormatBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenWireFormatBenchmark::~OpenWireFormatBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatBenchmark::testTightEncoding() {
+    runAll(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatBenchmark::testLooseEncoding() {
+    runAll(false);
+}
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFORMATBENCHMARK_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFORMATBENCHMARK_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+
+    /**
+     * Times OpenWireFormat::marshal and OpenWireFormat::unmarshal for the commands
+     * that dominate a busy connection: a MessageDispatch carrying a bytes message
+     * with a few properties, a bare text message as a producer sends it and the
+     * MessageAck that completes the exchange.
+     *
+     * Each command is run with tight and loose encoding and the average cost is
+     * printed in nanoseconds and heap allocations per command.
+     */
+    class OpenWireFormatBenchmark : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( OpenWireFormatBenchmark );
+        CPPUNIT_TEST( testTightEncoding );
+        CPPUNIT_TEST( testLooseEncoding );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        OpenWireFormatBenchmark();
+        virtual ~OpenWireFormatBenchmark();
+
+        void testTightEncoding();
+        void testLooseEncoding();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_OPENWIRE_OPENWIREFORMATBENCHMARK_H_ */
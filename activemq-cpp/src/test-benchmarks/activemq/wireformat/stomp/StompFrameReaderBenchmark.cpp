@@ -0,0 +1,293 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StompFrameReaderBenchmark.h"
+
+#include <activemq/wireformat/stomp/StompFrame.h>
+
+#include <decaf/io/BufferedInputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/Character.h>
+#include <decaf/lang/Integer.h>
+
+#include <string>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::stomp;
+using namespace decaf::io;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Hand built frames shaped like those an ActiveMQ broker sends to a STOMP client,
+    // a mix of receipts, short text messages without content-length and bytes messages.
+    const char* RECORDED_FRAMES[] = {
+        "RECEIPT\nreceipt-id:ID:client-42341-1389041434210-2:0:-1:1:1\n\n",
+        "MESSAGE\nmessage-id:ID:broker-1-60710-1389041420022-3:7:1:1:1\ndestination:/queue/orders.in\n"
+            "timestamp:1389041434321\nexpires:0\npriority:4\nsubscription:ID:client-42341-1389041434210-2:0:0:1\n"
+            "persistent:true\ncorrelation-id:order-1001\n\n{\"order\":1001,\"sku\":\"A-113\",\"qty\":2}",
+        "MESSAGE\nmessage-id:ID:broker-1-60710-1389041420022-3:7:1:1:2\ndestination:/topic/prices.EURUSD\n"
+            "timestamp:1389041434323\nexpires:1389041494323\npriority:4\nsubscription:ID:client-42341-1389041434210-2:0:0:2\n"
+            "type:price\nJMSXGroupID:EURUSD\n\n1.3612",
+        "MESSAGE\nmessage-id:ID:broker-1-60710-1389041420022-3:7:1:1:3\ndestination:/queue/orders.in\n"
+            "timestamp:1389041434330\nexpires:0\npriority:4\nsubscription:ID:client-42341-1389041434210-2:0:0:1\n"
+            "reply-to:/temp-queue/ID:client-42341-1389041434210-2:0:1\nshipping:express\nregion:emea\n\n"
+            "{\"order\":1002,\"sku\":\"B-7\",\"qty\":10,\"note\":\"leave at reception\"}",
+        "RECEIPT\nreceipt-id:ID:client-42341-1389041434210-2:0:-1:1:2\n\n"
+    };
+
+    const int RECORDED_FRAME_COUNT = (int) (sizeof(RECORDED_FRAMES) / sizeof(RECORDED_FRAMES[0]));
+
+    const int CORPUS_REPETITIONS = 2000;
+
+    int buildCorpus(std::vector<unsigned char>& corpus) {
+
+        std::string binaryBody(700, 'b');
+        for (std::size_t i = 0; i < binaryBody.size(); i += 7) {
+            binaryBody[i] = '\0';
+        }
+
+        std::string bytesFrame("MESSAGE\nmessage-id:ID:broker-1-60710-1389041420022-3:7:1:1:4\n"
+            "destination:/queue/blobs\ntimestamp:1389041434340\nexpires:0\npriority:4\n"
+            "subscription:ID:client-42341-1389041434210-2:0:0:3\ncontent-length:700\n\n");
+        bytesFrame.append(binaryBody);
+
+        int count = 0;
+        for (int i = 0; i < CORPUS_REPETITIONS; ++i) {
+            for (int j = 0; j < RECORDED_FRAME_COUNT; ++j) {
+                std::string frame(RECORDED_FRAMES[j]);
+                corpus.insert(corpus.end(), frame.begin(), frame.end());
+                corpus.push_back('\0');
+                corpus.push_back('\n');
+                count++;
+            }
+
+            corpus.insert(corpus.end(), bytesFrame.begin(), bytesFrame.end());
+            corpus.push_back('\0');
+            corpus.push_back('\n');
+            count++;
+        }
+
+        return count;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameReaderBenchmark::StompFrameReaderBenchmark() : corpus(), frameCount(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameReaderBenchmark::~StompFrameReaderBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderBenchmark::setUp() {
+    this->frameCount = buildCorpus(this->corpus);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderBenchmark::run() {
+
+    ByteArrayInputStream bytes(this->corpus);
+    BufferedInputStream buffered(&bytes);
+    DataInputStream input(&buffered);
+
+    StompFrameReader reader;
+
+    for (int i = 0; i < this->frameCount; ++i) {
+        StompFrame frame;
+        reader.readFrame(frame, &input);
+        frame.getProperty("destination");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameFromStreamBenchmark::StompFrameFromStreamBenchmark() : corpus(), frameCount(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameFromStreamBenchmark::~StompFrameFromStreamBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameFromStreamBenchmark::setUp() {
+    this->frameCount = buildCorpus(this->corpus);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameFromStreamBenchmark::run() {
+
+    ByteArrayInputStream bytes(this->corpus);
+    BufferedInputStream buffered(&bytes);
+    DataInputStream input(&buffered);
+
+    for (int i = 0; i < this->frameCount; ++i) {
+        StompFrame frame;
+        frame.fromStream(&input);
+        frame.getProperty("destination");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LegacyStompFrameParser::readFrame(StompFrame& frame, DataInputStream* in) {
+    readCommandHeader(frame, in);
+    readHeaders(frame, in);
+    readBody(frame, in);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LegacyStompFrameParser::readCommandHeader(StompFrame& frame, DataInputStream* in) {
+
+    std::vector<unsigned char> buffer;
+
+    while (true) {
+
+        // The command header is formatted just like any other stomp header.
+        readHeaderLine(buffer, in);
+
+        // Ignore all white space before the command.
+        long long offset = -1;
+        for (size_t ix = 0; ix < buffer.size() - 1; ++ix) {
+            if (!Character::isWhitespace(buffer[ix])) {
+                offset = (long long) ix;
+                break;
+            }
+        }
+
+        if (offset >= 0) {
+            frame.setCommand(reinterpret_cast<char*>(&buffer[(size_t) offset]));
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LegacyStompFrameParser::readHeaders(StompFrame& frame, DataInputStream* in) {
+
+    std::vector<unsigned char> buffer;
+
+    while (true) {
+
+        std::size_t numChars = readHeaderLine(buffer, in);
+
+        // An empty line ends the header section.
+        if (numChars == 1 && buffer[0] == '\0') {
+            break;
+        }
+
+        for (size_t ix = 0; ix < buffer.size(); ++ix) {
+            if (buffer[ix] == ':') {
+                buffer[ix] = '\0';
+
+                const char* key = reinterpret_cast<char*>(&buffer[0]);
+                const char* value = reinterpret_cast<char*>(&buffer[ix + 1]);
+
+                if (!frame.getProperties().hasProperty(key)) {
+                    frame.getProperties().setProperty(key, value);
+                }
+                break;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t LegacyStompFrameParser::readHeaderLine(std::vector<unsigned char>& buffer, DataInputStream* in) {
+
+    buffer.clear();
+
+    std::size_t count = 0;
+
+    while (true) {
+
+        buffer.push_back(in->readByte());
+        count++;
+
+        if (buffer[count - 1] == '\n') {
+            buffer[count - 1] = '\0';
+            return count;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LegacyStompFrameParser::readBody(StompFrame& frame, DataInputStream* in) {
+
+    std::vector<unsigned char>& body = frame.getBody();
+    body.clear();
+
+    unsigned int contentLength = 0;
+
+    if (frame.hasProperty("content-length")) {
+        contentLength = (unsigned int) Integer::parseInt(frame.getProperty("content-length"));
+    }
+
+    if (contentLength != 0) {
+
+        body.resize((std::size_t) contentLength);
+        in->readFully(&body[0], (int) body.size());
+
+        if (in->readByte() != '\0') {
+            throw IOException(__FILE__, __LINE__, "Read Content Length, and no trailing null");
+        }
+
+    } else {
+
+        // No content length, read until the first null.
+        while (true) {
+            char byte = in->readByte();
+            body.push_back(byte);
+            if (byte == '\0') {
+                break;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameLegacyParserBenchmark::StompFrameLegacyParserBenchmark() : corpus(), frameCount(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameLegacyParserBenchmark::~StompFrameLegacyParserBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameLegacyParserBenchmark::setUp() {
+    this->frameCount = buildCorpus(this->corpus);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameLegacyParserBenchmark::run() {
+
+    ByteArrayInputStream bytes(this->corpus);
+    BufferedInputStream buffered(&bytes);
+    DataInputStream input(&buffered);
+
+    LegacyStompFrameParser parser;
+
+    for (int i = 0; i < this->frameCount; ++i) {
+        StompFrame frame;
+        parser.readFrame(frame, &input);
+        frame.getProperty("destination");
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEREADERBENCHMARK_H_
+#define _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEREADERBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/wireformat/stomp/StompFrameReader.h>
+#include <activemq/wireformat/stomp/StompFrame.h>
+#include <decaf/io/DataInputStream.h>
+
+#include <vector>
+
+namespace activemq {
+namespace wireformat {
+namespace stomp {
+
+    /**
+     * Parses a corpus of hand built Stomp frames shaped like a broker's output, once
+     * with the bulk scanning StompFrameReader used by the wire format, once through
+     * the non read ahead StompFrame::fromStream path and once with the byte at a time
+     * parser StompFrame used before the reader was added, as a baseline.
+     */
+    class StompFrameReaderBenchmark :
+        public benchmark::BenchmarkBase<
+            activemq::wireformat::stomp::StompFrameReaderBenchmark, StompFrameReader, 20 >
+    {
+    private:
+
+        std::vector<unsigned char> corpus;
+        int frameCount;
+
+    public:
+
+        StompFrameReaderBenchmark();
+        virtual ~StompFrameReaderBenchmark();
+
+        virtual void setUp();
+        virtual void run();
+
+    };
+
+    class StompFrameFromStreamBenchmark :
+        public benchmark::BenchmarkBase<
+            activemq::wireformat::stomp::StompFrameFromStreamBenchmark, StompFrame, 20 >
+    {
+    private:
+
+        std::vector<unsigned char> corpus;
+        int frameCount;
+
+    public:
+
+        StompFrameFromStreamBenchmark();
+        virtual ~StompFrameFromStreamBenchmark();
+
+        virtual void setUp();
+        virtual void run();
+
+    };
+
+    /**
+     * The byte at a time parse that StompFrame::fromStream did before StompFrameReader,
+     * kept here as the baseline for the reader benchmarks.
+     */
+    class LegacyStompFrameParser {
+    public:
+
+        void readFrame(StompFrame& frame, decaf::io::DataInputStream* in);
+
+    private:
+
+        void readCommandHeader(StompFrame& frame, decaf::io::DataInputStream* in);
+        void readHeaders(StompFrame& frame, decaf::io::DataInputStream* in);
+        std::size_t readHeaderLine(std::vector<unsigned char>& buffer, decaf::io::DataInputStream* in);
+        void readBody(StompFrame& frame, decaf::io::DataInputStream* in);
+
+    };
+
+    class StompFrameLegacyParserBenchmark :
+        public benchmark::BenchmarkBase<
+            activemq::wireformat::stomp::StompFrameLegacyParserBenchmark, LegacyStompFrameParser, 20 >
+    {
+    private:
+
+        std::vector<unsigned char> corpus;
+        int frameCount;
+
+    public:
+
+        StompFrameLegacyParserBenchmark();
+        virtual ~StompFrameLegacyParserBenchmark();
+
+        virtual void setUp();
+        virtual void run();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEREADERBENCHMARK_H_ */
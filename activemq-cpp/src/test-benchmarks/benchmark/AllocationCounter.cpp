@@ -0,0 +1,79 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AllocationCounter.h"
+
+#include <decaf/internal/util/concurrent/Atomics.h>
+
+#include <cstdlib>
+#include <new>
+
+using namespace benchmark;
+using namespace decaf::internal::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    volatile int allocations = 0;
+
+    void* countedAllocate(std::size_t size) {
+
+        AllocationCounter::increment();
+
+        void* memory = std::malloc(size == 0 ? 1 : size);
+        if (memory == NULL) {
+            throw std::bad_alloc();
+        }
+
+        return memory;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AllocationCounter::getCount() {
+    return Atomics::getAndAdd(&allocations, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AllocationCounter::reset() {
+    Atomics::getAndSet(&allocations, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AllocationCounter::increment() {
+    Atomics::incrementAndGet(&allocations);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new(std::size_t size) throw(std::bad_alloc) {
+    return countedAllocate(size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new[](std::size_t size) throw(std::bad_alloc) {
+    return countedAllocate(size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void* memory) throw() {
+    std::free(memory);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete[](void* memory) throw() {
+    std::free(memory);
+}
@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _BENCHMARK_ALLOCATIONCOUNTER_H_
+#define _BENCHMARK_ALLOCATIONCOUNTER_H_
+
+#include <activemq/util/Config.h>
+
+namespace benchmark{
+
+    /**
+     * Counts calls to the global operator new made anywhere in the benchmark process.
+     * The benchmark binary replaces the global allocation operators with versions that
+     * bump this counter before calling malloc, so the count covers the library as well
+     * as the benchmark code.  Read the count before and after the measured section and
+     * divide by the number of operations to get allocations per operation.
+     */
+    class AllocationCounter {
+    private:
+
+        AllocationCounter();
+        AllocationCounter(const AllocationCounter&);
+        AllocationCounter& operator=(const AllocationCounter&);
+
+    public:
+
+        /**
+         * @return the number of allocations made since the counter was last reset.
+         */
+        static int getCount();
+
+        /**
+         * Sets the count back to zero.
+         */
+        static void reset();
+
+        /**
+         * Called by the replaced allocation operators.
+         */
+        static void increment();
+
+    };
+
+}
+
+#endif /*_BENCHMARK_ALLOCATIONCOUNTER_H_*/
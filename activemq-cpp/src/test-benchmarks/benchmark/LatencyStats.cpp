@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+using namespace benchmark;
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyStats::LatencyStats() : samples(), sorted(true) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyStats::~LatencyStats() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyStats::reserve(int count) {
+    this->samples.reserve(count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyStats::add(long long nanos) {
+    this->samples.push_back(nanos);
+    this->sorted = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyStats::addAll(const LatencyStats& other) {
+    this->samples.insert(this->samples.end(), other.samples.begin(), other.samples.end());
+    this->sorted = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyStats::reset() {
+    this->samples.clear();
+    this->sorted = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LatencyStats::getPercentile(double percentile) {
+
+    if (this->samples.empty()) {
+        return 0;
+    }
+
+    if (!this->sorted) {
+        std::sort(this->samples.begin(), this->samples.end());
+        this->sorted = true;
+    }
+
+    std::size_t rank = (std::size_t) std::ceil(percentile / 100.0 * (double) this->samples.size());
+    if (rank < 1) {
+        rank = 1;
+    } else if (rank > this->samples.size()) {
+        rank = this->samples.size();
+    }
+
+    return this->samples[rank - 1];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string LatencyStats::toString() {
+
+    char buffer[128];
+    ::snprintf(buffer, sizeof(buffer), "p50=%.1fus p99=%.1fus p999=%.1fus",
+               (double) getPercentile(50.0) / 1000.0,
+               (double) getPercentile(99.0) / 1000.0,
+               (double) getPercentile(99.9) / 1000.0);
+
+    return std::string(buffer);
+}
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _BENCHMARK_LATENCYSTATS_H_
+#define _BENCHMARK_LATENCYSTATS_H_
+
+#include <activemq/util/Config.h>
+#include <vector>
+#include <string>
+
+namespace benchmark{
+
+    /**
+     * Collects individual latency samples in nanoseconds and reports percentiles over
+     * them.  Samples are kept in full so that the tail percentiles are exact, callers
+     * should reserve room for the expected number up front to keep the recording cheap.
+     */
+    class LatencyStats {
+    private:
+
+        std::vector<long long> samples;
+        bool sorted;
+
+    public:
+
+        LatencyStats();
+        virtual ~LatencyStats();
+
+        /**
+         * Reserves room for the given number of samples.
+         */
+        void reserve(int count);
+
+        /**
+         * Records one sample.
+         *
+         * @param nanos
+         *      The measured latency in nanoseconds.
+         */
+        void add(long long nanos);
+
+        /**
+         * Adds all the samples held by another instance to this one.
+         */
+        void addAll(const LatencyStats& other);
+
+        /**
+         * Throws away all recorded samples.
+         */
+        void reset();
+
+        int size() const {
+            return (int) this->samples.size();
+        }
+
+        /**
+         * Gets the sample at the given percentile using the nearest rank method.
+         *
+         * @param percentile
+         *      The percentile to return, in the range (0, 100].
+         *
+         * @return the sample in nanoseconds, or zero if there are no samples.
+         */
+        long long getPercentile(double percentile);
+
+        /**
+         * @return a summary of the form "p50=... p99=... p999=..." in microseconds.
+         */
+        std::string toString();
+
+    };
+
+}
+
+#endif /*_BENCHMARK_LATENCYSTATS_H_*/
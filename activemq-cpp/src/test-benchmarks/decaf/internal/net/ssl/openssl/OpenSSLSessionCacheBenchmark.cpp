@@ -0,0 +1,327 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OpenSSLSessionCacheBenchmark.h"
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/net/Socket.h>
+#include <decaf/net/ssl/SSLSocket.h>
+#include <decaf/net/ssl/SSLSocketFactory.h>
+#include <decaf/internal/net/tcp/TcpSocket.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+
+#ifdef HAVE_OPENSSL
+#include <openssl/ssl.h>
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+#endif
+
+#include <memory>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::net;
+using namespace decaf::net::ssl;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::internal;
+using namespace decaf::internal::net;
+using namespace decaf::internal::net::tcp;
+using namespace decaf::internal::net::ssl;
+using namespace decaf::internal::net::ssl::openssl;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace internal {
+namespace net {
+namespace ssl {
+namespace openssl {
+
+    /**
+     * Minimal TLS server built directly on OpenSSL, it accepts one connection at a
+     * time, sends a single byte once the handshake completes so that the client also
+     * receives any session tickets, and waits for the client to disconnect.
+     */
+    class HandshakeServer : public Runnable {
+    private:
+
+        AtomicBoolean running;
+        int port;
+        Thread* thread;
+
+#ifdef HAVE_OPENSSL
+        SSL_CTX* context;
+        BIO* acceptor;
+#endif
+
+    private:
+
+        HandshakeServer(const HandshakeServer&);
+        HandshakeServer& operator=(const HandshakeServer&);
+
+    public:
+
+        HandshakeServer() : Runnable(), running(false), port(0), thread(NULL)
+#ifdef HAVE_OPENSSL
+                          , context(NULL), acceptor(NULL)
+#endif
+        {
+        }
+
+        virtual ~HandshakeServer() {
+            try {
+                stop();
+            } catch (...) {
+            }
+        }
+
+        int getPort() const {
+            return this->port;
+        }
+
+        void start() {
+
+#ifdef HAVE_OPENSSL
+            this->context = SSL_CTX_new(SSLv23_server_method());
+            createCertificate(this->context);
+            SSL_CTX_set_session_cache_mode(this->context, SSL_SESS_CACHE_SERVER);
+            SSL_CTX_set_session_id_context(this->context, (const unsigned char*) "benchmark", 9);
+
+            this->acceptor = BIO_new_accept((char*) "127.0.0.1:0");
+            if (this->acceptor == NULL || BIO_do_accept(this->acceptor) <= 0) {
+                throw IllegalStateException(__FILE__, __LINE__, "Failed to bind the benchmark server.");
+            }
+
+            this->port = Integer::parseInt(BIO_get_accept_port(this->acceptor));
+#endif
+
+            this->running.set(true);
+            this->thread = new Thread(this, "OpenSSL Benchmark Server");
+            this->thread->start();
+        }
+
+        void stop() {
+
+            if (this->thread == NULL) {
+                return;
+            }
+
+            this->running.set(false);
+
+            // Wake up the accept call with a plain connection.
+            try {
+                TcpSocket waker;
+                waker.create();
+                waker.connect("127.0.0.1", this->port, 1000);
+                waker.close();
+            } catch (...) {
+            }
+
+            this->thread->join();
+            delete this->thread;
+            this->thread = NULL;
+
+#ifdef HAVE_OPENSSL
+            BIO_free_all(this->acceptor);
+            SSL_CTX_free(this->context);
+            this->acceptor = NULL;
+            this->context = NULL;
+#endif
+        }
+
+        virtual void run() {
+
+#ifdef HAVE_OPENSSL
+            while (this->running.get()) {
+
+                if (BIO_do_accept(this->acceptor) <= 0) {
+                    break;
+                }
+
+                BIO* client = BIO_pop(this->acceptor);
+                if (!this->running.get()) {
+                    BIO_free_all(client);
+                    break;
+                }
+
+                // The ticket and data records are small, don't let Nagle hold them back.
+                int fd = -1;
+                BIO_get_fd(client, &fd);
+                BIO_set_tcp_ndelay(fd, 1);
+
+                SSL* ssl = SSL_new(this->context);
+                SSL_set_bio(ssl, client, client);
+
+                if (SSL_accept(ssl) == 1) {
+                    unsigned char byte = 1;
+                    SSL_write(ssl, &byte, 1);
+
+                    unsigned char buffer[64];
+                    while (SSL_read(ssl, buffer, (int) sizeof(buffer)) > 0) {
+                    }
+                }
+
+                SSL_free(ssl);
+            }
+#endif
+        }
+
+    private:
+
+#ifdef HAVE_OPENSSL
+        // Generates a throw away RSA key and self signed certificate for the server.
+        static void createCertificate(SSL_CTX* context) {
+
+            EVP_PKEY* key = NULL;
+            EVP_PKEY_CTX* keyContext = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, NULL);
+            EVP_PKEY_keygen_init(keyContext);
+            EVP_PKEY_CTX_set_rsa_keygen_bits(keyContext, 2048);
+            EVP_PKEY_keygen(keyContext, &key);
+            EVP_PKEY_CTX_free(keyContext);
+
+            X509* certificate = X509_new();
+            X509_set_version(certificate, 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+            X509_gmtime_adj(X509_get_notBefore(certificate), 0);
+            X509_gmtime_adj(X509_get_notAfter(certificate), 3600);
+            X509_set_pubkey(certificate, key);
+
+            X509_NAME* name = X509_get_subject_name(certificate);
+            X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char*) "localhost", -1, -1, 0);
+            X509_set_issuer_name(certificate, name);
+            X509_sign(certificate, key, EVP_sha256());
+
+            SSL_CTX_use_certificate(context, certificate);
+            SSL_CTX_use_PrivateKey(context, key);
+
+            X509_free(certificate);
+            EVP_PKEY_free(key);
+        }
+#endif
+
+    };
+
+}}}}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int CONNECTIONS = 50;
+
+    void connectClients(int port) {
+
+        SocketFactory* factory = SSLSocketFactory::getDefault();
+
+        for (int i = 0; i < CONNECTIONS; ++i) {
+
+            std::auto_ptr<Socket> socket(factory->createSocket());
+            socket->setTcpNoDelay(true);
+            socket->connect("127.0.0.1", port, 1000);
+
+            SSLSocket* sslSocket = dynamic_cast<SSLSocket*>(socket.get());
+            sslSocket->startHandshake();
+
+            socket->getInputStream()->read();
+            socket->close();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLSessionCacheBenchmark::OpenSSLSessionCacheBenchmark() :
+    server(NULL), disableResumption(), disablePeerVerification() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLSessionCacheBenchmark::~OpenSSLSessionCacheBenchmark() {
+    delete this->server;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSessionCacheBenchmark::setUp() {
+
+    this->disableResumption = System::getProperty("decaf.net.ssl.disableSessionResumption", "false");
+    this->disablePeerVerification = System::getProperty("decaf.net.ssl.disablePeerVerification", "false");
+
+    System::setProperty("decaf.net.ssl.disableSessionResumption", "false");
+    System::setProperty("decaf.net.ssl.disablePeerVerification", "true");
+
+    this->server = new HandshakeServer();
+    this->server->start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSessionCacheBenchmark::tearDown() {
+
+    this->server->stop();
+    delete this->server;
+    this->server = NULL;
+
+    System::setProperty("decaf.net.ssl.disableSessionResumption", this->disableResumption);
+    System::setProperty("decaf.net.ssl.disablePeerVerification", this->disablePeerVerification);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSessionCacheBenchmark::run() {
+    connectClients(this->server->getPort());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLFullHandshakeBenchmark::OpenSSLFullHandshakeBenchmark() :
+    server(NULL), disableResumption(), disablePeerVerification() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLFullHandshakeBenchmark::~OpenSSLFullHandshakeBenchmark() {
+    delete this->server;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLFullHandshakeBenchmark::setUp() {
+
+    this->disableResumption = System::getProperty("decaf.net.ssl.disableSessionResumption", "false");
+    this->disablePeerVerification = System::getProperty("decaf.net.ssl.disablePeerVerification", "false");
+
+    System::setProperty("decaf.net.ssl.disableSessionResumption", "true");
+    System::setProperty("decaf.net.ssl.disablePeerVerification", "true");
+
+    this->server = new HandshakeServer();
+    this->server->start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLFullHandshakeBenchmark::tearDown() {
+
+    this->server->stop();
+    delete this->server;
+    this->server = NULL;
+
+    System::setProperty("decaf.net.ssl.disableSessionResumption", this->disableResumption);
+    System::setProperty("decaf.net.ssl.disablePeerVerification", this->disablePeerVerification);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLFullHandshakeBenchmark::run() {
+    connectClients(this->server->getPort());
+}
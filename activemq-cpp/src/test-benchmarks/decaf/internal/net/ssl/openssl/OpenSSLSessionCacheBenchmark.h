@@ -0,0 +1,96 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSESSIONCACHEBENCHMARK_H_
+#define _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSESSIONCACHEBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <decaf/internal/net/ssl/openssl/OpenSSLSocket.h>
+#include <decaf/internal/net/ssl/openssl/OpenSSLSessionCache.h>
+
+#include <string>
+
+namespace decaf {
+namespace internal {
+namespace net {
+namespace ssl {
+namespace openssl {
+
+    class HandshakeServer;
+
+    /**
+     * Measures the cost of reconnecting SSL client sockets to a local OpenSSL server
+     * stand-in.  The first benchmark lets the client resume the cached session of the
+     * previous connection, the second disables resumption so that every connect pays
+     * for a full handshake.
+     */
+    class OpenSSLSessionCacheBenchmark :
+        public benchmark::BenchmarkBase<
+            decaf::internal::net::ssl::openssl::OpenSSLSessionCacheBenchmark, OpenSSLSessionCache, 5 >
+    {
+    private:
+
+        HandshakeServer* server;
+        std::string disableResumption;
+        std::string disablePeerVerification;
+
+    private:
+
+        OpenSSLSessionCacheBenchmark(const OpenSSLSessionCacheBenchmark&);
+        OpenSSLSessionCacheBenchmark& operator=(const OpenSSLSessionCacheBenchmark&);
+
+    public:
+
+        OpenSSLSessionCacheBenchmark();
+        virtual ~OpenSSLSessionCacheBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+    class OpenSSLFullHandshakeBenchmark :
+        public benchmark::BenchmarkBase<
+            decaf::internal::net::ssl::openssl::OpenSSLFullHandshakeBenchmark, OpenSSLSocket, 5 >
+    {
+    private:
+
+        HandshakeServer* server;
+        std::string disableResumption;
+        std::string disablePeerVerification;
+
+    private:
+
+        OpenSSLFullHandshakeBenchmark(const OpenSSLFullHandshakeBenchmark&);
+        OpenSSLFullHandshakeBenchmark& operator=(const OpenSSLFullHandshakeBenchmark&);
+
+    public:
+
+        OpenSSLFullHandshakeBenchmark();
+        virtual ~OpenSSLFullHandshakeBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+
+    };
+
+}}}}}
+
+#endif /* _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSESSIONCACHEBENCHMARK_H_ */
@@ -0,0 +1,145 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ModifiedUTF8Benchmark.h"
+
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const std::size_t PAYLOAD_SIZE = 256 * 1024;
+    const std::size_t UTF_STRING_SIZE = 16 * 1024;
+    const int CODEC_LOOPS = 20;
+    const int STREAM_LOOPS = 100;
+
+    const char LATIN1_CHARS[] = { (char) 0xE9, (char) 0xE8, (char) 0xFC, (char) 0xF6, (char) 0xE4, (char) 0xDF, (char) 0xC7 };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ModifiedUTF8Workload::ModifiedUTF8Workload() : chars(), encoded(), decoded(), utfString(), produced(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Workload::setUp(bool mixed) {
+
+    const std::string text = "The quick brown fox jumps over the lazy dog. ";
+
+    chars.resize(PAYLOAD_SIZE);
+    for (std::size_t i = 0; i < PAYLOAD_SIZE; ++i) {
+        if (mixed && i % 8 == 5) {
+            chars[i] = (unsigned char) LATIN1_CHARS[(i / 8) % sizeof(LATIN1_CHARS)];
+        } else {
+            chars[i] = (unsigned char) text[i % text.length()];
+        }
+    }
+
+    encoded.resize(PAYLOAD_SIZE * 2);
+    decoded.resize(PAYLOAD_SIZE * 2);
+    utfString.assign((const char*) &chars[0], UTF_STRING_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Workload::run() {
+
+    std::size_t total = 0;
+
+    for (int i = 0; i < CODEC_LOOPS; ++i) {
+        total += ModifiedUTF8::encodedLength(&chars[0], chars.size());
+        std::size_t length = ModifiedUTF8::encode(&chars[0], chars.size(), &encoded[0]);
+        total += ModifiedUTF8::decode(&encoded[0], length, &decoded[0]);
+    }
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut(&bytesOut);
+
+    for (int i = 0; i < STREAM_LOOPS; ++i) {
+        dataOut.writeUTF(utfString);
+    }
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    ByteArrayInputStream bytesIn(array.first, array.second, true);
+    DataInputStream dataIn(&bytesIn);
+
+    for (int i = 0; i < STREAM_LOOPS; ++i) {
+        total += dataIn.readUTF().length();
+    }
+
+    // Keeps the results live so the loops can't be optimized away.
+    produced = total;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8AsciiBenchmark::setUp() {
+    workload.setUp(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8AsciiBenchmark::run() {
+    workload.run();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8MixedBenchmark::setUp() {
+    workload.setUp(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8MixedBenchmark::run() {
+    workload.run();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8ScalarAsciiBenchmark::setUp() {
+    ModifiedUTF8::setAccelerationEnabled(false);
+    workload.setUp(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8ScalarAsciiBenchmark::tearDown() {
+    ModifiedUTF8::setAccelerationEnabled(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8ScalarAsciiBenchmark::run() {
+    workload.run();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8ScalarMixedBenchmark::setUp() {
+    ModifiedUTF8::setAccelerationEnabled(false);
+    workload.setUp(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8ScalarMixedBenchmark::tearDown() {
+    ModifiedUTF8::setAccelerationEnabled(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8ScalarMixedBenchmark::run() {
+    workload.run();
+}
@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_UTIL_MODIFIEDUTF8BENCHMARK_H_
+#define _DECAF_INTERNAL_UTIL_MODIFIEDUTF8BENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <decaf/internal/util/ModifiedUTF8.h>
+
+#include <string>
+#include <vector>
+
+namespace decaf {
+namespace internal {
+namespace util {
+
+    /**
+     * Payload and loop shared by the modified UTF-8 benchmarks.  Each run encodes and
+     * decodes a large buffer through the codec directly, then round trips a string
+     * through DataOutputStream::writeUTF and DataInputStream::readUTF as the wire
+     * format does.
+     */
+    class ModifiedUTF8Workload {
+    private:
+
+        std::vector<unsigned char> chars;
+        std::vector<unsigned char> encoded;
+        std::vector<unsigned char> decoded;
+        std::string utfString;
+        volatile std::size_t produced;
+
+    public:
+
+        ModifiedUTF8Workload();
+
+        /**
+         * @param mixed
+         *      When true about one char in eight needs the two byte form, otherwise
+         *      the payload is plain ASCII.
+         */
+        void setUp(bool mixed);
+
+        void run();
+
+    };
+
+    class ModifiedUTF8AsciiBenchmark :
+        public benchmark::BenchmarkBase<
+            decaf::internal::util::ModifiedUTF8AsciiBenchmark, ModifiedUTF8AsciiBenchmark >
+    {
+    private:
+
+        ModifiedUTF8Workload workload;
+
+    public:
+
+        ModifiedUTF8AsciiBenchmark() : workload() {}
+        virtual ~ModifiedUTF8AsciiBenchmark() {}
+
+        virtual void setUp();
+        virtual void run();
+    };
+
+    class ModifiedUTF8MixedBenchmark :
+        public benchmark::BenchmarkBase<
+            decaf::internal::util::ModifiedUTF8MixedBenchmark, ModifiedUTF8MixedBenchmark >
+    {
+    private:
+
+        ModifiedUTF8Workload workload;
+
+    public:
+
+        ModifiedUTF8MixedBenchmark() : workload() {}
+        virtual ~ModifiedUTF8MixedBenchmark() {}
+
+        virtual void setUp();
+        virtual void run();
+    };
+
+    /**
+     * Same as ModifiedUTF8AsciiBenchmark with the vectorized scans disabled, for
+     * comparing against the scalar fallback.
+     */
+    class ModifiedUTF8ScalarAsciiBenchmark :
+        public benchmark::BenchmarkBase<
+            decaf::internal::util::ModifiedUTF8ScalarAsciiBenchmark, ModifiedUTF8ScalarAsciiBenchmark >
+    {
+    private:
+
+        ModifiedUTF8Workload workload;
+
+    public:
+
+        ModifiedUTF8ScalarAsciiBenchmark() : workload() {}
+        virtual ~ModifiedUTF8ScalarAsciiBenchmark() {}
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+    };
+
+    /**
+     * Same as ModifiedUTF8MixedBenchmark with the vectorized scans disabled, for
+     * comparing against the scalar fallback.
+     */
+    class ModifiedUTF8ScalarMixedBenchmark :
+        public benchmark::BenchmarkBase<
+            decaf::internal::util::ModifiedUTF8ScalarMixedBenchmark, ModifiedUTF8ScalarMixedBenchmark >
+    {
+    private:
+
+        ModifiedUTF8Workload workload;
+
+    public:
+
+        ModifiedUTF8ScalarMixedBenchmark() : workload() {}
+        virtual ~ModifiedUTF8ScalarMixedBenchmark() {}
+
+        virtual void setUp();
+        virtual void tearDown();
+        virtual void run();
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_UTIL_MODIFIEDUTF8BENCHMARK_H_ */
@@ -17,67 +17,284 @@
 
 #include "HashMapBenchmark.h"
 
+#include <benchmark/PerformanceTimer.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/FlatHashMap.h>
+#include <decaf/util/HashMap.h>
+#include <decaf/util/LinkedFlatHashMap.h>
+#include <decaf/util/LinkedHashMap.h>
+#include <decaf/util/Random.h>
 #include <decaf/util/StlMap.h>
 
+#include <iomanip>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
 using namespace decaf;
 using namespace decaf::util;
 using namespace decaf::lang;
 
 ////////////////////////////////////////////////////////////////////////////////
-HashMapBenchmark::HashMapBenchmark() : stringMap(), intMap() {
-}
+namespace {
 
-////////////////////////////////////////////////////////////////////////////////
-HashMapBenchmark::~HashMapBenchmark() {
-}
+    const int SIZES[] = { 1000, 10000, 100000 };
+    const int NUM_SIZES = 3;
 
-////////////////////////////////////////////////////////////////////////////////
-void HashMapBenchmark::run() {
-
-    int numRuns = 500;
-    std::string test = "test";
-    std::string resultStr = "";
-    StlMap<std::string, std::string> stringCopy;
-    StlMap<int, int> intCopy;
-
-    for( int i = 0; i < numRuns; ++i ) {
-        stringMap.put( test + Integer::toString(i), test + Integer::toString(i) );
-        intMap.put( 100 + i, 100 + i );
-        stringMap.containsKey( test + Integer::toString(i) );
-        intMap.containsKey( 100 + i );
-        stringMap.containsValue( test + Integer::toString(i) );
-        intMap.containsValue( 100 + i );
+    // Operations timed for each map and size, smaller maps are rebuilt more often.
+    const int OPERATIONS = 2000000;
+
+    std::vector<int> intKeys(int count) {
+        std::vector<int> keys;
+        for (int i = 0; i < count; ++i) {
+            keys.push_back(i + 1);
+        }
+        return keys;
     }
 
-    for( int i = 0; i < numRuns; ++i ) {
-        stringMap.remove( test + Integer::toString(i) );
-        intMap.remove( 100 + i );
-        stringMap.containsKey( test + Integer::toString(i) );
-        intMap.containsKey( 100 + i );
+    std::vector<std::string> stringKeys(int count) {
+        std::vector<std::string> keys;
+        for (int i = 0; i < count; ++i) {
+            keys.push_back("ID:broker-host-43573-1366193012345-3:1:1:1:" + Integer::toString(i + 1));
+        }
+        return keys;
     }
 
-    for( int i = 0; i < numRuns; ++i ) {
-        stringMap.put( test + Integer::toString(i), test + Integer::toString(i) );
-        intMap.put( 100 + i, 100 + i );
+    // Responses and cache hits do not arrive in the order the keys were added, a sweep
+    // in insertion order would favour whichever map happens to lay its nodes out that way.
+    template<typename KEY>
+    std::vector<KEY> shuffled(const std::vector<KEY>& keys) {
+        std::vector<KEY> result(keys);
+        Random random(17);
+        for (int i = (int) result.size() - 1; i > 0; --i) {
+            std::swap(result[i], result[random.nextInt(i + 1)]);
+        }
+        return result;
+    }
+
+    int roundsFor(int size) {
+        return OPERATIONS / size > 0 ? OPERATIONS / size : 1;
+    }
+
+    template<typename MAP, typename KEY>
+    struct Insert {
+        static double run(const std::vector<KEY>& keys) {
+            int rounds = roundsFor((int) keys.size());
+            long long elapsed = 0;
+
+            for (int round = 0; round < rounds; ++round) {
+                MAP map;
+                long long begin = System::nanoTime();
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    map.put(keys[i], (int) i);
+                }
+                elapsed += System::nanoTime() - begin;
+            }
+
+            return (double) elapsed / ((double) rounds * (double) keys.size());
+        }
+    };
+
+    template<typename MAP, typename KEY>
+    struct Lookup {
+        static double run(const std::vector<KEY>& keys) {
+            int rounds = roundsFor((int) keys.size());
+            long long sum = 0;
+            std::vector<KEY> order = shuffled(keys);
+
+            MAP map;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                map.put(keys[i], (int) i);
+            }
+
+            long long begin = System::nanoTime();
+            for (int round = 0; round < rounds; ++round) {
+                for (std::size_t i = 0; i < order.size(); ++i) {
+                    sum += map.get(order[i]);
+                }
+            }
+            long long elapsed = System::nanoTime() - begin;
+
+            if (sum < 0) {
+                std::cout << sum;
+            }
+
+            return (double) elapsed / ((double) rounds * (double) keys.size());
+        }
+    };
+
+    template<typename MAP, typename KEY>
+    struct Erase {
+        static double run(const std::vector<KEY>& keys) {
+            int rounds = roundsFor((int) keys.size());
+            long long elapsed = 0;
+            std::vector<KEY> order = shuffled(keys);
+
+            for (int round = 0; round < rounds; ++round) {
+                MAP map;
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    map.put(keys[i], (int) i);
+                }
+
+                long long begin = System::nanoTime();
+                for (std::size_t i = 0; i < order.size(); ++i) {
+                    map.remove(order[i]);
+                }
+                elapsed += System::nanoTime() - begin;
+            }
+
+            return (double) elapsed / ((double) rounds * (double) keys.size());
+        }
+    };
+
+    template<typename KEY>
+    class Comparison {
+    public:
+
+        typedef double (*Timing)(const std::vector<KEY>&);
+
+    private:
+
+        std::vector< std::vector<KEY> > keySets;
+
+    public:
+
+        Comparison(const char* title, std::vector<KEY> (*generator)(int)) : keySets() {
+            std::cout << std::endl << std::left << std::setw(22) << title << std::right;
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                keySets.push_back(generator(SIZES[i]));
+                std::cout << std::setw(10) << SIZES[i];
+            }
+            std::cout << "   (ns/op)" << std::endl;
+        }
+
+        void row(const char* name, Timing timing) const {
+            std::cout << std::left << std::setw(22) << name << std::right
+                      << std::fixed << std::setprecision(1);
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                std::cout << std::setw(10) << timing(keySets[i]);
+            }
+            std::cout << std::endl;
+        }
+    };
+
+    template<template<typename, typename> class TIMING>
+    void compare(const char* operation) {
+
+        std::string title = std::string(operation) + " int";
+        Comparison<int> ints(title.c_str(), &intKeys);
+        ints.row("HashMap", TIMING<HashMap<int, int>, int>::run);
+        ints.row("FlatHashMap", TIMING<FlatHashMap<int, int>, int>::run);
+        ints.row("LinkedHashMap", TIMING<LinkedHashMap<int, int>, int>::run);
+        ints.row("LinkedFlatHashMap", TIMING<LinkedFlatHashMap<int, int>, int>::run);
+        ints.row("StlMap", TIMING<StlMap<int, int>, int>::run);
+
+        title = std::string(operation) + " string";
+        Comparison<std::string> strings(title.c_str(), &stringKeys);
+        strings.row("HashMap", TIMING<HashMap<std::string, int>, std::string>::run);
+        strings.row("FlatHashMap", TIMING<FlatHashMap<std::string, int>, std::string>::run);
+        strings.row("LinkedHashMap", TIMING<LinkedHashMap<std::string, int>, std::string>::run);
+        strings.row("LinkedFlatHashMap", TIMING<LinkedFlatHashMap<std::string, int>, std::string>::run);
+        strings.row("StlMap", TIMING<StlMap<std::string, int>, std::string>::run);
     }
 
-    for( int i = 0; i < numRuns / 2; ++i ) {
-        Set<std::string>& stringSet = stringMap.keySet();
-        stringSet.size();
-        Collection<std::string>& stringCol = stringMap.values();
-        stringCol.size();
-        Set<int>& intSet = intMap.keySet();
-        intSet.size();
-        Collection<int>& intCol = intMap.values();
-        intCol.size();
+    // The operation mix this benchmark has always timed against HashMap.
+    template<typename STRINGMAP, typename INTMAP>
+    void mixedOperations(STRINGMAP& stringMap, INTMAP& intMap) {
+
+        int numRuns = 500;
+        std::string test = "test";
+        StlMap<std::string, std::string> stringCopy;
+        StlMap<int, int> intCopy;
+
+        for( int i = 0; i < numRuns; ++i ) {
+            stringMap.put( test + Integer::toString(i), test + Integer::toString(i) );
+            intMap.put( 100 + i, 100 + i );
+            stringMap.containsKey( test + Integer::toString(i) );
+            intMap.containsKey( 100 + i );
+            stringMap.containsValue( test + Integer::toString(i) );
+            intMap.containsValue( 100 + i );
+        }
+
+        for( int i = 0; i < numRuns; ++i ) {
+            stringMap.remove( test + Integer::toString(i) );
+            intMap.remove( 100 + i );
+            stringMap.containsKey( test + Integer::toString(i) );
+            intMap.containsKey( 100 + i );
+        }
+
+        for( int i = 0; i < numRuns; ++i ) {
+            stringMap.put( test + Integer::toString(i), test + Integer::toString(i) );
+            intMap.put( 100 + i, 100 + i );
+        }
+
+        for( int i = 0; i < numRuns / 2; ++i ) {
+            Set<std::string>& stringSet = stringMap.keySet();
+            stringSet.size();
+            Collection<std::string>& stringCol = stringMap.values();
+            stringCol.size();
+            Set<int>& intSet = intMap.keySet();
+            intSet.size();
+            Collection<int>& intCol = intMap.values();
+            intCol.size();
+        }
+
+        for( int i = 0; i < numRuns / 2; ++i ) {
+            stringCopy.copy( stringMap );
+            stringCopy.clear();
+            intCopy.copy( intMap );
+            intCopy.clear();
+        }
     }
 
-    for( int i = 0; i < numRuns / 2; ++i ) {
-        stringCopy.copy( stringMap );
-        stringCopy.clear();
-        intCopy.copy( intMap );
-        intCopy.clear();
+    template<template<typename, typename, typename> class MAP>
+    void timeMixedOperations(const char* name) {
+        MAP<std::string, std::string, HashCode<std::string> > stringMap;
+        MAP<int, int, HashCode<int> > intMap;
+        benchmark::PerformanceTimer timer;
+
+        for (int i = 0; i < 100; ++i) {
+            timer.start();
+            mixedOperations(stringMap, intMap);
+            timer.stop();
+        }
+
+        std::cout << std::left << std::setw(22) << name << std::right
+                  << timer.getAverageTime() << " Millisecs" << std::endl;
     }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+HashMapBenchmark::HashMapBenchmark() {
+}
 
+////////////////////////////////////////////////////////////////////////////////
+HashMapBenchmark::~HashMapBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HashMapBenchmark::testMixedOperations() {
+    std::cout << std::endl;
+    timeMixedOperations<HashMap>("HashMap");
+    timeMixedOperations<FlatHashMap>("FlatHashMap");
+    timeMixedOperations<LinkedHashMap>("LinkedHashMap");
+    timeMixedOperations<LinkedFlatHashMap>("LinkedFlatHashMap");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HashMapBenchmark::testInsert() {
+    compare<Insert>("insert");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HashMapBenchmark::testLookup() {
+    compare<Lookup>("lookup");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void HashMapBenchmark::testErase() {
+    compare<Erase>("erase");
 }
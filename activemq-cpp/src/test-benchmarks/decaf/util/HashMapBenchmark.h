@@ -18,25 +18,38 @@
 #ifndef _DECAF_UTIL_HASHMAPBENCHMARK_H_
 #define _DECAF_UTIL_HASHMAPBENCHMARK_H_
 
-#include <benchmark/BenchmarkBase.h>
-#include <decaf/util/HashMap.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
 
 namespace decaf {
 namespace util {
 
-    class HashMapBenchmark :
-        public benchmark::BenchmarkBase<decaf::util::HashMapBenchmark, HashMap<int, int> > {
-    private:
-
-        HashMap<std::string, std::string> stringMap;
-        HashMap<int, int> intMap;
+    /**
+     * Compares the chained HashMap and LinkedHashMap with the open addressing
+     * FlatHashMap and LinkedFlatHashMap, and StlMap as a baseline.  The insert,
+     * lookup and erase cases report the mean cost of one operation at map sizes
+     * of one thousand to one hundred thousand entries, for integer keys such as
+     * command ids and for string keys shaped like message ids.  Keys are added
+     * in sequence and then looked up or removed in a shuffled order.
+     */
+    class HashMapBenchmark : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( HashMapBenchmark );
+        CPPUNIT_TEST( testMixedOperations );
+        CPPUNIT_TEST( testInsert );
+        CPPUNIT_TEST( testLookup );
+        CPPUNIT_TEST( testErase );
+        CPPUNIT_TEST_SUITE_END();
 
     public:
 
         HashMapBenchmark();
         virtual ~HashMapBenchmark();
 
-        virtual void run();
+        void testMixedOperations();
+        void testInsert();
+        void testLookup();
+        void testErase();
 
     };
 
@@ -0,0 +1,255 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkStealingExecutorBenchmark.h"
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/LinkedBlockingQueue.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/WorkStealingExecutor.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int POOL_SIZES[] = { 1, 2, 4, 8, 16, 32, 64 };
+    const int NUM_POOL_SIZES = 7;
+
+    const int SUBMITTERS = 4;
+    const int SUBMITTED_TASKS = 200000;
+
+    // A tree of this depth holds 2^17 - 1 tasks.
+    const int TREE_DEPTH = 16;
+
+    // Roughly the work of handling one small message, well under a microsecond.
+    const int TASK_WORK = 64;
+
+    volatile int sink = 0;
+
+    void doWork() {
+        int value = 0;
+        for (int i = 0; i < TASK_WORK; ++i) {
+            value = value * 31 + i;
+        }
+        sink = value;
+    }
+
+    class Completion {
+    private:
+
+        AtomicInteger remaining;
+        CountDownLatch done;
+
+    public:
+
+        Completion(int count) : remaining(count), done(1) {}
+
+        void taskDone() {
+            if (remaining.decrementAndGet() == 0) {
+                done.countDown();
+            }
+        }
+
+        void await() {
+            done.await();
+        }
+    };
+
+    class ShortTask : public Runnable {
+    private:
+
+        Completion* completion;
+
+    private:
+
+        ShortTask(const ShortTask&);
+        ShortTask& operator=(const ShortTask&);
+
+    public:
+
+        ShortTask(Completion* completion) : Runnable(), completion(completion) {}
+
+        virtual void run() {
+            doWork();
+            completion->taskDone();
+        }
+    };
+
+    class TreeTask : public Runnable {
+    private:
+
+        ExecutorService* executor;
+        Completion* completion;
+        int depth;
+
+    private:
+
+        TreeTask(const TreeTask&);
+        TreeTask& operator=(const TreeTask&);
+
+    public:
+
+        TreeTask(ExecutorService* executor, Completion* completion, int depth) :
+            Runnable(), executor(executor), completion(completion), depth(depth) {}
+
+        virtual void run() {
+            if (depth > 0) {
+                executor->execute(new TreeTask(executor, completion, depth - 1));
+                executor->execute(new TreeTask(executor, completion, depth - 1));
+            }
+            doWork();
+            completion->taskDone();
+        }
+    };
+
+    class Submitter : public Runnable {
+    private:
+
+        ExecutorService* executor;
+        Completion* completion;
+        CountDownLatch* go;
+        int count;
+
+    private:
+
+        Submitter(const Submitter&);
+        Submitter& operator=(const Submitter&);
+
+    public:
+
+        Submitter(ExecutorService* executor, Completion* completion, CountDownLatch* go, int count) :
+            Runnable(), executor(executor), completion(completion), go(go), count(count) {}
+
+        virtual void run() {
+            go->await();
+            for (int i = 0; i < count; ++i) {
+                executor->execute(new ShortTask(completion));
+            }
+        }
+    };
+
+    ExecutorService* newThreadPool(int threads) {
+        return new ThreadPoolExecutor(threads, threads, 0, TimeUnit::MILLISECONDS,
+                                      new LinkedBlockingQueue<Runnable*>());
+    }
+
+    ExecutorService* newWorkStealingPool(int threads) {
+        return new WorkStealingExecutor(threads);
+    }
+
+    void retire(ExecutorService* executor) {
+        executor->shutdown();
+        executor->awaitTermination(1, TimeUnit::MINUTES);
+        delete executor;
+    }
+
+    double timeSubmitted(ExecutorService* (*factory)(int), int threads) {
+
+        Pointer<ExecutorService> executor(factory(threads));
+        Completion completion(SUBMITTED_TASKS);
+        CountDownLatch go(1);
+
+        Pointer<Submitter> submitters[SUBMITTERS];
+        Pointer<Thread> workers[SUBMITTERS];
+        for (int i = 0; i < SUBMITTERS; ++i) {
+            submitters[i].reset(new Submitter(executor.get(), &completion, &go, SUBMITTED_TASKS / SUBMITTERS));
+            workers[i].reset(new Thread(submitters[i].get()));
+            workers[i]->start();
+        }
+
+        long long begin = System::nanoTime();
+        go.countDown();
+        completion.await();
+        long long elapsed = System::nanoTime() - begin;
+
+        for (int i = 0; i < SUBMITTERS; ++i) {
+            workers[i]->join();
+        }
+        retire(executor.release());
+
+        return (double) elapsed / (double) SUBMITTED_TASKS;
+    }
+
+    double timeForked(ExecutorService* (*factory)(int), int threads) {
+
+        int tasks = (1 << (TREE_DEPTH + 1)) - 1;
+
+        Pointer<ExecutorService> executor(factory(threads));
+        Completion completion(tasks);
+
+        long long begin = System::nanoTime();
+        executor->execute(new TreeTask(executor.get(), &completion, TREE_DEPTH));
+        completion.await();
+        long long elapsed = System::nanoTime() - begin;
+
+        retire(executor.release());
+
+        return (double) elapsed / (double) tasks;
+    }
+
+    void compare(const char* title, double (*timing)(ExecutorService* (*)(int), int)) {
+
+        std::cout << std::endl << std::left << std::setw(22) << title << std::right;
+        for (int i = 0; i < NUM_POOL_SIZES; ++i) {
+            std::cout << std::setw(8) << POOL_SIZES[i];
+        }
+        std::cout << "   (ns/task)" << std::endl;
+
+        const char* names[] = { "ThreadPoolExecutor", "WorkStealingExecutor" };
+        ExecutorService* (*factories[])(int) = { &newThreadPool, &newWorkStealingPool };
+
+        for (int row = 0; row < 2; ++row) {
+            std::cout << std::left << std::setw(22) << names[row] << std::right
+                      << std::fixed << std::setprecision(0);
+            for (int i = 0; i < NUM_POOL_SIZES; ++i) {
+                std::cout << std::setw(8) << timing(factories[row], POOL_SIZES[i]) << std::flush;
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutorBenchmark::WorkStealingExecutorBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutorBenchmark::~WorkStealingExecutorBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorBenchmark::testSubmittedTasks() {
+    compare("submitted, threads", &timeSubmitted);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorBenchmark::testForkedTasks() {
+    compare("forked, threads", &timeForked);
+}
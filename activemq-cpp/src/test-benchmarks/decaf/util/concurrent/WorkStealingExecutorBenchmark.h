@@ -0,0 +1,54 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORBENCHMARK_H_
+#define _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORBENCHMARK_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    /**
+     * Compares the WorkStealingExecutor with a fixed size ThreadPoolExecutor running
+     * short tasks on pools of 1 to 64 threads.  The submitted case has four threads
+     * outside the pool feeding it tasks, the forked case has the tasks themselves
+     * submit the next level of a tree of tasks from the pool threads.  Each reports
+     * the mean wall clock time per task from the first submit to the last completion.
+     */
+    class WorkStealingExecutorBenchmark : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( WorkStealingExecutorBenchmark );
+        CPPUNIT_TEST( testSubmittedTasks );
+        CPPUNIT_TEST( testForkedTasks );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        WorkStealingExecutorBenchmark();
+        virtual ~WorkStealingExecutorBenchmark();
+
+        void testSubmittedTasks();
+        void testForkedTasks();
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORBENCHMARK_H_ */
@@ -15,8 +15,26 @@
  * limitations under the License.
  */
 
+#include <activemq/core/ClientPathBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ClientPathBenchmark );
+#include <activemq/cmsutil/RequestorBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::RequestorBenchmark );
+#include <activemq/cmsutil/CmsTemplateBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::CmsTemplateBenchmark );
 #include <activemq/util/PrimitiveMapBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::PrimitiveMapBenchmark );
+#include <activemq/selector/SelectorBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::selector::SelectorBenchmark );
+#include <activemq/util/MemoryUsageBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::MemoryUsageBenchmark );
+#include <activemq/transport/tcp/TcpTransportWriteBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::tcp::TcpTransportWriteBenchmark );
+#include <activemq/wireformat/openwire/OpenWireFormatBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::OpenWireFormatBenchmark );
+#include <activemq/wireformat/stomp/StompFrameReaderBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::stomp::StompFrameReaderBenchmark );
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::stomp::StompFrameFromStreamBenchmark );
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::stomp::StompFrameLegacyParserBenchmark );
 
 #include <decaf/lang/BooleanBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::lang::BooleanBenchmark );
@@ -37,6 +55,18 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::HashMapBenchmark );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::StlListBenchmark );
 #include <decaf/util/LinkedListBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::LinkedListBenchmark );
+#include <decaf/util/concurrent/WorkStealingExecutorBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::WorkStealingExecutorBenchmark );
+
+#include <decaf/internal/net/ssl/openssl/OpenSSLSessionCacheBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::net::ssl::openssl::OpenSSLSessionCacheBenchmark );
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::net::ssl::openssl::OpenSSLFullHandshakeBenchmark );
+
+#include <decaf/internal/util/ModifiedUTF8Benchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::ModifiedUTF8AsciiBenchmark );
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::ModifiedUTF8MixedBenchmark );
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::ModifiedUTF8ScalarAsciiBenchmark );
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::ModifiedUTF8ScalarMixedBenchmark );
 
 #include <decaf/io/ByteArrayOutputStreamBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::ByteArrayOutputStreamBenchmark );
@@ -20,10 +20,92 @@
 #include <activemq/cmsutil/ResourceLifecycleManager.h>
 #include "DummyConnectionFactory.h"
 #include "DummyMessageCreator.h"
+#include <activemq/commands/ActiveMQQueue.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/ArrayList.h>
+
+#include <memory>
 
 using namespace activemq;
 using namespace activemq::cmsutil;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingSendListener : public MessageContext::SendListener {
+    public:
+
+        std::vector<const cms::Destination*> destinations;
+
+        CountingSendListener() : destinations() {}
+        virtual ~CountingSendListener() {}
+
+        virtual void onSend(const cms::Destination* destination,
+                cms::Message* message, int deliveryMode, int priority,
+                long long timeToLive) {
+            destinations.push_back(destination);
+        }
+
+        virtual cms::Message* doReceive(const cms::Destination* dest,
+                const std::string& selector, bool noLocal, long long timeout) {
+            return NULL;
+        }
+    };
+
+    // Runs a session callback through the template twice from its own thread.
+    class ExecuteTask : public decaf::lang::Runnable {
+    private:
+
+        CmsTemplate* cmsTemplate;
+
+    private:
+
+        ExecuteTask(const ExecuteTask&);
+        ExecuteTask& operator=(const ExecuteTask&);
+
+    public:
+
+        cms::Session* first;
+        cms::Session* second;
+
+        ExecuteTask(CmsTemplate* cmsTemplate) :
+            decaf::lang::Runnable(), cmsTemplate(cmsTemplate), first(NULL), second(NULL) {
+        }
+
+        virtual ~ExecuteTask() {}
+
+        virtual void run();
+    };
+
+    class RecordingSessionCallback : public SessionCallback {
+    public:
+
+        cms::Session* session;
+
+        RecordingSessionCallback() : session(NULL) {}
+        virtual ~RecordingSessionCallback() {}
+
+        virtual void doInCms(cms::Session* session) {
+            this->session = session;
+        }
+    };
+
+    void ExecuteTask::run() {
+        RecordingSessionCallback callback;
+        cmsTemplate->execute(&callback);
+        first = callback.session;
+        cmsTemplate->execute(&callback);
+        second = callback.session;
+    }
+
+    void runInThread(ExecuteTask& task) {
+        decaf::lang::Thread thread(&task);
+        thread.start();
+        thread.join();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void CmsTemplateTest::setUp() {
     cf = new DummyConnectionFactory();
@@ -197,6 +279,74 @@ void CmsTemplateTest::testSend() {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void CmsTemplateTest::testSendBatch() {
+
+    MessageContext* messageContext = cf->getMessageContext();
+
+    CountingSendListener listener;
+    messageContext->setSendListener(&listener);
+
+    DummyMessageCreator msgCreator;
+    decaf::util::ArrayList<MessageCreator*> creators;
+    creators.add(&msgCreator);
+    creators.add(&msgCreator);
+    creators.add(&msgCreator);
+
+    std::auto_ptr< decaf::util::Iterator<MessageCreator*> > iter(creators.iterator());
+    cmsTemplate->sendBatch(iter.get());
+    CPPUNIT_ASSERT_EQUAL(3, (int) listener.destinations.size());
+    const cms::Queue* q = dynamic_cast<const cms::Queue*>(listener.destinations[0]);
+    CPPUNIT_ASSERT(q != NULL);
+    CPPUNIT_ASSERT_EQUAL((std::string)"test", q->getQueueName());
+
+    activemq::commands::ActiveMQQueue myQueue("anotherqueue");
+    iter.reset(creators.iterator());
+    cmsTemplate->sendBatch(&myQueue, iter.get());
+    CPPUNIT_ASSERT_EQUAL(6, (int) listener.destinations.size());
+    CPPUNIT_ASSERT(listener.destinations[5] == &myQueue);
+
+    iter.reset(creators.iterator());
+    cmsTemplate->sendBatch("yetanotherqueue", iter.get());
+    CPPUNIT_ASSERT_EQUAL(9, (int) listener.destinations.size());
+    q = dynamic_cast<const cms::Queue*>(listener.destinations[8]);
+    CPPUNIT_ASSERT(q != NULL);
+    CPPUNIT_ASSERT_EQUAL((std::string)"yetanotherqueue", q->getQueueName());
+
+    // The whole batch went through one producer, so one destination object.
+    CPPUNIT_ASSERT(listener.destinations[6] == listener.destinations[8]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CmsTemplateTest::testThreadSessionCache() {
+
+    cmsTemplate->setThreadSessionCacheSize(4);
+    CPPUNIT_ASSERT_EQUAL(4, cmsTemplate->getThreadSessionCacheSize());
+
+    RecordingSessionCallback callback;
+    cmsTemplate->execute(&callback);
+    cms::Session* mainSession = callback.session;
+    CPPUNIT_ASSERT(mainSession != NULL);
+
+    // This thread still holds its session, so another thread gets its own
+    // and keeps it between operations.
+    ExecuteTask task(cmsTemplate);
+    runInThread(task);
+    CPPUNIT_ASSERT(task.first != NULL);
+    CPPUNIT_ASSERT(task.first != mainSession);
+    CPPUNIT_ASSERT(task.first == task.second);
+
+    cmsTemplate->execute(&callback);
+    CPPUNIT_ASSERT(callback.session == mainSession);
+
+    // Released, this thread's session goes to the next thread that needs one.
+    cmsTemplate->releaseThreadSession();
+    ExecuteTask next(cmsTemplate);
+    runInThread(next);
+    CPPUNIT_ASSERT(next.first == mainSession);
+    CPPUNIT_ASSERT(next.second == mainSession);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void CmsTemplateTest::testReceive() {
 
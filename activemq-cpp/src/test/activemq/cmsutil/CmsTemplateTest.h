@@ -39,6 +39,8 @@ namespace cmsutil{
         CPPUNIT_TEST( testExecuteSession );
         CPPUNIT_TEST( testExecuteProducer );
         CPPUNIT_TEST( testSend );
+        CPPUNIT_TEST( testSendBatch );
+        CPPUNIT_TEST( testThreadSessionCache );
         CPPUNIT_TEST( testReceive );
         CPPUNIT_TEST( testReceive_Destination );
         CPPUNIT_TEST( testReceive_DestinationName );
@@ -166,6 +168,8 @@ namespace cmsutil{
         void testExecuteSession();
         void testExecuteProducer();
         void testSend();
+        void testSendBatch();
+        void testThreadSessionCache();
         void testReceive();
         void testReceive_Destination();
         void testReceive_DestinationName();
@@ -0,0 +1,373 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DemuxConsumerTest.h"
+
+#include <activemq/cmsutil/DemuxConsumer.h>
+#include <activemq/cmsutil/DummyConsumer.h>
+#include <activemq/cmsutil/DummyMessage.h>
+#include <activemq/cmsutil/MessageContext.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <cms/ExceptionListener.h>
+#include <cms/InvalidSelectorException.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace activemq::commands;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingListener : public cms::MessageListener {
+    public:
+
+        int count;
+
+        CountingListener() : count(0) {}
+        virtual ~CountingListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+            count++;
+        }
+    };
+
+    class ThrowingListener : public cms::MessageListener {
+    public:
+
+        int count;
+
+        ThrowingListener() : count(0) {}
+        virtual ~ThrowingListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+            count++;
+            throw cms::CMSException("listener failed", NULL);
+        }
+    };
+
+    class RecordingExceptionListener : public cms::ExceptionListener {
+    public:
+
+        std::vector<std::string> errors;
+
+        RecordingExceptionListener() : errors() {}
+        virtual ~RecordingExceptionListener() {}
+
+        virtual void onException(const cms::CMSException& ex) {
+            errors.push_back(ex.getMessage());
+        }
+    };
+
+    class RemovingListener : public cms::MessageListener {
+    private:
+
+        RemovingListener(const RemovingListener&);
+        RemovingListener& operator=(const RemovingListener&);
+
+    public:
+
+        DemuxConsumer* demux;
+        int count;
+
+        RemovingListener(DemuxConsumer* demux) : demux(demux), count(0) {}
+        virtual ~RemovingListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+            count++;
+            demux->removeListener(this);
+        }
+    };
+
+    class Remover : public Runnable {
+    private:
+
+        Remover(const Remover&);
+        Remover& operator=(const Remover&);
+
+    public:
+
+        DemuxConsumer* demux;
+        cms::MessageListener* listener;
+        bool removed;
+
+        Remover(DemuxConsumer* demux, cms::MessageListener* listener) :
+            Runnable(), demux(demux), listener(listener), removed(false) {}
+        virtual ~Remover() {}
+
+        virtual void run() {
+            removed = demux->removeListener(listener);
+        }
+    };
+
+    // Waits for another thread to remove it, which can only finish if the
+    // DemuxConsumer holds no lock while calling its listeners.
+    class CrossThreadRemovingListener : public cms::MessageListener {
+    private:
+
+        CrossThreadRemovingListener(const CrossThreadRemovingListener&);
+        CrossThreadRemovingListener& operator=(const CrossThreadRemovingListener&);
+
+    public:
+
+        DemuxConsumer* demux;
+        bool removed;
+        bool finished;
+
+        CrossThreadRemovingListener(DemuxConsumer* demux) : demux(demux), removed(false), finished(false) {}
+        virtual ~CrossThreadRemovingListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+            Remover remover(demux, this);
+            Thread thread(&remover);
+            thread.start();
+            thread.join(5000);
+            finished = !thread.isAlive();
+            removed = remover.removed;
+            if (!finished) {
+                thread.join();
+            }
+        }
+    };
+
+    void send(DemuxConsumer& demux, const std::string& region, int priority) {
+        ActiveMQTextMessage message;
+        message.setStringProperty("region", region);
+        message.setIntProperty("priority", priority);
+        demux.onMessage(&message);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testInstallsListener() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+
+    {
+        DemuxConsumer demux(&consumer);
+        CPPUNIT_ASSERT(consumer.getMessageListener() == &demux);
+        CPPUNIT_ASSERT(demux.getConsumer() == &consumer);
+        CPPUNIT_ASSERT_EQUAL(0, demux.getListenerCount());
+    }
+
+    CPPUNIT_ASSERT(consumer.getMessageListener() == NULL);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException",
+        DemuxConsumer((cms::MessageConsumer*) NULL),
+        cms::CMSException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testRoutesToMatchingListeners() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+    DemuxConsumer demux(&consumer);
+
+    CountingListener east;
+    CountingListener west;
+    CountingListener urgent;
+
+    demux.addListener("region = 'east'", &east);
+    demux.addListener("region = 'west'", &west);
+    demux.addListener("priority > 5", &urgent);
+    CPPUNIT_ASSERT_EQUAL(3, demux.getListenerCount());
+
+    send(demux, "east", 1);
+    send(demux, "east", 9);
+    send(demux, "west", 7);
+    send(demux, "north", 2);
+
+    CPPUNIT_ASSERT_EQUAL(2, east.count);
+    CPPUNIT_ASSERT_EQUAL(1, west.count);
+    CPPUNIT_ASSERT_EQUAL(2, urgent.count);
+
+    // The same listener under two selectors is called for each that matches.
+    CountingListener twice;
+    demux.addListener("region LIKE 'e%'", &twice);
+    demux.addListener("priority = 3", &twice);
+
+    send(demux, "east", 3);
+    CPPUNIT_ASSERT_EQUAL(2, twice.count);
+    CPPUNIT_ASSERT_EQUAL(3, east.count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testEmptySelectorReceivesAll() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+    DemuxConsumer demux(&consumer);
+
+    CountingListener all;
+    CountingListener blank;
+    demux.addListener("", &all);
+    demux.addListener("  ", &blank);
+
+    send(demux, "east", 1);
+    send(demux, "west", 2);
+
+    CPPUNIT_ASSERT_EQUAL(2, all.count);
+    CPPUNIT_ASSERT_EQUAL(2, blank.count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testInvalidSelector() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+    DemuxConsumer demux(&consumer);
+
+    CountingListener listener;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an InvalidSelectorException",
+        demux.addListener("region = ", &listener),
+        cms::InvalidSelectorException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException",
+        demux.addListener("region = 'east'", NULL),
+        cms::CMSException);
+
+    CPPUNIT_ASSERT_EQUAL(0, demux.getListenerCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testRemoveListener() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+    DemuxConsumer demux(&consumer);
+
+    CountingListener first;
+    CountingListener second;
+    demux.addListener("region = 'east'", &first);
+    demux.addListener("priority > 0", &first);
+    demux.addListener("region = 'east'", &second);
+
+    CPPUNIT_ASSERT(demux.removeListener(&first));
+    CPPUNIT_ASSERT(!demux.removeListener(&first));
+    CPPUNIT_ASSERT_EQUAL(1, demux.getListenerCount());
+
+    send(demux, "east", 1);
+    CPPUNIT_ASSERT_EQUAL(0, first.count);
+    CPPUNIT_ASSERT_EQUAL(1, second.count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testRemoveFromListener() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+    DemuxConsumer demux(&consumer);
+
+    RemovingListener once(&demux);
+    CountingListener after;
+    demux.addListener("region = 'east'", &once);
+    demux.addListener("region = 'east'", &after);
+
+    send(demux, "east", 1);
+    send(demux, "east", 1);
+
+    CPPUNIT_ASSERT_EQUAL(1, once.count);
+    CPPUNIT_ASSERT_EQUAL(2, after.count);
+    CPPUNIT_ASSERT_EQUAL(1, demux.getListenerCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testForeignMessage() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+    DemuxConsumer demux(&consumer);
+
+    CountingListener all;
+    CountingListener selective;
+    demux.addListener("", &all);
+    demux.addListener("region IS NULL", &selective);
+
+    DummyMessage message;
+    demux.onMessage(&message);
+
+    CPPUNIT_ASSERT_EQUAL(1, all.count);
+    CPPUNIT_ASSERT_EQUAL(0, selective.count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testRemoveFromOtherThreadDuringDelivery() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+    DemuxConsumer demux(&consumer);
+
+    CrossThreadRemovingListener listener(&demux);
+    CountingListener after;
+    demux.addListener("", &listener);
+    demux.addListener("", &after);
+
+    send(demux, "east", 1);
+
+    CPPUNIT_ASSERT(listener.finished);
+    CPPUNIT_ASSERT(listener.removed);
+    CPPUNIT_ASSERT_EQUAL(1, demux.getListenerCount());
+
+    // The delivery under way when the listener was removed still reaches the others.
+    CPPUNIT_ASSERT_EQUAL(1, after.count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DemuxConsumerTest::testListenerExceptionReported() {
+
+    MessageContext context;
+    DummyConsumer consumer(&context, NULL, "", false);
+    DemuxConsumer demux(&consumer);
+
+    CountingListener first;
+    ThrowingListener failing;
+    CountingListener last;
+
+    demux.addListener("", &first);
+    demux.addListener("region = 'emea'", &failing);
+    demux.addListener("", &last);
+
+    // Without an ExceptionListener the failure is dropped, it never reaches the consumer.
+    CPPUNIT_ASSERT(demux.getExceptionListener() == NULL);
+    CPPUNIT_ASSERT_NO_THROW(send(demux, "emea", 1));
+    CPPUNIT_ASSERT_EQUAL(1, first.count);
+    CPPUNIT_ASSERT_EQUAL(1, failing.count);
+    CPPUNIT_ASSERT_EQUAL(1, last.count);
+
+    RecordingExceptionListener errors;
+    demux.setExceptionListener(&errors);
+    CPPUNIT_ASSERT(demux.getExceptionListener() == &errors);
+
+    CPPUNIT_ASSERT_NO_THROW(send(demux, "emea", 2));
+    CPPUNIT_ASSERT_EQUAL(2, first.count);
+    CPPUNIT_ASSERT_EQUAL(2, failing.count);
+    CPPUNIT_ASSERT_EQUAL(2, last.count);
+    CPPUNIT_ASSERT_EQUAL(1, (int) errors.errors.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("listener failed"), errors.errors[0]);
+}
@@ -18,6 +18,8 @@
 #include "DynamicDestinationResolverTest.h"
 #include <activemq/cmsutil/DynamicDestinationResolver.h>
 #include <activemq/cmsutil/ResourceLifecycleManager.h>
+#include <activemq/cmsutil/SessionPool.h>
+#include "DummyConnection.h"
 #include "DummySession.h"
 
 using namespace activemq;
@@ -85,3 +87,32 @@ void DynamicDestinationResolverTest::testQueues() {
 
     mgr.destroy();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void DynamicDestinationResolverTest::testPooledSession() {
+
+    ResourceLifecycleManager mgr;
+    DynamicDestinationResolver resolver;
+    resolver.init(&mgr);
+
+    DummyConnection connection(NULL);
+    SessionPool pool(&connection, cms::Session::AUTO_ACKNOWLEDGE, &mgr);
+    PooledSession* session = pool.takeSession();
+
+    // Destinations are cached on the pooled session, by name and kind.
+    cms::Destination* testTopic = resolver.resolveDestinationName(session, "test", true);
+    cms::Destination* testQueue = resolver.resolveDestinationName(session, "test", false);
+
+    CPPUNIT_ASSERT(dynamic_cast<cms::Topic*>(testTopic) != NULL);
+    CPPUNIT_ASSERT(dynamic_cast<cms::Queue*>(testQueue) != NULL);
+    CPPUNIT_ASSERT(testTopic == session->resolveCachedDestination("test", true));
+    CPPUNIT_ASSERT(testTopic == resolver.resolveDestinationName(session, "test", true));
+    CPPUNIT_ASSERT(testQueue == resolver.resolveDestinationName(session, "test", false));
+
+    // Another session resolves its own.
+    PooledSession* other = pool.takeSession();
+    CPPUNIT_ASSERT(other != session);
+    CPPUNIT_ASSERT(testTopic != resolver.resolveDestinationName(other, "test", true));
+
+    mgr.destroy();
+}
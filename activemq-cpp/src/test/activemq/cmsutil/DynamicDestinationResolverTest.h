@@ -29,6 +29,7 @@ namespace cmsutil{
         CPPUNIT_TEST_SUITE( DynamicDestinationResolverTest );
         CPPUNIT_TEST( testTopics );
         CPPUNIT_TEST( testQueues );
+        CPPUNIT_TEST( testPooledSession );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -38,6 +39,7 @@ namespace cmsutil{
 
         void testTopics();
         void testQueues();
+        void testPooledSession();
     };
 
 }}
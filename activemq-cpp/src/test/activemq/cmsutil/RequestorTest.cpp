@@ -0,0 +1,444 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RequestorTest.h"
+
+#include <activemq/cmsutil/Requestor.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ConsumerInfo.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <cms/IllegalStateException.h>
+#include <cms/TextMessage.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/ExecutionException.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/TimeoutException.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace activemq::commands;
+using namespace activemq::core;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const std::string REQUEST_QUEUE = "TEST.REQUESTS";
+
+    /**
+     * Plays the part of the broker and the service behind it, watching what the client
+     * sends and answering each request with a text reply to its CMSReplyTo.
+     */
+    class Responder : public DefaultTransportListener {
+    private:
+
+        Mutex mutex;
+        MockTransport* transport;
+        bool autoReply;
+        long long sequence;
+        int temporaryConsumers;
+        std::map<std::string, Pointer<ConsumerId> > consumers;
+
+    private:
+
+        Responder(const Responder&);
+        Responder& operator=(const Responder&);
+
+    public:
+
+        std::vector< Pointer<commands::Message> > requests;
+
+        Responder(MockTransport* transport, bool autoReply) :
+            mutex(), transport(transport), autoReply(autoReply), sequence(0), temporaryConsumers(0), consumers(), requests() {
+        }
+
+        virtual ~Responder() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+
+            Pointer<commands::Message> request;
+
+            synchronized(&mutex) {
+                if (command->isConsumerInfo()) {
+                    Pointer<ConsumerInfo> info = command.dynamicCast<ConsumerInfo>();
+                    consumers[info->getDestination()->getPhysicalName()] = info->getConsumerId();
+                    if (info->getDestination()->isTemporary()) {
+                        temporaryConsumers++;
+                    }
+                } else if (command->isMessage()) {
+                    Pointer<commands::Message> message = command.dynamicCast<commands::Message>();
+                    if (message->getDestination()->getPhysicalName() == REQUEST_QUEUE) {
+                        requests.push_back(message);
+                        request = message;
+                    }
+                }
+            }
+
+            if (autoReply && request != NULL) {
+                reply(request);
+            }
+        }
+
+        int getTemporaryConsumerCount() {
+            synchronized(&mutex) {
+                return temporaryConsumers;
+            }
+            return 0;
+        }
+
+        Pointer<commands::Message> getRequest(int index) {
+            synchronized(&mutex) {
+                return requests.at(index);
+            }
+            return Pointer<commands::Message>();
+        }
+
+        void reply(const Pointer<commands::Message>& request) {
+
+            Pointer<ConsumerId> consumerId;
+            long long id = 0;
+            synchronized(&mutex) {
+                consumerId = consumers[request->getReplyTo()->getPhysicalName()];
+                id = ++sequence;
+            }
+
+            Pointer<ActiveMQTextMessage> reply(new ActiveMQTextMessage());
+            reply->setText("reply:" + request.dynamicCast<ActiveMQTextMessage>()->getText());
+            reply->setCorrelationId(request->getCorrelationId());
+            reply->setDestination(request->getReplyTo());
+            reply->setMessageId(Pointer<MessageId>(new MessageId(
+                Pointer<ProducerId>(new ProducerId("ID:responder:1:1:1")), id)));
+
+            Pointer<MessageDispatch> dispatch(new MessageDispatch());
+            dispatch->setConsumerId(Pointer<ConsumerId>(consumerId->cloneDataStructure()));
+            dispatch->setDestination(request->getReplyTo());
+            dispatch->setMessage(reply);
+
+            transport->fireCommand(dispatch);
+        }
+    };
+
+    class MockService {
+    private:
+
+        MockService(const MockService&);
+        MockService& operator=(const MockService&);
+
+    public:
+
+        std::auto_ptr<ActiveMQConnection> connection;
+        MockTransport* transport;
+        std::auto_ptr<Responder> responder;
+
+        MockService(bool autoReply) : connection(), transport(NULL), responder() {
+
+            ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+            connection.reset(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+            transport = dynamic_cast<MockTransport*>(
+                connection->getTransport().narrow(typeid(MockTransport)));
+
+            responder.reset(new Responder(transport, autoReply));
+            transport->setOutgoingListener(responder.get());
+            connection->start();
+        }
+
+        ~MockService() {
+            try {
+                connection->close();
+            } catch (...) {
+            }
+            transport->setOutgoingListener(NULL);
+        }
+    };
+
+    class RequestTask : public Runnable {
+    private:
+
+        Requestor* requestor;
+        int index;
+        int count;
+
+    private:
+
+        RequestTask(const RequestTask&);
+        RequestTask& operator=(const RequestTask&);
+
+    public:
+
+        AtomicInteger* matched;
+
+        RequestTask(Requestor* requestor, int index, int count, AtomicInteger* matched) :
+            Runnable(), requestor(requestor), index(index), count(count), matched(matched) {
+        }
+
+        virtual ~RequestTask() {}
+
+        virtual void run() {
+
+            ActiveMQQueue queue(REQUEST_QUEUE);
+
+            try {
+                for (int i = 0; i < count; ++i) {
+                    std::string text = Integer::toString(index) + "-" + Integer::toString(i);
+
+                    ActiveMQTextMessage request;
+                    request.setText(text);
+
+                    std::auto_ptr<cms::Message> reply(requestor->request(&queue, &request, 10000));
+                    cms::TextMessage* textReply = dynamic_cast<cms::TextMessage*>(reply.get());
+                    if (textReply != NULL && textReply->getText() == "reply:" + text) {
+                        matched->incrementAndGet();
+                    }
+                }
+            } catch (...) {
+            }
+        }
+    };
+
+    std::string replyText(const Pointer<Requestor::ReplyFuture>& future) {
+        return dynamic_cast<cms::TextMessage*>(future->get().get())->getText();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testRequest() {
+
+    MockService service(true);
+    Requestor requestor(service.connection.get());
+    ActiveMQQueue queue(REQUEST_QUEUE);
+
+    ActiveMQTextMessage request;
+    request.setText("hello");
+
+    std::auto_ptr<cms::Message> reply(requestor.request(&queue, &request, 10000));
+    CPPUNIT_ASSERT(reply.get() != NULL);
+
+    cms::TextMessage* textReply = dynamic_cast<cms::TextMessage*>(reply.get());
+    CPPUNIT_ASSERT(textReply != NULL);
+    CPPUNIT_ASSERT_EQUAL(std::string("reply:hello"), textReply->getText());
+    CPPUNIT_ASSERT_EQUAL(request.getCMSCorrelationID(), reply->getCMSCorrelationID());
+    CPPUNIT_ASSERT_EQUAL(0, requestor.getOutstandingRequestCount());
+
+    Pointer<commands::Message> sent = service.responder->getRequest(0);
+    CPPUNIT_ASSERT_EQUAL(requestor.getReplyQueue()->getQueueName(), sent->getReplyTo()->getPhysicalName());
+    CPPUNIT_ASSERT(!sent->isPersistent());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testSharedReplyQueue() {
+
+    MockService service(true);
+    Requestor requestor(service.connection.get());
+    ActiveMQQueue queue(REQUEST_QUEUE);
+
+    std::set<std::string> correlationIds;
+    for (int i = 0; i < 10; ++i) {
+        ActiveMQTextMessage request;
+        request.setText("hello");
+        std::auto_ptr<cms::Message> reply(requestor.request(&queue, &request, 10000));
+        CPPUNIT_ASSERT(reply.get() != NULL);
+        correlationIds.insert(reply->getCMSCorrelationID());
+    }
+
+    // Every request got its own id but they all shared the one reply consumer.
+    CPPUNIT_ASSERT_EQUAL(10, (int) correlationIds.size());
+    CPPUNIT_ASSERT_EQUAL(1, service.responder->getTemporaryConsumerCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testOutOfOrderReplies() {
+
+    MockService service(false);
+    Requestor requestor(service.connection.get());
+    ActiveMQQueue queue(REQUEST_QUEUE);
+
+    std::vector< Pointer<Requestor::ReplyFuture> > futures;
+    for (int i = 0; i < 3; ++i) {
+        ActiveMQTextMessage request;
+        request.setText(Integer::toString(i));
+        futures.push_back(requestor.requestAsync(&queue, &request, 0));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(3, requestor.getOutstandingRequestCount());
+
+    service.responder->reply(service.responder->getRequest(2));
+    service.responder->reply(service.responder->getRequest(0));
+    service.responder->reply(service.responder->getRequest(1));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("reply:0"), replyText(futures[0]));
+    CPPUNIT_ASSERT_EQUAL(std::string("reply:1"), replyText(futures[1]));
+    CPPUNIT_ASSERT_EQUAL(std::string("reply:2"), replyText(futures[2]));
+    CPPUNIT_ASSERT_EQUAL(0, requestor.getOutstandingRequestCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testConcurrentRequests() {
+
+    static const int THREADS = 4;
+    static const int REQUESTS = 100;
+
+    MockService service(true);
+    Requestor requestor(service.connection.get());
+    AtomicInteger matched;
+
+    std::vector<RequestTask*> tasks;
+    std::vector<Thread*> threads;
+    for (int i = 0; i < THREADS; ++i) {
+        tasks.push_back(new RequestTask(&requestor, i, REQUESTS, &matched));
+        threads.push_back(new Thread(tasks.back()));
+        threads.back()->start();
+    }
+
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+        delete tasks[i];
+    }
+
+    CPPUNIT_ASSERT_EQUAL(THREADS * REQUESTS, matched.get());
+    CPPUNIT_ASSERT_EQUAL(0, requestor.getOutstandingRequestCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testRequestTimeout() {
+
+    MockService service(false);
+    Requestor requestor(service.connection.get());
+    ActiveMQQueue queue(REQUEST_QUEUE);
+
+    ActiveMQTextMessage request;
+    request.setText("hello");
+
+    std::auto_ptr<cms::Message> reply(requestor.request(&queue, &request, 100));
+    CPPUNIT_ASSERT(reply.get() == NULL);
+    CPPUNIT_ASSERT_EQUAL(0, requestor.getOutstandingRequestCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testAsyncRequestTimeout() {
+
+    MockService service(false);
+    Requestor requestor(service.connection.get());
+    ActiveMQQueue queue(REQUEST_QUEUE);
+
+    ActiveMQTextMessage request;
+    request.setText("hello");
+
+    Pointer<Requestor::ReplyFuture> future = requestor.requestAsync(&queue, &request, 100);
+    CPPUNIT_ASSERT(future->await(10000, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT(future->isCompletedExceptionally());
+    CPPUNIT_ASSERT_EQUAL(0, requestor.getOutstandingRequestCount());
+
+    try {
+        future->get();
+        CPPUNIT_FAIL("Should have thrown an ExecutionException");
+    } catch (ExecutionException& ex) {
+        CPPUNIT_ASSERT(dynamic_cast<const TimeoutException*>(ex.getCause()) != NULL);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testLateReplyIgnored() {
+
+    MockService service(false);
+    Requestor requestor(service.connection.get());
+    ActiveMQQueue queue(REQUEST_QUEUE);
+
+    ActiveMQTextMessage late;
+    late.setText("late");
+    CPPUNIT_ASSERT(requestor.request(&queue, &late, 50) == NULL);
+
+    ActiveMQTextMessage request;
+    request.setText("hello");
+    Pointer<Requestor::ReplyFuture> future = requestor.requestAsync(&queue, &request, 0);
+
+    // The reply to the abandoned request must not be taken for the current one.
+    service.responder->reply(service.responder->getRequest(0));
+    service.responder->reply(service.responder->getRequest(1));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("reply:hello"), replyText(future));
+    CPPUNIT_ASSERT_EQUAL(0, requestor.getOutstandingRequestCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testCloseFailsOutstanding() {
+
+    MockService service(false);
+    Requestor requestor(service.connection.get());
+    ActiveMQQueue queue(REQUEST_QUEUE);
+
+    ActiveMQTextMessage request;
+    request.setText("hello");
+
+    Pointer<Requestor::ReplyFuture> future = requestor.requestAsync(&queue, &request, 0);
+    CPPUNIT_ASSERT(!future->isDone());
+
+    requestor.close();
+    CPPUNIT_ASSERT(future->isCompletedExceptionally());
+    CPPUNIT_ASSERT_EQUAL(0, requestor.getOutstandingRequestCount());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a cms::IllegalStateException",
+        requestor.requestAsync(&queue, &request, 0),
+        cms::IllegalStateException);
+
+    requestor.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void RequestorTest::testRepliesCancelTimeouts() {
+
+    MockService service(true);
+    Requestor requestor(service.connection.get());
+    ActiveMQQueue queue(REQUEST_QUEUE);
+
+    // Enough replies to cancel timeouts past the point where the timer is purged.
+    std::vector< Pointer<Requestor::ReplyFuture> > futures;
+    for (int i = 0; i < 300; ++i) {
+        ActiveMQTextMessage request;
+        request.setText(Integer::toString(i));
+        futures.push_back(requestor.requestAsync(&queue, &request, 60000));
+    }
+
+    for (int i = 0; i < 300; ++i) {
+        CPPUNIT_ASSERT_EQUAL("reply:" + Integer::toString(i), replyText(futures[i]));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, requestor.getOutstandingRequestCount());
+}
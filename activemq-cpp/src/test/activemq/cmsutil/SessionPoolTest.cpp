@@ -19,8 +19,80 @@
 #include "DummyConnection.h"
 #include <activemq/cmsutil/SessionPool.h>
 #include <activemq/cmsutil/ResourceLifecycleManager.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
 
 using namespace activemq::cmsutil;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Takes a session twice from its own thread, returning it in between.
+    class TakeTwiceTask : public Runnable {
+    private:
+
+        SessionPool* pool;
+
+    private:
+
+        TakeTwiceTask(const TakeTwiceTask&);
+        TakeTwiceTask& operator=(const TakeTwiceTask&);
+
+    public:
+
+        PooledSession* first;
+        PooledSession* second;
+
+        TakeTwiceTask(SessionPool* pool) : Runnable(), pool(pool), first(NULL), second(NULL) {
+        }
+
+        virtual ~TakeTwiceTask() {}
+
+        virtual void run() {
+            first = pool->takeSession();
+            first->close();
+            second = pool->takeSession();
+            second->close();
+        }
+    };
+
+    // Takes two sessions from its own thread without returning the first.
+    class TakeTwoTask : public Runnable {
+    private:
+
+        SessionPool* pool;
+
+    private:
+
+        TakeTwoTask(const TakeTwoTask&);
+        TakeTwoTask& operator=(const TakeTwoTask&);
+
+    public:
+
+        PooledSession* first;
+        PooledSession* second;
+
+        TakeTwoTask(SessionPool* pool) : Runnable(), pool(pool), first(NULL), second(NULL) {
+        }
+
+        virtual ~TakeTwoTask() {}
+
+        virtual void run() {
+            first = pool->takeSession();
+            second = pool->takeSession();
+            first->close();
+            second->close();
+        }
+    };
+
+    template<typename TASK>
+    void runInThread(TASK& task) {
+        Thread thread(&task);
+        thread.start();
+        thread.join();
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 void SessionPoolTest::testTakeSession() {
@@ -87,3 +159,83 @@ void SessionPoolTest::testCloseSession() {
     // Make sure they're the same object.
     CPPUNIT_ASSERT(pooledSession1 == pooledSession2); 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionPoolTest::testThreadBoundSession() {
+
+    DummyConnection connection(NULL);
+    ResourceLifecycleManager mgr;
+
+    SessionPool pool(&connection, cms::Session::AUTO_ACKNOWLEDGE, &mgr, 2);
+    CPPUNIT_ASSERT_EQUAL(2, pool.getMaxBoundSessions());
+
+    // This thread keeps its session even when taking two at once.
+    PooledSession* pooledSession1 = pool.takeSession();
+    PooledSession* pooledSession2 = pool.takeSession();
+    CPPUNIT_ASSERT(pooledSession1 == pooledSession2);
+    pooledSession1->close();
+
+    // Another thread gets a session of its own, and keeps it too.
+    TakeTwiceTask task1(&pool);
+    runInThread(task1);
+    CPPUNIT_ASSERT(task1.first != pooledSession1);
+    CPPUNIT_ASSERT(task1.first == task1.second);
+
+    // The first thread has ended so the next one reuses its session.
+    TakeTwiceTask task2(&pool);
+    runInThread(task2);
+    CPPUNIT_ASSERT(task2.first == task1.first);
+    CPPUNIT_ASSERT(task2.first == task2.second);
+
+    CPPUNIT_ASSERT(pool.takeSession() == pooledSession1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionPoolTest::testThreadBoundSessionLimit() {
+
+    DummyConnection connection(NULL);
+    ResourceLifecycleManager mgr;
+
+    SessionPool pool(&connection, cms::Session::AUTO_ACKNOWLEDGE, &mgr, 1);
+
+    PooledSession* pooledSession1 = pool.takeSession();
+    CPPUNIT_ASSERT(pooledSession1 != NULL);
+
+    // The only binding is taken, the other thread shares the pool as usual.
+    TakeTwoTask task(&pool);
+    runInThread(task);
+    CPPUNIT_ASSERT(task.first != pooledSession1);
+    CPPUNIT_ASSERT(task.second != pooledSession1);
+    CPPUNIT_ASSERT(task.first != task.second);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionPoolTest::testReleaseThreadSession() {
+
+    DummyConnection connection(NULL);
+    ResourceLifecycleManager mgr;
+
+    SessionPool pool(&connection, cms::Session::AUTO_ACKNOWLEDGE, &mgr, 1);
+
+    // Nothing bound yet, releasing does nothing.
+    pool.releaseThreadSession();
+
+    PooledSession* pooledSession1 = pool.takeSession();
+    CPPUNIT_ASSERT(pool.takeSession() == pooledSession1);
+
+    // While bound the only binding is taken, other threads share the pool.
+    TakeTwoTask task1(&pool);
+    runInThread(task1);
+    CPPUNIT_ASSERT(task1.first != pooledSession1);
+    CPPUNIT_ASSERT(task1.second != pooledSession1);
+
+    // Released, the session is available to another thread, which binds it.
+    pool.releaseThreadSession();
+    TakeTwiceTask task2(&pool);
+    runInThread(task2);
+    CPPUNIT_ASSERT(task2.first == task2.second);
+
+    PooledSession* pooledSession2 = pool.takeSession();
+    CPPUNIT_ASSERT(pooledSession2 != NULL);
+    CPPUNIT_ASSERT(pool.takeSession() == pooledSession2);
+}
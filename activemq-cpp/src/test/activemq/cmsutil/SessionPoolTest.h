@@ -30,6 +30,9 @@ namespace cmsutil{
         CPPUNIT_TEST( testTakeSession );
         CPPUNIT_TEST( testReturnSession );
         CPPUNIT_TEST( testCloseSession );
+        CPPUNIT_TEST( testThreadBoundSession );
+        CPPUNIT_TEST( testThreadBoundSessionLimit );
+        CPPUNIT_TEST( testReleaseThreadSession );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -40,6 +43,9 @@ namespace cmsutil{
         void testTakeSession();
         void testReturnSession();
         void testCloseSession();
+        void testThreadBoundSession();
+        void testThreadBoundSessionLimit();
+        void testReleaseThreadSession();
     };
 
 }}
@@ -18,6 +18,8 @@
 #include "ActiveMQBytesMessageTest.h"
 
 #include <decaf/util/UUID.h>
+#include <decaf/io/File.h>
+#include <decaf/io/FileOutputStream.h>
 #include <decaf/lang/Exception.h>
 #include <activemq/commands/ActiveMQBytesMessage.h>
 
@@ -28,6 +30,8 @@ using namespace activemq::util;
 using namespace activemq::commands;
 using namespace decaf;
 using namespace decaf::lang;
+using namespace decaf::io;
+using namespace decaf::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessageTest::testGetBodyLength() {
@@ -459,3 +463,62 @@ void ActiveMQBytesMessageTest::testWriteOnlyBody() {
     } catch( MessageNotReadableException& e ) {
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageTest::testSetBodyFromFile() {
+
+    std::string fileName = "ActiveMQBytesMessageTest-" + UUID::randomUUID().toString();
+
+    {
+        FileOutputStream out(fileName);
+        for (int i = 0; i < 100; ++i) {
+            out.write((unsigned char) i);
+        }
+    }
+
+    ActiveMQBytesMessage message;
+    message.writeInt(42);
+    message.setBodyFromFile(fileName, 10, 20);
+
+    CPPUNIT_ASSERT(message.getMappedContent() != NULL);
+    CPPUNIT_ASSERT(message.getContent().empty());
+    CPPUNIT_ASSERT_EQUAL(20, message.getContentSize());
+
+    message.reset();
+    CPPUNIT_ASSERT_EQUAL(20, message.getBodyLength());
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 10, message.readByte());
+
+    // Copies share the read-only mapping.
+    std::auto_ptr<cms::BytesMessage> copy(message.clone());
+    ActiveMQBytesMessage* copied = dynamic_cast<ActiveMQBytesMessage*>(copy.get());
+    CPPUNIT_ASSERT(copied->getMappedContent() == message.getMappedContent());
+
+    // Writing to a copy appends to the mapped bytes without touching the file.
+    copied->writeByte(200);
+    CPPUNIT_ASSERT(copied->getMappedContent() == NULL);
+    copied->reset();
+    CPPUNIT_ASSERT_EQUAL(21, copied->getBodyLength());
+    std::vector<unsigned char> body(21);
+    copied->readBytes(body);
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 29, body[19]);
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 200, body[20]);
+
+    message.clearBody();
+    CPPUNIT_ASSERT(message.getMappedContent() == NULL);
+    CPPUNIT_ASSERT_EQUAL(0, message.getContentSize());
+
+    try {
+        message.reset();
+        message.setBodyFromFile(fileName);
+        CPPUNIT_FAIL("Should have thrown exception");
+    } catch (MessageNotWriteableException& ex) {
+    }
+
+    message.clearBody();
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a CMSException",
+        message.setBodyFromFile(fileName, 101),
+        CMSException);
+
+    File(fileName).remove();
+}
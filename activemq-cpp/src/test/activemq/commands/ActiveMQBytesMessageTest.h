@@ -43,6 +43,7 @@ namespace commands{
         CPPUNIT_TEST( testReset );
         CPPUNIT_TEST( testReadOnlyBody );
         CPPUNIT_TEST( testWriteOnlyBody );
+        CPPUNIT_TEST( testSetBodyFromFile );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -67,6 +68,7 @@ namespace commands{
         void testReset();
         void testReadOnlyBody();
         void testWriteOnlyBody();
+        void testSetBodyFromFile();
 
     };
 
@@ -475,3 +475,40 @@ void ActiveMQMapMessageTest::testWriteOnlyBody() {
     msg.getShort( "short" );
     msg.getString( "string" );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageTest::testMarshalledBodyReused() {
+
+    ActiveMQMapMessage msg;
+    msg.setInt( "count", 1 );
+    msg.setString( "name", "first" );
+
+    msg.beforeMarshal( NULL );
+    std::vector<unsigned char> encoded = msg.getContent();
+    CPPUNIT_ASSERT( !encoded.empty() );
+
+    // An unchanged map keeps the previous encoding rather than being marshaled again.
+    msg.getContent().back() ^= 0xFF;
+    msg.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( msg.getContent() != encoded );
+
+    msg.setInt( "count", 1 );
+    msg.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( msg.getContent() == encoded );
+
+    // A body decoded on receipt is sent on as it arrived.
+    ActiveMQMapMessage received;
+    received.setContent( encoded );
+    CPPUNIT_ASSERT( received.getString( "name" ) == "first" );
+    received.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( received.getContent() == encoded );
+
+    received.setString( "name", "second" );
+    received.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( received.getContent() != encoded );
+
+    ActiveMQMapMessage copy;
+    copy.setContent( received.getContent() );
+    CPPUNIT_ASSERT( copy.getString( "name" ) == "second" );
+    CPPUNIT_ASSERT( copy.getInt( "count" ) == 1 );
+}
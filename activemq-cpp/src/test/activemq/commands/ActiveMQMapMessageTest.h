@@ -44,6 +44,7 @@ namespace commands{
         CPPUNIT_TEST( testClearBody );
         CPPUNIT_TEST( testReadOnlyBody );
         CPPUNIT_TEST( testWriteOnlyBody );
+        CPPUNIT_TEST( testMarshalledBodyReused );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -72,6 +73,7 @@ namespace commands{
         void testClearBody();
         void testReadOnlyBody();
         void testWriteOnlyBody();
+        void testMarshalledBodyReused();
 
     };
 
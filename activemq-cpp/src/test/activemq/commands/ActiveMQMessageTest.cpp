@@ -818,3 +818,41 @@ void ActiveMQMessageTest::testIsExpired() {
     msg.setCMSExpiration( System::currentTimeMillis() + 10000 );
     CPPUNIT_ASSERT( !msg.isExpired() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageTest::testMarshalledPropertiesReused() {
+
+    ActiveMQMessage msg;
+    msg.setIntProperty( "count", 1 );
+    msg.setStringProperty( "name", "first" );
+
+    msg.beforeMarshal( NULL );
+    std::vector<unsigned char> encoded = msg.getMarshalledProperties();
+    CPPUNIT_ASSERT( !encoded.empty() );
+
+    // Unchanged properties keep the previous encoding rather than being marshaled again.
+    msg.getMarshalledProperties().back() ^= 0xFF;
+    msg.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( msg.getMarshalledProperties() != encoded );
+
+    msg.setIntProperty( "count", 1 );
+    msg.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( msg.getMarshalledProperties() == encoded );
+
+    msg.setStringProperty( "name", "second" );
+    msg.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( msg.getMarshalledProperties() != encoded );
+
+    // What was received is what gets sent on.
+    ActiveMQMessage received;
+    received.setMarshalledProperties( msg.getMarshalledProperties() );
+    received.afterUnmarshal( NULL );
+    CPPUNIT_ASSERT( received.getStringProperty( "name" ) == "second" );
+    received.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( received.getMarshalledProperties() == msg.getMarshalledProperties() );
+
+    msg.clearProperties();
+    msg.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( msg.getMarshalledProperties().empty() );
+}
+
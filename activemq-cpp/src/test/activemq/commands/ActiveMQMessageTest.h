@@ -75,6 +75,7 @@ namespace commands{
         CPPUNIT_TEST( testDoublePropertyConversion );
         CPPUNIT_TEST( testReadOnlyProperties );
         CPPUNIT_TEST( testIsExpired );
+        CPPUNIT_TEST( testMarshalledPropertiesReused );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -142,6 +143,7 @@ namespace commands{
         void testStringPropertyConversion();
         void testReadOnlyProperties();
         void testIsExpired();
+        void testMarshalledPropertiesReused();
 
     };
 
@@ -340,3 +340,37 @@ void ActiveMQConnectionFactoryTest::testURIOptionsProcessing() {
 
     CPPUNIT_ASSERT( false );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactoryTest::testURIOptionsProcessingPooledDispatch() {
+
+    try
+    {
+        std::string URI =
+            "mock://127.0.0.1:23232?connection.useDedicatedTaskRunner=false&"
+            "connection.sessionTaskPoolSize=3";
+
+        ActiveMQConnectionFactory connectionFactory( URI );
+
+        CPPUNIT_ASSERT( connectionFactory.isUseDedicatedTaskRunner() == false );
+        CPPUNIT_ASSERT( connectionFactory.getSessionTaskPoolSize() == 3 );
+
+        cms::Connection* connection =
+            connectionFactory.createConnection();
+
+        CPPUNIT_ASSERT( connection != NULL );
+
+        ActiveMQConnection* amqConnection = dynamic_cast<ActiveMQConnection*>( connection );
+
+        CPPUNIT_ASSERT( amqConnection->isUseDedicatedTaskRunner() == false );
+        CPPUNIT_ASSERT( amqConnection->getSessionTaskPoolSize() == 3 );
+
+        delete connection;
+
+        return;
+    }
+    AMQ_CATCH_NOTHROW( exceptions::ActiveMQException )
+    AMQ_CATCHALL_NOTHROW( )
+
+    CPPUNIT_ASSERT( false );
+}
@@ -21,16 +21,23 @@
 #include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/transport/TransportRegistry.h>
 #include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ConsumerControl.h>
 #include <activemq/commands/ConsumerId.h>
 #include <activemq/commands/MessageDispatch.h>
 #include <activemq/core/ActiveMQConnectionFactory.h>
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/ActiveMQConsumer.h>
 #include <activemq/core/ActiveMQProducer.h>
+#include <activemq/core/PrefetchPolicy.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <decaf/util/ArrayList.h>
 #include <decaf/util/Properties.h>
+#include <decaf/lang/Integer.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
 #include <decaf/net/Socket.h>
 #include <decaf/net/ServerSocket.h>
 
@@ -101,6 +108,29 @@ namespace core {
             AMQ_CATCHALL_THROW( activemq::exceptions::ActiveMQException )
         }
     };
+
+    class MyAsyncCallback : public cms::AsyncCallback {
+    public:
+
+        decaf::util::concurrent::CountDownLatch done;
+        bool failed;
+
+    public:
+
+        MyAsyncCallback() : done(1), failed(false) {
+        }
+
+        virtual ~MyAsyncCallback() {}
+
+        virtual void onSuccess() {
+            done.countDown();
+        }
+
+        virtual void onException(const cms::CMSException& ex AMQCPP_UNUSED) {
+            failed = true;
+            done.countDown();
+        }
+    };
 }}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -556,6 +586,60 @@ void ActiveMQSessionTest::testTransactionCloseWithoutCommit() {
     session->close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testTransactionCommitAsync() {
+
+    CPPUNIT_ASSERT( connection.get() != NULL );
+
+    std::auto_ptr<ActiveMQSession> session(
+        dynamic_cast<ActiveMQSession*>( connection->createSession( cms::Session::SESSION_TRANSACTED ) ) );
+    CPPUNIT_ASSERT( session.get() != NULL );
+
+    std::auto_ptr<cms::Topic> topic1( session->createTopic( "TestTopic1" ) );
+    std::auto_ptr<cms::MessageProducer> producer( session->createProducer( topic1.get() ) );
+    std::auto_ptr<cms::TextMessage> message( session->createTextMessage( "This is a Test" ) );
+
+    // Send only transactions are committed without waiting on the broker.
+    MyAsyncCallback first;
+    MyAsyncCallback second;
+
+    producer->send( message.get() );
+    producer->send( message.get() );
+    session->commitAsync( &first );
+
+    producer->send( message.get() );
+    session->commitAsync( &second );
+
+    CPPUNIT_ASSERT( first.done.await( 2000 ) );
+    CPPUNIT_ASSERT( second.done.await( 2000 ) );
+    CPPUNIT_ASSERT( !first.failed );
+    CPPUNIT_ASSERT( !second.failed );
+
+    // A transaction that consumed messages completes before commitAsync returns.
+    MyCMSMessageListener msgListener;
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic1.get() ) ) );
+    consumer->setMessageListener( &msgListener );
+
+    injectTextMessage( "This is a Test 1" , *topic1, *( consumer->getConsumerId() ) );
+    msgListener.asyncWaitForMessages( 1 );
+    CPPUNIT_ASSERT_EQUAL( 1, (int)msgListener.messages.size() );
+
+    MyAsyncCallback third;
+    session->commitAsync( &third );
+    CPPUNIT_ASSERT_EQUAL( 0, third.done.getCount() );
+    CPPUNIT_ASSERT( !third.failed );
+
+    // Nothing to commit still reports success.
+    MyAsyncCallback fourth;
+    session->commitAsync( &fourth );
+    CPPUNIT_ASSERT( fourth.done.await( 2000 ) );
+    CPPUNIT_ASSERT( !fourth.failed );
+
+    consumer->close();
+    session->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::testExpiration() {
 
@@ -694,6 +778,199 @@ void ActiveMQSessionTest::testCreateTempTopicByName() {
     CPPUNIT_ASSERT(topic->getDestinationType() == cms::Destination::TEMPORARY_TOPIC);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ConsumerControlListener : public transport::DefaultTransportListener {
+    public:
+
+        decaf::util::concurrent::CountDownLatch shrunk;
+        decaf::util::concurrent::atomic::AtomicInteger lastPrefetch;
+        int initialPrefetch;
+
+        ConsumerControlListener(int initialPrefetch) :
+            shrunk(1), lastPrefetch(-1), initialPrefetch(initialPrefetch) {}
+        virtual ~ConsumerControlListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            if (command->isConsumerControl()) {
+                int prefetch = command.dynamicCast<ConsumerControl>()->getPrefetch();
+                lastPrefetch.set(prefetch);
+                if (prefetch < initialPrefetch) {
+                    shrunk.countDown();
+                }
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testAdaptivePrefetchShrinksStalledConsumer() {
+
+    connection->getPrefetchPolicy()->setAdaptive(true);
+    connection->getPrefetchPolicy()->setAdaptiveInterval(50);
+
+    ConsumerControlListener listener(connection->getPrefetchPolicy()->getQueuePrefetch());
+    dTransport->setOutgoingListener(&listener);
+
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    std::auto_ptr<cms::Queue> queue(session->createQueue("TestAdaptivePrefetch"));
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>(session->createConsumer(queue.get())));
+
+    // Nobody is receiving so the messages sit in the dispatch queue.
+    for (int i = 0; i < 10; ++i) {
+        injectTextMessage("Not consumed", *queue, *(consumer->getConsumerId()));
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Stalled consumer should ask for a smaller window", listener.shrunk.await(5000));
+    CPPUNIT_ASSERT(listener.lastPrefetch.get() > 0);
+    CPPUNIT_ASSERT(listener.lastPrefetch.get() < listener.initialPrefetch);
+
+    consumer->close();
+    dTransport->setOutgoingListener(NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class SentMessageListener : public transport::DefaultTransportListener {
+    public:
+
+        std::vector< Pointer<commands::Message> > messages;
+
+        SentMessageListener() : messages() {}
+        virtual ~SentMessageListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            if (command->isMessage()) {
+                messages.push_back(command.dynamicCast<commands::Message>());
+            }
+        }
+    };
+
+    void createBatch(cms::Session* session, int count,
+                     std::vector< Pointer<cms::Message> >& owned,
+                     decaf::util::ArrayList<cms::Message*>& batch) {
+
+        for (int i = 0; i < count; ++i) {
+            owned.push_back(Pointer<cms::Message>(
+                session->createTextMessage(std::string("Batch ") + Integer::toString(i))));
+            batch.add(owned.back().get());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testProducerSendBatch() {
+
+    SentMessageListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    std::auto_ptr<cms::Queue> queue(session->createQueue("TestSendBatch"));
+    std::auto_ptr<ActiveMQProducer> producer(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+    producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+
+    std::vector< Pointer<cms::Message> > owned;
+    decaf::util::ArrayList<cms::Message*> batch;
+    createBatch(session.get(), 5, owned, batch);
+
+    int batches = dTransport->getNumSentBatches();
+    producer->sendBatch(batch);
+
+    // Messages that need no response go out as one write, in order, with one timestamp
+    // and consecutive sequence ids.
+    CPPUNIT_ASSERT_EQUAL(batches + 1, dTransport->getNumSentBatches());
+    CPPUNIT_ASSERT_EQUAL(5, (int) sent.messages.size());
+
+    long long firstSequence = sent.messages[0]->getMessageId()->getProducerSequenceId();
+    for (int i = 0; i < 5; ++i) {
+        Pointer<commands::Message> message = sent.messages[i];
+        CPPUNIT_ASSERT_EQUAL(firstSequence + i, message->getMessageId()->getProducerSequenceId());
+        CPPUNIT_ASSERT_EQUAL(std::string("Batch ") + Integer::toString(i),
+                             message.dynamicCast<ActiveMQTextMessage>()->getText());
+        CPPUNIT_ASSERT_EQUAL(message->getMessageId()->toString(), batch.get(i)->getCMSMessageID());
+        CPPUNIT_ASSERT_EQUAL(sent.messages[0]->getTimestamp(), message->getTimestamp());
+        CPPUNIT_ASSERT(!message->isPersistent());
+    }
+    CPPUNIT_ASSERT(sent.messages[0]->getTimestamp() > 0);
+
+    // A single send carries on from the batch.
+    producer->send(batch.get(0));
+    CPPUNIT_ASSERT_EQUAL(6, (int) sent.messages.size());
+    CPPUNIT_ASSERT_EQUAL(firstSequence + 5, sent.messages[5]->getMessageId()->getProducerSequenceId());
+
+    producer->close();
+    dTransport->setOutgoingListener(NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testProducerSendBatchPersistent() {
+
+    SentMessageListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    std::auto_ptr<cms::Queue> queue(session->createQueue("TestSendBatchPersistent"));
+    std::auto_ptr<ActiveMQProducer> producer(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+    producer->setDeliveryMode(cms::DeliveryMode::PERSISTENT);
+
+    std::vector< Pointer<cms::Message> > owned;
+    decaf::util::ArrayList<cms::Message*> batch;
+    createBatch(session.get(), 3, owned, batch);
+
+    int batches = dTransport->getNumSentBatches();
+    producer->sendBatch(batch);
+
+    // Persistent messages are still sent one at a time and wait for the broker.
+    CPPUNIT_ASSERT_EQUAL(batches, dTransport->getNumSentBatches());
+    CPPUNIT_ASSERT_EQUAL(3, (int) sent.messages.size());
+    for (int i = 0; i < 3; ++i) {
+        CPPUNIT_ASSERT(sent.messages[i]->isPersistent());
+        CPPUNIT_ASSERT(sent.messages[i]->isResponseRequired());
+        CPPUNIT_ASSERT_EQUAL(std::string("Batch ") + Integer::toString(i),
+                             sent.messages[i].dynamicCast<ActiveMQTextMessage>()->getText());
+    }
+
+    producer->close();
+    dTransport->setOutgoingListener(NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testProducerSendBatchTransacted() {
+
+    SentMessageListener sent;
+    dTransport->setOutgoingListener(&sent);
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::SESSION_TRANSACTED));
+    std::auto_ptr<cms::Queue> queue(session->createQueue("TestSendBatchTransacted"));
+    std::auto_ptr<ActiveMQProducer> producer(
+        dynamic_cast<ActiveMQProducer*>(session->createProducer(queue.get())));
+    producer->setDeliveryMode(cms::DeliveryMode::PERSISTENT);
+
+    std::vector< Pointer<cms::Message> > owned;
+    decaf::util::ArrayList<cms::Message*> batch;
+    createBatch(session.get(), 4, owned, batch);
+
+    int batches = dTransport->getNumSentBatches();
+    producer->sendBatch(batch);
+
+    // Inside a transaction persistent messages need no response, so they are batched.
+    CPPUNIT_ASSERT_EQUAL(batches + 1, dTransport->getNumSentBatches());
+    CPPUNIT_ASSERT_EQUAL(4, (int) sent.messages.size());
+    CPPUNIT_ASSERT(sent.messages[0]->getTransactionId() != NULL);
+    for (int i = 1; i < 4; ++i) {
+        CPPUNIT_ASSERT(sent.messages[0]->getTransactionId()->equals(sent.messages[i]->getTransactionId().get()));
+    }
+
+    session->commit();
+    producer->close();
+    dTransport->setOutgoingListener(NULL);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::setUp() {
 
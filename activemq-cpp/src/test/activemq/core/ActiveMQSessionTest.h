@@ -47,10 +47,15 @@ namespace core{
         CPPUNIT_TEST( testTransactionRollbackOneConsumer );
         CPPUNIT_TEST( testTransactionRollbackTwoConsumer );
         CPPUNIT_TEST( testTransactionCloseWithoutCommit );
+        CPPUNIT_TEST( testTransactionCommitAsync );
         CPPUNIT_TEST( testExpiration );
         CPPUNIT_TEST( testCreateManyConsumersAndSetListeners );
         CPPUNIT_TEST( testCreateTempQueueByName );
         CPPUNIT_TEST( testCreateTempTopicByName );
+        CPPUNIT_TEST( testAdaptivePrefetchShrinksStalledConsumer );
+        CPPUNIT_TEST( testProducerSendBatch );
+        CPPUNIT_TEST( testProducerSendBatchPersistent );
+        CPPUNIT_TEST( testProducerSendBatchTransacted );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -104,9 +109,14 @@ namespace core{
         void testTransactionRollbackTwoConsumer();
         void testTransactionCloseWithoutCommit();
         void testTransactionCommitAfterConsumerClosed();
+        void testTransactionCommitAsync();
         void testExpiration();
         void testCreateTempQueueByName();
         void testCreateTempTopicByName();
+        void testAdaptivePrefetchShrinksStalledConsumer();
+        void testProducerSendBatch();
+        void testProducerSendBatchPersistent();
+        void testProducerSendBatchTransacted();
 
     };
 
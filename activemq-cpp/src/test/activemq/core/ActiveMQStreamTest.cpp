@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveMQStreamTest.h"
+
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/core/ActiveMQConsumer.h>
+#include <activemq/core/ActiveMQInputStream.h>
+#include <activemq/core/ActiveMQOutputStream.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <decaf/io/IOException.h>
+#include <decaf/util/ArrayList.h>
+
+#include <cms/BytesMessage.h>
+
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class ChunkRecorder : public DefaultTransportListener {
+    public:
+
+        ArrayList<Pointer<Message> > messages;
+
+        ChunkRecorder() : messages() {}
+
+        virtual ~ChunkRecorder() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            if (command->isMessage()) {
+                messages.add(command.dynamicCast<Message>());
+            }
+        }
+    };
+
+    void dispatch(transport::mock::MockTransport* transport, const Pointer<Message>& message,
+                  ActiveMQInputStream& stream) {
+
+        ActiveMQConsumer* consumer = dynamic_cast<ActiveMQConsumer*>(stream.getConsumer());
+
+        Pointer<Message> copy(message->cloneDataStructure());
+        Pointer<MessageDispatch> dispatch(new MessageDispatch());
+        dispatch->setMessage(copy);
+        dispatch->setConsumerId(Pointer<ConsumerId>(consumer->getConsumerId()->cloneDataStructure()));
+        dispatch->setDestination(copy->getDestination());
+        transport->fireCommand(dispatch);
+    }
+
+    std::vector<unsigned char> createPayload(int size) {
+        std::vector<unsigned char> payload(size);
+        for (int i = 0; i < size; ++i) {
+            payload[i] = (unsigned char) (i * 31 + 7);
+        }
+        return payload;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQStreamTest::ActiveMQStreamTest() : connection(), transport(NULL) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQStreamTest::~ActiveMQStreamTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::setUp() {
+
+    ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire");
+    connection.reset(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+
+    transport = dynamic_cast<transport::mock::MockTransport*>(
+        connection->getTransport().narrow(typeid(transport::mock::MockTransport)));
+    CPPUNIT_ASSERT(transport != NULL);
+
+    connection->start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::tearDown() {
+    transport->setOutgoingListener(NULL);
+    connection.reset(NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testChunking() {
+
+    // Declared first so it outlives the session, which sends commands as it closes.
+    ChunkRecorder recorder;
+    transport->setOutgoingListener(&recorder);
+
+    const int CHUNK_SIZE = 1000;
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    std::auto_ptr<cms::Queue> queue(session->createQueue("stream"));
+
+    std::vector<unsigned char> payload = createPayload(10500);
+
+    ActiveMQOutputStream out(session.get(), queue.get(), CHUNK_SIZE);
+    CPPUNIT_ASSERT_EQUAL(CHUNK_SIZE, out.getChunkSize());
+
+    // Mix single bytes, partial and oversized writes.
+    out.write(payload[0]);
+    out.write(&payload[0], (int) payload.size(), 1, 499);
+    out.write(&payload[0], (int) payload.size(), 500, 10000);
+    CPPUNIT_ASSERT_EQUAL(10, out.getChunksSent());
+    out.close();
+
+    CPPUNIT_ASSERT_EQUAL(11, out.getChunksSent());
+    CPPUNIT_ASSERT_EQUAL(12, recorder.messages.size());
+
+    for (int i = 0; i < recorder.messages.size(); ++i) {
+        Pointer<Message> message = recorder.messages.get(i);
+        CPPUNIT_ASSERT_EQUAL(out.getStreamId(), message->getGroupID());
+
+        if (i < 11) {
+            CPPUNIT_ASSERT_EQUAL(i + 1, message->getGroupSequence());
+            cms::BytesMessage* chunk = dynamic_cast<cms::BytesMessage*>(message.get());
+            CPPUNIT_ASSERT(chunk != NULL);
+            CPPUNIT_ASSERT_EQUAL(i < 10 ? CHUNK_SIZE : 500, (int) message->getContent().size());
+        } else {
+            CPPUNIT_ASSERT_EQUAL(-1, message->getGroupSequence());
+            CPPUNIT_ASSERT(dynamic_cast<cms::BytesMessage*>(message.get()) == NULL);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testRoundTrip() {
+
+    ChunkRecorder recorder;
+    transport->setOutgoingListener(&recorder);
+
+    const int CHUNK_SIZE = 4096;
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::CLIENT_ACKNOWLEDGE));
+    std::auto_ptr<cms::Queue> queue(session->createQueue("stream?consumer.prefetchSize=4"));
+
+    std::vector<unsigned char> payload = createPayload(100000);
+
+    {
+        ActiveMQOutputStream out(session.get(), queue.get(), CHUNK_SIZE);
+        out.write(&payload[0], (int) payload.size(), 0, (int) payload.size());
+    }
+
+    transport->setOutgoingListener(NULL);
+
+    ActiveMQInputStream in(session.get(), queue.get(), "", 5000);
+
+    for (int i = 0; i < recorder.messages.size(); ++i) {
+        dispatch(transport, recorder.messages.get(i), in);
+    }
+
+    std::vector<unsigned char> received;
+    unsigned char buffer[3000];
+    int count = 0;
+    while ((count = in.read(buffer, (int) sizeof(buffer), 0, (int) sizeof(buffer))) != -1) {
+        received.insert(received.end(), buffer, buffer + count);
+        CPPUNIT_ASSERT(count <= CHUNK_SIZE);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(recorder.messages.get(0)->getGroupID(), in.getStreamId());
+    CPPUNIT_ASSERT_EQUAL(payload.size(), received.size());
+    CPPUNIT_ASSERT(payload == received);
+    CPPUNIT_ASSERT_EQUAL(-1, in.read());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testEmptyStream() {
+
+    ChunkRecorder recorder;
+    transport->setOutgoingListener(&recorder);
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    std::auto_ptr<cms::Queue> queue(session->createQueue("stream"));
+
+    {
+        ActiveMQOutputStream out(session.get(), queue.get());
+        out.flush();
+    }
+
+    transport->setOutgoingListener(NULL);
+    CPPUNIT_ASSERT_EQUAL(1, recorder.messages.size());
+
+    ActiveMQInputStream in(session.get(), queue.get(), "", 5000);
+    dispatch(transport, recorder.messages.get(0), in);
+
+    CPPUNIT_ASSERT_EQUAL(-1, in.read());
+    CPPUNIT_ASSERT_EQUAL(0, in.available());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testOutOfSequenceChunk() {
+
+    ChunkRecorder recorder;
+    transport->setOutgoingListener(&recorder);
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    std::auto_ptr<cms::Queue> queue(session->createQueue("stream"));
+
+    std::vector<unsigned char> payload = createPayload(300);
+
+    {
+        ActiveMQOutputStream out(session.get(), queue.get(), 100);
+        out.write(&payload[0], (int) payload.size(), 0, (int) payload.size());
+    }
+
+    transport->setOutgoingListener(NULL);
+
+    ActiveMQInputStream in(session.get(), queue.get(), "", 5000);
+    dispatch(transport, recorder.messages.get(1), in);
+
+    unsigned char buffer[100];
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        in.read(buffer, 100, 0, 100),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testReadTimeout() {
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    std::auto_ptr<cms::Queue> queue(session->createQueue("stream"));
+
+    ActiveMQInputStream in(session.get(), queue.get(), "", 100);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        in.read(),
+        IOException);
+
+    in.close();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        in.read(),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testWriteAfterClose() {
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    std::auto_ptr<cms::Queue> queue(session->createQueue("stream"));
+
+    ActiveMQOutputStream out(session.get(), queue.get());
+    out.close();
+    out.close();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        out.write('A'),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamTest::testCloseAfterFailedFlush() {
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    std::auto_ptr<cms::Queue> queue(session->createQueue("stream"));
+
+    ActiveMQOutputStream out(session.get(), queue.get());
+    out.write('A');
+
+    transport->setFailOnSendMessage(true);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        out.close(),
+        IOException);
+
+    transport->setFailOnSendMessage(false);
+
+    // The failed close still ends the stream.
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        out.write('B'),
+        IOException);
+}
@@ -0,0 +1,309 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AdaptivePrefetchControllerTest.h"
+
+#include <activemq/core/AdaptivePrefetchController.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <deque>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    void consume(AdaptivePrefetchController& controller, int count) {
+        for (int i = 0; i < count; ++i) {
+            controller.messageConsumed();
+        }
+    }
+
+    /**
+     * A consumer in the simulated broker, messages are dispatched into its queue while
+     * it has fewer than window messages in flight and it processes one at a time.
+     */
+    struct SimulatedConsumer {
+        int serviceTime;
+        int window;
+        std::deque<long long> queue;
+        int inflight;
+        bool busy;
+        long long busyUntil;
+        long long enqueued;
+        int processed;
+        long long maxLatency;
+        Pointer<AdaptivePrefetchController> controller;
+
+        SimulatedConsumer(int serviceTime, int window) :
+            serviceTime(serviceTime), window(window), queue(), inflight(0), busy(false),
+            busyUntil(0), enqueued(0), processed(0), maxLatency(0), controller() {
+        }
+    };
+
+    struct SimulationResult {
+        int produced;
+        int fastProcessed;
+        int slowProcessed;
+        long long maxLatency;
+        long long finishTime;
+    };
+
+    /**
+     * Runs a millisecond resolution simulation of a queue with one fast and one slow
+     * consumer.  A producer sends 600 messages a second for ten seconds, the fast
+     * consumer can process 1000 a second and the slow one 100, so together they keep up
+     * only if the broker gives most of the work to the fast one.  The broker dispatches
+     * round robin to whichever consumers have room in their prefetch window.
+     */
+    SimulationResult simulate(bool adaptive) {
+
+        const int PREFETCH = 1000;
+        const long long INTERVAL = 100;
+        const long long PRODUCE_UNTIL = 10000;
+
+        std::vector<SimulatedConsumer> consumers;
+        consumers.push_back(SimulatedConsumer(1, PREFETCH));
+        consumers.push_back(SimulatedConsumer(10, PREFETCH));
+
+        if (adaptive) {
+            for (std::size_t i = 0; i < consumers.size(); ++i) {
+                consumers[i].controller.reset(new AdaptivePrefetchController(PREFETCH, 1, PREFETCH, INTERVAL, 0));
+            }
+        }
+
+        SimulationResult result = { 0, 0, 0, 0, 0 };
+        std::deque<long long> pending;
+        std::size_t next = 0;
+
+        for (long long now = 0; ; ++now) {
+
+            if (now < PRODUCE_UNTIL && now % 5 == 0) {
+                for (int i = 0; i < 3; ++i) {
+                    pending.push_back(now);
+                    result.produced++;
+                }
+            }
+
+            while (!pending.empty()) {
+                bool dispatched = false;
+                for (std::size_t k = 0; k < consumers.size(); ++k) {
+                    SimulatedConsumer& consumer = consumers[(next + k) % consumers.size()];
+                    if (consumer.inflight < consumer.window) {
+                        consumer.queue.push_back(pending.front());
+                        consumer.inflight++;
+                        pending.pop_front();
+                        next = (next + k + 1) % consumers.size();
+                        dispatched = true;
+                        break;
+                    }
+                }
+
+                if (!dispatched) {
+                    break;
+                }
+            }
+
+            bool idle = pending.empty();
+
+            for (std::size_t i = 0; i < consumers.size(); ++i) {
+                SimulatedConsumer& consumer = consumers[i];
+
+                if (consumer.busy && now >= consumer.busyUntil) {
+                    consumer.busy = false;
+                    consumer.inflight--;
+                    consumer.processed++;
+                    if (now - consumer.enqueued > consumer.maxLatency) {
+                        consumer.maxLatency = now - consumer.enqueued;
+                    }
+                    if (consumer.controller != NULL) {
+                        consumer.controller->messageConsumed();
+                    }
+                }
+
+                if (!consumer.busy && !consumer.queue.empty()) {
+                    consumer.enqueued = consumer.queue.front();
+                    consumer.queue.pop_front();
+                    consumer.busy = true;
+                    consumer.busyUntil = now + consumer.serviceTime;
+                }
+
+                if (consumer.controller != NULL && now > 0 && now % INTERVAL == 0) {
+                    if (consumer.controller->sample(now, (int) consumer.queue.size())) {
+                        consumer.window = consumer.controller->getPrefetch();
+                    }
+                }
+
+                idle = idle && !consumer.busy && consumer.queue.empty();
+            }
+
+            if (now >= PRODUCE_UNTIL && idle) {
+                result.finishTime = now;
+                break;
+            }
+        }
+
+        result.fastProcessed = consumers[0].processed;
+        result.slowProcessed = consumers[1].processed;
+        result.maxLatency = consumers[0].maxLatency > consumers[1].maxLatency ?
+                            consumers[0].maxLatency : consumers[1].maxLatency;
+
+        return result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testConstructor() {
+
+    AdaptivePrefetchController controller(5000, 10, 500, 1000, 0);
+    CPPUNIT_ASSERT_EQUAL(500, controller.getPrefetch());
+    CPPUNIT_ASSERT_EQUAL(10, controller.getMinimumPrefetch());
+    CPPUNIT_ASSERT_EQUAL(500, controller.getMaximumPrefetch());
+    CPPUNIT_ASSERT_EQUAL(1000LL, controller.getInterval());
+    CPPUNIT_ASSERT_EQUAL(0.0, controller.getProcessingRate());
+
+    AdaptivePrefetchController low(1, 10, 500, 1000, 0);
+    CPPUNIT_ASSERT_EQUAL(10, low.getPrefetch());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        AdaptivePrefetchController(100, 0, 500, 1000, 0),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        AdaptivePrefetchController(100, 50, 10, 1000, 0),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        AdaptivePrefetchController(100, 1, 500, 0, 0),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testGrowsWhenDrained() {
+
+    AdaptivePrefetchController controller(10, 1, 1000, 1000, 0);
+
+    // Consumed everything it was sent and nothing is waiting.
+    consume(controller, 10);
+    CPPUNIT_ASSERT(controller.sample(1000, 0));
+    CPPUNIT_ASSERT_EQUAL(20, controller.getPrefetch());
+
+    consume(controller, 20);
+    CPPUNIT_ASSERT(controller.sample(2000, 0));
+    CPPUNIT_ASSERT_EQUAL(40, controller.getPrefetch());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testShrinksWhenStalled() {
+
+    AdaptivePrefetchController controller(1000, 1, 1000, 1000, 0);
+
+    // Nothing processed while messages wait, halves each interval down to the minimum.
+    int expected = 1000;
+    for (long long time = 1000; expected > 1; time += 1000) {
+        expected /= 2;
+        CPPUNIT_ASSERT(controller.sample(time, 500));
+        CPPUNIT_ASSERT_EQUAL(expected > 1 ? expected : 1, controller.getPrefetch());
+    }
+
+    CPPUNIT_ASSERT(!controller.sample(100000, 500));
+    CPPUNIT_ASSERT_EQUAL(1, controller.getPrefetch());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testTracksProcessingRate() {
+
+    AdaptivePrefetchController controller(1000, 1, 1000, 500, 0);
+
+    // 100 messages a second with a backlog, settles on half a second of work.
+    long long time = 0;
+    for (int i = 0; i < 10; ++i) {
+        consume(controller, 50);
+        time += 500;
+        controller.sample(time, 200);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(100.0, controller.getProcessingRate());
+    CPPUNIT_ASSERT_EQUAL(50, controller.getPrefetch());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testStaysWithinBounds() {
+
+    AdaptivePrefetchController controller(100, 20, 150, 1000, 0);
+
+    consume(controller, 10000);
+    CPPUNIT_ASSERT(controller.sample(1000, 0));
+    CPPUNIT_ASSERT_EQUAL(150, controller.getPrefetch());
+
+    consume(controller, 10000);
+    CPPUNIT_ASSERT(!controller.sample(2000, 0));
+    CPPUNIT_ASSERT_EQUAL(150, controller.getPrefetch());
+
+    for (long long time = 3000; time < 10000; time += 1000) {
+        controller.sample(time, 100);
+    }
+    CPPUNIT_ASSERT_EQUAL(20, controller.getPrefetch());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testIgnoresIdleAndSmallChanges() {
+
+    AdaptivePrefetchController controller(100, 1, 1000, 1000, 0);
+
+    // No traffic at all keeps the window.
+    CPPUNIT_ASSERT(!controller.sample(1000, 0));
+    CPPUNIT_ASSERT_EQUAL(100, controller.getPrefetch());
+
+    // Samples without time passing are ignored.
+    consume(controller, 5);
+    CPPUNIT_ASSERT(!controller.sample(1000, 10));
+    CPPUNIT_ASSERT_EQUAL(100, controller.getPrefetch());
+
+    // A rate within ten percent of the window isn't worth telling the broker.
+    consume(controller, 90);
+    CPPUNIT_ASSERT(!controller.sample(2000, 10));
+    CPPUNIT_ASSERT_EQUAL(100, controller.getPrefetch());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testCompetingConsumersSimulation() {
+
+    SimulationResult fixed = simulate(false);
+    SimulationResult adaptive = simulate(true);
+
+    CPPUNIT_ASSERT_EQUAL(fixed.produced, fixed.fastProcessed + fixed.slowProcessed);
+    CPPUNIT_ASSERT_EQUAL(adaptive.produced, adaptive.fastProcessed + adaptive.slowProcessed);
+
+    // With a fixed window the slow consumer hoards a second of its own work on every
+    // ten messages it is sent, adapting hands that work to the fast consumer.
+    CPPUNIT_ASSERT(adaptive.fastProcessed > fixed.fastProcessed);
+    CPPUNIT_ASSERT(adaptive.slowProcessed < fixed.slowProcessed);
+    CPPUNIT_ASSERT(adaptive.maxLatency * 4 < fixed.maxLatency);
+    CPPUNIT_ASSERT(adaptive.finishTime * 4 < fixed.finishTime * 3);
+}
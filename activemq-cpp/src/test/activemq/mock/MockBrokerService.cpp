@@ -57,6 +57,7 @@ namespace mock {
 
         volatile bool done;
         volatile bool error;
+        volatile int acceptDelay;
         const int configuredPort;
         Pointer<ServerSocket> server;
         Pointer<OpenWireFormat> wireFormat;
@@ -66,7 +67,7 @@ namespace mock {
 
     public:
 
-        TcpServer() : Thread(), done(false), error(false), configuredPort(0), server(), wireFormat(),
+        TcpServer() : Thread(), done(false), error(false), acceptDelay(0), configuredPort(0), server(), wireFormat(),
                       responeBuilder(), started(1), rand() {
 
             Properties properties;
@@ -77,7 +78,7 @@ namespace mock {
             this->rand.setSeed(System::currentTimeMillis());
         }
 
-        TcpServer(int port) : Thread(), done(false), error(false), configuredPort(port), server(), wireFormat(),
+        TcpServer(int port) : Thread(), done(false), error(false), acceptDelay(0), configuredPort(port), server(), wireFormat(),
                               responeBuilder(), started(1), rand() {
 
             Properties properties;
@@ -100,6 +101,10 @@ namespace mock {
             return 0;
         }
 
+        void setAcceptDelay(int delay) {
+            this->acceptDelay = delay;
+        }
+
         void waitUntilStarted() {
             this->started.await();
         }
@@ -118,14 +123,14 @@ namespace mock {
         virtual void run() {
             try {
 
+                server.reset(new ServerSocket(configuredPort));
+
                 started.countDown();
 
                 while (!done) {
 
                     MockTransport mock(this->wireFormat, this->responeBuilder);
 
-                    server.reset(new ServerSocket(configuredPort));
-
                     std::auto_ptr<Socket> socket;
                     try {
                         socket.reset(server->accept());
@@ -135,6 +140,10 @@ namespace mock {
 
                     socket->setSoLinger(false, 0);
 
+                    if (acceptDelay > 0) {
+                        Thread::sleep(acceptDelay);
+                    }
+
                     Pointer<WireFormatInfo> preferred = wireFormat->getPreferedWireFormatInfo();
 
                     OutputStream* os = socket->getOutputStream();
@@ -143,16 +152,21 @@ namespace mock {
                     InputStream* is = socket->getInputStream();
                     DataInputStream dataIn(is);
 
-                    wireFormat->marshal(preferred, &mock, &dataOut);
-                    dataOut.flush();
+                    // A client that drops its connection, such as a latency probe, leaves
+                    // the broker free to accept the next one.
+                    try {
+                        wireFormat->marshal(preferred, &mock, &dataOut);
+                        dataOut.flush();
 
-                    while (!done) {
-                        Pointer<Command> command = wireFormat->unmarshal(&mock, &dataIn);
-                        Pointer<Response> response = responeBuilder->buildResponse(command);
+                        while (!done) {
+                            Pointer<Command> command = wireFormat->unmarshal(&mock, &dataIn);
+                            Pointer<Response> response = responeBuilder->buildResponse(command);
 
-                        if (response != NULL) {
-                            wireFormat->marshal(response, &mock, &dataOut);
+                            if (response != NULL) {
+                                wireFormat->marshal(response, &mock, &dataOut);
+                            }
                         }
+                    } catch (IOException& ex) {
                     }
                 }
             } catch (IOException& ex) {
@@ -162,6 +176,8 @@ namespace mock {
             } catch (...) {
                 error = true;
             }
+
+            started.countDown();
         }
     };
 
@@ -234,6 +250,11 @@ void MockBrokerService::waitUntilStopped() {
     this->impl->server->waitUntilStopped();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void MockBrokerService::setAcceptDelay(int delay) {
+    this->impl->server->setAcceptDelay(delay);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int MockBrokerService::getPort() const {
     return this->impl->server->getLocalPort();
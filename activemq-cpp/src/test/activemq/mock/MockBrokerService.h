@@ -55,6 +55,12 @@ namespace mock {
 
         void waitUntilStopped();
 
+        /**
+         * Sets a delay in milliseconds applied after each connection is accepted and
+         * before the broker sends its WireFormatInfo, simulating a distant broker.
+         */
+        void setAcceptDelay(int delay);
+
         std::string getConnectString() const;
 
         int getPort() const;
@@ -0,0 +1,409 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SelectorTest.h"
+
+#include <activemq/selector/Selector.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/MessageId.h>
+#include <cms/DeliveryMode.h>
+#include <cms/InvalidSelectorException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::selector;
+using namespace activemq::commands;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    bool matches(const std::string& expression, const commands::Message& message) {
+        Selector selector(expression);
+        return selector.matches(&message);
+    }
+
+    bool matches(const std::string& expression) {
+        ActiveMQTextMessage message;
+        return matches(expression, message);
+    }
+
+    bool isInvalid(const std::string& expression) {
+        try {
+            Selector selector(expression);
+        } catch (cms::InvalidSelectorException&) {
+            return true;
+        }
+        return false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testInvalidSelectors() {
+
+    CPPUNIT_ASSERT(isInvalid(""));
+    CPPUNIT_ASSERT(isInvalid("   "));
+    CPPUNIT_ASSERT(isInvalid("a ="));
+    CPPUNIT_ASSERT(isInvalid("a = 1 b"));
+    CPPUNIT_ASSERT(isInvalid("(a = 1"));
+    CPPUNIT_ASSERT(isInvalid("a = 'open"));
+    CPPUNIT_ASSERT(isInvalid("a = 1 = 2"));
+    CPPUNIT_ASSERT(isInvalid("a # 1"));
+    CPPUNIT_ASSERT(isInvalid("a = NULL"));
+    CPPUNIT_ASSERT(isInvalid("a IS 1"));
+    CPPUNIT_ASSERT(isInvalid("a LIKE b"));
+    CPPUNIT_ASSERT(isInvalid("a LIKE 'x' ESCAPE 'ab'"));
+    CPPUNIT_ASSERT(isInvalid("a LIKE 'x!' ESCAPE '!'"));
+    CPPUNIT_ASSERT(isInvalid("a IN ()"));
+    CPPUNIT_ASSERT(isInvalid("a IN (1, 2)"));
+    CPPUNIT_ASSERT(isInvalid("a NOT 1"));
+    CPPUNIT_ASSERT(isInvalid("a BETWEEN 1"));
+    CPPUNIT_ASSERT(isInvalid("'a'"));
+    CPPUNIT_ASSERT(isInvalid("1 + 2"));
+    CPPUNIT_ASSERT(isInvalid("'a' + 1 = 2"));
+    CPPUNIT_ASSERT(isInvalid("TRUE + 1 = 2"));
+    CPPUNIT_ASSERT(isInvalid("1 LIKE 'a'"));
+    CPPUNIT_ASSERT(isInvalid("'a' BETWEEN 1 AND 2"));
+    CPPUNIT_ASSERT(isInvalid("NOT 5"));
+    CPPUNIT_ASSERT(isInvalid("a = 1 AND 2"));
+    CPPUNIT_ASSERT(isInvalid("a = 99999999999999999999"));
+    CPPUNIT_ASSERT(isInvalid("a = 09"));
+    CPPUNIT_ASSERT(isInvalid("a = 1e"));
+
+    try {
+        Selector selector("color = 'red' AND");
+        CPPUNIT_FAIL("Should throw an InvalidSelectorException");
+    } catch (cms::InvalidSelectorException& ex) {
+        CPPUNIT_ASSERT(ex.getMessage().find("color = 'red' AND") != std::string::npos);
+    }
+
+    Selector selector("color = 'red'");
+    CPPUNIT_ASSERT_EQUAL(std::string("color = 'red'"), selector.getExpression());
+    CPPUNIT_ASSERT(!selector.matches(NULL));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testLiterals() {
+
+    CPPUNIT_ASSERT(matches("TRUE"));
+    CPPUNIT_ASSERT(matches("true"));
+    CPPUNIT_ASSERT(!matches("FALSE"));
+    CPPUNIT_ASSERT(matches("1 = 1"));
+    CPPUNIT_ASSERT(matches("0x1F = 31"));
+    CPPUNIT_ASSERT(matches("010 = 8"));
+    CPPUNIT_ASSERT(matches("10L = 10"));
+    CPPUNIT_ASSERT(matches("1.5 = 1.5"));
+    CPPUNIT_ASSERT(matches(".5 = 0.5"));
+    CPPUNIT_ASSERT(matches("1e3 = 1000"));
+    CPPUNIT_ASSERT(matches("2.5E-1 = 0.25"));
+    CPPUNIT_ASSERT(matches("2f = 2"));
+    CPPUNIT_ASSERT(matches("-5 < 0"));
+    CPPUNIT_ASSERT(matches("-9223372036854775807 - 1 < 0"));
+    CPPUNIT_ASSERT(matches("'it''s' = 'it''s'"));
+    CPPUNIT_ASSERT(matches("'' = ''"));
+    CPPUNIT_ASSERT(matches("TRUE = TRUE"));
+    CPPUNIT_ASSERT(matches("TRUE <> FALSE"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testComparisons() {
+
+    ActiveMQTextMessage message;
+    message.setIntProperty("count", 10);
+    message.setDoubleProperty("price", 2.5);
+    message.setStringProperty("color", "red");
+
+    CPPUNIT_ASSERT(matches("count = 10", message));
+    CPPUNIT_ASSERT(!matches("count = 11", message));
+    CPPUNIT_ASSERT(matches("count <> 11", message));
+    CPPUNIT_ASSERT(matches("count > 9", message));
+    CPPUNIT_ASSERT(matches("count >= 10", message));
+    CPPUNIT_ASSERT(!matches("count < 10", message));
+    CPPUNIT_ASSERT(matches("count <= 10", message));
+    CPPUNIT_ASSERT(matches("count = 10.0", message));
+    CPPUNIT_ASSERT(matches("price > 2", message));
+    CPPUNIT_ASSERT(matches("price < count", message));
+    CPPUNIT_ASSERT(matches("color = 'red'", message));
+    CPPUNIT_ASSERT(!matches("color = 'Red'", message));
+    CPPUNIT_ASSERT(matches("color <> 'blue'", message));
+    CPPUNIT_ASSERT(matches("color > 'blue'", message));
+    CPPUNIT_ASSERT(matches("color < 'yellow'", message));
+    CPPUNIT_ASSERT(matches("'red' = color", message));
+    CPPUNIT_ASSERT(matches("count = 10 and color = 'red'", message));
+    CPPUNIT_ASSERT(matches("count = 1 Or color = 'red'", message));
+    CPPUNIT_ASSERT(matches("NOT count = 1", message));
+    CPPUNIT_ASSERT(matches("(count = 1 OR count = 10) AND NOT (color = 'blue')", message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testTypeMismatch() {
+
+    ActiveMQTextMessage message;
+    message.setIntProperty("count", 10);
+    message.setStringProperty("number", "10");
+    message.setBooleanProperty("flag", true);
+
+    CPPUNIT_ASSERT(!matches("count = '10'", message));
+    CPPUNIT_ASSERT(matches("count <> '10'", message));
+    CPPUNIT_ASSERT(!matches("number = 10", message));
+    CPPUNIT_ASSERT(!matches("number > 5", message));
+    CPPUNIT_ASSERT(!matches("flag = 1", message));
+    CPPUNIT_ASSERT(!matches("flag > FALSE", message));
+    CPPUNIT_ASSERT(matches("flag = TRUE", message));
+    CPPUNIT_ASSERT(matches("flag", message));
+    CPPUNIT_ASSERT(!matches("count", message));
+    CPPUNIT_ASSERT(!matches("NOT count", message));
+    CPPUNIT_ASSERT(!matches("number + 1 = 11", message));
+    CPPUNIT_ASSERT(!matches("count LIKE '1%'", message));
+    CPPUNIT_ASSERT(!matches("count IN ('10')", message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testLogicWithNull() {
+
+    ActiveMQTextMessage message;
+    message.setIntProperty("count", 10);
+
+    // missing = 1 is unknown, NOT of unknown is unknown.
+    CPPUNIT_ASSERT(!matches("missing = 1", message));
+    CPPUNIT_ASSERT(!matches("NOT missing = 1", message));
+    CPPUNIT_ASSERT(!matches("missing <> 1", message));
+
+    CPPUNIT_ASSERT(!matches("missing = 1 AND count = 10", message));
+    CPPUNIT_ASSERT(!matches("count = 10 AND missing = 1", message));
+    CPPUNIT_ASSERT(!matches("NOT (missing = 1 AND count = 10)", message));
+    CPPUNIT_ASSERT(matches("NOT (missing = 1 AND count = 1)", message));
+
+    CPPUNIT_ASSERT(matches("missing = 1 OR count = 10", message));
+    CPPUNIT_ASSERT(matches("count = 10 OR missing = 1", message));
+    CPPUNIT_ASSERT(!matches("missing = 1 OR count = 1", message));
+    CPPUNIT_ASSERT(!matches("NOT (missing = 1 OR count = 1)", message));
+
+    CPPUNIT_ASSERT(!matches("missing", message));
+    CPPUNIT_ASSERT(!matches("missing + 1 = 1", message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testArithmetic() {
+
+    ActiveMQTextMessage message;
+    message.setIntProperty("count", 10);
+    message.setLongProperty("big", 9223372036854775807LL);
+    message.setDoubleProperty("ratio", 0.5);
+
+    CPPUNIT_ASSERT(matches("count + 5 = 15", message));
+    CPPUNIT_ASSERT(matches("count - 15 = -5", message));
+    CPPUNIT_ASSERT(matches("count * 3 = 30", message));
+    CPPUNIT_ASSERT(matches("count / 3 = 3", message));
+    CPPUNIT_ASSERT(matches("count / 4.0 = 2.5", message));
+    CPPUNIT_ASSERT(matches("count * ratio = 5", message));
+    CPPUNIT_ASSERT(matches("2 + 3 * 4 = 14", message));
+    CPPUNIT_ASSERT(matches("(2 + 3) * 4 = 20", message));
+    CPPUNIT_ASSERT(matches("10 - 4 - 3 = 3", message));
+    CPPUNIT_ASSERT(matches("-count = -10", message));
+    CPPUNIT_ASSERT(matches("- -count = 10", message));
+    CPPUNIT_ASSERT(matches("+count = 10", message));
+    CPPUNIT_ASSERT(matches("big + 1 < 0", message));
+
+    // Division by zero is unknown rather than an error.
+    CPPUNIT_ASSERT(!matches("count / 0 = 0", message));
+    CPPUNIT_ASSERT(!matches("NOT count / 0 = 0", message));
+    CPPUNIT_ASSERT(!matches("ratio / 0 > 0", message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testBetween() {
+
+    ActiveMQTextMessage message;
+    message.setIntProperty("count", 10);
+
+    CPPUNIT_ASSERT(matches("count BETWEEN 5 AND 15", message));
+    CPPUNIT_ASSERT(matches("count BETWEEN 10 AND 10", message));
+    CPPUNIT_ASSERT(!matches("count BETWEEN 11 AND 15", message));
+    CPPUNIT_ASSERT(matches("count NOT BETWEEN 11 AND 15", message));
+    CPPUNIT_ASSERT(matches("count BETWEEN 2 * 4 AND count + 1", message));
+    CPPUNIT_ASSERT(matches("count BETWEEN 1 AND 20 AND count = 10", message));
+    CPPUNIT_ASSERT(!matches("missing BETWEEN 1 AND 20", message));
+    CPPUNIT_ASSERT(!matches("missing NOT BETWEEN 1 AND 20", message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testIn() {
+
+    ActiveMQTextMessage message;
+    message.setStringProperty("color", "red");
+
+    CPPUNIT_ASSERT(matches("color IN ('red')", message));
+    CPPUNIT_ASSERT(matches("color IN ('green', 'red', 'blue', 'red')", message));
+    CPPUNIT_ASSERT(!matches("color IN ('green', 'blue')", message));
+    CPPUNIT_ASSERT(matches("color NOT IN ('green', 'blue')", message));
+    CPPUNIT_ASSERT(!matches("color NOT IN ('red', 'blue')", message));
+    CPPUNIT_ASSERT(!matches("missing IN ('red')", message));
+    CPPUNIT_ASSERT(!matches("missing NOT IN ('red')", message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testLike() {
+
+    ActiveMQTextMessage message;
+    message.setStringProperty("name", "order.created");
+    message.setStringProperty("code", "10%_off");
+    message.setStringProperty("unicode", "caf\xC3\xA9!");
+
+    CPPUNIT_ASSERT(matches("name LIKE 'order.created'", message));
+    CPPUNIT_ASSERT(!matches("name LIKE 'order'", message));
+    CPPUNIT_ASSERT(matches("name LIKE 'order.%'", message));
+    CPPUNIT_ASSERT(!matches("name LIKE 'trade.%'", message));
+    CPPUNIT_ASSERT(matches("name LIKE '%.created'", message));
+    CPPUNIT_ASSERT(matches("name LIKE '%der.cr%'", message));
+    CPPUNIT_ASSERT(!matches("name LIKE '%deleted%'", message));
+    CPPUNIT_ASSERT(matches("name LIKE '%'", message));
+    CPPUNIT_ASSERT(matches("name LIKE 'o_der%'", message));
+    CPPUNIT_ASSERT(matches("name LIKE '%r%r%d'", message));
+    CPPUNIT_ASSERT(matches("name LIKE '_____.%__'", message));
+    CPPUNIT_ASSERT(!matches("name LIKE '%r%z%d'", message));
+    CPPUNIT_ASSERT(!matches("name LIKE 'order.created_'", message));
+    CPPUNIT_ASSERT(matches("name NOT LIKE 'trade%'", message));
+    CPPUNIT_ASSERT(!matches("name NOT LIKE 'order%'", message));
+
+    CPPUNIT_ASSERT(matches("code LIKE '10!%!_off' ESCAPE '!'", message));
+    CPPUNIT_ASSERT(matches("code LIKE '%!%%' ESCAPE '!'", message));
+    CPPUNIT_ASSERT(!matches("code LIKE '10!%!_' ESCAPE '!'", message));
+    CPPUNIT_ASSERT(matches("code LIKE '10\\%\\_%' ESCAPE '\\'", message));
+
+    // '_' stands for one character, not one byte.
+    CPPUNIT_ASSERT(matches("unicode LIKE 'caf_!'", message));
+    CPPUNIT_ASSERT(matches("unicode LIKE '%f_!'", message));
+    CPPUNIT_ASSERT(!matches("unicode LIKE 'caf__!'", message));
+
+    CPPUNIT_ASSERT(!matches("missing LIKE '%'", message));
+    CPPUNIT_ASSERT(!matches("missing NOT LIKE '%'", message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testIsNull() {
+
+    ActiveMQTextMessage message;
+    message.setIntProperty("count", 10);
+
+    CPPUNIT_ASSERT(matches("missing IS NULL", message));
+    CPPUNIT_ASSERT(!matches("missing IS NOT NULL", message));
+    CPPUNIT_ASSERT(!matches("count IS NULL", message));
+    CPPUNIT_ASSERT(matches("count IS NOT NULL", message));
+    CPPUNIT_ASSERT(matches("count / 0 IS NULL", message));
+    CPPUNIT_ASSERT(matches("missing IS NULL OR missing = 1", message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testHeaders() {
+
+    ActiveMQTextMessage message;
+    message.setCMSDeliveryMode(cms::DeliveryMode::PERSISTENT);
+    message.setCMSPriority(7);
+    message.setCMSType("order");
+    message.setCMSCorrelationID("abc-1");
+    message.setTimestamp(1000);
+    message.setExpiration(5000);
+    message.setGroupID("group-a");
+    message.setGroupSequence(3);
+    message.setRedeliveryCounter(2);
+    message.setMessageId(decaf::lang::Pointer<MessageId>(new MessageId("ID:producer-1:1:1", 5)));
+
+    CPPUNIT_ASSERT(matches("JMSDeliveryMode = 'PERSISTENT'", message));
+    CPPUNIT_ASSERT(matches("JMSPriority > 4", message));
+    CPPUNIT_ASSERT(matches("JMSType = 'order'", message));
+    CPPUNIT_ASSERT(matches("JMSCorrelationID LIKE 'abc-%'", message));
+    CPPUNIT_ASSERT(matches("JMSTimestamp = 1000", message));
+    CPPUNIT_ASSERT(matches("JMSExpiration = 5000", message));
+    CPPUNIT_ASSERT(matches("JMSXGroupID = 'group-a'", message));
+    CPPUNIT_ASSERT(matches("JMSXGroupSeq = 3", message));
+    CPPUNIT_ASSERT(matches("JMSRedelivered", message));
+    CPPUNIT_ASSERT(matches("JMSXDeliveryCount = 3", message));
+    CPPUNIT_ASSERT(matches("JMSMessageID = '" + message.getCMSMessageID() + "'", message));
+
+    // Header names are case sensitive, a differently cased name is a property.
+    CPPUNIT_ASSERT(matches("jmstype IS NULL", message));
+
+    ActiveMQTextMessage empty;
+    empty.setCMSDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+
+    CPPUNIT_ASSERT(matches("JMSDeliveryMode = 'NON_PERSISTENT'", empty));
+    CPPUNIT_ASSERT(matches("JMSType IS NULL", empty));
+    CPPUNIT_ASSERT(matches("JMSCorrelationID IS NULL", empty));
+    CPPUNIT_ASSERT(matches("JMSXGroupID IS NULL", empty));
+    CPPUNIT_ASSERT(matches("JMSMessageID IS NULL", empty));
+    CPPUNIT_ASSERT(matches("NOT JMSRedelivered", empty));
+    CPPUNIT_ASSERT(matches("JMSXDeliveryCount = 1", empty));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testPropertyTypes() {
+
+    ActiveMQTextMessage message;
+    message.setBooleanProperty("boolean", true);
+    message.setByteProperty("byte", (unsigned char) 0xFF);
+    message.setShortProperty("short", -300);
+    message.setIntProperty("int", 70000);
+    message.setLongProperty("long", 5000000000LL);
+    message.setFloatProperty("float", 1.5f);
+    message.setDoubleProperty("double", 2.25);
+    message.setStringProperty("string", "a string value longer than any inline buffer");
+
+    CPPUNIT_ASSERT(matches("boolean = TRUE", message));
+    CPPUNIT_ASSERT(matches("byte = -1", message));
+    CPPUNIT_ASSERT(matches("short = -300", message));
+    CPPUNIT_ASSERT(matches("int = 70000", message));
+    CPPUNIT_ASSERT(matches("long = 5000000000", message));
+    CPPUNIT_ASSERT(matches("float = 1.5", message));
+    CPPUNIT_ASSERT(matches("double = 2.25", message));
+    CPPUNIT_ASSERT(matches("string LIKE 'a string%buffer'", message));
+    CPPUNIT_ASSERT(matches("byte + short + int + long + float + double > 5000000000", message));
+
+    // A selector is evaluated against each message independently.
+    Selector selector("int BETWEEN 1 AND 100");
+    ActiveMQTextMessage small;
+    small.setIntProperty("int", 50);
+    CPPUNIT_ASSERT(!selector.matches(&message));
+    CPPUNIT_ASSERT(selector.matches(&small));
+    CPPUNIT_ASSERT(!selector.matches(&message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testDeepExpression() {
+
+    ActiveMQTextMessage message;
+    message.setIntProperty("count", 10);
+
+    // Deeper than the values the evaluator keeps on the stack.
+    std::string expression;
+    for (int i = 0; i < 40; ++i) {
+        expression += "(1 + ";
+    }
+    expression += "count";
+    for (int i = 0; i < 40; ++i) {
+        expression += ")";
+    }
+    expression += " = 50";
+
+    CPPUNIT_ASSERT(matches(expression, message));
+
+    std::string chain("count = 0");
+    for (int i = 1; i <= 100; ++i) {
+        chain += " OR count = " + std::string(1, (char) ('0' + i % 10));
+    }
+    CPPUNIT_ASSERT(!matches(chain, message));
+    CPPUNIT_ASSERT(matches(chain + " OR count = 10", message));
+}
@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _ACTIVEMQ_SELECTOR_SELECTORTEST_H_
+#define _ACTIVEMQ_SELECTOR_SELECTORTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace activemq {
+namespace selector {
+
+    class SelectorTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( SelectorTest );
+        CPPUNIT_TEST( testInvalidSelectors );
+        CPPUNIT_TEST( testLiterals );
+        CPPUNIT_TEST( testComparisons );
+        CPPUNIT_TEST( testTypeMismatch );
+        CPPUNIT_TEST( testLogicWithNull );
+        CPPUNIT_TEST( testArithmetic );
+        CPPUNIT_TEST( testBetween );
+        CPPUNIT_TEST( testIn );
+        CPPUNIT_TEST( testLike );
+        CPPUNIT_TEST( testIsNull );
+        CPPUNIT_TEST( testHeaders );
+        CPPUNIT_TEST( testPropertyTypes );
+        CPPUNIT_TEST( testDeepExpression );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        SelectorTest() {}
+        virtual ~SelectorTest() {}
+
+        void testInvalidSelectors();
+        void testLiterals();
+        void testComparisons();
+        void testTypeMismatch();
+        void testLogicWithNull();
+        void testArithmetic();
+        void testBetween();
+        void testIn();
+        void testLike();
+        void testIsNull();
+        void testHeaders();
+        void testPropertyTypes();
+        void testDeepExpression();
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_SELECTOR_SELECTORTEST_H_*/
@@ -18,6 +18,9 @@
 #include "ConnectionStateTrackerTest.h"
 
 #include <activemq/transport/Transport.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/state/ConnectionStateTracker.h>
 #include <activemq/state/ConsumerState.h>
@@ -28,6 +31,8 @@
 #include <activemq/commands/SessionInfo.h>
 #include <activemq/commands/Message.h>
 #include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+#include <decaf/net/URI.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/util/LinkedList.h>
 
@@ -36,6 +41,7 @@ using namespace activemq;
 using namespace activemq::state;
 using namespace activemq::commands;
 using namespace activemq::transport;
+using namespace activemq::transport::mock;
 using namespace activemq::wireformat;
 using namespace decaf::util;
 using namespace decaf::lang;
@@ -143,6 +149,20 @@ namespace {
 
     };
 
+    class RecordingListener : public DefaultTransportListener {
+    public:
+
+        LinkedList< Pointer<Command> > sent;
+
+    public:
+
+        virtual ~RecordingListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            sent.add(command);
+        }
+    };
+
     class ConnectionData {
     public:
 
@@ -266,3 +286,84 @@ void ConnectionStateTrackerTest::testMessagePullCache() {
 
     CPPUNIT_ASSERT_EQUAL_MESSAGE("Should only be three message pulls", 10, transport->messagePulls.size());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ConnectionStateTrackerTest::testRestoreBatching() {
+
+    const int SESSION_COUNT = 10;
+    const int CONSUMERS_PER_SESSION = 500;
+    const int PRODUCERS_PER_SESSION = 50;
+    const int BATCH_SIZE = 100;
+
+    MockTransportFactory factory;
+    Pointer<MockTransport> transport =
+        factory.createComposite(decaf::net::URI("mock://mock?wireformat=openwire")).dynamicCast<MockTransport>();
+
+    RecordingListener listener;
+    transport->setOutgoingListener(&listener);
+
+    ConnectionStateTracker tracker;
+    tracker.setRestoreBatchSize(BATCH_SIZE);
+
+    Pointer<ConnectionId> connectionId(new ConnectionId);
+    connectionId->setValue("CONNECTION");
+    Pointer<ConnectionInfo> connection(new ConnectionInfo);
+    connection->setConnectionId(connectionId);
+    tracker.processConnectionInfo(connection.get());
+
+    for (int i = 0; i < SESSION_COUNT; ++i) {
+
+        Pointer<SessionId> sessionId(new SessionId);
+        sessionId->setConnectionId("CONNECTION");
+        sessionId->setValue(i);
+        Pointer<SessionInfo> session(new SessionInfo);
+        session->setSessionId(sessionId);
+        tracker.processSessionInfo(session.get());
+
+        for (int j = 0; j < PRODUCERS_PER_SESSION; ++j) {
+            Pointer<ProducerId> producerId(new ProducerId);
+            producerId->setConnectionId("CONNECTION");
+            producerId->setSessionId(i);
+            producerId->setValue(j);
+            Pointer<ProducerInfo> producer(new ProducerInfo);
+            producer->setProducerId(producerId);
+            tracker.processProducerInfo(producer.get());
+        }
+
+        for (int j = 0; j < CONSUMERS_PER_SESSION; ++j) {
+            Pointer<ConsumerId> consumerId(new ConsumerId);
+            consumerId->setConnectionId("CONNECTION");
+            consumerId->setSessionId(i);
+            consumerId->setValue(j);
+            Pointer<ConsumerInfo> consumer(new ConsumerInfo);
+            consumer->setConsumerId(consumerId);
+            tracker.processConsumerInfo(consumer.get());
+        }
+    }
+
+    // The ConnectionState always holds a default session in addition to the ones added here.
+    const int expected = 2 + SESSION_COUNT * (1 + CONSUMERS_PER_SESSION + PRODUCERS_PER_SESSION);
+
+    long long start = System::currentTimeMillis();
+    tracker.restore(transport);
+    long long elapsed = System::currentTimeMillis() - start;
+
+    transport->close();
+
+    CPPUNIT_ASSERT_EQUAL(expected, listener.sent.size());
+    CPPUNIT_ASSERT_EQUAL((expected + BATCH_SIZE - 1) / BATCH_SIZE, transport->getNumSentBatches());
+    CPPUNIT_ASSERT_MESSAGE("Restore took too long", elapsed < 10000);
+
+    // Connection first, then every session, every consumer and last the producers.
+    std::auto_ptr< Iterator< Pointer<Command> > > iter(listener.sent.iterator());
+    CPPUNIT_ASSERT(iter->next()->isConnectionInfo());
+    for (int i = 0; i <= SESSION_COUNT; ++i) {
+        CPPUNIT_ASSERT_EQUAL((int)SessionInfo::ID_SESSIONINFO, (int)iter->next()->getDataStructureType());
+    }
+    for (int i = 0; i < SESSION_COUNT * CONSUMERS_PER_SESSION; ++i) {
+        CPPUNIT_ASSERT(iter->next()->isConsumerInfo());
+    }
+    for (int i = 0; i < SESSION_COUNT * PRODUCERS_PER_SESSION; ++i) {
+        CPPUNIT_ASSERT(iter->next()->isProducerInfo());
+    }
+}
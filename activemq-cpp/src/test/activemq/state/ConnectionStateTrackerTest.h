@@ -30,6 +30,7 @@ namespace state {
         CPPUNIT_TEST( test );
         CPPUNIT_TEST( testMessageCache );
         CPPUNIT_TEST( testMessagePullCache );
+        CPPUNIT_TEST( testRestoreBatching );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -40,6 +41,7 @@ namespace state {
         void test();
         void testMessageCache();
         void testMessagePullCache();
+        void testRestoreBatching();
 
     };
 
@@ -0,0 +1,201 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledTaskRunnerTest.h"
+
+#include <memory>
+
+#include <activemq/threads/Task.h>
+#include <activemq/threads/PooledTaskRunner.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/concurrent/WorkStealingExecutor.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class SimpleCountingTask : public Task {
+    private:
+
+        unsigned int count;
+
+    public:
+
+        SimpleCountingTask() : count(0) {}
+        virtual ~SimpleCountingTask() {}
+
+        virtual bool iterate() {
+
+            count++;
+            return false;
+        }
+
+        unsigned int getCount() const { return count; }
+    };
+
+    class InfiniteCountingTask : public Task {
+    private:
+
+        unsigned int count;
+
+    public:
+
+        InfiniteCountingTask() : count(0) {}
+        virtual ~InfiniteCountingTask() {}
+
+        virtual bool iterate() {
+
+            count++;
+            Thread::yield();
+            return true;
+        }
+
+        unsigned int getCount() const { return count; }
+    };
+
+    class SelfStoppingTask : public Task {
+    private:
+
+        SelfStoppingTask(const SelfStoppingTask&);
+        SelfStoppingTask& operator=(const SelfStoppingTask&);
+
+    public:
+
+        TaskRunner* runner;
+        unsigned int count;
+
+        SelfStoppingTask() : runner(NULL), count(0) {}
+        virtual ~SelfStoppingTask() {}
+
+        virtual bool iterate() {
+
+            count++;
+            runner->shutdown();
+            return true;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testSimple() {
+
+    WorkStealingExecutor executor(2);
+    SimpleCountingTask simpleTask;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        std::auto_ptr<TaskRunner>( new PooledTaskRunner( NULL, &simpleTask, 10 ) ),
+        NullPointerException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        std::auto_ptr<TaskRunner>( new PooledTaskRunner( &executor, NULL, 10 ) ),
+        NullPointerException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        std::auto_ptr<TaskRunner>( new PooledTaskRunner( &executor, &simpleTask, 0 ) ),
+        IllegalArgumentException );
+
+    CPPUNIT_ASSERT( simpleTask.getCount() == 0 );
+    PooledTaskRunner simpleTaskRunner( &executor, &simpleTask, 10 );
+
+    CPPUNIT_ASSERT( !simpleTaskRunner.isStarted() );
+    simpleTaskRunner.start();
+    CPPUNIT_ASSERT( simpleTaskRunner.isStarted() );
+
+    simpleTaskRunner.wakeup();
+    Thread::sleep( 250 );
+    CPPUNIT_ASSERT( simpleTask.getCount() >= 1 );
+    simpleTaskRunner.wakeup();
+    Thread::sleep( 250 );
+    CPPUNIT_ASSERT( simpleTask.getCount() >= 2 );
+
+    InfiniteCountingTask infiniteTask;
+    CPPUNIT_ASSERT( infiniteTask.getCount() == 0 );
+    PooledTaskRunner infiniteTaskRunner( &executor, &infiniteTask, 10 );
+    infiniteTaskRunner.start();
+    Thread::sleep( 500 );
+    CPPUNIT_ASSERT( infiniteTask.getCount() != 0 );
+    infiniteTaskRunner.shutdown();
+    unsigned int count = infiniteTask.getCount();
+    Thread::sleep( 250 );
+    CPPUNIT_ASSERT( infiniteTask.getCount() == count );
+
+    simpleTaskRunner.shutdown();
+    executor.shutdown();
+    CPPUNIT_ASSERT( executor.awaitTermination( 5, TimeUnit::SECONDS ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testRunnersShareThreads() {
+
+    // More busy runners than threads, each hands its thread back after a
+    // bounded number of iterations so all of them make progress.
+    static const int RUNNERS = 6;
+
+    WorkStealingExecutor executor(2);
+    InfiniteCountingTask tasks[RUNNERS];
+    std::auto_ptr<PooledTaskRunner> runners[RUNNERS];
+
+    for (int i = 0; i < RUNNERS; ++i) {
+        runners[i].reset( new PooledTaskRunner( &executor, &tasks[i], 10 ) );
+        runners[i]->start();
+    }
+
+    Thread::sleep( 500 );
+
+    for (int i = 0; i < RUNNERS; ++i) {
+        runners[i]->shutdown();
+        CPPUNIT_ASSERT( tasks[i].getCount() > 0 );
+    }
+
+    executor.shutdown();
+    CPPUNIT_ASSERT( executor.awaitTermination( 5, TimeUnit::SECONDS ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testShutdownFromTask() {
+
+    WorkStealingExecutor executor(1);
+    SelfStoppingTask task;
+    PooledTaskRunner runner( &executor, &task, 10 );
+    task.runner = &runner;
+
+    runner.start();
+    Thread::sleep( 250 );
+
+    // The shutdown from inside iterate must neither deadlock nor let the runner
+    // queue itself again.
+    CPPUNIT_ASSERT_EQUAL( 1U, task.count );
+    runner.wakeup();
+    Thread::sleep( 100 );
+    CPPUNIT_ASSERT_EQUAL( 1U, task.count );
+
+    runner.shutdown();
+    executor.shutdown();
+    CPPUNIT_ASSERT( executor.awaitTermination( 5, TimeUnit::SECONDS ) );
+}
@@ -0,0 +1,290 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThreadPolicyTest.h"
+
+#include <activemq/threads/ThreadPolicy.h>
+#include <activemq/threads/DedicatedTaskRunner.h>
+#include <activemq/threads/CompositeTaskRunner.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+
+#include <memory>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace activemq;
+using namespace activemq::threads;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class AffinityRecorder : public Runnable {
+    public:
+
+        std::string name;
+        std::vector<int> affinity;
+
+        AffinityRecorder() : name(), affinity() {}
+
+        virtual ~AffinityRecorder() {}
+
+        virtual void run() {
+            name = Thread::currentThread()->getName();
+            affinity = Thread::currentThread()->getAffinity();
+        }
+    };
+
+    class AffinityRecorderTask : public Task {
+    public:
+
+        CountDownLatch done;
+        std::string name;
+        std::vector<int> affinity;
+
+        AffinityRecorderTask() : done(1), name(), affinity() {}
+
+        virtual ~AffinityRecorderTask() {}
+
+        virtual bool iterate() {
+            name = Thread::currentThread()->getName();
+            affinity = Thread::currentThread()->getAffinity();
+            done.countDown();
+            return false;
+        }
+    };
+
+    /**
+     * Returns a single processor list holding the last processor this thread may use,
+     * or an empty list when the platform cannot report thread affinity.
+     */
+    std::vector<int> pickProcessor() {
+
+        std::vector<int> result;
+
+        try {
+            std::vector<int> available = Thread::currentThread()->getAffinity();
+            if (!available.empty()) {
+                result.push_back(available.back());
+            }
+        } catch (UnsupportedOperationException& ex) {
+        }
+
+        return result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPolicyTest::ThreadPolicyTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ThreadPolicyTest::~ThreadPolicyTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicyTest::testDefaults() {
+
+    ThreadPolicy policy;
+
+    CPPUNIT_ASSERT(policy.isEmpty());
+
+    for (int i = 0; i < ThreadPolicy::ROLE_COUNT; ++i) {
+        ThreadPolicy::Role role = (ThreadPolicy::Role) i;
+        CPPUNIT_ASSERT(policy.getName(role).empty());
+        CPPUNIT_ASSERT_EQUAL(0, policy.getPriority(role));
+        CPPUNIT_ASSERT(policy.getAffinity(role).empty());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::string("transportReader"), ThreadPolicy::getRoleName(ThreadPolicy::TRANSPORT_READER));
+    CPPUNIT_ASSERT_EQUAL(std::string("sessionDispatch"), ThreadPolicy::getRoleName(ThreadPolicy::SESSION_DISPATCH));
+    CPPUNIT_ASSERT_EQUAL(std::string("failover"), ThreadPolicy::getRoleName(ThreadPolicy::FAILOVER));
+    CPPUNIT_ASSERT_EQUAL(std::string("scheduler"), ThreadPolicy::getRoleName(ThreadPolicy::SCHEDULER));
+    CPPUNIT_ASSERT_EQUAL(std::string("executor"), ThreadPolicy::getRoleName(ThreadPolicy::EXECUTOR));
+
+    // A default policy leaves threads exactly as created.
+    std::auto_ptr<Thread> thread(policy.newThread(ThreadPolicy::EXECUTOR, NULL, "Default Name"));
+    CPPUNIT_ASSERT_EQUAL(std::string("Default Name"), thread->getName());
+    CPPUNIT_ASSERT_EQUAL((int) Thread::NORM_PRIORITY, thread->getPriority());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicyTest::testParseAffinity() {
+
+    CPPUNIT_ASSERT(ThreadPolicy::parseAffinity("").empty());
+
+    std::vector<int> cpus = ThreadPolicy::parseAffinity("3");
+    CPPUNIT_ASSERT_EQUAL(1, (int) cpus.size());
+    CPPUNIT_ASSERT_EQUAL(3, cpus[0]);
+
+    cpus = ThreadPolicy::parseAffinity(" 0, 2,4-6 ,9");
+    CPPUNIT_ASSERT_EQUAL(6, (int) cpus.size());
+    CPPUNIT_ASSERT_EQUAL(0, cpus[0]);
+    CPPUNIT_ASSERT_EQUAL(2, cpus[1]);
+    CPPUNIT_ASSERT_EQUAL(4, cpus[2]);
+    CPPUNIT_ASSERT_EQUAL(5, cpus[3]);
+    CPPUNIT_ASSERT_EQUAL(6, cpus[4]);
+    CPPUNIT_ASSERT_EQUAL(9, cpus[5]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicyTest::testParseAffinityInvalid() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ThreadPolicy::parseAffinity("a"),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ThreadPolicy::parseAffinity("-1"),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ThreadPolicy::parseAffinity("4-2"),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ThreadPolicy::parseAffinity("1-"),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicyTest::testConfigure() {
+
+    Properties properties;
+    properties.setProperty("threads.transportReader.name", "Reader");
+    properties.setProperty("threads.transportReader.affinity", "1-2");
+    properties.setProperty("threads.sessionDispatch.priority", "8");
+    properties.setProperty("threads.scheduler.affinity", "0");
+    properties.setProperty("connection.useAsyncSend", "true");
+
+    ThreadPolicy policy;
+    policy.setName(ThreadPolicy::EXECUTOR, "Executor");
+    policy.configure(properties);
+
+    CPPUNIT_ASSERT(!policy.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(std::string("Reader"), policy.getName(ThreadPolicy::TRANSPORT_READER));
+    CPPUNIT_ASSERT_EQUAL(2, (int) policy.getAffinity(ThreadPolicy::TRANSPORT_READER).size());
+    CPPUNIT_ASSERT_EQUAL(8, policy.getPriority(ThreadPolicy::SESSION_DISPATCH));
+    CPPUNIT_ASSERT_EQUAL(1, (int) policy.getAffinity(ThreadPolicy::SCHEDULER).size());
+    CPPUNIT_ASSERT(policy.getName(ThreadPolicy::FAILOVER).empty());
+
+    // Keys that are absent leave programmatic settings alone.
+    CPPUNIT_ASSERT_EQUAL(std::string("Executor"), policy.getName(ThreadPolicy::EXECUTOR));
+
+    ThreadPolicy copy(policy);
+    CPPUNIT_ASSERT_EQUAL(std::string("Reader"), copy.getName(ThreadPolicy::TRANSPORT_READER));
+    CPPUNIT_ASSERT_EQUAL(8, copy.getPriority(ThreadPolicy::SESSION_DISPATCH));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicyTest::testConfigureInvalid() {
+
+    ThreadPolicy policy;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        policy.setPriority(ThreadPolicy::EXECUTOR, Thread::MAX_PRIORITY + 1),
+        IllegalArgumentException);
+
+    Properties properties;
+    properties.setProperty("threads.executor.priority", "high");
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        policy.configure(properties),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicyTest::testNewThread() {
+
+    ThreadPolicy policy;
+    policy.setName(ThreadPolicy::SESSION_DISPATCH, "Dispatcher");
+    policy.setPriority(ThreadPolicy::SESSION_DISPATCH, Thread::MAX_PRIORITY);
+
+    AffinityRecorder recorder;
+    std::auto_ptr<Thread> thread(policy.newThread(ThreadPolicy::SESSION_DISPATCH, &recorder, "Default"));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Dispatcher"), thread->getName());
+    CPPUNIT_ASSERT_EQUAL((int) Thread::MAX_PRIORITY, thread->getPriority());
+
+    thread->start();
+    thread->join();
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Dispatcher"), recorder.name);
+
+    // Other roles are not affected.
+    std::auto_ptr<Thread> other(policy.newThread(ThreadPolicy::SCHEDULER, &recorder, "Default"));
+    CPPUNIT_ASSERT_EQUAL(std::string("Default"), other->getName());
+    CPPUNIT_ASSERT_EQUAL((int) Thread::NORM_PRIORITY, other->getPriority());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicyTest::testAffinityApplied() {
+
+    std::vector<int> pinned = pickProcessor();
+    if (pinned.empty()) {
+        return;
+    }
+
+    ThreadPolicy policy;
+    policy.setAffinity(ThreadPolicy::TRANSPORT_READER, pinned);
+
+    AffinityRecorder recorder;
+    std::auto_ptr<Thread> thread(policy.newThread(ThreadPolicy::TRANSPORT_READER, &recorder, "Reader"));
+    thread->start();
+    thread->join();
+
+    CPPUNIT_ASSERT_MESSAGE("Thread was not pinned", recorder.affinity == pinned);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadPolicyTest::testTaskRunnerAffinityApplied() {
+
+    std::vector<int> pinned = pickProcessor();
+    if (pinned.empty()) {
+        return;
+    }
+
+    ThreadPolicy policy;
+    policy.setName(ThreadPolicy::SESSION_DISPATCH, "Pinned Dispatcher");
+    policy.setAffinity(ThreadPolicy::SESSION_DISPATCH, pinned);
+
+    AffinityRecorderTask task;
+    DedicatedTaskRunner runner(&task);
+    runner.applyThreadPolicy(policy, ThreadPolicy::SESSION_DISPATCH);
+    runner.start();
+    runner.wakeup();
+
+    CPPUNIT_ASSERT(task.done.await(30000));
+    runner.shutdown();
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Pinned Dispatcher"), task.name);
+    CPPUNIT_ASSERT_MESSAGE("Task runner thread was not pinned", task.affinity == pinned);
+}
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_THREADPOLICYTEST_H_
+#define _ACTIVEMQ_THREADS_THREADPOLICYTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace activemq {
+namespace threads {
+
+    class ThreadPolicyTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( ThreadPolicyTest );
+        CPPUNIT_TEST( testDefaults );
+        CPPUNIT_TEST( testParseAffinity );
+        CPPUNIT_TEST( testParseAffinityInvalid );
+        CPPUNIT_TEST( testConfigure );
+        CPPUNIT_TEST( testConfigureInvalid );
+        CPPUNIT_TEST( testNewThread );
+        CPPUNIT_TEST( testAffinityApplied );
+        CPPUNIT_TEST( testTaskRunnerAffinityApplied );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        ThreadPolicyTest();
+        virtual ~ThreadPolicyTest();
+
+        void testDefaults();
+        void testParseAffinity();
+        void testParseAffinityInvalid();
+        void testConfigure();
+        void testConfigureInvalid();
+        void testNewThread();
+        void testAffinityApplied();
+        void testTaskRunnerAffinityApplied();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_THREADS_THREADPOLICYTEST_H_ */
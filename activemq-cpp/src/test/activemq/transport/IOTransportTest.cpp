@@ -32,6 +32,7 @@
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/Exception.h>
 #include <decaf/util/Random.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
 
 using namespace activemq;
 using namespace activemq::transport;
@@ -205,6 +206,23 @@ public:
     virtual void transportResumed() {}
 };
 
+////////////////////////////////////////////////////////////////////////////////
+class ThreadRecordingListener : public MyTransportListener {
+public:
+
+    std::string threadName;
+    std::vector<int> affinity;
+
+    ThreadRecordingListener() : MyTransportListener(1), threadName(), affinity() {}
+    virtual ~ThreadRecordingListener() {}
+
+    virtual void onCommand(const Pointer<commands::Command> command) {
+        threadName = decaf::lang::Thread::currentThread()->getName();
+        affinity = decaf::lang::Thread::currentThread()->getAffinity();
+        MyTransportListener::onCommand(command);
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // This will just test that we can start and stop the
 // transport without any exceptions.
@@ -394,3 +412,43 @@ void IOTransportTest::testNarrow(){
     CPPUNIT_ASSERT( narrowed == &transport );
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testThreadPolicy() {
+
+    std::vector<int> pinned;
+    try {
+        pinned.push_back(decaf::lang::Thread::currentThread()->getAffinity().back());
+    } catch (UnsupportedOperationException& ex) {
+        return;
+    }
+
+    threads::ThreadPolicy policy;
+    policy.setName(threads::ThreadPolicy::TRANSPORT_READER, "Pinned Reader");
+    policy.setAffinity(threads::ThreadPolicy::TRANSPORT_READER, pinned);
+
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::DataInputStream input(&is);
+    decaf::io::DataOutputStream output(&os);
+
+    ThreadRecordingListener listener;
+    IOTransport transport(Pointer<MyWireFormat>(new MyWireFormat()));
+    transport.setInputStream(&input);
+    transport.setOutputStream(&output);
+    transport.setTransportListener(&listener);
+    transport.setThreadPolicy(policy);
+
+    transport.start();
+
+    unsigned char buffer[1] = { '1' };
+    synchronized(&is) {
+        is.setByteArray(buffer, 1);
+    }
+
+    listener.await();
+    transport.close();
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Pinned Reader"), listener.threadName);
+    CPPUNIT_ASSERT_MESSAGE("Reader thread was not pinned", listener.affinity == pinned);
+}
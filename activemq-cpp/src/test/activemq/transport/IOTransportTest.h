@@ -34,6 +34,7 @@ namespace transport{
         CPPUNIT_TEST( testWrite );
         CPPUNIT_TEST( testException );
         CPPUNIT_TEST( testNarrow );
+        CPPUNIT_TEST( testThreadPolicy );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -46,6 +47,7 @@ namespace transport{
         void testStartClose();
         void testStressTransportStartClose();
         void testNarrow();
+        void testThreadPolicy();
 
     };
 
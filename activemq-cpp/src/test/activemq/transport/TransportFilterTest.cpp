@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TransportFilterTest.h"
+
+#include <activemq/commands/MessageAck.h>
+#include <activemq/transport/TransportFilter.h>
+#include <activemq/transport/correlator/ResponseCorrelator.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/OpenWireResponseBuilder.h>
+#include <decaf/util/LinkedList.h>
+#include <decaf/util/Properties.h>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::correlator;
+using namespace activemq::transport::mock;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // A filter written before onewayBatch existed, it only knows about oneway.
+    class CountingFilter : public TransportFilter {
+    public:
+
+        int count;
+
+        CountingFilter(const Pointer<Transport> next) : TransportFilter(next), count(0) {}
+        virtual ~CountingFilter() {}
+
+        virtual void oneway(const Pointer<Command> command) {
+            count++;
+            TransportFilter::oneway(command);
+        }
+    };
+
+    Pointer<MockTransport> createMockTransport() {
+        Properties properties;
+        Pointer<WireFormat> wireFormat(new OpenWireFormat(properties));
+        Pointer<ResponseBuilder> builder(new OpenWireResponseBuilder());
+        return Pointer<MockTransport>(new MockTransport(wireFormat, builder));
+    }
+
+    void createBatch(LinkedList< Pointer<Command> >& batch, int size) {
+        for (int i = 0; i < size; ++i) {
+            batch.add(Pointer<Command>(new MessageAck()));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TransportFilterTest::testOnewayBatchGoesThroughOneway() {
+
+    Pointer<MockTransport> mock = createMockTransport();
+    CountingFilter filter(mock);
+
+    LinkedList< Pointer<Command> > batch;
+    createBatch(batch, 3);
+
+    filter.onewayBatch(batch);
+
+    CPPUNIT_ASSERT_EQUAL(3, filter.count);
+    CPPUNIT_ASSERT_EQUAL(0, mock->getNumSentBatches());
+
+    filter.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TransportFilterTest::testOnewayBatchForwardedWhole() {
+
+    Pointer<MockTransport> mock = createMockTransport();
+    ResponseCorrelator correlator(mock);
+
+    LinkedList< Pointer<Command> > batch;
+    createBatch(batch, 3);
+
+    correlator.onewayBatch(batch);
+
+    CPPUNIT_ASSERT_EQUAL(1, mock->getNumSentBatches());
+
+    correlator.close();
+}
@@ -24,6 +24,7 @@
 #include <activemq/transport/correlator/ResponseCorrelator.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/CompletableFuture.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <queue>
 
@@ -324,6 +325,32 @@ namespace correlator {
         }
     };
 
+    typedef decaf::util::concurrent::CompletableFuture< Pointer<Response> > ResponseFuture;
+
+    // Starts a follow up request from the continuation of the previous one, on the
+    // transport thread that delivered the first response.
+    class FollowUpRequest : public decaf::util::concurrent::Continuation< Pointer<Response>, Pointer<ResponseFuture> > {
+    private:
+
+        ResponseCorrelator* correlator;
+
+    private:
+
+        FollowUpRequest(const FollowUpRequest&);
+        FollowUpRequest& operator= (const FollowUpRequest&);
+
+    public:
+
+        FollowUpRequest(ResponseCorrelator* correlator) : correlator(correlator) {}
+
+        virtual ~FollowUpRequest() {}
+
+        virtual Pointer<ResponseFuture> apply(const Pointer<Response>& response AMQCPP_UNUSED) {
+            Pointer<MyCommand> cmd(new MyCommand);
+            return this->correlator->asyncRequest(cmd, Pointer<ResponseCallback>());
+        }
+    };
+
 }}}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -514,3 +541,31 @@ void ResponseCorrelatorTest::testNarrow(){
     narrowed = correlator.narrow(typeid( correlator ));
     CPPUNIT_ASSERT(narrowed == &correlator);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ResponseCorrelatorTest::testAsyncRequestContinuation() {
+
+    MyListener listener;
+    Pointer<MyTransport> transport(new MyTransport());
+    ResponseCorrelator correlator(transport);
+    correlator.setTransportListener(&listener);
+
+    synchronized(&(transport->startedMutex)) {
+        correlator.start();
+        transport->startedMutex.wait();
+    }
+
+    Pointer<MyCommand> cmd(new MyCommand);
+    Pointer<FutureResponse> future = correlator.asyncRequest(cmd, Pointer<ResponseCallback>());
+
+    Pointer<ResponseFuture> next = future->thenCompose(
+        Pointer< decaf::util::concurrent::Continuation< Pointer<Response>, Pointer<ResponseFuture> > >(
+            new FollowUpRequest(&correlator)));
+
+    Pointer<Response> response = next->get(5, decaf::util::concurrent::TimeUnit::SECONDS);
+    CPPUNIT_ASSERT(response != NULL);
+    CPPUNIT_ASSERT(future->getResponse()->getCorrelationId() == cmd->getCommandId());
+    CPPUNIT_ASSERT(response->getCorrelationId() != cmd->getCommandId());
+
+    correlator.close();
+}
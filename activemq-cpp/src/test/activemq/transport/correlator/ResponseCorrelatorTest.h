@@ -33,6 +33,7 @@ namespace correlator{
         CPPUNIT_TEST( testTransportException );
         CPPUNIT_TEST( testMultiRequests );
         CPPUNIT_TEST( testNarrow );
+        CPPUNIT_TEST( testAsyncRequestContinuation );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -44,6 +45,7 @@ namespace correlator{
         void testTransportException();
         void testMultiRequests();
         void testNarrow();
+        void testAsyncRequestContinuation();
 
     };
 
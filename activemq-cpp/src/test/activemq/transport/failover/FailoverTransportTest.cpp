@@ -24,12 +24,16 @@
 #include <activemq/commands/ActiveMQMessage.h>
 #include <activemq/commands/ConnectionControl.h>
 #include <activemq/mock/MockBrokerService.h>
+#include <decaf/io/File.h>
+#include <decaf/util/ArrayList.h>
 #include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/util/UUID.h>
 
+#include <vector>
+
 using namespace activemq;
 using namespace activemq::mock;
 using namespace activemq::commands;
@@ -260,6 +264,52 @@ void FailoverTransportTest::testSendOnewayMessage() {
     transport->close();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransportTest::testSendOnewayBatch() {
+
+    std::string uri = "failover://(mock://localhost:61616)?randomize=false";
+
+    const int numMessages = 50;
+
+    MessageCountingListener messageCounter;
+    DefaultTransportListener listener;
+    FailoverTransportFactory factory;
+
+    Pointer<Transport> transport(factory.create(uri));
+    CPPUNIT_ASSERT(transport != NULL);
+    transport->setTransportListener(&listener);
+
+    FailoverTransport* failover =
+        dynamic_cast<FailoverTransport*>(transport->narrow(typeid(FailoverTransport)));
+
+    CPPUNIT_ASSERT(failover != NULL);
+
+    transport->start();
+
+    Thread::sleep(1000);
+    CPPUNIT_ASSERT(failover->isConnected() == true);
+
+    MockTransport* mock = NULL;
+    while (mock == NULL) {
+        mock = dynamic_cast<MockTransport*>(transport->narrow(typeid(MockTransport)));
+    }
+    mock->setOutgoingListener(&messageCounter);
+
+    ArrayList< Pointer<Command> > batch;
+    for (int i = 0; i < numMessages; ++i) {
+        batch.add(Pointer<Command>(new ActiveMQMessage()));
+    }
+
+    int batches = mock->getNumSentBatches();
+    transport->onewayBatch(batch);
+
+    // The connected transport is handed the whole batch in one call.
+    CPPUNIT_ASSERT_EQUAL(batches + 1, mock->getNumSentBatches());
+    CPPUNIT_ASSERT_EQUAL(numMessages, messageCounter.numMessages);
+
+    transport->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void FailoverTransportTest::testSendRequestMessage() {
 
@@ -1036,3 +1086,183 @@ void FailoverTransportTest::testConnectsToPriorityAfterInitialBackupFails() {
     broker3->stop();
     broker3->waitUntilStopped();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class SentMessageListener : public DefaultTransportListener {
+    public:
+
+        Mutex mutex;
+        std::vector<long long> sequenceIds;
+
+        SentMessageListener() : mutex(), sequenceIds() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            if (command->isMessage()) {
+                synchronized(&mutex) {
+                    sequenceIds.push_back(
+                        command.dynamicCast<Message>()->getMessageId()->getProducerSequenceId());
+                }
+            }
+        }
+    };
+
+    Pointer<ActiveMQMessage> createSpoolMessage(long long sequenceId) {
+        Pointer<ProducerId> producerId(new ProducerId());
+        producerId->setConnectionId("SPOOL");
+        producerId->setSessionId(1);
+        producerId->setValue(1);
+
+        Pointer<MessageId> messageId(new MessageId());
+        messageId->setProducerId(producerId);
+        messageId->setProducerSequenceId(sequenceId);
+
+        Pointer<ActiveMQMessage> message(new ActiveMQMessage());
+        message->setMessageId(messageId);
+        return message;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransportTest::testSpoolsSendsWhileDisconnected() {
+
+    const int SPOOLED_COUNT = 10;
+
+    std::string spoolFile = "FailoverTransportTest-" + UUID::randomUUID().toString();
+
+    {
+        std::string uri = "failover://(mock://localhost:61616?failOnCreate=true)?"
+                "useExponentialBackOff=false&initialReconnectDelay=100&"
+                "maxSpoolSize=1048576&spoolSyncEvery=4&spoolFile=" + spoolFile;
+
+        DefaultTransportListener listener;
+        FailoverTransportFactory factory;
+
+        Pointer<Transport> transport(factory.create(uri));
+        transport->setTransportListener(&listener);
+
+        FailoverTransport* failover =
+            dynamic_cast<FailoverTransport*>(transport->narrow(typeid(FailoverTransport)));
+
+        CPPUNIT_ASSERT(failover != NULL);
+        CPPUNIT_ASSERT_EQUAL(spoolFile, failover->getSpoolFile());
+        CPPUNIT_ASSERT_EQUAL(1048576LL, failover->getMaxSpoolSize());
+        CPPUNIT_ASSERT_EQUAL(4, failover->getSpoolSyncEvery());
+        CPPUNIT_ASSERT_EQUAL(1000LL, failover->getSpoolSyncInterval());
+
+        transport->start();
+
+        // None of these may block even though a broker is never reached.
+        for (int i = 0; i < SPOOLED_COUNT; ++i) {
+            transport->oneway(createSpoolMessage(i + 1));
+        }
+
+        CPPUNIT_ASSERT(failover->isConnected() == false);
+
+        transport->close();
+    }
+
+    CPPUNIT_ASSERT(File(spoolFile).exists());
+
+    {
+        std::string uri = "failover://(mock://localhost:61616)?spoolFile=" + spoolFile;
+
+        DefaultTransportListener listener;
+        FailoverTransportFactory factory;
+
+        Pointer<Transport> transport(factory.create(uri));
+        transport->setTransportListener(&listener);
+
+        FailoverTransport* failover =
+            dynamic_cast<FailoverTransport*>(transport->narrow(typeid(FailoverTransport)));
+
+        transport->start();
+
+        Thread::sleep(1000);
+        CPPUNIT_ASSERT(failover->isConnected() == true);
+
+        MockTransport* mock = NULL;
+        while (mock == NULL) {
+            mock = dynamic_cast<MockTransport*>(transport->narrow(typeid(MockTransport)));
+        }
+
+        SentMessageListener sent;
+        mock->setOutgoingListener(&sent);
+
+        // The spool recovered from the first run goes out ahead of the new message.
+        transport->oneway(createSpoolMessage(SPOOLED_COUNT + 1));
+
+        std::vector<long long> sequenceIds;
+        synchronized(&sent.mutex) {
+            sequenceIds = sent.sequenceIds;
+        }
+
+        CPPUNIT_ASSERT_EQUAL(SPOOLED_COUNT + 1, (int) sequenceIds.size());
+        for (int i = 0; i <= SPOOLED_COUNT; ++i) {
+            CPPUNIT_ASSERT_EQUAL((long long) i + 1, sequenceIds[i]);
+        }
+
+        transport->close();
+    }
+
+    File(spoolFile).remove();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransportTest::testLatencySelectionConnectsToFastestBroker() {
+
+    Pointer<MockBrokerService> broker1(new MockBrokerService(61626));
+    Pointer<MockBrokerService> broker2(new MockBrokerService(61627));
+    Pointer<MockBrokerService> broker3(new MockBrokerService(61628));
+
+    broker1->setAcceptDelay(400);
+    broker3->setAcceptDelay(200);
+
+    broker1->start();
+    broker1->waitUntilStarted();
+    broker2->start();
+    broker2->waitUntilStarted();
+    broker3->start();
+    broker3->waitUntilStarted();
+
+    std::string uri = "failover://(tcp://localhost:61626?transport.useInactivityMonitor=false,"
+                                  "tcp://localhost:61627?transport.useInactivityMonitor=false,"
+                                  "tcp://localhost:61628?transport.useInactivityMonitor=false)"
+                                  "?randomize=false&latencySelection=true&latencyProbe=wireformat"
+                                  "&latencyProbeTimeout=2000";
+
+    PriorityBackupListener listener;
+    FailoverTransportFactory factory;
+
+    Pointer<Transport> transport(factory.create(uri));
+    CPPUNIT_ASSERT(transport != NULL);
+    transport->setTransportListener(&listener);
+
+    FailoverTransport* failover =
+        dynamic_cast<FailoverTransport*>(transport->narrow(typeid(FailoverTransport)));
+
+    CPPUNIT_ASSERT(failover != NULL);
+    CPPUNIT_ASSERT(failover->isLatencySelection() == true);
+    CPPUNIT_ASSERT(failover->getLatencyProbeType() == LatencyProbe::WIREFORMAT);
+    CPPUNIT_ASSERT_EQUAL(2000, failover->getLatencyProbeTimeout());
+    CPPUNIT_ASSERT(failover->isLatencyRebalance() == false);
+
+    transport->start();
+
+    CPPUNIT_ASSERT_MESSAGE("Failed to get connected in time", listener.awaitResumed());
+    CPPUNIT_ASSERT(failover->isConnected() == true);
+
+    // The first URI in the list is the slowest, the second answers without delay.
+    CPPUNIT_ASSERT_EQUAL(std::string("tcp://localhost:61627?transport.useInactivityMonitor=false"),
+                         failover->getConnectedTransportURI());
+
+    transport->close();
+
+    broker1->stop();
+    broker1->waitUntilStopped();
+    broker2->stop();
+    broker2->waitUntilStopped();
+    broker3->stop();
+    broker3->waitUntilStopped();
+}
@@ -46,6 +46,7 @@ namespace failover {
         CPPUNIT_TEST( testTransportCreateFailOnCreateSendMessage );
         CPPUNIT_TEST( testFailingBackupCreation );
         CPPUNIT_TEST( testSendOnewayMessage );
+        CPPUNIT_TEST( testSendOnewayBatch );
         CPPUNIT_TEST( testSendRequestMessage );
         CPPUNIT_TEST( testSendOnewayMessageFail );
         CPPUNIT_TEST( testSendRequestMessageFail );
@@ -59,6 +60,8 @@ namespace failover {
         CPPUNIT_TEST( testStartupMaxReconnectsHonorsConfiguration );
         CPPUNIT_TEST( testConnectedToPriorityOnFirstTryThenFailover );
         CPPUNIT_TEST( testConnectsToPriorityOnceStarted );
+        CPPUNIT_TEST( testSpoolsSendsWhileDisconnected );
+        CPPUNIT_TEST( testLatencySelectionConnectsToFastestBroker );
         //CPPUNIT_TEST( testConnectsToPriorityAfterInitialBackupFails );
         CPPUNIT_TEST_SUITE_END();
 
@@ -73,6 +76,7 @@ namespace failover {
         void testTransportCreateFailOnCreateSendMessage();
         void testFailingBackupCreation();
         void testSendOnewayMessage();
+        void testSendOnewayBatch();
         void testSendRequestMessage();
         void testSendOnewayMessageFail();
         void testSendRequestMessageFail();
@@ -87,6 +91,8 @@ namespace failover {
         void testConnectedToPriorityOnFirstTryThenFailover();
         void testConnectsToPriorityOnceStarted();
         void testConnectsToPriorityAfterInitialBackupFails();
+        void testSpoolsSendsWhileDisconnected();
+        void testLatencySelectionConnectsToFastestBroker();
 
     private:
 
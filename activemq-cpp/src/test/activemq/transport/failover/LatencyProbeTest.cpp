@@ -0,0 +1,170 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyProbeTest.h"
+
+#include <activemq/transport/failover/LatencyProbe.h>
+#include <activemq/transport/failover/URIPool.h>
+#include <activemq/mock/MockBrokerService.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/net/ServerSocket.h>
+#include <decaf/net/URI.h>
+#include <decaf/util/LinkedList.h>
+
+using namespace activemq;
+using namespace activemq::mock;
+using namespace activemq::transport;
+using namespace activemq::transport::failover;
+using namespace decaf::lang;
+using namespace decaf::net;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyProbeTest::LatencyProbeTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyProbeTest::~LatencyProbeTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbeTest::testIsBetter() {
+
+    CPPUNIT_ASSERT(LatencyProbe::isBetter(10, 20));
+    CPPUNIT_ASSERT(!LatencyProbe::isBetter(20, 10));
+    CPPUNIT_ASSERT(!LatencyProbe::isBetter(10, 10));
+    CPPUNIT_ASSERT(LatencyProbe::isBetter(5000, LatencyProbe::UNKNOWN));
+    CPPUNIT_ASSERT(LatencyProbe::isBetter(5000, LatencyProbe::UNREACHABLE));
+    CPPUNIT_ASSERT(LatencyProbe::isBetter(LatencyProbe::UNKNOWN, LatencyProbe::UNREACHABLE));
+    CPPUNIT_ASSERT(!LatencyProbe::isBetter(LatencyProbe::UNREACHABLE, LatencyProbe::UNKNOWN));
+    CPPUNIT_ASSERT(!LatencyProbe::isBetter(LatencyProbe::UNKNOWN, 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbeTest::testProbeMeasuresDelays() {
+
+    MockBrokerService slow;
+    MockBrokerService fast;
+    slow.setAcceptDelay(300);
+
+    slow.start();
+    slow.waitUntilStarted();
+    fast.start();
+    fast.waitUntilStarted();
+
+    // Nothing listens on a port that was just released.
+    int closedPort = 0;
+    {
+        ServerSocket socket(0);
+        closedPort = socket.getLocalPort();
+        socket.close();
+    }
+
+    URI slowURI(slow.getConnectString());
+    URI fastURI(fast.getConnectString());
+    URI closedURI("tcp://localhost:" + Integer::toString(closedPort));
+
+    LinkedList<URI> uris;
+    uris.add(slowURI);
+    uris.add(fastURI);
+    uris.add(closedURI);
+
+    LatencyProbe probe;
+    probe.setProbeType(LatencyProbe::WIREFORMAT);
+    probe.setTimeout(2000);
+    CPPUNIT_ASSERT(probe.isStale());
+
+    probe.probe(uris);
+    CPPUNIT_ASSERT(!probe.isStale());
+
+    CPPUNIT_ASSERT(probe.getLatency(slowURI) >= 300 * 1000);
+    CPPUNIT_ASSERT(probe.getLatency(fastURI) >= 0);
+    CPPUNIT_ASSERT(probe.getLatency(fastURI) < probe.getLatency(slowURI));
+    CPPUNIT_ASSERT_EQUAL(LatencyProbe::UNREACHABLE, probe.getLatency(closedURI));
+    CPPUNIT_ASSERT(!probe.getFailure(closedURI).empty());
+    CPPUNIT_ASSERT(probe.getFailure(fastURI).empty());
+
+    // A later success clears the recorded failure.
+    probe.setLatency(closedURI, 1000);
+    CPPUNIT_ASSERT(probe.getFailure(closedURI).empty());
+
+    // The connect alone does not wait on the broker.
+    probe.setProbeType(LatencyProbe::CONNECT);
+    probe.probe(uris);
+    CPPUNIT_ASSERT(probe.getLatency(slowURI) >= 0);
+    CPPUNIT_ASSERT(probe.getLatency(slowURI) < 300 * 1000);
+
+    slow.stop();
+    slow.waitUntilStopped();
+    fast.stop();
+    fast.waitUntilStopped();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbeTest::testUnprobeableURIsAreUnknown() {
+
+    URI mock("mock://localhost");
+
+    LinkedList<URI> uris;
+    uris.add(mock);
+
+    LatencyProbe probe;
+    probe.setInterval(60000);
+    probe.probe(uris);
+
+    CPPUNIT_ASSERT_EQUAL(LatencyProbe::UNKNOWN, probe.getLatency(mock));
+    CPPUNIT_ASSERT_EQUAL(LatencyProbe::UNKNOWN, probe.getLatency(URI("tcp://localhost:61616")));
+    CPPUNIT_ASSERT(!probe.isStale());
+
+    probe.setInterval(0);
+    CPPUNIT_ASSERT(probe.isStale());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyProbeTest::testURIPoolPrefersLowestLatency() {
+
+    URI unreachable("tcp://broker1:61616");
+    URI unknown("tcp://broker2:61616");
+    URI slow("tcp://broker3:61616");
+    URI fast("tcp://broker4:61616");
+
+    LinkedList<URI> uris;
+    uris.add(unreachable);
+    uris.add(unknown);
+    uris.add(slow);
+    uris.add(fast);
+
+    Pointer<LatencyProbe> probe(new LatencyProbe());
+    probe->setLatency(unreachable, LatencyProbe::UNREACHABLE);
+    probe->setLatency(slow, 2000);
+    probe->setLatency(fast, 150);
+
+    URIPool pool(uris);
+    pool.setLatencyProbe(probe);
+
+    CPPUNIT_ASSERT(pool.getURI().equals(fast));
+    CPPUNIT_ASSERT(pool.getURI().equals(slow));
+    CPPUNIT_ASSERT(pool.getURI().equals(unknown));
+    CPPUNIT_ASSERT(pool.getURI().equals(unreachable));
+    CPPUNIT_ASSERT(pool.isEmpty());
+
+    // Without a probe the pool goes back to taking URIs in order.
+    pool.addURIs(uris);
+    pool.setLatencyProbe(Pointer<LatencyProbe>());
+    CPPUNIT_ASSERT(pool.getURI().equals(unreachable));
+}
@@ -0,0 +1,409 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageSpoolTest.h"
+
+#include <activemq/transport/failover/MessageSpool.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/transport/mock/MockTransportFactory.h>
+#include <activemq/commands/ActiveMQMessage.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/SessionId.h>
+#include <decaf/io/File.h>
+#include <decaf/io/FileInputStream.h>
+#include <decaf/io/FileOutputStream.h>
+#include <decaf/net/URI.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/UUID.h>
+
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::failover;
+using namespace activemq::transport::mock;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordingListener : public DefaultTransportListener {
+    public:
+
+        ArrayList<Pointer<Command> > commands;
+
+        RecordingListener() : commands() {}
+
+        virtual ~RecordingListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            commands.add(command);
+        }
+    };
+
+    Pointer<MockTransport> createTransport() {
+        MockTransportFactory factory;
+        return factory.createComposite(decaf::net::URI("mock://mock?wireformat=openwire")).dynamicCast<MockTransport>();
+    }
+
+    Pointer<ProducerId> createProducerId(long long sessionId, long long value) {
+        Pointer<ProducerId> producerId(new ProducerId());
+        producerId->setConnectionId("SPOOL");
+        producerId->setSessionId(sessionId);
+        producerId->setValue(value);
+        return producerId;
+    }
+
+    Pointer<Command> createMessage(long long sequenceId, Pointer<ProducerId> producerId) {
+
+        Pointer<MessageId> messageId(new MessageId());
+        messageId->setProducerId(producerId);
+        messageId->setProducerSequenceId(sequenceId);
+
+        Pointer<ActiveMQMessage> message(new ActiveMQMessage());
+        message->setMessageId(messageId);
+        message->setProducerId(producerId);
+        return message;
+    }
+
+    Pointer<Command> createMessage(long long sequenceId) {
+        return createMessage(sequenceId, createProducerId(1, 1));
+    }
+
+    long long sequenceOf(const Pointer<Command>& command) {
+        return command.dynamicCast<Message>()->getMessageId()->getProducerSequenceId();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageSpoolTest::MessageSpoolTest() : fileName() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageSpoolTest::~MessageSpoolTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::setUp() {
+    this->fileName = "MessageSpoolTest-" + UUID::randomUUID().toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::tearDown() {
+    File(this->fileName).remove();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testAppendAndReplay() {
+
+    const int MESSAGE_COUNT = 25;
+
+    Pointer<MockTransport> transport = createTransport();
+    RecordingListener listener;
+    transport->setOutgoingListener(&listener);
+
+    MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+    spool.open();
+    CPPUNIT_ASSERT(spool.isOpen());
+    CPPUNIT_ASSERT(spool.isEmpty());
+
+    long long emptySize = spool.getFileSize();
+    CPPUNIT_ASSERT_EQUAL(emptySize, File(fileName).length());
+
+    for (int i = 0; i < MESSAGE_COUNT; ++i) {
+        CPPUNIT_ASSERT(spool.append(createMessage(i + 1)));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(MESSAGE_COUNT, spool.size());
+    CPPUNIT_ASSERT_EQUAL(spool.getFileSize(), File(fileName).length());
+
+    CPPUNIT_ASSERT_EQUAL(MESSAGE_COUNT, spool.replay(transport, 10));
+    CPPUNIT_ASSERT_EQUAL(3, transport->getNumSentBatches());
+    CPPUNIT_ASSERT_EQUAL(MESSAGE_COUNT, listener.commands.size());
+
+    for (int i = 0; i < MESSAGE_COUNT; ++i) {
+        CPPUNIT_ASSERT(listener.commands.get(i)->isMessage());
+        CPPUNIT_ASSERT_EQUAL((long long) i + 1, sequenceOf(listener.commands.get(i)));
+    }
+
+    CPPUNIT_ASSERT(spool.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(emptySize, spool.getFileSize());
+    CPPUNIT_ASSERT_EQUAL(emptySize, File(fileName).length());
+
+    spool.close();
+    CPPUNIT_ASSERT(!spool.isOpen());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testMaxSize() {
+
+    const long long MAX_SIZE = 2048;
+
+    Pointer<MockTransport> transport = createTransport();
+
+    MessageSpool spool(transport.get(), fileName, MAX_SIZE);
+    spool.open();
+
+    int appended = 0;
+    while (spool.append(createMessage(appended + 1))) {
+        appended++;
+        CPPUNIT_ASSERT(appended < 1000);
+    }
+
+    CPPUNIT_ASSERT(appended > 0);
+    CPPUNIT_ASSERT_EQUAL(appended, spool.size());
+    CPPUNIT_ASSERT(spool.getFileSize() <= MAX_SIZE);
+    CPPUNIT_ASSERT(File(fileName).length() <= MAX_SIZE);
+
+    // Space comes back once the spool has been replayed.
+    spool.replay(transport, 100);
+    CPPUNIT_ASSERT(spool.append(createMessage(1)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testRecoverAfterReopen() {
+
+    Pointer<MockTransport> transport = createTransport();
+    RecordingListener listener;
+    transport->setOutgoingListener(&listener);
+
+    {
+        MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+        spool.open();
+        for (int i = 0; i < 5; ++i) {
+            spool.append(createMessage(i + 1));
+        }
+    }
+
+    MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+    spool.open();
+    CPPUNIT_ASSERT_EQUAL(5, spool.size());
+
+    spool.append(createMessage(6));
+    CPPUNIT_ASSERT_EQUAL(6, spool.replay(transport, 100));
+
+    for (int i = 0; i < 6; ++i) {
+        CPPUNIT_ASSERT_EQUAL((long long) i + 1, sequenceOf(listener.commands.get(i)));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testRecoverTornTail() {
+
+    Pointer<MockTransport> transport = createTransport();
+    RecordingListener listener;
+    transport->setOutgoingListener(&listener);
+
+    long long validSize = 0;
+
+    {
+        MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+        spool.open();
+        for (int i = 0; i < 5; ++i) {
+            spool.append(createMessage(i + 1));
+        }
+        validSize = spool.getFileSize();
+    }
+
+    // Simulate a crash part way through writing the next record.
+    {
+        FileOutputStream out(fileName, true);
+        unsigned char partial[] = { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 42, 1, 2, 3 };
+        out.write(partial, (int) sizeof(partial), 0, (int) sizeof(partial));
+    }
+
+    CPPUNIT_ASSERT(File(fileName).length() > validSize);
+
+    MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+    spool.open();
+    CPPUNIT_ASSERT_EQUAL(5, spool.size());
+    CPPUNIT_ASSERT_EQUAL(validSize, spool.getFileSize());
+    CPPUNIT_ASSERT_EQUAL(validSize, File(fileName).length());
+    CPPUNIT_ASSERT(!File(fileName + ".tmp").exists());
+
+    // New records land after the good ones, not after the damaged tail.
+    spool.append(createMessage(6));
+    CPPUNIT_ASSERT_EQUAL(6, spool.replay(transport, 100));
+    CPPUNIT_ASSERT_EQUAL(6, listener.commands.size());
+    CPPUNIT_ASSERT_EQUAL(6LL, sequenceOf(listener.commands.get(5)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testReplayFailureKeepsRecords() {
+
+    Pointer<MockTransport> transport = createTransport();
+    RecordingListener listener;
+    transport->setOutgoingListener(&listener);
+
+    MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+    spool.open();
+    for (int i = 0; i < 5; ++i) {
+        spool.append(createMessage(i + 1));
+    }
+
+    transport->setFailOnSendMessage(true);
+    transport->setNumSentMessageBeforeFail(2);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        spool.replay(transport, 100),
+        decaf::io::IOException);
+
+    CPPUNIT_ASSERT(spool.isOpen());
+    CPPUNIT_ASSERT_EQUAL(5, spool.size());
+
+    transport->setFailOnSendMessage(false);
+    listener.commands.clear();
+
+    CPPUNIT_ASSERT_EQUAL(5, spool.replay(transport, 100));
+    CPPUNIT_ASSERT_EQUAL(5, listener.commands.size());
+    CPPUNIT_ASSERT(spool.isEmpty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testReplayStopsAtDamagedRecord() {
+
+    Pointer<MockTransport> transport = createTransport();
+    RecordingListener listener;
+    transport->setOutgoingListener(&listener);
+
+    MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+    spool.open();
+    for (int i = 0; i < 2; ++i) {
+        spool.append(createMessage(i + 1));
+    }
+    spool.append(createMessage(3));
+    long long damagedEnd = spool.getFileSize();
+    for (int i = 3; i < 5; ++i) {
+        spool.append(createMessage(i + 1));
+    }
+
+    // Flip the last byte of the third record so that its checksum no longer matches.
+    std::vector<unsigned char> contents((std::size_t) File(fileName).length());
+    {
+        FileInputStream in(fileName);
+        int total = 0;
+        while (total < (int) contents.size()) {
+            int count = in.read(&contents[0], (int) contents.size(), total, (int) contents.size() - total);
+            CPPUNIT_ASSERT(count > 0);
+            total += count;
+        }
+    }
+    contents[(std::size_t) damagedEnd - 1] ^= 0xFF;
+    {
+        FileOutputStream out(fileName, false);
+        out.write(&contents[0], (int) contents.size(), 0, (int) contents.size());
+    }
+
+    // The records ahead of the damage go out and the spool starts over.
+    CPPUNIT_ASSERT_EQUAL(2, spool.replay(transport, 100));
+    CPPUNIT_ASSERT_EQUAL(2, listener.commands.size());
+    CPPUNIT_ASSERT_EQUAL(1LL, sequenceOf(listener.commands.get(0)));
+    CPPUNIT_ASSERT_EQUAL(2LL, sequenceOf(listener.commands.get(1)));
+    CPPUNIT_ASSERT(spool.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(spool.getFileSize(), File(fileName).length());
+
+    listener.commands.clear();
+    CPPUNIT_ASSERT(spool.append(createMessage(6)));
+    CPPUNIT_ASSERT_EQUAL(1, spool.replay(transport, 100));
+    CPPUNIT_ASSERT_EQUAL(6LL, sequenceOf(listener.commands.get(0)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testDiscardSendsFromRemovedProducers() {
+
+    Pointer<MockTransport> transport = createTransport();
+    RecordingListener listener;
+    transport->setOutgoingListener(&listener);
+
+    MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+    spool.open();
+
+    // Producers 1 and 2 share session 1, producer 3 is alone in session 2.
+    for (int i = 0; i < 9; ++i) {
+        spool.append(createMessage(i + 1, createProducerId(i % 3 == 2 ? 2 : 1, i % 3 + 1)));
+    }
+
+    // Ids of other kinds are ignored, removing producer 2 drops its sends.
+    spool.discardSendsFrom(Pointer<DataStructure>(new MessageId()));
+    spool.discardSendsFrom(createProducerId(1, 2));
+
+    CPPUNIT_ASSERT_EQUAL(6, spool.replay(transport, 10));
+    CPPUNIT_ASSERT_EQUAL(6, listener.commands.size());
+    for (int i = 0; i < listener.commands.size(); ++i) {
+        CPPUNIT_ASSERT(sequenceOf(listener.commands.get(i)) % 3 != 2);
+    }
+
+    // A removed session takes the sends of all of its producers with it.
+    for (int i = 0; i < 9; ++i) {
+        spool.append(createMessage(i + 1, createProducerId(i % 3 == 2 ? 2 : 1, i % 3 + 1)));
+    }
+
+    Pointer<SessionId> sessionId(new SessionId());
+    sessionId->setConnectionId("SPOOL");
+    sessionId->setValue(1);
+    spool.discardSendsFrom(sessionId);
+
+    listener.commands.clear();
+    CPPUNIT_ASSERT_EQUAL(3, spool.replay(transport, 10));
+    for (int i = 0; i < listener.commands.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(0LL, sequenceOf(listener.commands.get(i)) % 3);
+    }
+
+    // Replay forgets the removals, a later outage starts over.
+    spool.append(createMessage(1, createProducerId(1, 1)));
+    listener.commands.clear();
+    CPPUNIT_ASSERT_EQUAL(1, spool.replay(transport, 10));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testSyncPolicy() {
+
+    Pointer<MockTransport> transport = createTransport();
+
+    MessageSpool spool(transport.get(), fileName, 1024 * 1024);
+    CPPUNIT_ASSERT_EQUAL(0, spool.getSyncEvery());
+    CPPUNIT_ASSERT_EQUAL(0LL, spool.getSyncInterval());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        spool.sync(),
+        IOException);
+
+    spool.setSyncEvery(-1);
+    CPPUNIT_ASSERT_EQUAL(0, spool.getSyncEvery());
+    spool.setSyncEvery(1);
+    spool.setSyncInterval(50);
+    CPPUNIT_ASSERT_EQUAL(1, spool.getSyncEvery());
+    CPPUNIT_ASSERT_EQUAL(50LL, spool.getSyncInterval());
+
+    spool.open();
+    for (int i = 0; i < 5; ++i) {
+        CPPUNIT_ASSERT(spool.append(createMessage(i + 1)));
+    }
+    spool.sync();
+    spool.close();
+
+    MessageSpool reopened(transport.get(), fileName, 1024 * 1024);
+    reopened.open();
+    CPPUNIT_ASSERT_EQUAL(5, reopened.size());
+}
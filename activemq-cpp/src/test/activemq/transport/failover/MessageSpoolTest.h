@@ -0,0 +1,68 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_FAILOVER_MESSAGESPOOLTEST_H_
+#define _ACTIVEMQ_TRANSPORT_FAILOVER_MESSAGESPOOLTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    class MessageSpoolTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( MessageSpoolTest );
+        CPPUNIT_TEST( testAppendAndReplay );
+        CPPUNIT_TEST( testMaxSize );
+        CPPUNIT_TEST( testRecoverAfterReopen );
+        CPPUNIT_TEST( testRecoverTornTail );
+        CPPUNIT_TEST( testReplayFailureKeepsRecords );
+        CPPUNIT_TEST( testReplayStopsAtDamagedRecord );
+        CPPUNIT_TEST( testDiscardSendsFromRemovedProducers );
+        CPPUNIT_TEST( testSyncPolicy );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        std::string fileName;
+
+    public:
+
+        MessageSpoolTest();
+        virtual ~MessageSpoolTest();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testAppendAndReplay();
+        void testMaxSize();
+        void testRecoverAfterReopen();
+        void testRecoverTornTail();
+        void testReplayFailureKeepsRecords();
+        void testReplayStopsAtDamagedRecord();
+        void testDiscardSendsFromRemovedProducers();
+        void testSyncPolicy();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_FAILOVER_MESSAGESPOOLTEST_H_ */
@@ -30,6 +30,7 @@
 #include <decaf/io/InputStream.h>
 #include <decaf/io/OutputStream.h>
 #include <decaf/util/Random.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
 
 using namespace decaf;
 using namespace decaf::lang;
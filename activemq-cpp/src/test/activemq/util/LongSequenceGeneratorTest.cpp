@@ -33,3 +33,16 @@ void LongSequenceGeneratorTest::test() {
     CPPUNIT_ASSERT( result2 < sequence.getNextSequenceId() );
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void LongSequenceGeneratorTest::testReserve() {
+
+    LongSequenceGenerator sequence;
+
+    long long first = sequence.getNextSequenceId();
+    long long reserved = sequence.getNextSequenceIds(10);
+
+    CPPUNIT_ASSERT_EQUAL( first + 1, reserved );
+    CPPUNIT_ASSERT_EQUAL( reserved + 9, sequence.getLastSequenceId() );
+    CPPUNIT_ASSERT_EQUAL( reserved + 10, sequence.getNextSequenceId() );
+}
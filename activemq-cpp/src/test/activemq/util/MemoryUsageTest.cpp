@@ -21,6 +21,10 @@
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Concurrent.h>
+
+#include <vector>
 
 using namespace activemq;
 using namespace activemq::util;
@@ -48,6 +52,54 @@ namespace {
             this->usage->decreaseUsage(this->usage->getUsage());
         }
     };
+
+    class EnqueueRunner : public decaf::lang::Runnable {
+    private:
+
+        EnqueueRunner(const EnqueueRunner&);
+        EnqueueRunner& operator= (const EnqueueRunner&);
+
+    private:
+
+        MemoryUsage* usage;
+        unsigned long long amount;
+        int id;
+        std::vector<int>* completed;
+        decaf::util::concurrent::Mutex* lock;
+
+    public:
+
+        EnqueueRunner(MemoryUsage* usage, unsigned long long amount, int id,
+                      std::vector<int>* completed, decaf::util::concurrent::Mutex* lock) :
+            usage(usage), amount(amount), id(id), completed(completed), lock(lock) {}
+
+        virtual void run() {
+            this->usage->enqueueUsage(this->amount);
+            synchronized(lock) {
+                completed->push_back(id);
+            }
+        }
+    };
+
+    void waitForWaiters(MemoryUsage& usage, int count) {
+        for (int i = 0; i < 200 && usage.getWaitingCount() < count; ++i) {
+            Thread::sleep(10);
+        }
+    }
+
+    std::size_t completedCount(std::vector<int>& completed, decaf::util::concurrent::Mutex& lock) {
+        std::size_t result = 0;
+        synchronized(&lock) {
+            result = completed.size();
+        }
+        return result;
+    }
+
+    void waitForCompleted(std::vector<int>& completed, decaf::util::concurrent::Mutex& lock, std::size_t count) {
+        for (int i = 0; i < 200 && completedCount(completed, lock) < count; ++i) {
+            Thread::sleep(10);
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -104,6 +156,86 @@ void MemoryUsageTest::testTimedWait() {
     unsigned long long endTime = System::currentTimeMillis();
 
     CPPUNIT_ASSERT( endTime - startTime >= 125 );
+
+    startTime = System::currentTimeMillis();
+    CPPUNIT_ASSERT( !usage.tryWaitForSpace( 150 ) );
+    endTime = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( endTime - startTime >= 125 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testTimedEnqueueUsage() {
+
+    MemoryUsage usage( 100 );
+    usage.increaseUsage( 100 );
+
+    unsigned long long startTime = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( !usage.enqueueUsage( 10, 150 ) );
+
+    unsigned long long endTime = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( endTime - startTime >= 125 );
+    CPPUNIT_ASSERT_EQUAL( 100ULL, usage.getUsage() );
+    CPPUNIT_ASSERT_EQUAL( 0, usage.getWaitingCount() );
+
+    usage.decreaseUsage( 50 );
+    CPPUNIT_ASSERT( usage.enqueueUsage( 10, 150 ) );
+    CPPUNIT_ASSERT_EQUAL( 60ULL, usage.getUsage() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testZeroTimeoutWaitsForSpace() {
+
+    MemoryUsage usage( 100 );
+    usage.increaseUsage( 100 );
+
+    UsageRunner runner1( &usage );
+    Thread thread1( &runner1 );
+    thread1.start();
+
+    CPPUNIT_ASSERT( usage.tryWaitForSpace( 0 ) );
+    thread1.join();
+
+    usage.increaseUsage( 100 );
+
+    UsageRunner runner2( &usage );
+    Thread thread2( &runner2 );
+    thread2.start();
+
+    CPPUNIT_ASSERT( usage.enqueueUsage( 10, 0 ) );
+    CPPUNIT_ASSERT_EQUAL( 10ULL, usage.getUsage() );
+    thread2.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testReserveUsage() {
+
+    MemoryUsage usage( 100 );
+    usage.increaseUsage( 50 );
+
+    // Below the limit but without room for all of it.
+    CPPUNIT_ASSERT( !usage.reserveUsage( 60, 100 ) );
+    CPPUNIT_ASSERT_EQUAL( 50ULL, usage.getUsage() );
+    CPPUNIT_ASSERT_EQUAL( 0, usage.getWaitingCount() );
+
+    usage.decreaseUsage( 20 );
+    CPPUNIT_ASSERT( usage.reserveUsage( 60, 100 ) );
+    CPPUNIT_ASSERT_EQUAL( 90ULL, usage.getUsage() );
+
+    // More than the limit only has to wait for the usage to drain.
+    CPPUNIT_ASSERT( !usage.reserveUsage( 500, 50 ) );
+    CPPUNIT_ASSERT_EQUAL( 90ULL, usage.getUsage() );
+
+    UsageRunner runner( &usage );
+    Thread myThread( &runner );
+    myThread.start();
+
+    CPPUNIT_ASSERT( usage.reserveUsage( 500, 0 ) );
+    CPPUNIT_ASSERT_EQUAL( 500ULL, usage.getUsage() );
+
+    myThread.join();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -121,3 +253,127 @@ void MemoryUsageTest::testWait() {
 
     myThread.join();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testTimedWaitWakesOnSpace() {
+
+    MemoryUsage usage( 2048 );
+    usage.increaseUsage( 5072 );
+    UsageRunner runner( &usage );
+
+    Thread myThread( &runner );
+    myThread.start();
+
+    unsigned long long startTime = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( usage.tryWaitForSpace( 5000 ) );
+
+    unsigned long long endTime = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( endTime - startTime < 2500 );
+    CPPUNIT_ASSERT( !usage.isFull() );
+    CPPUNIT_ASSERT_EQUAL( 0, usage.getWaitingCount() );
+
+    myThread.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testEnqueueUsageReservesCredit() {
+
+    MemoryUsage usage( 100 );
+    usage.enqueueUsage( 100 );
+    CPPUNIT_ASSERT( usage.isFull() );
+
+    std::vector<int> completed;
+    decaf::util::concurrent::Mutex lock;
+
+    EnqueueRunner runner1( &usage, 100, 1, &completed, &lock );
+    EnqueueRunner runner2( &usage, 100, 2, &completed, &lock );
+
+    Thread thread1( &runner1 );
+    Thread thread2( &runner2 );
+    thread1.start();
+    thread2.start();
+
+    waitForWaiters( usage, 2 );
+    CPPUNIT_ASSERT_EQUAL( 2, usage.getWaitingCount() );
+
+    // Returning enough credit for one send must release only one producer.
+    usage.decreaseUsage( 100 );
+    waitForCompleted( completed, lock, 1 );
+    Thread::sleep( 50 );
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 1, completedCount( completed, lock ) );
+    CPPUNIT_ASSERT_EQUAL( 1, usage.getWaitingCount() );
+    CPPUNIT_ASSERT_EQUAL( 100ULL, usage.getUsage() );
+
+    usage.decreaseUsage( 100 );
+    waitForCompleted( completed, lock, 2 );
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 2, completedCount( completed, lock ) );
+    CPPUNIT_ASSERT_EQUAL( 0, usage.getWaitingCount() );
+    CPPUNIT_ASSERT_EQUAL( 100ULL, usage.getUsage() );
+
+    thread1.join();
+    thread2.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testWaitersReleasedInOrder() {
+
+    const int COUNT = 5;
+
+    MemoryUsage usage( 10 );
+    usage.increaseUsage( 10 );
+
+    std::vector<int> completed;
+    decaf::util::concurrent::Mutex lock;
+
+    std::vector<EnqueueRunner*> runners;
+    std::vector<Thread*> threads;
+
+    for (int i = 0; i < COUNT; ++i) {
+        runners.push_back( new EnqueueRunner( &usage, 10, i, &completed, &lock ) );
+        threads.push_back( new Thread( runners.back() ) );
+        threads.back()->start();
+        waitForWaiters( usage, i + 1 );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( COUNT, usage.getWaitingCount() );
+
+    for (int i = 0; i < COUNT; ++i) {
+        usage.decreaseUsage( 10 );
+        waitForCompleted( completed, lock, i + 1 );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) COUNT, completed.size() );
+    for (int i = 0; i < COUNT; ++i) {
+        CPPUNIT_ASSERT_EQUAL( i, completed[i] );
+        threads[i]->join();
+        delete threads[i];
+        delete runners[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testSetLimitWakesWaiters() {
+
+    MemoryUsage usage( 10 );
+    usage.increaseUsage( 10 );
+
+    std::vector<int> completed;
+    decaf::util::concurrent::Mutex lock;
+
+    EnqueueRunner runner( &usage, 10, 1, &completed, &lock );
+    Thread myThread( &runner );
+    myThread.start();
+
+    waitForWaiters( usage, 1 );
+    CPPUNIT_ASSERT_EQUAL( 1, usage.getWaitingCount() );
+
+    usage.setLimit( 100 );
+    myThread.join();
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 1, completed.size() );
+    CPPUNIT_ASSERT_EQUAL( 20ULL, usage.getUsage() );
+}
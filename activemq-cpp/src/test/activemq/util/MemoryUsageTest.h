@@ -31,6 +31,13 @@ namespace util {
         CPPUNIT_TEST( testUsage );
         CPPUNIT_TEST( testTimedWait );
         CPPUNIT_TEST( testWait );
+        CPPUNIT_TEST( testTimedWaitWakesOnSpace );
+        CPPUNIT_TEST( testTimedEnqueueUsage );
+        CPPUNIT_TEST( testZeroTimeoutWaitsForSpace );
+        CPPUNIT_TEST( testReserveUsage );
+        CPPUNIT_TEST( testEnqueueUsageReservesCredit );
+        CPPUNIT_TEST( testWaitersReleasedInOrder );
+        CPPUNIT_TEST( testSetLimitWakesWaiters );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -42,6 +49,13 @@ namespace util {
         void testUsage();
         void testTimedWait();
         void testWait();
+        void testTimedWaitWakesOnSpace();
+        void testTimedEnqueueUsage();
+        void testZeroTimeoutWaitsForSpace();
+        void testReserveUsage();
+        void testEnqueueUsageReservesCredit();
+        void testWaitersReleasedInOrder();
+        void testSetLimitWakesWaiters();
 
     };
 
@@ -316,3 +316,45 @@ void PrimitiveListTest::testListOfMaps() {
     CPPUNIT_ASSERT( list.get(2).getMap().get("3").getInt() == 3 );
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveListTest::testDirtyTracking() {
+
+    PrimitiveList plist;
+    CPPUNIT_ASSERT( plist.isDirty() );
+
+    plist.add( 1 );
+    plist.add( 2 );
+    plist.clearDirty();
+    CPPUNIT_ASSERT( !plist.isDirty() );
+
+    // Reads leave the list clean.
+    const PrimitiveList& constList = plist;
+    CPPUNIT_ASSERT( plist.getInt( 0 ) == 1 );
+    CPPUNIT_ASSERT( plist.size() == 2 );
+    CPPUNIT_ASSERT( constList.getFirst().getInt() == 1 );
+    CPPUNIT_ASSERT( !plist.isDirty() );
+
+    plist.add( 3 );
+    CPPUNIT_ASSERT( plist.isDirty() );
+    plist.clearDirty();
+
+    plist.setInt( 0, 5 );
+    CPPUNIT_ASSERT( plist.isDirty() );
+    plist.clearDirty();
+
+    plist.removeAt( 2 );
+    CPPUNIT_ASSERT( plist.isDirty() );
+    plist.clearDirty();
+
+    plist.getLast().setInt( 7 );
+    CPPUNIT_ASSERT( plist.isDirty() );
+    plist.clearDirty();
+
+    std::auto_ptr< decaf::util::Iterator<PrimitiveValueNode> > iter( plist.iterator() );
+    CPPUNIT_ASSERT( plist.isDirty() );
+    plist.clearDirty();
+
+    plist.clear();
+    CPPUNIT_ASSERT( plist.isDirty() );
+}
@@ -38,6 +38,7 @@ namespace util{
         CPPUNIT_TEST( testContains );
         CPPUNIT_TEST( testListOfLists );
         CPPUNIT_TEST( testListOfMaps );
+        CPPUNIT_TEST( testDirtyTracking );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -55,6 +56,7 @@ namespace util{
         void testContains();
         void testListOfLists();
         void testListOfMaps();
+        void testDirtyTracking();
 
     };
 
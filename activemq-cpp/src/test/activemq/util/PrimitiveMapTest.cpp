@@ -287,3 +287,55 @@ void PrimitiveMapTest::testGetKeys(){
     CPPUNIT_ASSERT( keys[1] == "int" || keys[1] == "float" || keys[1] == "int2" );
     CPPUNIT_ASSERT( keys[2] == "int" || keys[2] == "float" || keys[2] == "int2" );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMapTest::testDirtyTracking() {
+
+    PrimitiveMap pmap;
+    CPPUNIT_ASSERT( pmap.isDirty() );
+
+    pmap.setInt( "int", 1 );
+    pmap.setString( "string", "hello" );
+    pmap.clearDirty();
+    CPPUNIT_ASSERT( !pmap.isDirty() );
+
+    // Reads leave the map clean.
+    const PrimitiveMap& constMap = pmap;
+    CPPUNIT_ASSERT( pmap.getInt( "int" ) == 1 );
+    CPPUNIT_ASSERT( pmap.containsKey( "string" ) );
+    CPPUNIT_ASSERT( constMap.get( "string" ).getString() == "hello" );
+    CPPUNIT_ASSERT( constMap.keySet().size() == 2 );
+    CPPUNIT_ASSERT( !pmap.isDirty() );
+
+    pmap.setInt( "int", 2 );
+    CPPUNIT_ASSERT( pmap.isDirty() );
+    pmap.clearDirty();
+
+    pmap.remove( "int" );
+    CPPUNIT_ASSERT( pmap.isDirty() );
+    pmap.clearDirty();
+
+    pmap.get( "string" ).setString( "world" );
+    CPPUNIT_ASSERT( pmap.isDirty() );
+    pmap.clearDirty();
+
+    pmap.keySet();
+    CPPUNIT_ASSERT( pmap.isDirty() );
+    pmap.clearDirty();
+
+    PrimitiveMap other;
+    other.setBool( "bool", true );
+    pmap.copy( other );
+    CPPUNIT_ASSERT( pmap.isDirty() );
+    pmap.clearDirty();
+
+    pmap.putAll( other );
+    CPPUNIT_ASSERT( pmap.isDirty() );
+    pmap.clearDirty();
+
+    pmap.clear();
+    CPPUNIT_ASSERT( pmap.isDirty() );
+
+    PrimitiveMap copy( pmap );
+    CPPUNIT_ASSERT( copy.isDirty() );
+}
@@ -37,6 +37,7 @@ namespace util{
         CPPUNIT_TEST( testCopy );
         CPPUNIT_TEST( testContains );
         CPPUNIT_TEST( testGetKeys );
+        CPPUNIT_TEST( testDirtyTracking );
         CPPUNIT_TEST_SUITE_END();
         
     public:
@@ -52,6 +53,7 @@ namespace util{
         void testClear();
         void testContains();
         void testGetKeys();
+        void testDirtyTracking();
     };
 
 }}
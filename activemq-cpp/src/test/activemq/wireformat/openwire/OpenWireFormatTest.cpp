@@ -18,8 +18,18 @@
 #include "OpenWireFormatTest.h"
 
 #include <decaf/util/Properties.h>
+#include <decaf/util/UUID.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/File.h>
+#include <decaf/io/FileOutputStream.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
 #include <activemq/wireformat/openwire/OpenWireFormatFactory.h>
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQBytesMessageMarshaller.h>
+#include <activemq/wireformat/openwire/utils/BooleanStream.h>
 
 #include <activemq/core/ActiveMQConnectionMetaData.h>
 
@@ -33,6 +43,42 @@ using namespace decaf::util;
 using namespace activemq::exceptions;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace activemq::wireformat::openwire::marshal::generated;
+using namespace activemq::commands;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    void marshalAndUnmarshal(OpenWireFormat* wireFormat, bool tight,
+                             ActiveMQBytesMessage* message, ActiveMQBytesMessage* received) {
+
+        ActiveMQBytesMessageMarshaller marshaller;
+        ByteArrayOutputStream baos;
+        DataOutputStream dataOut(&baos);
+        BooleanStream bs;
+
+        if (tight) {
+            marshaller.tightMarshal1(wireFormat, message, &bs);
+            bs.marshal(&dataOut);
+            marshaller.tightMarshal2(wireFormat, message, &dataOut, &bs);
+        } else {
+            marshaller.looseMarshal(wireFormat, message, &dataOut);
+        }
+
+        std::pair<unsigned char*, int> array = baos.toByteArray();
+        ByteArrayInputStream bais(array.first, array.second, true);
+        DataInputStream dataIn(&bais);
+
+        if (tight) {
+            BooleanStream inBs;
+            inBs.unmarshal(&dataIn);
+            marshaller.tightUnmarshal(wireFormat, received, &dataIn, &inBs);
+        } else {
+            marshaller.looseUnmarshal(wireFormat, received, &dataIn);
+        }
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormatTest::testProviderInfoInWireFormat() {
@@ -50,3 +96,57 @@ void OpenWireFormatTest::testProviderInfoInWireFormat() {
             myWireFormat->getPreferedWireFormatInfo()->getProperties().getString("ProviderVersion"));
     CPPUNIT_ASSERT(!myWireFormat->getPreferedWireFormatInfo()->getProperties().getString("PlatformDetails").empty());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testMessageContentSpooling() {
+
+    std::string fileName = "OpenWireFormatTest-" + UUID::randomUUID().toString();
+
+    std::vector<unsigned char> data(5000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = (unsigned char)(i % 199);
+    }
+
+    {
+        FileOutputStream out(fileName);
+        out.write(&data[0], (int) data.size(), 0, (int) data.size());
+    }
+
+    Properties properties;
+    properties.setProperty("wireFormat.contentSpoolThreshold", "4096");
+    OpenWireFormat wireFormat(properties);
+    CPPUNIT_ASSERT_EQUAL(4096, wireFormat.getContentSpoolThreshold());
+
+    ActiveMQBytesMessage message;
+    message.setBodyFromFile(fileName, 100, 4500);
+    message.onSend();
+
+    for (int tight = 0; tight < 2; ++tight) {
+
+        ActiveMQBytesMessage received;
+        marshalAndUnmarshal(&wireFormat, tight != 0, &message, &received);
+
+        CPPUNIT_ASSERT_MESSAGE("Body at the threshold should be spooled", received.getMappedContent() != NULL);
+        CPPUNIT_ASSERT(received.getContent().empty());
+        received.setReadOnlyBody(true);
+        CPPUNIT_ASSERT_EQUAL(4500, received.getBodyLength());
+
+        std::vector<unsigned char> body(4500);
+        received.readBytes(&body[0], 4500);
+        CPPUNIT_ASSERT(std::equal(body.begin(), body.end(), data.begin() + 100));
+    }
+
+    wireFormat.setContentSpoolThreshold(0);
+
+    for (int tight = 0; tight < 2; ++tight) {
+
+        ActiveMQBytesMessage received;
+        marshalAndUnmarshal(&wireFormat, tight != 0, &message, &received);
+
+        CPPUNIT_ASSERT_MESSAGE("Spooling is disabled", received.getMappedContent() == NULL);
+        CPPUNIT_ASSERT_EQUAL(4500, (int) received.getContent().size());
+        CPPUNIT_ASSERT(std::equal(received.getContent().begin(), received.getContent().end(), data.begin() + 100));
+    }
+
+    File(fileName).remove();
+}
@@ -29,6 +29,7 @@ namespace openwire {
 
         CPPUNIT_TEST_SUITE( OpenWireFormatTest );
         CPPUNIT_TEST( testProviderInfoInWireFormat );
+        CPPUNIT_TEST( testMessageContentSpooling );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -37,6 +38,7 @@ namespace openwire {
         virtual ~OpenWireFormatTest() {}
 
         virtual void testProviderInfoInWireFormat();
+        virtual void testMessageContentSpooling();
 
     };
 
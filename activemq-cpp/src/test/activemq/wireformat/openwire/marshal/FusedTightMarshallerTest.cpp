@@ -0,0 +1,505 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FusedTightMarshallerTest.h"
+
+#include <activemq/wireformat/openwire/marshal/FusedTightMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQBlobMessageMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQBytesMessageMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQMapMessageMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQMessageMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQObjectMessageMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQStreamMessageMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/ActiveMQTextMessageMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/MessageAckMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/MessageDispatchMarshaller.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/commands/ActiveMQBlobMessage.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQMapMessage.h>
+#include <activemq/commands/ActiveMQMessage.h>
+#include <activemq/commands/ActiveMQObjectMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQStreamMessage.h>
+#include <activemq/commands/ActiveMQTempQueue.h>
+#include <activemq/commands/ActiveMQTempTopic.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ActiveMQTopic.h>
+#include <activemq/commands/BrokerError.h>
+#include <activemq/commands/BrokerId.h>
+#include <activemq/commands/ConnectionId.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/ConsumerInfo.h>
+#include <activemq/commands/LocalTransactionId.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/XATransactionId.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/util/Properties.h>
+
+#include <memory>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace activemq::wireformat::openwire::marshal::generated;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    DataStreamMarshaller* createMarshaller(unsigned char type) {
+
+        if (type == ActiveMQMessage::ID_ACTIVEMQMESSAGE) {
+            return new ActiveMQMessageMarshaller();
+        } else if (type == ActiveMQBytesMessage::ID_ACTIVEMQBYTESMESSAGE) {
+            return new ActiveMQBytesMessageMarshaller();
+        } else if (type == ActiveMQMapMessage::ID_ACTIVEMQMAPMESSAGE) {
+            return new ActiveMQMapMessageMarshaller();
+        } else if (type == ActiveMQObjectMessage::ID_ACTIVEMQOBJECTMESSAGE) {
+            return new ActiveMQObjectMessageMarshaller();
+        } else if (type == ActiveMQStreamMessage::ID_ACTIVEMQSTREAMMESSAGE) {
+            return new ActiveMQStreamMessageMarshaller();
+        } else if (type == ActiveMQTextMessage::ID_ACTIVEMQTEXTMESSAGE) {
+            return new ActiveMQTextMessageMarshaller();
+        } else if (type == ActiveMQBlobMessage::ID_ACTIVEMQBLOBMESSAGE) {
+            return new ActiveMQBlobMessageMarshaller();
+        } else if (type == MessageDispatch::ID_MESSAGEDISPATCH) {
+            return new MessageDispatchMarshaller();
+        } else if (type == MessageAck::ID_MESSAGEACK) {
+            return new MessageAckMarshaller();
+        }
+
+        CPPUNIT_FAIL("No marshaller for the command type");
+        return NULL;
+    }
+
+    std::vector<unsigned char> toVector(ByteArrayOutputStream& bytes) {
+        std::pair<unsigned char*, int> array = bytes.toByteArray();
+        std::vector<unsigned char> result(array.first, array.first + array.second);
+        delete [] array.first;
+        return result;
+    }
+
+    // What OpenWireFormat::marshal writes when it takes the two pass route.
+    std::vector<unsigned char> marshalInTwoPasses(OpenWireFormat* format, DataStructure* command) {
+
+        std::auto_ptr<DataStreamMarshaller> marshaller(createMarshaller(command->getDataStructureType()));
+
+        ByteArrayOutputStream bytes;
+        DataOutputStream dataOut(&bytes);
+
+        BooleanStream bs;
+        int size = 1 + marshaller->tightMarshal1(format, command, &bs);
+        size += bs.marshalledSize();
+
+        if (!format->isSizePrefixDisabled()) {
+            dataOut.writeInt(size);
+        }
+
+        dataOut.writeByte(command->getDataStructureType());
+        bs.marshal(&dataOut);
+        marshaller->tightMarshal2(format, command, &dataOut, &bs);
+
+        return toVector(bytes);
+    }
+
+    std::vector<unsigned char> marshalInOnePass(OpenWireFormat* format, DataStructure* command) {
+
+        ByteArrayOutputStream bytes;
+        DataOutputStream dataOut(&bytes);
+
+        CPPUNIT_ASSERT_MESSAGE("Command should be marshaled in one pass",
+                               FusedTightMarshaller::marshal(format, command, &dataOut));
+
+        return toVector(bytes);
+    }
+
+    void assertSameEncoding(DataStructure* command, bool stackTrace = true, bool sizePrefixDisabled = false) {
+
+        for (int version = 1; version <= OpenWireFormat::MAX_SUPPORTED_VERSION; ++version) {
+
+            Properties properties;
+            OpenWireFormat format(properties);
+            format.setVersion(version);
+            format.setTightEncodingEnabled(true);
+            format.setStackTraceEnabled(stackTrace);
+            format.setSizePrefixDisabled(sizePrefixDisabled);
+
+            std::vector<unsigned char> expected = marshalInTwoPasses(&format, command);
+            std::vector<unsigned char> actual = marshalInOnePass(&format, command);
+
+            CPPUNIT_ASSERT_EQUAL_MESSAGE("Encoded size differs", expected.size(), actual.size());
+            CPPUNIT_ASSERT_MESSAGE("Encoding differs", expected == actual);
+        }
+    }
+
+    Pointer<ConsumerId> createConsumerId() {
+        Pointer<ConsumerId> consumerId(new ConsumerId());
+        consumerId->setConnectionId("ID:fused-host-40123-1389041434210-0:1");
+        consumerId->setSessionId(1);
+        consumerId->setValue(70000);
+        return consumerId;
+    }
+
+    Pointer<MessageId> createMessageId(long long sequence) {
+        Pointer<MessageId> messageId(new MessageId(
+            Pointer<ProducerId>(new ProducerId("ID:fused-host-40123-1389041434210-0:1:1:1")), sequence));
+        messageId->setBrokerSequenceId(5000000000LL);
+        return messageId;
+    }
+
+    Pointer<TransactionId> createLocalTransactionId() {
+        Pointer<LocalTransactionId> id(new LocalTransactionId());
+        id->setValue(42);
+        id->setConnectionId(Pointer<ConnectionId>(new ConnectionId()));
+        id->getConnectionId()->setValue("ID:fused-host-40123-1389041434210-0");
+        return id;
+    }
+
+    Pointer<TransactionId> createXATransactionId() {
+        Pointer<XATransactionId> id(new XATransactionId());
+        id->setFormatId(0x1234);
+        id->setGlobalTransactionId(std::vector<unsigned char>(16, 0xAB));
+        return id;
+    }
+
+    Pointer<BrokerId> createBrokerId(const std::string& value) {
+        Pointer<BrokerId> id(new BrokerId());
+        id->setValue(value);
+        return id;
+    }
+
+    void populate(Message* message) {
+
+        std::vector<unsigned char> payload(300);
+        for (std::size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = (unsigned char) (i * 13 + 5);
+        }
+
+        message->setCommandId(17);
+        message->setResponseRequired(true);
+        message->setMessageId(createMessageId(99));
+        message->getMessageId()->setTextView("ID:fused-host-40123-1389041434210-0:1:1:1:99");
+        message->setProducerId(message->getMessageId()->getProducerId());
+        message->setDestination(Pointer<ActiveMQDestination>(new ActiveMQTopic("fused.prices")));
+        message->setTransactionId(createLocalTransactionId());
+        message->setOriginalDestination(Pointer<ActiveMQDestination>(new ActiveMQTempQueue("ID:fused:1:1")));
+        message->setOriginalTransactionId(createXATransactionId());
+        message->setGroupID("gr\xC3\xBC" "ppe");
+        message->setGroupSequence(3);
+        message->setCorrelationId("corr-1");
+        message->setPersistent(true);
+        message->setExpiration(1389041434210LL + 60000);
+        message->setPriority(7);
+        message->setReplyTo(Pointer<ActiveMQDestination>(new ActiveMQTempTopic("ID:fused:1:2")));
+        message->setTimestamp(1389041434210LL);
+        message->setType("quote");
+        message->setContent(payload);
+        message->setTargetConsumerId(createConsumerId());
+        message->setRedeliveryCounter(2);
+        message->getBrokerPath().push_back(createBrokerId("broker-a"));
+        message->getBrokerPath().push_back(createBrokerId("broker-b"));
+        message->setArrival(1000);
+        message->setUserID("system");
+        message->setDroppable(true);
+        message->getCluster().push_back(createBrokerId("cluster-a"));
+        message->setBrokerInTime(70000);
+        message->setBrokerOutTime(-1);
+        message->setJMSXGroupFirstForConsumer(true);
+    }
+
+    Pointer<Message> createMessage(unsigned char type) {
+
+        Pointer<Message> message;
+
+        if (type == ActiveMQMessage::ID_ACTIVEMQMESSAGE) {
+            message.reset(new ActiveMQMessage());
+        } else if (type == ActiveMQBytesMessage::ID_ACTIVEMQBYTESMESSAGE) {
+            message.reset(new ActiveMQBytesMessage());
+        } else if (type == ActiveMQMapMessage::ID_ACTIVEMQMAPMESSAGE) {
+            message.reset(new ActiveMQMapMessage());
+        } else if (type == ActiveMQObjectMessage::ID_ACTIVEMQOBJECTMESSAGE) {
+            message.reset(new ActiveMQObjectMessage());
+        } else if (type == ActiveMQStreamMessage::ID_ACTIVEMQSTREAMMESSAGE) {
+            message.reset(new ActiveMQStreamMessage());
+        } else if (type == ActiveMQTextMessage::ID_ACTIVEMQTEXTMESSAGE) {
+            message.reset(new ActiveMQTextMessage());
+        } else {
+            Pointer<ActiveMQBlobMessage> blob(new ActiveMQBlobMessage());
+            blob->setRemoteBlobUrl("http://fused.example/blob/1");
+            blob->setMimeType("application/octet-stream");
+            blob->setDeletedByBroker(true);
+            message = blob;
+        }
+
+        populate(message.get());
+
+        if (type == ActiveMQTextMessage::ID_ACTIVEMQTEXTMESSAGE) {
+            message.dynamicCast<ActiveMQTextMessage>()->setText("{\"quote\":\"A-113\",\"bid\":10.25}");
+        } else if (type == ActiveMQMapMessage::ID_ACTIVEMQMAPMESSAGE) {
+            // The map body is read back from the content, which must not be the raw payload.
+            message->setContent(std::vector<unsigned char>());
+            message.dynamicCast<ActiveMQMapMessage>()->setString("symbol", "A-113");
+        }
+
+        message->getMessageProperties().setString("region", "emea");
+        message->getMessageProperties().setInt("attempt", 1);
+
+        return message;
+    }
+
+    // Records every array written to it, to see how a command reached the stream.
+    class RecordingOutputStream : public ByteArrayOutputStream {
+    public:
+
+        std::vector<const unsigned char*> arrays;
+        std::vector<int> lengths;
+
+        RecordingOutputStream() : ByteArrayOutputStream(), arrays(), lengths() {}
+        virtual ~RecordingOutputStream() {}
+
+    protected:
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length) {
+            arrays.push_back(buffer + offset);
+            lengths.push_back(length);
+            ByteArrayOutputStream::doWriteArrayBounded(buffer, size, offset, length);
+        }
+    };
+
+    const unsigned char MESSAGE_TYPES[] = { 23, 24, 25, 26, 27, 28, 29 };
+    const int MESSAGE_TYPE_COUNT = (int) sizeof(MESSAGE_TYPES);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FusedTightMarshallerTest::testMessageFamily() {
+
+    for (int i = 0; i < MESSAGE_TYPE_COUNT; ++i) {
+        Pointer<Message> message = createMessage(MESSAGE_TYPES[i]);
+        CPPUNIT_ASSERT_EQUAL((int) MESSAGE_TYPES[i], (int) message->getDataStructureType());
+        assertSameEncoding(message.get());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FusedTightMarshallerTest::testEmptyCommands() {
+
+    ActiveMQMessage message;
+    assertSameEncoding(&message);
+
+    ActiveMQBlobMessage blob;
+    assertSameEncoding(&blob);
+
+    MessageDispatch dispatch;
+    assertSameEncoding(&dispatch);
+
+    MessageAck ack;
+    assertSameEncoding(&ack);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FusedTightMarshallerTest::testMessageDispatch() {
+
+    for (int i = 0; i < MESSAGE_TYPE_COUNT; ++i) {
+
+        Pointer<Message> message = createMessage(MESSAGE_TYPES[i]);
+
+        MessageDispatch dispatch;
+        dispatch.setCommandId(3);
+        dispatch.setConsumerId(createConsumerId());
+        dispatch.setDestination(message->getDestination());
+        dispatch.setMessage(message);
+        dispatch.setRedeliveryCounter(1);
+
+        assertSameEncoding(&dispatch);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FusedTightMarshallerTest::testMessageAck() {
+
+    Pointer<BrokerError> cause(new BrokerError());
+    cause->setExceptionClass("java.lang.IllegalStateException");
+    cause->setMessage("root cause");
+
+    std::vector< Pointer<BrokerError::StackTraceElement> > stackTrace;
+    Pointer<BrokerError::StackTraceElement> element(new BrokerError::StackTraceElement());
+    element->ClassName = "org.example.Listener";
+    element->MethodName = "onMessage";
+    element->FileName = "Listener.java";
+    element->LineNumber = 42;
+    stackTrace.push_back(element);
+
+    Pointer<BrokerError> poison(new BrokerError());
+    poison->setExceptionClass("javax.jms.JMSException");
+    poison->setMessage("redelivery limit exceeded");
+    poison->setStackTraceElements(stackTrace);
+    poison->setCause(cause);
+
+    MessageAck ack;
+    ack.setCommandId(9);
+    ack.setResponseRequired(true);
+    ack.setAckType(2);
+    ack.setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue("fused.orders")));
+    ack.setTransactionId(createXATransactionId());
+    ack.setConsumerId(createConsumerId());
+    ack.setFirstMessageId(createMessageId(1));
+    ack.setLastMessageId(createMessageId(100));
+    ack.setMessageCount(100);
+    ack.setPoisonCause(poison);
+
+    assertSameEncoding(&ack, true);
+    assertSameEncoding(&ack, false);
+
+    ack.setTransactionId(createLocalTransactionId());
+    ack.setPoisonCause(Pointer<BrokerError>());
+    assertSameEncoding(&ack);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FusedTightMarshallerTest::testSizePrefixDisabled() {
+
+    Pointer<Message> message = createMessage(ActiveMQTextMessage::ID_ACTIVEMQTEXTMESSAGE);
+    assertSameEncoding(message.get(), true, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FusedTightMarshallerTest::testBodyWrittenInPlace() {
+
+    Properties properties;
+    OpenWireFormat format(properties);
+    format.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+    format.setTightEncodingEnabled(true);
+
+    Pointer<Message> message = createMessage(ActiveMQBytesMessage::ID_ACTIVEMQBYTESMESSAGE);
+    message->setContent(std::vector<unsigned char>(64 * 1024, 0x5A));
+
+    MessageDispatch dispatch;
+    dispatch.setConsumerId(createConsumerId());
+    dispatch.setDestination(message->getDestination());
+    dispatch.setMessage(message);
+
+    DataStructure* commands[] = { message.get(), &dispatch };
+
+    for (int i = 0; i < 2; ++i) {
+
+        RecordingOutputStream recorder;
+        DataOutputStream dataOut(&recorder);
+        CPPUNIT_ASSERT(FusedTightMarshaller::marshal(&format, commands[i], &dataOut));
+
+        // The body goes to the stream in a single write straight from the message.
+        int bodyWrites = 0;
+        for (std::size_t j = 0; j < recorder.arrays.size(); ++j) {
+            if (recorder.arrays[j] == message->getContentData()) {
+                CPPUNIT_ASSERT_EQUAL(message->getContentSize(), recorder.lengths[j]);
+                bodyWrites++;
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL(1, bodyWrites);
+
+        CPPUNIT_ASSERT_MESSAGE("Encoding differs", marshalInTwoPasses(&format, commands[i]) == toVector(recorder));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FusedTightMarshallerTest::testUnsupportedCommands() {
+
+    Properties properties;
+    OpenWireFormat format(properties);
+    format.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+    format.setTightEncodingEnabled(true);
+
+    ByteArrayOutputStream bytes;
+    DataOutputStream dataOut(&bytes);
+
+    ConsumerInfo info;
+    CPPUNIT_ASSERT(!FusedTightMarshaller::marshal(&format, &info, &dataOut));
+
+    // A message that carries an arbitrary command, as advisories do.
+    Pointer<Message> advisory = createMessage(ActiveMQMessage::ID_ACTIVEMQMESSAGE);
+    advisory->setDataStructure(Pointer<DataStructure>(new ConsumerInfo()));
+    CPPUNIT_ASSERT(!FusedTightMarshaller::marshal(&format, advisory.get(), &dataOut));
+
+    MessageDispatch dispatch;
+    dispatch.setMessage(advisory);
+    CPPUNIT_ASSERT(!FusedTightMarshaller::marshal(&format, &dispatch, &dataOut));
+
+    CPPUNIT_ASSERT_EQUAL(0, (int) bytes.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FusedTightMarshallerTest::testRoundTrip() {
+
+    MockTransport transport((Pointer<WireFormat>()), (Pointer<ResponseBuilder>()));
+
+    Properties properties;
+    OpenWireFormat format(properties);
+    format.setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+    format.setTightEncodingEnabled(true);
+
+    Pointer<Message> message = createMessage(ActiveMQTextMessage::ID_ACTIVEMQTEXTMESSAGE);
+
+    Pointer<MessageDispatch> dispatch(new MessageDispatch());
+    dispatch->setConsumerId(createConsumerId());
+    dispatch->setDestination(message->getDestination());
+    dispatch->setMessage(message);
+    dispatch->setRedeliveryCounter(4);
+
+    // The advisory is left to the generated marshallers, both must decode.
+    Pointer<Message> advisory = createMessage(ActiveMQMessage::ID_ACTIVEMQMESSAGE);
+    advisory->setDataStructure(Pointer<DataStructure>(new ConsumerInfo()));
+
+    ByteArrayOutputStream bytes;
+    DataOutputStream dataOut(&bytes);
+    format.marshal(dispatch, &transport, &dataOut);
+    format.marshal(advisory, &transport, &dataOut);
+
+    std::vector<unsigned char> encoded = toVector(bytes);
+    ByteArrayInputStream source(encoded);
+    DataInputStream dataIn(&source);
+
+    Pointer<MessageDispatch> received = format.unmarshal(&transport, &dataIn).dynamicCast<MessageDispatch>();
+    CPPUNIT_ASSERT(received->getConsumerId()->equals(dispatch->getConsumerId().get()));
+    CPPUNIT_ASSERT_EQUAL(4, received->getRedeliveryCounter());
+
+    Pointer<ActiveMQTextMessage> text = received->getMessage().dynamicCast<ActiveMQTextMessage>();
+    CPPUNIT_ASSERT_EQUAL(std::string("{\"quote\":\"A-113\",\"bid\":10.25}"), text->getText());
+    CPPUNIT_ASSERT_EQUAL(message->getGroupID(), text->getGroupID());
+    CPPUNIT_ASSERT_EQUAL(std::string("emea"), text->getStringProperty("region"));
+    CPPUNIT_ASSERT_EQUAL(-1LL, text->getBrokerOutTime());
+    CPPUNIT_ASSERT_EQUAL(2, (int) text->getBrokerPath().size());
+
+    Pointer<Message> decoded = format.unmarshal(&transport, &dataIn).dynamicCast<Message>();
+    CPPUNIT_ASSERT(decoded->getDataStructure() != NULL);
+    CPPUNIT_ASSERT_EQUAL(0, source.available());
+}
@@ -20,6 +20,8 @@
 #include <activemq/util/PrimitiveMap.h>
 #include <activemq/util/PrimitiveList.h>
 #include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
 
 using namespace std;
 using namespace activemq;
@@ -158,3 +160,60 @@ void PrimitiveTypesMarshallerTest::testMaps() {
     CPPUNIT_ASSERT( newMap.get() != NULL );
     CPPUNIT_ASSERT( newMap->size() == 3 );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveTypesMarshallerTest::testMatchesStreamEncoding() {
+
+    PrimitiveMap myMap;
+
+    myMap.setBool( "boolKey", true );
+    myMap.setByte( "byteKey", 'A' );
+    myMap.setChar( "charKey", 'B' );
+    myMap.setShort( "shortKey", -2048 );
+    myMap.setInt( "intKey", -655369 );
+    myMap.setLong( "longKey", 0xFFFFFFFF00000001ULL );
+    myMap.setFloat( "floatKey", 45.6545f );
+    myMap.setDouble( "doubleKey", -654564.654654 );
+    myMap.setString( "emptyKey", "" );
+    myMap.setString( "stringKey", "The test string" );
+    myMap.setString( "bigStringKey", std::string( 10000, 'x' ) );
+    myMap.setByteArray( "emptyBytesKey", std::vector<unsigned char>() );
+    myMap.setByteArray( "bytesKey", std::vector<unsigned char>( 5, 0xF0 ) );
+    myMap.setInt( std::string( "caf\xC3\xA9\0key", 9 ), 7 );
+
+    PrimitiveList list;
+    list.add( 1 );
+    list.add( std::string( "two" ) );
+    PrimitiveMap nested;
+    nested.setLong( "three", 3 );
+    list.add( nested );
+    myMap.put( "listKey", list );
+    myMap.put( "mapKey", nested );
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut( &bytesOut );
+    PrimitiveTypesMarshaller::marshalMap( &myMap, dataOut );
+    std::pair<unsigned char*, int> streamed = bytesOut.toByteArray();
+    std::vector<unsigned char> expected( streamed.first, streamed.first + streamed.second );
+    delete [] streamed.first;
+
+    std::vector<unsigned char> marshaled;
+    PrimitiveTypesMarshaller::marshal( &myMap, marshaled );
+    CPPUNIT_ASSERT( marshaled == expected );
+
+    bytesOut.reset();
+    PrimitiveTypesMarshaller::marshalList( &list, dataOut );
+    streamed = bytesOut.toByteArray();
+    expected.assign( streamed.first, streamed.first + streamed.second );
+    delete [] streamed.first;
+
+    marshaled.clear();
+    PrimitiveTypesMarshaller::marshal( &list, marshaled );
+    CPPUNIT_ASSERT( marshaled == expected );
+
+    // A NULL map is written as a -1 count.
+    marshaled.clear();
+    PrimitiveTypesMarshaller::marshal( (PrimitiveMap*) NULL, marshaled );
+    CPPUNIT_ASSERT( marshaled == std::vector<unsigned char>( 4, 0xFF ) );
+}
+
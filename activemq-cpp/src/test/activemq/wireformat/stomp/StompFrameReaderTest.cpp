@@ -0,0 +1,293 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StompFrameReaderTest.h"
+
+#include <activemq/wireformat/stomp/StompFrame.h>
+#include <activemq/wireformat/stomp/StompFrameReader.h>
+
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/EOFException.h>
+#include <decaf/io/IOException.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::stomp;
+using namespace decaf::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::string bodyAsString(const StompFrame& frame) {
+        const std::vector<unsigned char>& body = frame.getBody();
+        return std::string(body.begin(), body.end());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameReaderTest::StompFrameReaderTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameReaderTest::~StompFrameReaderTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testReadFrame() {
+
+    std::string data("MESSAGE\ndestination:/queue/test\nmessage-id:ID:1\n\nhello\0\n", 56);
+    ByteArrayInputStream input((const unsigned char*) data.c_str(), (int) data.length());
+
+    StompFrameReader reader;
+    StompFrame frame;
+    reader.readFrame(frame, &input);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("MESSAGE"), frame.getCommand());
+    CPPUNIT_ASSERT(frame.hasProperty("destination"));
+    CPPUNIT_ASSERT(frame.hasProperty("message-id"));
+    CPPUNIT_ASSERT(!frame.hasProperty("content-length"));
+    CPPUNIT_ASSERT_EQUAL(std::string("/queue/test"), frame.getProperty("destination"));
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:1"), frame.getProperty("message-id"));
+    CPPUNIT_ASSERT_EQUAL(std::string("none"), frame.getProperty("missing", "none"));
+    CPPUNIT_ASSERT_EQUAL(std::string("hello", 6), bodyAsString(frame));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testReadConsecutiveFrames() {
+
+    std::string data;
+    data.append("RECEIPT\nreceipt-id:1\n\n", 22);
+    data.push_back('\0');
+    data.append("\n\nMESSAGE\ncontent-length:3\n\nabc", 31);
+    data.push_back('\0');
+    data.append("\nERROR\nmessage:failed\n\n", 23);
+    data.push_back('\0');
+    data.push_back('\n');
+
+    ByteArrayInputStream input((const unsigned char*) data.c_str(), (int) data.length());
+
+    StompFrameReader reader(true, 7);
+    StompFrame frame;
+
+    reader.readFrame(frame, &input);
+    CPPUNIT_ASSERT_EQUAL(std::string("RECEIPT"), frame.getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("1"), frame.getProperty("receipt-id"));
+
+    reader.readFrame(frame, &input);
+    CPPUNIT_ASSERT_EQUAL(std::string("MESSAGE"), frame.getCommand());
+    CPPUNIT_ASSERT(!frame.hasProperty("receipt-id"));
+    CPPUNIT_ASSERT_EQUAL(std::string("abc"), bodyAsString(frame));
+
+    reader.readFrame(frame, &input);
+    CPPUNIT_ASSERT_EQUAL(std::string("ERROR"), frame.getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("failed"), frame.getProperty("message"));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, frame.getBodyLength());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testReadContentLengthBody() {
+
+    std::string payload;
+    for (int i = 0; i < 20000; ++i) {
+        payload.push_back((char) (i % 251));
+    }
+
+    std::string data("MESSAGE\ncontent-length:20000\n\n");
+    data.append(payload);
+    data.push_back('\0');
+    data.push_back('\n');
+
+    ByteArrayInputStream input((const unsigned char*) data.c_str(), (int) data.length());
+
+    StompFrameReader reader(true, 64);
+    StompFrame frame;
+    reader.readFrame(frame, &input);
+
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 20000, frame.getBodyLength());
+    CPPUNIT_ASSERT(payload == bodyAsString(frame));
+
+    std::string bad("MESSAGE\ncontent-length:2\n\nabc");
+    ByteArrayInputStream badInput((const unsigned char*) bad.c_str(), (int) bad.length());
+
+    StompFrameReader badReader;
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException when the trailing null is missing",
+        badReader.readFrame(frame, &badInput),
+        decaf::io::IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testReadNullTerminatedBody() {
+
+    std::string payload(10000, 'x');
+
+    std::string data("MESSAGE\ndestination:/topic/a\n\n");
+    data.append(payload);
+    data.push_back('\0');
+    data.push_back('\n');
+
+    ByteArrayInputStream input((const unsigned char*) data.c_str(), (int) data.length());
+
+    StompFrameReader reader(true, 100);
+    StompFrame frame;
+    reader.readFrame(frame, &input);
+
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 10001, frame.getBodyLength());
+    CPPUNIT_ASSERT_EQUAL('\0', (char) frame.getBody().back());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testFirstHeaderWins() {
+
+    std::string data("MESSAGE\nfoo:first\nbar:a:b:c\nfoo:second\nnovalue\n\n", 48);
+    data.push_back('\0');
+
+    ByteArrayInputStream input((const unsigned char*) data.c_str(), (int) data.length());
+
+    StompFrameReader reader;
+    StompFrame frame;
+    reader.readFrame(frame, &input);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("first"), frame.getProperty("foo"));
+    CPPUNIT_ASSERT_EQUAL(std::string("a:b:c"), frame.getProperty("bar"));
+    CPPUNIT_ASSERT(!frame.hasProperty("novalue"));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 2, frame.propertiesToArray().size());
+    CPPUNIT_ASSERT_EQUAL(std::string("first"), frame.getProperties().getProperty("foo"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testHeadersSpanBuffer() {
+
+    std::string longValue(5000, 'v');
+
+    std::string data("  \r\nSEND\nlong:");
+    data.append(longValue);
+    data.append("\nshort:s\n\n");
+    data.push_back('\0');
+
+    ByteArrayInputStream input((const unsigned char*) data.c_str(), (int) data.length());
+
+    StompFrameReader reader(true, 16);
+    StompFrame frame;
+    reader.readFrame(frame, &input);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("SEND"), frame.getCommand());
+    CPPUNIT_ASSERT_EQUAL(longValue, frame.getProperty("long"));
+    CPPUNIT_ASSERT_EQUAL(std::string("s"), frame.getProperty("short"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testMaterializeHeaders() {
+
+    std::string data("MESSAGE\nfoo:1\nbar:2\n\n", 21);
+    data.push_back('\0');
+
+    ByteArrayInputStream input((const unsigned char*) data.c_str(), (int) data.length());
+
+    StompFrameReader reader;
+    StompFrame frame;
+    reader.readFrame(frame, &input);
+
+    frame.setProperty("baz", "3");
+
+    CPPUNIT_ASSERT_EQUAL(std::string("1"), frame.getProperty("foo"));
+    CPPUNIT_ASSERT_EQUAL(std::string("2"), frame.getProperty("bar"));
+    CPPUNIT_ASSERT_EQUAL(std::string("3"), frame.getProperty("baz"));
+    CPPUNIT_ASSERT_EQUAL(3, frame.getProperties().size());
+
+    std::auto_ptr<StompFrame> copy(frame.clone());
+    CPPUNIT_ASSERT_EQUAL(std::string("3"), copy->getProperty("baz"));
+
+    StompFrame viewCopy;
+    ByteArrayInputStream input2((const unsigned char*) data.c_str(), (int) data.length());
+    reader.readFrame(viewCopy, &input2);
+    frame.copy(&viewCopy);
+    CPPUNIT_ASSERT(!frame.hasProperty("baz"));
+    CPPUNIT_ASSERT_EQUAL(std::string("2"), frame.getProperty("bar"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testFromStreamDoesNotReadAhead() {
+
+    std::string data("RECEIPT\nreceipt-id:1\n\n", 22);
+    data.push_back('\0');
+    data.append("\nRECEIPT\nreceipt-id:2\n\n", 23);
+    data.push_back('\0');
+
+    ByteArrayInputStream bytes((const unsigned char*) data.c_str(), (int) data.length());
+    DataInputStream input(&bytes);
+
+    StompFrame frame1;
+    frame1.fromStream(&input);
+    StompFrame frame2;
+    frame2.fromStream(&input);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("1"), frame1.getProperty("receipt-id"));
+    CPPUNIT_ASSERT_EQUAL(std::string("2"), frame2.getProperty("receipt-id"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testReadEOF() {
+
+    std::string data("MESSAGE\nfoo:1\n");
+    ByteArrayInputStream input((const unsigned char*) data.c_str(), (int) data.length());
+
+    StompFrameReader reader;
+    StompFrame frame;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an EOFException",
+        reader.readFrame(frame, &input),
+        decaf::io::EOFException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameReaderTest::testRoundTrip() {
+
+    StompFrame frame;
+    frame.setCommand("MESSAGE");
+    frame.setProperty("destination", "/queue/test");
+    frame.setProperty("content-length", "4");
+    unsigned char body[] = { 'a', '\0', 'b', 'c' };
+    frame.setBody(body, 4);
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream output(&bytesOut);
+    frame.toStream(&output);
+    frame.toStream(&output);
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    ByteArrayInputStream input(array.first, array.second, true);
+
+    StompFrameReader reader;
+
+    for (int i = 0; i < 2; ++i) {
+        StompFrame result;
+        reader.readFrame(result, &input);
+
+        CPPUNIT_ASSERT_EQUAL(std::string("MESSAGE"), result.getCommand());
+        CPPUNIT_ASSERT_EQUAL(std::string("/queue/test"), result.getProperty("destination"));
+        CPPUNIT_ASSERT(frame.getBody() == result.getBody());
+    }
+}
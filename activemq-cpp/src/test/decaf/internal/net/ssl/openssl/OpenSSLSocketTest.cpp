@@ -0,0 +1,278 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OpenSSLSocketTest.h"
+
+#include <decaf/internal/net/ssl/openssl/OpenSSLSocket.h>
+#include <decaf/internal/net/tcp/TcpSocket.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/net/Socket.h>
+#include <decaf/net/ssl/SSLSocketFactory.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+
+#ifdef HAVE_OPENSSL
+#include <openssl/ssl.h>
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+#endif
+
+#include <memory>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::net;
+using namespace decaf::net::ssl;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::internal;
+using namespace decaf::internal::net;
+using namespace decaf::internal::net::tcp;
+using namespace decaf::internal::net::ssl;
+using namespace decaf::internal::net::ssl::openssl;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+#ifdef HAVE_OPENSSL
+
+    /**
+     * TLS server built directly on OpenSSL with a self signed certificate.  Each
+     * connection gets a single byte once the handshake completes so the client has
+     * read any session tickets before it disconnects.
+     */
+    class TestServer : public Runnable {
+    private:
+
+        AtomicBoolean running;
+        int port;
+        Thread* thread;
+        SSL_CTX* context;
+        BIO* acceptor;
+
+    private:
+
+        TestServer(const TestServer&);
+        TestServer& operator=(const TestServer&);
+
+    public:
+
+        TestServer() : Runnable(), running(false), port(0), thread(NULL), context(NULL), acceptor(NULL) {
+        }
+
+        virtual ~TestServer() {
+            try {
+                stop();
+            } catch (...) {
+            }
+        }
+
+        int getPort() const {
+            return this->port;
+        }
+
+        void start() {
+
+            this->context = SSL_CTX_new(SSLv23_server_method());
+            createCertificate(this->context);
+            SSL_CTX_set_session_cache_mode(this->context, SSL_SESS_CACHE_SERVER);
+            SSL_CTX_set_session_id_context(this->context, (const unsigned char*) "test", 4);
+
+            this->acceptor = BIO_new_accept((char*) "127.0.0.1:0");
+            if (this->acceptor == NULL || BIO_do_accept(this->acceptor) <= 0) {
+                throw IllegalStateException(__FILE__, __LINE__, "Failed to bind the test server.");
+            }
+
+            this->port = Integer::parseInt(BIO_get_accept_port(this->acceptor));
+
+            this->running.set(true);
+            this->thread = new Thread(this, "OpenSSL Test Server");
+            this->thread->start();
+        }
+
+        void stop() {
+
+            if (this->thread == NULL) {
+                return;
+            }
+
+            this->running.set(false);
+
+            // Wake up the accept call with a plain connection.
+            try {
+                TcpSocket waker;
+                waker.create();
+                waker.connect("127.0.0.1", this->port, 1000);
+                waker.close();
+            } catch (...) {
+            }
+
+            this->thread->join();
+            delete this->thread;
+            this->thread = NULL;
+
+            BIO_free_all(this->acceptor);
+            SSL_CTX_free(this->context);
+            this->acceptor = NULL;
+            this->context = NULL;
+        }
+
+        virtual void run() {
+
+            while (this->running.get()) {
+
+                if (BIO_do_accept(this->acceptor) <= 0) {
+                    break;
+                }
+
+                BIO* client = BIO_pop(this->acceptor);
+                if (!this->running.get()) {
+                    BIO_free_all(client);
+                    break;
+                }
+
+                SSL* ssl = SSL_new(this->context);
+                SSL_set_bio(ssl, client, client);
+
+                if (SSL_accept(ssl) == 1) {
+                    unsigned char byte = 1;
+                    SSL_write(ssl, &byte, 1);
+
+                    unsigned char buffer[64];
+                    while (SSL_read(ssl, buffer, (int) sizeof(buffer)) > 0) {
+                    }
+                }
+
+                SSL_free(ssl);
+            }
+        }
+
+    private:
+
+        static void createCertificate(SSL_CTX* context) {
+
+            EVP_PKEY* key = NULL;
+            EVP_PKEY_CTX* keyContext = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, NULL);
+            EVP_PKEY_keygen_init(keyContext);
+            EVP_PKEY_CTX_set_rsa_keygen_bits(keyContext, 2048);
+            EVP_PKEY_keygen(keyContext, &key);
+            EVP_PKEY_CTX_free(keyContext);
+
+            X509* certificate = X509_new();
+            X509_set_version(certificate, 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+            X509_gmtime_adj(X509_get_notBefore(certificate), 0);
+            X509_gmtime_adj(X509_get_notAfter(certificate), 3600);
+            X509_set_pubkey(certificate, key);
+
+            X509_NAME* name = X509_get_subject_name(certificate);
+            X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char*) "localhost", -1, -1, 0);
+            X509_set_issuer_name(certificate, name);
+            X509_sign(certificate, key, EVP_sha256());
+
+            SSL_CTX_use_certificate(context, certificate);
+            SSL_CTX_use_PrivateKey(context, key);
+
+            X509_free(certificate);
+            EVP_PKEY_free(key);
+        }
+    };
+
+    // Connects to the server, completes the handshake and reads the server's byte,
+    // returns whether the handshake resumed a cached session.
+    bool connect(int port) {
+
+        std::auto_ptr<Socket> socket(SSLSocketFactory::getDefault()->createSocket());
+        socket->connect("127.0.0.1", port, 5000);
+
+        OpenSSLSocket* sslSocket = dynamic_cast<OpenSSLSocket*>(socket.get());
+        CPPUNIT_ASSERT(sslSocket != NULL);
+        sslSocket->startHandshake();
+
+        CPPUNIT_ASSERT_EQUAL(1, socket->getInputStream()->read());
+
+        bool reused = sslSocket->isSessionReused();
+        socket->close();
+        return reused;
+    }
+
+#endif
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLSocketTest::OpenSSLSocketTest() : disableResumption(), disablePeerVerification() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OpenSSLSocketTest::~OpenSSLSocketTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSocketTest::setUp() {
+
+    this->disableResumption = System::getProperty("decaf.net.ssl.disableSessionResumption", "false");
+    this->disablePeerVerification = System::getProperty("decaf.net.ssl.disablePeerVerification", "false");
+
+    // The server's certificate is self signed.
+    System::setProperty("decaf.net.ssl.disablePeerVerification", "true");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSocketTest::tearDown() {
+    System::setProperty("decaf.net.ssl.disableSessionResumption", this->disableResumption);
+    System::setProperty("decaf.net.ssl.disablePeerVerification", this->disablePeerVerification);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSocketTest::testSessionReusedOnReconnect() {
+
+#ifdef HAVE_OPENSSL
+    System::setProperty("decaf.net.ssl.disableSessionResumption", "false");
+
+    TestServer server;
+    server.start();
+
+    CPPUNIT_ASSERT_MESSAGE("First connect should perform a full handshake", !connect(server.getPort()));
+    CPPUNIT_ASSERT_MESSAGE("Second connect should resume the session", connect(server.getPort()));
+    CPPUNIT_ASSERT_MESSAGE("Third connect should resume the session", connect(server.getPort()));
+
+    server.stop();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenSSLSocketTest::testSessionNotReusedWhenDisabled() {
+
+#ifdef HAVE_OPENSSL
+    System::setProperty("decaf.net.ssl.disableSessionResumption", "true");
+
+    TestServer server;
+    server.start();
+
+    CPPUNIT_ASSERT(!connect(server.getPort()));
+    CPPUNIT_ASSERT(!connect(server.getPort()));
+
+    server.stop();
+#endif
+}
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSOCKETTEST_H_
+#define _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSOCKETTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace decaf {
+namespace internal {
+namespace net {
+namespace ssl {
+namespace openssl {
+
+    class OpenSSLSocketTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( OpenSSLSocketTest );
+        CPPUNIT_TEST( testSessionReusedOnReconnect );
+        CPPUNIT_TEST( testSessionNotReusedWhenDisabled );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        std::string disableResumption;
+        std::string disablePeerVerification;
+
+    public:
+
+        OpenSSLSocketTest();
+        virtual ~OpenSSLSocketTest();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testSessionReusedOnReconnect();
+        void testSessionNotReusedWhenDisabled();
+
+    };
+
+}}}}}
+
+#endif /* _DECAF_INTERNAL_NET_SSL_OPENSSL_OPENSSLSOCKETTEST_H_ */
@@ -0,0 +1,244 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ModifiedUTF8Test.h"
+
+#include <decaf/internal/util/ModifiedUTF8.h>
+#include <decaf/io/UTFDataFormatException.h>
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::vector<unsigned char> referenceEncode(const std::vector<unsigned char>& value) {
+        std::vector<unsigned char> result;
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            unsigned int charValue = value[i];
+            if (charValue > 0 && charValue <= 127) {
+                result.push_back((unsigned char) charValue);
+            } else {
+                result.push_back((unsigned char) (0xc0 | (0x1f & (charValue >> 6))));
+                result.push_back((unsigned char) (0x80 | (0x3f & charValue)));
+            }
+        }
+        return result;
+    }
+
+    // Random chars where roughly one in 'ratio' needs the two byte form.
+    std::vector<unsigned char> randomChars(std::size_t length, int ratio) {
+        std::vector<unsigned char> result(length);
+        for (std::size_t i = 0; i < length; ++i) {
+            if (ratio > 0 && rand() % ratio == 0) {
+                result[i] = (rand() % 4 == 0) ? 0 : (unsigned char) (0x80 + rand() % 128);
+            } else {
+                result[i] = (unsigned char) (1 + rand() % 127);
+            }
+        }
+        return result;
+    }
+
+    const unsigned char* data(const std::vector<unsigned char>& value) {
+        static const unsigned char EMPTY = 0;
+        return value.empty() ? &EMPTY : &value[0];
+    }
+
+    void checkRoundTrip(const std::vector<unsigned char>& value) {
+
+        std::vector<unsigned char> expected = referenceEncode(value);
+
+        CPPUNIT_ASSERT_EQUAL(expected.size(), ModifiedUTF8::encodedLength(data(value), value.size()));
+
+        std::vector<unsigned char> encoded(expected.size() + 1);
+        std::size_t written = ModifiedUTF8::encode(data(value), value.size(), &encoded[0]);
+        CPPUNIT_ASSERT_EQUAL(expected.size(), written);
+        encoded.resize(written);
+        CPPUNIT_ASSERT(expected == encoded);
+
+        std::vector<unsigned char> decoded(encoded.size() + 1);
+        std::size_t read = ModifiedUTF8::decode(data(encoded), encoded.size(), &decoded[0]);
+        CPPUNIT_ASSERT_EQUAL(value.size(), read);
+        decoded.resize(read);
+        CPPUNIT_ASSERT(value == decoded);
+    }
+
+    void checkDecodeFails(const unsigned char* encoded, std::size_t length) {
+        std::vector<unsigned char> buffer(length);
+        CPPUNIT_ASSERT_THROW_MESSAGE(
+            "Should have thrown a UTFDataFormatException",
+            ModifiedUTF8::decode(encoded, length, &buffer[0]),
+            UTFDataFormatException);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Test::tearDown() {
+    ModifiedUTF8::setAccelerationEnabled(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Test::testAsciiLength() {
+
+    std::vector<unsigned char> value(200, 'a');
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 200, ModifiedUTF8::asciiLength(&value[0], value.size()));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 0, ModifiedUTF8::asciiLength(&value[0], 0));
+
+    // Walk the stopping byte across every position so each block width and
+    // the scalar tail all see it.
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        value[i] = 0;
+        CPPUNIT_ASSERT_EQUAL(i, ModifiedUTF8::asciiLength(&value[0], value.size()));
+        value[i] = 0xE9;
+        CPPUNIT_ASSERT_EQUAL(i, ModifiedUTF8::asciiLength(&value[0], value.size()));
+        value[i] = 0x7F;
+        CPPUNIT_ASSERT_EQUAL(value.size(), ModifiedUTF8::asciiLength(&value[0], value.size()));
+        value[i] = 'a';
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Test::testEncodedLength() {
+
+    for (std::size_t length = 0; length < 100; ++length) {
+        std::vector<unsigned char> value(length, 'z');
+        CPPUNIT_ASSERT_EQUAL(length, ModifiedUTF8::encodedLength(data(value), length));
+
+        for (std::size_t i = 0; i < length; i += 3) {
+            value[i] = (unsigned char) (i % 2 == 0 ? 0xFF : 0x00);
+        }
+        CPPUNIT_ASSERT_EQUAL(referenceEncode(value).size(), ModifiedUTF8::encodedLength(data(value), length));
+    }
+
+    // Large enough that the vector byte counters have to be folded more than once.
+    std::vector<unsigned char> large(20000, 0xC4);
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 40000, ModifiedUTF8::encodedLength(&large[0], large.size()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Test::testEncode() {
+
+    std::vector<unsigned char> all;
+    for (int i = 0; i < 256; ++i) {
+        all.push_back((unsigned char) i);
+    }
+    checkRoundTrip(all);
+
+    std::vector<unsigned char> empty;
+    checkRoundTrip(empty);
+
+    unsigned char zero = 0;
+    unsigned char encoded[2];
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 2, ModifiedUTF8::encode(&zero, 1, encoded));
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 0xC0, encoded[0]);
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 0x80, encoded[1]);
+
+    unsigned char high = 0xFF;
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 2, ModifiedUTF8::encode(&high, 1, encoded));
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 0xC3, encoded[0]);
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 0xBF, encoded[1]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Test::testDecode() {
+
+    srand(42);
+
+    for (std::size_t length = 0; length < 300; length += 7) {
+        checkRoundTrip(randomChars(length, 0));
+        checkRoundTrip(randomChars(length, 2));
+        checkRoundTrip(randomChars(length, 40));
+    }
+
+    // A raw zero byte is accepted on decode even though encode never writes one.
+    unsigned char encoded[] = { 'a', 0x00, 'b' };
+    unsigned char decoded[3];
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 3, ModifiedUTF8::decode(encoded, 3, decoded));
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 0x00, decoded[1]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Test::testDecodeInPlace() {
+
+    srand(7);
+
+    std::vector<unsigned char> value = randomChars(1000, 5);
+    std::vector<unsigned char> buffer = referenceEncode(value);
+
+    std::size_t length = ModifiedUTF8::decode(&buffer[0], buffer.size(), &buffer[0]);
+    CPPUNIT_ASSERT_EQUAL(value.size(), length);
+    buffer.resize(length);
+    CPPUNIT_ASSERT(value == buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Test::testDecodeInvalid() {
+
+    // Two byte start at the end.
+    unsigned char truncated[] = { 'a', 'b', 0xC3 };
+    checkDecodeFails(truncated, 3);
+
+    // Second byte not a continuation.
+    unsigned char badContinuation[] = { 0xC3, 'a' };
+    checkDecodeFails(badContinuation, 2);
+
+    // Two byte value greater than 255.
+    unsigned char tooLarge[] = { 0xC4, 0x80 };
+    checkDecodeFails(tooLarge, 2);
+
+    // Three byte sequences are not supported.
+    unsigned char threeByte[] = { 0xE2, 0x82, 0xAC };
+    checkDecodeFails(threeByte, 3);
+    checkDecodeFails(threeByte, 2);
+
+    // Stray continuation byte.
+    unsigned char stray[] = { 'a', 0x80, 'b' };
+    checkDecodeFails(stray, 3);
+
+    // Errors found after a long ASCII run are still detected.
+    std::vector<unsigned char> longRun(100, 'x');
+    longRun.push_back(0xF0);
+    checkDecodeFails(&longRun[0], longRun.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ModifiedUTF8Test::testScalarMatchesAccelerated() {
+
+    srand(1234);
+
+    for (int round = 0; round < 50; ++round) {
+
+        std::vector<unsigned char> value = randomChars((std::size_t) (rand() % 2000), 1 + rand() % 64);
+
+        ModifiedUTF8::setAccelerationEnabled(true);
+        std::size_t acceleratedAscii = ModifiedUTF8::asciiLength(data(value), value.size());
+        std::size_t acceleratedLength = ModifiedUTF8::encodedLength(data(value), value.size());
+
+        ModifiedUTF8::setAccelerationEnabled(false);
+        CPPUNIT_ASSERT_EQUAL(std::string("scalar"), ModifiedUTF8::getImplementationName());
+        CPPUNIT_ASSERT_EQUAL(acceleratedAscii, ModifiedUTF8::asciiLength(data(value), value.size()));
+        CPPUNIT_ASSERT_EQUAL(acceleratedLength, ModifiedUTF8::encodedLength(data(value), value.size()));
+        checkRoundTrip(value);
+    }
+}
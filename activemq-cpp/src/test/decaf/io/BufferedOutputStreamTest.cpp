@@ -65,6 +65,22 @@ namespace {
 
     };
 
+    class GatheringOutputStream : public ByteArrayOutputStream {
+    public:
+
+        int gatheredWrites;
+
+        GatheringOutputStream() : ByteArrayOutputStream(), gatheredWrites(0) {}
+        virtual ~GatheringOutputStream() {}
+
+    protected:
+
+        virtual void doWriteGathered(const unsigned char* const* buffers, const int* lengths, int count) {
+            gatheredWrites++;
+            ByteArrayOutputStream::doWriteGathered(buffers, lengths, count);
+        }
+    };
+
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -311,3 +327,56 @@ void BufferedOutputStreamTest::testBiggerBuffer(){
     bufStream.flush();
     CPPUNIT_ASSERT( strcmp( buffer, "TESTTEST12345678910" ) == 0 );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void BufferedOutputStreamTest::testDirectWrite() {
+
+    GatheringOutputStream target;
+    BufferedOutputStream bufStream( &target, 16 );
+    bufStream.setDirectWriteThreshold( 16 );
+
+    bufStream.write( (unsigned char*)"HEAD", 4, 0, 4 );
+    CPPUNIT_ASSERT_EQUAL( 0, (int)target.size() );
+
+    // Shorter than the threshold, still copied through the buffer.
+    bufStream.write( (unsigned char*)"short", 5, 0, 5 );
+    CPPUNIT_ASSERT_EQUAL( 0, (int)target.size() );
+    CPPUNIT_ASSERT_EQUAL( 0, target.gatheredWrites );
+
+    // Goes straight out, behind the bytes that were buffered.
+    std::string body( "0123456789ABCDEFGHIJ" );
+    bufStream.write( (const unsigned char*)body.c_str(), (int)body.length(), 0, (int)body.length() );
+    CPPUNIT_ASSERT_EQUAL( 1, target.gatheredWrites );
+    CPPUNIT_ASSERT_EQUAL( std::string( "HEADshort" ) + body, target.toString() );
+
+    bufStream.write( (unsigned char*)"TAIL", 4, 0, 4 );
+    CPPUNIT_ASSERT_EQUAL( (int)(9 + body.length()), (int)target.size() );
+
+    bufStream.flush();
+    CPPUNIT_ASSERT_EQUAL( std::string( "HEADshort" ) + body + "TAIL", target.toString() );
+    CPPUNIT_ASSERT_EQUAL( 1, target.gatheredWrites );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BufferedOutputStreamTest::testDirectWriteThreshold() {
+
+    GatheringOutputStream target;
+    BufferedOutputStream bufStream( &target, 8 );
+
+    CPPUNIT_ASSERT_EQUAL( 0, bufStream.getDirectWriteThreshold() );
+
+    // Disabled by default, a large write is copied through in chunks.
+    std::string body( "0123456789ABCDEFGHIJ" );
+    bufStream.write( (const unsigned char*)body.c_str(), (int)body.length(), 0, (int)body.length() );
+    CPPUNIT_ASSERT_EQUAL( 0, target.gatheredWrites );
+    CPPUNIT_ASSERT_EQUAL( 16, (int)target.size() );
+
+    bufStream.setDirectWriteThreshold( 32 );
+    CPPUNIT_ASSERT_EQUAL( 32, bufStream.getDirectWriteThreshold() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        bufStream.setDirectWriteThreshold( -1 ),
+        IllegalArgumentException );
+}
+
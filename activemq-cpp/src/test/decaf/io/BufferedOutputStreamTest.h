@@ -43,6 +43,8 @@ namespace io{
       CPPUNIT_TEST( testWriteNullStreamNullArraySize );
       CPPUNIT_TEST( testWriteNullStreamSize );
       CPPUNIT_TEST( testWriteI );
+      CPPUNIT_TEST( testDirectWrite );
+      CPPUNIT_TEST( testDirectWriteThreshold );
       CPPUNIT_TEST_SUITE_END();
 
       std::string testString;
@@ -69,6 +71,8 @@ namespace io{
         void testWriteNullStream();
         void testWriteNullStreamSize();
         void testWriteI();
+        void testDirectWrite();
+        void testDirectWriteThreshold();
 
     };
 
@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileOutputStreamTest.h"
+
+#include <decaf/io/File.h>
+#include <decaf/io/FileInputStream.h>
+#include <decaf/io/FileOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/util/UUID.h>
+
+#include <string.h>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+FileOutputStreamTest::FileOutputStreamTest() : fileName() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileOutputStreamTest::~FileOutputStreamTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStreamTest::setUp() {
+    this->fileName = "FileOutputStreamTest-" + UUID::randomUUID().toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStreamTest::tearDown() {
+    File(this->fileName).remove();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStreamTest::testWriteAndReadBack() {
+
+    const char* text = "Test data for the FileOutputStream";
+    int length = (int) strlen(text);
+
+    FileOutputStream out(fileName);
+    CPPUNIT_ASSERT_EQUAL(fileName, out.getName());
+    out.write((const unsigned char*) text, length, 0, length);
+    out.write('!');
+    out.close();
+
+    FileInputStream in(fileName);
+    CPPUNIT_ASSERT_EQUAL(length + 1, in.available());
+
+    unsigned char buffer[64] = { 0 };
+    CPPUNIT_ASSERT_EQUAL(length, in.read(buffer, 64, 0, length));
+    CPPUNIT_ASSERT(memcmp(buffer, text, length) == 0);
+    CPPUNIT_ASSERT_EQUAL((int) '!', in.read());
+    CPPUNIT_ASSERT_EQUAL(0, in.available());
+    CPPUNIT_ASSERT_EQUAL(-1, in.read());
+    CPPUNIT_ASSERT_EQUAL(-1, in.read(buffer, 64, 0, 64));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStreamTest::testAppend() {
+
+    {
+        FileOutputStream out(fileName);
+        out.write('A');
+    }
+
+    {
+        FileOutputStream out(fileName, true);
+        out.write('B');
+    }
+
+    FileInputStream in(fileName);
+    CPPUNIT_ASSERT_EQUAL((int) 'A', in.read());
+    CPPUNIT_ASSERT_EQUAL((int) 'B', in.read());
+    CPPUNIT_ASSERT_EQUAL(-1, in.read());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStreamTest::testTruncate() {
+
+    {
+        FileOutputStream out(fileName);
+        out.write('A');
+        out.write('B');
+    }
+
+    {
+        FileOutputStream out(fileName);
+        out.write('C');
+    }
+
+    CPPUNIT_ASSERT_EQUAL(1LL, File(fileName).length());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStreamTest::testWriteAfterClose() {
+
+    FileOutputStream out(fileName);
+    out.close();
+    out.close();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        out.write('A'),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        out.sync(),
+        IOException);
+
+    FileInputStream in(fileName);
+    in.close();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        in.read(),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStreamTest::testOpenMissingFile() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        FileInputStream in(fileName),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileOutputStreamTest::testSync() {
+
+    FileOutputStream out(fileName);
+    out.write('A');
+    out.sync();
+    out.write('B');
+    out.sync();
+
+    CPPUNIT_ASSERT_EQUAL(2LL, File(fileName).length());
+}
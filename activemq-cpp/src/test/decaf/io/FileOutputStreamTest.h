@@ -0,0 +1,63 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_IO_FILEOUTPUTSTREAMTEST_H_
+#define _DECAF_IO_FILEOUTPUTSTREAMTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace decaf {
+namespace io {
+
+    class FileOutputStreamTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( FileOutputStreamTest );
+        CPPUNIT_TEST( testWriteAndReadBack );
+        CPPUNIT_TEST( testAppend );
+        CPPUNIT_TEST( testTruncate );
+        CPPUNIT_TEST( testWriteAfterClose );
+        CPPUNIT_TEST( testOpenMissingFile );
+        CPPUNIT_TEST( testSync );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        std::string fileName;
+
+    public:
+
+        FileOutputStreamTest();
+        virtual ~FileOutputStreamTest();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testWriteAndReadBack();
+        void testAppend();
+        void testTruncate();
+        void testWriteAfterClose();
+        void testOpenMissingFile();
+        void testSync();
+
+    };
+
+}}
+
+#endif /* _DECAF_IO_FILEOUTPUTSTREAMTEST_H_ */
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileTest.h"
+
+#include <decaf/io/File.h>
+#include <decaf/io/FileOutputStream.h>
+#include <decaf/util/UUID.h>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::string createFile(int size) {
+        std::string name = "FileTest-" + UUID::randomUUID().toString();
+
+        FileOutputStream out(name);
+        for (int i = 0; i < size; ++i) {
+            out.write((unsigned char) i);
+        }
+        out.close();
+
+        return name;
+    }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileTest::FileTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileTest::~FileTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTest::testExistsAndLength() {
+
+    File missing("FileTest-" + UUID::randomUUID().toString());
+    CPPUNIT_ASSERT(!missing.exists());
+    CPPUNIT_ASSERT_EQUAL(0LL, missing.length());
+
+    File file(createFile(100));
+    CPPUNIT_ASSERT(file.exists());
+    CPPUNIT_ASSERT_EQUAL(100LL, file.length());
+
+    file.remove();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTest::testRemove() {
+
+    File file(createFile(10));
+    CPPUNIT_ASSERT(file.exists());
+    CPPUNIT_ASSERT(file.remove());
+    CPPUNIT_ASSERT(!file.exists());
+    CPPUNIT_ASSERT(!file.remove());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileTest::testRenameTo() {
+
+    File source(createFile(10));
+    File target(createFile(20));
+
+    CPPUNIT_ASSERT(source.renameTo(target));
+    CPPUNIT_ASSERT(!source.exists());
+    CPPUNIT_ASSERT(target.exists());
+    CPPUNIT_ASSERT_EQUAL(10LL, target.length());
+
+    target.remove();
+}
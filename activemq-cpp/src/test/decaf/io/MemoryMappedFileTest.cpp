@@ -0,0 +1,198 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryMappedFileTest.h"
+
+#include <decaf/io/File.h>
+#include <decaf/io/FileOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/io/MemoryMappedFile.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/util/UUID.h>
+
+#include <memory>
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryMappedFileTest::MemoryMappedFileTest() : fileName() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryMappedFileTest::~MemoryMappedFileTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::setUp() {
+    this->fileName = "MemoryMappedFileTest-" + UUID::randomUUID().toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::tearDown() {
+    File(this->fileName).remove();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::writeFile(int size) {
+
+    std::vector<unsigned char> data(size);
+    for (int i = 0; i < size; ++i) {
+        data[i] = (unsigned char)(i % 251);
+    }
+
+    FileOutputStream out(fileName);
+    if (size > 0) {
+        out.write(&data[0], size, 0, size);
+    }
+    out.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::testMapWholeFile() {
+
+    writeFile(1000);
+
+    MemoryMappedFile mapping(fileName);
+    CPPUNIT_ASSERT_EQUAL(fileName, mapping.getName());
+    CPPUNIT_ASSERT_EQUAL(0LL, mapping.getOffset());
+    CPPUNIT_ASSERT_EQUAL(1000LL, mapping.getLength());
+    CPPUNIT_ASSERT(mapping.isReadOnly());
+    CPPUNIT_ASSERT(!mapping.isClosed());
+
+    const unsigned char* data = mapping.getData();
+    CPPUNIT_ASSERT(data != NULL);
+    for (int i = 0; i < 1000; ++i) {
+        CPPUNIT_ASSERT_EQUAL((int)(i % 251), (int)data[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::testMapUnalignedRegion() {
+
+    // Large enough that the region starts past the first mapping boundary.
+    writeFile(200000);
+
+    MemoryMappedFile mapping(fileName, 70001, 5000);
+    CPPUNIT_ASSERT_EQUAL(70001LL, mapping.getOffset());
+    CPPUNIT_ASSERT_EQUAL(5000LL, mapping.getLength());
+
+    const unsigned char* data = mapping.getData();
+    for (int i = 0; i < 5000; ++i) {
+        CPPUNIT_ASSERT_EQUAL((int)((70001 + i) % 251), (int)data[i]);
+    }
+
+    MemoryMappedFile tail(fileName, 199990);
+    CPPUNIT_ASSERT_EQUAL(10LL, tail.getLength());
+    CPPUNIT_ASSERT_EQUAL((int)(199999 % 251), (int)tail.getData()[9]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::testMapEmptyRegion() {
+
+    writeFile(0);
+
+    MemoryMappedFile mapping(fileName);
+    CPPUNIT_ASSERT_EQUAL(0LL, mapping.getLength());
+    CPPUNIT_ASSERT(mapping.getData() == NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::testRegionOutsideFile() {
+
+    writeFile(100);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        MemoryMappedFile(fileName, 101),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        MemoryMappedFile(fileName, 50, 51),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        MemoryMappedFile(fileName, -1),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        MemoryMappedFile(fileName + "-missing"),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::testReadOnlyMapping() {
+
+    writeFile(100);
+
+    MemoryMappedFile mapping(fileName);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalStateException",
+        mapping.getWritableData(),
+        IllegalStateException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::testAccessAfterClose() {
+
+    writeFile(100);
+
+    MemoryMappedFile mapping(fileName);
+    mapping.close();
+    mapping.close();
+
+    CPPUNIT_ASSERT(mapping.isClosed());
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IOException",
+        mapping.getData(),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryMappedFileTest::testTemporary() {
+
+    std::auto_ptr<MemoryMappedFile> mapping(MemoryMappedFile::createTemporary(100000));
+
+    CPPUNIT_ASSERT(!mapping->isReadOnly());
+    CPPUNIT_ASSERT_EQUAL(100000LL, mapping->getLength());
+
+    unsigned char* data = mapping->getWritableData();
+    for (int i = 0; i < 100000; ++i) {
+        data[i] = (unsigned char)(i % 13);
+    }
+
+    const unsigned char* readBack = mapping->getData();
+    CPPUNIT_ASSERT_EQUAL(0, (int)readBack[0]);
+    CPPUNIT_ASSERT_EQUAL(99999 % 13, (int)readBack[99999]);
+
+    std::string name = mapping->getName();
+    mapping->close();
+    CPPUNIT_ASSERT(!File(name).exists());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        MemoryMappedFile::createTemporary(-1),
+        IllegalArgumentException);
+}
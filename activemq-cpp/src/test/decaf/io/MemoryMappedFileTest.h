@@ -0,0 +1,69 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_IO_MEMORYMAPPEDFILETEST_H_
+#define _DECAF_IO_MEMORYMAPPEDFILETEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace decaf {
+namespace io {
+
+    class MemoryMappedFileTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( MemoryMappedFileTest );
+        CPPUNIT_TEST( testMapWholeFile );
+        CPPUNIT_TEST( testMapUnalignedRegion );
+        CPPUNIT_TEST( testMapEmptyRegion );
+        CPPUNIT_TEST( testRegionOutsideFile );
+        CPPUNIT_TEST( testReadOnlyMapping );
+        CPPUNIT_TEST( testAccessAfterClose );
+        CPPUNIT_TEST( testTemporary );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        std::string fileName;
+
+    public:
+
+        MemoryMappedFileTest();
+        virtual ~MemoryMappedFileTest();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testMapWholeFile();
+        void testMapUnalignedRegion();
+        void testMapEmptyRegion();
+        void testRegionOutsideFile();
+        void testReadOnlyMapping();
+        void testAccessAfterClose();
+        void testTemporary();
+
+    private:
+
+        void writeFile(int size);
+
+    };
+
+}}
+
+#endif /* _DECAF_IO_MEMORYMAPPEDFILETEST_H_ */
@@ -71,3 +71,41 @@ void OutputStreamTest::test() {
     CPPUNIT_ASSERT_EQUAL_MESSAGE( "Written string not what was expected",
                                   std::string( "hello world" ), result );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void OutputStreamTest::testWriteGathered() {
+
+    MockOutputStream ostream;
+
+    std::string hello( "hello" );
+    std::string world( " world" );
+    const unsigned char* buffers[3] = {
+        (const unsigned char*)hello.c_str(), NULL, (const unsigned char*)world.c_str() };
+    int lengths[3] = { 5, 0, 6 };
+
+    ostream.writeGathered( buffers, lengths, 3 );
+
+    std::string result( ostream.getBuffer().begin(), ostream.getBuffer().end() );
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE( "Written string not what was expected",
+                                  std::string( "hello world" ), result );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IndexOutOfBoundsException",
+        ostream.writeGathered( buffers, lengths, -1 ),
+        IndexOutOfBoundsException );
+
+    lengths[1] = 1;
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a NullPointerException",
+        ostream.writeGathered( buffers, lengths, 3 ),
+        NullPointerException );
+
+    lengths[1] = -1;
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IndexOutOfBoundsException",
+        ostream.writeGathered( buffers, lengths, 3 ),
+        IndexOutOfBoundsException );
+
+    CPPUNIT_ASSERT_EQUAL( 11, (int)ostream.getBuffer().size() );
+}
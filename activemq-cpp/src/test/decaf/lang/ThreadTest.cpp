@@ -131,6 +131,20 @@ namespace lang{
         }
     };
 
+    class AffinityThread : public Runnable {
+    public:
+
+        std::vector<int> affinity;
+
+        AffinityThread() : Runnable(), affinity() {}
+
+        virtual ~AffinityThread() {}
+
+        virtual void run() {
+            affinity = Thread::currentThread()->getAffinity();
+        }
+    };
+
     class YieldThread : public Runnable {
     private:
 
@@ -921,3 +935,47 @@ void ThreadTest::testCreatedButNotStarted() {
 
     threads.clear();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ThreadTest::testSetAffinity() {
+
+    std::vector<int> available;
+
+    try {
+        available = Thread::currentThread()->getAffinity();
+    } catch (UnsupportedOperationException& ex) {
+        return;
+    }
+
+    CPPUNIT_ASSERT(!available.empty());
+
+    // Pin to the last processor we may use, assigned before start so the whole run is pinned.
+    std::vector<int> pinned;
+    pinned.push_back(available.back());
+
+    AffinityThread runnable;
+    Thread thread(&runnable);
+    thread.setAffinity(pinned);
+    CPPUNIT_ASSERT(thread.getAffinity() == pinned);
+    thread.start();
+    thread.join();
+
+    CPPUNIT_ASSERT_MESSAGE("Thread did not observe its affinity", runnable.affinity == pinned);
+
+    // An empty set lifts the restriction again.
+    AffinityThread unpinned;
+    Thread other(&unpinned);
+    other.setAffinity(pinned);
+    other.setAffinity(std::vector<int>());
+    other.start();
+    other.join();
+
+    CPPUNIT_ASSERT(unpinned.affinity.size() >= available.size());
+
+    std::vector<int> invalid;
+    invalid.push_back(-1);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        other.setAffinity(invalid),
+        IllegalArgumentException);
+}
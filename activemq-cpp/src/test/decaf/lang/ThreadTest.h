@@ -56,6 +56,7 @@ namespace lang{
       CPPUNIT_TEST( testRapidCreateAndDestroy );
       CPPUNIT_TEST( testConcurrentRapidCreateAndDestroy );
       CPPUNIT_TEST( testCreatedButNotStarted );
+      CPPUNIT_TEST( testSetAffinity );
       CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -94,6 +95,7 @@ namespace lang{
         void testRapidCreateAndDestroy();
         void testConcurrentRapidCreateAndDestroy();
         void testCreatedButNotStarted();
+        void testSetAffinity();
 
     };
 
@@ -26,7 +26,10 @@
 #include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/lang/Thread.h>
+#include <algorithm>
 #include <list>
+#include <memory>
+#include <vector>
 #include <string.h>
 
 using namespace std;
@@ -822,3 +825,76 @@ void SocketTest::testTrxNoDelay() {
         printf( "%s\n", ex.getMessage().c_str() );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class GatheredReader : public lang::Runnable {
+    private:
+
+        Socket* socket;
+        int expected;
+
+    public:
+
+        std::vector<unsigned char> received;
+
+        GatheredReader(Socket* socket, int expected) : socket(socket), expected(expected), received() {}
+
+        virtual ~GatheredReader() {}
+
+        virtual void run() {
+            try {
+                std::vector<unsigned char> buffer(65536);
+                while ((int) received.size() < expected) {
+                    int count = socket->getInputStream()->read(&buffer[0], (int) buffer.size(), 0, (int) buffer.size());
+                    if (count == -1) {
+                        break;
+                    }
+                    received.insert(received.end(), buffer.begin(), buffer.begin() + count);
+                }
+            } catch (io::IOException& ex) {
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketTest::testTxGathered() {
+
+    ServerSocket server(0);
+
+    Socket client;
+    client.connect("127.0.0.1", server.getLocalPort());
+    std::auto_ptr<Socket> peer(server.accept());
+
+    // Large enough that the socket cannot take it in one send.
+    std::vector<unsigned char> body(4 * 1024 * 1024);
+    for (std::size_t i = 0; i < body.size(); ++i) {
+        body[i] = (unsigned char) (i % 251);
+    }
+
+    std::string header("header:");
+    std::string trailer(":trailer");
+
+    const unsigned char* buffers[4] = {
+        (const unsigned char*) header.c_str(), NULL, &body[0], (const unsigned char*) trailer.c_str() };
+    int lengths[4] = { (int) header.length(), 0, (int) body.size(), (int) trailer.length() };
+    int total = lengths[0] + lengths[2] + lengths[3];
+
+    GatheredReader reader(peer.get(), total);
+    Thread readerThread(&reader);
+    readerThread.start();
+
+    client.getOutputStream()->writeGathered(buffers, lengths, 4);
+    readerThread.join(10000);
+
+    CPPUNIT_ASSERT_EQUAL(total, (int) reader.received.size());
+    CPPUNIT_ASSERT(std::equal(header.begin(), header.end(), reader.received.begin()));
+    CPPUNIT_ASSERT(std::equal(body.begin(), body.end(), reader.received.begin() + header.length()));
+    CPPUNIT_ASSERT(std::equal(trailer.begin(), trailer.end(), reader.received.end() - trailer.length()));
+
+    client.close();
+    peer->close();
+}
+
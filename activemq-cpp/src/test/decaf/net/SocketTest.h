@@ -49,6 +49,7 @@ namespace net{
         CPPUNIT_TEST( testTrx );
         CPPUNIT_TEST( testTrxNoDelay );
         CPPUNIT_TEST( testRxFail );
+        CPPUNIT_TEST( testTxGathered );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -79,6 +80,7 @@ namespace net{
         void testTrx();
         void testRxFail();
         void testTrxNoDelay();
+        void testTxGathered();
 
     };
 
@@ -0,0 +1,399 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FlatHashMapTest.h"
+
+#include <decaf/util/FlatHashMap.h>
+#include <decaf/util/HashMap.h>
+#include <decaf/util/Random.h>
+#include <decaf/util/Set.h>
+#include <decaf/util/Iterator.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+
+#include <map>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int MAP_SIZE = 1000;
+
+    void populateMap(FlatHashMap<int, std::string>& map) {
+        for (int i = 0; i < MAP_SIZE; ++i) {
+            map.put(i, Integer::toString(i));
+        }
+    }
+
+    // Sends every key to the same home slot so that all of them share one probe run.
+    struct CollidingHashCode : HashCodeUnaryBase<int> {
+        int operator()(int arg DECAF_UNUSED) const {
+            return 42;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FlatHashMapTest::FlatHashMapTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FlatHashMapTest::~FlatHashMapTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testConstructor() {
+
+    FlatHashMap<int, std::string> map;
+    CPPUNIT_ASSERT(map.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(0, map.size());
+    CPPUNIT_ASSERT_THROW(map.get(1), NoSuchElementException);
+    CPPUNIT_ASSERT_THROW(map.remove(1), NoSuchElementException);
+
+    FlatHashMap<int, std::string> empty(0);
+    empty.put(1, "here");
+    CPPUNIT_ASSERT_EQUAL(std::string("here"), empty.get(1));
+
+    try {
+        FlatHashMap<int, std::string> map(-1);
+        CPPUNIT_FAIL("Should have thrown IllegalArgumentException for negative arg.");
+    } catch (IllegalArgumentException& e) {
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testConstructorIF() {
+
+    FlatHashMap<int, std::string> map(5, 0.5f);
+    CPPUNIT_ASSERT_EQUAL(0, map.size());
+
+    try {
+        FlatHashMap<int, std::string> map(0, 0);
+        CPPUNIT_FAIL("Should have thrown IllegalArgumentException for zero load factor.");
+    } catch (IllegalArgumentException& e) {
+    }
+
+    // A load factor of one is reduced so the index never fills up.
+    FlatHashMap<int, int> full(16, 1.0f);
+    for (int i = 0; i < 100; ++i) {
+        full.put(i, i);
+    }
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i, full.get(i));
+    }
+    CPPUNIT_ASSERT(!full.containsKey(100));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testConstructorMap() {
+
+    HashMap<int, int> source;
+    for (int i = 0; i < 125; ++i) {
+        source.put(i, i * 3);
+    }
+
+    FlatHashMap<int, int> map(source);
+    CPPUNIT_ASSERT_EQUAL(125, map.size());
+    for (int i = 0; i < 125; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i * 3, map.get(i));
+    }
+
+    FlatHashMap<int, int> copy(map);
+    CPPUNIT_ASSERT(copy.equals(map));
+    CPPUNIT_ASSERT(copy.equals(source));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testPutGet() {
+
+    FlatHashMap<std::string, int> map;
+
+    CPPUNIT_ASSERT(!map.put("one", 1));
+    CPPUNIT_ASSERT(!map.put("two", 2));
+
+    int oldValue = 0;
+    CPPUNIT_ASSERT(map.put("one", 11, oldValue));
+    CPPUNIT_ASSERT_EQUAL(1, oldValue);
+    CPPUNIT_ASSERT_EQUAL(2, map.size());
+    CPPUNIT_ASSERT_EQUAL(11, map.get("one"));
+
+    map.get("two") = 22;
+    CPPUNIT_ASSERT_EQUAL(22, map.get("two"));
+
+    const FlatHashMap<std::string, int>& constMap = map;
+    CPPUNIT_ASSERT_EQUAL(22, constMap.get("two"));
+    CPPUNIT_ASSERT_THROW(constMap.get("three"), NoSuchElementException);
+
+    CPPUNIT_ASSERT(map.containsKey("one"));
+    CPPUNIT_ASSERT(!map.containsKey("three"));
+    CPPUNIT_ASSERT(map.containsValue(22));
+    CPPUNIT_ASSERT(!map.containsValue(2));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testRemove() {
+
+    FlatHashMap<int, std::string> map;
+    populateMap(map);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("10"), map.remove(10));
+    CPPUNIT_ASSERT(!map.containsKey(10));
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE - 1, map.size());
+    CPPUNIT_ASSERT_THROW(map.remove(10), NoSuchElementException);
+
+    for (int i = 0; i < MAP_SIZE; i += 2) {
+        if (i != 10) {
+            map.remove(i);
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE / 2, map.size());
+    for (int i = 0; i < MAP_SIZE; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i % 2 == 1, map.containsKey(i));
+        if (i % 2 == 1) {
+            CPPUNIT_ASSERT_EQUAL(Integer::toString(i), map.get(i));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testCollidingKeys() {
+
+    FlatHashMap<int, int, CollidingHashCode> map;
+    for (int i = 0; i < 64; ++i) {
+        map.put(i, i);
+    }
+
+    // Removing from the middle of the run has to shift the tail of it back.
+    for (int i = 0; i < 64; i += 3) {
+        CPPUNIT_ASSERT_EQUAL(i, map.remove(i));
+    }
+
+    for (int i = 0; i < 64; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i % 3 != 0, map.containsKey(i));
+    }
+
+    for (int i = 0; i < 64; i += 3) {
+        map.put(i, -i);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(64, map.size());
+    for (int i = 0; i < 64; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i % 3 == 0 ? -i : i, map.get(i));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testRehash() {
+
+    FlatHashMap<int, int> map(0);
+    for (int i = 0; i < 100000; ++i) {
+        map.put(i * 7, i);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(100000, map.size());
+    for (int i = 0; i < 100000; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i, map.get(i * 7));
+    }
+    CPPUNIT_ASSERT(!map.containsKey(1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testClear() {
+
+    FlatHashMap<int, std::string> map;
+    populateMap(map);
+    map.clear();
+
+    CPPUNIT_ASSERT(map.isEmpty());
+    CPPUNIT_ASSERT(!map.containsKey(0));
+    CPPUNIT_ASSERT(!map.values().iterator()->hasNext());
+
+    map.put(1, "one");
+    CPPUNIT_ASSERT_EQUAL(std::string("one"), map.get(1));
+    CPPUNIT_ASSERT_EQUAL(1, map.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testEntrySetIterator() {
+
+    FlatHashMap<int, std::string> map;
+    populateMap(map);
+
+    std::map<int, std::string> seen;
+    Pointer< Iterator< MapEntry<int, std::string> > > iter(map.entrySet().iterator());
+    while (iter->hasNext()) {
+        MapEntry<int, std::string> entry = iter->next();
+        CPPUNIT_ASSERT_EQUAL(Integer::toString(entry.getKey()), entry.getValue());
+        seen.insert(std::make_pair(entry.getKey(), entry.getValue()));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE, (int) seen.size());
+    CPPUNIT_ASSERT_THROW(iter->next(), NoSuchElementException);
+
+    CPPUNIT_ASSERT(map.entrySet().contains(MapEntry<int, std::string>(5, "5")));
+    CPPUNIT_ASSERT(!map.entrySet().contains(MapEntry<int, std::string>(5, "6")));
+    CPPUNIT_ASSERT(!map.entrySet().remove(MapEntry<int, std::string>(5, "6")));
+    CPPUNIT_ASSERT(map.entrySet().remove(MapEntry<int, std::string>(5, "5")));
+    CPPUNIT_ASSERT(!map.containsKey(5));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testKeySetIteratorRemove() {
+
+    FlatHashMap<int, std::string> map;
+    populateMap(map);
+
+    Pointer< Iterator<int> > iter(map.keySet().iterator());
+    CPPUNIT_ASSERT_THROW(iter->remove(), IllegalStateException);
+
+    // Each removal moves the last entry into the freed position, which must
+    // still be visited by the iterator.
+    int visited = 0;
+    while (iter->hasNext()) {
+        int key = iter->next();
+        visited++;
+        if (key % 2 == 0) {
+            iter->remove();
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE, visited);
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE / 2, map.size());
+    for (int i = 0; i < MAP_SIZE; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i % 2 == 1, map.containsKey(i));
+    }
+
+    CPPUNIT_ASSERT(map.keySet().remove(1));
+    CPPUNIT_ASSERT(!map.keySet().remove(1));
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE / 2 - 1, map.keySet().size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testConstViews() {
+
+    FlatHashMap<int, std::string> map;
+    populateMap(map);
+    const FlatHashMap<int, std::string>& constMap = map;
+
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE, constMap.keySet().size());
+    CPPUNIT_ASSERT(constMap.values().contains("999"));
+
+    Pointer< Iterator<std::string> > iter(constMap.values().iterator());
+    int count = 0;
+    while (iter->hasNext()) {
+        iter->next();
+        count++;
+    }
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE, count);
+
+    CPPUNIT_ASSERT_THROW(iter->remove(), UnsupportedOperationException);
+    CPPUNIT_ASSERT_THROW(
+        const_cast<Set<int>&>(constMap.keySet()).remove(1), UnsupportedOperationException);
+    CPPUNIT_ASSERT_EQUAL(MAP_SIZE, map.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testConcurrentModification() {
+
+    FlatHashMap<int, std::string> map;
+    populateMap(map);
+
+    Pointer< Iterator<int> > iter(map.keySet().iterator());
+    iter->next();
+    map.put(MAP_SIZE, "new");
+    CPPUNIT_ASSERT_THROW(iter->next(), ConcurrentModificationException);
+
+    // Replacing a value is not a structural modification.
+    Pointer< Iterator<int> > iter2(map.keySet().iterator());
+    iter2->next();
+    map.put(0, "zero");
+    CPPUNIT_ASSERT_NO_THROW(iter2->next());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testEquals() {
+
+    FlatHashMap<int, std::string> map;
+    HashMap<int, std::string> other;
+    populateMap(map);
+
+    for (int i = MAP_SIZE - 1; i >= 0; --i) {
+        other.put(i, Integer::toString(i));
+    }
+
+    CPPUNIT_ASSERT(map.equals(other));
+    CPPUNIT_ASSERT(other.equals(map));
+
+    other.put(0, "different");
+    CPPUNIT_ASSERT(!map.equals(other));
+
+    FlatHashMap<int, std::string> copy;
+    copy.copy(other);
+    CPPUNIT_ASSERT(copy.equals(other));
+    CPPUNIT_ASSERT_EQUAL(std::string("different"), copy.get(0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FlatHashMapTest::testRandomOperations() {
+
+    FlatHashMap<int, int> map;
+    std::map<int, int> expected;
+    Random random(42);
+
+    for (int i = 0; i < 50000; ++i) {
+        int key = random.nextInt(2000);
+        switch (random.nextInt(3)) {
+            case 0:
+            case 1:
+                CPPUNIT_ASSERT_EQUAL(expected.count(key) != 0, map.put(key, i));
+                expected[key] = i;
+                break;
+            default:
+                if (expected.count(key) != 0) {
+                    CPPUNIT_ASSERT_EQUAL(expected[key], map.remove(key));
+                    expected.erase(key);
+                } else {
+                    CPPUNIT_ASSERT(!map.containsKey(key));
+                }
+                break;
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL((int) expected.size(), map.size());
+
+    std::map<int, int>::const_iterator iter = expected.begin();
+    for (; iter != expected.end(); ++iter) {
+        CPPUNIT_ASSERT_EQUAL(iter->second, map.get(iter->first));
+    }
+
+    int count = 0;
+    Pointer< Iterator< MapEntry<int, int> > > entries(map.entrySet().iterator());
+    while (entries->hasNext()) {
+        MapEntry<int, int> entry = entries->next();
+        CPPUNIT_ASSERT_EQUAL(expected[entry.getKey()], entry.getValue());
+        count++;
+    }
+    CPPUNIT_ASSERT_EQUAL(map.size(), count);
+}
@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_FLATHASHMAPTEST_H_
+#define _DECAF_UTIL_FLATHASHMAPTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace decaf {
+namespace util {
+
+    class FlatHashMapTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( FlatHashMapTest );
+        CPPUNIT_TEST( testConstructor );
+        CPPUNIT_TEST( testConstructorIF );
+        CPPUNIT_TEST( testConstructorMap );
+        CPPUNIT_TEST( testPutGet );
+        CPPUNIT_TEST( testRemove );
+        CPPUNIT_TEST( testCollidingKeys );
+        CPPUNIT_TEST( testRehash );
+        CPPUNIT_TEST( testClear );
+        CPPUNIT_TEST( testEntrySetIterator );
+        CPPUNIT_TEST( testKeySetIteratorRemove );
+        CPPUNIT_TEST( testConstViews );
+        CPPUNIT_TEST( testConcurrentModification );
+        CPPUNIT_TEST( testEquals );
+        CPPUNIT_TEST( testRandomOperations );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        FlatHashMapTest();
+        virtual ~FlatHashMapTest();
+
+        void testConstructor();
+        void testConstructorIF();
+        void testConstructorMap();
+        void testPutGet();
+        void testRemove();
+        void testCollidingKeys();
+        void testRehash();
+        void testClear();
+        void testEntrySetIterator();
+        void testKeySetIteratorRemove();
+        void testConstViews();
+        void testConcurrentModification();
+        void testEquals();
+        void testRandomOperations();
+
+    };
+
+}}
+
+#endif /* _DECAF_UTIL_FLATHASHMAPTEST_H_ */
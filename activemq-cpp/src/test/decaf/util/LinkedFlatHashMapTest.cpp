@@ -0,0 +1,283 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LinkedFlatHashMapTest.h"
+
+#include <decaf/util/LinkedFlatHashMap.h>
+#include <decaf/util/Random.h>
+#include <decaf/util/Iterator.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Pointer.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::util;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::vector<int> keysOf(LinkedFlatHashMap<int, int>& map) {
+        std::vector<int> keys;
+        Pointer< Iterator<int> > iter(map.keySet().iterator());
+        while (iter->hasNext()) {
+            keys.push_back(iter->next());
+        }
+        return keys;
+    }
+
+    class CacheMap : public LinkedFlatHashMap<int, int> {
+    public:
+
+        int removals;
+
+        CacheMap() : LinkedFlatHashMap<int, int>(), removals(0) {
+        }
+
+        virtual ~CacheMap() {}
+
+    protected:
+
+        virtual bool removeEldestEntry(const MapEntry<int, int>& eldest DECAF_UNUSED) {
+            return size() > 5;
+        }
+
+        virtual void onEviction(const MapEntry<int, int>& eldest DECAF_UNUSED) {
+            removals++;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LinkedFlatHashMapTest::LinkedFlatHashMapTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LinkedFlatHashMapTest::~LinkedFlatHashMapTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LinkedFlatHashMapTest::testInsertionOrder() {
+
+    LinkedFlatHashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.put((i * 7919) % 1000, i);
+    }
+
+    std::vector<int> keys = keysOf(map);
+    CPPUNIT_ASSERT_EQUAL(1000, (int) keys.size());
+    for (int i = 0; i < 1000; ++i) {
+        CPPUNIT_ASSERT_EQUAL((i * 7919) % 1000, keys[i]);
+    }
+
+    // Replacing a value keeps the entry where it was.
+    map.put(keys[0], -1);
+    CPPUNIT_ASSERT_EQUAL(keys[0], keysOf(map)[0]);
+    CPPUNIT_ASSERT_EQUAL(-1, map.get(keys[0]));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LinkedFlatHashMapTest::testInsertionOrderAfterRemove() {
+
+    LinkedFlatHashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.put(i, i);
+    }
+
+    // Enough removals to force the entries to be compacted several times over.
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 10 != 0) {
+            map.remove(i);
+        }
+    }
+
+    std::vector<int> keys = keysOf(map);
+    CPPUNIT_ASSERT_EQUAL(100, (int) keys.size());
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i * 10, keys[i]);
+        CPPUNIT_ASSERT_EQUAL(i * 10, map.get(i * 10));
+    }
+
+    map.put(5, 5);
+    CPPUNIT_ASSERT_EQUAL(5, keysOf(map).back());
+
+    for (int i = 0; i < 100; ++i) {
+        map.remove(i * 10);
+    }
+    map.remove(5);
+    CPPUNIT_ASSERT(map.isEmpty());
+    CPPUNIT_ASSERT(keysOf(map).empty());
+
+    map.put(1, 1);
+    CPPUNIT_ASSERT_EQUAL(1, (int) keysOf(map).size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LinkedFlatHashMapTest::testAccessOrder() {
+
+    LinkedFlatHashMap<int, int> map(0, 0.75f, true);
+    for (int i = 0; i < 10; ++i) {
+        map.put(i, i);
+    }
+
+    map.get(3);
+    map.put(5, 50);
+    const LinkedFlatHashMap<int, int>& constMap = map;
+    constMap.get(0);
+
+    std::vector<int> keys = keysOf(map);
+    int expected[] = { 1, 2, 4, 6, 7, 8, 9, 3, 5, 0 };
+    CPPUNIT_ASSERT_EQUAL(10, (int) keys.size());
+    for (int i = 0; i < 10; ++i) {
+        CPPUNIT_ASSERT_EQUAL(expected[i], keys[i]);
+    }
+    CPPUNIT_ASSERT_EQUAL(50, map.get(5));
+
+    // Repeated access to the eldest entries keeps the array compact.
+    for (int i = 0; i < 10000; ++i) {
+        map.get(keysOf(map)[0]);
+    }
+    CPPUNIT_ASSERT_EQUAL(10, map.size());
+    CPPUNIT_ASSERT_EQUAL(10, (int) keysOf(map).size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LinkedFlatHashMapTest::testAccessOrderInvalidatesIterator() {
+
+    LinkedFlatHashMap<int, int> map(0, 0.75f, true);
+    for (int i = 0; i < 10; ++i) {
+        map.put(i, i);
+    }
+
+    Pointer< Iterator<int> > iter(map.values().iterator());
+    iter->next();
+    map.get(0);
+    CPPUNIT_ASSERT_THROW(iter->next(), ConcurrentModificationException);
+
+    LinkedFlatHashMap<int, int> insertion;
+    insertion.put(1, 1);
+    insertion.put(2, 2);
+    Pointer< Iterator<int> > iter2(insertion.values().iterator());
+    iter2->next();
+    insertion.get(1);
+    CPPUNIT_ASSERT_EQUAL(2, iter2->next());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LinkedFlatHashMapTest::testRemoveEldest() {
+
+    CacheMap map;
+    for (int i = 0; i < 100; ++i) {
+        map.put(i, i * 2);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(5, map.size());
+    CPPUNIT_ASSERT_EQUAL(95, map.removals);
+
+    Pointer< Iterator<int> > iter(map.values().iterator());
+    for (int i = 95; iter->hasNext(); i++) {
+        CPPUNIT_ASSERT_EQUAL(i * 2, iter->next());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LinkedFlatHashMapTest::testIteratorRemove() {
+
+    LinkedFlatHashMap<int, int> map;
+    for (int i = 0; i < 100; ++i) {
+        map.put(i, i);
+    }
+
+    Pointer< Iterator< MapEntry<int, int> > > iter(map.entrySet().iterator());
+    int visited = 0;
+    while (iter->hasNext()) {
+        MapEntry<int, int> entry = iter->next();
+        CPPUNIT_ASSERT_EQUAL(visited, entry.getKey());
+        visited++;
+        if (entry.getKey() % 4 != 0) {
+            iter->remove();
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(100, visited);
+    std::vector<int> keys = keysOf(map);
+    CPPUNIT_ASSERT_EQUAL(25, (int) keys.size());
+    for (int i = 0; i < 25; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i * 4, keys[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LinkedFlatHashMapTest::testConstructorMap() {
+
+    LinkedFlatHashMap<int, int> source;
+    for (int i = 50; i > 0; --i) {
+        source.put(i, i);
+    }
+
+    LinkedFlatHashMap<int, int> copy(source);
+    CPPUNIT_ASSERT(copy.equals(source));
+    std::vector<int> keys = keysOf(copy);
+    for (int i = 0; i < 50; ++i) {
+        CPPUNIT_ASSERT_EQUAL(50 - i, keys[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LinkedFlatHashMapTest::testRandomOperations() {
+
+    LinkedFlatHashMap<int, int> map(0, 0.75f, true);
+    std::vector<int> expected;
+    Random random(7);
+
+    for (int i = 0; i < 20000; ++i) {
+        int key = random.nextInt(500);
+        std::vector<int>::iterator pos = std::find(expected.begin(), expected.end(), key);
+
+        switch (random.nextInt(3)) {
+            case 0:
+                map.put(key, key);
+                if (pos != expected.end()) {
+                    expected.erase(pos);
+                }
+                expected.push_back(key);
+                break;
+            case 1:
+                if (pos != expected.end()) {
+                    CPPUNIT_ASSERT_EQUAL(key, map.get(key));
+                    expected.erase(pos);
+                    expected.push_back(key);
+                } else {
+                    CPPUNIT_ASSERT(!map.containsKey(key));
+                }
+                break;
+            default:
+                if (pos != expected.end()) {
+                    CPPUNIT_ASSERT_EQUAL(key, map.remove(key));
+                    expected.erase(pos);
+                }
+                break;
+        }
+    }
+
+    std::vector<int> keys = keysOf(map);
+    CPPUNIT_ASSERT_EQUAL((int) expected.size(), map.size());
+    CPPUNIT_ASSERT(expected == keys);
+}
@@ -0,0 +1,457 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CompletableFutureTest.h"
+
+#include <decaf/util/concurrent/CompletableFuture.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/LinkedBlockingQueue.h>
+#include <decaf/util/Timer.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+///////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    typedef CompletableFuture<int> IntFuture;
+
+    class RecordingListener : public CompletionListener<int> {
+    private:
+
+        RecordingListener(const RecordingListener&);
+        RecordingListener& operator= (const RecordingListener&);
+
+    public:
+
+        CountDownLatch done;
+        int value;
+        std::string error;
+        Thread* thread;
+
+        RecordingListener() : CompletionListener<int>(), done(1), value(0), error(), thread(NULL) {}
+        virtual ~RecordingListener() {}
+
+        virtual void onSuccess(const int& result) {
+            this->value = result;
+            this->thread = Thread::currentThread();
+            this->done.countDown();
+        }
+
+        virtual void onFailure(const Exception& failure) {
+            this->error = failure.getMessage();
+            this->thread = Thread::currentThread();
+            this->done.countDown();
+        }
+    };
+
+    class Doubler : public Continuation<int, int> {
+    public:
+
+        virtual ~Doubler() {}
+
+        virtual int apply(const int& value) {
+            return value * 2;
+        }
+    };
+
+    class Describer : public Continuation<int, std::string> {
+    public:
+
+        virtual ~Describer() {}
+
+        virtual std::string apply(const int& value) {
+            return value > 0 ? "positive" : "not positive";
+        }
+    };
+
+    class Thrower : public Continuation<int, int> {
+    public:
+
+        virtual ~Thrower() {}
+
+        virtual int apply(const int& value DECAF_UNUSED) {
+            throw IllegalStateException(__FILE__, __LINE__, "continuation failed");
+        }
+    };
+
+    // Starts a second operation from the result of the first, completed from another
+    // thread the way a response to a follow up request would be.
+    class FollowUp : public Continuation<int, Pointer<IntFuture> > {
+    private:
+
+        class Completer : public Runnable {
+        private:
+
+            Pointer<IntFuture> future;
+            int value;
+
+        private:
+
+            Completer(const Completer&);
+            Completer& operator= (const Completer&);
+
+        public:
+
+            Completer(const Pointer<IntFuture>& future, int value) : Runnable(), future(future), value(value) {}
+            virtual ~Completer() {}
+
+            virtual void run() {
+                Thread::sleep(20);
+                this->future->complete(this->value);
+            }
+        };
+
+        Executor* executor;
+
+    private:
+
+        FollowUp(const FollowUp&);
+        FollowUp& operator= (const FollowUp&);
+
+    public:
+
+        FollowUp(Executor* executor) : Continuation<int, Pointer<IntFuture> >(), executor(executor) {}
+        virtual ~FollowUp() {}
+
+        virtual Pointer<IntFuture> apply(const int& value) {
+            Pointer<IntFuture> next(new IntFuture());
+            this->executor->execute(new Completer(next, value + 1));
+            return next;
+        }
+    };
+
+    ThreadPoolExecutor* newExecutor() {
+        return new ThreadPoolExecutor(2, 2, 60, TimeUnit::SECONDS, new LinkedBlockingQueue<Runnable*>());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+CompletableFutureTest::CompletableFutureTest() {
+}
+
+///////////////////////////////////////////////////////////////////////////////
+CompletableFutureTest::~CompletableFutureTest() {
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testComplete() {
+
+    IntFuture future;
+    CPPUNIT_ASSERT(!future.isDone());
+
+    CPPUNIT_ASSERT(future.complete(42));
+    CPPUNIT_ASSERT(!future.complete(43));
+    CPPUNIT_ASSERT(!future.completeExceptionally(Exception(__FILE__, __LINE__, "late")));
+
+    CPPUNIT_ASSERT(future.isDone());
+    CPPUNIT_ASSERT(!future.isCancelled());
+    CPPUNIT_ASSERT(!future.isCompletedExceptionally());
+    CPPUNIT_ASSERT_EQUAL(42, future.get());
+    CPPUNIT_ASSERT_EQUAL(42, future.get(1, TimeUnit::SECONDS));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testCompleteExceptionally() {
+
+    IntFuture future;
+    CPPUNIT_ASSERT(future.completeExceptionally(IllegalStateException(__FILE__, __LINE__, "failed")));
+    CPPUNIT_ASSERT(!future.complete(1));
+
+    CPPUNIT_ASSERT(future.isDone());
+    CPPUNIT_ASSERT(!future.isCancelled());
+    CPPUNIT_ASSERT(future.isCompletedExceptionally());
+
+    try {
+        future.get();
+        CPPUNIT_FAIL("Should have thrown an ExecutionException");
+    } catch (ExecutionException& ex) {
+        CPPUNIT_ASSERT(dynamic_cast<const IllegalStateException*>(ex.getCause()) != NULL);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testCancel() {
+
+    IntFuture future;
+    CPPUNIT_ASSERT(future.cancel(false));
+    CPPUNIT_ASSERT(!future.cancel(true));
+    CPPUNIT_ASSERT(!future.complete(1));
+
+    CPPUNIT_ASSERT(future.isDone());
+    CPPUNIT_ASSERT(future.isCancelled());
+    CPPUNIT_ASSERT(future.isCompletedExceptionally());
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a CancellationException",
+        future.get(),
+        CancellationException);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testTimedGet() {
+
+    IntFuture future;
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a TimeoutException",
+        future.get(SHORT_DELAY_MS, TimeUnit::MILLISECONDS),
+        TimeoutException);
+
+    CPPUNIT_ASSERT(!future.await(SHORT_DELAY_MS, TimeUnit::MILLISECONDS));
+    future.complete(7);
+    CPPUNIT_ASSERT(future.await(0, TimeUnit::MILLISECONDS));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testGetNow() {
+
+    IntFuture future;
+    CPPUNIT_ASSERT_EQUAL(-1, future.getNow(-1));
+    future.complete(3);
+    CPPUNIT_ASSERT_EQUAL(3, future.getNow(-1));
+
+    IntFuture failed;
+    failed.completeExceptionally(Exception(__FILE__, __LINE__, "failed"));
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an ExecutionException",
+        failed.getNow(-1),
+        ExecutionException);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testOnCompleteAfterCompletion() {
+
+    Pointer<IntFuture> future = IntFuture::completedFuture(5);
+
+    Pointer<RecordingListener> listener(new RecordingListener);
+    future->onComplete(listener);
+
+    CPPUNIT_ASSERT_EQUAL(0, listener->done.getCount());
+    CPPUNIT_ASSERT_EQUAL(5, listener->value);
+    CPPUNIT_ASSERT(listener->thread == Thread::currentThread());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a NullPointerException",
+        future->onComplete(Pointer< CompletionListener<int> >()),
+        NullPointerException);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testOnCompleteWithExecutor() {
+
+    Pointer<ThreadPoolExecutor> executor(newExecutor());
+
+    Pointer<IntFuture> future(new IntFuture());
+    Pointer<RecordingListener> listener(new RecordingListener);
+    future->onComplete(listener, executor.get());
+
+    future->completeExceptionally(Exception(__FILE__, __LINE__, "failed"));
+    CPPUNIT_ASSERT(listener->done.await(LONG_DELAY_MS));
+    CPPUNIT_ASSERT_EQUAL(std::string("failed"), listener->error);
+    CPPUNIT_ASSERT(listener->thread != Thread::currentThread());
+
+    // A rejecting executor falls back to the completing thread.
+    executor->shutdown();
+    CPPUNIT_ASSERT(executor->awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    Pointer<RecordingListener> rejected(new RecordingListener);
+    future->onComplete(rejected, executor.get());
+    CPPUNIT_ASSERT_EQUAL(0, rejected->done.getCount());
+    CPPUNIT_ASSERT(rejected->thread == Thread::currentThread());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testThen() {
+
+    Pointer<IntFuture> future(new IntFuture());
+
+    Pointer< CompletableFuture<std::string> > described =
+        future->then(Pointer< Continuation<int, int> >(new Doubler))
+              ->then(Pointer< Continuation<int, std::string> >(new Describer));
+
+    CPPUNIT_ASSERT(!described->isDone());
+    future->complete(21);
+    CPPUNIT_ASSERT_EQUAL(std::string("positive"), described->get());
+
+    Pointer<ThreadPoolExecutor> executor(newExecutor());
+    Pointer<IntFuture> doubled = future->then(Pointer< Continuation<int, int> >(new Doubler), executor.get());
+    CPPUNIT_ASSERT_EQUAL(42, doubled->get(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    executor->shutdown();
+    CPPUNIT_ASSERT(executor->awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testThenPropagatesFailure() {
+
+    Pointer<IntFuture> future(new IntFuture());
+    Pointer<IntFuture> doubled = future->then(Pointer< Continuation<int, int> >(new Doubler));
+
+    future->cancel(false);
+
+    CPPUNIT_ASSERT(doubled->isCompletedExceptionally());
+    CPPUNIT_ASSERT(!doubled->isCancelled());
+    try {
+        doubled->get();
+        CPPUNIT_FAIL("Should have thrown an ExecutionException");
+    } catch (ExecutionException& ex) {
+        CPPUNIT_ASSERT(dynamic_cast<const CancellationException*>(ex.getCause()) != NULL);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testThenContinuationThrows() {
+
+    Pointer<IntFuture> future(new IntFuture());
+    Pointer<IntFuture> failed = future->then(Pointer< Continuation<int, int> >(new Thrower));
+    Pointer<IntFuture> skipped = failed->then(Pointer< Continuation<int, int> >(new Doubler));
+
+    future->complete(1);
+
+    CPPUNIT_ASSERT(failed->isCompletedExceptionally());
+    try {
+        skipped->get();
+        CPPUNIT_FAIL("Should have thrown an ExecutionException");
+    } catch (ExecutionException& ex) {
+        CPPUNIT_ASSERT(dynamic_cast<const IllegalStateException*>(ex.getCause()) != NULL);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testThenCompose() {
+
+    Pointer<ThreadPoolExecutor> executor(newExecutor());
+
+    Pointer<IntFuture> future(new IntFuture());
+    Pointer< Continuation<int, Pointer<IntFuture> > > followUp(new FollowUp(executor.get()));
+
+    Pointer<IntFuture> result = future->thenCompose(followUp)->thenCompose(followUp);
+
+    future->complete(1);
+    CPPUNIT_ASSERT_EQUAL(3, result->get(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    executor->shutdown();
+    CPPUNIT_ASSERT(executor->awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testWhenAll() {
+
+    ArrayList< Pointer<IntFuture> > futures;
+    for (int i = 0; i < 5; ++i) {
+        futures.add(Pointer<IntFuture>(new IntFuture()));
+    }
+
+    Pointer< CompletableFuture< ArrayList<int> > > all = IntFuture::whenAll(futures);
+
+    for (int i = 4; i >= 0; --i) {
+        CPPUNIT_ASSERT(!all->isDone());
+        futures.get(i)->complete(i * 10);
+    }
+
+    ArrayList<int> results = all->get();
+    CPPUNIT_ASSERT_EQUAL(5, results.size());
+    for (int i = 0; i < 5; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i * 10, results.get(i));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testWhenAllFailure() {
+
+    ArrayList< Pointer<IntFuture> > futures;
+    futures.add(Pointer<IntFuture>(new IntFuture()));
+    futures.add(Pointer<IntFuture>(new IntFuture()));
+
+    Pointer< CompletableFuture< ArrayList<int> > > all = IntFuture::whenAll(futures);
+
+    futures.get(1)->completeExceptionally(IllegalStateException(__FILE__, __LINE__, "failed"));
+    CPPUNIT_ASSERT(all->isCompletedExceptionally());
+
+    futures.get(0)->complete(1);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an ExecutionException",
+        all->get(),
+        ExecutionException);
+
+    futures.add(Pointer<IntFuture>());
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a NullPointerException",
+        IntFuture::whenAll(futures),
+        NullPointerException);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testWhenAllEmpty() {
+
+    ArrayList< Pointer<IntFuture> > futures;
+    Pointer< CompletableFuture< ArrayList<int> > > all = IntFuture::whenAll(futures);
+
+    CPPUNIT_ASSERT(all->isDone());
+    CPPUNIT_ASSERT(all->get().isEmpty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testWithTimeout() {
+
+    Timer timer;
+
+    Pointer<IntFuture> future(new IntFuture());
+    Pointer<IntFuture> bounded = future->withTimeout(SHORT_DELAY_MS, TimeUnit::MILLISECONDS, &timer);
+
+    try {
+        bounded->get(LONG_DELAY_MS, TimeUnit::MILLISECONDS);
+        CPPUNIT_FAIL("Should have thrown an ExecutionException");
+    } catch (ExecutionException& ex) {
+        CPPUNIT_ASSERT(dynamic_cast<const TimeoutException*>(ex.getCause()) != NULL);
+    }
+
+    // The source is not affected by the timeout.
+    CPPUNIT_ASSERT(!future->isDone());
+    CPPUNIT_ASSERT(future->complete(1));
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown a NullPointerException",
+        future->withTimeout(1, TimeUnit::SECONDS, NULL),
+        NullPointerException);
+
+    timer.cancel();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void CompletableFutureTest::testWithTimeoutCompletesFirst() {
+
+    Timer timer;
+
+    Pointer<IntFuture> future(new IntFuture());
+    Pointer<IntFuture> bounded = future->withTimeout(LONG_DELAY_MS, TimeUnit::MILLISECONDS, &timer);
+
+    future->complete(9);
+    CPPUNIT_ASSERT_EQUAL(9, bounded->get());
+
+    // Completion cancels the pending timeout task so the timer has nothing left to run.
+    CPPUNIT_ASSERT_EQUAL(1, timer.purge());
+
+    timer.cancel();
+}
@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_COMPLETABLEFUTURETEST_H_
+#define _DECAF_UTIL_CONCURRENT_COMPLETABLEFUTURETEST_H_
+
+#include <decaf/util/concurrent/ExecutorsTestSupport.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    class CompletableFutureTest : public ExecutorsTestSupport {
+
+        CPPUNIT_TEST_SUITE( CompletableFutureTest );
+        CPPUNIT_TEST( testComplete );
+        CPPUNIT_TEST( testCompleteExceptionally );
+        CPPUNIT_TEST( testCancel );
+        CPPUNIT_TEST( testTimedGet );
+        CPPUNIT_TEST( testGetNow );
+        CPPUNIT_TEST( testOnCompleteAfterCompletion );
+        CPPUNIT_TEST( testOnCompleteWithExecutor );
+        CPPUNIT_TEST( testThen );
+        CPPUNIT_TEST( testThenPropagatesFailure );
+        CPPUNIT_TEST( testThenContinuationThrows );
+        CPPUNIT_TEST( testThenCompose );
+        CPPUNIT_TEST( testWhenAll );
+        CPPUNIT_TEST( testWhenAllFailure );
+        CPPUNIT_TEST( testWhenAllEmpty );
+        CPPUNIT_TEST( testWithTimeout );
+        CPPUNIT_TEST( testWithTimeoutCompletesFirst );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        CompletableFutureTest();
+        virtual ~CompletableFutureTest();
+
+        void testComplete();
+        void testCompleteExceptionally();
+        void testCancel();
+        void testTimedGet();
+        void testGetNow();
+        void testOnCompleteAfterCompletion();
+        void testOnCompleteWithExecutor();
+        void testThen();
+        void testThenPropagatesFailure();
+        void testThenContinuationThrows();
+        void testThenCompose();
+        void testWhenAll();
+        void testWhenAllFailure();
+        void testWhenAllEmpty();
+        void testWithTimeout();
+        void testWithTimeoutCompletesFirst();
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_COMPLETABLEFUTURETEST_H_ */
@@ -19,6 +19,7 @@
 
 #include <decaf/lang/Pointer.h>
 #include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/WorkStealingExecutor.h>
 #include <decaf/util/concurrent/Executors.h>
 #include <decaf/util/concurrent/CountDownLatch.h>
 
@@ -114,6 +115,41 @@ void ExecutorsTest::testCastNewSingleThreadExecutor() {
     joinPool(e.get());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ExecutorsTest::testNewWorkStealingPool1() {
+
+    Pointer<ExecutorService> e(Executors::newWorkStealingPool());
+
+    e->execute(new NoOpRunnable());
+    e->execute(new NoOpRunnable());
+    e->execute(new NoOpRunnable());
+
+    joinPool(e.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ExecutorsTest::testNewWorkStealingPool2() {
+
+    Pointer<ExecutorService> e(Executors::newWorkStealingPool(2));
+
+    CPPUNIT_ASSERT_EQUAL(2, e.dynamicCast<WorkStealingExecutor>()->getParallelism());
+
+    e->execute(new NoOpRunnable());
+    e->execute(new NoOpRunnable());
+    e->execute(new NoOpRunnable());
+
+    joinPool(e.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ExecutorsTest::testNewWorkStealingPool3() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        Executors::newWorkStealingPool(0),
+        IllegalArgumentException);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ExecutorsTest::testDefaultThreadFactory() {
 
@@ -36,6 +36,9 @@ namespace concurrent {
         CPPUNIT_TEST( testNewSingleThreadExecutor2 );
         CPPUNIT_TEST( testNewSingleThreadExecutor3 );
         CPPUNIT_TEST( testCastNewSingleThreadExecutor );
+        CPPUNIT_TEST( testNewWorkStealingPool1 );
+        CPPUNIT_TEST( testNewWorkStealingPool2 );
+        CPPUNIT_TEST( testNewWorkStealingPool3 );
         CPPUNIT_TEST( testUnconfigurableExecutorService );
         CPPUNIT_TEST( testUnconfigurableExecutorServiceNPE );
         CPPUNIT_TEST( testCallable1 );
@@ -58,6 +61,9 @@ namespace concurrent {
         void testNewSingleThreadExecutor2();
         void testNewSingleThreadExecutor3();
         void testCastNewSingleThreadExecutor();
+        void testNewWorkStealingPool1();
+        void testNewWorkStealingPool2();
+        void testNewWorkStealingPool3();
         void testUnconfigurableExecutorService();
         void testUnconfigurableExecutorServiceNPE();
         void testCallable1();
@@ -0,0 +1,318 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkStealingExecutorTest.h"
+
+#include <decaf/util/concurrent/WorkStealingExecutor.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <decaf/lang/exceptions/RuntimeException.h>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+///////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingTask : public Runnable {
+    private:
+
+        CountingTask(const CountingTask&);
+        CountingTask operator= (const CountingTask&);
+
+    public:
+
+        AtomicInteger* counter;
+
+        CountingTask(AtomicInteger* counter) : Runnable(), counter(counter) {
+        }
+
+        virtual ~CountingTask() {}
+
+        virtual void run() {
+            counter->incrementAndGet();
+        }
+    };
+
+    // Splits itself into two subtasks from the worker thread until depth runs out.
+    class TreeTask : public Runnable {
+    private:
+
+        TreeTask(const TreeTask&);
+        TreeTask operator= (const TreeTask&);
+
+    public:
+
+        ExecutorService* executor;
+        AtomicInteger* counter;
+        int depth;
+
+        TreeTask(ExecutorService* executor, AtomicInteger* counter, int depth) :
+            Runnable(), executor(executor), counter(counter), depth(depth) {
+        }
+
+        virtual ~TreeTask() {}
+
+        virtual void run() {
+            counter->incrementAndGet();
+            if (depth > 0) {
+                executor->execute(new TreeTask(executor, counter, depth - 1));
+                executor->execute(new TreeTask(executor, counter, depth - 1));
+            }
+        }
+    };
+
+    // Queues all of its sleeping subtasks on the worker that runs it.
+    class ForkingTask : public Runnable {
+    private:
+
+        ForkingTask(const ForkingTask&);
+        ForkingTask operator= (const ForkingTask&);
+
+    public:
+
+        ExecutorService* executor;
+        CountDownLatch* done;
+        int count;
+
+        ForkingTask(ExecutorService* executor, CountDownLatch* done, int count) :
+            Runnable(), executor(executor), done(done), count(count) {
+        }
+
+        virtual ~ForkingTask() {}
+
+        virtual void run();
+    };
+
+    class SleepingTask : public Runnable {
+    private:
+
+        SleepingTask(const SleepingTask&);
+        SleepingTask operator= (const SleepingTask&);
+
+    public:
+
+        CountDownLatch* done;
+
+        SleepingTask(CountDownLatch* done) : Runnable(), done(done) {
+        }
+
+        virtual ~SleepingTask() {}
+
+        virtual void run() {
+            Thread::sleep(10);
+            done->countDown();
+        }
+    };
+
+    void ForkingTask::run() {
+        for (int i = 0; i < count; ++i) {
+            executor->execute(new SleepingTask(done));
+        }
+    }
+
+    class ThrowingTask : public Runnable {
+    public:
+
+        virtual ~ThrowingTask() {}
+
+        virtual void run() {
+            throw RuntimeException(__FILE__, __LINE__, "Task failure");
+        }
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutorTest::WorkStealingExecutorTest() {
+}
+
+///////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutorTest::~WorkStealingExecutorTest() {
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testConstructor() {
+
+    WorkStealingExecutor p1(3);
+    CPPUNIT_ASSERT_EQUAL(3, p1.getParallelism());
+    CPPUNIT_ASSERT(!p1.isShutdown());
+    CPPUNIT_ASSERT(!p1.isTerminated());
+    joinPool(p1);
+    CPPUNIT_ASSERT(p1.isTerminated());
+
+    WorkStealingExecutor p2(2, new SimpleThreadFactory());
+    CPPUNIT_ASSERT_EQUAL(2, p2.getParallelism());
+    joinPool(p2);
+
+    WorkStealingExecutor p3;
+    CPPUNIT_ASSERT(p3.getParallelism() > 0);
+    joinPool(p3);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testConstructorIllegalArgument() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        WorkStealingExecutor(0),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        WorkStealingExecutor(-1, new SimpleThreadFactory()),
+        IllegalArgumentException);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testConstructorNullThreadFactory() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        WorkStealingExecutor(2, NULL),
+        NullPointerException);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testExecuteRunsEveryTask() {
+
+    static const int TASK_COUNT = 10000;
+
+    AtomicInteger counter;
+    WorkStealingExecutor p1(4);
+
+    for (int i = 0; i < TASK_COUNT; ++i) {
+        p1.execute(new CountingTask(&counter));
+    }
+
+    joinPool(p1);
+    CPPUNIT_ASSERT_EQUAL(TASK_COUNT, counter.get());
+    CPPUNIT_ASSERT_EQUAL(0LL, p1.getQueuedTaskCount());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testExecuteUnowned() {
+
+    AtomicInteger counter;
+    CountingTask task(&counter);
+
+    WorkStealingExecutor p1(2);
+    p1.execute(&task, false);
+    p1.execute(&task, false);
+    joinPool(p1);
+
+    CPPUNIT_ASSERT_EQUAL(2, counter.get());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testSubmitCallable() {
+
+    WorkStealingExecutor p1(2);
+
+    Pointer< Future<string> > future(p1.submit(new StringTask()));
+    CPPUNIT_ASSERT_EQUAL(TEST_STRING, future->get());
+    CPPUNIT_ASSERT(future->isDone());
+
+    joinPool(p1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testNestedTasksRunAfterShutdown() {
+
+    // A full binary tree of depth 10 has 2047 nodes, all but the root are
+    // submitted by the workers after shutdown has been called.
+    AtomicInteger counter;
+    WorkStealingExecutor p1(4);
+
+    p1.execute(new TreeTask(&p1, &counter, 10));
+    joinPool(p1);
+
+    CPPUNIT_ASSERT_EQUAL(2047, counter.get());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testIdleWorkersSteal() {
+
+    static const int TASK_COUNT = 40;
+
+    CountDownLatch done(TASK_COUNT);
+    WorkStealingExecutor p1(4);
+
+    p1.execute(new ForkingTask(&p1, &done, TASK_COUNT));
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS));
+    CPPUNIT_ASSERT(p1.getStealCount() > 0);
+
+    joinPool(p1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testExecuteAfterShutdown() {
+
+    AtomicInteger counter;
+    WorkStealingExecutor p1(2);
+    p1.shutdown();
+
+    CPPUNIT_ASSERT(p1.isShutdown());
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a RejectedExecutionException",
+        p1.execute(new CountingTask(&counter)),
+        RejectedExecutionException);
+
+    CPPUNIT_ASSERT(p1.awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT(p1.isTerminated());
+    CPPUNIT_ASSERT_EQUAL(0, counter.get());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testShutdownNow() {
+
+    WorkStealingExecutor p1(1);
+
+    p1.execute(new MediumPossiblyInterruptedRunnable(this));
+    for (int i = 0; i < 4; ++i) {
+        p1.execute(new MediumPossiblyInterruptedRunnable(this));
+    }
+
+    Thread::sleep(SHORT_DELAY_MS);
+
+    ArrayList<Runnable*> list = p1.shutdownNow();
+    CPPUNIT_ASSERT(p1.isShutdown());
+    CPPUNIT_ASSERT_EQUAL(4, list.size());
+    destroyRemaining(list);
+
+    CPPUNIT_ASSERT(p1.awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT(p1.isTerminated());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testTaskExceptionKeepsWorker() {
+
+    AtomicInteger counter;
+    WorkStealingExecutor p1(1);
+
+    p1.execute(new ThrowingTask());
+    p1.execute(new CountingTask(&counter));
+    joinPool(p1);
+
+    CPPUNIT_ASSERT_EQUAL(1, counter.get());
+}
@@ -0,0 +1,64 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORTEST_H_
+#define _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORTEST_H_
+
+#include <decaf/util/concurrent/ExecutorsTestSupport.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    class WorkStealingExecutorTest : public ExecutorsTestSupport {
+
+        CPPUNIT_TEST_SUITE( WorkStealingExecutorTest );
+        CPPUNIT_TEST( testConstructor );
+        CPPUNIT_TEST( testConstructorIllegalArgument );
+        CPPUNIT_TEST( testConstructorNullThreadFactory );
+        CPPUNIT_TEST( testExecuteRunsEveryTask );
+        CPPUNIT_TEST( testExecuteUnowned );
+        CPPUNIT_TEST( testSubmitCallable );
+        CPPUNIT_TEST( testNestedTasksRunAfterShutdown );
+        CPPUNIT_TEST( testIdleWorkersSteal );
+        CPPUNIT_TEST( testExecuteAfterShutdown );
+        CPPUNIT_TEST( testShutdownNow );
+        CPPUNIT_TEST( testTaskExceptionKeepsWorker );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        WorkStealingExecutorTest();
+        virtual ~WorkStealingExecutorTest();
+
+        void testConstructor();
+        void testConstructorIllegalArgument();
+        void testConstructorNullThreadFactory();
+        void testExecuteRunsEveryTask();
+        void testExecuteUnowned();
+        void testSubmitCallable();
+        void testNestedTasksRunAfterShutdown();
+        void testIdleWorkersSteal();
+        void testExecuteAfterShutdown();
+        void testShutdownNow();
+        void testTaskExceptionKeepsWorker();
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORTEST_H_ */
@@ -0,0 +1,358 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncHandlerTest.h"
+
+#include <decaf/util/logging/AsyncHandler.h>
+#include <decaf/util/logging/LogRecord.h>
+#include <decaf/util/logging/Level.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordingHandler : public Handler {
+    private:
+
+        Mutex mutex;
+        std::vector<std::string> messages;
+        CountDownLatch* gate;
+        bool closed;
+        int flushes;
+
+    public:
+
+        RecordingHandler() : Handler(), mutex(), messages(), gate(NULL), closed(false), flushes(0) {}
+
+        virtual ~RecordingHandler() {}
+
+        void setGate(CountDownLatch* gate) {
+            this->gate = gate;
+        }
+
+        virtual void publish(const LogRecord& record) {
+            if (this->gate != NULL) {
+                this->gate->await();
+            }
+            synchronized(&mutex) {
+                messages.push_back(record.getMessage());
+            }
+        }
+
+        virtual void flush() {
+            synchronized(&mutex) {
+                flushes++;
+            }
+        }
+
+        virtual void close() {
+            synchronized(&mutex) {
+                closed = true;
+            }
+        }
+
+        std::vector<std::string> getMessages() {
+            std::vector<std::string> result;
+            synchronized(&mutex) {
+                result = messages;
+            }
+            return result;
+        }
+
+        bool isClosed() {
+            bool result = false;
+            synchronized(&mutex) {
+                result = closed;
+            }
+            return result;
+        }
+
+        int getFlushCount() {
+            int result = 0;
+            synchronized(&mutex) {
+                result = flushes;
+            }
+            return result;
+        }
+    };
+
+    void publish(Handler& handler, const std::string& message, const Level& level = Level::INFO) {
+        LogRecord record;
+        record.setLevel(level);
+        record.setMessage(message);
+        handler.publish(record);
+    }
+
+    class Producer : public Runnable {
+    private:
+
+        Handler* handler;
+        std::string prefix;
+        int count;
+
+    public:
+
+        Producer(Handler* handler, const std::string& prefix, int count) :
+            Runnable(), handler(handler), prefix(prefix), count(count) {}
+
+        virtual ~Producer() {}
+
+        virtual void run() {
+            for (int i = 0; i < count; ++i) {
+                publish(*handler, prefix + Integer::toString(i));
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testConstructor() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        AsyncHandler(NULL),
+        NullPointerException);
+
+    RecordingHandler target;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        AsyncHandler(&target, 0),
+        IllegalArgumentException);
+
+    AsyncHandler handler(&target, 1000);
+    CPPUNIT_ASSERT_EQUAL(1024, handler.getCapacity());
+    CPPUNIT_ASSERT_EQUAL(AsyncHandler::DROP, handler.getOverflowPolicy());
+    CPPUNIT_ASSERT_EQUAL(0, handler.getDroppedCount());
+
+    AsyncHandler blocking(&target, 1, AsyncHandler::BLOCK);
+    CPPUNIT_ASSERT_EQUAL(1, blocking.getCapacity());
+    CPPUNIT_ASSERT_EQUAL(AsyncHandler::BLOCK, blocking.getOverflowPolicy());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testPublishInOrder() {
+
+    RecordingHandler target;
+    AsyncHandler handler(&target, 16, AsyncHandler::BLOCK);
+
+    for (int i = 0; i < 1000; ++i) {
+        publish(handler, Integer::toString(i));
+    }
+
+    handler.flush();
+
+    std::vector<std::string> messages = target.getMessages();
+    CPPUNIT_ASSERT_EQUAL((std::size_t)1000, messages.size());
+    for (int i = 0; i < 1000; ++i) {
+        CPPUNIT_ASSERT_EQUAL(Integer::toString(i), messages[i]);
+    }
+
+    CPPUNIT_ASSERT(target.getFlushCount() > 0);
+    CPPUNIT_ASSERT_EQUAL(0, handler.getDroppedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testLevelFiltering() {
+
+    RecordingHandler target;
+    AsyncHandler handler(&target);
+    handler.setLevel(Level::WARNING);
+
+    publish(handler, "fine", Level::FINE);
+    publish(handler, "warning", Level::WARNING);
+    publish(handler, "severe", Level::SEVERE);
+
+    handler.flush();
+
+    std::vector<std::string> messages = target.getMessages();
+    CPPUNIT_ASSERT_EQUAL((std::size_t)2, messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("warning"), messages[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("severe"), messages[1]);
+    CPPUNIT_ASSERT_EQUAL(0, handler.getDroppedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testDropWhenFull() {
+
+    CountDownLatch gate(1);
+    RecordingHandler target;
+    target.setGate(&gate);
+
+    AsyncHandler handler(&target, 4, AsyncHandler::DROP);
+
+    // The writer holds at most one record while it waits on the gate, the rest
+    // of the ring fills and everything past that is dropped without waiting.
+    for (int i = 0; i < 20; ++i) {
+        publish(handler, Integer::toString(i));
+    }
+
+    CPPUNIT_ASSERT(handler.getDroppedCount() >= 20 - 5);
+
+    gate.countDown();
+    handler.flush();
+
+    std::vector<std::string> messages = target.getMessages();
+    CPPUNIT_ASSERT_EQUAL(20, (int)messages.size() + handler.getDroppedCount());
+    CPPUNIT_ASSERT_EQUAL(std::string("0"), messages[0]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testBlockWhenFull() {
+
+    CountDownLatch gate(1);
+    RecordingHandler target;
+    target.setGate(&gate);
+
+    AsyncHandler handler(&target, 2, AsyncHandler::BLOCK);
+
+    Producer producer(&handler, "", 10);
+    Thread thread(&producer);
+    thread.start();
+
+    thread.join(200);
+    CPPUNIT_ASSERT_MESSAGE("Producer should be blocked on the full ring", thread.isAlive());
+
+    gate.countDown();
+    thread.join();
+    handler.flush();
+
+    std::vector<std::string> messages = target.getMessages();
+    CPPUNIT_ASSERT_EQUAL((std::size_t)10, messages.size());
+    for (int i = 0; i < 10; ++i) {
+        CPPUNIT_ASSERT_EQUAL(Integer::toString(i), messages[i]);
+    }
+    CPPUNIT_ASSERT_EQUAL(0, handler.getDroppedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testCloseDrainsRing() {
+
+    RecordingHandler target;
+    AsyncHandler handler(&target, 64);
+
+    for (int i = 0; i < 50; ++i) {
+        publish(handler, Integer::toString(i));
+    }
+
+    handler.close();
+
+    CPPUNIT_ASSERT(target.isClosed());
+    CPPUNIT_ASSERT_EQUAL((std::size_t)50, target.getMessages().size());
+
+    LogRecord record;
+    record.setLevel(Level::SEVERE);
+    CPPUNIT_ASSERT(!handler.isLoggable(record));
+
+    publish(handler, "late");
+    CPPUNIT_ASSERT_EQUAL(1, handler.getDroppedCount());
+    CPPUNIT_ASSERT_EQUAL((std::size_t)50, target.getMessages().size());
+
+    // Closing again is a no-op.
+    handler.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testMultipleProducers() {
+
+    static const int PRODUCERS = 4;
+    static const int RECORDS = 2000;
+
+    RecordingHandler target;
+    AsyncHandler handler(&target, 32, AsyncHandler::BLOCK);
+
+    std::vector<Producer*> producers;
+    std::vector<Thread*> threads;
+
+    for (int i = 0; i < PRODUCERS; ++i) {
+        producers.push_back(new Producer(&handler, Integer::toString(i) + ":", RECORDS));
+        threads.push_back(new Thread(producers.back()));
+        threads.back()->start();
+    }
+
+    for (int i = 0; i < PRODUCERS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+        delete producers[i];
+    }
+
+    handler.flush();
+
+    std::vector<std::string> messages = target.getMessages();
+    CPPUNIT_ASSERT_EQUAL((std::size_t)(PRODUCERS * RECORDS), messages.size());
+    CPPUNIT_ASSERT_EQUAL(0, handler.getDroppedCount());
+
+    // Records from any one producer must arrive in the order they were published.
+    std::vector<int> next(PRODUCERS, 0);
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        std::string::size_type split = messages[i].find(':');
+        int producer = Integer::parseInt(messages[i].substr(0, split));
+        int sequence = Integer::parseInt(messages[i].substr(split + 1));
+        CPPUNIT_ASSERT_EQUAL(next[producer], sequence);
+        next[producer]++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testCloseWhilePublishing() {
+
+    static const int PRODUCERS = 4;
+    static const int RECORDS = 5000;
+
+    RecordingHandler target;
+    AsyncHandler handler(&target, 64);
+
+    std::vector<Producer*> producers;
+    std::vector<Thread*> threads;
+
+    for (int i = 0; i < PRODUCERS; ++i) {
+        producers.push_back(new Producer(&handler, Integer::toString(i) + ":", RECORDS));
+        threads.push_back(new Thread(producers.back()));
+        threads.back()->start();
+    }
+
+    Thread::sleep(5);
+    handler.close();
+
+    for (int i = 0; i < PRODUCERS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+        delete producers[i];
+    }
+
+    // Every record was either written before the close finished or counted as dropped.
+    CPPUNIT_ASSERT_EQUAL(PRODUCERS * RECORDS,
+                         (int) target.getMessages().size() + handler.getDroppedCount());
+}
@@ -0,0 +1,213 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileHandlerTest.h"
+
+#include <decaf/util/logging/FileHandler.h>
+#include <decaf/util/logging/Formatter.h>
+#include <decaf/util/logging/LogRecord.h>
+#include <decaf/util/logging/Level.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <cstdio>
+#include <string>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const std::string LOG_FILE = "FileHandlerTest.log";
+
+    class LineFormatter : public Formatter {
+    public:
+
+        virtual std::string format(const LogRecord& record) const {
+            return record.getMessage() + "\n";
+        }
+    };
+
+    std::string readFile(const std::string& name) {
+
+        std::string content;
+        FILE* file = std::fopen(name.c_str(), "rb");
+        if (file == NULL) {
+            return content;
+        }
+
+        char buffer[1024];
+        std::size_t count = 0;
+        while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            content.append(buffer, count);
+        }
+
+        std::fclose(file);
+        return content;
+    }
+
+    bool fileExists(const std::string& name) {
+        FILE* file = std::fopen(name.c_str(), "rb");
+        if (file != NULL) {
+            std::fclose(file);
+            return true;
+        }
+        return false;
+    }
+
+    void removeFiles() {
+        std::remove(LOG_FILE.c_str());
+        for (int i = 1; i < 5; ++i) {
+            char suffix[8];
+            std::sprintf(suffix, ".%d", i);
+            std::remove((LOG_FILE + suffix).c_str());
+        }
+    }
+
+    void publish(Handler& handler, const std::string& message) {
+        LogRecord record;
+        record.setLevel(Level::INFO);
+        record.setMessage(message);
+        handler.publish(record);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandlerTest::setUp() {
+    removeFiles();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandlerTest::tearDown() {
+    removeFiles();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandlerTest::testConstructor() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        FileHandler(""),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        FileHandler(LOG_FILE, false, -1),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        FileHandler(LOG_FILE, false, 0, 0),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        FileHandler(LOG_FILE, false, 0, 1, -1),
+        IllegalArgumentException);
+
+    FileHandler handler(LOG_FILE);
+    CPPUNIT_ASSERT_EQUAL(LOG_FILE, handler.getFileName());
+    CPPUNIT_ASSERT(fileExists(LOG_FILE));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandlerTest::testBatchedWrites() {
+
+    LineFormatter formatter;
+    FileHandler handler(LOG_FILE, false, 0, 1, 1024);
+    handler.setFormatter(&formatter);
+
+    publish(handler, "first");
+    publish(handler, "second");
+
+    // Nothing reaches the file until the batch fills or the handler is flushed.
+    CPPUNIT_ASSERT_EQUAL(std::string(""), readFile(LOG_FILE));
+
+    handler.flush();
+    CPPUNIT_ASSERT_EQUAL(std::string("first\nsecond\n"), readFile(LOG_FILE));
+
+    std::string large(2000, 'x');
+    publish(handler, large);
+    CPPUNIT_ASSERT_EQUAL(std::string("first\nsecond\n") + large + "\n", readFile(LOG_FILE));
+
+    publish(handler, "last");
+    handler.close();
+    CPPUNIT_ASSERT_EQUAL(std::string("first\nsecond\n") + large + "\nlast\n", readFile(LOG_FILE));
+
+    // Records published after close are ignored.
+    publish(handler, "ignored");
+    handler.flush();
+    CPPUNIT_ASSERT_EQUAL(std::string("first\nsecond\n") + large + "\nlast\n", readFile(LOG_FILE));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandlerTest::testAppend() {
+
+    LineFormatter formatter;
+
+    {
+        FileHandler handler(LOG_FILE);
+        handler.setFormatter(&formatter);
+        publish(handler, "one");
+        handler.close();
+    }
+
+    {
+        FileHandler handler(LOG_FILE, true);
+        handler.setFormatter(&formatter);
+        publish(handler, "two");
+        handler.close();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::string("one\ntwo\n"), readFile(LOG_FILE));
+
+    {
+        FileHandler handler(LOG_FILE, false);
+        handler.setFormatter(&formatter);
+        publish(handler, "three");
+        handler.close();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::string("three\n"), readFile(LOG_FILE));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileHandlerTest::testRotation() {
+
+    LineFormatter formatter;
+    FileHandler handler(LOG_FILE, false, 20, 3, 0);
+    handler.setFormatter(&formatter);
+
+    // Each record is 10 bytes so every file holds two of them.
+    const char* records[] = { "record-01", "record-02", "record-03", "record-04",
+                              "record-05", "record-06", "record-07" };
+
+    for (int i = 0; i < 7; ++i) {
+        publish(handler, records[i]);
+    }
+
+    handler.close();
+
+    CPPUNIT_ASSERT_EQUAL(std::string("record-07\n"), readFile(LOG_FILE));
+    CPPUNIT_ASSERT_EQUAL(std::string("record-05\nrecord-06\n"), readFile(LOG_FILE + ".1"));
+    CPPUNIT_ASSERT_EQUAL(std::string("record-03\nrecord-04\n"), readFile(LOG_FILE + ".2"));
+    CPPUNIT_ASSERT(!fileExists(LOG_FILE + ".3"));
+}
@@ -47,6 +47,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::commands::XATransactionIdTest );
 
 #include <activemq/wireformat/openwire/marshal/BaseDataStreamMarshallerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::marshal::BaseDataStreamMarshallerTest );
+#include <activemq/wireformat/openwire/marshal/FusedTightMarshallerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::marshal::FusedTightMarshallerTest );
 #include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshallerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::marshal::PrimitiveTypesMarshallerTest );
 
@@ -60,6 +62,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::MessageP
 #include <activemq/wireformat/openwire/OpenWireFormatTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::OpenWireFormatTest );
 
+#include <activemq/wireformat/stomp/StompFrameReaderTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::stomp::StompFrameReaderTest );
 #include <activemq/wireformat/stomp/StompHelperTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::stomp::StompHelperTest );
 #include <activemq/wireformat/stomp/StompWireFormatTest.h>
@@ -77,6 +81,10 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::CmsTemplateTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::DynamicDestinationResolverTest );
 #include <activemq/cmsutil/SessionPoolTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::SessionPoolTest );
+#include <activemq/cmsutil/RequestorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::RequestorTest );
+#include <activemq/cmsutil/DemuxConsumerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::DemuxConsumerTest );
 
 #include <activemq/core/ActiveMQConnectionFactoryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQConnectionFactoryTest );
@@ -84,15 +92,22 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQConnectionFactoryTest )
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQConnectionTest );
 #include <activemq/core/ActiveMQSessionTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQSessionTest );
+#include <activemq/core/ActiveMQStreamTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQStreamTest );
 #include <activemq/core/FifoMessageDispatchChannelTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::FifoMessageDispatchChannelTest );
 #include <activemq/core/SimplePriorityMessageDispatchChannelTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::SimplePriorityMessageDispatchChannelTest );
 #include <activemq/core/ActiveMQMessageAuditTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQMessageAuditTest );
+#include <activemq/core/AdaptivePrefetchControllerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::AdaptivePrefetchControllerTest );
 #include <activemq/core/ConnectionAuditTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ConnectionAuditTest );
 
+#include <activemq/selector/SelectorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::selector::SelectorTest );
+
 #include <activemq/state/ConnectionStateTrackerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::ConnectionStateTrackerTest );
 #include <activemq/state/ConnectionStateTest.h>
@@ -108,6 +123,10 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::TransactionStateTest );
 
 #include <activemq/transport/failover/FailoverTransportTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::failover::FailoverTransportTest );
+#include <activemq/transport/failover/MessageSpoolTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::failover::MessageSpoolTest );
+#include <activemq/transport/failover/LatencyProbeTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::failover::LatencyProbeTest );
 
 #include <activemq/transport/tcp/TcpTransportTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::tcp::TcpTransportTest );
@@ -125,6 +144,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::inactivity::InactivityMoni
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::TransportRegistryTest );
 #include <activemq/transport/IOTransportTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::IOTransportTest );
+#include <activemq/transport/TransportFilterTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::TransportFilterTest );
 
 #include <activemq/exceptions/ActiveMQExceptionTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::exceptions::ActiveMQExceptionTest );
@@ -156,19 +177,27 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::MarshallingSupportTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::SchedulerTest );
 #include <activemq/threads/DedicatedTaskRunnerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::DedicatedTaskRunnerTest );
+#include <activemq/threads/PooledTaskRunnerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::PooledTaskRunnerTest );
 #include <activemq/threads/CompositeTaskRunnerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::CompositeTaskRunnerTest );
+#include <activemq/threads/ThreadPolicyTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::ThreadPolicyTest );
 
 #include <activemq/wireformat/WireFormatRegistryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::WireFormatRegistryTest );
 
 #include <decaf/internal/util/ByteArrayAdapterTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::ByteArrayAdapterTest );
+#include <decaf/internal/util/ModifiedUTF8Test.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::ModifiedUTF8Test );
 #include <decaf/internal/util/TimerTaskHeapTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::TimerTaskHeapTest );
 
 #include <decaf/internal/net/ssl/DefaultSSLSocketFactoryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::net::ssl::DefaultSSLSocketFactoryTest );
+#include <decaf/internal/net/ssl/openssl/OpenSSLSocketTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::net::ssl::openssl::OpenSSLSocketTest );
 
 #include <decaf/internal/nio/ByteArrayBufferTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::nio::ByteArrayBufferTest );
@@ -217,6 +246,12 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::PushbackInputStreamTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::DataInputStreamTest );
 #include <decaf/io/DataOutputStreamTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::DataOutputStreamTest );
+#include <decaf/io/FileTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::FileTest );
+#include <decaf/io/FileOutputStreamTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::FileOutputStreamTest );
+#include <decaf/io/MemoryMappedFileTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::MemoryMappedFileTest );
 #include <decaf/io/WriterTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::WriterTest );
 #include <decaf/io/ReaderTest.h>
@@ -301,6 +336,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::CountDownLatchTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::MutexTest );
 #include <decaf/util/concurrent/ThreadPoolExecutorTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::ThreadPoolExecutorTest );
+#include <decaf/util/concurrent/WorkStealingExecutorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::WorkStealingExecutorTest );
 #include <decaf/util/concurrent/ExecutorsTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::ExecutorsTest );
 #include <decaf/util/concurrent/TimeUnitTest.h>
@@ -311,6 +348,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::LinkedBlockingQueueTes
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::SemaphoreTest );
 #include <decaf/util/concurrent/FutureTaskTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::FutureTaskTest );
+#include <decaf/util/concurrent/CompletableFutureTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::CompletableFutureTest );
 #include <decaf/util/concurrent/AbstractExecutorServiceTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::AbstractExecutorServiceTest );
 #include <decaf/util/concurrent/ConcurrentHashMapTest.h>
@@ -332,10 +371,19 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::ReentrantLockTe
 #include <decaf/util/concurrent/locks/ReentrantReadWriteLockTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::ReentrantReadWriteLockTest );
 
+#include <decaf/util/logging/AsyncHandlerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::logging::AsyncHandlerTest );
+#include <decaf/util/logging/FileHandlerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::logging::FileHandlerTest );
+
 #include <decaf/util/CollectionsTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::CollectionsTest );
 #include <decaf/util/HashCodeTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::HashCodeTest );
+#include <decaf/util/FlatHashMapTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::FlatHashMapTest );
+#include <decaf/util/LinkedFlatHashMapTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::LinkedFlatHashMapTest );
 #include <decaf/util/LinkedHashMapTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::LinkedHashMapTest );
 #include <decaf/util/LinkedHashSetTest.h>